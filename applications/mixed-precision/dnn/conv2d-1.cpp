@@ -5,87 +5,79 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
 
 #include <universal/native/ieee754.hpp>
 #define POSIT_FAST_SPECIALIZATION 1
 #include <universal/number/posit/posit.hpp>
 #include <universal/number/bfloat/bfloat.hpp>
 #include <universal/number/cfloat/cfloat.hpp>
-#include <universal/number/fixpnt/fixpnt.hpp>
-#include "conv2d-1.hpp"
+#include <universal/dnn/conv2d.hpp>
 
-int main() {
-    using namespace sw::universal;
-    
-    // Convenience type aliases for common Universal number configurations
-    using Posit80 = posit<8, 0>;
-    using Posit82 = posit<8, 2>;
-    using CFloat16 = cfloat<16, 5>;
-    using CFloat32 = cfloat<32, 8>;
-    using FixedPoint16 = fixpnt<16, 8>;
+// throughput of the three convolution algorithms for a precision configuration
+template<typename InputT, typename WeightT, typename AccumT, typename OutputT>
+void Benchmark(const std::string& label, const sw::dnn::conv2d_parameters& params, size_t N, size_t H, size_t W, unsigned iterations) {
+	using namespace sw::universal;
+	using namespace sw::dnn;
 
-	// MixedPrecisionConfig<InputT, WeightT, AccumT, OutputT> is a template struct that defines the types used in convolution
+	conv2d<InputT, WeightT, AccumT, OutputT> conv(params);
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<WeightT> weights(params.out_channels * params.in_channels * params.kernel_height * params.kernel_width);
+	for (auto& w : weights) w = WeightT(distribution(generator));
+	conv.set_weights(weights);
+	std::vector<InputT> input(N * params.in_channels * H * W);
+	for (auto& x : input) x = InputT(distribution(generator));
+	std::vector<OutputT> output;
 
-    // Example mixed-precision configurations
-    using HighPrecisionConfig = MixedPrecisionConfig<float, float, double, float>;
-    using BfloatMixedConfig = MixedPrecisionConfig<bfloat16, bfloat16, float, bfloat16>;
-    using PositMixedConfig = MixedPrecisionConfig<Posit82, Posit82, float, Posit82>;
-    using CFloatMixedConfig = MixedPrecisionConfig<CFloat16, CFloat16, CFloat32, CFloat16>;
-    using HybridConfig = MixedPrecisionConfig<half, half, float, half>;
-
-    // Create different precision configurations for comparison
-    //constexpr size_t N = 1, C_in = 128, C_out = 64, H_in = 32, W_in = 32, K_h = 3, K_w = 3;
-    //constexpr size_t N = 1, C_in = 64, C_out = 128, H_in = 32, W_in = 32, K_h = 3, K_w = 3;
-    //constexpr size_t N = 1, C_in = 32, C_out = 16, H_in = 8, W_in = 8, K_h = 3, K_w = 3;
-    //constexpr size_t N = 8, C_in = 64, C_out = 128, H_in = 32, W_in = 32, K_h = 3, K_w = 3;
-    constexpr size_t N = 8, C_in = 32, C_out = 16, H_in = 8, W_in = 8, K_h = 3, K_w = 3;
-
-    // Benchmark different configurations
-    auto fp32_result = ConvolutionBenchmark<HighPrecisionConfig>::benchmark_direct_conv(
-        N, C_in, H_in, W_in, C_out, K_h, K_w, 100);
-    std::cout << "FP32 Config - GFLOPS: " << fp32_result.gflops
-        << ", Memory: " << fp32_result.memory_footprint_bytes << " bytes\n";
-    
-    auto bfloat_result = ConvolutionBenchmark<BfloatMixedConfig>::benchmark_direct_conv(
-        N, C_in, H_in, W_in, C_out, K_h, K_w, 100);
-    std::cout << "Bfloat16 Config - GFLOPS: " << bfloat_result.gflops 
-              << ", Memory: " << bfloat_result.memory_footprint_bytes << " bytes\n";
-    
-    auto posit_result = ConvolutionBenchmark<PositMixedConfig>::benchmark_direct_conv(
-        N, C_in, H_in, W_in, C_out, K_h, K_w, 100);
-    std::cout << "Posit8 Config - GFLOPS: " << posit_result.gflops
-        << ", Memory: " << posit_result.memory_footprint_bytes << " bytes\n";
-
-    return 0;
+	const double flops = 2.0 * double(N * params.out_channels * conv.output_height(H) * conv.output_width(W) * params.in_channels * params.kernel_height * params.kernel_width);
+	const size_t footprint = input.size() * sizeof(InputT) + weights.size() * sizeof(WeightT) + N * params.out_channels * conv.output_height(H) * conv.output_width(W) * sizeof(OutputT);
+	std::cout << label << " (automatic: " << to_string(conv.schedule(N, H, W).algorithm) << "), memory " << footprint << " bytes\n";
+	for (auto algorithm : { conv2d_algorithm::Direct, conv2d_algorithm::Im2col, conv2d_algorithm::Winograd }) {
+		if (algorithm == conv2d_algorithm::Winograd && !conv.winograd_applicable()) continue;
+		conv.forward(input, N, H, W, output, algorithm);  // warm up the pool and the workspaces
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned i = 0; i < iterations; ++i) conv.forward(input, N, H, W, output, algorithm);
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "  " << std::setw(10) << std::left << to_string(algorithm) << std::right << " GFLOPS: " << std::setw(10) << flops * iterations / elapsed / 1.0e9 << '\n';
+	}
 }
 
-/*
- ETLO: 8/18/2025
- Ryzen 9: single thread
-
- N = 1, C_in = 128, C_out = 64, H_in = 32, W_in = 32, K_h = 3, K_w = 3
- FP32     Config - GFLOPS: 0.615096, Memory: 1049600 bytes
- Bfloat16 Config - GFLOPS: 0.216806, Memory:  524800 bytes
- Posit8   Config - GFLOPS: 0.117461, Memory:  262400 bytes
+int main()
+try {
+	using namespace sw::universal;
+	using namespace sw::dnn;
 
- N = 1, C_in = 64, C_out = 128, H_in = 32, W_in = 32, K_h = 3, K_w = 3
- FP32     Config - GFLOPS: 0.613619, Memory: 1017856 bytes
- Bfloat16 Config - GFLOPS: 0.231718, Memory:  508928 bytes
- Posit8   Config - GFLOPS: 0.151432, Memory:  254464 bytes
+	// Convenience type aliases for common Universal number configurations
+	using Posit82 = posit<8, 2>;
+	using CFloat16 = cfloat<16, 5>;
+	using CFloat32 = cfloat<32, 8>;
 
- N = 1, C_in = 32, C_out = 16, H_in = 8, W_in = 8, K_h = 3, K_w = 3
- FP32     Config - GFLOPS: 0.612652, Memory:   91136 bytes
- Bfloat16 Config - GFLOPS: 0.229921, Memory:   45568 bytes
- Posit8   Config - GFLOPS: 0.151830, Memory:   22784 bytes
+	// Create different precision configurations for comparison
+	//constexpr size_t N = 1, C_in = 128, C_out = 64, H_in = 32, W_in = 32;
+	//constexpr size_t N = 1, C_in = 64, C_out = 128, H_in = 32, W_in = 32;
+	//constexpr size_t N = 8, C_in = 64, C_out = 128, H_in = 32, W_in = 32;
+	constexpr size_t N = 8, C_in = 32, C_out = 16, H_in = 8, W_in = 8;
+	conv2d_parameters params{ C_in, C_out, 3, 3, 1, 1, 1, 1, 1, 1 };
 
- N = 8, C_in = 64, C_out = 128, H_in = 32, W_in = 32, K_h = 3, K_w = 3
- FP32     Config - GFLOPS: 2.206150, Memory: 6078464 bytes
- Bfloat16 Config - GFLOPS: 1.647780, Memory: 3039232 bytes
- Posit8   Config - GFLOPS: 0.850738, Memory: 1519616 bytes
+	// conv2d<InputT, WeightT, AccumT, OutputT>
+	Benchmark<float, float, double, float>("FP32 with FP64 accumulation", params, N, H_in, W_in, 100);
+	Benchmark<bfloat16, bfloat16, float, bfloat16>("Bfloat16 with FP32 accumulation", params, N, H_in, W_in, 20);
+	Benchmark<half, half, float, half>("Half with FP32 accumulation", params, N, H_in, W_in, 20);
+	Benchmark<Posit82, Posit82, float, Posit82>("Posit8 with FP32 accumulation", params, N, H_in, W_in, 20);
+	Benchmark<CFloat16, CFloat16, CFloat32, CFloat16>("CFloat16 with CFloat32 accumulation", params, N, H_in, W_in, 2);
 
- N = 8, C_in = 32, C_out = 16, H_in = 8, W_in = 8, K_h = 3, K_w = 3
- FP32     Config - GFLOPS: 2.047450, Memory:  102400 bytes
- Bfloat16 Config - GFLOPS: 1.329820, Memory:   51200 bytes
- Posit8   Config - GFLOPS: 0.728240, Memory:   25600 bytes
-
- */
\ No newline at end of file
+	return EXIT_SUCCESS;
+}
+catch (const std::exception& e) {
+	std::cerr << "Benchmark failed with exception: " << e.what() << "\n";
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Unexpected exception caught\n" << std::endl;
+	return EXIT_FAILURE;
+}
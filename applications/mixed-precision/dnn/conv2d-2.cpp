@@ -1,72 +1,86 @@
-// conv2d-1.cpp: mixed-precision convolution benchmark
+// conv2d-2.cpp: selecting a convolution algorithm and schedule from the tensor shape
 //
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 //
-// Energy-Efficient 2D Convolution Kernel using Universal Numbers Library
-// 
-// This implementation avoids im2col data duplication by using direct convolution
-// with mixed-precision support through the Universal Numbers Library.
+// Direct convolution avoids the data duplication of im2col, im2col turns the convolution into a gemm
+// with better cache reuse, and Winograd F(2x2,3x3) trades multiplies for additions. Which one wins depends
+// on the shape of the layer, and conv2d picks one automatically.
 
-#include <iostream>
 #include <chrono>
-#include <random>
 #include <iomanip>
+#include <iostream>
+#include <random>
 #include <string>
-#include <memory>
-#include <cassert>
+#include <vector>
 
 #define POSIT_FAST_SPECIALIZATION 1
 #include <universal/number/posit/posit.hpp>
 #include <universal/number/cfloat/cfloat.hpp>
-#include <universal/number/fixpnt/fixpnt.hpp>
-#include "conv2d-2.hpp"
-
-int main()
-try {
-	using namespace sw::universal;
-
-    // Example usage with different precision configurations
-	using Conv2D_float = Conv2D<float, float, float, float>;
-    using Conv2D_fixpnt = Conv2D<fixpnt<8, 4>, fixpnt<8, 4>, fixpnt<8, 4>, fixpnt<8, 4>>;
-    using Conv2D_posit = Conv2D<posit<16, 1>, posit<8, 0>, posit<32, 2>, posit<16, 1>>;
-    using Conv2D_cfloat = Conv2D<cfloat<8, 2>, cfloat<8, 2>, cfloat<16, 5>, cfloat<8, 2>>;
+#include <universal/dnn/conv2d.hpp>
 
-    BenchmarkRunner benchmark;
+struct Layer {
+	std::string name;
+	size_t N, C, K, H, W, R, stride, pad;
+};
 
-    std::cout << "Starting Conv2D Energy Efficiency Benchmark...\n\n";
+template<typename InputT, typename WeightT, typename AccumT, typename OutputT>
+void Compare(const Layer& layer, unsigned iterations) {
+	using namespace sw::dnn;
+	conv2d_parameters params{ layer.C, layer.K, layer.R, layer.R, layer.stride, layer.stride, layer.pad, layer.pad, 1, 1 };
+	conv2d<InputT, WeightT, AccumT, OutputT> conv(params);
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<WeightT> weights(layer.K * layer.C * layer.R * layer.R);
+	for (auto& w : weights) w = WeightT(distribution(generator));
+	conv.set_weights(weights);
+	std::vector<InputT> input(layer.N * layer.C * layer.H * layer.W);
+	for (auto& x : input) x = InputT(distribution(generator));
+	std::vector<OutputT> output;
 
-    ConvolutionParameters2D conv2dParams({
-        .batch_size = 1, .in_channels = 64, .out_channels = 128,
-        .in_height = 28, .in_width = 28,
-        .kernel_height = 3, .kernel_width = 3,
-        .stride_h = 1, .stride_w = 1, .pad_h = 1, .pad_w = 1,
-        .dilation_h = 1, .dilation_w = 1
-        });
+	conv2d_schedule s = conv.schedule(layer.N, layer.H, layer.W);
+	std::cout << std::setw(16) << std::left << layer.name << std::right << " automatic " << std::setw(9) << to_string(s.algorithm)
+		<< (s.partition == conv2d_partition::Batch ? " over the batch   " : " within samples   ");
+	for (auto algorithm : { conv2d_algorithm::Direct, conv2d_algorithm::Im2col, conv2d_algorithm::Winograd }) {
+		if (algorithm == conv2d_algorithm::Winograd && !conv.winograd_applicable()) {
+			std::cout << std::setw(22) << "";
+			continue;
+		}
+		conv.forward(input, layer.N, layer.H, layer.W, output, algorithm);
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned i = 0; i < iterations; ++i) conv.forward(input, layer.N, layer.H, layer.W, output, algorithm);
+		double ms = 1000.0 * std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / iterations;
+		std::cout << std::setw(9) << to_string(algorithm) << ' ' << std::setw(9) << std::fixed << std::setprecision(3) << ms << "ms  ";
+	}
+	std::cout << '\n';
+}
 
-    Conv2D_float conv(conv2dParams);
-    benchmark.conv2D<Conv2D_float>(conv2dParams);
+int main()
+try {
+	using namespace sw::universal;
 
-#if 0
-    // Run comprehensive benchmark with different Conv2D types
-    benchmark.run_comprehensive_benchmark<
-        Conv2D_fixpnt,
-        Conv2D_posit,
-        Conv2D_cfloat,
-        Conv2D<float, float, float, float>
-    >();
-#endif
-    // Run tile size analysis
-    benchmark.run_tile_size_analysis();
+	std::vector<Layer> layers = {
+		{ "stem 7x7/2",     1,   3,  16, 64, 64, 7, 2, 3 },
+		{ "3x3 64->64",     1,  64,  64, 28, 28, 3, 1, 1 },
+		{ "3x3 64->64 x8",  8,  64,  64, 14, 14, 3, 1, 1 },
+		{ "3x3/2 32->64",   1,  32,  64, 28, 28, 3, 2, 1 },
+		{ "1x1 64->128",    1,  64, 128, 14, 14, 1, 1, 0 },
+		{ "3x3 2->4",       4,   2,   4, 16, 16, 3, 1, 1 },
+	};
 
-    std::cout << "\nBenchmark completed successfully!\n";
+	std::cout << "float\n";
+	for (const auto& layer : layers) Compare<float, float, float, float>(layer, 3);
+	std::cout << "\nposit<16,1> inputs, posit<8,0> weights, float accumulation\n";
+	for (const auto& layer : layers) Compare<posit<16, 1>, posit<8, 0>, float, posit<16, 1>>(layer, 1);
 
+	std::cout << "\nBenchmark completed successfully!\n";
+	return EXIT_SUCCESS;
 }
 catch (const std::exception& e) {
-    std::cerr << "Benchmark failed with exception: " << e.what() << "\n";
-    return EXIT_FAILURE;
+	std::cerr << "Benchmark failed with exception: " << e.what() << "\n";
+	return EXIT_FAILURE;
 }
 catch (...) {
 	std::cerr << "Unexpected exception caught\n" << std::endl;
@@ -4,34 +4,88 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <vector>
 
 // Configure the cfloat and lns environment
 #include <universal/number/cfloat/cfloat.hpp>
 #include <universal/number/lns/lns.hpp>
 #include <universal/dnn/dnn.hpp>
 
+// LeNet-5: a 28x28 grayscale digit through two convolutions and a classifier,
+// returns the logits of a batch of random images and reports the inference throughput
+template<typename WeightType, typename ActivationType, typename AccumulatorType = float>
+std::vector<double> LeNet5(const std::vector<double>& images, size_t batchSize, unsigned nrBatches, bool verbose = false) {
+	using namespace sw::universal;
+	using namespace sw::dnn;
+
+	dnn<float> network("LeNet-5", 0.1f);
+
+	unsigned N(1), C(1), H(28), W(28);
+	auto convLayer1 = CreateConvolutionLayer<WeightType, ActivationType, AccumulatorType>(N, C, H, W, Activation::Tanh, 6, 5, 5, 1, 2);
+	network.addLayer(convLayer1);
+	auto convLayer2 = CreateConvolutionLayer<WeightType, ActivationType, AccumulatorType>(N, 6, convLayer1.outputHeight(), convLayer1.outputWidth(), Activation::Tanh, 16, 5, 5, 2, 0);
+	network.addLayer(convLayer2);
+	auto fcLayer1 = CreateFullyConnectedLayer<WeightType, ActivationType, AccumulatorType>(84ul, Activation::ReLU);
+	network.addLayer(fcLayer1);
+	auto fcLayer2 = CreateFullyConnectedLayer<WeightType, ActivationType, AccumulatorType>(10ul, Activation::Identity);
+	network.addLayer(fcLayer2);
+
+	network.build(0, batchSize);
+	network.initialize(42);
+	network.setThreads(0);
+	if (verbose) {
+		std::cout << convLayer1 << '\n' << convLayer2 << '\n' << network << '\n';
+	}
+
+	network.forward(images, batchSize);  // warm up the rounding tables and buffers
+	auto begin = std::chrono::steady_clock::now();
+	std::vector<double> logits;
+	for (unsigned i = 0; i < nrBatches; ++i) logits = network.forward(images, batchSize);
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	std::cout << "weights " << std::setw(70) << std::left << type_tag(WeightType()) << " activations " << std::setw(40) << type_tag(ActivationType()) << std::right
+		<< " : " << std::setw(10) << (nrBatches * batchSize) / elapsed << " images/sec\n";
+	return logits;
+}
+
+// fraction of the images that are classified the same as the reference
+double Agreement(const std::vector<double>& logits, const std::vector<double>& reference, size_t nrClasses) {
+	size_t agree{ 0 }, nrImages = reference.size() / nrClasses;
+	for (size_t i = 0; i < nrImages; ++i) {
+		auto first = logits.begin() + static_cast<std::ptrdiff_t>(i * nrClasses);
+		auto ref = reference.begin() + static_cast<std::ptrdiff_t>(i * nrClasses);
+		if (std::max_element(first, first + static_cast<std::ptrdiff_t>(nrClasses)) - first == std::max_element(ref, ref + static_cast<std::ptrdiff_t>(nrClasses)) - ref) ++agree;
+	}
+	return double(agree) / double(nrImages);
+}
+
 int main()
 try {
 	using namespace sw::universal;
-	using namespace sw::dnn;
 
 	constexpr bool hasSubnormals = true;
 	constexpr bool hasSupernormals = true;
 	constexpr bool isSaturating = false;
 	using WeightType = cfloat<8, 2, std::uint8_t, hasSubnormals, hasSupernormals, isSaturating>;
 	using ActivationType = lns<5, 2, std::uint8_t>;
-	dnn<float> dnn("LeNet-5", 0.1f);
-
-	unsigned N(1), C(3), H(224), W(224);
-	auto convLayer1 = CreateConvolutionLayer<WeightType, ActivationType>(N, C, H, W, Activation::Tanh);
-	std::cout << convLayer1 << '\n';
-	dnn.addLayer(convLayer1);
 
-	auto fcLayer = CreateFullyConnectedLayer<WeightType, ActivationType>(10ul, Activation::ReLU);
-	std::cout << fcLayer << '\n';
-	dnn.addLayer(fcLayer);
+	constexpr size_t batchSize = 64;
+	constexpr unsigned nrBatches = 4;
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<double> pixel(0.0, 1.0);
+	std::vector<double> images(batchSize * 28 * 28);
+	for (auto& v : images) v = pixel(generator);
 
-	std::cout << dnn << '\n';
+	auto reference = LeNet5<float, float>(images, batchSize, nrBatches, true);
+	auto logits = LeNet5<WeightType, ActivationType>(images, batchSize, nrBatches);
+	std::cout << "classification agreement with float : " << Agreement(logits, reference, 10) << '\n';
+	logits = LeNet5<WeightType, lns<8, 3, std::uint8_t>>(images, batchSize, nrBatches);
+	std::cout << "classification agreement with float : " << Agreement(logits, reference, 10) << '\n';
+	logits = LeNet5<WeightType, cfloat<8, 4, std::uint8_t, true, false, false>>(images, batchSize, nrBatches);
+	std::cout << "classification agreement with float : " << Agreement(logits, reference, 10) << '\n';
 
 	return EXIT_SUCCESS;
 }
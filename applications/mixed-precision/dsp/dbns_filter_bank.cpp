@@ -0,0 +1,119 @@
+// dbns_filter_bank.cpp: example program evaluating a FIR filter bank in double-base logarithmic arithmetic
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <universal/number/dbns/dbns.hpp>
+
+/*
+ * A double-base logarithmic number system multiplies by adding exponent pairs, which makes
+ * the multiply of a multiply-accumulate free of a multiplier. The filter bank below splits
+ * a test signal into a low, band, and high band with three windowed-sinc FIR filters, and
+ * reports the signal-to-noise ratio of each band against a double precision reference
+ * together with the rate of multiply-accumulates.
+ */
+
+constexpr double pi = 3.14159265358979323846;  // best practice for C++
+
+// windowed-sinc band-pass filter between the normalized frequencies f1 and f2 (cycles/sample)
+std::vector<double> BandPassTaps(unsigned nrTaps, double f1, double f2) {
+	std::vector<double> taps(nrTaps);
+	int center = static_cast<int>(nrTaps / 2);
+	for (unsigned i = 0; i < nrTaps; ++i) {
+		int n = static_cast<int>(i) - center;
+		double ideal = (n == 0 ? 2.0 * (f2 - f1) : (std::sin(2.0 * pi * f2 * n) - std::sin(2.0 * pi * f1 * n)) / (pi * n));
+		double hamming = 0.54 - 0.46 * std::cos(2.0 * pi * i / (nrTaps - 1));
+		taps[i] = ideal * hamming;
+	}
+	return taps;
+}
+
+// y[n] = sum_k h[k] x[n - k]
+template<typename Real>
+std::vector<double> Filter(const std::vector<double>& taps, const std::vector<double>& signal, double& seconds) {
+	std::vector<Real> h(taps.begin(), taps.end()), x(signal.begin(), signal.end());
+	std::vector<double> y(signal.size());
+	auto begin = std::chrono::steady_clock::now();
+	for (size_t n = 0; n < x.size(); ++n) {
+		Real acc(0);
+		for (size_t k = 0; k < h.size() && k <= n; ++k) {
+			acc += h[k] * x[n - k];
+		}
+		y[n] = double(acc);
+	}
+	auto end = std::chrono::steady_clock::now();
+	seconds = std::chrono::duration<double>(end - begin).count();
+	return y;
+}
+
+double SignalToNoise(const std::vector<double>& reference, const std::vector<double>& y) {
+	double signal{ 0 }, noise{ 0 };
+	for (size_t i = 0; i < y.size(); ++i) {
+		signal += reference[i] * reference[i];
+		noise += (reference[i] - y[i]) * (reference[i] - y[i]);
+	}
+	return (noise == 0.0 ? INFINITY : 10.0 * std::log10(signal / noise));
+}
+
+template<typename Real>
+void FilterBank(const std::string& tag, const std::vector<std::vector<double>>& bank, const std::vector<double>& signal) {
+	std::cout << tag << '\n';
+	const char* bands[] = { "low ", "band", "high" };
+	for (size_t b = 0; b < bank.size(); ++b) {
+		double refSeconds, seconds;
+		std::vector<double> reference = Filter<double>(bank[b], signal, refSeconds);
+		std::vector<double> y = Filter<Real>(bank[b], signal, seconds);
+		double macs = static_cast<double>(bank[b].size() * signal.size());
+		std::cout << "  " << bands[b] << " : SNR " << std::setw(8) << std::setprecision(4) << SignalToNoise(reference, y) << " dB"
+			<< "  " << std::setw(8) << std::setprecision(4) << macs / seconds / 1.0e6 << " MMAC/s\n";
+	}
+}
+
+int main()
+try {
+	using namespace sw::universal;
+
+	constexpr unsigned nrTaps = 31;
+	constexpr unsigned nrSamples = 1024;
+	std::vector<std::vector<double>> bank = {
+		BandPassTaps(nrTaps, 0.0, 0.1),
+		BandPassTaps(nrTaps, 0.1, 0.3),
+		BandPassTaps(nrTaps, 0.3, 0.5)
+	};
+	// three tones, one in each band
+	std::vector<double> signal(nrSamples);
+	for (unsigned n = 0; n < nrSamples; ++n) {
+		signal[n] = 0.5 * std::sin(2.0 * pi * 0.03 * n) + 0.25 * std::sin(2.0 * pi * 0.2 * n) + 0.125 * std::sin(2.0 * pi * 0.4 * n);
+	}
+
+	FilterBank< dbns< 8, 3, std::uint8_t> >("dbns< 8,3>", bank, signal);
+	FilterBank< dbns<12, 5, std::uint16_t> >("dbns<12,5>", bank, signal);
+	FilterBank< dbns<16, 6, std::uint16_t> >("dbns<16,6>", bank, signal);
+
+	return EXIT_SUCCESS;
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (std::runtime_error& err) {
+	std::cerr << "Caught unexpected runtime error: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
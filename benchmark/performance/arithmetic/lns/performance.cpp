@@ -25,10 +25,11 @@ void TestArithmeticOperatorPerformance() {
 
 	uint64_t NR_OPS = 1000000;
 
-	PerformanceRunner("lns<8>    add/subtract  ", AdditionSubtractionWorkload< sw::universal::lns<16, 5> >, NR_OPS);
+	PerformanceRunner("lns<8>    add/subtract  ", AdditionSubtractionWorkload< sw::universal::lns<8, 3> >, NR_OPS);
 	PerformanceRunner("lns<16>   add/subtract  ", AdditionSubtractionWorkload< sw::universal::lns<16, 5> >, NR_OPS);
 	PerformanceRunner("lns<32>   add/subtract  ", AdditionSubtractionWorkload< sw::universal::lns<32, 8> >, NR_OPS);
-//	PerformanceRunner("lns<64>   add/subtract  ", AdditionSubtractionWorkload< sw::universal::lns<64, 11> >, NR_OPS);
+	PerformanceRunner("lns<64>   add/subtract  ", AdditionSubtractionWorkload< sw::universal::lns<64, 11> >, NR_OPS);
+	PerformanceRunner("lns<96>   add/subtract  ", AdditionSubtractionWorkload< sw::universal::lns<96, 32, std::uint32_t> >, NR_OPS);
 
 	NR_OPS = 1024 * 32;
 	PerformanceRunner("lns<16>   division      ", DivisionWorkload< sw::universal::lns<16, 5> >, NR_OPS);
@@ -0,0 +1,90 @@
+// performance.cpp : performance benchmarking for takum arithmetic
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <string>
+#include <chrono>
+// configure the arithmetic classes
+#define TAKUM_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/takum/takum.hpp>
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/posit/posit.hpp>
+#include <universal/verification/test_status.hpp> // ReportTestResult
+#include <universal/benchmark/performance_runner.hpp>
+
+/*
+   Takums are tapered floating-point numbers with a dynamic range that is nearly independent
+   of their precision. The benchmark runs the takum operators next to the posit<16,2> that
+   a takum<16> would replace.
+*/
+
+// measure performance of arithmetic operators
+void TestArithmeticOperatorPerformance() {
+	using namespace sw::universal;
+	std::cout << "\nTakum Arithmetic operator performance\n";
+
+	uint64_t NR_OPS = 1000000;
+
+	PerformanceRunner("takum<8>        add/subtract  ", AdditionSubtractionWorkload< takum<8, std::uint8_t> >, NR_OPS);
+	PerformanceRunner("takum<16>       add/subtract  ", AdditionSubtractionWorkload< takum<16, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("takum<32>       add/subtract  ", AdditionSubtractionWorkload< takum<32, std::uint32_t> >, NR_OPS);
+	PerformanceRunner("posit<16,2>     add/subtract  ", AdditionSubtractionWorkload< posit<16, 2> >, NR_OPS);
+
+	NR_OPS = 1024 * 32;
+	PerformanceRunner("takum<8>        multiplication", MultiplicationWorkload< takum<8, std::uint8_t> >, NR_OPS);
+	PerformanceRunner("takum<16>       multiplication", MultiplicationWorkload< takum<16, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("takum<32>       multiplication", MultiplicationWorkload< takum<32, std::uint32_t> >, NR_OPS);
+	PerformanceRunner("posit<16,2>     multiplication", MultiplicationWorkload< posit<16, 2> >, NR_OPS);
+
+	PerformanceRunner("takum<8>        division      ", DivisionWorkload< takum<8, std::uint8_t> >, NR_OPS);
+	PerformanceRunner("takum<16>       division      ", DivisionWorkload< takum<16, std::uint16_t> >, NR_OPS);
+	PerformanceRunner("takum<32>       division      ", DivisionWorkload< takum<32, std::uint32_t> >, NR_OPS);
+	PerformanceRunner("posit<16,2>     division      ", DivisionWorkload< posit<16, 2> >, NR_OPS);
+}
+
+// conditional compilation
+#define MANUAL_TESTING 0
+#define STRESS_TESTING 0
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string tag = "takum operator performance benchmarking";
+
+#if MANUAL_TESTING
+
+	TestArithmeticOperatorPerformance();
+
+	std::cout << "done" << std::endl;
+
+	return EXIT_SUCCESS;
+#else
+	std::cout << tag << std::endl;
+
+	int nrOfFailedTestCases = 0;
+
+	TestArithmeticOperatorPerformance();
+
+#if STRESS_TESTING
+
+#endif // STRESS_TESTING
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << '\n';
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << '\n';
+	return EXIT_FAILURE;
+}
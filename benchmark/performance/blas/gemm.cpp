@@ -4,6 +4,8 @@
 // SPDX-License-Identifier: MIT 
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+// measure the throughput of the gemm kernel on all hardware threads
+#define NUMERIC_GEMM_MAX_THREADS 0
 #include <universal/utility/directives.hpp>
 
 // enable the following define to show the intermediate steps in the fused-dot product
@@ -13,6 +15,9 @@
 // enable posit arithmetic exceptions
 #define POSIT_THROW_ARITHMETIC_EXCEPTION 1
 #include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/lns/lns.hpp>
 // enable operation counts
 #define EDECIMAL_OPERATIONS_COUNT 1
 #include <universal/number/edecimal/edecimal.hpp>
@@ -30,6 +35,26 @@ std::string conditional_fdp(const sw::numeric::containers::vector< sw::universal
 	return ss.str();
 }
 
+// measure the throughput of the packed, tiled, and multithreaded C = A * B for a number system
+// a matrix-matrix product of N x N matrices executes 2*N^3 floating-point operations
+template<typename Scalar>
+void GemmPerformance(size_t N) {
+	using namespace sw::numeric::containers;
+	using Matrix = matrix<Scalar>;
+	Matrix A(sw::blas::uniform_random_matrix<double>(N, N, -1.0, 1.0));
+	Matrix B(sw::blas::uniform_random_matrix<double>(N, N, -1.0, 1.0));
+
+	auto begin = std::chrono::steady_clock::now();
+	Matrix C = A * B;
+	auto end = std::chrono::steady_clock::now();
+	double elapsed = std::chrono::duration<double>(end - begin).count();
+	double flops = 2.0 * double(N) * double(N) * double(N);
+	std::cout << std::setw(60) << sw::universal::type_tag(Scalar()) << " : N = " << std::setw(4) << N
+		<< " : " << std::setw(10) << std::setprecision(4) << elapsed << " sec : "
+		<< std::setw(10) << std::setprecision(4) << (elapsed > 0.0 ? flops / elapsed / 1.0e9 : 0.0) << " GFLOPS"
+		<< " : trace " << C(0, 0) << '\n';
+}
+
 #if EDECIMAL_OPERATIONS_COUNT
 
 // create the static storage for the occurrence measurements of the decimal number system
@@ -57,6 +82,16 @@ try {
 	std::cout << C << std::endl;
 	proxy.printStats(std::cout);
 
+	std::cout << "\nGEMM throughput on " << sw::universal::default_thread_pool().size() << " threads\n";
+	GemmPerformance< float >(512);
+	GemmPerformance< double >(512);
+	GemmPerformance< cfloat<32, 8, uint32_t, true, false, false> >(128);
+	GemmPerformance< bfloat_t >(128);
+	GemmPerformance< fixpnt<32, 16, Modulo, uint32_t> >(128);
+	GemmPerformance< lns<16, 8> >(64);
+	GemmPerformance< posit<16, 1> >(64);
+	GemmPerformance< posit<32, 2> >(64);
+
 	return EXIT_SUCCESS;
 }
 catch (char const* msg) {
@@ -184,7 +184,7 @@ void examples() {
 	std::cout << d3 << '\n';
 
 	d1.setzero();		std::cout << d1.iszero() << '\n';
-	d1.push_back(0);	std::cout << d1.iszero() << '\n';
+	d1.setdigit(0, true);	std::cout << d1.iszero() << '\n';
 
 	std::cout << "Conversions\n";
 	// signed integers
@@ -89,6 +89,46 @@ namespace sw { namespace universal {
 			return nrOfFailedTests;
 		}
 
+		// multi-limb operands: verify a == q * b + r and |r| < |b| on digit strings that span many radix limbs
+		inline int VerifyLargeEdecimalDivision(bool reportTestCases) {
+			int nrOfFailedTests = 0;
+			uint64_t state = 0x9E3779B97F4A7C15ull;
+			auto randomDigits = [&state](size_t nrDigits) {
+				std::string digits;
+				for (size_t i = 0; i < nrDigits; ++i) {
+					state = state * 6364136223846793005ull + 1442695040888963407ull;
+					digits.push_back(static_cast<char>('0' + (state >> 33) % 10));
+				}
+				if (digits[0] == '0') digits[0] = '7';
+				return digits;
+			};
+			const size_t sizes[] = { 1, 18, 19, 20, 38, 39, 57, 100, 250 };
+			for (size_t na : sizes) {
+				for (size_t nb : sizes) {
+					if (nb > na) continue;
+					edecimal a, b, q, r, check;
+					a.parse(randomDigits(na));
+					b.parse(randomDigits(nb));
+					if ((na + nb) & 1) a.setsign(true);
+					if (a.str() != to_string(a).substr(a.sign() ? 1 : 0)) {
+						++nrOfFailedTests;
+						if (reportTestCases) std::cerr << "FAIL: string round trip of " << a << '\n';
+					}
+					q = a / b;
+					r = a % b;
+					check = q * b + r;
+					edecimal absr(r), absb(b);
+					absr.setsign(false);
+					absb.setsign(false);
+					if (check != a || absr >= absb) {
+						++nrOfFailedTests;
+						if (reportTestCases) std::cerr << "FAIL: " << a << " / " << b << " = " << q << " rem " << r << '\n';
+					}
+				}
+			}
+			return nrOfFailedTests;
+		}
+
 }} // namespace sw::universal
 
 // generate specific test case that you can trace with the trace conditions in mpreal.hpp
@@ -153,6 +193,7 @@ try {
 #endif
 
 #if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyLargeEdecimalDivision(reportTestCases), "decimal division multi-limb", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyEdecimalDivision<16>(reportTestCases), "decimal division nbits=16", test_tag);
 #endif
 
@@ -9,6 +9,7 @@
 #include <string>
 #include <cmath>
 #include <limits>
+#include <random>
 
 // minimum set of include files to reflect source code dependencies
 #include <universal/number/efloat/efloat.hpp>
@@ -35,6 +36,51 @@ void GenerateTestCase(Ty _a, Ty _b) {
 	std::cout << std::setprecision(precision);
 }
 
+namespace sw { namespace universal {
+
+	// with 128 bits or more the sum is rounded once more to double without double rounding
+	// artifacts, so the result must match the native double sum exactly
+	template<unsigned nlimbs>
+	int VerifyRandomEfloatAddition(bool reportTestCases, unsigned nrTests) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(0x5eed);
+		std::uniform_real_distribution<double> fraction(-1.0, 1.0);
+		std::uniform_int_distribution<int> exponent(-80, 80);
+		for (unsigned i = 0; i < nrTests; ++i) {
+			double da = std::ldexp(fraction(rng), exponent(rng));
+			double db = std::ldexp(fraction(rng), exponent(rng));
+			if (i % 8 == 0) db = -da * (1.0 + std::ldexp(1.0, -50));   // catastrophic cancellation
+			efloat<nlimbs> a(da), b(db);
+			double sum = double(a + b), difference = double(a - b);
+			if (sum != da + db) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << a << " + " << b << " = " << sum << " instead of " << da + db << '\n';
+			}
+			if (difference != da - db) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << a << " - " << b << " = " << difference << " instead of " << da - db << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// a sum of operands that are far apart is carried exactly as long as it fits in the limbs
+	template<unsigned nlimbs>
+	int VerifyExactEfloatAddition(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		for (int scale = 1; scale < static_cast<int>(32 * nlimbs) - 53; scale += 37) {
+			efloat<nlimbs> big(std::ldexp(1.0, scale)), tiny(0.1);
+			efloat<nlimbs> sum = big + tiny;
+			efloat<nlimbs> recovered = sum - big;
+			if (recovered != tiny) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << sum << " - " << big << " = " << recovered << " instead of " << tiny << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
 
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
 #define MANUAL_TESTING 0
@@ -74,12 +120,17 @@ try {
 #else  // !MANUAL_TESTING
 
 #if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomEfloatAddition<4>(reportTestCases, 10000), "efloat<4> vs double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyExactEfloatAddition<4>(reportTestCases), "efloat<4> exact sums", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomEfloatAddition<16>(reportTestCases, 10000), "efloat<16> vs double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyExactEfloatAddition<16>(reportTestCases), "efloat<16> exact sums", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomEfloatAddition<64>(reportTestCases, 100000), "efloat<64> vs double", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
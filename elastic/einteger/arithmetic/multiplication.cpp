@@ -10,6 +10,8 @@
 #include <string>
 #include <cmath>
 #include <limits>
+#include <random>
+#include <vector>
 
 // minimum set of include files to reflect source code dependencies
 #include <universal/number/einteger/einteger.hpp>
@@ -54,6 +56,43 @@ namespace sw { namespace universal {
 		return nrOfFailedTests;
 	}
 
+	// multiply random operands of nrLimbs x nrLimbs, nrLimbs x nrLimbs / 3, and nrLimbs squared,
+	// and compare the subquadratic kernels to the schoolbook multiplication
+	template<typename BlockType>
+	int VerifyLargeMultiplication(bool reportTestCases, unsigned nrLimbs) {
+		using Integer = einteger<BlockType>;
+		std::mt19937_64 rng(nrLimbs);
+		auto random = [&](unsigned n) {
+			Integer v;
+			for (unsigned i = 0; i < n; ++i) v.setblock(i, static_cast<BlockType>(rng()));
+			v.setblock(n - 1, static_cast<BlockType>(v.block(n - 1) | 1u));
+			return v;
+		};
+		auto reference = [](const Integer& a, const Integer& b) {
+			std::vector<BlockType> x(a.limbs()), y(b.limbs()), r(a.limbs() + b.limbs());
+			for (unsigned i = 0; i < a.limbs(); ++i) x[i] = a.block(i);
+			for (unsigned i = 0; i < b.limbs(); ++i) y[i] = b.block(i);
+			internal::limb_mul_basecase(r.data(), x.data(), x.size(), y.data(), y.size());
+			Integer c;
+			for (unsigned i = 0; i < r.size(); ++i) if (r[i] != 0) c.setblock(i, r[i]);
+			c.setsign(a.sign() ^ b.sign());
+			return c;
+		};
+
+		int nrOfFailedTests = 0;
+		Integer a = random(nrLimbs), b = -random(nrLimbs), c = random(nrLimbs / 3 + 1);
+		Integer products[3] = { a * b, a * c, a * a };
+		Integer references[3] = { reference(a, b), reference(a, c), reference(a, a) };
+		const char* labels[3] = { "balanced", "unbalanced", "square" };
+		for (int i = 0; i < 3; ++i) {
+			if (products[i] != references[i]) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL " << labels[i] << " product of " << nrLimbs << " limbs\n";
+			}
+		}
+		return nrOfFailedTests;
+	}
+
 } } // namespace sw::univeral
 
 // generate specific test case that you can trace with the trace conditions in mpreal.hpp
@@ -144,7 +183,20 @@ try {
 #endif
 
 #if REGRESSION_LEVEL_2
-
+	{
+		// operand sizes around the Karatsuba and Toom-3 thresholds
+		int nrOfFailures = 0;
+		for (unsigned nrLimbs : { 16u, 31u, 32u, 33u, 47u, 64u, 100u, 249u, 250u, 251u, 400u, 1000u }) {
+			nrOfFailures += VerifyLargeMultiplication<std::uint32_t>(reportTestCases, nrLimbs);
+		}
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "einteger<uint32_t> large", "karatsuba/toom3");
+		nrOfFailures = 0;
+		for (unsigned nrLimbs : { 40u, 200u, 700u }) {
+			nrOfFailures += VerifyLargeMultiplication<std::uint8_t>(reportTestCases, nrLimbs);
+			nrOfFailures += VerifyLargeMultiplication<std::uint16_t>(reportTestCases, nrLimbs);
+		}
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "einteger<uint8/16_t> large", "karatsuba/toom3");
+	}
 #endif
 
 #if REGRESSION_LEVEL_3
@@ -9,11 +9,47 @@
 #include <string>
 #include <cmath>
 #include <limits>
+#include <chrono>
+#include <random>
+#include <vector>
 
 // minimum set of include files to reflect source code dependencies
 #include <universal/number/einteger/einteger.hpp>
 #include <universal/verification/test_suite.hpp>
 
+namespace sw { namespace universal {
+
+	// time the products of n-limb operands with the schoolbook kernel and with the size-adaptive einteger multiplication
+	template<typename BlockType>
+	void MultiplicationPerformance(const std::string& blockTypeName, const std::vector<unsigned>& sizes) {
+		using Integer = einteger<BlockType>;
+		std::mt19937_64 rng(1);
+		std::cout << "einteger<" << blockTypeName << "> multiplication\n";
+		std::cout << std::setw(10) << "limbs" << std::setw(18) << "schoolbook (us)" << std::setw(18) << "multiply (us)" << std::setw(18) << "square (us)" << '\n';
+		for (unsigned n : sizes) {
+			Integer a, b, c;
+			std::vector<BlockType> x(n), y(n), r(2ull * n);
+			for (unsigned i = 0; i < n; ++i) {
+				x[i] = static_cast<BlockType>(rng() | 1u);
+				y[i] = static_cast<BlockType>(rng() | 1u);
+				a.setblock(i, x[i]);
+				b.setblock(i, y[i]);
+			}
+			unsigned reps = 4'000'000 / (n * n) + 1;
+			auto t0 = std::chrono::steady_clock::now();
+			for (unsigned i = 0; i < reps; ++i) internal::limb_mul_basecase(r.data(), x.data(), n, y.data(), n);
+			auto t1 = std::chrono::steady_clock::now();
+			for (unsigned i = 0; i < reps; ++i) c = a * b;
+			auto t2 = std::chrono::steady_clock::now();
+			for (unsigned i = 0; i < reps; ++i) c = a * a;
+			auto t3 = std::chrono::steady_clock::now();
+			auto usec = [reps](auto begin, auto end) { return std::chrono::duration<double, std::micro>(end - begin).count() / reps; };
+			std::cout << std::setw(10) << n << std::setw(18) << usec(t0, t1) << std::setw(18) << usec(t1, t2) << std::setw(18) << usec(t2, t3) << '\n';
+		}
+	}
+
+}}  // namespace sw::universal
+
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
 #define MANUAL_TESTING 1
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
@@ -43,6 +79,9 @@ try {
 
 #if MANUAL_TESTING
 
+	MultiplicationPerformance<std::uint32_t>("uint32_t", { 8, 16, 32, 64, 128, 256, 512, 1024, 2048 });
+	MultiplicationPerformance<std::uint16_t>("uint16_t", { 64, 256, 1024 });
+
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
 	return EXIT_SUCCESS; // ignore failures
 #else
@@ -0,0 +1,154 @@
+// add.cpp: test runner for addition on adaptive precision multi-component floating-point
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <random>
+
+// minimum set of include files to reflect source code dependencies
+#include <universal/number/ereal/ereal.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// generate specific test case that you can trace with the trace conditions in mpreal.hpp
+// for most bugs they are traceable with _trace_conversion and _trace_add
+template<typename Ty>
+void GenerateTestCase(Ty _a, Ty _b) {
+	Ty ref;
+	sw::universal::ereal<> a, b, aref, asum;
+	a = _a;
+	b = _b;
+	asum = a + b;
+	ref = _a + _b;
+	aref = ref;
+
+	auto precision = std::cout.precision();
+	constexpr size_t ndigits = std::numeric_limits<Ty>::digits10;
+	std::cout << std::setprecision(ndigits);
+	std::cout << std::setw(ndigits) << _a << " + " << std::setw(ndigits) << _b << " = " << std::setw(ndigits) << ref << std::endl;
+	std::cout << a << " + " << b << " = " << asum << " (reference: " << aref << ")   " ;
+	std::cout << (aref == asum ? "PASS" : "FAIL") << std::endl << std::endl;
+	std::cout << std::setprecision(precision);
+}
+
+namespace sw { namespace universal {
+
+	// the sum of two doubles is exact as an expansion and converts back to double with a single
+	// rounding, so the result must match the native double sum exactly
+	template<unsigned nlimbs>
+	int VerifyRandomErealAddition(bool reportTestCases, unsigned nrTests) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(0x5eed);
+		std::uniform_real_distribution<double> fraction(-1.0, 1.0);
+		std::uniform_int_distribution<int> exponent(-80, 80);
+		for (unsigned i = 0; i < nrTests; ++i) {
+			double da = std::ldexp(fraction(rng), exponent(rng));
+			double db = std::ldexp(fraction(rng), exponent(rng));
+			if (i % 8 == 0) db = -da * (1.0 + std::ldexp(1.0, -50));   // catastrophic cancellation
+			ereal<nlimbs> a(da), b(db);
+			double sum = double(a + b), difference = double(a - b);
+			if (sum != da + db) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << a << " + " << b << " = " << sum << " instead of " << da + db << '\n';
+			}
+			if (difference != da - db) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << a << " - " << b << " = " << difference << " instead of " << da - db << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// a sum of operands that are far apart is carried exactly in two components, whatever the distance
+	template<unsigned nlimbs>
+	int VerifyExactErealAddition(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		for (int scale = 1; scale < 1000; scale += 37) {
+			ereal<nlimbs> big(std::ldexp(1.0, scale)), tiny(0.1);
+			ereal<nlimbs> sum = big + tiny;
+			ereal<nlimbs> recovered = sum - big;
+			if (recovered != tiny) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << sum << " - " << big << " = " << recovered << " instead of " << tiny << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "elastic precision floating-point arithmetic validation";
+	std::string test_tag    = "ereal addition";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+//	bool bReportIndividualTestCases = false;
+
+	// generate individual testcases to hand trace/debug
+	GenerateTestCase(INFINITY, INFINITY);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else  // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomErealAddition<4>(reportTestCases, 10000), "ereal<4> vs double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyExactErealAddition<4>(reportTestCases), "ereal<4> exact sums", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomErealAddition<16>(reportTestCases, 10000), "ereal<16> vs double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyExactErealAddition<16>(reportTestCases), "ereal<16> exact sums", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomErealAddition<64>(reportTestCases, 100000), "ereal<64> vs double", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,155 @@
+// division.cpp: test runner for division on adaptive precision multi-component floating-point
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+
+// minimum set of include files to reflect source code dependencies
+#include <universal/number/ereal/ereal.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// generate specific test case that you can trace with the trace conditions in mpreal.hpp
+// for most bugs they are traceable with _trace_conversion and _trace_div
+template<typename Ty>
+void GenerateTestCase(Ty _a, Ty _b) {
+	Ty ref;
+	sw::universal::ereal<> a, b, aref, aresult;
+	a = _a;
+	b = _b;
+	aresult = a / b;
+	ref = _a / _b;
+	aref = ref;
+
+	auto precision = std::cout.precision();
+	constexpr size_t ndigits = std::numeric_limits<Ty>::digits10;
+	std::cout << std::setprecision(ndigits);
+	std::cout << std::setw(ndigits) << _a << " / " << std::setw(ndigits) << _b << " = " << std::setw(ndigits) << ref << std::endl;
+	std::cout << a << " / " << b << " = " << aresult << " (reference: " << aref << ")   " ;
+	std::cout << (aref == aresult ? "PASS" : "FAIL") << std::endl << std::endl;
+	std::cout << std::setprecision(precision);
+}
+
+namespace sw { namespace universal {
+
+	// the quotient carries several components, so rounding it to double
+	// must match the native double quotient
+	template<unsigned nlimbs>
+	int VerifyRandomErealDivision(bool reportTestCases, unsigned nrTests) {
+		int nrOfFailedTests = 0;
+		std::mt19937_64 rng(0x5eed);
+		std::uniform_real_distribution<double> fraction(-1.0, 1.0);
+		std::uniform_int_distribution<int> exponent(-200, 200);
+		for (unsigned i = 0; i < nrTests; ++i) {
+			double da = std::ldexp(fraction(rng), exponent(rng));
+			double db = std::ldexp(fraction(rng), exponent(rng));
+			if (db == 0.0) continue;
+			ereal<nlimbs> a(da), b(db);
+			double quotient = double(a / b);
+			if (quotient != da / db) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << a << " / " << b << " = " << quotient << " instead of " << da / db << '\n';
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// the decimal expansion of 1/7 repeats 142857 for the full precision of the quotient
+	template<unsigned nlimbs>
+	int VerifyErealReciprocal(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		ereal<nlimbs> one(1), seven(7);
+		ereal<nlimbs> reciprocal = one / seven;
+		std::stringstream s;
+		int nrDigits = static_cast<int>(15.9 * nlimbs) - 2;   // 53 * log10(2) digits per limb
+		s << std::setprecision(nrDigits) << reciprocal;
+		std::string digits = s.str().substr(2);
+		for (size_t i = 0; i + 1 < digits.size(); ++i) {
+			if (digits[i] != "142857"[i % 6]) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: 1/7 = " << s.str() << '\n';
+				break;
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main(int argc, char** argv)
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "elastic precision floating-point arithmetic validation";
+	std::string test_tag    = "ereal division";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+//	bool bReportIndividualTestCases = false;
+
+	// generate individual testcases to hand trace/debug
+	GenerateTestCase(1.5, 0.25);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else  // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomErealDivision<4>(reportTestCases, 10000), "ereal<4> vs double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyErealReciprocal<4>(reportTestCases), "ereal<4> 1/7", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomErealDivision<16>(reportTestCases, 10000), "ereal<16> vs double", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyErealReciprocal<16>(reportTestCases), "ereal<16> 1/7", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyRandomErealDivision<64>(reportTestCases, 100000), "ereal<64> vs double", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
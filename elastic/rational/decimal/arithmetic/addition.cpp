@@ -10,6 +10,30 @@
 #include <universal/number/erational/erational.hpp>
 #include <universal/verification/test_suite.hpp>
 
+namespace sw { namespace universal {
+
+	// the harmonic number H(50) = sum 1/k accumulates denominators that share many factors,
+	// which exercises the gcd of the denominators in the addition path
+	inline int VerifyHarmonicSum(bool reportTestCases) {
+		erational sum(0), one(1);
+		for (int k = 1; k <= 50; ++k) {
+			sum += one / erational(k);
+		}
+		edecimal numerator, denominator;
+		numerator.parse("13943237577224054960759");
+		denominator.parse("3099044504245996706400");
+		erational h;
+		h.setnumerator(numerator);
+		h.setdenominator(denominator);
+		if (sum != h) {
+			if (reportTestCases) std::cerr << "FAIL: H(50) = " << sum << " expected " << h << '\n';
+			return 1;
+		}
+		return 0;
+	}
+
+}} // namespace sw::universal
+
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
 #define MANUAL_TESTING 1
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
@@ -43,6 +67,7 @@ try {
 	Rational r{1.2345};
 	std::cout << r << '\n';
 
+	nrOfFailedTestCases += ReportTestResult(VerifyHarmonicSum(true), "harmonic sum", test_tag);
 
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
@@ -50,6 +75,7 @@ try {
 #else // !MANUAL_TESTING
 
 #if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyHarmonicSum(reportTestCases), "harmonic sum", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_2
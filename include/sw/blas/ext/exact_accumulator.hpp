@@ -0,0 +1,216 @@
+#pragma once
+// exact_accumulator.hpp: exact dot product accumulators for Universal and native number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <universal/number/posit/posit_fwd.hpp>
+#include <universal/number/cfloat/cfloat_fwd.hpp>
+#include <universal/number/fixpnt/fixpnt_fwd.hpp>
+#include <universal/number/lns/lns_fwd.hpp>
+#include <universal/number/bfloat/bfloat16_fwd.hpp>
+#include <universal/number/float/quire.hpp>
+
+namespace sw { namespace blas {
+
+///////////////////////////////////////////////////////////////////////////////////
+// exact_accumulator<Scalar> is the trait that selects the accumulator of a fused dot product:
+// products are added without rounding and the sum is rounded once in resolve().
+//
+//   exact_accumulator<Scalar> acc;
+//   for (...) acc.add_product(a, b);
+//   Scalar r = acc.resolve();
+//
+// capacity is the log2 of the number of products that can be accumulated without overflow.
+// Number systems without a specialization do not have an exact accumulator.
+template<typename Scalar, unsigned capacity = 20>
+class exact_accumulator {
+	static_assert(!std::is_same_v<Scalar, Scalar>, "exact_accumulator: no exact accumulator is defined for this number system");
+};
+
+// makes a forward declared class a dependent type so that it only needs to be complete at instantiation
+template<typename T, unsigned>
+struct deferred_type { using type = T; };
+
+// IEEE-754 semantics of non-finite products: they bypass the accumulator and are resolved at the end
+class nonfinite_state {
+public:
+	void clear() { _nan = _posinf = _neginf = false; }
+	// returns true when the product of a and b is not finite and has been recorded
+	template<typename Real>
+	bool record(Real a, Real b) {
+		if (std::isfinite(a) && std::isfinite(b)) return false;
+		if (std::isnan(a) || std::isnan(b) || a == 0 || b == 0) { _nan = true; return true; }
+		if (std::signbit(a) != std::signbit(b)) _neginf = true; else _posinf = true;
+		return true;
+	}
+	bool any() const { return _nan || _posinf || _neginf; }
+	double value() const {
+		if (_nan || (_posinf && _neginf)) return std::numeric_limits<double>::quiet_NaN();
+		return (_posinf ? std::numeric_limits<double>::infinity() : -std::numeric_limits<double>::infinity());
+	}
+private:
+	bool _nan{ false }, _posinf{ false }, _neginf{ false };
+};
+
+// accumulator for a binary floating-point format that is a subset of double:
+// operands are embedded exactly in double, and the quire of the format with
+// the given (nbits, es) accumulates the unrounded products of the embeddings.
+// A format without subnormals flushes the products and the sum whose unrounded
+// scale is below the normal range to zero, as the cfloat arithmetic does.
+template<unsigned nbits, unsigned es, unsigned precision, int minScale, unsigned capacity, bool subnormals = true>
+class ieee_accumulator {
+	static constexpr int minNormalScale = minScale + int(precision) - 1;
+public:
+	void clear() { _q.clear(); _special.clear(); }
+	void add(double a, double b) {
+		if (_special.record(a, b)) return;
+		if constexpr (!subnormals) {
+			if (a == 0.0 || b == 0.0) return;
+			// the scale of the exact product: with |a| = ma 2^ea and |b| = mb 2^eb, ma and mb in [0.5, 1),
+			// the significand product is in [1, 4) and reaches 2 when ma mb >= 0.5, which fma decides exactly
+			int ea, eb;
+			double ma = std::frexp(std::abs(a), &ea), mb = std::frexp(std::abs(b), &eb);
+			int scale = (ea - 1) + (eb - 1) + (std::fma(ma, mb, -0.5) >= 0.0 ? 1 : 0);
+			if (scale < minNormalScale) return;
+		}
+		_q += sw::ieee::quire_mul(a, b);
+	}
+	// the one and only rounding step: round to nearest, ties to even, onto the grid of the target format
+	double resolve() const {
+		if (_special.any()) return _special.value();
+		if constexpr (!subnormals) {
+			if (!_q.iszero() && _q.scale() < minNormalScale) return (_q.isneg() ? -0.0 : 0.0);
+		}
+		return _q.to_double(precision, minScale);
+	}
+private:
+	sw::ieee::quire<nbits, es, capacity> _q;
+	nonfinite_state _special;
+};
+
+// posits accumulate in their own quire
+template<unsigned nbits, unsigned es, unsigned capacity>
+class exact_accumulator<sw::universal::posit<nbits, es>, capacity> {
+	using Scalar = sw::universal::posit<nbits, es>;
+public:
+	void clear() { _q.clear(); _nar = false; }
+	void add_product(const Scalar& a, const Scalar& b) {
+		if (a.isnar() || b.isnar()) { _nar = true; return; }
+		_q += sw::universal::quire_mul(a, b);
+	}
+	Scalar resolve() const {
+		Scalar r;
+		if (_nar) { r.setnar(); return r; }
+		sw::universal::convert(_q.to_value(), r);
+		return r;
+	}
+private:
+	sw::universal::quire<nbits, es, capacity> _q;
+	bool _nar{ false };
+};
+
+// cfloats that embed in double accumulate in the IEEE quire of their configuration
+template<unsigned nbits, unsigned es, typename bt, bool hasSubnormals, bool hasSupernormals, bool isSaturating, unsigned capacity>
+class exact_accumulator<sw::universal::cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>, capacity> {
+	using Scalar = sw::universal::cfloat<nbits, es, bt, hasSubnormals, hasSupernormals, isSaturating>;
+	static_assert(nbits - es <= 53 && es <= 11, "exact_accumulator: cfloat configuration does not embed in double");
+	static constexpr int minScale = 2 - (1 << (es - 1)) - int(nbits - 1 - es);  // scale of the smallest subnormal
+public:
+	void clear() { _acc.clear(); }
+	void add_product(const Scalar& a, const Scalar& b) { _acc.add(double(a), double(b)); }
+	Scalar resolve() const { return Scalar(_acc.resolve()); }
+private:
+	ieee_accumulator<nbits, es, nbits - es, minScale, capacity, hasSubnormals> _acc;
+};
+
+// fixpnts accumulate in a wide fixpnt: the full product of two fixpnt<nbits, rbits> is a fixpnt<2*nbits, 2*rbits>,
+// and the capacity bits above it absorb the carries of the sum
+template<unsigned nbits, unsigned rbits, bool arithmetic, typename bt, unsigned capacity>
+class exact_accumulator<sw::universal::fixpnt<nbits, rbits, arithmetic, bt>, capacity> {
+	using Scalar = sw::universal::fixpnt<nbits, rbits, arithmetic, bt>;
+	static constexpr unsigned abits = 2 * nbits + capacity;
+	static constexpr bool modulo = true;  // fixpnt Modulo arithmetic
+	using Accumulator = sw::universal::fixpnt<abits, 2 * rbits, modulo, bt>;
+public:
+	void clear() { _acc.setzero(); }
+	void add_product(const Scalar& a, const Scalar& b) {
+		Accumulator product;
+		product = urmul2(a.bits(), b.bits());  // sign-extends the 2*nbits product
+		_acc += product;
+	}
+	Scalar resolve() const {
+		auto c = _acc.bits();
+		bool roundUp = c.roundingMode(rbits);
+		c >>= rbits;
+		if (roundUp) ++c;
+		Scalar r;
+		if constexpr (arithmetic != modulo) {
+			Scalar maxpos(sw::universal::SpecificValue::maxpos), maxneg(sw::universal::SpecificValue::maxneg);
+			decltype(c) saturation = maxpos.bits();
+			if (c >= saturation) return maxpos;
+			saturation = maxneg.bits();
+			if (c < saturation) return maxneg;
+		}
+		r = c;  // select the lower nbits of the result
+		return r;
+	}
+private:
+	Accumulator _acc{ 0 };
+};
+
+// lns values are converted to double, and their products are accumulated in the Kulisch register of double.
+// The result is double-rounded: the exact sum is rounded to double, and the double is rounded to lns in the
+// log domain. The two steps can differ from the correctly rounded lns when the sum lies within half a double
+// ulp of an lns rounding boundary, so the result is reproducible, but not guaranteed to be correctly rounded.
+template<unsigned nbits, unsigned rbits, typename bt, auto... xtra, unsigned capacity>
+class exact_accumulator<sw::universal::lns<nbits, rbits, bt, xtra...>, capacity> {
+	using Scalar = sw::universal::lns<nbits, rbits, bt, xtra...>;
+public:
+	void clear() { _acc.clear(); }
+	void add_product(const Scalar& a, const Scalar& b) { _acc.add(double(a), double(b)); }
+	Scalar resolve() const { return Scalar(_acc.resolve()); }
+private:
+	ieee_accumulator<64, 11, 53, -1074, capacity> _acc;
+};
+
+// bfloat16 embeds in float
+template<unsigned capacity>
+class exact_accumulator<sw::universal::bfloat16, capacity> {
+	using Scalar = typename deferred_type<sw::universal::bfloat16, capacity>::type;
+public:
+	void clear() { _acc.clear(); }
+	void add_product(const Scalar& a, const Scalar& b) { _acc.add(double(float(a)), double(float(b))); }
+	Scalar resolve() const { return Scalar(float(_acc.resolve())); }
+private:
+	ieee_accumulator<16, 8, 8, -133, capacity> _acc;
+};
+
+// native IEEE-754 single precision
+template<unsigned capacity>
+class exact_accumulator<float, capacity> {
+public:
+	void clear() { _acc.clear(); }
+	void add_product(float a, float b) { _acc.add(a, b); }
+	float resolve() const { return float(_acc.resolve()); }
+private:
+	ieee_accumulator<32, 8, 24, -149, capacity> _acc;
+};
+
+// native IEEE-754 double precision uses a Kulisch register that spans the full exponent range
+template<unsigned capacity>
+class exact_accumulator<double, capacity> {
+public:
+	void clear() { _acc.clear(); }
+	void add_product(double a, double b) { _acc.add(a, b); }
+	double resolve() const { return _acc.resolve(); }
+private:
+	ieee_accumulator<64, 11, 53, -1074, capacity> _acc;
+};
+
+}} // namespace sw::blas
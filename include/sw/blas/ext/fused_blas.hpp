@@ -0,0 +1,104 @@
+#pragma once
+// fused_blas.hpp: reproducible dot, matrix-vector, and matrix-matrix products for any number system with an exact accumulator
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cassert>
+#include <numeric/containers.hpp>
+#include <blas/exceptions.hpp>
+#include <blas/ext/exact_accumulator.hpp>
+
+namespace sw { namespace blas {
+	using namespace sw::numeric::containers;
+
+///////////////////////////////////////////////////////////////////////////////////
+// fused dot product: the products are accumulated exactly and the sum is rounded once,
+// so the result is independent of the order of the elements
+// (lns is the exception to the single rounding: its sum is rounded to double and then to lns)
+template<typename Vector>
+typename Vector::value_type fused_dot(size_t n, const Vector& x, size_t incx, const Vector& y, size_t incy) {
+	exact_accumulator<typename Vector::value_type> acc;
+	size_t ix{ 0 }, iy{ 0 };
+	for (size_t i = 0; i < n; ++i, ix += incx, iy += incy) {
+		acc.add_product(x[ix], y[iy]);
+	}
+	return acc.resolve();
+}
+
+template<typename Vector>
+typename Vector::value_type fused_dot(const Vector& x, const Vector& y) {
+	assert(size(x) == size(y));
+	return fused_dot(size(x), x, 1, y, 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+// fused matrix-vector product: A times x = b with one rounding per element of b
+template<typename Scalar>
+vector<Scalar> fused_matvec(const matrix<Scalar>& A, const vector<Scalar>& x) {
+	if (A.cols() != size(x)) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), size(x), 1, "*").what());
+	size_t rows = A.rows();
+	size_t cols = A.cols();
+	vector<Scalar> b(rows);
+	exact_accumulator<Scalar> acc;
+	for (size_t i = 0; i < rows; ++i) {
+		acc.clear();
+		for (size_t j = 0; j < cols; ++j) {
+			acc.add_product(A(i, j), x[j]);
+		}
+		b[i] = acc.resolve();
+	}
+	return b;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+// fused sparse matrix-vector product: only the stored elements contribute to the accumulation.
+// A CSC matrix is transposed to CSR first, so that one accumulator serves all rows.
+template<typename Scalar, SparseFormat format>
+vector<Scalar> fused_matvec(const sparse_matrix<Scalar, format>& A, const vector<Scalar>& x) {
+	if (A.cols() != size(x)) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), size(x), 1, "*").what());
+	if constexpr (format == SparseFormat::CSC) {
+		return fused_matvec(sparse_matrix<Scalar, SparseFormat::CSR>(A), x);
+	}
+	else {
+		const auto& offsets = A.offsets();
+		const auto& indices = A.indices();
+		const auto& values = A.values();
+		size_t rows = A.rows();
+		vector<Scalar> b(rows);
+		exact_accumulator<Scalar> acc;
+		for (size_t i = 0; i < rows; ++i) {
+			acc.clear();
+			for (auto k = offsets[i]; k < offsets[i + 1]; ++k) {
+				acc.add_product(values[k], x[indices[k]]);
+			}
+			b[i] = acc.resolve();
+		}
+		return b;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+// fused matrix-matrix product: A times B = C with one rounding per element of C
+template<typename Scalar>
+matrix<Scalar> fused_gemm(const matrix<Scalar>& A, const matrix<Scalar>& B) {
+	if (A.cols() != B.rows()) throw matmul_incompatible_matrices(incompatible_matrices(A.rows(), A.cols(), B.rows(), B.cols(), "*").what());
+	size_t rows = A.rows();
+	size_t cols = B.cols();
+	size_t dots = A.cols();
+	matrix<Scalar> C(rows, cols);
+	exact_accumulator<Scalar> acc;
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < cols; ++j) {
+			acc.clear();
+			for (size_t k = 0; k < dots; ++k) {
+				acc.add_product(A(i, k), B(k, j));
+			}
+			C(i, j) = acc.resolve();
+		}
+	}
+	return C;
+}
+
+}} // namespace sw::blas
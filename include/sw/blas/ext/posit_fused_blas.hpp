@@ -16,7 +16,7 @@ namespace sw { namespace blas {
 ///////////////////////////////////////////////////////////////////////////////////
 // fused matrix-vector product
 //  
-// TODO: how would you generalize this to posits, cfloats, lns, integer, or even native int and float?
+// fused_matvec in <blas/ext/fused_blas.hpp> generalizes this to any number system with an exact_accumulator
 //
 // A times x = b fused matrix-vector product
 template<unsigned nbits, unsigned es>
@@ -62,7 +62,7 @@ vector< sw::universal::posit<nbits, es> > fmv(const matrix< sw::universal::posit
 ///////////////////////////////////////////////////////////////////////////////////
 // fused matrix-matrix product
 //  
-// TODO: how to generalize this to posit, cfloat, lns, integer, etc.
+// fused_gemm in <blas/ext/fused_blas.hpp> generalizes this to any number system with an exact_accumulator
 //
 // A times B = C fused matrix-vector product
 template<unsigned nbits, unsigned es>
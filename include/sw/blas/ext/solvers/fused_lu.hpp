@@ -0,0 +1,46 @@
+#pragma once
+// fused_lu.hpp: blocked LU decomposition with the trailing update fused through an exact accumulator
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <vector>
+#include <blas/solvers/lu.hpp>
+#include <blas/ext/exact_accumulator.hpp>
+
+namespace sw { namespace blas {
+
+///////////////////////////////////////////////////////////////////////////////////
+// trailing update A22 -= L21 * U12 with one rounding per element of A22:
+// the element and the kb products of the panel are accumulated exactly before they are rounded.
+// Plug into the blocked LU as LUP<Scalar, lu_fused_update<Scalar>>.
+template<typename Scalar, unsigned capacity = 20>
+struct lu_fused_update {
+	void operator()(size_t m, size_t n, size_t k, const Scalar* L21, const Scalar* U12, Scalar* A22, size_t lda, sw::universal::thread_pool* pool) const {
+		// U12 transposed, so that the inner loop runs over contiguous memory
+		std::vector<Scalar> Ut(n * k);
+		for (size_t p = 0; p < k; ++p) {
+			for (size_t j = 0; j < n; ++j) Ut[j * k + p] = U12[p * lda + j];
+		}
+		const Scalar one(1);
+		solvers::lu_parallel_for(pool, m, [&](size_t i) {
+			exact_accumulator<Scalar, capacity> acc;
+			const Scalar* l = L21 + i * lda;
+			Scalar* a = A22 + i * lda;
+			for (size_t j = 0; j < n; ++j) {
+				const Scalar* u = Ut.data() + j * k;
+				acc.clear();
+				acc.add_product(a[j], one);
+				for (size_t p = 0; p < k; ++p) acc.add_product(-l[p], u[p]);
+				a[j] = acc.resolve();
+			}
+		});
+	}
+};
+
+// LUP decomposition with the quire fused trailing update
+template<typename Scalar>
+using fused_LUP = solvers::LUP<Scalar, lu_fused_update<Scalar>>;
+
+}} // namespace sw::blas
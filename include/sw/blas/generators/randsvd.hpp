@@ -1,32 +1,41 @@
 #pragma once
-// trigonometry.hpp: vectorized trigonometry functions
+// randsvd.hpp: randomized singular value decomposition
 //
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <tuple>
 #include <blas/blas.hpp>
 #include <blas/generators/gaussian_random.hpp>
 
 namespace sw { namespace blas {  
 	using namespace sw::numeric::containers;
 
+    // randomized SVD: project A onto the range of A times a gaussian test matrix and
+    // decompose the small projected matrix, returns U, S, V with A ~ U S V^T
     template<typename Scalar>
     std::tuple<matrix<Scalar>,matrix<Scalar>, matrix<Scalar>> randsvd(const matrix<Scalar>& A) {
         size_t k = std::min(num_cols(A), num_rows(A));
-        size_t n = num_cols(A), m = num_rows(A);                
-        matrix<Scalar> omega(n, k),Y(m, k), B(k, n);
+        size_t n = num_cols(A), m = num_rows(A);
+        matrix<Scalar> omega(n, k), Y(m, k);
         double mean = 1.0;
         double stddev = 0.5;
         gaussian_random(omega, mean, stddev);
         Y = A * omega;
-        matrix<Scalar> Q(n, k), R(n, n);
+        // orthonormal basis of the range of Y
+        matrix<Scalar> Q, R;
         std::tie(Q, R) = solvers::qr(Y);
-        Q.transpose();
-        B = Q * A;
-        matrix<Scalar> S(n, k), V(n, n), D(n, n);
-        std::tie(S, V, D) = solvers::svd(B,k);
-        return std::make_tuple(S, V, D);
+        matrix<Scalar> Qk(m, k), Qt(k, m);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < k; ++j) Qt(j, i) = Qk(i, j) = Q(i, j);
+        }
+        matrix<Scalar> B = Qt * A;
+        matrix<Scalar> Ub, S, V;
+        std::tie(Ub, S, V) = solvers::svd(B);
+        matrix<Scalar> U = Qk * Ub;
+        return std::make_tuple(U, S, V);
     }
 
 }} // namespace sw::blas
\ No newline at end of file
@@ -6,15 +6,20 @@
 // SPDX-License-Identifier: MIT 
 // 
 // This file is part of the universal numbers project.
+#include <cstring>
 #include <iostream>
+#include <fstream>
 #include <vector>
 #include <list>
 #include <map>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
 // the arithmetic types datafile is supporting
 #include <universal/number_systems.hpp>
 // the aggregation types that datafile is supporting
 #include <numeric/containers.hpp>
+#include <blas/serialization/mapped_file.hpp>
  
 namespace sw { namespace blas {
     using namespace sw::numeric::containers;
@@ -170,6 +175,75 @@ namespace sw { namespace blas {
         }
     }
 
+    /*
+        Binary format: the raw encodings of the elements are stored, so saving is a block write
+        and restoring needs no parsing. All fields are in the byte order of the machine that wrote
+        the file, and every block starts at a multiple of 8 bytes so a memory-mapped file can be
+        used in place.
+
+          file header   : magic number, byte order mark, version, number of records
+          record header : type id and parameters (as generated by generateScalarTypeId),
+                          aggregation type, element size, rows, columns, number of elements,
+                          length of the name
+          name          : the name of the data structure, padded to 8 bytes
+          data          : the raw elements in storage order, padded to 8 bytes
+     */
+    constexpr uint32_t UNIVERSAL_DATA_FILE_BYTE_ORDER_MARK = 0x01020304;
+    constexpr uint32_t UNIVERSAL_DATA_FILE_BINARY_VERSION = 1;
+
+    struct BinaryDataFileHeader {
+        uint32_t magicNumber{ UNIVERSAL_DATA_FILE_MAGIC_NUMBER };
+        uint32_t byteOrderMark{ UNIVERSAL_DATA_FILE_BYTE_ORDER_MARK };
+        uint32_t version{ UNIVERSAL_DATA_FILE_BINARY_VERSION };
+        uint32_t nrRecords{ 0 };
+    };
+    static_assert(sizeof(BinaryDataFileHeader) == 16, "BinaryDataFileHeader must not contain padding");
+
+    struct BinaryRecordHeader {
+        uint32_t typeId{ UNIVERSAL_UNKNOWN_ARITHMETIC_TYPE };
+        uint32_t nrParameters{ 0 };
+        uint32_t parameter[16]{ 0 };
+        uint32_t aggregationType{ 0 };
+        uint32_t elementSize{ 0 };
+        uint64_t rows{ 0 };
+        uint64_t cols{ 0 };
+        uint64_t nrElements{ 0 };
+        uint32_t nameLength{ 0 };
+        uint32_t reserved{ 0 };
+    };
+    static_assert(sizeof(BinaryRecordHeader) == 112, "BinaryRecordHeader must not contain padding");
+
+    constexpr size_t binaryPadding(size_t nrBytes) { return (8 - (nrBytes & 7)) & 7; }
+
+    inline void writeBinaryPadding(std::ostream& ostr, size_t nrBytes) {
+        static const char zeros[8]{ 0 };
+        ostr.write(zeros, static_cast<std::streamsize>(binaryPadding(nrBytes)));
+    }
+
+    // the record header of a data structure of Scalar elements
+    template<typename Scalar>
+    BinaryRecordHeader generateRecordHeader(uint32_t aggregationType, uint64_t rows, uint64_t cols) {
+        BinaryRecordHeader record;
+        generateScalarTypeId<Scalar>(record.typeId, record.nrParameters, record.parameter);
+        record.aggregationType = aggregationType;
+        record.elementSize = static_cast<uint32_t>(sizeof(Scalar));
+        record.rows = rows;
+        record.cols = cols;
+        record.nrElements = rows * cols;
+        return record;
+    }
+
+    // a record only matches a Scalar with the same encoding
+    template<typename Scalar>
+    bool recordHoldsScalar(const BinaryRecordHeader& record) {
+        BinaryRecordHeader expected = generateRecordHeader<Scalar>(record.aggregationType, 0, 0);
+        if (record.typeId != expected.typeId || record.elementSize != expected.elementSize || record.nrParameters != expected.nrParameters) return false;
+        for (uint32_t i = 0; i < record.nrParameters; ++i) {
+            if (record.parameter[i] != expected.parameter[i]) return false;
+        }
+        return true;
+    }
+
     std::string collectionType(uint32_t aggregationType) {
         std::string t{""};
         switch (aggregationType) {
@@ -267,6 +341,7 @@ namespace sw { namespace blas {
     class ICollection {
     public:
         virtual void save(std::ostream&, bool) const = 0;
+        virtual bool saveBinary(std::ostream&, const std::string&) const = 0;
         virtual void restore(std::istream&) = 0;
         virtual ~ICollection() {}
     };
@@ -313,6 +388,32 @@ namespace sw { namespace blas {
             }
         }
 
+        // the override is instantiated with the class, so element types that cannot be stored as raw
+        // encodings fail at run time, and only when a binary datafile is saved
+        bool saveBinary(std::ostream& ostr, const std::string& name) const override {
+            using Scalar = typename CollectionType::value_type;
+            if constexpr (!std::is_trivially_copyable_v<Scalar>) {
+                ostr.setstate(std::ios::failbit);
+                return false;
+            }
+            else {
+                uint64_t rows = collection.size(), cols = 1;
+                if constexpr (CollectionType::AggregationType == UNIVERSAL_AGGREGATE_MATRIX) {
+                    rows = collection.rows();
+                    cols = collection.cols();
+                }
+                BinaryRecordHeader record = generateRecordHeader<Scalar>(CollectionType::AggregationType, rows, cols);
+                record.nameLength = static_cast<uint32_t>(name.size());
+                ostr.write(reinterpret_cast<const char*>(&record), sizeof(record));
+                ostr.write(name.data(), static_cast<std::streamsize>(name.size()));
+                writeBinaryPadding(ostr, name.size());
+                size_t nrBytes = record.nrElements * sizeof(Scalar);
+                if (nrBytes > 0) ostr.write(reinterpret_cast<const char*>(std::to_address(collection.begin())), static_cast<std::streamsize>(nrBytes));
+                writeBinaryPadding(ostr, nrBytes);
+                return ostr.good();
+            }
+        }
+
         void restore(std::istream& istr) override {
             int v;
             istr >> v;
@@ -369,6 +470,15 @@ namespace sw { namespace blas {
         }
 
 		bool save(std::ostream& ostr, bool hex = false) const {
+            if constexpr (SerializationFormat == BinaryFormat) {
+                BinaryDataFileHeader header;
+                header.nrRecords = static_cast<uint32_t>(dataStructures.size());
+                ostr.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                for (size_t i = 0; i < dataStructures.size(); ++i) {
+                    if (!dataStructures[i]->saveBinary(ostr, dsName[i])) return false;
+                }
+                return ostr.good();
+            }
             ostr << UNIVERSAL_DATA_FILE_MAGIC_NUMBER << '\n';
             unsigned i = 0;
             for (const auto& ds : dataStructures) {
@@ -465,6 +575,9 @@ namespace sw { namespace blas {
         }
 
 		bool restore(std::istream& istr) {
+            if constexpr (SerializationFormat == BinaryFormat) {
+                return false;  // binary datafiles are restored through a mapped_datafile
+            }
             constexpr bool TraceParse = true;
             uint32_t magic_number;
             istr >> magic_number;
@@ -522,4 +635,135 @@ namespace sw { namespace blas {
         std::vector<std::string> dsName;
 	};
 
+    // read-only view of the elements of a record in a memory-mapped binary datafile
+    template<typename Scalar>
+    class mapped_array {
+    public:
+        typedef Scalar        value_type;
+        typedef const Scalar* const_iterator;
+
+        mapped_array(const Scalar* data, size_t rows, size_t cols) : _data{ data }, _rows{ rows }, _cols{ cols } {}
+
+        const Scalar& operator[](size_t i) const noexcept { return _data[i]; }
+        const Scalar& operator()(size_t i) const noexcept { return _data[i]; }
+        const Scalar& operator()(size_t i, size_t j) const noexcept { return _data[i * _cols + j]; }
+
+        const Scalar* data() const noexcept { return _data; }
+        size_t size() const noexcept { return _rows * _cols; }
+        size_t rows() const noexcept { return _rows; }
+        size_t cols() const noexcept { return _cols; }
+        const_iterator begin() const noexcept { return _data; }
+        const_iterator end() const noexcept { return _data + size(); }
+
+    private:
+        const Scalar* _data;
+        size_t _rows, _cols;
+    };
+
+    // mapped_datafile restores a binary datafile by mapping it into memory: the records are
+    // indexed when the file is opened, and the elements are used in place or block copied
+    class mapped_datafile {
+    public:
+        explicit mapped_datafile(const std::string& filename) : file(filename) {
+            const std::byte* base = file.data();
+            size_t fileSize = file.size();
+            if (fileSize < sizeof(BinaryDataFileHeader)) throw std::runtime_error(filename + " is not a binary Universal datafile");
+            BinaryDataFileHeader header;
+            std::memcpy(&header, base, sizeof(header));
+            if (header.magicNumber != UNIVERSAL_DATA_FILE_MAGIC_NUMBER) throw std::runtime_error(filename + " is not a binary Universal datafile");
+            if (header.byteOrderMark != UNIVERSAL_DATA_FILE_BYTE_ORDER_MARK) throw std::runtime_error(filename + " was written with a different byte order");
+            if (header.version != UNIVERSAL_DATA_FILE_BINARY_VERSION) throw std::runtime_error(filename + " has an unsupported binary version");
+            size_t offset = sizeof(header);
+            for (uint32_t r = 0; r < header.nrRecords; ++r) {
+                Record rec;
+                if (offset + sizeof(BinaryRecordHeader) > fileSize) throw std::runtime_error(filename + " is truncated");
+                std::memcpy(&rec.header, base + offset, sizeof(BinaryRecordHeader));
+                offset += sizeof(BinaryRecordHeader);
+                if (offset + rec.header.nameLength > fileSize) throw std::runtime_error(filename + " is truncated");
+                rec.name.assign(reinterpret_cast<const char*>(base + offset), rec.header.nameLength);
+                offset += rec.header.nameLength + binaryPadding(rec.header.nameLength);
+                if (offset > fileSize) throw std::runtime_error(filename + " is truncated");
+                if (!shapeMatches(rec.header)) throw std::runtime_error(filename + " record " + rec.name + " has an inconsistent shape");
+                // bound the element count by the remaining bytes before multiplying, so the size cannot wrap
+                if (rec.header.nrElements > 0 && (rec.header.elementSize == 0 || rec.header.nrElements > (fileSize - offset) / rec.header.elementSize)) throw std::runtime_error(filename + " is truncated");
+                size_t nrBytes = rec.header.nrElements * rec.header.elementSize;
+                rec.offset = offset;
+                offset += nrBytes + binaryPadding(nrBytes);
+                records.push_back(std::move(rec));
+            }
+        }
+
+        size_t size() const noexcept { return records.size(); }
+        std::vector<std::string> names() const {
+            std::vector<std::string> n;
+            for (const auto& rec : records) n.push_back(rec.name);
+            return n;
+        }
+        bool contains(const std::string& name) const noexcept { return find(name) != nullptr; }
+        // the record header, which carries the type id and the shape of the data structure
+        const BinaryRecordHeader& header(const std::string& name) const { return lookup(name).header; }
+
+        // zero-copy access to the elements of a record: the view is valid while the mapped_datafile lives
+        template<typename Scalar>
+        mapped_array<Scalar> view(const std::string& name) const {
+            static_assert(std::is_trivially_copyable_v<Scalar>, "binary serialization requires a trivially copyable element type");
+            static_assert(alignof(Scalar) <= 8, "records are aligned to 8 bytes");
+            const Record& rec = lookup(name);
+            switch (rec.header.aggregationType) {
+            case UNIVERSAL_AGGREGATE_SCALAR:
+            case UNIVERSAL_AGGREGATE_VECTOR:
+            case UNIVERSAL_AGGREGATE_MATRIX:
+                break;
+            default:
+                throw std::runtime_error("record " + name + " is not a scalar, vector, or matrix");
+            }
+            if (!recordHoldsScalar<Scalar>(rec.header)) throw std::runtime_error("record " + name + " holds a different arithmetic type");
+            return mapped_array<Scalar>(reinterpret_cast<const Scalar*>(file.data() + rec.offset), rec.header.rows, rec.header.cols);
+        }
+
+        // restore a record into a container with a single block copy
+        template<typename Scalar>
+        bool get(const std::string& name, vector<Scalar>& v) const {
+            const Record* rec = find(name);
+            if (rec == nullptr || rec->header.aggregationType != UNIVERSAL_AGGREGATE_VECTOR || !recordHoldsScalar<Scalar>(rec->header)) return false;
+            v.resize(rec->header.nrElements);
+            if (v.size() > 0) std::memcpy(static_cast<void*>(std::to_address(v.begin())), file.data() + rec->offset, v.size() * sizeof(Scalar));
+            return true;
+        }
+        template<typename Scalar>
+        bool get(const std::string& name, matrix<Scalar>& A) const {
+            const Record* rec = find(name);
+            if (rec == nullptr || rec->header.aggregationType != UNIVERSAL_AGGREGATE_MATRIX || !recordHoldsScalar<Scalar>(rec->header)) return false;
+            A.resize(rec->header.rows, rec->header.cols);
+            // the constructor guarantees nrElements == rows * cols, so this is exactly the matrix storage
+            size_t nrElements = A.rows() * A.cols();
+            if (nrElements > 0) std::memcpy(static_cast<void*>(std::to_address(A.begin())), file.data() + rec->offset, nrElements * sizeof(Scalar));
+            return true;
+        }
+
+    private:
+        struct Record {
+            BinaryRecordHeader header;
+            std::string name;
+            size_t offset{ 0 };
+        };
+        mapped_file file;
+        std::vector<Record> records;
+
+        // rows * cols == nrElements, evaluated without overflow
+        static bool shapeMatches(const BinaryRecordHeader& h) noexcept {
+            if (h.rows == 0 || h.cols == 0) return h.nrElements == 0;
+            return h.nrElements % h.rows == 0 && h.nrElements / h.rows == h.cols;
+        }
+        const Record* find(const std::string& name) const noexcept {
+            for (const auto& rec : records) if (rec.name == name) return &rec;
+            return nullptr;
+        }
+        const Record& lookup(const std::string& name) const {
+            const Record* rec = find(name);
+            if (rec == nullptr) throw std::runtime_error("no record named " + name);
+            return *rec;
+        }
+    };
+
 } }  // namespace sw::blas
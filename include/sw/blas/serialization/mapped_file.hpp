@@ -0,0 +1,111 @@
+#pragma once
+// mapped_file.hpp: read-only memory mapping of a file
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sw { namespace blas {
+
+	// mapped_file maps the content of a file into the address space of the process,
+	// so the pages are brought in by the operating system when they are first touched
+	// and restoring a data set does not copy or parse it
+	class mapped_file {
+	public:
+		mapped_file() = default;
+		explicit mapped_file(const std::string& filename) { open(filename); }
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+		mapped_file(mapped_file&& rhs) noexcept { swap(rhs); }
+		mapped_file& operator=(mapped_file&& rhs) noexcept { close(); swap(rhs); return *this; }
+		~mapped_file() { close(); }
+
+		void open(const std::string& filename) {
+			close();
+#if defined(_WIN32)
+			HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("mapped_file: unable to open " + filename);
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(file, &fileSize)) {
+				CloseHandle(file);
+				throw std::runtime_error("mapped_file: unable to size " + filename);
+			}
+			_size = static_cast<size_t>(fileSize.QuadPart);
+			if (_size > 0) {
+				HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mapping != nullptr) {
+					_data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+					CloseHandle(mapping);  // the view keeps the mapping alive
+				}
+				if (_data == nullptr) {
+					CloseHandle(file);
+					_size = 0;
+					throw std::runtime_error("mapped_file: unable to map " + filename);
+				}
+			}
+			CloseHandle(file);
+#else
+			int fd = ::open(filename.c_str(), O_RDONLY);
+			if (fd < 0) throw std::runtime_error("mapped_file: unable to open " + filename);
+			struct stat info;
+			if (::fstat(fd, &info) != 0) {
+				::close(fd);
+				throw std::runtime_error("mapped_file: unable to size " + filename);
+			}
+			_size = static_cast<size_t>(info.st_size);
+			if (_size > 0) {
+				void* address = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (address == MAP_FAILED) {
+					::close(fd);
+					_size = 0;
+					throw std::runtime_error("mapped_file: unable to map " + filename);
+				}
+				_data = static_cast<const std::byte*>(address);
+			}
+			::close(fd);  // the mapping keeps the file alive
+#endif
+		}
+
+		void close() noexcept {
+			if (_data != nullptr) {
+#if defined(_WIN32)
+				UnmapViewOfFile(_data);
+#else
+				::munmap(const_cast<std::byte*>(_data), _size);
+#endif
+			}
+			_data = nullptr;
+			_size = 0;
+		}
+
+		bool is_open() const noexcept { return _data != nullptr; }
+		const std::byte* data() const noexcept { return _data; }
+		size_t size() const noexcept { return _size; }
+
+	private:
+		const std::byte* _data{ nullptr };
+		size_t _size{ 0 };
+
+		void swap(mapped_file& rhs) noexcept {
+			std::swap(_data, rhs._data);
+			std::swap(_size, rhs._size);
+		}
+	};
+
+}} // namespace sw::blas
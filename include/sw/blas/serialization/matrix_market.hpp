@@ -0,0 +1,385 @@
+#pragma once
+// matrix_market.hpp: Matrix Market text reader/writer and a compact, memory-mappable binary matrix format
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <limits>
+#include <stdexcept>
+#include <numeric/containers.hpp>
+#include <blas/serialization/mapped_file.hpp>
+
+namespace sw { namespace blas {
+	using namespace sw::numeric::containers;
+
+	/*
+	 * Matrix Market exchange format (https://math.nist.gov/MatrixMarket/formats.html)
+	 *
+	 *   %%MatrixMarket matrix coordinate real general
+	 *   % comments
+	 *   rows cols nnz
+	 *   i j value        (1-based, one entry per line)
+	 *
+	 * The array format lists all elements column by column. The reader supports the real,
+	 * double, integer, and pattern fields, and the general, symmetric, skew-symmetric, and
+	 * (for real data) hermitian symmetries. The file is consumed one line at a time and
+	 * each value is converted to the target Scalar type as it is read, so there is no
+	 * intermediate double copy of the matrix.
+	 */
+	struct MatrixMarketHeader {
+		bool     coordinate{ true };   // coordinate or array
+		bool     pattern{ false };     // coordinate entries without a value
+		bool     symmetric{ false };   // only the lower triangle is stored
+		bool     skew{ false };        // A(j,i) = -A(i,j)
+		uint64_t rows{ 0 }, cols{ 0 }, entries{ 0 };
+	};
+
+	namespace mm {
+		inline std::string lowercase(std::string s) {
+			for (auto& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+			return s;
+		}
+		// skip comment and blank lines, returns false at the end of the stream
+		inline bool nextDataLine(std::istream& istr, std::string& line) {
+			while (std::getline(istr, line)) {
+				size_t first = line.find_first_not_of(" \t\r");
+				if (first != std::string::npos && line[first] != '%') return true;
+			}
+			return false;
+		}
+		inline uint64_t parseIndex(const char*& cursor) {
+			char* end;
+			unsigned long long v = std::strtoull(cursor, &end, 10);
+			if (end == cursor) throw std::runtime_error("Matrix Market: malformed index");
+			cursor = end;
+			return v;
+		}
+		inline double parseValue(const char*& cursor) {
+			char* end;
+			double v = std::strtod(cursor, &end);
+			if (end == cursor) throw std::runtime_error("Matrix Market: malformed value");
+			cursor = end;
+			return v;
+		}
+	}
+
+	// parse the banner and the size line
+	inline MatrixMarketHeader readMatrixMarketHeader(std::istream& istr) {
+		MatrixMarketHeader header;
+		std::string line;
+		if (!std::getline(istr, line)) throw std::runtime_error("Matrix Market: empty stream");
+		std::istringstream banner(line);
+		std::string token, object, layout, field, symmetry;
+		banner >> token >> object >> layout >> field >> symmetry;
+		if (token != "%%MatrixMarket" || mm::lowercase(object) != "matrix") throw std::runtime_error("Matrix Market: missing %%MatrixMarket matrix banner");
+		layout = mm::lowercase(layout);
+		field = mm::lowercase(field);
+		symmetry = mm::lowercase(symmetry);
+		if (layout == "coordinate") header.coordinate = true;
+		else if (layout == "array") header.coordinate = false;
+		else throw std::runtime_error("Matrix Market: unknown layout " + layout);
+		if (field == "pattern") header.pattern = true;
+		else if (field != "real" && field != "double" && field != "integer") throw std::runtime_error("Matrix Market: unsupported field " + field);
+		if (symmetry == "symmetric" || symmetry == "hermitian") header.symmetric = true;
+		else if (symmetry == "skew-symmetric") header.symmetric = header.skew = true;
+		else if (symmetry != "general") throw std::runtime_error("Matrix Market: unknown symmetry " + symmetry);
+		if (header.pattern && !header.coordinate) throw std::runtime_error("Matrix Market: pattern requires the coordinate layout");
+
+		if (!mm::nextDataLine(istr, line)) throw std::runtime_error("Matrix Market: missing size line");
+		const char* cursor = line.c_str();
+		header.rows = mm::parseIndex(cursor);
+		header.cols = mm::parseIndex(cursor);
+		if (header.coordinate) {
+			header.entries = mm::parseIndex(cursor);
+		}
+		else {
+			// symmetric arrays only list the lower triangle, skew-symmetric ones exclude the diagonal
+			uint64_t n = header.rows;
+			header.entries = header.symmetric ? (header.skew ? n * (n - 1) / 2 : n * (n + 1) / 2) : header.rows * header.cols;
+		}
+		if (header.rows > std::numeric_limits<uint32_t>::max() || header.cols > std::numeric_limits<uint32_t>::max()) throw std::runtime_error("Matrix Market: matrix too large");
+		return header;
+	}
+
+	// stream the entries that follow the header of a Matrix Market file: visit(i, j, value) is called
+	// with 0-based indices, and symmetric files are expanded so the visitor sees both triangles
+	template<typename Visitor>
+	void visitMatrixMarket(std::istream& istr, const MatrixMarketHeader& header, Visitor&& visit) {
+		std::string line;
+		uint64_t i = 0, j = 0;  // position in an array layout
+		for (uint64_t e = 0; e < header.entries; ++e) {
+			if (!mm::nextDataLine(istr, line)) throw std::runtime_error("Matrix Market: unexpected end of data");
+			const char* cursor = line.c_str();
+			double value = 1.0;
+			if (header.coordinate) {
+				i = mm::parseIndex(cursor);
+				j = mm::parseIndex(cursor);
+				if (i == 0 || j == 0 || i > header.rows || j > header.cols) throw std::runtime_error("Matrix Market: entry outside of the matrix");
+				--i; --j;
+				if (!header.pattern) value = mm::parseValue(cursor);
+			}
+			else {
+				value = mm::parseValue(cursor);
+			}
+			visit(i, j, value);
+			if (header.symmetric && i != j) visit(j, i, header.skew ? -value : value);
+			if (!header.coordinate) {  // column-major walk over the stored part
+				if (++i == header.rows) {
+					++j;
+					i = header.symmetric ? (header.skew ? j + 1 : j) : 0;
+				}
+			}
+		}
+	}
+
+	// read a Matrix Market file into a sparse matrix
+	template<typename Scalar, SparseFormat format = SparseFormat::CSR>
+	sparse_matrix<Scalar, format> readMatrixMarket(std::istream& istr) {
+		using triplet = typename sparse_matrix<Scalar, format>::triplet;
+		using index_type = typename sparse_matrix<Scalar, format>::index_type;
+		MatrixMarketHeader header = readMatrixMarketHeader(istr);
+		// the entry count comes from the file: reject what the 32-bit offsets cannot hold before reserving for it
+		constexpr uint64_t maxEntries = std::numeric_limits<index_type>::max();
+		if (header.entries > (header.symmetric ? maxEntries / 2 : maxEntries)) throw std::runtime_error("Matrix Market: number of entries exceeds the sparse index type");
+		std::vector<triplet> entries;
+		entries.reserve(header.symmetric ? 2 * header.entries : header.entries);
+		visitMatrixMarket(istr, header, [&](uint64_t i, uint64_t j, double v) { entries.emplace_back(i, j, Scalar(v)); });
+		return sparse_matrix<Scalar, format>(header.rows, header.cols, std::move(entries));
+	}
+
+	// read a Matrix Market file into a dense matrix
+	template<typename Scalar>
+	void readMatrixMarket(std::istream& istr, matrix<Scalar>& A) {
+		MatrixMarketHeader header = readMatrixMarketHeader(istr);
+		A.resize(header.rows, header.cols);
+		A.setzero();
+		visitMatrixMarket(istr, header, [&](uint64_t i, uint64_t j, double v) { A(i, j) += Scalar(v); });
+	}
+
+	template<typename Scalar, SparseFormat format = SparseFormat::CSR>
+	sparse_matrix<Scalar, format> loadMatrixMarket(const std::string& filename) {
+		std::ifstream fi(filename);
+		if (!fi.good()) throw std::runtime_error("Matrix Market: unable to open " + filename);
+		return readMatrixMarket<Scalar, format>(fi);
+	}
+
+	// write a sparse matrix in coordinate layout
+	template<typename Scalar, SparseFormat format>
+	void writeMatrixMarket(std::ostream& ostr, const sparse_matrix<Scalar, format>& A) {
+		ostr << "%%MatrixMarket matrix coordinate real general\n";
+		ostr << A.rows() << ' ' << A.cols() << ' ' << A.nnz() << '\n';
+		auto precision = ostr.precision(std::numeric_limits<double>::max_digits10);
+		size_t nrMajor = (format == SparseFormat::CSR ? A.rows() : A.cols());
+		for (size_t p = 0; p < nrMajor; ++p) {
+			for (auto k = A.offsets()[p]; k < A.offsets()[p + 1]; ++k) {
+				size_t i = (format == SparseFormat::CSR ? p : A.indices()[k]);
+				size_t j = (format == SparseFormat::CSR ? A.indices()[k] : p);
+				ostr << i + 1 << ' ' << j + 1 << ' ' << double(A.values()[k]) << '\n';
+			}
+		}
+		ostr.precision(precision);
+	}
+
+	// write a dense matrix in array layout
+	template<typename Scalar>
+	void writeMatrixMarket(std::ostream& ostr, const matrix<Scalar>& A) {
+		ostr << "%%MatrixMarket matrix array real general\n";
+		ostr << A.rows() << ' ' << A.cols() << '\n';
+		auto precision = ostr.precision(std::numeric_limits<double>::max_digits10);
+		for (size_t j = 0; j < A.cols(); ++j) {
+			for (size_t i = 0; i < A.rows(); ++i) ostr << double(A(i, j)) << '\n';
+		}
+		ostr.precision(precision);
+	}
+
+	/*
+	 * Binary matrix format: a fixed header followed by naturally aligned arrays
+	 *
+	 *   header    : magic "UMTX", byte order mark, version, layout, rows, cols, nnz
+	 *   dense     : rows*cols doubles in row-major order
+	 *   CSR       : (rows+1) uint32 offsets, nnz uint32 column indices, padding to 8 bytes, nnz doubles
+	 *
+	 * The values are stored as doubles so one file serves every target type. Loading maps the
+	 * file and converts from the mapped arrays straight into the target container, so nothing
+	 * is parsed and the only copy is the one into the target type.
+	 */
+	constexpr uint32_t UNIVERSAL_BINARY_MATRIX_BOM = 0x01020304;
+	constexpr uint32_t UNIVERSAL_BINARY_MATRIX_VERSION = 1;
+	enum class BinaryMatrixLayout : uint32_t { Dense = 0, CSR = 1 };
+
+	struct BinaryMatrixHeader {
+		char     magic[4]{ 'U', 'M', 'T', 'X' };
+		uint32_t bom{ UNIVERSAL_BINARY_MATRIX_BOM };
+		uint32_t version{ UNIVERSAL_BINARY_MATRIX_VERSION };
+		uint32_t layout{ 0 };
+		uint64_t rows{ 0 }, cols{ 0 }, nnz{ 0 };
+	};
+	static_assert(sizeof(BinaryMatrixHeader) == 40, "BinaryMatrixHeader must not contain padding");
+
+	namespace mm {
+		constexpr size_t align8(size_t offset) { return (offset + 7) & ~size_t(7); }
+		template<typename T>
+		void writeArray(std::ostream& ostr, const T* data, size_t n) {
+			ostr.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(n * sizeof(T)));
+		}
+		inline void pad(std::ostream& ostr, size_t offset) {
+			static const char zeros[8]{};
+			ostr.write(zeros, static_cast<std::streamsize>(align8(offset) - offset));
+		}
+	}
+
+	template<typename Scalar>
+	void saveBinaryMatrix(std::ostream& ostr, const matrix<Scalar>& A) {
+		BinaryMatrixHeader header;
+		header.layout = static_cast<uint32_t>(BinaryMatrixLayout::Dense);
+		header.rows = A.rows();
+		header.cols = A.cols();
+		header.nnz = A.rows() * A.cols();
+		ostr.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		std::vector<double> row(A.cols());
+		for (size_t i = 0; i < A.rows(); ++i) {
+			for (size_t j = 0; j < A.cols(); ++j) row[j] = double(A(i, j));
+			mm::writeArray(ostr, row.data(), row.size());
+		}
+	}
+
+	template<typename Scalar, SparseFormat format>
+	void saveBinaryMatrix(std::ostream& ostr, const sparse_matrix<Scalar, format>& S) {
+		const sparse_matrix<double, SparseFormat::CSR> A(S);
+		BinaryMatrixHeader header;
+		header.layout = static_cast<uint32_t>(BinaryMatrixLayout::CSR);
+		header.rows = A.rows();
+		header.cols = A.cols();
+		header.nnz = A.nnz();
+		ostr.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		mm::writeArray(ostr, A.offsets().data(), A.offsets().size());
+		mm::writeArray(ostr, A.indices().data(), A.indices().size());
+		mm::pad(ostr, sizeof(header) + (A.offsets().size() + A.indices().size()) * sizeof(uint32_t));
+		mm::writeArray(ostr, A.values().data(), A.values().size());
+	}
+
+	template<typename Container>
+	void saveBinaryMatrix(const std::string& filename, const Container& A) {
+		std::ofstream fo(filename, std::ios::binary);
+		if (!fo.good()) throw std::runtime_error("binary matrix: unable to create " + filename);
+		saveBinaryMatrix(fo, A);
+		if (!fo.good()) throw std::runtime_error("binary matrix: failed to write " + filename);
+	}
+
+	// read-only view of a memory-mapped binary matrix file
+	class BinaryMatrixView {
+	public:
+		explicit BinaryMatrixView(const std::string& filename) : _file(filename) {
+			if (_file.size() < sizeof(BinaryMatrixHeader)) throw std::runtime_error("binary matrix: " + filename + " is too small");
+			std::memcpy(&_header, _file.data(), sizeof(_header));
+			if (std::memcmp(_header.magic, "UMTX", 4) != 0) throw std::runtime_error("binary matrix: " + filename + " is not a binary matrix file");
+			if (_header.bom != UNIVERSAL_BINARY_MATRIX_BOM) throw std::runtime_error("binary matrix: " + filename + " has a different byte order");
+			if (_header.version != UNIVERSAL_BINARY_MATRIX_VERSION) throw std::runtime_error("binary matrix: unsupported version");
+			// the record counts are bounded by the mapping before they enter any offset arithmetic,
+			// so a corrupt header cannot wrap the offsets back into the mapping
+			const size_t available = _file.size() - sizeof(BinaryMatrixHeader);
+			size_t expected = sizeof(BinaryMatrixHeader);
+			if (layout() == BinaryMatrixLayout::Dense) {
+				if (_header.cols != 0 && _header.rows > available / sizeof(double) / _header.cols) throw std::runtime_error("binary matrix: " + filename + " is truncated");
+				if (_header.nnz != _header.rows * _header.cols) throw std::runtime_error("binary matrix: " + filename + " has an inconsistent dense size");
+				_valueOffset = expected;
+				expected += _header.rows * _header.cols * sizeof(double);
+			}
+			else if (layout() == BinaryMatrixLayout::CSR) {
+				if (_header.rows >= available / sizeof(uint32_t) || _header.nnz > available / (sizeof(uint32_t) + sizeof(double))) throw std::runtime_error("binary matrix: " + filename + " is truncated");
+				if (_header.cols > std::numeric_limits<uint32_t>::max()) throw std::runtime_error("binary matrix: " + filename + " has too many columns");
+				_offsetsOffset = expected;
+				_indicesOffset = _offsetsOffset + (_header.rows + 1) * sizeof(uint32_t);
+				_valueOffset = mm::align8(_indicesOffset + _header.nnz * sizeof(uint32_t));
+				expected = _valueOffset + _header.nnz * sizeof(double);
+			}
+			else {
+				throw std::runtime_error("binary matrix: unknown layout");
+			}
+			if (_file.size() < expected) throw std::runtime_error("binary matrix: " + filename + " is truncated");
+			if (is_sparse()) validateStructure(filename);
+		}
+
+		BinaryMatrixLayout layout() const noexcept { return static_cast<BinaryMatrixLayout>(_header.layout); }
+		bool is_sparse() const noexcept { return layout() == BinaryMatrixLayout::CSR; }
+		size_t rows() const noexcept { return _header.rows; }
+		size_t cols() const noexcept { return _header.cols; }
+		size_t nnz() const noexcept { return _header.nnz; }
+
+		// the mapped arrays: offsets and indices are only present in the CSR layout
+		const double* values() const noexcept { return reinterpret_cast<const double*>(_file.data() + _valueOffset); }
+		const uint32_t* offsets() const noexcept { return is_sparse() ? reinterpret_cast<const uint32_t*>(_file.data() + _offsetsOffset) : nullptr; }
+		const uint32_t* indices() const noexcept { return is_sparse() ? reinterpret_cast<const uint32_t*>(_file.data() + _indicesOffset) : nullptr; }
+
+		// convert into a dense matrix of the target type
+		template<typename Scalar>
+		matrix<Scalar> dense() const {
+			matrix<Scalar> A(rows(), cols());
+			const double* v = values();
+			if (is_sparse()) {
+				const uint32_t* offset = offsets();
+				const uint32_t* index = indices();
+				for (size_t i = 0; i < rows(); ++i) {
+					for (uint32_t k = offset[i]; k < offset[i + 1]; ++k) A(i, index[k]) = Scalar(v[k]);
+				}
+			}
+			else {
+				for (size_t i = 0; i < rows(); ++i) {
+					for (size_t j = 0; j < cols(); ++j) A(i, j) = Scalar(*v++);
+				}
+			}
+			return A;
+		}
+
+		// convert into a sparse matrix of the target type
+		template<typename Scalar, SparseFormat format = SparseFormat::CSR>
+		sparse_matrix<Scalar, format> sparse() const {
+			if (!is_sparse()) return sparse_matrix<Scalar, format>(dense<Scalar>());
+			const uint32_t* offset = offsets();
+			const uint32_t* index = indices();
+			const double* v = values();
+			std::vector<uint32_t> o(offset, offset + rows() + 1);
+			std::vector<uint32_t> idx(index, index + nnz());
+			std::vector<Scalar> val(nnz());
+			for (size_t k = 0; k < nnz(); ++k) val[k] = Scalar(v[k]);
+			sparse_matrix<Scalar, SparseFormat::CSR> A(rows(), cols(), std::move(o), std::move(idx), std::move(val));
+			if constexpr (format == SparseFormat::CSR) return A; else return sparse_matrix<Scalar, format>(A);
+		}
+
+	private:
+		mapped_file _file;
+		BinaryMatrixHeader _header;
+
+		// dense() and sparse() index through the mapped arrays, so the CSR structure is checked once:
+		// the row offsets start at 0, never decrease and end at nnz, and the column indices of a row are
+		// in range and strictly increasing, which sparse_matrix relies on for its binary search
+		void validateStructure(const std::string& filename) const {
+			const uint32_t* offset = offsets();
+			const uint32_t* index = indices();
+			if (offset[0] != 0 || offset[rows()] != nnz()) throw std::runtime_error("binary matrix: " + filename + " has corrupt row offsets");
+			for (size_t i = 0; i < rows(); ++i) {
+				if (offset[i] > offset[i + 1]) throw std::runtime_error("binary matrix: " + filename + " has corrupt row offsets");
+			}
+			for (size_t i = 0; i < rows(); ++i) {
+				for (uint32_t k = offset[i]; k < offset[i + 1]; ++k) {
+					if (index[k] >= cols()) throw std::runtime_error("binary matrix: " + filename + " has a column index outside of the matrix");
+					if (k > offset[i] && index[k] <= index[k - 1]) throw std::runtime_error("binary matrix: " + filename + " has unsorted or duplicate column indices");
+				}
+			}
+		}
+
+		size_t _offsetsOffset{ 0 }, _indicesOffset{ 0 }, _valueOffset{ 0 };
+	};
+
+}} // namespace sw::blas
@@ -7,6 +7,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <limits>
 #include <numeric/containers/matrix.hpp>
+#include <numeric/containers/sparse_matrix.hpp>
 
 namespace sw {
 	namespace blas {
@@ -69,6 +70,28 @@ namespace sw {
 				return itr;
 			}
 
+			// inverse of the diagonal of A as a sparse matrix: the Jacobi preconditioner
+			template<typename Scalar, sw::numeric::containers::SparseFormat format>
+			sw::numeric::containers::sparse_matrix<Scalar, format> jacobi_preconditioner(const sw::numeric::containers::sparse_matrix<Scalar, format>& A) {
+				using namespace sw::numeric::containers;
+				using triplet = typename sparse_matrix<Scalar, format>::triplet;
+				vector<Scalar> diag = A.diagonal();
+				std::vector<triplet> entries;
+				entries.reserve(size(diag));
+				for (size_t i = 0; i < size(diag); ++i) {
+					if (diag[i] != Scalar(0)) entries.emplace_back(i, i, Scalar(1) / diag[i]);
+				}
+				return sparse_matrix<Scalar, format>(A.rows(), A.cols(), entries);
+			}
+
+			// cg: Solution of x in Ax=b for a sparse system matrix using the Jacobi preconditioner
+			// the matrix-vector products are sparse, so an iteration is O(nnz)
+			template<typename Scalar, sw::numeric::containers::SparseFormat format, size_t MAX_ITERATIONS = 100>
+			size_t cg(const sw::numeric::containers::sparse_matrix<Scalar, format>& A, const sw::numeric::containers::vector<Scalar>& b, sw::numeric::containers::vector<Scalar>& x, sw::numeric::containers::vector<Scalar>& residuals, typename sw::numeric::containers::sparse_matrix<Scalar, format>::value_type tolerance = Scalar(0.00001)) {
+				auto M = jacobi_preconditioner(A);
+				return cg<sw::numeric::containers::sparse_matrix<Scalar, format>, sw::numeric::containers::vector<Scalar>, MAX_ITERATIONS>(M, A, b, x, residuals, tolerance);
+			}
+
 		}
 	}
 } // namespace sw::blas::solvers
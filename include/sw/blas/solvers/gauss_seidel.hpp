@@ -7,6 +7,7 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
 #include <numeric/containers/matrix.hpp>
+#include <numeric/containers/sparse_matrix.hpp>
 
 namespace sw { namespace blas { namespace solvers {
 
@@ -38,4 +39,35 @@ size_t GaussSeidel(const Matrix& A, const Vector& b, Vector& x, typename Matrix:
 	return itr;
 }
 
+// Gauss-Seidel: Solution of x in Ax=b for a sparse system matrix, O(nnz) per iteration
+template<typename Scalar, sw::numeric::containers::SparseFormat format, size_t MAX_ITERATIONS = 100, bool traceIteration = false>
+size_t GaussSeidel(const sw::numeric::containers::sparse_matrix<Scalar, format>& S, const sw::numeric::containers::vector<Scalar>& b, sw::numeric::containers::vector<Scalar>& x, typename sw::numeric::containers::sparse_matrix<Scalar, format>::value_type tolerance = Scalar(0.00001)) {
+	using namespace sw::numeric::containers;
+	using Vector = vector<Scalar>;
+	const sparse_matrix<Scalar, SparseFormat::CSR> A(S);  // row access
+	Scalar residual = Scalar(std::numeric_limits<Scalar>::max());
+	size_t m = num_rows(A);
+	const auto& offsets = A.offsets();
+	const auto& indices = A.indices();
+	const auto& values = A.values();
+	Vector diag = A.diagonal();
+	size_t itr = 0;
+	while (residual > tolerance && itr < MAX_ITERATIONS) {
+		Vector x_old = x;
+		// updating x in place uses the new values of the rows above the diagonal
+		for (size_t i = 0; i < m; ++i) {
+			Scalar sigma = 0;
+			for (auto k = offsets[i]; k < offsets[i + 1]; ++k) {
+				if (indices[k] != i) sigma += values[k] * x(indices[k]);
+			}
+			x(i) = (b(i) - sigma) / diag(i);
+		}
+		residual = norm(x_old - x, 1);
+		if constexpr (traceIteration) std::cout << '[' << itr << "] " << std::setw(10) << x << "        residual " << residual << std::endl;
+		++itr;
+	}
+
+	return itr;
+}
+
 }}} // namespace sw::blas::solvers
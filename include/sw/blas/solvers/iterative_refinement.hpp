@@ -0,0 +1,257 @@
+#pragma once
+// iterative_refinement.hpp: mixed-precision iterative refinement with a low precision LU factorization
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include <numeric/containers.hpp>
+#include <blas/solvers/lu.hpp>
+#include <blas/squeeze.hpp>
+#include <blas/ext/exact_accumulator.hpp>
+
+namespace sw { namespace blas { namespace solvers {
+	using namespace sw::numeric::containers;
+
+// residual type tag: r = b - A x is accumulated exactly in the quire of the working precision and rounded once
+struct quire_residual {};
+
+// how the working precision matrix is squeezed into the low precision before it is factored, see blas/squeeze.hpp
+enum class SqueezeStrategy {
+	None,                  // round only
+	RoundAndReplace,       // round, then replace infinities with maxpos
+	ScaleAndRound,         // scale by mu so that the largest element becomes theta, then round
+	TwoSidedScaleAndRound  // row and column equilibration R A S, then scale and round
+};
+
+struct refinement_options {
+	size_t          maxIterations{ 10 };
+	double          tolerance{ 0.0 };     // normwise backward error to stop at, 0 selects the epsilon of the working precision
+	SqueezeStrategy squeeze{ SqueezeStrategy::None };
+	double          theta{ 0.1 };         // target of the largest element of the scaling strategies
+	size_t          blockSize{ 64 };      // of the blocked LU
+	unsigned        maxThreads{ NUMERIC_GEMM_MAX_THREADS };
+};
+
+enum class refinement_status { NotStarted, Converged, Stagnated, MaxIterations, Diverged, FactorizationFailed };
+
+// record of one iteration: the state of x at the start of the iteration and the correction applied to it
+struct refinement_step {
+	size_t iteration;
+	double backwardError;    // ||b - A x|| / (||A|| ||x|| + ||b||), infinity norms
+	double correctionNorm;   // ||c|| / ||x||, 0 when the iteration stopped before the correction
+	double residualSeconds;  // computing the residual
+	double solveSeconds;     // computing and applying the correction
+};
+
+/// <summary>
+/// iterative_refinement: solve A x = b with the LU factors of a low precision copy of A
+/// </summary>
+/// The matrix is squeezed and factored once in LowT. Each right-hand side starts from the solution of the
+/// factored system, and is refined with residuals computed in ResidualT, or in the quire of WorkingT when
+/// ResidualT is quire_residual. The corrections are solved with the low precision factors in WorkingT.
+/// The iteration stops as soon as the backward error or the relative correction drops below the tolerance,
+/// or when the corrections stop contracting.
+template<typename WorkingT, typename LowT, typename ResidualT = WorkingT>
+class iterative_refinement {
+	static constexpr bool fusedResidual = std::is_same_v<ResidualT, quire_residual>;
+	using HighT = std::conditional_t<fusedResidual, WorkingT, ResidualT>;
+public:
+	using value_type = WorkingT;
+
+	iterative_refinement(const refinement_options& options = refinement_options{}) : _options{ options } {}
+	iterative_refinement(const matrix<WorkingT>& A, const refinement_options& options = refinement_options{}) : _options{ options } {
+		factor(A);
+	}
+
+	// squeeze and factor A in low precision, returns false when the low precision factorization is singular
+	bool factor(const matrix<WorkingT>& A) {
+		using clock = std::chrono::steady_clock;
+		auto start = clock::now();
+		const size_t n = num_rows(A);
+		_A = A;
+		if constexpr (!fusedResidual) _Ah = matrix<HighT>(A);
+		_normA = 0.0;
+		for (size_t i = 0; i < n; ++i) {
+			double rowSum{ 0.0 };
+			for (size_t j = 0; j < num_cols(A); ++j) rowSum += std::abs(double(A(i, j)));
+			_normA = std::max(_normA, rowSum);
+		}
+		_rowScale = std::vector<WorkingT>(n, WorkingT(1));
+		_colScale = std::vector<WorkingT>(n, WorkingT(1));
+		_mu = WorkingT(1);
+
+		matrix<WorkingT> Aw(A);
+		matrix<LowT> Al;
+		WorkingT theta(_options.theta);
+		switch (_options.squeeze) {
+		case SqueezeStrategy::None:
+			Al = Aw;
+			break;
+		case SqueezeStrategy::RoundAndReplace:
+			Al = Aw;
+			sw::universal::RoundAndReplace(Aw, Al);
+			break;
+		case SqueezeStrategy::ScaleAndRound:
+			sw::universal::ScaleAndRound(Aw, Al, theta, _mu);
+			break;
+		case SqueezeStrategy::TwoSidedScaleAndRound:
+		{
+			vector<WorkingT> R(n), S(n);
+			sw::universal::xyyEQU(R, Aw, S);
+			sw::universal::ScaleAndRound(Aw, Al, theta, _mu);
+			for (size_t i = 0; i < n; ++i) {
+				_rowScale[i] = R[i];
+				_colScale[i] = S[i];
+			}
+		}
+			break;
+		}
+		for (size_t i = 0; i < n; ++i) {
+			for (size_t j = 0; j < num_cols(Al); ++j) {
+				if (!std::isfinite(double(Al(i, j)))) {
+					std::cerr << "matrix overflows the low precision, select a squeeze strategy\n";
+					_status = refinement_status::FactorizationFailed;
+					return false;
+				}
+			}
+		}
+		LUP<LowT> low(Al, _options.blockSize, _options.maxThreads);
+		_factors = LUP<WorkingT>(low, _options.maxThreads);
+		_factorSeconds = std::chrono::duration<double>(clock::now() - start).count();
+		_status = (low.singular() ? refinement_status::FactorizationFailed : refinement_status::NotStarted);
+		return !low.singular();
+	}
+
+	// solve A x = b, the iteration history is available until the next solve
+	vector<WorkingT> solve(const vector<WorkingT>& b) {
+		using clock = std::chrono::steady_clock;
+		const size_t n = num_rows(_A);
+		_history.clear();
+		if (n != size(b)) {
+			std::cerr << "rhs vector does not match size of the factored matrix\n";
+			return vector<WorkingT>{};
+		}
+		if (_status == refinement_status::FactorizationFailed) return vector<WorkingT>(n);
+
+		const double tolerance = (_options.tolerance > 0.0 ? _options.tolerance : double(std::numeric_limits<WorkingT>::epsilon()));
+		const double normb = infinity_norm(b);
+		vector<WorkingT> x = correction(b);
+		double previousCorrection = std::numeric_limits<double>::infinity();
+		_status = refinement_status::MaxIterations;
+		for (size_t iteration = 1; iteration <= _options.maxIterations; ++iteration) {
+			auto start = clock::now();
+			vector<WorkingT> r = residual(b, x);
+			auto residualDone = clock::now();
+			const double normx = infinity_norm(x);
+			const double denominator = _normA * normx + normb;
+			const double backwardError = (denominator > 0.0 ? infinity_norm(r) / denominator : 0.0);
+			refinement_step step{ iteration, backwardError, 0.0, std::chrono::duration<double>(residualDone - start).count(), 0.0 };
+			if (!std::isfinite(backwardError)) {
+				_history.push_back(step);
+				_status = refinement_status::Diverged;
+				break;
+			}
+			if (backwardError <= tolerance) {
+				_history.push_back(step);
+				_status = refinement_status::Converged;
+				break;
+			}
+			vector<WorkingT> c = correction(r);
+			for (size_t i = 0; i < n; ++i) x[i] += c[i];
+			step.correctionNorm = (normx > 0.0 ? infinity_norm(c) / normx : infinity_norm(c));
+			step.solveSeconds = std::chrono::duration<double>(clock::now() - residualDone).count();
+			_history.push_back(step);
+			if (!std::isfinite(step.correctionNorm)) {
+				_status = refinement_status::Diverged;
+				break;
+			}
+			if (step.correctionNorm <= tolerance) {
+				_status = refinement_status::Converged;
+				break;
+			}
+			// the corrections must contract, otherwise the low precision factors are too far from A
+			if (step.correctionNorm > 0.9 * previousCorrection) {
+				_status = (step.correctionNorm > 2.0 * previousCorrection ? refinement_status::Diverged : refinement_status::Stagnated);
+				break;
+			}
+			previousCorrection = step.correctionNorm;
+		}
+		return x;
+	}
+
+	refinement_status status() const noexcept { return _status; }
+	bool converged() const noexcept { return _status == refinement_status::Converged; }
+	size_t iterations() const noexcept { return _history.size(); }
+	const std::vector<refinement_step>& history() const noexcept { return _history; }
+	double factorizationSeconds() const noexcept { return _factorSeconds; }
+	const LUP<WorkingT>& factors() const noexcept { return _factors; }
+	WorkingT mu() const noexcept { return _mu; }
+
+private:
+	refinement_options           _options;
+	matrix<WorkingT>             _A;
+	matrix<HighT>                _Ah;
+	double                       _normA{ 0.0 };
+	std::vector<WorkingT>        _rowScale, _colScale;
+	WorkingT                     _mu{ 1 };
+	LUP<WorkingT>                _factors;
+	double                       _factorSeconds{ 0.0 };
+	refinement_status            _status{ refinement_status::NotStarted };
+	std::vector<refinement_step> _history;
+
+	template<typename Scalar>
+	static double infinity_norm(const vector<Scalar>& v) {
+		double norm{ 0.0 };
+		for (size_t i = 0; i < size(v); ++i) {
+			double e = std::abs(double(v[i]));
+			if (std::isnan(e)) return e;
+			norm = std::max(norm, e);
+		}
+		return norm;
+	}
+
+	// solve A c = r with the factors of the squeezed matrix mu R A S: c = S (LU)^-1 mu R r
+	vector<WorkingT> correction(const vector<WorkingT>& r) const {
+		const size_t n = size(r);
+		vector<WorkingT> y(n);
+		for (size_t i = 0; i < n; ++i) y[i] = _mu * (_rowScale[i] * r[i]);
+		y = _factors.solve(y);
+		for (size_t i = 0; i < n; ++i) y[i] *= _colScale[i];
+		return y;
+	}
+
+	// r = b - A x in the residual precision, rounded to the working precision
+	vector<WorkingT> residual(const vector<WorkingT>& b, const vector<WorkingT>& x) const {
+		const size_t n = size(b);
+		vector<WorkingT> r(n);
+		if constexpr (fusedResidual) {
+			exact_accumulator<WorkingT> acc;
+			for (size_t i = 0; i < n; ++i) {
+				acc.clear();
+				acc.add_product(b[i], WorkingT(1));
+				for (size_t j = 0; j < n; ++j) acc.add_product(_A(i, j), -x[j]);
+				r[i] = acc.resolve();
+			}
+		}
+		else {
+			std::vector<HighT> xh(n);
+			for (size_t j = 0; j < n; ++j) xh[j] = HighT(x[j]);
+			for (size_t i = 0; i < n; ++i) {
+				HighT sum(b[i]);
+				for (size_t j = 0; j < n; ++j) sum -= _Ah(i, j) * xh[j];
+				r[i] = WorkingT(sum);
+			}
+		}
+		return r;
+	}
+};
+
+}}} // namespace sw::blas::solvers
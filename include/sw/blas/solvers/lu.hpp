@@ -7,6 +7,10 @@
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <universal/utility/directives.hpp>
 #include <iostream>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
 #include <numeric/containers.hpp>
 
 #if defined(_MSC_VER)
@@ -22,27 +26,6 @@
 
 namespace sw { namespace blas { namespace solvers {
 	using namespace sw::numeric::containers;
-/*
-template<typename Scalar>
-class LUP {
-public:
-	void decompose(const matrix<Scalar>& A) {
-		auto LU = lu(A);
-		L = tril(LU);
-		U = triu(LU);
-	}
-	vector<value_type> solve(const vector<Scalar>& b) {
-		auto y = solve(L, (P * b));
-		auto x = solve(U, y);
-		return x;
-	}
-
-private:
-	matrix<Scalar> L;
-	matrix<Scalar> U;
-	vector<size_t> P;
-};
-*/
 
 // non-pivoting Gaussian Elimination
 // The following compact LU factorization schemes are described
@@ -266,6 +249,252 @@ vector<Scalar> lubksb(const matrix<Scalar>& A, const vector<size_t>& indx, const
 	return x;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////
+/// blocked LU decomposition with partial pivoting
+
+// run body(i) for i in [0, n) on the pool, or on the calling thread when there is no pool
+inline void lu_parallel_for(sw::universal::thread_pool* pool, size_t n, const std::function<void(size_t)>& body) {
+	if (pool == nullptr) {
+		for (size_t i = 0; i < n; ++i) body(i);
+	}
+	else {
+		pool->parallel_for(n, body);
+	}
+}
+
+// trailing update of the blocked LU: A22 -= L21 * U12
+// L21 is m x k, U12 is k x n, and A22 is m x n, all three inside the same row-major matrix with leading dimension lda.
+// The product runs through the packed gemm kernel, one column slab at a time to bound the workspace.
+template<typename Scalar>
+struct lu_gemm_update {
+	static constexpr size_t slab = 1024;  // columns of A22 per gemm call
+
+	void operator()(size_t m, size_t n, size_t k, const Scalar* L21, const Scalar* U12, Scalar* A22, size_t lda, sw::universal::thread_pool* pool) const {
+		std::vector<Scalar> L(m * k), U, product;
+		for (size_t i = 0; i < m; ++i) std::copy(L21 + i * lda, L21 + i * lda + k, L.begin() + static_cast<std::ptrdiff_t>(i * k));
+		for (size_t j0 = 0; j0 < n; j0 += slab) {
+			size_t w = std::min(slab, n - j0);
+			U.resize(k * w);
+			product.resize(m * w);
+			for (size_t p = 0; p < k; ++p) std::copy(U12 + p * lda + j0, U12 + p * lda + j0 + w, U.begin() + static_cast<std::ptrdiff_t>(p * w));
+			gemm_kernel(m, w, k, L.data(), U.data(), product.data(), pool);
+			lu_parallel_for(pool, m, [&](size_t i) {
+				Scalar* a = A22 + i * lda + j0;
+				const Scalar* c = product.data() + i * w;
+				for (size_t j = 0; j < w; ++j) a[j] -= c[j];
+			});
+		}
+	}
+};
+
+/// <summary>
+/// LUP: reusable LU factorization with partial pivoting, P * A = L * U
+/// </summary>
+/// The factorization is right-looking and blocked: each step factors a panel of blockSize columns,
+/// solves for the matching block row of U, and applies the rank-blockSize update to the trailing
+/// submatrix through TrailingUpdate, which by default is the packed, multithreaded gemm kernel.
+/// The factors are kept, so any number of right-hand sides can be solved in O(N^2) each.
+/// maxThreads follows NUMERIC_GEMM_MAX_THREADS: 0 selects the process-wide pool, 1 the calling thread.
+/// The result does not depend on the number of threads.
+template<typename Scalar, typename TrailingUpdate = lu_gemm_update<Scalar>>
+class LUP {
+public:
+	using value_type = Scalar;
+	static constexpr size_t defaultBlockSize = 64;
+
+	LUP(size_t blockSize = defaultBlockSize, unsigned maxThreads = NUMERIC_GEMM_MAX_THREADS)
+		: _blockSize{ blockSize == 0 ? 1 : blockSize }, _maxThreads{ maxThreads } {}
+	LUP(const matrix<Scalar>& A, size_t blockSize = defaultBlockSize, unsigned maxThreads = NUMERIC_GEMM_MAX_THREADS)
+		: LUP(blockSize, maxThreads) {
+		decompose(A);
+	}
+	// the factors of another precision rounded to Scalar: factor in low precision, substitute in a higher one
+	template<typename SourceScalar, typename SourceUpdate>
+	explicit LUP(const LUP<SourceScalar, SourceUpdate>& factors, unsigned maxThreads = NUMERIC_GEMM_MAX_THREADS)
+		: _lu(factors._lu), _pivot(factors._pivot), _singular{ factors._singular }, _blockSize{ factors._blockSize }, _maxThreads{ maxThreads } {}
+
+	// factor A, returns false when A is not square or is singular
+	bool decompose(const matrix<Scalar>& A) {
+		using std::abs;
+		const size_t N = num_rows(A);
+		if (N != num_cols(A)) {
+			std::cerr << "matrix argument to LUP is not square: (" << num_rows(A) << " x " << num_cols(A) << ")\n";
+			_lu.resize(0, 0);
+			_pivot.clear();
+			_singular = true;
+			return false;
+		}
+		_lu = A;
+		_pivot.resize(N);
+		_singular = false;
+		Scalar* a = std::to_address(_lu.begin());
+		sw::universal::thread_pool* workers = pool();
+		for (size_t k0 = 0; k0 < N; k0 += _blockSize) {
+			const size_t kb = std::min(_blockSize, N - k0);
+			const size_t k1 = k0 + kb;
+			// panel factorization of columns [k0, k1), swapping entire rows
+			for (size_t j = k0; j < k1; ++j) {
+				size_t p = j;
+				Scalar pivot = abs(a[j * N + j]);
+				for (size_t i = j + 1; i < N; ++i) {
+					Scalar e = abs(a[i * N + j]);
+					if (e > pivot) {
+						pivot = e;
+						p = i;
+					}
+				}
+				_pivot[j] = p;
+				if (p != j) std::swap_ranges(a + j * N, a + (j + 1) * N, a + p * N);
+				if (a[j * N + j] == Scalar(0)) {  // singular: leave the column and keep factoring
+					_singular = true;
+					continue;
+				}
+				const Scalar diagonal = a[j * N + j];
+				for (size_t i = j + 1; i < N; ++i) {
+					Scalar* row = a + i * N;
+					row[j] /= diagonal;
+					const Scalar l = row[j];
+					for (size_t c = j + 1; c < k1; ++c) row[c] -= l * a[j * N + c];
+				}
+			}
+			if (k1 == N) break;
+			// block row of U: solve L11 * U12 = A12, columns in independent chunks
+			const size_t n2 = N - k1;
+			const size_t chunk = 256;
+			lu_parallel_for(workers, (n2 + chunk - 1) / chunk, [&](size_t t) {
+				const size_t c0 = k1 + t * chunk, c1 = std::min(N, c0 + chunk);
+				for (size_t r = k0 + 1; r < k1; ++r) {
+					for (size_t p = k0; p < r; ++p) {
+						const Scalar l = a[r * N + p];
+						for (size_t c = c0; c < c1; ++c) a[r * N + c] -= l * a[p * N + c];
+					}
+				}
+			});
+			// trailing update: A22 -= L21 * U12
+			_update(n2, n2, kb, a + k1 * N + k0, a + k0 * N + k1, a + k1 * N + k1, N, workers);
+		}
+		return !_singular;
+	}
+
+	// solve A x = b
+	vector<Scalar> solve(const vector<Scalar>& b) const {
+		const size_t N = num_rows(_lu);
+		if (N != size(b)) {
+			std::cerr << "rhs vector does not match size of LU decomposition\n";
+			return vector<Scalar>{};
+		}
+		vector<Scalar> x(b);
+		for (size_t i = 0; i < N; ++i) {
+			if (_pivot[i] != i) std::swap(x[i], x[_pivot[i]]);
+		}
+		for (size_t i = 0; i < N; ++i) {
+			Scalar sum = x[i];
+			for (size_t j = 0; j < i; ++j) sum -= _lu(i, j) * x[j];
+			x[i] = sum;
+		}
+		for (size_t i = N; i >= 1; --i) {
+			Scalar sum = x[i - 1];
+			for (size_t j = i; j < N; ++j) sum -= _lu(i - 1, j) * x[j];
+			x[i - 1] = sum / _lu(i - 1, i - 1);
+		}
+		return x;
+	}
+
+	// solve A X = B for all the columns of B
+	matrix<Scalar> solve(const matrix<Scalar>& B) const {
+		const size_t N = num_rows(_lu);
+		if (N != num_rows(B)) {
+			std::cerr << "rhs matrix does not match size of LU decomposition\n";
+			return matrix<Scalar>{};
+		}
+		const size_t nrhs = num_cols(B);
+		matrix<Scalar> X(B);
+		Scalar* x = std::to_address(X.begin());
+		for (size_t i = 0; i < N; ++i) {
+			if (_pivot[i] != i) std::swap_ranges(x + i * nrhs, x + (i + 1) * nrhs, x + _pivot[i] * nrhs);
+		}
+		// the right-hand sides are independent: substitute them in column chunks
+		const size_t chunk = 64;
+		lu_parallel_for(pool(), (nrhs + chunk - 1) / chunk, [&](size_t t) {
+			const size_t c0 = t * chunk, c1 = std::min(nrhs, c0 + chunk);
+			for (size_t i = 0; i < N; ++i) {
+				for (size_t j = 0; j < i; ++j) {
+					const Scalar l = _lu(i, j);
+					for (size_t c = c0; c < c1; ++c) x[i * nrhs + c] -= l * x[j * nrhs + c];
+				}
+			}
+			for (size_t i = N; i >= 1; --i) {
+				for (size_t j = i; j < N; ++j) {
+					const Scalar u = _lu(i - 1, j);
+					for (size_t c = c0; c < c1; ++c) x[(i - 1) * nrhs + c] -= u * x[j * nrhs + c];
+				}
+				const Scalar diagonal = _lu(i - 1, i - 1);
+				for (size_t c = c0; c < c1; ++c) x[(i - 1) * nrhs + c] /= diagonal;
+			}
+		});
+		return X;
+	}
+
+	// unit lower triangular factor
+	matrix<Scalar> L() const {
+		const size_t N = num_rows(_lu);
+		matrix<Scalar> L(N, N);
+		for (size_t i = 0; i < N; ++i) {
+			for (size_t j = 0; j < i; ++j) L(i, j) = _lu(i, j);
+			L(i, i) = Scalar(1);
+		}
+		return L;
+	}
+	// upper triangular factor
+	matrix<Scalar> U() const {
+		const size_t N = num_rows(_lu);
+		matrix<Scalar> U(N, N);
+		for (size_t i = 0; i < N; ++i) {
+			for (size_t j = i; j < N; ++j) U(i, j) = _lu(i, j);
+		}
+		return U;
+	}
+	// permutation matrix P of P * A = L * U
+	matrix<Scalar> P() const {
+		const size_t N = num_rows(_lu);
+		matrix<Scalar> P(N, N);
+		std::vector<size_t> perm = permutation();
+		for (size_t i = 0; i < N; ++i) P(i, perm[i]) = Scalar(1);
+		return P;
+	}
+	// row i of P * A is row permutation()[i] of A
+	std::vector<size_t> permutation() const {
+		std::vector<size_t> perm(_pivot.size());
+		for (size_t i = 0; i < perm.size(); ++i) perm[i] = i;
+		for (size_t i = 0; i < perm.size(); ++i) std::swap(perm[i], perm[_pivot[i]]);
+		return perm;
+	}
+	// the row interchanges in LAPACK convention: row i was swapped with row pivots()[i]
+	const std::vector<size_t>& pivots() const noexcept { return _pivot; }
+	// L and U packed in one matrix, the unit diagonal of L is implicit
+	const matrix<Scalar>& LU() const noexcept { return _lu; }
+	bool singular() const noexcept { return _singular; }
+	size_t blockSize() const noexcept { return _blockSize; }
+
+private:
+	template<typename, typename> friend class LUP;
+
+	matrix<Scalar> _lu;
+	std::vector<size_t> _pivot;
+	bool _singular{ false };
+	size_t _blockSize;
+	unsigned _maxThreads;
+	TrailingUpdate _update;
+	mutable std::shared_ptr<sw::universal::thread_pool> _pool;  // only when a thread count other than 0 or 1 is requested
+
+	sw::universal::thread_pool* pool() const {
+		if (_maxThreads == 1 || !sw::universal::is_parallel_safe<Scalar>) return nullptr;
+		if (_maxThreads == 0) return &sw::universal::default_thread_pool();
+		if (!_pool) _pool = std::make_shared<sw::universal::thread_pool>(_maxThreads);
+		return _pool.get();
+	}
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // solve the system of equations A x = b using partial pivoting LU
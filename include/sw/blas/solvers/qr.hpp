@@ -1,6 +1,7 @@
 /** **********************************************************************
  * QR decompositions
- *  - 
+ *  - blocked Householder (compact WY), the default
+ *  - modified Gram-Schmidt, Givens, Householder with column pivoting, unblocked Householder
  * 
  * @author:     James Quinlan
  * @date:       2022-12-28
@@ -11,6 +12,8 @@
  * ***********************************************************************
  */
 #pragma once
+#include <algorithm>
+#include <vector>
 #include<blas/blas.hpp>
 
 namespace sw {
@@ -248,6 +251,166 @@ namespace sw {
                 }
             }
 
+            ///////////////////////////////////////////////////////////////////////////////////
+            // blocked Householder QR in compact WY form
+
+            // 2-norm of n elements with stride inc, scaled by the largest magnitude to avoid
+            // overflow and underflow of the squares in narrow number systems
+            template<typename Scalar>
+            Scalar scaled_norm2(size_t n, const Scalar* x, size_t inc) {
+                using std::abs; using std::sqrt;
+                Scalar scale(0);
+                for (size_t i = 0; i < n; ++i) {
+                    Scalar e = abs(x[i * inc]);
+                    if (e > scale) scale = e;
+                }
+                if (scale == Scalar(0)) return scale;
+                Scalar sum(0);
+                for (size_t i = 0; i < n; ++i) {
+                    Scalar e = x[i * inc] / scale;
+                    sum += e * e;
+                }
+                return scale * sqrt(sum);
+            }
+
+            // apply the block reflector I - V T V^T (or its transpose) from the left to the m x n block C with leading dimension ldc
+            // V is m x k, unit lower trapezoidal, T is k x k upper triangular, both row-major and contiguous
+            template<typename Scalar>
+            void apply_block_reflector(bool transposed, size_t m, size_t n, size_t k, const std::vector<Scalar>& V, const std::vector<Scalar>& T, Scalar* C, size_t ldc) {
+                if (m == 0 || n == 0 || k == 0) return;
+                std::vector<Scalar> Vt(k * m), Cp(m * n), W(k * n), TW(k * n, Scalar(0)), VTW(m * n);
+                for (size_t i = 0; i < m; ++i) {
+                    for (size_t p = 0; p < k; ++p) Vt[p * m + i] = V[i * k + p];
+                    std::copy(C + i * ldc, C + i * ldc + n, Cp.begin() + static_cast<std::ptrdiff_t>(i * n));
+                }
+                gemm_kernel(k, n, m, Vt.data(), Cp.data(), W.data());   // W = V^T C
+                for (size_t i = 0; i < k; ++i) {                          // TW = T W or T^T W
+                    for (size_t p = 0; p < k; ++p) {
+                        Scalar t = (transposed ? T[p * k + i] : T[i * k + p]);
+                        if (t == Scalar(0)) continue;
+                        for (size_t j = 0; j < n; ++j) TW[i * n + j] += t * W[p * n + j];
+                    }
+                }
+                gemm_kernel(m, n, k, V.data(), TW.data(), VTW.data());  // C -= V TW
+                for (size_t i = 0; i < m; ++i) {
+                    Scalar* c = C + i * ldc;
+                    for (size_t j = 0; j < n; ++j) c[j] -= VTW[i * n + j];
+                }
+            }
+
+            // the reflectors of a blocked Householder QR in compact WY form: Q = (I - V_0 T_0 V_0^T) (I - V_1 T_1 V_1^T) ...,
+            // where block b covers the reflectors b * blockSize up to the next block and acts on the rows from b * blockSize on
+            template<typename Scalar>
+            struct householder_blocks {
+                size_t rows = 0;
+                size_t reflectors = 0;
+                size_t blockSize = 1;
+                std::vector<std::vector<Scalar>> V, T;
+            };
+
+            // Householder QR with the reflectors of each panel of blockSize columns aggregated
+            // into I - V T V^T, so that the trailing matrix is updated with matrix-matrix products.
+            // R is m x n upper triangular, and the returned blocks represent the m x m orthogonal Q of A = Q R.
+            template<typename Scalar>
+            householder_blocks<Scalar> blockedqr_factor(const matrix<Scalar>& A, matrix<Scalar>& R, size_t blockSize = 32) {
+                const size_t m = num_rows(A);
+                const size_t n = num_cols(A);
+                const size_t nrReflectors = std::min(m, n);
+                if (blockSize == 0) blockSize = 1;
+                householder_blocks<Scalar> H;
+                H.rows = m;
+                H.reflectors = nrReflectors;
+                H.blockSize = blockSize;
+                R = A;
+                Scalar* a = std::to_address(R.begin());
+                std::vector<Scalar> tau(nrReflectors, Scalar(0));
+                for (size_t k0 = 0; k0 < nrReflectors; k0 += blockSize) {
+                    const size_t kb = std::min(blockSize, nrReflectors - k0);
+                    const size_t k1 = k0 + kb;
+                    const size_t mp = m - k0;  // rows of the panel
+                    // unblocked factorization of the panel
+                    for (size_t j = k0; j < k1; ++j) {
+                        Scalar alpha = a[j * n + j];
+                        Scalar xnorm = scaled_norm2(m - j - 1, a + (j + 1) * n + j, n);
+                        if (xnorm == Scalar(0)) {
+                            tau[j] = Scalar(0);  // H = I
+                            continue;
+                        }
+                        Scalar beta = scaled_norm2(m - j, a + j * n + j, n);
+                        if (alpha >= Scalar(0)) beta = -beta;
+                        tau[j] = (beta - alpha) / beta;
+                        Scalar scale = Scalar(1) / (alpha - beta);
+                        for (size_t i = j + 1; i < m; ++i) a[i * n + j] *= scale;
+                        a[j * n + j] = beta;
+                        // apply H = I - tau v v^T to the remaining columns of the panel
+                        for (size_t c = j + 1; c < k1; ++c) {
+                            Scalar w = a[j * n + c];
+                            for (size_t i = j + 1; i < m; ++i) w += a[i * n + j] * a[i * n + c];
+                            w *= tau[j];
+                            a[j * n + c] -= w;
+                            for (size_t i = j + 1; i < m; ++i) a[i * n + c] -= a[i * n + j] * w;
+                        }
+                    }
+                    // V: the unit lower trapezoidal reflectors of the panel, T: the triangular factor, H_k0 ... H_k1-1 = I - V T V^T
+                    std::vector<Scalar> V(mp * kb, Scalar(0)), T(kb * kb, Scalar(0));
+                    for (size_t p = 0; p < kb; ++p) {
+                        V[p * kb + p] = Scalar(1);
+                        for (size_t i = p + 1; i < mp; ++i) V[i * kb + p] = a[(k0 + i) * n + k0 + p];
+                    }
+                    for (size_t p = 0; p < kb; ++p) {
+                        T[p * kb + p] = tau[k0 + p];
+                        // T(0:p, p) = -tau_p T(0:p, 0:p) V(:, 0:p)^T v_p
+                        std::vector<Scalar> z(p, Scalar(0));
+                        for (size_t r = 0; r < p; ++r) {
+                            Scalar s(0);
+                            for (size_t i = p; i < mp; ++i) s += V[i * kb + r] * V[i * kb + p];
+                            z[r] = s;
+                        }
+                        for (size_t r = 0; r < p; ++r) {
+                            Scalar s(0);
+                            for (size_t c = r; c < p; ++c) s += T[r * kb + c] * z[c];
+                            T[r * kb + p] = -tau[k0 + p] * s;
+                        }
+                    }
+                    // trailing update with the transposed block reflector
+                    if (k1 < n) apply_block_reflector(true, mp, n - k1, kb, V, T, a + k0 * n + k1, n);
+                    // R keeps only the upper triangle
+                    for (size_t i = k0 + 1; i < m; ++i) {
+                        for (size_t j = k0; j < std::min(i, k1); ++j) a[i * n + j] = Scalar(0);
+                    }
+                    H.V.push_back(std::move(V));
+                    H.T.push_back(std::move(T));
+                }
+                return H;
+            }
+
+            // C = Q C for the m x c matrix C, with the blocks of Q applied backward. When C starts as the identity,
+            // the columns before a block are still zero in the rows it acts on, so only the trailing part is updated.
+            template<typename Scalar>
+            void apply_householder_blocks(const householder_blocks<Scalar>& H, matrix<Scalar>& C, bool fromIdentity = false) {
+                const size_t m = H.rows;
+                const size_t c = num_cols(C);
+                Scalar* p = std::to_address(C.begin());
+                for (size_t b = H.V.size(); b > 0; --b) {
+                    const size_t k0 = (b - 1) * H.blockSize;
+                    const size_t kb = std::min(H.blockSize, H.reflectors - k0);
+                    const size_t first = (fromIdentity ? std::min(k0, c) : 0);
+                    apply_block_reflector(false, m - k0, c - first, kb, H.V[b - 1], H.T[b - 1], p + k0 * c + first, c);
+                }
+            }
+
+            // blocked Householder QR: Q is m x m orthogonal, R is m x n upper triangular, A = Q R.
+            // Callers that only need Q applied to a few columns should use blockedqr_factor and
+            // apply_householder_blocks instead, as forming Q costs O(m^2) memory.
+            template<typename Scalar>
+            void blockedqr(const matrix<Scalar>& A, matrix<Scalar>& Q, matrix<Scalar>& R, size_t blockSize = 32) {
+                householder_blocks<Scalar> H = blockedqr_factor(A, R, blockSize);
+                const size_t m = num_rows(A);
+                Q.resize(m, m);
+                Q = 1;
+                apply_householder_blocks(H, Q, true);
+            }
+
             // MAIN QR method (calls specific method within)
             template<typename Scalar>
             std::pair<matrix<Scalar>, matrix<Scalar>> qr(const matrix<Scalar>& A, size_t which = 1) {
@@ -257,12 +420,8 @@ namespace sw {
 
                 switch (which) {
                 case 1:
-                {
-                    Q = 1;
-                    R = A;
-                    houseqr(A, Q, R);
-                }
-                break;
+                    blockedqr(A, Q, R);
+                    break;
                 case 2:
                     mgs(A, Q, R);
                     break;
@@ -289,13 +448,17 @@ namespace sw {
                     houseqrpivot(A, Q, R, P);
                 }
                 break;
-                default:
+                case 5:
                 {
+                    // unblocked Householder
                     Q = 1;
                     R = A;
                     houseqr(A, Q, R);
                 }
                 break;
+                default:
+                    blockedqr(A, Q, R);
+                    break;
                 }
                 return std::make_pair(Q, R);
             }
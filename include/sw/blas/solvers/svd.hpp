@@ -1,69 +1,203 @@
 #pragma once
-// svd.hpp: generate bit patterns and values for a 16-bit takum
+// svd.hpp: singular value decomposition by one-sided Jacobi rotations
 //
 // Copyright (C) 2017 Stillwater Supercomputing, Inc.
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <vector>
 #include <numeric/containers.hpp>
+#include <blas/solvers/qr.hpp>
 
 namespace sw {
     namespace blas {
         namespace solvers {
             using namespace sw::numeric::containers;
 
-            template<typename Scalar, typename Tolerance = double>
-            void svd(const matrix<Scalar>& A, matrix<Scalar>& S, matrix<Scalar>& V, matrix<Scalar>& D, Tolerance tol = 10e-10) {
-                /*
-                    using value_type = Scalar;
-                    using size_type  = typename matrix<Scalar>::size_type;
-                    size_type        ncols = num_cols(A), nrows = num_rows(A);
-                    value_type       ref, zero = Scalar{ 0 }, one = Scalar{ 1 };
-
-                    // if (nrows != ncols) std::swap(row, col);
-
-                    matrix<Scalar> Q(nrows, nrows), R(nrows, ncols), VT(nrows, ncols), E(nrows, ncols),QT(ncols, ncols), RT(ncols, nrows);
-                    size_type l = 100 * std::max(nrows, ncols);
-                    S = one; D = one;
-                    double err{ std::numeric_limits<double>::max() };
-                    for (size_type i = 0; err > tol && i < l; ++i) {
-                        double e, f;
-                        std::tie(QT, RT) = qr(V);
-                        S *= QT;
-                        VT = RT.transpose();
-                        std::tie(Q, R) = qr(VT);
-                        D *= Q;
-                        E = triu(R, 1);
-                        V = trans(R);
-                        f=norm(diag(R), 2);
-                        e=norm(E);
-                        if(f==zero) f=1;
-                        err=e/f;
+            // one-sided Jacobi on the columns of W, stored transposed: row j of Wt is column j of W, and row j of Vt is column j of V.
+            // Each round of the round-robin ordering rotates disjoint column pairs, so the pairs of a round run in parallel
+            // and the result does not depend on the number of threads. Returns the number of sweeps.
+            template<typename Scalar>
+            unsigned jacobi_sweeps(size_t n, size_t m, std::vector<Scalar>& Wt, std::vector<Scalar>& Vt, double threshold, sw::universal::thread_pool* pool, unsigned maxSweeps = 64) {
+                using std::abs; using std::sqrt;
+                const size_t players = n + (n & 1);  // an odd number of columns gets a bye in each round
+                std::vector<size_t> position(players);
+                std::iota(position.begin(), position.end(), size_t(0));
+                std::vector<char> rotated(players / 2);
+                auto rotate = [&](size_t pair) {
+                    rotated[pair] = 0;
+                    size_t p = position[pair], q = position[players - 1 - pair];
+                    if (p >= n || q >= n) return;
+                    if (p > q) std::swap(p, q);
+                    Scalar* gp = Wt.data() + p * m;
+                    Scalar* gq = Wt.data() + q * m;
+                    Scalar alpha(0), beta(0), gamma(0);
+                    for (size_t i = 0; i < m; ++i) {
+                        alpha += gp[i] * gp[i];
+                        beta  += gq[i] * gq[i];
+                        gamma += gp[i] * gq[i];
+                    }
+                    if (gamma == Scalar(0) || abs(gamma) <= Scalar(threshold) * sqrt(alpha) * sqrt(beta)) return;
+                    // the rotation that annihilates gamma, with the smaller of the two angles
+                    Scalar zeta = (beta - alpha) / (Scalar(2) * gamma);
+                    Scalar t = Scalar(1) / (abs(zeta) + sqrt(Scalar(1) + zeta * zeta));
+                    if (zeta < Scalar(0)) t = -t;
+                    Scalar c = Scalar(1) / sqrt(Scalar(1) + t * t);
+                    Scalar s = c * t;
+                    for (size_t i = 0; i < m; ++i) {
+                        Scalar x = gp[i], y = gq[i];
+                        gp[i] = c * x - s * y;
+                        gq[i] = s * x + c * y;
+                    }
+                    Scalar* vp = Vt.data() + p * n;
+                    Scalar* vq = Vt.data() + q * n;
+                    for (size_t i = 0; i < n; ++i) {
+                        Scalar x = vp[i], y = vq[i];
+                        vp[i] = c * x - s * y;
+                        vq[i] = s * x + c * y;
                     }
-                    {
-                        V= 0;
-                        matrix<Scalar>  ins_V(V), ins_S(S);
+                    rotated[pair] = 1;
+                };
+                unsigned sweep = 0;
+                while (sweep < maxSweeps) {
+                    ++sweep;
+                    bool converged = true;
+                    for (size_t round = 0; round + 1 < players; ++round) {
+                        if (pool == nullptr || players < 16) {
+                            for (size_t pair = 0; pair < players / 2; ++pair) rotate(pair);
+                        }
+                        else {
+                            pool->parallel_for(players / 2, rotate);
+                        }
+                        for (char r : rotated) if (r) converged = false;
+                        // keep the first player in place and rotate the others one position
+                        std::rotate(position.begin() + 1, position.end() - 1, position.end());
+                    }
+                    if (converged) break;
+                }
+                return sweep;
+            }
 
-                        for (size_type i= 0, end= std::min(nrows, ncols); i < end; ++i) {
-                            ins_V[i][i] *= std::abs(R[i][i]);
-                            if (R[i][i] < zero)
-                            for (size_type j= 0; j < nrows; ++j)
-                            ins_S[j][i] *= -1;
+            // complete the columns of the square matrix U that are not defined to an orthonormal basis: a missing column
+            // is the unit vector with the largest component outside the span of the columns in place, orthogonalized twice
+            template<typename Scalar>
+            void complete_orthonormal_basis(matrix<Scalar>& U, std::vector<char>& defined) {
+                using std::sqrt;
+                const size_t n = num_rows(U);
+                for (size_t k = 0; k < n; ++k) {
+                    if (defined[k]) continue;
+                    // the squared distance of e_i to the span is 1 - sum of U(i, c)^2 over the columns in place
+                    size_t best = 0;
+                    Scalar largest(-1);
+                    for (size_t i = 0; i < n; ++i) {
+                        Scalar residual(1);
+                        for (size_t c = 0; c < n; ++c) if (defined[c]) residual -= U(i, c) * U(i, c);
+                        if (residual > largest) { largest = residual; best = i; }
+                    }
+                    std::vector<Scalar> r(n, Scalar(0));
+                    r[best] = Scalar(1);
+                    for (int pass = 0; pass < 2; ++pass) {
+                        for (size_t c = 0; c < n; ++c) {
+                            if (!defined[c]) continue;
+                            Scalar dot(0);
+                            for (size_t i = 0; i < n; ++i) dot += U(i, c) * r[i];
+                            for (size_t i = 0; i < n; ++i) r[i] -= dot * U(i, c);
                         }
                     }
-                    */
+                    Scalar norm = scaled_norm2(n, r.data(), size_t(1));
+                    for (size_t i = 0; i < n; ++i) U(i, k) = r[i] / norm;
+                    defined[k] = 1;
+                }
             }
 
-            template<typename Scalar, typename Tolerance>
-            std::tuple<matrix<Scalar>, matrix<Scalar>, matrix<Scalar>> svd(const matrix<Scalar>& A, Tolerance tol = 10e-10) {
-                using size_type = typename matrix<Scalar>::size_type;
-                size_type    ncols = num_cols(A), nrows = num_rows(A);
-                //if (nrows != ncols) std::swap(row, col);
-                matrix<Scalar> ST(ncols, ncols), V(A), D(nrows, nrows);
-                svd(A, ST, V, D, tol);
-                return std::make_tuple(ST, V, D);
+            // thin singular value decomposition A = U S V^T, with k = min(m, n):
+            // U is m x k with orthonormal columns, S is k x k diagonal with the singular values in decreasing order,
+            // and V is n x k with orthonormal columns. The left singular vectors of zero singular values are not
+            // determined by A: they complete the others to an orthonormal basis, so U keeps orthonormal columns
+            // for rank-deficient A.
+            // Tall matrices are first reduced to their triangular factor R by the blocked Householder QR, and the
+            // one-sided Jacobi iteration then orthogonalizes the columns of R. A column pair is rotated until its
+            // cosine drops below tol, and tol is never tighter than the precision of Scalar.
+            // maxThreads follows NUMERIC_GEMM_MAX_THREADS: 0 selects the process-wide pool, 1 the calling thread.
+            template<typename Scalar, typename Tolerance = double>
+            void svd(const matrix<Scalar>& A, matrix<Scalar>& U, matrix<Scalar>& S, matrix<Scalar>& V, Tolerance tol = 0, unsigned maxThreads = NUMERIC_GEMM_MAX_THREADS) {
+                const size_t m = num_rows(A), n = num_cols(A);
+                if (m < n) {
+                    // A^T = V S U^T
+                    matrix<Scalar> At(n, m);
+                    for (size_t i = 0; i < m; ++i) {
+                        for (size_t j = 0; j < n; ++j) At(j, i) = A(i, j);
+                    }
+                    svd(At, V, S, U, tol, maxThreads);
+                    return;
+                }
+                // the Jacobi iteration runs on the n x n triangular factor of tall matrices
+                matrix<Scalar> R;
+                householder_blocks<Scalar> H;
+                const bool reduced = (m > n);
+                if (reduced) H = blockedqr_factor(A, R);
+                const size_t mw = (reduced ? n : m);
+                std::vector<Scalar> Wt(n * mw), Vt(n * n, Scalar(0));
+                for (size_t i = 0; i < mw; ++i) {
+                    for (size_t j = 0; j < n; ++j) Wt[j * mw + i] = (reduced ? R(i, j) : A(i, j));
+                }
+                for (size_t j = 0; j < n; ++j) Vt[j * n + j] = Scalar(1);
+
+                double threshold = std::max(double(tol), std::sqrt(double(mw)) * double(std::numeric_limits<Scalar>::epsilon()));
+                std::unique_ptr<sw::universal::thread_pool> local;
+                sw::universal::thread_pool* pool = nullptr;
+                if (!sw::universal::is_parallel_safe<Scalar>) pool = nullptr;
+                else if (maxThreads == 0) pool = &sw::universal::default_thread_pool();
+                else if (maxThreads > 1) pool = (local = std::make_unique<sw::universal::thread_pool>(maxThreads)).get();
+                jacobi_sweeps(n, mw, Wt, Vt, threshold, pool);
 
+                // singular values are the column norms, sorted in decreasing order
+                std::vector<Scalar> sigma(n);
+                for (size_t j = 0; j < n; ++j) sigma[j] = scaled_norm2(mw, Wt.data() + j * mw, size_t(1));
+                std::vector<size_t> order(n);
+                std::iota(order.begin(), order.end(), size_t(0));
+                std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sigma[a] > sigma[b]; });
+
+                // mw == n: the working matrix is square
+                matrix<Scalar> Uw(mw, n);
+                S = matrix<Scalar>(n, n);
+                V = matrix<Scalar>(n, n);
+                std::vector<char> defined(n, 1);
+                for (size_t k = 0; k < n; ++k) {
+                    const size_t j = order[k];
+                    S(k, k) = sigma[j];
+                    for (size_t i = 0; i < n; ++i) V(i, k) = Vt[j * n + i];
+                    if (sigma[j] == Scalar(0)) {  // a zero singular value leaves its left singular vector undefined
+                        defined[k] = 0;
+                        continue;
+                    }
+                    for (size_t i = 0; i < mw; ++i) Uw(i, k) = Wt[j * mw + i] / sigma[j];
+                }
+                complete_orthonormal_basis(Uw, defined);
+                if (reduced) {
+                    // U = Q [Uw; 0], applying the reflectors to the m x n matrix without forming Q
+                    U = matrix<Scalar>(m, n);
+                    for (size_t i = 0; i < n; ++i) {
+                        for (size_t j = 0; j < n; ++j) U(i, j) = Uw(i, j);
+                    }
+                    apply_householder_blocks(H, U);
+                }
+                else {
+                    U = Uw;
+                }
+            }
+
+            template<typename Scalar, typename Tolerance = double>
+            std::tuple<matrix<Scalar>, matrix<Scalar>, matrix<Scalar>> svd(const matrix<Scalar>& A, Tolerance tol = 0) {
+                matrix<Scalar> U, S, V;
+                svd(A, U, S, V, tol);
+                return std::make_tuple(U, S, V);
             }
 
         }
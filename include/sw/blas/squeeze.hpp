@@ -10,6 +10,7 @@
 // Modified: 2022-10-30
 //
 // This file is part of the Mixed Precision Iterative Refinement project.
+#include <limits>
 #include <blas/blas.hpp>
  
 namespace sw { namespace universal {
@@ -65,7 +66,7 @@ void getS(const blas::matrix<Scalar>& A, blas::vector<Scalar>& S) {
 /// <param name="R">scale factors to apply</param>
 /// <param name="A">matrix to scale</param>
 template<typename Scalar>
-void rowScale(blas::vector<Scalar>& R, const blas::matrix<Scalar>& A) {
+void rowScale(blas::vector<Scalar>& R, blas::matrix<Scalar>& A) {
     unsigned n = static_cast<unsigned>(A.rows()); // assuming square matrix
     for (unsigned i = 0; i < n; ++i) {
         for (unsigned j = 0; j < n; ++j) {
@@ -109,12 +110,12 @@ void colScale(blas::matrix<Scalar>& A, blas::vector<Scalar>& S) {
 /// <param name="A">Working precision matrix</param>
 /// <param name="Al">Low precision matrix</param>
 template<typename Working, typename Low>
-void RoundAndReplace(const blas::matrix<Working>& Aw, const blas::matrix<Low>& Al){
+void RoundAndReplace(const blas::matrix<Working>& Aw, blas::matrix<Low>& Al){
     constexpr bool Verbose = false;
 
     unsigned m = static_cast<unsigned>(Aw.rows());
     unsigned n = static_cast<unsigned>(Aw.cols());
-    Low maxpos(SpecificValue::maxpos);
+    Low maxpos = std::numeric_limits<Low>::max();
     for (unsigned i = 0; i < m; ++i) {
         double maxval{ 0 };
         for (unsigned j = 0; j < n; ++j) {
@@ -134,7 +135,7 @@ void ScaleAndRound(blas::matrix<WorkingPrecision>& Aw, blas::matrix<LowPrecision
     constexpr bool Trace = false;
     /* Algo 22: scale by scalar, then round */
     WorkingPrecision Amax = maxelement(Aw);
-    LowPrecision xmax(SpecificValue::maxpos);
+    LowPrecision xmax = std::numeric_limits<LowPrecision>::max();
     WorkingPrecision Xmax(xmax);
     
     // 
@@ -14,5 +14,6 @@ constexpr uint32_t UNIVERSAL_AGGREGATE_TENSOR = 0x8008;
 
 #include <numeric/containers/vector.hpp>
 #include <numeric/containers/matrix.hpp>
+#include <numeric/containers/sparse_matrix.hpp>
 #include <numeric/containers/tensor.hpp>
 
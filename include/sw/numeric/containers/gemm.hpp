@@ -0,0 +1,154 @@
+#pragma once
+// gemm.hpp: cache-blocked, multithreaded matrix-matrix product kernel for the numeric containers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include <universal/utility/thread_pool.hpp>
+
+// maximum number of threads of the gemm kernel: 0 selects the hardware concurrency, 1 runs it on the calling thread.
+// Scalars that are not parallel safe always run on the calling thread.
+#ifndef NUMERIC_GEMM_MAX_THREADS
+#define NUMERIC_GEMM_MAX_THREADS 0
+#endif
+
+namespace sw { namespace numeric { namespace containers {
+
+/*
+ * C = A * B for row-major storage, following the Goto/BLIS structure:
+ *   - the output is partitioned into mc x nc tiles, which are the units of parallel work
+ *   - for each kc slice of the inner dimension, the tile's slivers of A and B are packed
+ *     into contiguous mr x kc and kc x nr panels that stay resident in L2 and L1
+ *   - an mr x nr register-blocked micro-kernel updates C from a pair of panels
+ * The micro-kernel loads C, accumulates the kc products in order, and stores C back,
+ * so each element of C sees exactly the sequence of roundings of the textbook i-j-k loop:
+ * the result is identical to the naive product and independent of the thread count
+ * (as long as the compiler does not contract the multiply-add into an fma).
+ */
+template<typename Scalar>
+struct gemm_blocking {
+	static constexpr size_t mr = 4;  // rows of the micro-kernel
+	static constexpr size_t nr = (sizeof(Scalar) == 4 ? 8 : 4);  // columns of the micro-kernel: eight 32-bit values fill a 256-bit register
+	// a kc x nr panel of B fills about half of a 32KB L1, an mc x kc block of A about half of a 256KB L2
+	static constexpr size_t kc = std::max<size_t>(16, std::min<size_t>(256, 16384 / (nr * sizeof(Scalar))));
+	static constexpr size_t mc = std::max<size_t>(mr, std::min<size_t>(128, (131072 / (kc * sizeof(Scalar))) / mr * mr));
+	static constexpr size_t nc = 256;
+};
+
+// pack rows [i0, i0+m) and columns [k0, k0+k) of a row-major A (leading dimension lda)
+// into panels of mr rows, each stored k-major; rows beyond m are zero padded
+template<typename Scalar, size_t mr>
+void gemm_pack_a(const Scalar* A, size_t lda, size_t i0, size_t m, size_t k0, size_t k, Scalar* packed) {
+	for (size_t ip = 0; ip < m; ip += mr) {
+		size_t rows = std::min(mr, m - ip);
+		for (size_t p = 0; p < k; ++p) {
+			for (size_t i = 0; i < rows; ++i) *packed++ = A[(i0 + ip + i) * lda + k0 + p];
+			for (size_t i = rows; i < mr; ++i) *packed++ = Scalar(0);
+		}
+	}
+}
+
+// pack rows [k0, k0+k) and columns [j0, j0+n) of a row-major B (leading dimension ldb)
+// into panels of nr columns, each stored k-major; columns beyond n are zero padded
+template<typename Scalar, size_t nr>
+void gemm_pack_b(const Scalar* B, size_t ldb, size_t k0, size_t k, size_t j0, size_t n, Scalar* packed) {
+	for (size_t jp = 0; jp < n; jp += nr) {
+		size_t cols = std::min(nr, n - jp);
+		for (size_t p = 0; p < k; ++p) {
+			const Scalar* b = B + (k0 + p) * ldb + j0 + jp;
+			for (size_t j = 0; j < cols; ++j) *packed++ = b[j];
+			for (size_t j = cols; j < nr; ++j) *packed++ = Scalar(0);
+		}
+	}
+}
+
+// C[0:m, 0:n] += A panel * B panel with the accumulators held in registers, m <= mr and n <= nr
+template<typename Scalar, size_t mr, size_t nr>
+void gemm_micro_kernel(size_t k, const Scalar* a, const Scalar* b, Scalar* C, size_t ldc, size_t m, size_t n) {
+	Scalar c[mr][nr];
+	for (size_t i = 0; i < mr; ++i) {
+		for (size_t j = 0; j < nr; ++j) c[i][j] = (i < m && j < n) ? C[i * ldc + j] : Scalar(0);
+	}
+	for (size_t p = 0; p < k; ++p, a += mr, b += nr) {
+		for (size_t i = 0; i < mr; ++i) {
+			Scalar ai = a[i];
+			for (size_t j = 0; j < nr; ++j) c[i][j] += ai * b[j];
+		}
+	}
+	for (size_t i = 0; i < m; ++i) {
+		for (size_t j = 0; j < n; ++j) C[i * ldc + j] = c[i][j];
+	}
+}
+
+// C = A * B, where A is m x k, B is k x n, and C is m x n, all row-major and contiguous
+// C is overwritten; the tiles run on the given pool, or on the calling thread when pool is nullptr
+template<typename Scalar>
+void gemm_kernel(size_t m, size_t n, size_t k, const Scalar* A, const Scalar* B, Scalar* C, sw::universal::thread_pool* pool) {
+	using blocking = gemm_blocking<Scalar>;
+	constexpr size_t mr = blocking::mr, nr = blocking::nr, mc = blocking::mc, kc = blocking::kc, nc = blocking::nc;
+
+	std::fill(C, C + m * n, Scalar(0));
+	if (m == 0 || n == 0 || k == 0) return;
+	// tiny products do not amortize the packing
+	if (m * n * k < 16 * 16 * 16) {
+		for (size_t i = 0; i < m; ++i) {
+			for (size_t j = 0; j < n; ++j) {
+				Scalar e = Scalar(0);
+				for (size_t p = 0; p < k; ++p) e += A[i * k + p] * B[p * n + j];
+				C[i * n + j] = e;
+			}
+		}
+		return;
+	}
+	size_t rowTiles = (m + mc - 1) / mc;
+	size_t colTiles = (n + nc - 1) / nc;
+	auto tile = [&](size_t t) {
+		size_t i0 = (t / colTiles) * mc, j0 = (t % colTiles) * nc;
+		size_t mt = std::min(mc, m - i0), nt = std::min(nc, n - j0);
+		std::vector<Scalar> packedA(((mt + mr - 1) / mr) * mr * kc);
+		std::vector<Scalar> packedB(((nt + nr - 1) / nr) * nr * kc);
+		for (size_t k0 = 0; k0 < k; k0 += kc) {
+			size_t kt = std::min(kc, k - k0);
+			gemm_pack_a<Scalar, mr>(A, k, i0, mt, k0, kt, packedA.data());
+			gemm_pack_b<Scalar, nr>(B, n, k0, kt, j0, nt, packedB.data());
+			for (size_t jr = 0; jr < nt; jr += nr) {
+				const Scalar* b = packedB.data() + (jr / nr) * nr * kt;
+				for (size_t ir = 0; ir < mt; ir += mr) {
+					const Scalar* a = packedA.data() + (ir / mr) * mr * kt;
+					Scalar* c = C + (i0 + ir) * n + j0 + jr;
+					gemm_micro_kernel<Scalar, mr, nr>(kt, a, b, c, n, std::min(mr, mt - ir), std::min(nr, nt - jr));
+				}
+			}
+		}
+	};
+	size_t nrTiles = rowTiles * colTiles;
+	// small products are not worth the hand-off to the worker threads
+	constexpr size_t parallelThreshold = 64 * 64 * 64;
+	if (pool == nullptr || !sw::universal::is_parallel_safe<Scalar> || nrTiles == 1 || m * n * k < parallelThreshold) {
+		for (size_t t = 0; t < nrTiles; ++t) tile(t);
+	}
+	else {
+		pool->parallel_for(nrTiles, tile);
+	}
+}
+
+// C = A * B on at most maxThreads threads: 0 selects the process-wide pool, 1 the calling thread
+template<typename Scalar>
+void gemm_kernel(size_t m, size_t n, size_t k, const Scalar* A, const Scalar* B, Scalar* C, unsigned maxThreads = NUMERIC_GEMM_MAX_THREADS) {
+	if (maxThreads == 1) {
+		gemm_kernel(m, n, k, A, B, C, static_cast<sw::universal::thread_pool*>(nullptr));
+	}
+	else if (maxThreads == 0) {
+		gemm_kernel(m, n, k, A, B, C, &sw::universal::default_thread_pool());
+	}
+	else {
+		sw::universal::thread_pool pool(maxThreads);
+		gemm_kernel(m, n, k, A, B, C, &pool);
+	}
+}
+
+}}} // namespace sw::numeric::containers
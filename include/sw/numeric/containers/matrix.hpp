@@ -9,7 +9,9 @@
 #include <vector>
 #include <initializer_list>
 #include <map>
+#include <memory>
 #include <blas/exceptions.hpp>
+#include <numeric/containers/gemm.hpp>
 
 #if defined(__clang__)
 /* Clang/LLVM. ---------------------------------------------- */
@@ -374,15 +376,8 @@ matrix<Scalar> operator*(const matrix<Scalar>& A, const matrix<Scalar>& B) {
 	size_type cols = B.cols();
 	size_type dots = A.cols();
 	matrix<Scalar> C(rows, cols);
-	for (size_type i = 0; i < rows; ++i) {
-		for (size_type j = 0; j < cols; ++j) {
-			Scalar e = Scalar(0);
-			for (size_type k = 0; k < dots; ++k) {
-				e += A(i, k) * B(k, j);
-			}
-			C(i, j) = e;
-		}
-	}
+	// packed, tiled, and multithreaded: rounds identically to the i-j-k loop
+	gemm_kernel(rows, cols, dots, std::to_address(A.begin()), std::to_address(B.begin()), std::to_address(C.begin()));
 	return C;
 }
 
@@ -0,0 +1,254 @@
+#pragma once
+// sparse_matrix.hpp: compressed sparse row and compressed sparse column matrix class
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <tuple>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <blas/exceptions.hpp>
+#include <numeric/containers/vector.hpp>
+#include <numeric/containers/matrix.hpp>
+
+namespace sw { namespace numeric { namespace containers {
+
+// storage order of a sparse matrix
+enum class SparseFormat { CSR, CSC };
+
+/*
+ * sparse_matrix stores the nonzeros of an m x n matrix in compressed form:
+ *   CSR: offsets has m+1 entries, row i occupies [offsets[i], offsets[i+1]) of indices (column) and values
+ *   CSC: offsets has n+1 entries, column j occupies [offsets[j], offsets[j+1]) of indices (row) and values
+ * The indices within a row (column) are sorted and unique, so element access is a binary search
+ * and the matrix-vector product is O(nnz). Offsets and indices are 32-bit: construction throws
+ * std::length_error when the number of nonzeros or the minor dimension does not fit.
+ */
+template<typename Scalar, SparseFormat format = SparseFormat::CSR>
+class sparse_matrix {
+public:
+	typedef Scalar                                  value_type;
+	typedef const value_type&                       const_reference;
+	typedef value_type&                             reference;
+	typedef typename std::vector<Scalar>::size_type size_type;
+	typedef uint32_t                                index_type;
+	typedef std::tuple<size_type, size_type, Scalar> triplet;   // (row, column, value)
+	static constexpr SparseFormat storage_format = format;
+
+	sparse_matrix() : _m{ 0 }, _n{ 0 }, _offsets(1, 0) {}
+	sparse_matrix(size_type m, size_type n) : _m{ m }, _n{ n }, _offsets(major(m, n) + 1, 0) { check_minor_range(); }
+	// assemble from coordinate triplets: duplicates are summed, explicit zeros are kept
+	sparse_matrix(size_type m, size_type n, std::vector<triplet> entries) : _m{ m }, _n{ n } {
+		check_minor_range();
+		assemble(entries);
+	}
+	// adopt an already compressed structure
+	sparse_matrix(size_type m, size_type n, std::vector<index_type> offsets, std::vector<index_type> indices, std::vector<Scalar> values)
+		: _m{ m }, _n{ n }, _offsets(std::move(offsets)), _indices(std::move(indices)), _values(std::move(values)) {
+		check_minor_range();
+		if (_offsets.size() != major(_m, _n) + 1 || _indices.size() != _values.size() || _offsets.back() != _values.size()) {
+			throw std::invalid_argument("sparse_matrix: inconsistent compressed structure");
+		}
+	}
+	// compress a dense matrix, dropping its zeros
+	template<typename SourceType>
+	explicit sparse_matrix(const matrix<SourceType>& A) : _m{ A.rows() }, _n{ A.cols() } {
+		check_minor_range();
+		_offsets.assign(major(_m, _n) + 1, 0);
+		for (size_type p = 0; p < major(_m, _n); ++p) {
+			for (size_type q = 0; q < minor(_m, _n); ++q) {
+				Scalar v = (format == SparseFormat::CSR) ? Scalar(A(p, q)) : Scalar(A(q, p));
+				if (v != Scalar(0)) {
+					if (_values.size() == max_index) throw std::length_error("sparse_matrix: number of nonzeros exceeds the index type");
+					_indices.push_back(static_cast<index_type>(q));
+					_values.push_back(v);
+				}
+			}
+			_offsets[p + 1] = static_cast<index_type>(_values.size());
+		}
+	}
+	// converting constructor: changes the Scalar type and/or the storage format
+	template<typename SourceType, SparseFormat sourceFormat>
+	sparse_matrix(const sparse_matrix<SourceType, sourceFormat>& S) : _m{ S.rows() }, _n{ S.cols() } {
+		if constexpr (sourceFormat == format) {
+			_offsets = S.offsets();
+			_indices = S.indices();
+			_values.reserve(S.nnz());
+			for (const auto& v : S.values()) _values.push_back(Scalar(v));
+		}
+		else {
+			// transpose the compressed structure with a counting sort on the minor index
+			size_type nrMajor = major(_m, _n);
+			_offsets.assign(nrMajor + 1, 0);
+			for (auto idx : S.indices()) ++_offsets[idx + 1];
+			for (size_type p = 0; p < nrMajor; ++p) _offsets[p + 1] += _offsets[p];
+			_indices.resize(S.nnz());
+			_values.resize(S.nnz());
+			std::vector<index_type> next(_offsets.begin(), _offsets.end() - 1);
+			size_type nrSourceMajor = minor(_m, _n);
+			for (size_type q = 0; q < nrSourceMajor; ++q) {
+				for (index_type k = S.offsets()[q]; k < S.offsets()[q + 1]; ++k) {
+					index_type dst = next[S.indices()[k]]++;
+					_indices[dst] = static_cast<index_type>(q);
+					_values[dst] = Scalar(S.values()[k]);
+				}
+			}
+		}
+	}
+
+	// element access: zero for entries that are not stored
+	Scalar operator()(size_type i, size_type j) const {
+		size_type p = (format == SparseFormat::CSR ? i : j);
+		size_type q = (format == SparseFormat::CSR ? j : i);
+		auto first = _indices.begin() + _offsets[p];
+		auto last = _indices.begin() + _offsets[p + 1];
+		auto it = std::lower_bound(first, last, static_cast<index_type>(q));
+		if (it != last && *it == q) return _values[static_cast<size_type>(it - _indices.begin())];
+		return Scalar(0);
+	}
+
+	size_type rows() const noexcept { return _m; }
+	size_type cols() const noexcept { return _n; }
+	size_type nnz() const noexcept { return _values.size(); }
+
+	// compressed structure
+	const std::vector<index_type>& offsets() const noexcept { return _offsets; }
+	const std::vector<index_type>& indices() const noexcept { return _indices; }
+	const std::vector<Scalar>& values() const noexcept { return _values; }
+	std::vector<Scalar>& values() noexcept { return _values; }
+
+	// the diagonal of the matrix, zero where it is not stored
+	vector<Scalar> diagonal() const {
+		size_type d = std::min(_m, _n);
+		vector<Scalar> diag(d);
+		for (size_type i = 0; i < d; ++i) diag[i] = (*this)(i, i);
+		return diag;
+	}
+
+	// expand into a dense matrix
+	matrix<Scalar> to_dense() const {
+		matrix<Scalar> A(_m, _n);
+		for (size_type p = 0; p < major(_m, _n); ++p) {
+			for (index_type k = _offsets[p]; k < _offsets[p + 1]; ++k) {
+				if constexpr (format == SparseFormat::CSR) A(p, _indices[k]) = _values[k]; else A(_indices[k], p) = _values[k];
+			}
+		}
+		return A;
+	}
+
+	void clear() { _m = _n = 0; _offsets.assign(1, 0); _indices.clear(); _values.clear(); }
+
+private:
+	size_type _m, _n;
+	std::vector<index_type> _offsets;
+	std::vector<index_type> _indices;
+	std::vector<Scalar>     _values;
+
+	static constexpr size_type major(size_type m, size_type n) { return (format == SparseFormat::CSR ? m : n); }
+	static constexpr size_type minor(size_type m, size_type n) { return (format == SparseFormat::CSR ? n : m); }
+	static constexpr size_type max_index = std::numeric_limits<index_type>::max();
+
+	// the minor indices and the offsets must be representable in index_type
+	void check_minor_range() const {
+		if (minor(_m, _n) > max_index) throw std::length_error("sparse_matrix: dimension exceeds the index type");
+	}
+
+	void assemble(std::vector<triplet>& entries) {
+		if (entries.size() > max_index) throw std::length_error("sparse_matrix: number of nonzeros exceeds the index type");
+		for (const auto& e : entries) {
+			if (std::get<0>(e) >= _m || std::get<1>(e) >= _n) throw std::out_of_range("sparse_matrix: triplet outside of the matrix");
+		}
+		auto key = [](const triplet& e) {
+			return (format == SparseFormat::CSR ? std::make_pair(std::get<0>(e), std::get<1>(e)) : std::make_pair(std::get<1>(e), std::get<0>(e)));
+		};
+		std::stable_sort(entries.begin(), entries.end(), [&](const triplet& a, const triplet& b) { return key(a) < key(b); });
+		_offsets.assign(major(_m, _n) + 1, 0);
+		_indices.clear();
+		_values.clear();
+		_indices.reserve(entries.size());
+		_values.reserve(entries.size());
+		for (size_t k = 0; k < entries.size(); ++k) {
+			auto [p, q] = key(entries[k]);
+			if (k > 0 && key(entries[k - 1]) == std::make_pair(p, q)) {
+				_values.back() += std::get<2>(entries[k]);
+				continue;
+			}
+			_indices.push_back(static_cast<index_type>(q));
+			_values.push_back(std::get<2>(entries[k]));
+			++_offsets[p + 1];
+		}
+		for (size_type p = 0; p < major(_m, _n); ++p) _offsets[p + 1] += _offsets[p];
+	}
+};
+
+template<typename Scalar, SparseFormat format>
+inline typename sparse_matrix<Scalar, format>::size_type num_rows(const sparse_matrix<Scalar, format>& A) { return A.rows(); }
+template<typename Scalar, SparseFormat format>
+inline typename sparse_matrix<Scalar, format>::size_type num_cols(const sparse_matrix<Scalar, format>& A) { return A.cols(); }
+template<typename Scalar, SparseFormat format>
+inline typename sparse_matrix<Scalar, format>::size_type nnz(const sparse_matrix<Scalar, format>& A) { return A.nnz(); }
+
+// ostream operator: the coordinate list of the nonzeros
+template<typename Scalar, SparseFormat format>
+std::ostream& operator<<(std::ostream& ostr, const sparse_matrix<Scalar, format>& A) {
+	using size_type = typename sparse_matrix<Scalar, format>::size_type;
+	auto width = ostr.width();
+	ostr << A.rows() << ' ' << A.cols() << ' ' << A.nnz() << '\n';
+	size_type nrMajor = (format == SparseFormat::CSR ? A.rows() : A.cols());
+	for (size_type p = 0; p < nrMajor; ++p) {
+		for (auto k = A.offsets()[p]; k < A.offsets()[p + 1]; ++k) {
+			size_type i = (format == SparseFormat::CSR ? p : A.indices()[k]);
+			size_type j = (format == SparseFormat::CSR ? A.indices()[k] : p);
+			ostr << i << ' ' << j << ' ' << std::setw(width) << A.values()[k] << '\n';
+		}
+	}
+	return ostr;
+}
+
+// sparse matrix-vector product y = A * x where the products are accumulated in AccumulationType
+// and the result is rounded to ResultType: the matrix, the vector, the accumulator, and the result
+// can all be in different precisions
+template<typename AccumulationType, typename ResultType, typename MatrixScalar, SparseFormat format, typename VectorScalar>
+vector<ResultType> spmv(const sparse_matrix<MatrixScalar, format>& A, const vector<VectorScalar>& x) {
+	using size_type = typename sparse_matrix<MatrixScalar, format>::size_type;
+	if (A.cols() != size(x)) throw sw::blas::matmul_incompatible_matrices(sw::blas::incompatible_matrices(A.rows(), A.cols(), size(x), 1, "*").what());
+	const auto& offsets = A.offsets();
+	const auto& indices = A.indices();
+	const auto& values = A.values();
+	vector<ResultType> y(A.rows());
+	if constexpr (format == SparseFormat::CSR) {
+		for (size_type i = 0; i < A.rows(); ++i) {
+			AccumulationType sum{ 0 };
+			for (auto k = offsets[i]; k < offsets[i + 1]; ++k) {
+				sum += AccumulationType(values[k]) * AccumulationType(x[indices[k]]);
+			}
+			y[i] = ResultType(sum);
+		}
+	}
+	else {
+		std::vector<AccumulationType> sum(A.rows(), AccumulationType(0));
+		for (size_type j = 0; j < A.cols(); ++j) {
+			AccumulationType xj = AccumulationType(x[j]);
+			for (auto k = offsets[j]; k < offsets[j + 1]; ++k) {
+				sum[indices[k]] += AccumulationType(values[k]) * xj;
+			}
+		}
+		for (size_type i = 0; i < A.rows(); ++i) y[i] = ResultType(sum[i]);
+	}
+	return y;
+}
+
+// sparse matrix-vector product in the precision of the matrix
+template<typename Scalar, SparseFormat format>
+vector<Scalar> operator*(const sparse_matrix<Scalar, format>& A, const vector<Scalar>& x) {
+	return spmv<Scalar, Scalar>(A, x);
+}
+
+}}} // namespace sw::numeric::containers
@@ -0,0 +1,399 @@
+#pragma once
+// conv2d.hpp: mixed-precision 2D convolution with direct, im2col, and Winograd algorithms
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <numeric/containers/gemm.hpp>
+#include <universal/utility/thread_pool.hpp>
+
+namespace sw { namespace dnn {
+
+// shape of a convolution: the filters are out_channels x in_channels x kernel_height x kernel_width
+struct conv2d_parameters {
+    size_t in_channels{ 1 };
+    size_t out_channels{ 1 };
+    size_t kernel_height{ 3 };
+    size_t kernel_width{ 3 };
+    size_t stride_h{ 1 };
+    size_t stride_w{ 1 };
+    size_t pad_h{ 0 };
+    size_t pad_w{ 0 };
+    size_t dilation_h{ 1 };
+    size_t dilation_w{ 1 };
+};
+
+enum class conv2d_algorithm {
+    Automatic,  // selected from the tensor shape, see conv2d::schedule
+    Direct,     // a dot product per output element, no extra memory
+    Im2col,     // unfold the receptive fields of a sample and multiply with the gemm kernel
+    Winograd    // F(2x2,3x3): 16 multiplies per 2x2 output tile instead of 36, for 3x3 filters with unit stride
+};
+
+// the dimension the worker pool splits
+enum class conv2d_partition {
+    Batch,    // whole samples per thread
+    Channels  // one sample at a time, split over output channels, gemm tiles, or Winograd frequencies
+};
+
+struct conv2d_schedule {
+    conv2d_algorithm algorithm;
+    conv2d_partition partition;
+};
+
+inline std::string to_string(conv2d_algorithm algorithm) {
+    switch (algorithm) {
+    case conv2d_algorithm::Direct:   return "direct";
+    case conv2d_algorithm::Im2col:   return "im2col";
+    case conv2d_algorithm::Winograd: return "winograd";
+    default:                         return "automatic";
+    }
+}
+
+// conversion between number systems that may not know each other, through double
+template<typename To, typename From>
+inline To conv2d_convert(const From& v) {
+    if constexpr (std::is_same_v<To, From>) {
+        return v;
+    }
+    else if constexpr (std::is_arithmetic_v<To> && std::is_arithmetic_v<From>) {
+        return static_cast<To>(v);
+    }
+    else {
+        return To(double(v));
+    }
+}
+
+/// <summary>
+/// conv2d: NCHW convolution with inputs in InputT, filters in WeightT, products accumulated in AccumT,
+/// and results rounded to OutputT
+/// </summary>
+/// The filters are widened to AccumT once, when they are set. The pool is created on the first call and
+/// reused, as are the per-thread workspaces. Every schedule computes an output element with the same
+/// sequence of operations, so the result depends on the algorithm but not on the number of threads.
+/// maxThreads follows NUMERIC_GEMM_MAX_THREADS: 0 selects the process-wide pool, 1 the calling thread.
+template<typename InputT, typename WeightT = InputT, typename AccumT = InputT, typename OutputT = InputT>
+class conv2d {
+public:
+    using input_type       = InputT;
+    using weight_type      = WeightT;
+    using accumulator_type = AccumT;
+    using output_type      = OutputT;
+
+    static constexpr bool uses_mixed_precision =
+        !std::is_same_v<InputT, WeightT> || !std::is_same_v<WeightT, AccumT> || !std::is_same_v<AccumT, OutputT>;
+
+    conv2d(const conv2d_parameters& parameters, unsigned maxThreads = NUMERIC_GEMM_MAX_THREADS)
+        : _p{ parameters }, _maxThreads{ maxThreads },
+          _weights(parameters.out_channels * parameters.in_channels * parameters.kernel_height * parameters.kernel_width),
+          _bias(parameters.out_channels, AccumT(0)) {
+        if (_p.in_channels == 0 || _p.out_channels == 0 || _p.kernel_height == 0 || _p.kernel_width == 0) throw std::invalid_argument("conv2d: empty filter bank");
+        if (_p.stride_h == 0 || _p.stride_w == 0 || _p.dilation_h == 0 || _p.dilation_w == 0) throw std::invalid_argument("conv2d: stride and dilation must be positive");
+        pack();
+    }
+
+    const conv2d_parameters& parameters() const noexcept { return _p; }
+
+    // filters in [out_channels, in_channels, kernel_height, kernel_width] order
+    void set_weights(const std::vector<WeightT>& weights) {
+        if (weights.size() != _weights.size()) throw std::invalid_argument("conv2d: expected " + std::to_string(_weights.size()) + " weights, got " + std::to_string(weights.size()));
+        _weights = weights;
+        pack();
+    }
+    void set_bias(const std::vector<AccumT>& bias) {
+        if (bias.size() != _p.out_channels) throw std::invalid_argument("conv2d: expected " + std::to_string(_p.out_channels) + " biases, got " + std::to_string(bias.size()));
+        _bias = bias;
+    }
+    const std::vector<WeightT>& weights() const noexcept { return _weights; }
+    const std::vector<AccumT>& bias() const noexcept { return _bias; }
+
+    size_t output_height(size_t H) const {
+        size_t extent = _p.dilation_h * (_p.kernel_height - 1) + 1;
+        if (H + 2 * _p.pad_h < extent) throw std::invalid_argument("conv2d: filter is taller than the padded input");
+        return (H + 2 * _p.pad_h - extent) / _p.stride_h + 1;
+    }
+    size_t output_width(size_t W) const {
+        size_t extent = _p.dilation_w * (_p.kernel_width - 1) + 1;
+        if (W + 2 * _p.pad_w < extent) throw std::invalid_argument("conv2d: filter is wider than the padded input");
+        return (W + 2 * _p.pad_w - extent) / _p.stride_w + 1;
+    }
+
+    bool winograd_applicable() const noexcept {
+        return _p.kernel_height == 3 && _p.kernel_width == 3 && _p.stride_h == 1 && _p.stride_w == 1 && _p.dilation_h == 1 && _p.dilation_w == 1;
+    }
+
+    // Winograd is selected when there are enough channels to amortize the tile transforms, and when the accumulator
+    // has the precision to absorb the cancellation of the transforms. im2col is selected when the gemm has enough work
+    // and the unfolded sample fits the workspace budget, direct convolution otherwise.
+    // A batch with at least one sample per thread is split by samples, smaller batches split each sample.
+    conv2d_schedule schedule(size_t N, size_t H, size_t W) const {
+        return schedule(N, H, W, (_maxThreads == 0 ? size_t(sw::universal::default_thread_pool().size()) : size_t(_maxThreads)));
+    }
+    // the schedule on a pool of the given number of threads
+    conv2d_schedule schedule(size_t N, size_t H, size_t W, size_t threads) const {
+        const size_t P = output_height(H), Q = output_width(W);
+        const size_t crs = _p.in_channels * _p.kernel_height * _p.kernel_width;
+        constexpr bool accurateAccumulator = std::numeric_limits<AccumT>::is_specialized && std::numeric_limits<AccumT>::digits >= 16;
+        conv2d_schedule s{ conv2d_algorithm::Direct, conv2d_partition::Batch };
+        if (accurateAccumulator && winograd_applicable() && _p.in_channels >= 16 && _p.out_channels >= 16 && P >= 4 && Q >= 4) {
+            s.algorithm = conv2d_algorithm::Winograd;
+        }
+        else if (crs >= 16 && _p.out_channels >= 4 && crs * P * Q <= im2colBudget) {
+            s.algorithm = conv2d_algorithm::Im2col;
+        }
+        if (!sw::universal::is_parallel_safe<InputT, WeightT, AccumT, OutputT>) threads = 1;
+        if (threads > 1 && N < threads) s.partition = conv2d_partition::Channels;
+        return s;
+    }
+
+    // output = conv(input) + bias for N samples of in_channels x H x W, the output is resized to N x out_channels x P x Q
+    void forward(const std::vector<InputT>& input, size_t N, size_t H, size_t W, std::vector<OutputT>& output, conv2d_algorithm algorithm = conv2d_algorithm::Automatic) {
+        forward(input, N, H, W, output, algorithm, pool());
+    }
+    // the same on the workers of the caller instead of the pool selected by maxThreads, nullptr runs on the calling thread
+    void forward(const std::vector<InputT>& input, size_t N, size_t H, size_t W, std::vector<OutputT>& output, conv2d_algorithm algorithm, sw::universal::thread_pool* workers) {
+        if (!sw::universal::is_parallel_safe<InputT, WeightT, AccumT, OutputT>) workers = nullptr;
+        if (input.size() != N * _p.in_channels * H * W) {
+            throw std::invalid_argument("conv2d: expected " + std::to_string(N * _p.in_channels * H * W) + " input values, got " + std::to_string(input.size()));
+        }
+        conv2d_schedule s = schedule(N, H, W, (workers == nullptr ? size_t(1) : size_t(workers->size())));
+        if (algorithm != conv2d_algorithm::Automatic) s.algorithm = algorithm;
+        if (s.algorithm == conv2d_algorithm::Winograd && !winograd_applicable()) throw std::invalid_argument("conv2d: Winograd F(2x2,3x3) requires 3x3 filters with unit stride and dilation");
+        const size_t P = output_height(H), Q = output_width(W);
+        output.resize(N * _p.out_channels * P * Q);
+        if (N == 0) return;
+        if (s.algorithm == conv2d_algorithm::Winograd && !_transformed) transform_filters();
+
+        shape sh{ H, W, P, Q };
+        if (workers == nullptr || s.partition == conv2d_partition::Channels) {
+            workspace& ws = scratch(0);
+            for (size_t n = 0; n < N; ++n) sample(s.algorithm, sh, input.data() + n * _p.in_channels * H * W, output.data() + n * _p.out_channels * P * Q, ws, workers);
+        }
+        else {
+            const size_t nrChunks = std::min(N, size_t(workers->size()));
+            for (size_t c = 0; c < nrChunks; ++c) scratch(c);
+            workers->parallel_for(nrChunks, [&](size_t c) {
+                for (size_t n = N * c / nrChunks; n < N * (c + 1) / nrChunks; ++n) {
+                    sample(s.algorithm, sh, input.data() + n * _p.in_channels * H * W, output.data() + n * _p.out_channels * P * Q, _scratch[c], nullptr);
+                }
+            });
+        }
+    }
+
+private:
+    static constexpr size_t im2colBudget = size_t(1) << 22;  // elements of the unfolded sample
+
+    struct shape {
+        size_t H, W, P, Q;
+    };
+    struct workspace {
+        std::vector<AccumT> in, col, acc, V, M;
+    };
+
+    conv2d_parameters          _p;
+    unsigned                   _maxThreads;
+    std::vector<WeightT>       _weights;
+    std::vector<AccumT>        _bias;
+    std::vector<AccumT>        _w;            // the filters in AccumT, out_channels x (in_channels kernel_height kernel_width)
+    std::vector<AccumT>        _u;            // the Winograd filters, 16 x out_channels x in_channels
+    bool                       _transformed{ false };
+    std::vector<workspace>     _scratch;
+    std::shared_ptr<sw::universal::thread_pool> _pool;
+
+    void pack() {
+        _w.resize(_weights.size());
+        for (size_t i = 0; i < _weights.size(); ++i) _w[i] = conv2d_convert<AccumT>(_weights[i]);
+        _transformed = false;
+    }
+
+    sw::universal::thread_pool* pool() {
+        if (_maxThreads == 1 || !sw::universal::is_parallel_safe<InputT, WeightT, AccumT, OutputT>) return nullptr;
+        if (_maxThreads == 0) return &sw::universal::default_thread_pool();
+        if (!_pool) _pool = std::make_shared<sw::universal::thread_pool>(_maxThreads);
+        return _pool.get();
+    }
+
+    workspace& scratch(size_t i) {
+        if (_scratch.size() <= i) _scratch.resize(i + 1);
+        return _scratch[i];
+    }
+
+    template<typename Body>
+    static void split(sw::universal::thread_pool* workers, size_t n, Body&& body) {
+        if (workers == nullptr || n < 2) {
+            for (size_t i = 0; i < n; ++i) body(i);
+        }
+        else {
+            workers->parallel_for(n, body);
+        }
+    }
+
+    // one sample; the workers, when given, split the work inside the sample
+    void sample(conv2d_algorithm algorithm, const shape& sh, const InputT* x, OutputT* y, workspace& ws, sw::universal::thread_pool* workers) {
+        const size_t chw = _p.in_channels * sh.H * sh.W;
+        if (ws.in.size() < chw) ws.in.resize(chw);
+        for (size_t i = 0; i < chw; ++i) ws.in[i] = conv2d_convert<AccumT>(x[i]);
+        switch (algorithm) {
+        case conv2d_algorithm::Im2col:
+            im2col(sh, y, ws, workers);
+            break;
+        case conv2d_algorithm::Winograd:
+            winograd(sh, y, ws, workers);
+            break;
+        default:
+            direct(sh, y, ws, workers);
+            break;
+        }
+    }
+
+    void direct(const shape& sh, OutputT* y, workspace& ws, sw::universal::thread_pool* workers) const {
+        const size_t C = _p.in_channels, R = _p.kernel_height, S = _p.kernel_width, pq = sh.P * sh.Q;
+        const AccumT* in = ws.in.data();
+        split(workers, _p.out_channels, [&](size_t k) {
+            const AccumT* w = _w.data() + k * C * R * S;
+            for (size_t p = 0; p < sh.P; ++p) {
+                for (size_t q = 0; q < sh.Q; ++q) {
+                    AccumT acc(0);
+                    for (size_t c = 0; c < C; ++c) {
+                        for (size_t r = 0; r < R; ++r) {
+                            const int64_t h = static_cast<int64_t>(p * _p.stride_h + r * _p.dilation_h) - static_cast<int64_t>(_p.pad_h);
+                            if (h < 0 || h >= static_cast<int64_t>(sh.H)) continue;
+                            for (size_t s = 0; s < S; ++s) {
+                                const int64_t v = static_cast<int64_t>(q * _p.stride_w + s * _p.dilation_w) - static_cast<int64_t>(_p.pad_w);
+                                if (v < 0 || v >= static_cast<int64_t>(sh.W)) continue;
+                                acc += w[(c * R + r) * S + s] * in[(c * sh.H + size_t(h)) * sh.W + size_t(v)];
+                            }
+                        }
+                    }
+                    y[k * pq + p * sh.Q + q] = conv2d_convert<OutputT>(acc + _bias[k]);
+                }
+            }
+        });
+    }
+
+    void im2col(const shape& sh, OutputT* y, workspace& ws, sw::universal::thread_pool* workers) const {
+        const size_t C = _p.in_channels, R = _p.kernel_height, S = _p.kernel_width, K = _p.out_channels, pq = sh.P * sh.Q, crs = C * R * S;
+        if (ws.col.size() < crs * pq) ws.col.resize(crs * pq);
+        if (ws.acc.size() < K * pq) ws.acc.resize(K * pq);
+        const AccumT* in = ws.in.data();
+        for (size_t c = 0; c < C; ++c) {
+            for (size_t r = 0; r < R; ++r) {
+                for (size_t s = 0; s < S; ++s) {
+                    AccumT* row = ws.col.data() + ((c * R + r) * S + s) * pq;
+                    for (size_t p = 0; p < sh.P; ++p) {
+                        const int64_t h = static_cast<int64_t>(p * _p.stride_h + r * _p.dilation_h) - static_cast<int64_t>(_p.pad_h);
+                        for (size_t q = 0; q < sh.Q; ++q) {
+                            const int64_t v = static_cast<int64_t>(q * _p.stride_w + s * _p.dilation_w) - static_cast<int64_t>(_p.pad_w);
+                            bool inside = (h >= 0 && h < static_cast<int64_t>(sh.H) && v >= 0 && v < static_cast<int64_t>(sh.W));
+                            row[p * sh.Q + q] = (inside ? in[(c * sh.H + size_t(h)) * sh.W + size_t(v)] : AccumT(0));
+                        }
+                    }
+                }
+            }
+        }
+        sw::numeric::containers::gemm_kernel(K, pq, crs, _w.data(), ws.col.data(), ws.acc.data(), workers);
+        for (size_t k = 0; k < K; ++k) {
+            for (size_t i = 0; i < pq; ++i) y[k * pq + i] = conv2d_convert<OutputT>(ws.acc[k * pq + i] + _bias[k]);
+        }
+    }
+
+    // U = G g G^T for each filter g, with G = [1 0 0; 1/2 1/2 1/2; 1/2 -1/2 1/2; 0 0 1]
+    void transform_filters() {
+        const size_t C = _p.in_channels, K = _p.out_channels;
+        _u.assign(16 * K * C, AccumT(0));
+        const AccumT half(0.5);
+        for (size_t k = 0; k < K; ++k) {
+            for (size_t c = 0; c < C; ++c) {
+                const AccumT* g = _w.data() + (k * C + c) * 9;
+                AccumT t[4][3];  // G g
+                for (size_t j = 0; j < 3; ++j) {
+                    t[0][j] = g[j];
+                    t[1][j] = half * (g[j] + g[3 + j] + g[6 + j]);
+                    t[2][j] = half * (g[j] - g[3 + j] + g[6 + j]);
+                    t[3][j] = g[6 + j];
+                }
+                for (size_t i = 0; i < 4; ++i) {  // (G g) G^T
+                    AccumT u[4] = { t[i][0], half * (t[i][0] + t[i][1] + t[i][2]), half * (t[i][0] - t[i][1] + t[i][2]), t[i][2] };
+                    for (size_t j = 0; j < 4; ++j) _u[((i * 4 + j) * K + k) * C + c] = u[j];
+                }
+            }
+        }
+        _transformed = true;
+    }
+
+    // F(2x2,3x3): V = B^T d B for each 4x4 input tile d, M = U V as 16 gemms over the channels, Y = A^T M A
+    void winograd(const shape& sh, OutputT* y, workspace& ws, sw::universal::thread_pool* workers) const {
+        const size_t C = _p.in_channels, K = _p.out_channels, pq = sh.P * sh.Q;
+        const size_t tilesH = (sh.P + 1) / 2, tilesW = (sh.Q + 1) / 2, T = tilesH * tilesW;
+        if (ws.V.size() < 16 * C * T) ws.V.resize(16 * C * T);
+        if (ws.M.size() < 16 * K * T) ws.M.resize(16 * K * T);
+        const AccumT* in = ws.in.data();
+        for (size_t c = 0; c < C; ++c) {
+            for (size_t th = 0; th < tilesH; ++th) {
+                for (size_t tw = 0; tw < tilesW; ++tw) {
+                    AccumT d[4][4];
+                    for (size_t i = 0; i < 4; ++i) {
+                        const int64_t h = static_cast<int64_t>(2 * th + i) - static_cast<int64_t>(_p.pad_h);
+                        for (size_t j = 0; j < 4; ++j) {
+                            const int64_t v = static_cast<int64_t>(2 * tw + j) - static_cast<int64_t>(_p.pad_w);
+                            bool inside = (h >= 0 && h < static_cast<int64_t>(sh.H) && v >= 0 && v < static_cast<int64_t>(sh.W));
+                            d[i][j] = (inside ? in[(c * sh.H + size_t(h)) * sh.W + size_t(v)] : AccumT(0));
+                        }
+                    }
+                    AccumT b[4][4];  // B^T d, with B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1]
+                    for (size_t j = 0; j < 4; ++j) {
+                        b[0][j] = d[0][j] - d[2][j];
+                        b[1][j] = d[1][j] + d[2][j];
+                        b[2][j] = d[2][j] - d[1][j];
+                        b[3][j] = d[1][j] - d[3][j];
+                    }
+                    const size_t t = th * tilesW + tw;
+                    for (size_t i = 0; i < 4; ++i) {  // (B^T d) B
+                        AccumT v[4] = { b[i][0] - b[i][2], b[i][1] + b[i][2], b[i][2] - b[i][1], b[i][1] - b[i][3] };
+                        for (size_t j = 0; j < 4; ++j) ws.V[((i * 4 + j) * C + c) * T + t] = v[j];
+                    }
+                }
+            }
+        }
+        split(workers, 16, [&](size_t xi) {
+            sw::numeric::containers::gemm_kernel(K, T, C, _u.data() + xi * K * C, ws.V.data() + xi * C * T, ws.M.data() + xi * K * T, static_cast<sw::universal::thread_pool*>(nullptr));
+        });
+        for (size_t k = 0; k < K; ++k) {
+            for (size_t th = 0; th < tilesH; ++th) {
+                for (size_t tw = 0; tw < tilesW; ++tw) {
+                    const size_t t = th * tilesW + tw;
+                    AccumT m[4][4];
+                    for (size_t i = 0; i < 4; ++i) {
+                        for (size_t j = 0; j < 4; ++j) m[i][j] = ws.M[((i * 4 + j) * K + k) * T + t];
+                    }
+                    AccumT a[2][4];  // A^T m, with A^T = [1 1 1 0; 0 1 -1 -1]
+                    for (size_t j = 0; j < 4; ++j) {
+                        a[0][j] = m[0][j] + m[1][j] + m[2][j];
+                        a[1][j] = m[1][j] - m[2][j] - m[3][j];
+                    }
+                    for (size_t i = 0; i < 2; ++i) {  // (A^T m) A
+                        const size_t p = 2 * th + i;
+                        if (p >= sh.P) continue;
+                        AccumT o[2] = { a[i][0] + a[i][1] + a[i][2], a[i][1] - a[i][2] - a[i][3] };
+                        for (size_t j = 0; j < 2; ++j) {
+                            const size_t q = 2 * tw + j;
+                            if (q < sh.Q) y[k * pq + p * sh.Q + q] = conv2d_convert<OutputT>(o[j] + _bias[k]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+}} // namespace sw::dnn
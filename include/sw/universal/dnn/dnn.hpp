@@ -15,5 +15,6 @@
 
 #include <universal/dnn/layer.hpp>
 #include <universal/dnn/dnn_impl.hpp>
+#include <universal/dnn/conv2d.hpp>
 
 #endif // _UNIVERSAL_DNN_LIBRARY
\ No newline at end of file
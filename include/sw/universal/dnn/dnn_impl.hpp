@@ -5,7 +5,14 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include <numeric/containers/vector.hpp>
+#include <universal/utility/thread_pool.hpp>
 
 namespace sw {
     namespace dnn {
@@ -19,8 +26,65 @@ namespace sw {
             template<typename LayerType>
             void addLayer(LayerType& layer) noexcept {
                 layers.push_back(&layer);
+                built = false;
             }
 
+            // connect the layers and size the activation buffers for batches of up to maxBatch samples,
+            // inputSize 0 takes the input size of the first layer
+            void build(size_t inputSize = 0, size_t maxBatch = 1) {
+                if (layers.empty()) throw std::runtime_error("dnn: network has no layers");
+                size_t size = (inputSize == 0 ? layers.front()->inputSize() : inputSize);
+                if (size == 0) throw std::runtime_error("dnn: input size of the network is unknown");
+                nrInputs = size;
+                size_t widest = 0;
+                for (AbstractLayer* layer : layers) {
+                    size = layer->build(size);
+                    widest = std::max(widest, size);
+                }
+                nrOutputs = size;
+                widestLayer = widest;
+                reserve(maxBatch);
+                built = true;
+            }
+
+            // random weights, reproducible for a given seed
+            void initialize(unsigned seed = 0) {
+                if (!built) build();
+                std::mt19937 generator(seed);
+                for (AbstractLayer* layer : layers) layer->initialize(generator);
+            }
+
+            // threads of the batch dimension, 0 selects the process-wide pool and 1 the calling thread
+            void setThreads(unsigned maxThreads) {
+                threads = maxThreads;
+                localPool.reset();
+            }
+
+            // batch samples of inputSize() values each, stored one after the other; returns batch x outputSize() values
+            // in a buffer owned by the network, valid until the next forward pass
+            const std::vector<double>& forward(const std::vector<double>& input, size_t batch = 1) {
+                if (!built) build();
+                if (input.size() != batch * nrInputs) {
+                    throw std::runtime_error("dnn: expected " + std::to_string(batch * nrInputs) + " input values, got " + std::to_string(input.size()));
+                }
+                reserve(batch);
+                sw::universal::thread_pool* pool = threadPool();
+                const double* in = input.data();
+                std::vector<double>* out = &ping;
+                for (AbstractLayer* layer : layers) {
+                    layer->forward(batch, in, out->data(), pool);
+                    in = out->data();
+                    out = (out == &ping ? &pong : &ping);
+                }
+                std::vector<double>& result = (out == &ping ? pong : ping);
+                output.assign(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(batch * nrOutputs));
+                return output;
+            }
+
+            size_t inputSize() const noexcept { return nrInputs; }
+            size_t outputSize() const noexcept { return nrOutputs; }
+            size_t nrLayers() const noexcept { return layers.size(); }
+
         protected:
 
 
@@ -29,6 +93,26 @@ namespace sw {
             LearningRateType learningRate;
             std::vector<AbstractLayer*> layers;
 
+            bool built{ false };
+            size_t nrInputs{ 0 }, nrOutputs{ 0 }, widestLayer{ 0 };
+            std::vector<double> ping, pong, output;  // activation buffers, reused across batches
+            unsigned threads{ 1 };
+            std::unique_ptr<sw::universal::thread_pool> localPool;
+
+            void reserve(size_t batch) {
+                if (ping.size() < batch * widestLayer) {
+                    ping.resize(batch * widestLayer);
+                    pong.resize(batch * widestLayer);
+                }
+            }
+
+            sw::universal::thread_pool* threadPool() {
+                if (threads == 0) return &sw::universal::default_thread_pool();
+                if (threads == 1) return nullptr;
+                if (!localPool) localPool = std::make_unique<sw::universal::thread_pool>(threads);
+                return localPool.get();
+            }
+
             template<typename LR>
             friend std::ostream& operator<<(std::ostream& ostr, const dnn<LR>& network);
             template<typename LR>
@@ -39,6 +123,11 @@ namespace sw {
         std::ostream& operator<<(std::ostream& ostr, const dnn< LearningRateType>& network) {
             ostr << "Deep Neural Network : " << network.name << '\n';
             ostr << "Learning Rate       : " << network.learningRate << '\n';
+            ostr << "Layers              : " << network.layers.size() << '\n';
+            if (network.built) {
+                ostr << "Inputs              : " << network.nrInputs << '\n';
+                ostr << "Outputs             : " << network.nrOutputs << '\n';
+            }
             return ostr;
         }
 
@@ -5,57 +5,222 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include <numeric/containers.hpp>
+#include <universal/utility/thread_pool.hpp>
+#include <universal/dnn/conv2d.hpp>
 
 namespace sw { namespace dnn {
 
 enum class Activation {
-    ReLU, Sigmoid, Tanh
+    ReLU, Sigmoid, Tanh, Identity
 };
 
 enum class LayerOperation {
     FullyConnected, Sparse, MaxPooling, AvgPooling, Convolutional
 };
 
+inline double activate(Activation activation, double x) {
+    switch (activation) {
+    case Activation::ReLU:    return (x > 0.0 ? x : 0.0);
+    case Activation::Sigmoid: return 1.0 / (1.0 + std::exp(-x));
+    case Activation::Tanh:    return std::tanh(x);
+    default:                  return x;
+    }
+}
+
+// The layers exchange activations as double: every value of a small number system is exact in double,
+// so a layer sees the same ActivationScalarType values the previous layer produced.
 class AbstractLayer {
 public:
     AbstractLayer() {};
     virtual ~AbstractLayer() = 0;
+
+    // connect the layer to inputs of inputSize values per sample, returns the number of outputs per sample
+    virtual size_t build(size_t inputSize) = 0;
+    virtual size_t inputSize() const noexcept = 0;
+    virtual size_t outputSize() const noexcept = 0;
+    // uniform weights scaled by the fan-in and fan-out, zero biases
+    virtual void initialize(std::mt19937& generator) = 0;
+    // batch samples, one per row of input and output; the batch is split over the pool when there is one
+    virtual void forward(size_t batch, const double* input, double* output, sw::universal::thread_pool* pool) = 0;
 };
 
-AbstractLayer::~AbstractLayer() {}
+inline AbstractLayer::~AbstractLayer() {}
+
+// split a batch into contiguous chunks of samples, one per thread of the pool
+inline size_t batch_chunks(size_t batch, sw::universal::thread_pool* pool) {
+    return (pool == nullptr ? size_t(1) : std::max(size_t(1), std::min(batch, size_t(pool->size()))));
+}
+
+inline void for_each_chunk(sw::universal::thread_pool* pool, size_t nrChunks, const std::function<void(size_t)>& body) {
+    if (pool == nullptr || nrChunks == 1) {
+        for (size_t c = 0; c < nrChunks; ++c) body(c);
+    }
+    else {
+        pool->parallel_for(nrChunks, body);
+    }
+}
+
+// number systems narrow enough to enumerate
+template<typename T>
+concept enumerable_number = requires(T t) { T::nbits; t.setbits(uint64_t(0)); } && (T::nbits <= 12);
+
+// Rounding a double to a narrow number system through a table: the finite values of T are enumerated once,
+// and the first double of the rounding interval of each value is found by bisection on the conversion of T,
+// so the table reproduces the rounding of T exactly. Values outside the finite range use the conversion of T.
+template<typename T>
+class value_rounding {
+public:
+    static double round(double x) {
+        if constexpr (enumerable_number<T>) {
+            static const value_rounding table;
+            return table(x);
+        }
+        else {
+            return double(T(x));
+        }
+    }
+
+private:
+    std::vector<double> values, thresholds;  // thresholds[i] is the smallest double that rounds to values[i]
+
+    value_rounding() {
+        T t{};
+        for (uint64_t bits = 0; bits < (uint64_t(1) << T::nbits); ++bits) {
+            t.setbits(bits);
+            double v = double(t);
+            if (std::isfinite(v)) values.push_back(v);
+        }
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+        thresholds.resize(values.size());
+        if (values.empty()) return;
+        thresholds[0] = values[0];
+        for (size_t i = 1; i < values.size(); ++i) {
+            double lo = values[i - 1], hi = values[i];
+            for (;;) {
+                double mid = lo + (hi - lo) / 2.0;
+                if (mid <= lo || mid >= hi) break;
+                if (double(T(mid)) < values[i]) lo = mid; else hi = mid;
+            }
+            thresholds[i] = hi;
+        }
+    }
 
+    double operator()(double x) const {
+        if (!(x >= values.front() && x <= values.back())) return double(T(x));
+        size_t i = static_cast<size_t>(std::upper_bound(thresholds.begin(), thresholds.end(), x) - thresholds.begin());
+        return values[i - 1];
+    }
+};
 
+// round a value to the number system T and widen it to the accumulator
+template<typename T, typename AccumulatorScalarType>
+inline AccumulatorScalarType round_to(double value) {
+    return AccumulatorScalarType(value_rounding<T>::round(value));
+}
 
 //////////////////////////////////////////////////////////////////////////////
 ///           FULLY CONNECTED LAYER
 
-template<typename WeightScalarType, typename ActivationScalarType>
+// output = activation(weight * input + bias), the products are accumulated in AccumulatorScalarType
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulatorScalarType = float>
 class FullyConnectedLayer : public AbstractLayer {
 public:
     FullyConnectedLayer() noexcept = default;
-    FullyConnectedLayer(unsigned nrNodes, unsigned nrChannels, Activation activation) : nrChannels{ nrChannels }, weight(nrNodes), bias(nrNodes), activation{ activation } {}
+    FullyConnectedLayer(unsigned nrNodes, unsigned nrChannels, Activation activation) : nrNodes{ nrNodes }, nrChannels{ nrChannels }, weight(nrNodes), bias(nrNodes), activation{ activation } {}
+
+    size_t build(size_t inputSize) override {
+        if (inputSize != nrInputs) {
+            nrInputs = inputSize;
+            weight.resize(nrNodes * nrInputs);
+            packed = false;
+        }
+        return nrNodes;
+    }
+    size_t inputSize() const noexcept override { return nrInputs; }
+    size_t outputSize() const noexcept override { return nrNodes; }
+
+    void initialize(std::mt19937& generator) override {
+        double limit = std::sqrt(6.0 / double(nrInputs + nrNodes));
+        std::uniform_real_distribution<double> distribution(-limit, limit);
+        for (size_t i = 0; i < weight.size(); ++i) weight[i] = WeightScalarType(distribution(generator));
+        for (size_t i = 0; i < bias.size(); ++i) bias[i] = WeightScalarType(0);
+        packed = false;
+    }
 
-protected:
+    // weight of input i into node j, rounded to the weight type
+    void setWeight(size_t j, size_t i, double value) { weight[j * nrInputs + i] = WeightScalarType(value); packed = false; }
+    void setBias(size_t j, double value) { bias[j] = WeightScalarType(value); packed = false; }
+    const sw::numeric::containers::vector<WeightScalarType>& weights() const noexcept { return weight; }
+    const sw::numeric::containers::vector<WeightScalarType>& biases() const noexcept { return bias; }
+
+    void forward(size_t batch, const double* input, double* output, sw::universal::thread_pool* pool) override {
+        pack();
+        const size_t k = nrInputs, n = nrNodes;
+        if (in.size() < batch * k) in.resize(batch * k);
+        if (acc.size() < batch * n) acc.resize(batch * n);
+        const size_t nrChunks = batch_chunks(batch, pool);
+        for_each_chunk(pool, nrChunks, [&](size_t c) {
+            const size_t b0 = batch * c / nrChunks, b1 = batch * (c + 1) / nrChunks;
+            if (b0 == b1) return;
+            for (size_t i = b0 * k; i < b1 * k; ++i) in[i] = round_to<ActivationScalarType, AccumulatorScalarType>(input[i]);
+            sw::numeric::containers::gemm_kernel(b1 - b0, n, k, in.data() + b0 * k, packedWeight.data(), acc.data() + b0 * n, static_cast<sw::universal::thread_pool*>(nullptr));
+            // fused bias and activation, rounded to the activation type
+            for (size_t b = b0; b < b1; ++b) {
+                for (size_t j = 0; j < n; ++j) {
+                    AccumulatorScalarType v = acc[b * n + j] + packedBias[j];
+                    output[b * n + j] = value_rounding<ActivationScalarType>::round(activate(activation, double(v)));
+                }
+            }
+        });
+    }
 
 private:
-    unsigned nrChannels;
-    sw::numeric::containers::vector<WeightScalarType> weight;
+    unsigned nrNodes{ 0 };
+    unsigned nrChannels{ 0 };
+    size_t nrInputs{ 0 };
+    sw::numeric::containers::vector<WeightScalarType> weight;   // nrNodes x nrInputs
     sw::numeric::containers::vector<WeightScalarType> bias;
-    Activation activation;
+    Activation activation{ Activation::ReLU };
+
+    // the weights widened to the accumulator and transposed for the gemm kernel, and the batch buffers
+    bool packed{ false };
+    std::vector<AccumulatorScalarType> packedWeight, packedBias, in, acc;
+
+    void pack() {
+        if (packed) return;
+        packedWeight.resize(nrInputs * nrNodes);
+        for (size_t j = 0; j < nrNodes; ++j) {
+            for (size_t i = 0; i < nrInputs; ++i) packedWeight[i * nrNodes + j] = AccumulatorScalarType(double(weight[j * nrInputs + i]));
+        }
+        packedBias.resize(nrNodes);
+        for (size_t j = 0; j < nrNodes; ++j) packedBias[j] = AccumulatorScalarType(double(bias[j]));
+        packed = true;
+    }
 
-    template<typename WWeightScalarType, typename AActivationScalarType>
-    friend std::ostream& operator<<(std::ostream& ostr, FullyConnectedLayer<WWeightScalarType, AActivationScalarType>& fcLayer);
+    template<typename WWeightScalarType, typename AActivationScalarType, typename AAccumulatorScalarType>
+    friend std::ostream& operator<<(std::ostream& ostr, FullyConnectedLayer<WWeightScalarType, AActivationScalarType, AAccumulatorScalarType>& fcLayer);
 };
 
-template<typename WeightScalarType, typename ActivationScalarType>
-FullyConnectedLayer<WeightScalarType, ActivationScalarType> CreateFullyConnectedLayer(unsigned nrNodes, Activation activation) {
-    return FullyConnectedLayer<WeightScalarType, ActivationScalarType>(nrNodes, 1, activation);
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulatorScalarType = float>
+FullyConnectedLayer<WeightScalarType, ActivationScalarType, AccumulatorScalarType> CreateFullyConnectedLayer(unsigned nrNodes, Activation activation) {
+    return FullyConnectedLayer<WeightScalarType, ActivationScalarType, AccumulatorScalarType>(nrNodes, 1, activation);
 }
 
-template<typename WeightScalarType, typename ActivationScalarType>
-std::ostream& operator<<(std::ostream& ostr, FullyConnectedLayer<WeightScalarType, ActivationScalarType>& fcLayer) {
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulatorScalarType>
+std::ostream& operator<<(std::ostream& ostr, FullyConnectedLayer<WeightScalarType, ActivationScalarType, AccumulatorScalarType>& fcLayer) {
     ostr << "Fully Connected Layer\n";
+    ostr << "inputs  : " << fcLayer.nrInputs << '\n';
+    ostr << "nodes   : " << fcLayer.nrNodes << '\n';
     ostr << "weights :\n" << fcLayer.weight << '\n';
     ostr << "biases  :\n" << fcLayer.bias << '\n';
     return ostr;
@@ -64,36 +229,110 @@ std::ostream& operator<<(std::ostream& ostr, FullyConnectedLayer<WeightScalarTyp
 //////////////////////////////////////////////////////////////////////////////
 ///           CONVOLUTIONAL LAYER
 
-template<typename WeightScalarType, typename ActivationScalarType>
+// K filters of C x R x S over a C x H x W input, NCHW layout, evaluated by conv2d on the whole batch:
+// the inputs are rounded to ActivationScalarType and widened to AccumulatorScalarType, and the
+// bias and activation are applied to the conv2d result before rounding to ActivationScalarType
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulatorScalarType = float>
 class ConvolutionalLayer : public AbstractLayer {
 public:
-    ConvolutionalLayer() noexcept = default;
-    ConvolutionalLayer(unsigned N, unsigned C, unsigned H, unsigned W, Activation activation) : N{N}, C{C}, H{H}, W{W}, weight(C*H*W), bias(C*H*W), activation{activation} {}
+    using convolution = conv2d<AccumulatorScalarType, WeightScalarType, AccumulatorScalarType, AccumulatorScalarType>;
 
-protected:
+    ConvolutionalLayer() = default;
+    ConvolutionalLayer(unsigned N, unsigned C, unsigned H, unsigned W, Activation activation, unsigned K = 1, unsigned R = 3, unsigned S = 3, unsigned stride = 1, unsigned padding = 1, unsigned dilation = 1)
+        : N{ N }, C{ C }, H{ H }, W{ W }, K{ K }, R{ R }, S{ S }, stride{ stride == 0 ? 1 : stride }, padding{ padding }, dilation{ dilation == 0 ? 1 : dilation },
+          weight(size_t(K) * C * R * S), bias(K), activation{ activation },
+          conv{ conv2d_parameters{ C, K, R, S, this->stride, this->stride, padding, padding, this->dilation, this->dilation } } {
+        if (H + 2 * padding < this->dilation * (R - 1) + 1 || W + 2 * padding < this->dilation * (S - 1) + 1) throw std::runtime_error("ConvolutionalLayer: filter is larger than the padded input");
+        P = static_cast<unsigned>(conv.output_height(H));
+        Q = static_cast<unsigned>(conv.output_width(W));
+    }
+
+    size_t build(size_t inputSize) override {
+        if (inputSize != this->inputSize()) {
+            throw std::runtime_error("ConvolutionalLayer: expects " + std::to_string(this->inputSize()) + " inputs per sample, previous layer produces " + std::to_string(inputSize));
+        }
+        return outputSize();
+    }
+    size_t inputSize() const noexcept override { return size_t(C) * H * W; }
+    size_t outputSize() const noexcept override { return size_t(K) * P * Q; }
+    unsigned outputHeight() const noexcept { return P; }
+    unsigned outputWidth() const noexcept { return Q; }
+
+    void initialize(std::mt19937& generator) override {
+        double fanIn = double(C) * R * S, fanOut = double(K) * R * S;
+        double limit = std::sqrt(6.0 / (fanIn + fanOut));
+        std::uniform_real_distribution<double> distribution(-limit, limit);
+        for (size_t i = 0; i < weight.size(); ++i) weight[i] = WeightScalarType(distribution(generator));
+        for (size_t i = 0; i < bias.size(); ++i) bias[i] = WeightScalarType(0);
+        packed = false;
+    }
+
+    // weight of filter k at channel c, row r, column s
+    void setWeight(size_t k, size_t c, size_t r, size_t s, double value) { weight[((k * C + c) * R + r) * S + s] = WeightScalarType(value); packed = false; }
+    void setBias(size_t k, double value) { bias[k] = WeightScalarType(value); packed = false; }
+    const sw::numeric::containers::vector<WeightScalarType>& weights() const noexcept { return weight; }
+    const sw::numeric::containers::vector<WeightScalarType>& biases() const noexcept { return bias; }
+    // the convolution the layer evaluates, to inspect its schedule
+    const convolution& convolution_operator() const noexcept { return conv; }
+
+    void forward(size_t batch, const double* input, double* output, sw::universal::thread_pool* pool) override {
+        pack();
+        const size_t chw = inputSize(), kpq = outputSize();
+        const size_t nrChunks = batch_chunks(batch, pool);
+        in.resize(batch * chw);
+        for_each_chunk(pool, nrChunks, [&](size_t c) {
+            const size_t b0 = batch * c / nrChunks, b1 = batch * (c + 1) / nrChunks;
+            for (size_t i = b0 * chw; i < b1 * chw; ++i) in[i] = round_to<ActivationScalarType, AccumulatorScalarType>(input[i]);
+        });
+        conv.forward(in, batch, H, W, acc, conv2d_algorithm::Automatic, pool);
+        // activation of the biased sums, rounded to the activation type
+        for_each_chunk(pool, nrChunks, [&](size_t c) {
+            const size_t b0 = batch * c / nrChunks, b1 = batch * (c + 1) / nrChunks;
+            for (size_t i = b0 * kpq; i < b1 * kpq; ++i) output[i] = value_rounding<ActivationScalarType>::round(activate(activation, double(acc[i])));
+        });
+    }
 
 private:
-    unsigned N, C, H, W;
-    sw::numeric::containers::vector<WeightScalarType> weight;
+    unsigned N{ 0 }, C{ 0 }, H{ 0 }, W{ 0 };      // N is the nominal batch size
+    unsigned K{ 0 }, R{ 0 }, S{ 0 }, stride{ 1 }, padding{ 0 }, dilation{ 1 };
+    unsigned P{ 0 }, Q{ 0 };                      // output height and width
+    sw::numeric::containers::vector<WeightScalarType> weight;   // K x C x R x S
     sw::numeric::containers::vector<WeightScalarType> bias;
-    Activation activation;
+    Activation activation{ Activation::ReLU };
+
+    // the convolution holds the weights widened to the accumulator, and the batch buffers
+    convolution conv{ conv2d_parameters{} };
+    bool packed{ false };
+    std::vector<AccumulatorScalarType> in, acc;
+
+    void pack() {
+        if (packed) return;
+        conv.set_weights(std::vector<WeightScalarType>(weight.begin(), weight.end()));
+        std::vector<AccumulatorScalarType> widened(bias.size());
+        for (size_t i = 0; i < bias.size(); ++i) widened[i] = AccumulatorScalarType(double(bias[i]));
+        conv.set_bias(widened);
+        packed = true;
+    }
 
-    template<typename W, typename A>
-    friend std::ostream& operator<<(std::ostream& ostr, ConvolutionalLayer<W, A>& fcLayer);
+    template<typename WW, typename AA, typename CC>
+    friend std::ostream& operator<<(std::ostream& ostr, ConvolutionalLayer<WW, AA, CC>& convLayer);
 };
 
-template<typename WeightScalarType, typename ActivationScalarType>
-ConvolutionalLayer<WeightScalarType, ActivationScalarType> CreateConvolutionLayer(unsigned N, unsigned C, unsigned H, unsigned W, Activation activation) {
-    return ConvolutionalLayer<WeightScalarType, ActivationScalarType>(N, C, H, W, activation);
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulatorScalarType = float>
+ConvolutionalLayer<WeightScalarType, ActivationScalarType, AccumulatorScalarType> CreateConvolutionLayer(unsigned N, unsigned C, unsigned H, unsigned W, Activation activation,
+    unsigned K = 1, unsigned R = 3, unsigned S = 3, unsigned stride = 1, unsigned padding = 1, unsigned dilation = 1) {
+    return ConvolutionalLayer<WeightScalarType, ActivationScalarType, AccumulatorScalarType>(N, C, H, W, activation, K, R, S, stride, padding, dilation);
 }
 
-template<typename WeightScalarType, typename ActivationScalarType>
-std::ostream& operator<<(std::ostream& ostr, ConvolutionalLayer<WeightScalarType, ActivationScalarType>& convLayer) {
+template<typename WeightScalarType, typename ActivationScalarType, typename AccumulatorScalarType>
+std::ostream& operator<<(std::ostream& ostr, ConvolutionalLayer<WeightScalarType, ActivationScalarType, AccumulatorScalarType>& convLayer) {
     ostr << "Convolutional Layer\n";
     ostr << "batch size  : " << convLayer.N << '\n';
     ostr << "channels    : " << convLayer.C << '\n';
     ostr << "height      : " << convLayer.H << '\n';
     ostr << "width       : " << convLayer.W << '\n';
+    ostr << "filters     : " << convLayer.K << " x " << convLayer.R << " x " << convLayer.S << ", stride " << convLayer.stride << ", padding " << convLayer.padding << ", dilation " << convLayer.dilation << '\n';
+    ostr << "output      : " << convLayer.K << " x " << convLayer.P << " x " << convLayer.Q << '\n';
     ostr << "weights     : " << convLayer.weight.size() << '\n';
     ostr << "biases      : " << convLayer.bias.size() << '\n';
     return ostr;
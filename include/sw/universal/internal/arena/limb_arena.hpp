@@ -0,0 +1,127 @@
+#pragma once
+// limb_arena.hpp : thread-local pool of limb storage for the adaptive precision number systems
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace sw { namespace universal { namespace internal {
+
+/// <summary>
+/// limb_arena recycles the limb buffers of the adaptive precision types
+/// </summary>
+/// The temporaries of an expression chain like a * b + c * d allocate and release limb buffers of
+/// similar size in quick succession. The arena keeps released buffers on a free list per power-of-two
+/// size class, so the next temporary of that class reuses one instead of going to the heap.
+/// Each thread owns its own arena, so there is no locking: a buffer released on another thread than
+/// the one that allocated it simply migrates to the free list of the releasing thread.
+class limb_arena {
+public:
+	static constexpr unsigned nrSizeClasses  = 40;
+	static constexpr size_t   minBlockSize   = 16;   // bytes in size class 0
+	static constexpr size_t   maxCachedBlocks = 64;  // per size class
+
+	limb_arena() = default;
+	limb_arena(const limb_arena&) = delete;
+	limb_arena& operator=(const limb_arena&) = delete;
+	~limb_arena() {
+		for (auto& freeList : _free) {
+			for (void* p : freeList) ::operator delete(p);
+			freeList.clear();
+		}
+		destroyed() = true;
+	}
+
+	void* allocate(size_t bytes) {
+		unsigned sc = size_class(bytes);
+		auto& freeList = _free[sc];
+		if (!freeList.empty()) {
+			void* p = freeList.back();
+			freeList.pop_back();
+			return p;
+		}
+		return ::operator new(minBlockSize << sc);
+	}
+	void release(void* p, size_t bytes) noexcept {
+		unsigned sc = size_class(bytes);
+		auto& freeList = _free[sc];
+		if (freeList.size() < maxCachedBlocks) {
+			try {
+				freeList.push_back(p);
+				return;
+			}
+			catch (...) {
+				// fall through and return the block to the heap
+			}
+		}
+		::operator delete(p);
+	}
+
+	// the arena of the calling thread, or nullptr once the thread is tearing down its thread_local state
+	static limb_arena* local() noexcept {
+		if (destroyed()) return nullptr;
+		thread_local limb_arena arena;
+		return (destroyed() ? nullptr : &arena);
+	}
+
+	static unsigned size_class(size_t bytes) noexcept {
+		unsigned sc = 0;
+		while ((minBlockSize << sc) < bytes) ++sc;
+		return sc;
+	}
+
+private:
+	std::vector<void*> _free[nrSizeClasses];
+
+	// trivially destructible, so it stays valid while the other thread_local objects are destroyed
+	static bool& destroyed() noexcept {
+		thread_local bool flag = false;
+		return flag;
+	}
+};
+
+/// <summary>
+/// standard allocator interface on top of the thread-local limb_arena
+/// </summary>
+template<typename T>
+class arena_allocator {
+public:
+	using value_type = T;
+
+	arena_allocator() noexcept = default;
+	template<typename U>
+	arena_allocator(const arena_allocator<U>&) noexcept {}
+
+	T* allocate(size_t n) {
+		size_t bytes = n * sizeof(T);
+		if (bytes > (limb_arena::minBlockSize << (limb_arena::nrSizeClasses - 1))) throw std::bad_alloc();
+		limb_arena* arena = limb_arena::local();
+		void* p = (arena ? arena->allocate(bytes) : ::operator new(limb_arena::minBlockSize << limb_arena::size_class(bytes)));
+		return static_cast<T*>(p);
+	}
+	void deallocate(T* p, size_t n) noexcept {
+		limb_arena* arena = limb_arena::local();
+		if (arena) {
+			arena->release(p, n * sizeof(T));
+		}
+		else {
+			::operator delete(p);
+		}
+	}
+
+	template<typename U>
+	bool operator==(const arena_allocator<U>&) const noexcept { return true; }
+	template<typename U>
+	bool operator!=(const arena_allocator<U>&) const noexcept { return false; }
+};
+
+// limb vector drawing its storage from the arena
+template<typename Limb>
+using arena_vector = std::vector<Limb, arena_allocator<Limb>>;
+
+}}} // namespace sw::universal::internal
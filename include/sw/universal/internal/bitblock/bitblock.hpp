@@ -645,6 +645,39 @@ bitblock<nbits> convert_to_bitblock(Type number) {
 	return _Bits;
 }
 
+// copy a bitblock into (nbits + 63)/64 little-endian 64-bit limbs
+template<unsigned nbits>
+void to_limbs(const bitblock<nbits>& bits, uint64_t* limbs) {
+	constexpr unsigned nrLimbs = (nbits + 63) / 64;
+	if constexpr (nbits <= 64) {
+		if constexpr (nrLimbs > 0) limbs[0] = bits.to_ullong();
+	}
+	else {
+		const std::bitset<nbits> mask(~0ull);
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			limbs[i] = ((static_cast<const std::bitset<nbits>&>(bits) >> (64 * i)) & mask).to_ullong();
+		}
+	}
+}
+
+// assemble a bitblock from (nbits + 63)/64 little-endian 64-bit limbs, bits beyond nbits are dropped
+template<unsigned nbits>
+bitblock<nbits> from_limbs(const uint64_t* limbs) {
+	constexpr unsigned nrLimbs = (nbits + 63) / 64;
+	bitblock<nbits> bits;
+	if constexpr (nbits <= 64) {
+		if constexpr (nrLimbs > 0) bits = limbs[0];
+	}
+	else {
+		std::bitset<nbits>& b = bits;
+		for (int i = int(nrLimbs) - 1; i >= 0; --i) {
+			b <<= 64;
+			b |= std::bitset<nbits>(limbs[i]);
+		}
+	}
+	return bits;
+}
+
 template<unsigned nbits>
 std::string to_bit_string(bitblock<nbits> bits, bool separator = true) {
 	std::stringstream ss;
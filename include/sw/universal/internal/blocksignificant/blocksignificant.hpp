@@ -11,6 +11,8 @@
 #include <string>
 #include <sstream>
 
+#include <universal/internal/uint128/uint128.hpp>
+#include <universal/utility/find_msb.hpp>
 #include <universal/internal/blocksignificant/blocksignificant_fwd.hpp>
 
 /*
@@ -108,6 +110,7 @@ public:
 	static constexpr uint64_t fmask = (64 - nbits + 3) > 63 ? 0ull : (0xFFFF'FFFF'FFFF'FFFFull >> maxRightShift);
 
 	static constexpr unsigned MSU = nrBlocks - 1; // MSU == Most Significant Unit
+	static constexpr unsigned nrLimbs = 1u + ((nbits - 1u) / 64u); // nr of 64-bit limbs used by the multiplier and divider
 	static constexpr bt ALL_ONES = bt(~0);
 	static constexpr bt MSU_MASK = (ALL_ONES >> (nrBlocks * bitsInBlock - nbits));
 	static constexpr bt OVERFLOW_BIT = ~(MSU_MASK >> 1) & MSU_MASK;
@@ -237,34 +240,88 @@ public:
 		blocksignificant<nbits, bt> b(twosComplementFree(rhs)); 
 		add(lhs, b);
 	}
+	/// <summary>
+	/// multiply two significants, yielding the product modulo 2^nbits.
+	/// The multiplier works on 64-bit limbs, independent of the block type,
+	/// using 64x64 -> 128 bit partial products and only forms the partial
+	/// products that contribute to the lower nbits of the result.
+	/// </summary>
+	/// <param name="lhs">significant in 1's complement form 0'00001.fffff</param>
+	/// <param name="rhs">significant in 1's complement form 0'00001.fffff</param>
 	void mul(const blocksignificant& lhs, const blocksignificant& rhs) noexcept {
-		blocksignificant<nbits, bt> base(lhs);
-		blocksignificant<nbits, bt> multiplicant(rhs);
+		uint64_t a[nrLimbs], b[nrLimbs], p[nrLimbs];
+		lhs.toLimbs(a);
+		rhs.toLimbs(b);
 		clear();
-		for (unsigned i = 0; i < nbits; ++i) {
-			if (base.at(i)) {
-				add(*this, multiplicant);
+		if constexpr (nrLimbs == 1) {
+			p[0] = a[0] * b[0]; // native multiply is modulo 2^64
+		}
+		else {
+			for (unsigned i = 0; i < nrLimbs; ++i) p[i] = 0;
+			for (unsigned i = 0; i < nrLimbs; ++i) {
+				if (a[i] == 0) continue;
+				uint64_t carry = 0;
+				for (unsigned j = 0; i + j < nrLimbs; ++j) {
+					internal::uint128 t = internal::umac128(a[i], b[j], p[i + j], carry);
+					p[i + j] = t.lower;
+					carry = t.upper;
+				}
 			}
-			multiplicant <<= 1;
 		}
-		// since we used operator+=, which enforces the nulling of leading bits
-		// we don't need to null here
+		fromLimbs(p); // nulls the bits outside of nbits
 	}
+	/// <summary>
+	/// divide two significants, generating 2*fbits + 1 quotient bits, 
+	/// where fbits = radix/2, with the quotient msb at the radix of the lhs.
+	/// The divider is a word-level Knuth algorithm D on 32-bit digits,
+	/// and a single native divide when the scaled dividend fits in 64 bits.
+	/// Precondition: the operands are normalized, that is, lhs < 2*rhs
+	/// </summary>
+	/// <param name="lhs">dividend in the form 00000'00001'fffff</param>
+	/// <param name="rhs">divisor in the form 00000'00001'fffff</param>
 	void div(const blocksignificant& lhs, const blocksignificant& rhs) noexcept {
-		blocksignificant<nbits, bt> base(lhs);
-		blocksignificant<nbits, bt> divider(rhs);
-		clear();
 		unsigned outputRadix = static_cast<unsigned>(lhs.radix());
 		unsigned fbits = (outputRadix >> 1);
-		for (unsigned i = 0; i <= 2*fbits; ++i) {
-//			std::cout << "base    : " << to_binary(base) << " : " << base << '\n';
-//			std::cout << "divider : " << to_binary(divider) << " : " << divider << '\n';
-			if (divider <= base) {
-				base.sub(base, divider);
-				this->setbit(outputRadix - i);
+		unsigned shift = 2 * fbits;  // quotient = (lhs << shift) / rhs
+		if (shift > nbits) shift = nbits;
+		unsigned lsb = outputRadix - shift; // position of the lsb of the quotient in the output
+		uint64_t a[nrLimbs], b[nrLimbs], q[nrLimbs];
+		lhs.toLimbs(a);
+		rhs.toLimbs(b);
+		clear();
+		if (rhs.iszero()) return;
+		if constexpr (2 * nbits <= 64) {
+			q[0] = ((a[0] << shift) / b[0]) << lsb;
+		}
+		else {
+			constexpr unsigned nrDigits = 2 * nrLimbs;
+			uint32_t u[2 * nrDigits]{}, v[nrDigits]{}, quo[2 * nrDigits]{};
+			// scale the dividend: u = a << shift
+			unsigned digitShift = shift / 32;
+			unsigned bitShift = shift % 32;
+			for (unsigned i = 0; i < nrDigits; ++i) {
+				uint64_t digit = (a[i >> 1] >> (32 * (i & 1))) & 0xFFFF'FFFFull;
+				uint64_t scaled = digit << bitShift;
+				u[i + digitShift] |= static_cast<uint32_t>(scaled);
+				if (i + digitShift + 1 < 2 * nrDigits) u[i + digitShift + 1] |= static_cast<uint32_t>(scaled >> 32);
+				v[i] = static_cast<uint32_t>(b[i >> 1] >> (32 * (i & 1)));
+			}
+			int m = static_cast<int>(2 * nrDigits);
+			while (m > 1 && u[m - 1] == 0) --m;
+			int n = static_cast<int>(nrDigits);
+			while (n > 1 && v[n - 1] == 0) --n;
+			if (m >= n) divmnu(quo, u, m, v, n);
+			// gather the quotient digits into limbs and align the lsb
+			for (unsigned i = 0; i < nrLimbs; ++i) q[i] = 0;
+			for (unsigned i = 0; i < 2 * nrDigits; ++i) {
+				unsigned pos = 32 * i + lsb;
+				if (quo[i] == 0 || pos >= 64 * nrLimbs) continue;
+				uint64_t digit = static_cast<uint64_t>(quo[i]) << (pos % 64);
+				q[pos / 64] |= digit;
+				if ((pos % 64) > 32 && pos / 64 + 1 < nrLimbs) q[pos / 64 + 1] |= static_cast<uint64_t>(quo[i]) >> (64 - (pos % 64));
 			}
-			divider >>= 1;
 		}
+		fromLimbs(q);
 	}
 
 #ifdef FRACTION_REMAINDER
@@ -600,7 +657,86 @@ public:
 
 protected:
 	// HELPER methods
-	// none
+
+	// gather the blocks into 64-bit limbs: the word size of the multiplier and divider
+	constexpr void toLimbs(uint64_t* limbs) const noexcept {
+		if constexpr (bitsInBlock == 64) {
+			for (unsigned i = 0; i < nrBlocks; ++i) limbs[i] = _block[i];
+		}
+		else {
+			for (unsigned i = 0; i < nrLimbs; ++i) limbs[i] = 0;
+			for (unsigned i = 0; i < nrBlocks; ++i) {
+				limbs[(i * bitsInBlock) / 64] |= static_cast<uint64_t>(_block[i]) << ((i * bitsInBlock) % 64);
+			}
+		}
+	}
+	// scatter 64-bit limbs back into the blocks, nulling the bits outside of nbits
+	constexpr void fromLimbs(const uint64_t* limbs) noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			_block[i] = static_cast<bt>(limbs[(i * bitsInBlock) / 64] >> ((i * bitsInBlock) % 64));
+		}
+		_block[MSU] &= MSU_MASK;
+	}
+	// Knuth, TAOCP Vol 2, 4.3.1, algorithm D on 32-bit digits
+	// q[0..m-n] = u[0..m-1] / v[0..n-1], precondition: v[n-1] != 0, m >= n
+	static void divmnu(uint32_t* q, const uint32_t* u, int m, const uint32_t* v, int n) noexcept {
+		constexpr uint64_t base = (1ull << 32);
+		if (n == 1) {
+			uint64_t k = 0;
+			for (int j = m - 1; j >= 0; --j) {
+				uint64_t t = (k << 32) | u[j];
+				q[j] = static_cast<uint32_t>(t / v[0]);
+				k = t - q[j] * static_cast<uint64_t>(v[0]);
+			}
+			return;
+		}
+		// normalize so that the msb of the divisor is set
+		constexpr unsigned nrDigits = 2 * nrLimbs;
+		uint32_t un[2 * nrDigits + 1]{}, vn[nrDigits]{};
+		int s = 31 - static_cast<int>(find_msb(v[n - 1]) - 1);
+		for (int i = n - 1; i > 0; --i) {
+			vn[i] = static_cast<uint32_t>((static_cast<uint64_t>(v[i]) << s) | (static_cast<uint64_t>(v[i - 1]) >> (32 - s)));
+		}
+		vn[0] = v[0] << s;
+		un[m] = static_cast<uint32_t>(static_cast<uint64_t>(u[m - 1]) >> (32 - s));
+		for (int i = m - 1; i > 0; --i) {
+			un[i] = static_cast<uint32_t>((static_cast<uint64_t>(u[i]) << s) | (static_cast<uint64_t>(u[i - 1]) >> (32 - s)));
+		}
+		un[0] = u[0] << s;
+		for (int j = m - n; j >= 0; --j) {
+			// estimate the quotient digit from the top two digits of the remainder
+			uint64_t num = (static_cast<uint64_t>(un[j + n]) << 32) | un[j + n - 1];
+			uint64_t qhat = num / vn[n - 1];
+			uint64_t rhat = num - qhat * vn[n - 1];
+			while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+				--qhat;
+				rhat += vn[n - 1];
+				if (rhat >= base) break;
+			}
+			// multiply and subtract
+			int64_t borrow = 0;
+			int64_t t = 0;
+			for (int i = 0; i < n; ++i) {
+				uint64_t p = qhat * vn[i];
+				t = static_cast<int64_t>(un[i + j]) - borrow - static_cast<int64_t>(p & 0xFFFF'FFFFull);
+				un[i + j] = static_cast<uint32_t>(t);
+				borrow = static_cast<int64_t>(p >> 32) - (t >> 32);
+			}
+			t = static_cast<int64_t>(un[j + n]) - borrow;
+			un[j + n] = static_cast<uint32_t>(t);
+			q[j] = static_cast<uint32_t>(qhat);
+			if (t < 0) { // estimate was one too large: add back
+				--q[j];
+				uint64_t carry = 0;
+				for (int i = 0; i < n; ++i) {
+					uint64_t sum = static_cast<uint64_t>(un[i + j]) + vn[i] + carry;
+					un[i + j] = static_cast<uint32_t>(sum);
+					carry = sum >> 32;
+				}
+				un[j + n] = static_cast<uint32_t>(un[j + n] + carry);
+			}
+		}
+	}
 
 public:
 	int radixPoint;
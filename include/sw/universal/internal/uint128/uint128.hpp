@@ -17,4 +17,63 @@ public:
 	uint64_t lower;
 };
 
+#if defined(__SIZEOF_INT128__)
+// compiler-native 128-bit integer: __extension__ silences -Wpedantic on gcc/clang
+__extension__ typedef unsigned __int128 native_uint128_t;
+#endif
+
+// full 64x64 -> 128 bit unsigned product, the building block of limb-based multiplication
+inline constexpr uint128 umul128(uint64_t a, uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+	native_uint128_t p = static_cast<native_uint128_t>(a) * static_cast<native_uint128_t>(b);
+	return uint128{ static_cast<uint64_t>(p >> 64), static_cast<uint64_t>(p) };
+#else
+	// portable schoolbook on 32-bit halves
+	uint64_t a_lo = a & 0xFFFF'FFFFull, a_hi = a >> 32;
+	uint64_t b_lo = b & 0xFFFF'FFFFull, b_hi = b >> 32;
+	uint64_t lolo = a_lo * b_lo;
+	uint64_t hilo = a_hi * b_lo;
+	uint64_t lohi = a_lo * b_hi;
+	uint64_t hihi = a_hi * b_hi;
+	uint64_t cross = (lolo >> 32) + (hilo & 0xFFFF'FFFFull) + lohi;
+	uint64_t upper = hihi + (hilo >> 32) + (cross >> 32);
+	uint64_t lower = (cross << 32) | (lolo & 0xFFFF'FFFFull);
+	return uint128{ upper, lower };
+#endif
+}
+
+// multiply-accumulate a*b + c + d, which can't overflow 128 bits: (2^64-1)^2 + 2*(2^64-1) = 2^128-1
+inline constexpr uint128 umac128(uint64_t a, uint64_t b, uint64_t c, uint64_t d) noexcept {
+	uint128 p = umul128(a, b);
+	p.lower += c;
+	p.upper += (p.lower < c ? 1u : 0u);
+	p.lower += d;
+	p.upper += (p.lower < d ? 1u : 0u);
+	return p;
+}
+
+// quotient of the 128-bit n and the 64-bit d, precondition n.upper < d so that the quotient fits in 64 bits
+inline constexpr uint64_t udiv128(uint128 n, uint64_t d, uint64_t& remainder) noexcept {
+	assert(n.upper < d);
+#if defined(__SIZEOF_INT128__)
+	native_uint128_t u = (static_cast<native_uint128_t>(n.upper) << 64) | n.lower;
+	remainder = static_cast<uint64_t>(u % d);
+	return static_cast<uint64_t>(u / d);
+#else
+	// portable restoring division, one quotient bit per step
+	uint64_t r = n.upper, q = 0;
+	for (int i = 63; i >= 0; --i) {
+		bool carry = (r >> 63) != 0;
+		r = (r << 1) | ((n.lower >> i) & 1u);
+		q <<= 1;
+		if (carry || r >= d) {
+			r -= d;
+			q |= 1u;
+		}
+	}
+	remainder = r;
+	return q;
+#endif
+}
+
 }}} // namespace sw::universal::internal
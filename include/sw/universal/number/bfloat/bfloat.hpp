@@ -38,6 +38,13 @@
 #define BFLOAT_THROW_ARITHMETIC_EXCEPTION 0
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// enable/disable the SIMD implementation of the batch kernels
+#if !defined(BFLOAT_SIMD_KERNELS)
+// default is to use SSE2, or AVX2 when the build enables it
+#define BFLOAT_SIMD_KERNELS 1
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // bring in the trait functions
 #include <universal/traits/number_traits.hpp>
@@ -56,6 +63,10 @@
 #include <universal/number/bfloat/manipulators.hpp>
 #include <universal/number/bfloat/attributes.hpp>
 
+///////////////////////////////////////////////////////////////////////////////////////
+/// batch kernels over contiguous arrays of bfloat16
+#include <universal/number/bfloat/bfloat16_kernels.hpp>
+
 ///////////////////////////////////////////////////////////////////////////////////////
 /// math functions
 #include <universal/number/bfloat/mathlib.hpp>
@@ -5,6 +5,8 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -19,6 +21,46 @@
 
 namespace sw { namespace universal {
 
+// narrow the bits of a float to the bits of a bfloat16 with round-to-nearest-even: NaNs are kept quiet
+inline constexpr uint16_t bfloat16_narrow_bits(uint32_t f) noexcept {
+	if ((f & 0x7FFF'FFFFu) > 0x7F80'0000u) return static_cast<uint16_t>((f | 0x0040'0000u) >> 16);
+	return static_cast<uint16_t>((f + 0x7FFFu + ((f >> 16) & 1u)) >> 16);
+}
+
+// round (-1)^sign * significand * 2^(exponent - 63), with the leading one of the significand at bit 63,
+// to the bits of a bfloat16 with round-to-nearest-even in a single rounding step
+inline constexpr uint16_t bfloat16_round_bits(bool sign, int exponent, uint64_t significand) noexcept {
+	uint16_t s = sign ? 0x8000u : 0u;
+	if (exponent > 127) return static_cast<uint16_t>(s | 0x7F80u);     // overflow to infinity
+	// a normal keeps 8 significant bits, a subnormal fewer
+	int shift = 56 + (exponent < -126 ? -126 - exponent : 0);
+	if (shift > 64) return s;                                           // below half the smallest subnormal
+	uint64_t q{ 0 }, remainder{ significand }, half{ 1ull << 63 };
+	if (shift < 64) {
+		q = significand >> shift;
+		remainder = significand & ((1ull << shift) - 1);
+		half = 1ull << (shift - 1);
+	}
+	if (remainder > half || (remainder == half && (q & 1u))) ++q;
+	// the hidden bit of a normal adds to the biased exponent, and a carry out of the fraction bumps it
+	uint32_t bits = exponent < -126 ? uint32_t(q) : (uint32_t(exponent + 126) << 7) + uint32_t(q);
+	if (bits >= 0x7F80u) return static_cast<uint16_t>(s | 0x7F80u);
+	return static_cast<uint16_t>(s | bits);
+}
+
+// narrow the bits of a double to the bits of a bfloat16 with round-to-nearest-even, without an intermediate float
+inline constexpr uint16_t bfloat16_narrow_double_bits(uint64_t d) noexcept {
+	bool sign = (d >> 63) != 0;
+	int biasedExponent = int((d >> 52) & 0x7FFu);
+	uint64_t fraction = d & 0x000F'FFFF'FFFF'FFFFull;
+	if (biasedExponent == 0x7FF) {
+		uint16_t s = sign ? 0x8000u : 0u;
+		if (fraction != 0) return static_cast<uint16_t>(s | 0x7FC0u | (fraction >> 45));  // NaNs are kept quiet
+		return static_cast<uint16_t>(s | 0x7F80u);
+	}
+	if (biasedExponent == 0) return sign ? 0x8000u : 0u;  // double subnormals are far below the bfloat16 subnormals
+	return bfloat16_round_bits(sign, biasedExponent - 1023, ((1ull << 52) | fraction) << 11);
+}
 
 // bfloat16 is Google's Brain Float type
 class bfloat16 {
@@ -31,9 +73,9 @@ class bfloat16 {
 		}
 		else {
 			float f = float(v);
-			uint16_t pun[2];
-			std::memcpy(pun, &f, 4);
-			_bits = pun[1];
+			uint32_t raw;
+			std::memcpy(&raw, &f, 4);
+			_bits = bfloat16_narrow_bits(raw);
 		}
 		return *this;
 	}
@@ -45,20 +87,42 @@ class bfloat16 {
 		}
 		else {
 			float f = float(v);
-			uint16_t pun[2];
-			std::memcpy(pun, &f, 4);
-			_bits = pun[1];
+			uint32_t raw;
+			std::memcpy(&raw, &f, 4);
+			_bits = bfloat16_narrow_bits(raw);
 		}
 		return *this;
 	}
 	template<typename Real,
 		typename = typename std::enable_if< std::is_floating_point<Real>::value, Real >::type>
 	constexpr bfloat16& convert_ieee754(Real rhs) noexcept {
-
-		float f = float(rhs);
-		uint16_t pun[2];
-		std::memcpy(pun, &f, 4);
-		_bits = pun[1];
+		if constexpr (sizeof(Real) == sizeof(float)) {
+			uint32_t raw;
+			std::memcpy(&raw, &rhs, 4);
+			_bits = bfloat16_narrow_bits(raw);
+		}
+		else if constexpr (sizeof(Real) == sizeof(double)) {
+			// rounding through float would round twice
+			uint64_t raw;
+			std::memcpy(&raw, &rhs, 8);
+			_bits = bfloat16_narrow_double_bits(raw);
+		}
+		else {
+			if (std::isnan(rhs) || std::isinf(rhs) || rhs == 0) {
+				// special values and zeros map exactly through double
+				double d = double(rhs);
+				uint64_t raw;
+				std::memcpy(&raw, &d, 8);
+				_bits = bfloat16_narrow_double_bits(raw);
+				return *this;
+			}
+			// the leading 64 bits of the significand, with the bits beyond folded into a sticky bit
+			int exponent{ 0 };
+			Real scaled = std::ldexp(std::fabs(std::frexp(rhs, &exponent)), 64);
+			uint64_t significand = uint64_t(scaled);
+			if (scaled != Real(significand)) significand |= 1u;
+			_bits = bfloat16_round_bits(std::signbit(rhs), exponent - 1, significand);
+		}
 		return *this;
 	}
 	template<typename Real,
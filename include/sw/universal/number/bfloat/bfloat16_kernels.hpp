@@ -0,0 +1,225 @@
+#pragma once
+// bfloat16_kernels.hpp: batch kernels over contiguous arrays of bfloat16
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <universal/number/bfloat/bfloat16_impl.hpp>
+
+/*
+ * The kernels widen bfloat16 lanes to float, compute in float, and narrow the results
+ * back with round-to-nearest-even, which is the rounding of the scalar bfloat16 operators.
+ * The element-wise kernels therefore produce the same bits as a loop over the scalar
+ * operators, and do so without leaving the vector registers:
+ *   widening  : the bfloat16 bits become the upper 16 bits of a float
+ *   narrowing : add 0x7FFF plus the lsb of the result, and shift right by 16
+ *
+ * Instruction set selection:
+ *   AVX2      : when the build sets LIB_USE_AVX2 (cmake UNIVRSL_USE_AVX2) and the compiler targets AVX2, 8 lanes
+ *   SSE2      : the baseline of x86-64, 2 x 4 lanes
+ *   portable  : plain C++ loops otherwise, or when BFLOAT_SIMD_KERNELS is set to 0
+ *
+ * dot accumulates in 8 float partial sums, lane k holding the products k, k+8, k+16, ...,
+ * and reduces them in lane order, so its result does not depend on the instruction set.
+ */
+#if !defined(BFLOAT_SIMD_KERNELS)
+#define BFLOAT_SIMD_KERNELS 1
+#endif
+
+#if BFLOAT_SIMD_KERNELS && defined(LIB_USE_AVX2) && defined(__AVX2__)
+#define BFLOAT_KERNELS_AVX2 1
+#include <immintrin.h>
+#elif BFLOAT_SIMD_KERNELS && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BFLOAT_KERNELS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace sw { namespace universal {
+
+	static_assert(sizeof(bfloat16) == sizeof(uint16_t), "bfloat16 kernels require a 16-bit bfloat16 layout");
+
+	namespace internal {
+
+		inline float bfloat16_widen(uint16_t bits) noexcept {
+			uint32_t raw = uint32_t(bits) << 16;
+			float f;
+			std::memcpy(&f, &raw, 4);
+			return f;
+		}
+		inline uint16_t bfloat16_narrow(float f) noexcept {
+			uint32_t raw;
+			std::memcpy(&raw, &f, 4);
+			return bfloat16_narrow_bits(raw);
+		}
+		inline float load_widen(const bfloat16* p) noexcept { return bfloat16_widen(p->bits()); }
+		inline void narrow_store(bfloat16* p, float f) noexcept { p->setbits(bfloat16_narrow(f)); }
+
+#if defined(BFLOAT_KERNELS_AVX2)
+		// 8 lanes
+		inline __m256 load_widen8(const bfloat16* p) noexcept {
+			__m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+		}
+		inline void narrow_store8(bfloat16* p, __m256 v) noexcept {
+			const __m256i bits = _mm256_castps_si256(v);
+			const __m256i absBits = _mm256_and_si256(bits, _mm256_set1_epi32(0x7FFF'FFFF));
+			const __m256i isNaN = _mm256_cmpgt_epi32(absBits, _mm256_set1_epi32(0x7F80'0000));
+			const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+			const __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7FFF)));
+			const __m256i quiet = _mm256_or_si256(bits, _mm256_set1_epi32(0x0040'0000));
+			// arithmetic shift sign-extends so that the signed saturation of the pack is exact
+			const __m256i narrowed = _mm256_srai_epi32(_mm256_blendv_epi8(rounded, quiet, isNaN), 16);
+			const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(narrowed, narrowed), 0xD8);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(packed));
+		}
+#elif defined(BFLOAT_KERNELS_SSE2)
+		// 4 lanes
+		inline __m128 load_widen4(const bfloat16* p) noexcept {
+			__m128i h = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+			return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), h));
+		}
+		inline __m128i narrow4(__m128 v) noexcept {
+			const __m128i bits = _mm_castps_si128(v);
+			const __m128i absBits = _mm_and_si128(bits, _mm_set1_epi32(0x7FFF'FFFF));
+			const __m128i isNaN = _mm_cmpgt_epi32(absBits, _mm_set1_epi32(0x7F80'0000));
+			const __m128i lsb = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1));
+			const __m128i rounded = _mm_add_epi32(bits, _mm_add_epi32(lsb, _mm_set1_epi32(0x7FFF)));
+			const __m128i quiet = _mm_or_si128(bits, _mm_set1_epi32(0x0040'0000));
+			const __m128i selected = _mm_or_si128(_mm_and_si128(isNaN, quiet), _mm_andnot_si128(isNaN, rounded));
+			return _mm_srai_epi32(selected, 16);
+		}
+		inline void narrow_store8(bfloat16* p, __m128 lo, __m128 hi) noexcept {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(narrow4(lo), narrow4(hi)));
+		}
+#endif
+
+		// apply a lane-wise float operation to 8 lanes at a time and to the tail
+		template<typename Kernel8, typename Kernel1>
+		inline void bfloat16_transform(size_t n, Kernel8 kernel8, Kernel1 kernel1) {
+			size_t i = 0;
+#if defined(BFLOAT_KERNELS_AVX2) || defined(BFLOAT_KERNELS_SSE2)
+			for (; i + 8 <= n; i += 8) kernel8(i);
+#else
+			(void)kernel8;
+#endif
+			for (; i < n; ++i) kernel1(i);
+		}
+
+	} // namespace internal
+
+	/// <summary>
+	/// z[i] = x[i] + y[i] for i in [0, n)
+	/// </summary>
+	inline void bfloat16_add(size_t n, const bfloat16* x, const bfloat16* y, bfloat16* z) {
+		using namespace internal;
+		bfloat16_transform(n,
+			[=](size_t i) {
+#if defined(BFLOAT_KERNELS_AVX2)
+				narrow_store8(z + i, _mm256_add_ps(load_widen8(x + i), load_widen8(y + i)));
+#elif defined(BFLOAT_KERNELS_SSE2)
+				narrow_store8(z + i, _mm_add_ps(load_widen4(x + i), load_widen4(y + i)), _mm_add_ps(load_widen4(x + i + 4), load_widen4(y + i + 4)));
+#else
+				(void)i;
+#endif
+			},
+			[=](size_t i) { narrow_store(z + i, load_widen(x + i) + load_widen(y + i)); });
+	}
+
+	/// <summary>
+	/// z[i] = x[i] * y[i] for i in [0, n)
+	/// </summary>
+	inline void bfloat16_mul(size_t n, const bfloat16* x, const bfloat16* y, bfloat16* z) {
+		using namespace internal;
+		bfloat16_transform(n,
+			[=](size_t i) {
+#if defined(BFLOAT_KERNELS_AVX2)
+				narrow_store8(z + i, _mm256_mul_ps(load_widen8(x + i), load_widen8(y + i)));
+#elif defined(BFLOAT_KERNELS_SSE2)
+				narrow_store8(z + i, _mm_mul_ps(load_widen4(x + i), load_widen4(y + i)), _mm_mul_ps(load_widen4(x + i + 4), load_widen4(y + i + 4)));
+#else
+				(void)i;
+#endif
+			},
+			[=](size_t i) { narrow_store(z + i, load_widen(x + i) * load_widen(y + i)); });
+	}
+
+	/// <summary>
+	/// d[i] = a[i] * b[i] + c[i] for i in [0, n): the product of two bfloat16 values is exact in float,
+	/// but the sum is rounded to float and then to bfloat16, so this is not a fused multiply-add:
+	/// the double rounding can be one ulp off the correctly rounded a * b + c when the float sum lands on a tie
+	/// </summary>
+	inline void bfloat16_fma(size_t n, const bfloat16* a, const bfloat16* b, const bfloat16* c, bfloat16* d) {
+		using namespace internal;
+		bfloat16_transform(n,
+			[=](size_t i) {
+#if defined(BFLOAT_KERNELS_AVX2)
+				narrow_store8(d + i, _mm256_add_ps(_mm256_mul_ps(load_widen8(a + i), load_widen8(b + i)), load_widen8(c + i)));
+#elif defined(BFLOAT_KERNELS_SSE2)
+				narrow_store8(d + i,
+					_mm_add_ps(_mm_mul_ps(load_widen4(a + i), load_widen4(b + i)), load_widen4(c + i)),
+					_mm_add_ps(_mm_mul_ps(load_widen4(a + i + 4), load_widen4(b + i + 4)), load_widen4(c + i + 4)));
+#else
+				(void)i;
+#endif
+			},
+			[=](size_t i) { narrow_store(d + i, load_widen(a + i) * load_widen(b + i) + load_widen(c + i)); });
+	}
+
+	/// <summary>
+	/// y[i] = alpha * x[i] + y[i] for i in [0, n)
+	/// </summary>
+	inline void bfloat16_axpy(size_t n, bfloat16 alpha, const bfloat16* x, bfloat16* y) {
+		using namespace internal;
+		const float a = internal::bfloat16_widen(alpha.bits());
+		bfloat16_transform(n,
+			[=](size_t i) {
+#if defined(BFLOAT_KERNELS_AVX2)
+				narrow_store8(y + i, _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a), load_widen8(x + i)), load_widen8(y + i)));
+#elif defined(BFLOAT_KERNELS_SSE2)
+				const __m128 va = _mm_set1_ps(a);
+				narrow_store8(y + i,
+					_mm_add_ps(_mm_mul_ps(va, load_widen4(x + i)), load_widen4(y + i)),
+					_mm_add_ps(_mm_mul_ps(va, load_widen4(x + i + 4)), load_widen4(y + i + 4)));
+#else
+				(void)i;
+#endif
+			},
+			[=](size_t i) { narrow_store(y + i, a * load_widen(x + i) + load_widen(y + i)); });
+	}
+
+	/// <summary>
+	/// dot product of x and y accumulated in float
+	/// </summary>
+	/// <returns>the float sum of the lane partial sums, not rounded to bfloat16</returns>
+	inline float bfloat16_dot(size_t n, const bfloat16* x, const bfloat16* y) {
+		using namespace internal;
+		float partial[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		size_t i = 0;
+#if defined(BFLOAT_KERNELS_AVX2)
+		__m256 acc = _mm256_setzero_ps();
+		for (; i + 8 <= n; i += 8) acc = _mm256_add_ps(acc, _mm256_mul_ps(load_widen8(x + i), load_widen8(y + i)));
+		_mm256_storeu_ps(partial, acc);
+#elif defined(BFLOAT_KERNELS_SSE2)
+		__m128 lo = _mm_setzero_ps(), hi = _mm_setzero_ps();
+		for (; i + 8 <= n; i += 8) {
+			lo = _mm_add_ps(lo, _mm_mul_ps(load_widen4(x + i), load_widen4(y + i)));
+			hi = _mm_add_ps(hi, _mm_mul_ps(load_widen4(x + i + 4), load_widen4(y + i + 4)));
+		}
+		_mm_storeu_ps(partial, lo);
+		_mm_storeu_ps(partial + 4, hi);
+#else
+		for (; i + 8 <= n; i += 8) {
+			for (size_t k = 0; k < 8; ++k) partial[k] += load_widen(x + i + k) * load_widen(y + i + k);
+		}
+#endif
+		for (size_t k = 0; i < n; ++i, ++k) partial[k] += load_widen(x + i) * load_widen(y + i);
+		float sum = partial[0];
+		for (size_t k = 1; k < 8; ++k) sum += partial[k];
+		return sum;
+	}
+
+}} // namespace sw::universal
@@ -51,6 +51,11 @@
 #define CFLOAT_NATIVE_SQRT 0
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// enable native arithmetic for the IEEE-754 equivalent configurations
+// CFLOAT_FAST_SPECIALIZATION when set will map half, bfloat16, single, and double
+// onto the native floating-point unit, see <universal/number/cfloat/specializations.hpp>
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // bring in the trait functions
 #include <universal/traits/number_traits.hpp>
@@ -31,6 +31,8 @@
 #include <universal/number/algorithm/trace_constants.hpp>
 // cfloat exception structure
 #include <universal/number/cfloat/exceptions.hpp>
+// native arithmetic configuration of the IEEE-754 equivalent cfloats
+#include <universal/number/cfloat/specializations.hpp>
 // composition types used by cfloat
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/internal/blocktriple/blocktriple.hpp>
@@ -360,6 +362,10 @@ public:
 	static constexpr bool     isSaturating    = _isSaturating;
 	typedef bt BlockType;
 
+	// the native type that computes the arithmetic of IEEE-754 equivalent configurations, see specializations.hpp
+	using NativeArithmetic = typename cfloat_native_arithmetic<nbits, es, hasSubnormals, hasSupernormals>::type;
+	static constexpr bool     hasNativeArithmetic = !std::is_same_v<NativeArithmetic, void>;
+
 	// constructors
 	cfloat() = default;
 	cfloat(const cfloat&) = default;
@@ -491,6 +497,9 @@ public:
 
 	cfloat& operator+=(const cfloat& rhs) CFLOAT_EXCEPT {
 		if constexpr (_trace_add) std::cout << "---------------------- ADD -------------------" << std::endl;
+		if constexpr (hasNativeArithmetic) {
+			if (isnativeoperand() && rhs.isnativeoperand()) return assignnative(nativevalue() + rhs.nativevalue());
+		}
 		// special case handling of the inputs
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
 		if (isnan(NAN_TYPE_SIGNALLING) || rhs.isnan(NAN_TYPE_SIGNALLING)) {
@@ -565,6 +574,9 @@ public:
 	}
 	cfloat& operator*=(const cfloat& rhs) CFLOAT_EXCEPT {
 		if constexpr (_trace_mul) std::cout << "---------------------- MUL -------------------\n";
+		if constexpr (hasNativeArithmetic) {
+			if (isnativeoperand() && rhs.isnativeoperand()) return assignnative(nativevalue() * rhs.nativevalue());
+		}
 		// special case handling of the inputs
 #if CFLOAT_THROW_ARITHMETIC_EXCEPTION
 		if (isnan(NAN_TYPE_SIGNALLING) || rhs.isnan(NAN_TYPE_SIGNALLING)) {
@@ -631,6 +643,9 @@ public:
 	}
 	cfloat& operator/=(const cfloat& rhs) CFLOAT_EXCEPT {
 		if constexpr (_trace_div) std::cout << "---------------------- DIV -------------------" << std::endl;
+		if constexpr (hasNativeArithmetic) {
+			if (isnativeoperand() && rhs.isnativeoperand()) return assignnative(nativevalue() / rhs.nativevalue());
+		}
 
 		// special case handling of the inputs
 		// qnan / qnan = qnan
@@ -2219,6 +2234,69 @@ public:
 protected:
 	// HELPER methods
 
+	// native arithmetic helpers for the IEEE-754 equivalent configurations
+
+	// the encoding as an unsigned integer, only used for nbits <= 64
+	constexpr uint64_t rawbits() const noexcept {
+		uint64_t raw{ 0 };
+		for (unsigned i = 0; i < nrBlocks; ++i) raw |= (uint64_t(_block[i]) << (i * bitsInBlock));
+		return raw;
+	}
+	// true for normal and subnormal encodings: zero, inf, and nan are left to the emulation
+	constexpr bool isnativeoperand() const noexcept {
+		uint64_t raw = rawbits();
+		uint64_t exponent = (raw >> fbits) & ALL_ONES_ES;
+		return exponent != ALL_ONES_ES && (raw & ~(1ull << (nbits - 1))) != 0;
+	}
+	// exact value of a normal or subnormal encoding in the native type
+	NativeArithmetic nativevalue() const noexcept {
+		using Native = NativeArithmetic;
+		uint64_t raw = rawbits();
+		if constexpr (nbits == 32 && sizeof(Native) == 4) {
+			return sw::bit_cast<float>(static_cast<uint32_t>(raw));
+		}
+		else if constexpr (nbits == 64 && sizeof(Native) == 8) {
+			return sw::bit_cast<double>(raw);
+		}
+		else {
+			// widen the encoding into the native format, which has no subnormals in our range
+			using NativeBits = std::conditional_t<sizeof(Native) == 4, uint32_t, uint64_t>;
+			constexpr unsigned nativeFbits = static_cast<unsigned>(ieee754_parameter<Native>::fbits);
+			constexpr int nativeBias = ieee754_parameter<Native>::bias;
+			uint64_t exponent = (raw >> fbits) & ALL_ONES_ES;
+			uint64_t fraction = raw & ((1ull << fbits) - 1ull);
+			int scale = static_cast<int>(exponent) - EXP_BIAS;
+			if (exponent == 0) { // subnormal: normalize the fraction
+				int shift = static_cast<int>(fbits) - static_cast<int>(find_msb(fraction)) + 1;
+				fraction = (fraction << shift) & ((1ull << fbits) - 1ull);
+				scale = MIN_EXP_NORMAL - shift;
+			}
+			NativeBits bits = NativeBits((raw >> (nbits - 1)) & 1ull) << (sizeof(Native) * 8 - 1);
+			bits |= NativeBits(static_cast<uint64_t>(scale + nativeBias) << nativeFbits);
+			bits |= NativeBits(fraction << (nativeFbits - fbits));
+			return sw::bit_cast<Native>(bits);
+		}
+	}
+	// round a native result of two normal or subnormal operands into this cfloat
+	template<typename Native>
+	cfloat& assignnative(Native v) noexcept {
+		if constexpr (nbits == 8 * sizeof(Native)) {
+			if (std::isinf(v)) {
+				if constexpr (isSaturating) {
+					if (v < 0) maxneg(); else maxpos();
+				}
+				else {
+					setinf(v < 0);
+				}
+				return *this;
+			}
+			if constexpr (nbits == 32) return setbits(sw::bit_cast<uint32_t>(v)); else return setbits(sw::bit_cast<uint64_t>(v));
+		}
+		else {
+			return convert_ieee754(v); // rounds, and saturates or projects to inf out of range
+		}
+	}
+
 	/// <summary>
 	/// 1's complement of the encoding used to set up specific encoding patterns.
 	/// This is not an arithmetic operator that makes sense for floating-point numbers.
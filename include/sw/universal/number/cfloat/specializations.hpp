@@ -0,0 +1,78 @@
+#pragma once
+// specializations.hpp: header to configure the native arithmetic of the IEEE-754 equivalent cfloats
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cfloat>
+#include <type_traits>
+
+// enable native arithmetic for the cfloat configurations that are equivalent to IEEE-754 formats
+// CFLOAT_FAST_SPECIALIZATION when set will turn on all fast implementations
+// The individual CFLOAT_FAST_### macros enable fine grain control over which configurations
+// use native arithmetic:
+//   CFLOAT_FAST_FP16  cfloat<16,  5, bt, true, false, sat> computed in float
+//   CFLOAT_FAST_BF16  cfloat<16,  8, bt, true, false, sat> computed in double
+//   CFLOAT_FAST_FP32  cfloat<32,  8, bt, true, false, sat> computed in float
+//   CFLOAT_FAST_FP64  cfloat<64, 11, bt, true, false, sat> computed in double
+// The encodings of these configurations are the IEEE-754 encodings, and a native operation
+// on two finite, non-zero operands, followed by a single rounding to the cfloat, yields the
+// correctly rounded result as the wider native precision p satisfies p >= 2*fhbits + 2.
+// Zeros, infinities, and NaNs keep taking the emulated path, so the cfloat rules for signed
+// zeros and for the signalling and quiet NaN encodings are unchanged, and overflow of a
+// saturating configuration still saturates to maxpos or maxneg.
+// The native floating-point unit must operate with gradual underflow, that is, flush-to-zero
+// and denormals-are-zero modes must be disabled.
+#ifdef CFLOAT_FAST_SPECIALIZATION
+#define CFLOAT_FAST_FP16 1
+#define CFLOAT_FAST_BF16 1
+#define CFLOAT_FAST_FP32 1
+#define CFLOAT_FAST_FP64 1
+#endif
+
+#ifndef CFLOAT_FAST_FP16
+#define CFLOAT_FAST_FP16 0
+#endif
+#ifndef CFLOAT_FAST_BF16
+#define CFLOAT_FAST_BF16 0
+#endif
+#ifndef CFLOAT_FAST_FP32
+#define CFLOAT_FAST_FP32 0
+#endif
+#ifndef CFLOAT_FAST_FP64
+#define CFLOAT_FAST_FP64 0
+#endif
+
+// excess precision of the native evaluation, such as x87 extended precision, would round twice
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD != 0)
+#define CFLOAT_NATIVE_ARITHMETIC_SUPPORTED 0
+#else
+#define CFLOAT_NATIVE_ARITHMETIC_SUPPORTED 1
+#endif
+
+namespace sw { namespace universal {
+
+// cfloat_native_arithmetic selects the native floating-point type that computes the
+// results of a cfloat configuration, or void when the configuration is emulated
+template<unsigned nbits, unsigned es, bool hasSubnormals, bool hasSupernormals>
+struct cfloat_native_arithmetic { using type = void; };
+
+template<>
+struct cfloat_native_arithmetic<16, 5, true, false> {
+	using type = std::conditional_t<CFLOAT_FAST_FP16 && CFLOAT_NATIVE_ARITHMETIC_SUPPORTED, float, void>;
+};
+template<>
+struct cfloat_native_arithmetic<16, 8, true, false> {
+	using type = std::conditional_t<CFLOAT_FAST_BF16 && CFLOAT_NATIVE_ARITHMETIC_SUPPORTED, double, void>;
+};
+template<>
+struct cfloat_native_arithmetic<32, 8, true, false> {
+	using type = std::conditional_t<CFLOAT_FAST_FP32 && CFLOAT_NATIVE_ARITHMETIC_SUPPORTED, float, void>;
+};
+template<>
+struct cfloat_native_arithmetic<64, 11, true, false> {
+	using type = std::conditional_t<CFLOAT_FAST_FP64 && CFLOAT_NATIVE_ARITHMETIC_SUPPORTED, double, void>;
+};
+
+}} // namespace sw::universal
@@ -5,8 +5,12 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <limits>
+#include <type_traits>
+#include <vector>
 
 #include <universal/native/ieee754.hpp>
 #include <universal/internal/abstract/triple.hpp>
@@ -123,6 +127,13 @@ public:
 	static constexpr double   base1   = 3.0;
 	static constexpr double   log2of3 = 1.5849625007211561814537389439478;
 
+	// the Gaussian logarithms of the addition are tabulated for all exponent differences when that table is small
+	static constexpr bool     hasAdditionTable = (fbbits + sbbits + 2) <= 14;
+	// conversion to IEEE-754 reads 3^b from a table
+	static constexpr bool     hasPowerTable = (sbbits <= 12);
+	// rounding to the nearest exponent pair searches a sorted table of the fractional parts of b*log2(3)
+	static constexpr bool     hasFractionTable = (sbbits <= 16);
+
 	/// trivial constructor
 	dbns() = default;
 
@@ -189,37 +200,52 @@ public:
 	constexpr dbns operator-() const noexcept {
 		if (isnan() || iszero()) return *this;
 		dbns negate(*this);
-		negate.setbit(nbits - 1, !sign());
+		negate.setsign(!sign());
 		return negate;
 	}
 
 	// in-place arithmetic assignment operators
+	// x + y = x * (1 + y/x): the sum is the log of x plus the Gaussian logarithm of the exponent difference
 	dbns& operator+=(const dbns& rhs) {
-		double sum{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
+		if (isnan()) return *this;
+		if (rhs.isnan()) {
+			setnan();
+			return *this;
+		}
+		if (rhs.iszero()) return *this;
+		if (iszero()) return *this = rhs;
+
+		int64_t ax = extractExponent(0), bx = extractExponent(1);
+		int64_t ay = rhs.extractExponent(0), by = rhs.extractExponent(1);
+		int64_t da = ay - ax, db = by - bx;
+		bool sx = sign(), sy = rhs.sign();
+		if (sx != sy && da == 0 && db == 0) {
+			setzero();
+			return *this;
+		}
+		// log2|y| - log2|x|
+		double delta = static_cast<double>(db) * log2of3 - static_cast<double>(da);
+		double gaussian{ 0.0 };
+		if constexpr (hasAdditionTable) {
+			size_t index = static_cast<size_t>((da + static_cast<int64_t>(MAX_A)) * static_cast<int64_t>(2 * MAX_B + 1) + (db + static_cast<int64_t>(MAX_B)));
+			gaussian = (sx == sy ? additionTable()[index] : subtractionTable()[index]);
 		}
 		else {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
+			gaussian = (sx == sy ? sb(delta) : this->db(delta));
 		}
-		return *this = sum; // <-- saturation happens in the assignment
+		bool negative = (sx == sy ? sx : (delta < 0.0 ? sx : sy));
+		return round_to_pair(negative, static_cast<double>(bx) * log2of3 - static_cast<double>(ax) + gaussian);
 	}
 	dbns& operator+=(double rhs) { 
 		return operator+=(dbns(rhs));
 	}
 	dbns& operator-=(const dbns& rhs) { 
-		double diff{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
-		}
-		else {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
-		}
-		return *this = diff; // <-- saturation happens in the assignment
+		return operator+=(-rhs);
 	}
 	dbns& operator-=(double rhs) {
 		return operator-=(dbns(rhs));
 	}
+	// x * y is the sum of the exponent pairs
 	dbns& operator*=(const dbns& rhs) {
 		if (isnan()) return *this;
 		if (rhs.isnan()) {
@@ -231,61 +257,13 @@ public:
 			setzero();
 			return *this;
 		}
-#if defined(NATIVE_DBNS_ARITHMETIC)
-		bool negative = sign() ^ rhs.sign(); // determine sign of result
-		uint32_t a = extractExponent(0) + rhs.extractExponent(0);
-		uint32_t b = extractExponent(1) + rhs.extractExponent(1);
-		if constexpr (behavior == Behavior::Saturating) { // saturating, no infinite
-			clear();
-			if (a > MAX_A || b > MAX_B) {
-				// try to project the value back into valid pairs
-				// the approximations of unity looks like (3, -2), (8,-5), (19,-12), (84,-53),... 
-				// they grow too fast and in a rather irregular manner. There are more 
-				// subtle number theoretic considerations, but the ones outlined above 
-				// should be sufficient to figure out a good solution to the problem.
-				// 2^3*3^-2 = 0.888  2^-3*3^2 = 1.125
-				// 2^8*3^-5 = 1.053  2^-8*3^5 = 0.949
-				unsigned first[] = { 3, 8, 19, 84 };
-				unsigned second[] = { 2, 5, 12, 53 };
-				bool unableToAdjust{ true };
-				for (unsigned i = 0; i < 4; ++i) {
-					unsigned adjusted_a = a - first[i];
-					unsigned adjusted_b = b - second[i];
-					if (adjusted_a <= MAX_A && adjusted_b <= MAX_B) {
-						setexponent(0, adjusted_a);
-						setexponent(1, adjusted_b);
-						unableToAdjust = false;
-					}
-				}
-				if (unableToAdjust){
-					if (a > b) {
-						setexponent(0, MAX_A);
-						setexponent(1, 0);
-						negative = false; // we need to avoid nan(ind)
-					}
-					else {
-						setexponent(0, 0);
-						setexponent(1, MAX_B);
-					}
-				}
-			}
-			else {
-				setexponent(0, a);
-				setexponent(1, b);
-			}
-		}
-		else {
-			static_assert(true, "multi-limb TBD");
-		}
-		setsign(negative);
-		if (isnan()) setzero(); // if the arithmetic ends up in the nan encoding, set the value to zero
-#else
-		// marshall through double value
-		* this = double(*this) * double(rhs);
-#endif
-		return *this;
+		bool negative = sign() ^ rhs.sign();
+		int64_t a = static_cast<int64_t>(extractExponent(0)) + static_cast<int64_t>(rhs.extractExponent(0));
+		int64_t b = static_cast<int64_t>(extractExponent(1)) + static_cast<int64_t>(rhs.extractExponent(1));
+		return assign_pair(negative, a, b);
 	}
 	dbns& operator*=(double rhs) { return operator*=(dbns(rhs)); }
+	// x / y is the difference of the exponent pairs
 	dbns& operator/=(const dbns& rhs) {
 		if (isnan()) return *this;
 		if (rhs.isnan()) {
@@ -302,25 +280,10 @@ public:
 		}
 		if (iszero()) return *this;
 
-#if defined(NATIVE_DBNS_ARITHMETIC)
-		// this simple code doesn't work because of modulo underflow when the right hand side exponent is bigger than the left hand side
-		bool negative = sign() ^ rhs.sign(); // determine sign of result
-		uint32_t e0 = extractExponent(0) - rhs.extractExponent(0);
-		uint32_t e1 = extractExponent(1) - rhs.extractExponent(1);
-		if constexpr (behavior == Behavior::Saturating) { // saturating, no infinite
-			clear();
-			setexponent(0, e0);
-			setexponent(1, e1);
-		}
-		else {
-			static_assert(true, "multi-limb TBD");
-		}
-		setsign(negative);
-#else
-		// marshall through double value
-		* this = double(*this) / double(rhs);
-#endif
-		return *this;
+		bool negative = sign() ^ rhs.sign();
+		int64_t a = static_cast<int64_t>(extractExponent(0)) - static_cast<int64_t>(rhs.extractExponent(0));
+		int64_t b = static_cast<int64_t>(extractExponent(1)) - static_cast<int64_t>(rhs.extractExponent(1));
+		return assign_pair(negative, a, b);
 	}
 	dbns& operator/=(double rhs) { return operator/=(dbns(rhs)); }
 
@@ -396,7 +359,7 @@ public:
 	constexpr void setzero()                       noexcept { zero(); }
 	constexpr void setnan(bool sign = true)        noexcept { zero(); setbit(nbits - 1, sign); } // to be consistent with IEEE-754 to have either quiet or signalling NaNs
 	constexpr void setinf(bool sign = false)       noexcept { (sign ? maxneg() : maxpos()); } // TODO: is that what we want?
-	constexpr void setsign(bool s = true)          noexcept { setbit(nbits - 1, s); }
+	constexpr void setsign(bool s = true)          noexcept { _block[MSU] = bt(s ? (_block[MSU] | SIGN_BIT_MASK) : (_block[MSU] & ~SIGN_BIT_MASK)); }
 	constexpr void setbit(unsigned i, bool v = true) noexcept {
 		unsigned blockIndex = i / bitsInBlock;
 		if (i < nbits) {
@@ -662,10 +625,6 @@ protected:
 	template<typename Real>
 	CONSTEXPRESSION dbns& convert_ieee754(Real v) noexcept {
 		if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.conversionEvents;
-		using std::abs;
-		using std::log2;
-		using std::pow;
-		using std::round;
 		bool s{ false };
 		uint64_t unbiasedExponent{ 0 };
 		uint64_t rawFraction{ 0 };
@@ -703,94 +662,169 @@ protected:
 
 		// it is too expensive to check if the value is in the representable range
 		// the search below will end up at 0 or maxpos
+		return round_to_pair(s, std::log2(std::abs(static_cast<double>(v))));
+	}
 
-		// we search for the a and b in v = 2^a * 3^b, with both a and b positive
-		// in our representation we have 0.5^a * 3^b, which would be equivalent
-		// to a being negative
-		// 
-		// v = 2^a * 3^b =>
-		// v = 2^(a + b*log2of3) =>
-		// scale of v = (a + b*log2of3)
-		// we use this relationship to search among the second base exponents 
-		// and find a first base exponent that minimizes the error
-		// between the result and the value we are trying to approximate.
-		constexpr bool bDebug = false;
-		double scale = log2(abs(v)); 
-		if constexpr (bDebug) std::cout << "scale : " << scale << '\n';
-		double lowestError = 1.0e10;
-		int best_a = std::numeric_limits<int>::max();
-		int best_b = std::numeric_limits<int>::max();
-		for (int b = 0; b <= static_cast<int>(SB_MASK); ++b) {
-			int a = static_cast<int>(round((scale - b * log2of3))); // find the first base exponent that is closest to the value
-			if (a > 0 || a > static_cast<int>(MAX_A)) {
-				if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.exponentOverflowDuringSearch;
-				continue;
-			}
-			double err = abs(scale - (a + b * log2of3));
-			if constexpr (bDebug) {
-				double fb = pow(2.0, a);
-				double sb = pow(3.0, b);
-				double value = fb * sb;
-				std::cout << "a : " << a << " b : " << b << " err : " << err << " fb : " << fb << " sb : " << sb << " value : " << value << '\n';
-			}
-			if (err < lowestError) {
-				lowestError = err;
-				best_a = a;
-				best_b = b;
+	/// <summary>
+	/// round the value (-1)^s * 2^scale to the nearest exponent pair.
+	/// This is the rounding of the conversion from native types and of the arithmetic operators.
+	/// </summary>
+	/// <param name="s">sign of the value</param>
+	/// <param name="scale">base-2 logarithm of the magnitude of the value</param>
+	/// <returns>reference to this dbns</returns>
+	dbns& round_to_pair(bool s, double scale) noexcept {
+		// the value 0.5^a * 3^b has scale b*log2(3) - a, so for a given b the nearest first base
+		// exponent is a = round(b*log2(3) - scale), and the rounding error is the distance modulo 1 between
+		// the fractional parts of b*log2(3) and of scale. The nearest pair is therefore the b whose
+		// fractional part is closest to that of scale, among the b for which a is encodable.
+		if (std::isnan(scale) || scale == std::numeric_limits<double>::infinity()) return saturate(s);
+		if (scale == -std::numeric_limits<double>::infinity()) return underflow(s);
+		int64_t best_b{ -1 };
+		if constexpr (hasFractionTable) {
+			const std::vector<FractionalPart>& parts = fractionalParts();
+			const int64_t n = static_cast<int64_t>(parts.size());
+			double fraction = scale - std::floor(scale);
+			int64_t above = std::lower_bound(parts.begin(), parts.end(), fraction, [](const FractionalPart& p, double f) { return p.fraction < f; }) - parts.begin();
+			// walk away from the fractional part of scale on both sides: the rounding error grows
+			// monotonically, so the first encodable pair on each side is that side's nearest pair
+			for (int64_t k = 0; k < n; ++k) {
+				int64_t b = parts[static_cast<size_t>((above + k) % n)].b;
+				if (encodable(scale, b)) { best_b = b; break; }
 			}
-		}
-		if constexpr (bDebug) std::cout << "best a : " << best_a << " best b : " << best_b << " lowest err : " << lowestError << '\n';
-		assert(best_b >= 0); // second exponent is negative
-		clear();
-		int a = -best_a;
-		int b = best_b;
-		if (a < 0 || a > static_cast<int>(MAX_A) || b > static_cast<int>(MAX_B)) {
-			// try to project the value back into valid pairs
-			// the approximations of unity looks like (8,-5), (19,-12), (84,-53),... 
-			// they grow too fast and in a rather irregular manner. There are more 
-			// subtle number theoretic considerations, but the ones outlined above 
-			// should be sufficient to figure out a good solution to the problem.
-			// 2^3*3^-2 = 0.888  2^-3*3^2 = 1.125
-			// 2^8*3^-5 = 1.053  2^-8*3^5 = 0.949
-			// multiplier   0.5, 1.5, 0.6, 0.889, 1.125, 0.949, 1.053.....
-			int first[]  = { 1, 1, -1, 3, -3, 5, -5, 8, -8, 19, -19, 84, -84 };
-			int second[] = { 0, 1, -1, 2, -2, 3, -3, 5, -5, 12, -12, 53, -53 };
-			bool unableToAdjust{ true };
-			for (unsigned i = 0; i < 13; ++i) {
-				int adjusted_a = a - first[i];
-				int adjusted_b = b - second[i];
-				if (adjusted_a >= 0 && adjusted_a < static_cast<int>(MAX_A) && adjusted_b >= 0 && adjusted_b < static_cast<int>(MAX_B)) {
-					setexponent(0, static_cast<unsigned>(adjusted_a));
-					setexponent(1, static_cast<unsigned>(adjusted_b));
-					setsign(s);
-					unableToAdjust = false;
+			for (int64_t k = 1; k <= n; ++k) {
+				int64_t b = parts[static_cast<size_t>((above - k + n) % n)].b;
+				if (encodable(scale, b)) {
+					if (best_b < 0 || pairError(scale, b) < pairError(scale, best_b) || (pairError(scale, b) == pairError(scale, best_b) && b < best_b)) best_b = b;
 					break;
 				}
 			}
-			if (unableToAdjust) {
-				if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.roundingFailure;
-				//if (a > b) {
-				if (best_a < 0 && best_b >= 0) {
-					setexponent(0, MAX_A);
-					setexponent(1, 0);
-					setsign(false); // we need to avoid nan(ind)
-				}
-				else {   // we have maxed out
-					setexponent(0, 0);
-					setexponent(1, MAX_B);
-					setsign(s);
-				}
+		}
+		else {
+			// the encodable b form the window where 0 <= round(b*log2(3) - scale) <= MAX_A
+			double lowest = std::ceil((scale - 0.5) / log2of3) - 1.0;
+			double highest = std::floor((scale + static_cast<double>(MAX_A) + 0.5) / log2of3) + 1.0;
+			int64_t first = (lowest < 0.0 ? 0 : (lowest > static_cast<double>(MAX_B) ? static_cast<int64_t>(MAX_B) + 1 : static_cast<int64_t>(lowest)));
+			int64_t last = (highest < 0.0 ? -1 : (highest > static_cast<double>(MAX_B) ? static_cast<int64_t>(MAX_B) : static_cast<int64_t>(highest)));
+			for (int64_t b = first; b <= last; ++b) {
+				if (encodable(scale, b) && (best_b < 0 || pairError(scale, b) < pairError(scale, best_b))) best_b = b;
 			}
 		}
+		if (best_b >= 0) {
+			int64_t best_a = static_cast<int64_t>(std::round(static_cast<double>(best_b) * log2of3 - scale));
+			setpair(s, static_cast<uint64_t>(best_a), static_cast<uint64_t>(best_b));
+			// avoid assigning to nan(ind)
+			if (isnan()) setzero();
+			return *this;
+		}
+		// no encodable first base exponent: the value is either beyond maxpos, or below the smallest first base,
+		// since MAX_A >= 1 makes the window of encodable a wider than the step of log2(3) between successive b
+		if (std::round(static_cast<double>(MAX_B) * log2of3 - scale) < 0.0) return saturate(s);
+		return underflow(s);
+	}
+
+	// set the sign and exponent fields of the encoding
+	void setpair(bool s, uint64_t a, uint64_t b) noexcept {
+		if constexpr (nbits <= 64) {
+			setbits((static_cast<uint64_t>(s) << (nbits - 1)) | (a << sbbits) | b);
+		}
 		else {
-			a <<= sbbits;
-			_block[MSU] = static_cast<bt>(static_cast<bt>(s ? SIGN_BIT_MASK : 0u) | static_cast<bt>(a) | static_cast<bt>(b));
+			clear();
+			setexponent(0, static_cast<uint32_t>(a));
+			setexponent(1, static_cast<uint32_t>(b));
+			setsign(s);
+		}
+	}
+
+	// assign the exact product or quotient 0.5^a * 3^b, or round it to the nearest pair when it is out of range
+	dbns& assign_pair(bool s, int64_t a, int64_t b) noexcept {
+		if (a < 0 || a > static_cast<int64_t>(MAX_A) || b < 0 || b > static_cast<int64_t>(MAX_B)) {
+			return round_to_pair(s, static_cast<double>(b) * log2of3 - static_cast<double>(a));
 		}
-		// avoid assigning to nan(ind)
+		setpair(s, static_cast<uint64_t>(a), static_cast<uint64_t>(b));
+		// 0.5^MAX_A is the encoding of zero and nan
 		if (isnan()) setzero();
 		return *this;
 	}
 
+	// helpers of round_to_pair
+	static bool encodable(double scale, int64_t b) noexcept {
+		double a = std::round(static_cast<double>(b) * log2of3 - scale);
+		return a >= 0.0 && a <= static_cast<double>(MAX_A);
+	}
+	static double pairError(double scale, int64_t b) noexcept {
+		double x = static_cast<double>(b) * log2of3 - scale;
+		return std::abs(x - std::round(x));
+	}
+	dbns& saturate(bool s) noexcept {
+		if constexpr (bCollectDbnsEventStatistics) ++dbnsStats.roundingFailure;
+		maxpos();
+		setsign(s);
+		return *this;
+	}
+	// values below the smallest first base round to 0.5^MAX_A, which is the encoding of zero
+	dbns& underflow(bool s) noexcept {
+		setpair(s, MAX_A, 0);
+		if (isnan()) setzero();
+		return *this;
+	}
+	// the fractional parts of b*log2(3) in increasing order, generated on first use
+	struct FractionalPart {
+		double  fraction;
+		int64_t b;
+	};
+	static const std::vector<FractionalPart>& fractionalParts() {
+		static const std::vector<FractionalPart> table = [] {
+			std::vector<FractionalPart> parts(static_cast<size_t>(MAX_B) + 1);
+			for (size_t b = 0; b < parts.size(); ++b) {
+				double x = static_cast<double>(b) * log2of3;
+				parts[b] = { x - std::floor(x), static_cast<int64_t>(b) };
+			}
+			std::sort(parts.begin(), parts.end(), [](const FractionalPart& l, const FractionalPart& r) { return l.fraction < r.fraction; });
+			return parts;
+		}();
+		return table;
+	}
+
+	// Gaussian logarithms: log2(1 + 2^delta) and log2|1 - 2^delta|
+	static double sb(double delta) noexcept {
+		return (delta > 0.0 ? delta : 0.0) + std::log1p(std::exp2(-std::abs(delta))) / 0.69314718055994530942;
+	}
+	static double db(double delta) noexcept {
+		return (delta > 0.0 ? delta : 0.0) + std::log2(-std::expm1(-std::abs(delta) * 0.69314718055994530942));
+	}
+	// tables of the Gaussian logarithms indexed by the differences of the exponent pairs, generated on first use
+	static std::vector<double> gaussianTable(bool addition) {
+		constexpr int64_t rows = 2 * static_cast<int64_t>(MAX_A) + 1;
+		constexpr int64_t cols = 2 * static_cast<int64_t>(MAX_B) + 1;
+		std::vector<double> table(static_cast<size_t>(rows * cols));
+		for (int64_t da = -static_cast<int64_t>(MAX_A); da <= static_cast<int64_t>(MAX_A); ++da) {
+			for (int64_t db = -static_cast<int64_t>(MAX_B); db <= static_cast<int64_t>(MAX_B); ++db) {
+				double delta = static_cast<double>(db) * log2of3 - static_cast<double>(da);
+				size_t index = static_cast<size_t>((da + static_cast<int64_t>(MAX_A)) * cols + (db + static_cast<int64_t>(MAX_B)));
+				table[index] = (addition ? sb(delta) : (da == 0 && db == 0 ? 0.0 : dbns::db(delta)));
+			}
+		}
+		return table;
+	}
+	static const std::vector<double>& additionTable() {
+		static const std::vector<double> table = gaussianTable(true);
+		return table;
+	}
+	static const std::vector<double>& subtractionTable() {
+		static const std::vector<double> table = gaussianTable(false);
+		return table;
+	}
+	// table of 3^b for all second base exponents
+	template<typename Real>
+	static const std::vector<Real>& powersOfThree() {
+		static const std::vector<Real> table = [] {
+			std::vector<Real> powers(static_cast<size_t>(MAX_B) + 1);
+			for (size_t b = 0; b < powers.size(); ++b) powers[b] = std::pow(Real(3.0f), static_cast<Real>(b));
+			return powers;
+		}();
+		return table;
+	}
+
 	//////////////////////////////////////////////////////
 	/// convertion routines to native types
 
@@ -817,7 +851,7 @@ protected:
 		return UnsignedInt(to_ieee754<double>());
 	}
 	template<typename TargetFloat>
-	CONSTEXPRESSION TargetFloat to_ieee754() const noexcept {   // TODO: don't use bit math, use proper limb math to speed this up
+	CONSTEXPRESSION TargetFloat to_ieee754() const noexcept {
 		// special case handling
 		if (isnan()) return TargetFloat(NAN);
 		if (iszero()) return TargetFloat(0.0f);
@@ -827,6 +861,13 @@ protected:
 		constexpr unsigned minSubnormalExponent = static_cast<unsigned>(-ieee754_parameter<TargetFloat>::minSubnormalExp);
 		static_assert(fbbits <= minSubnormalExponent, "dbns::to_ieee754: fraction is too small to represent with requested floating-point type");
 
+		if constexpr (hasPowerTable) {
+			if (!std::is_constant_evaluated()) {
+				// 0.5^a * 3^b is an exact scaling of the tabulated 3^b
+				TargetFloat value = std::ldexp(powersOfThree<TargetFloat>()[extractExponent(1)], -static_cast<int>(extractExponent(0)));
+				return (signValue < 0 ? -value : value);
+			}
+		}
 		TargetFloat dim1, dim2;
 		dim1 = ipow(TargetFloat(base0), extractExponent(0));
 		dim2 = ipow(TargetFloat(base1), extractExponent(1));
@@ -16,7 +16,7 @@ namespace sw { namespace universal {
 // TODO: needs SFINAE
 template<typename DfloatConfiguration>
 std::string dfloat_range() {
-	constexpr unsigned ndigits = DfloatConfiguration::nbits;
+	constexpr unsigned ndigits = DfloatConfiguration::ndigits;
 	constexpr unsigned es = DfloatConfiguration::es;
 	using BlockType = typename DfloatConfiguration::BlockType;
 
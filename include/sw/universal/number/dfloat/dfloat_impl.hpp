@@ -6,14 +6,19 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
-#include <regex>
+#include <limits>
+#include <type_traits>
 
 // supporting types and functions
 #include <universal/native/ieee754.hpp>
+#include <universal/internal/uint128/uint128.hpp>
 #include <universal/number/shared/nan_encoding.hpp>
 #include <universal/number/shared/infinite_encoding.hpp>
 #include <universal/number/shared/specific_value_encoding.hpp>
@@ -22,21 +27,61 @@
 
 namespace sw { namespace universal {
 
-// dfloat is an fixed size, arbitrary configuration decimal floating-point type
+namespace internal {
+	// 10^e, for e <= 19
+	constexpr uint64_t decimal_power(unsigned e) noexcept {
+		uint64_t p = 1;
+		for (unsigned i = 0; i < e; ++i) p *= 10u;
+		return p;
+	}
+	// number of bits needed to represent v
+	constexpr unsigned binary_width(uint64_t v) noexcept {
+		unsigned w = 0;
+		while (v != 0) { ++w; v >>= 1; }
+		return w;
+	}
+} // namespace internal
+
+/*
+ * dfloat is a fixed size, arbitrary configuration decimal floating-point type.
+ * dfloat<ndigits, es> spends one digit on the leading significand digit, es digits on the exponent, and
+ * fdigits = ndigits - 1 - es digits on the fraction: value = (-1)^s * d.dd...d * 10^e with -emax <= e <= emax
+ * and emax = 10^es - 1. The smallest exponent also holds the subnormals 0.dd...d * 10^-emax.
+ * Results are rounded to nearest, ties to even, and magnitudes beyond maxpos round to infinity.
+ *
+ * The encoding is binary integer decimal: from least to most significant, the significand as a binary integer,
+ * the biased exponent, and the sign. The all-ones exponent field encodes infinity (significand 0) and NaN.
+ * Results are kept canonical, with a significand of fdigits + 1 digits unless the exponent is minimal,
+ * so equal values have equal encodings, except for +0 and -0.
+ */
 template<unsigned _ndigits, unsigned _es, typename bt = std::uint8_t> 
 class dfloat {
 public:
+	static_assert(_es >= 1 && _es <= 9, "dfloat: the exponent must have 1 to 9 digits");
+	static_assert(_ndigits > _es && _ndigits - _es <= 18, "dfloat: the significand must have 1 to 18 digits");
 	static constexpr unsigned ndigits = _ndigits;
 	static constexpr unsigned es = _es;
 	static constexpr unsigned fdigits = ndigits - 1u - es; // number of fraction digits
+	static constexpr unsigned precision = fdigits + 1u;    // number of significand digits
+
+	static constexpr int64_t  emax = int64_t(internal::decimal_power(es)) - 1;
+	static constexpr int64_t  qmin = -emax - int64_t(fdigits);  // exponent of the last significand digit of minpos
+	static constexpr int64_t  qmax =  emax - int64_t(fdigits);  // exponent of the last significand digit of maxpos
+	static constexpr uint64_t SIGNIFICAND_LIMIT  = internal::decimal_power(precision);
+	static constexpr uint64_t SIGNIFICAND_NORMAL = internal::decimal_power(fdigits);
+
+	static constexpr unsigned sbits = internal::binary_width(SIGNIFICAND_LIMIT - 1u);   // significand field
+	static constexpr unsigned ebits = internal::binary_width(uint64_t(2 * emax + 1));  // exponent field, with room for the all-ones pattern
+	static constexpr unsigned nbits = 1u + ebits + sbits;
+	static constexpr uint64_t EXPONENT_SPECIAL = (uint64_t(1) << ebits) - 1u;
 	typedef bt BlockType;
 
 	static constexpr unsigned bitsInByte = 8u;
 	static constexpr unsigned bitsInBlock = sizeof(bt) * bitsInByte;
-	static constexpr unsigned nrBlocks = 1u + ((ndigits - 1u) / bitsInBlock);
+	static constexpr unsigned nrBlocks = 1u + ((nbits - 1u) / bitsInBlock);
 	static constexpr unsigned MSU = nrBlocks - 1u; // MSU == Most Significant Unit, as MSB is already taken
 	static constexpr bt       ALL_ONES = bt(~0); // block type specific all 1's value
-	static constexpr bt       MSU_MASK = (ALL_ONES >> (nrBlocks * bitsInBlock - ndigits));
+	static constexpr bt       MSU_MASK = (ALL_ONES >> (nrBlocks * bitsInBlock - nbits));
 
 	static constexpr uint64_t storageMask = (0xFFFFFFFFFFFFFFFFull >> (64u - bitsInBlock));
 	static constexpr bt       BLOCK_MASK = bt(~0);
@@ -51,7 +96,7 @@ public:
 	dfloat& operator=(dfloat&&) = default;
 
 	// converting constructors
-	constexpr dfloat(const std::string& stringRep) : _block{} { assign(stringRep); }
+	dfloat(const std::string& stringRep) : _block{} { assign(stringRep); }
 
 	// specific value constructor
 	constexpr dfloat(const SpecificValue code) noexcept : _block{} {
@@ -108,7 +153,7 @@ public:
 	dfloat& operator=(int rhs)                noexcept { return convert_signed(rhs); }
 	dfloat& operator=(long rhs)               noexcept { return convert_signed(rhs); }
 	dfloat& operator=(long long rhs)          noexcept { return convert_signed(rhs); }
-	dfloat& operator=(char rhs)               noexcept { return convert_unsigned(rhs); }
+	dfloat& operator=(char rhs)               noexcept { return convert_unsigned(static_cast<unsigned char>(rhs)); }
 	dfloat& operator=(unsigned short rhs)     noexcept { return convert_unsigned(rhs); }
 	dfloat& operator=(unsigned int rhs)       noexcept { return convert_unsigned(rhs); }
 	dfloat& operator=(unsigned long rhs)      noexcept { return convert_unsigned(rhs); }
@@ -117,38 +162,94 @@ public:
 	dfloat& operator=(double rhs)             noexcept { return convert_ieee754(rhs); }
 
 	// conversion operators
-	explicit operator float()           const noexcept { return float(convert_to_ieee754()); }
-	explicit operator double()          const noexcept { return convert_to_ieee754(); }
+	explicit operator float()           const noexcept { return convert_to_ieee754<float>(); }
+	explicit operator double()          const noexcept { return convert_to_ieee754<double>(); }
 
 
 #if LONG_DOUBLE_SUPPORT
 	explicit dfloat(long double iv)           noexcept { *this = iv; }
 	dfloat& operator=(long double rhs)        noexcept { return convert_ieee754(rhs); }
-	explicit operator long double()     const noexcept { return convert_to_ieee754(); }
+	explicit operator long double()     const noexcept { return convert_to_ieee754<long double>(); }
 #endif
 
 	// prefix operators
 	dfloat operator-() const {
 		dfloat negated(*this);
+		if (!isnan()) negated.setsign(!sign());
 		return negated;
 	}
 
 	// arithmetic operators
-	dfloat& operator+=(const dfloat& rhs) {
-		return *this;
+	dfloat& operator+=(const dfloat& rhs) DFLOAT_EXCEPT {
+		if (nan_operands(rhs)) return *this;
+		if (isinf()) {
+			if (rhs.isinf() && sign() != rhs.sign()) setnan(NAN_TYPE_QUIET);  // inf - inf
+			return *this;
+		}
+		if (rhs.isinf()) return *this = rhs;
+		return add(sign(), significand(), exponent(), rhs.sign(), rhs.significand(), rhs.exponent());
 	}
-	dfloat& operator-=(const dfloat& rhs) {
-		return *this;
+	dfloat& operator-=(const dfloat& rhs) DFLOAT_EXCEPT {
+		return *this += -rhs;
 	}
-	dfloat& operator*=(const dfloat& rhs) {
-		return *this;
+	dfloat& operator*=(const dfloat& rhs) DFLOAT_EXCEPT {
+		if (nan_operands(rhs)) return *this;
+		bool negative = (sign() != rhs.sign());
+		if (isinf() || rhs.isinf()) {
+			if (iszero() || rhs.iszero()) setnan(NAN_TYPE_QUIET);  // 0 * inf
+			else setinf(negative);
+			return *this;
+		}
+		if (iszero() || rhs.iszero()) return zero(negative);
+		// the product of two significands of at most 18 digits is exact in 128 bits
+		return round(negative, internal::umul128(significand(), rhs.significand()), exponent() + rhs.exponent());
 	}
-	dfloat& operator/=(const dfloat& rhs) {
-		return *this;
+	dfloat& operator/=(const dfloat& rhs) DFLOAT_EXCEPT {
+		if (nan_operands(rhs)) return *this;
+		bool negative = (sign() != rhs.sign());
+		if (isinf()) {
+			if (rhs.isinf()) setnan(NAN_TYPE_QUIET);  // inf / inf
+			else setinf(negative);
+			return *this;
+		}
+		if (rhs.isinf()) return zero(negative);
+		if (rhs.iszero()) {
+#if DFLOAT_THROW_ARITHMETIC_EXCEPTION
+			throw dfloat_divide_by_zero{};
+#else
+			if (iszero()) setnan(NAN_TYPE_QUIET); else setinf(negative);
+			return *this;
+#endif
+		}
+		if (iszero()) return zero(negative);
+		// scale the dividend so that the quotient has precision + 1 or precision + 2 digits, the remainder is sticky
+		uint64_t a = significand(), b = rhs.significand();
+		unsigned k = precision + 1u + digits(b) - digits(a);
+		internal::uint128 q = scale_up(internal::uint128{ 0, a }, k);
+		uint64_t remainder = divide(q, b);
+		return round(negative, q, exponent() - rhs.exponent() - int64_t(k), remainder != 0);
 	}
 
-	// unary operators
+	// unary operators: step to the next encoding towards +inf (++) or -inf (--)
 	dfloat& operator++() {
+		if (isnan()) return *this;
+		if (isinf()) {
+			if (sign()) maxneg();
+			return *this;
+		}
+		if (iszero()) return minpos();
+		bool s = sign();
+		uint64_t m = significand();
+		int64_t q = exponent();
+		if (!s) {  // away from zero
+			if (++m == SIGNIFICAND_LIMIT) { m = SIGNIFICAND_NORMAL; ++q; }
+			if (q > qmax) { setinf(false); return *this; }
+		}
+		else {     // towards zero
+			if (m == SIGNIFICAND_NORMAL && q > qmin) { m = SIGNIFICAND_LIMIT - 1u; --q; }
+			else --m;
+		}
+		encode(s, q, m);
 		return *this;
 	}
 	dfloat operator++(int) {
@@ -157,6 +258,9 @@ public:
 		return tmp;
 	}
 	dfloat& operator--() {
+		*this = -*this;
+		operator++();
+		*this = -*this;
 		return *this;
 	}
 	dfloat operator--(int) {
@@ -166,155 +270,361 @@ public:
 	}
 
 	// modifiers
-	void clear()                                         noexcept {  }
-	void setzero()                                       noexcept { clear(); }
-	void setinf(bool sign = true)                        noexcept { }
-	void setnan(int NaNType = NAN_TYPE_SIGNALLING)       noexcept { }
-	void setsign(bool sign = true)                       noexcept { }
-	void setexponent(const std::string& expDigits)       noexcept { }
-	void setfraction(const std::string& fracDigits)      noexcept { }
-	// use un-interpreted raw bits to set the value of the dfloat
-	inline void setbits(uint64_t value) {
-		clear();
+	constexpr void clear()                               noexcept { for (unsigned i = 0; i < nrBlocks; ++i) _block[i] = bt(0); }
+	constexpr void setzero()                             noexcept { clear(); }
+	constexpr void setinf(bool sign = true)              noexcept { encode_fields(sign, EXPONENT_SPECIAL, 0); }
+	constexpr void setnan(int NaNType = NAN_TYPE_SIGNALLING) noexcept { encode_fields(NaNType == NAN_TYPE_SIGNALLING, EXPONENT_SPECIAL, 1); }
+	constexpr void setsign(bool sign = true)             noexcept { encode_fields(sign, exponent_field(), significand()); }
+	// use un-interpreted raw bits to set the value of the dfloat: the pattern is taken as is,
+	// so a significand of 10^precision or more, or one that is not normalized, is not canonical
+	constexpr void setbits(uint64_t value) noexcept {
+		setraw(internal::uint128{ 0, value });
 	}
 	
 	// create specific number system values of interest
 	constexpr dfloat& maxpos() noexcept {
-		// maxpos is represented by the pattern 9.999e99
+		// maxpos is represented by the pattern 9.99...9e+emax
+		encode(false, qmax, SIGNIFICAND_LIMIT - 1u);
 		return *this;
 	}
 	constexpr dfloat& minpos() noexcept {
-		// minpos is represented by the pattern 0.0001e-99
+		// minpos is represented by the pattern 0.00...1e-emax
+		encode(false, qmin, 1u);
 		return *this;
 	}
-	constexpr dfloat& zero() noexcept {
+	constexpr dfloat& zero(bool negative = false) noexcept {
 		// the zero value
-		clear();
+		encode(negative, qmin, 0u);
 		return *this;
 	}
 	constexpr dfloat& minneg() noexcept {
-		// minneg is represented by the pattern -0.0001e-99
+		// minneg is represented by the pattern -0.00...1e-emax
+		encode(true, qmin, 1u);
 		return *this;
 	}
 	constexpr dfloat& maxneg() noexcept {
-		// maxneg is represented by the pattern -9.999e99
+		// maxneg is represented by the pattern -9.99...9e+emax
+		encode(true, qmax, SIGNIFICAND_LIMIT - 1u);
 		return *this;
 	}
 
+	// assign a decimal string, NaN when the string is not a number
 	dfloat& assign(const std::string& txt) {
+		if (!parse(txt)) setnan(NAN_TYPE_QUIET);
 		return *this;
 	}
 
-	// selectors
-	constexpr bool iszero() const noexcept { return false; }
-	constexpr bool isone()  const noexcept { return true; }
-	constexpr bool ispos()  const noexcept { return false; }
-	constexpr bool isneg()  const noexcept { return false; }
-	constexpr int  scale()  const noexcept { return 0; }
-
-	// convert to string containing digits number of digits
-	std::string str(size_t nrDigits = 0) const {
-		if (iszero()) return std::string("0.0");
-
-		int64_t magnitude = scale();
-		if (magnitude > 1 || magnitude < 0) {
-			// use scientific notation for non-trivial exponent values
-			return std::string("TBD");
+	// parse [+-]digits[.digits][e[+-]digits], inf, or nan, returns false when txt is not a number
+	bool parse(const std::string& txt) {
+		size_t i = 0, n = txt.size();
+		bool negative = false;
+		if (i < n && (txt[i] == '+' || txt[i] == '-')) negative = (txt[i++] == '-');
+		std::string rest = txt.substr(i);
+		for (auto& c : rest) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		if (rest == "inf" || rest == "infinity") { setinf(negative); return true; }
+		if (rest == "nan") { setnan(NAN_TYPE_QUIET); return true; }
+		// the first 37 significant digits are exact in 128 bits, the others are sticky
+		internal::uint128 m{ 0, 0 };
+		unsigned kept = 0;
+		int64_t q = 0;
+		bool sticky = false, anyDigit = false, fraction = false;
+		for (; i < n; ++i) {
+			char c = txt[i];
+			if (c == '.' && !fraction) { fraction = true; continue; }
+			if (c < '0' || c > '9') break;
+			anyDigit = true;
+			unsigned d = unsigned(c - '0');
+			if (kept < 37) {
+				if (kept > 0 || d != 0) {
+					m = multiply(m, 10u);
+					m.lower += d;
+					m.upper += (m.lower < d ? 1u : 0u);
+					++kept;
+				}
+				if (fraction) --q;
+			}
+			else {
+				if (d != 0) sticky = true;
+				if (!fraction) ++q;
+			}
 		}
-
-		std::string str;
-		int64_t exponent = trimmed(nrDigits, str);
-
-		if (magnitude == 0) {
-			if (isneg())
-				return std::string("-0.0") + str;
-			else
-				return std::string("0.0") + str;
+		if (!anyDigit) return false;
+		if (i < n && (txt[i] == 'e' || txt[i] == 'E')) {
+			++i;
+			bool negativeExponent = false;
+			if (i < n && (txt[i] == '+' || txt[i] == '-')) negativeExponent = (txt[i++] == '-');
+			if (i == n) return false;
+			int64_t e = 0;
+			for (; i < n && txt[i] >= '0' && txt[i] <= '9'; ++i) {
+				if (e < 1'000'000'000'000ll) e = 10 * e + (txt[i] - '0');  // far beyond any exponent range
+			}
+			q += (negativeExponent ? -e : e);
 		}
+		if (i != n) return false;
+		round(negative, m, q, sticky);
+		return true;
+	}
 
-		std::string before_decimal = "TBD";
-
-		if (exponent >= 0) {
-			if (isneg())
-				return std::string("-") + before_decimal + ".0";
-			else
-				return before_decimal + ".0";
-		}
+	// selectors
+	constexpr bool sign()   const noexcept { return (fields() >> ebits) & 1u; }
+	constexpr bool iszero() const noexcept { return exponent_field() != EXPONENT_SPECIAL && significand() == 0; }
+	constexpr bool isone()  const noexcept { return !sign() && significand() == SIGNIFICAND_NORMAL && exponent() == -int64_t(fdigits); }
+	constexpr bool ispos()  const noexcept { return !sign(); }
+	constexpr bool isneg()  const noexcept { return sign(); }
+	constexpr bool isinf(int InfType = INF_TYPE_EITHER) const noexcept {
+		if (exponent_field() != EXPONENT_SPECIAL || significand() != 0) return false;
+		return (InfType == INF_TYPE_EITHER) || (InfType == INF_TYPE_NEGATIVE && sign()) || (InfType == INF_TYPE_POSITIVE && !sign());
+	}
+	constexpr bool isnan(int NaNType = NAN_TYPE_EITHER) const noexcept {
+		if (exponent_field() != EXPONENT_SPECIAL || significand() == 0) return false;
+		return (NaNType == NAN_TYPE_EITHER) || (NaNType == NAN_TYPE_SIGNALLING && sign()) || (NaNType == NAN_TYPE_QUIET && !sign());
+	}
+	// the significand as an integer and the exponent of its last digit: value = significand * 10^exponent
+	constexpr uint64_t significand() const noexcept { return raw().lower & ((uint64_t(1) << sbits) - 1u); }
+	constexpr int64_t  exponent()    const noexcept { return int64_t(exponent_field()) + qmin; }
+	// decimal exponent of the leading digit
+	constexpr int      scale()       const noexcept {
+		uint64_t m = significand();
+		return (m == 0 || exponent_field() == EXPONENT_SPECIAL) ? 0 : int(exponent() + int64_t(digits(m)) - 1);
+	}
 
-		// now the digits after the radix point
-		std::string after_decimal = str.substr((size_t)(str.size() + exponent), (size_t)-exponent);
-		std::string final;
-		if (isneg()) {
-			final = std::string("-") + before_decimal + "." + after_decimal;
-		}
-		else {
-			final = before_decimal + "." + after_decimal;
+	// convert to a string in scientific notation with at most nrDigits significant digits, 0 selects all digits
+	std::string str(size_t nrDigits = 0) const {
+		if (isnan()) return std::string("nan");
+		if (isinf()) return std::string(sign() ? "-inf" : "inf");
+		std::string sgn = (sign() ? "-" : "");
+		if (iszero()) return sgn + "0.0";
+
+		std::string d = std::to_string(significand());
+		int64_t e = exponent() + int64_t(d.size()) - 1;
+		if (nrDigits > 0 && nrDigits < d.size()) {
+			// round half to even on the digits
+			char roundDigit = d[nrDigits];
+			bool sticky = d.find_first_not_of('0', nrDigits + 1) != std::string::npos;
+			d.resize(nrDigits);
+			bool odd = ((d.back() - '0') & 1) != 0;
+			if (roundDigit > '5' || (roundDigit == '5' && (sticky || odd))) {
+				size_t k = d.size();
+				while (k > 0 && d[k - 1] == '9') d[--k] = '0';
+				if (k == 0) { d.insert(d.begin(), '1'); d.pop_back(); ++e; }
+				else ++d[k - 1];
+			}
 		}
-		return final;
+		size_t last = d.find_last_not_of('0');
+		d.resize(last + 1);
+		std::string fractionDigits = (d.size() > 1 ? d.substr(1) : std::string("0"));
+		std::string exp = std::to_string(e < 0 ? -e : e);
+		if (exp.size() < 2) exp.insert(exp.begin(), '0');
+		return sgn + d.substr(0, 1) + "." + fractionDigits + (e < 0 ? "e-" : "e+") + exp;
 	}
 
 protected:
-	bt _block[nrBlocks];   // do we want to pack the digits: two per byte?
+	bt _block[nrBlocks];
 
 	// HELPER methods
 
-	// convert to native floating-point
-	template<typename Real>
-	Real convert_to_ieee754() const {
-		Real ld = 0;
-		return ld;
+	// the encoding as a 128-bit integer, nbits <= 1 + 31 + 60
+	constexpr internal::uint128 raw() const noexcept {
+		internal::uint128 r{ 0, 0 };
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			unsigned pos = i * bitsInBlock;
+			uint64_t b = uint64_t(_block[i]);
+			if (pos < 64u) {
+				r.lower |= (b << pos);
+				if (pos > 0 && pos + bitsInBlock > 64u) r.upper |= (b >> (64u - pos));
+			}
+			else {
+				r.upper |= (b << (pos - 64u));
+			}
+		}
+		return r;
+	}
+	constexpr void setraw(internal::uint128 r) noexcept {
+		for (unsigned i = 0; i < nrBlocks; ++i) {
+			unsigned pos = i * bitsInBlock;
+			uint64_t b = 0;
+			if (pos < 64u) {
+				b = (r.lower >> pos);
+				if (pos > 0) b |= (r.upper << (64u - pos));
+			}
+			else {
+				b = (r.upper >> (pos - 64u));
+			}
+			_block[i] = bt(b & storageMask);
+		}
+		_block[MSU] &= MSU_MASK;
+	}
+	// the exponent and sign fields, shifted down to bit 0
+	constexpr uint64_t fields() const noexcept {
+		internal::uint128 r = raw();
+		return (r.lower >> sbits) | (r.upper << (64u - sbits));
+	}
+	constexpr uint64_t exponent_field() const noexcept { return fields() & EXPONENT_SPECIAL; }
+	constexpr void encode_fields(bool sign, uint64_t exponentField, uint64_t significandField) noexcept {
+		uint64_t upperFields = (uint64_t(sign) << ebits) | exponentField;
+		setraw(internal::uint128{ upperFields >> (64u - sbits), significandField | (upperFields << sbits) });
+	}
+	// encode a canonical value significand * 10^q
+	constexpr void encode(bool sign, int64_t q, uint64_t significand) noexcept {
+		encode_fields(sign, uint64_t(q - qmin), significand);
 	}
 
-	dfloat& convert_signed(int64_t v) {
-		if (0 == v) {
-			setzero();
+	// 128-bit decimal support
+	static constexpr unsigned digits(uint64_t v) noexcept {
+		unsigned n = 1;
+		while (v >= 10u) { v /= 10u; ++n; }
+		return n;
+	}
+	static constexpr bool fits(const internal::uint128& v, uint64_t limit) noexcept { return v.upper == 0 && v.lower < limit; }
+	static constexpr bool less(const internal::uint128& a, const internal::uint128& b) noexcept {
+		return a.upper < b.upper || (a.upper == b.upper && a.lower < b.lower);
+	}
+	static constexpr internal::uint128 sum(const internal::uint128& a, const internal::uint128& b) noexcept {
+		internal::uint128 s{ a.upper + b.upper, a.lower + b.lower };
+		if (s.lower < a.lower) ++s.upper;
+		return s;
+	}
+	static constexpr internal::uint128 difference(const internal::uint128& a, const internal::uint128& b) noexcept {
+		internal::uint128 d{ a.upper - b.upper, a.lower - b.lower };
+		if (a.lower < b.lower) --d.upper;
+		return d;
+	}
+	// v * m, the product must fit in 128 bits
+	static constexpr internal::uint128 multiply(const internal::uint128& v, uint64_t m) noexcept {
+		internal::uint128 p = internal::umul128(v.lower, m);
+		p.upper += v.upper * m;
+		return p;
+	}
+	static constexpr internal::uint128 scale_up(internal::uint128 v, unsigned k) noexcept {
+		for (; k > 18u; k -= 18u) v = multiply(v, internal::decimal_power(18u));
+		return multiply(v, internal::decimal_power(k));
+	}
+	// v /= d, returns the remainder
+	static constexpr uint64_t divide(internal::uint128& v, uint64_t d) noexcept {
+		uint64_t upper = v.upper / d;
+		uint64_t remainder = 0;
+		uint64_t lower = internal::udiv128(internal::uint128{ v.upper % d, v.lower }, d, remainder);
+		v = internal::uint128{ upper, lower };
+		return remainder;
+	}
+
+	// round m * 10^q to the nearest dfloat, ties to even: sticky marks nonzero digits below the last digit of m
+	constexpr dfloat& round(bool negative, internal::uint128 m, int64_t q, bool sticky = false) noexcept {
+		if (m.upper == 0 && m.lower == 0 && !sticky) return zero(negative);
+		// exact values with few digits move to the canonical, normalized cohort member
+		if (!sticky) {
+			while (fits(m, SIGNIFICAND_NORMAL) && q > qmin) {
+				m = multiply(m, 10u);
+				--q;
+			}
+		}
+		// drop the digits beyond the precision, and below the subnormal exponent
+		unsigned roundDigit = 0;
+		while (!fits(m, SIGNIFICAND_LIMIT) || q < qmin) {
+			sticky = sticky || (roundDigit != 0);
+			roundDigit = unsigned(divide(m, 10u));
+			++q;
+			if (m.upper == 0 && m.lower == 0 && q < qmin) {  // all further digits are zero
+				sticky = sticky || (roundDigit != 0);
+				roundDigit = 0;
+				q = qmin;
+			}
 		}
-		else {
-			// convert 
+		uint64_t s = m.lower;
+		if (roundDigit > 5u || (roundDigit == 5u && (sticky || (s & 1u)))) {
+			if (++s == SIGNIFICAND_LIMIT) {
+				s = SIGNIFICAND_NORMAL;
+				++q;
+			}
 		}
+		if (q > qmax) {
+			setinf(negative);
+			return *this;
+		}
+		if (s == 0) return zero(negative);
+		encode(negative, q, s);
 		return *this;
 	}
 
-	 dfloat& convert_unsigned(uint64_t v) {
-		if (0 == v) {
-			setzero();
+	// the sum of (-1)^sa * a * 10^qa and (-1)^sb * b * 10^qb
+	constexpr dfloat& add(bool sa, uint64_t a, int64_t qa, bool sb, uint64_t b, int64_t qb) noexcept {
+		if (a == 0 && b == 0) return zero(sa && sb);
+		if (b == 0) { encode(sa, qa, a); return *this; }
+		if (a == 0) { encode(sb, qb, b); return *this; }
+		if (qa < qb) {
+			std::swap(sa, sb); std::swap(a, b); std::swap(qa, qb);
 		}
-		else {
-			// convert 
+		// align a to at most precision + 1 digits below its last digit, the digits of b beyond that are sticky
+		int64_t shift = qa - qb;
+		unsigned k = unsigned(shift < int64_t(precision) + 1 ? shift : int64_t(precision) + 1);
+		internal::uint128 x = scale_up(internal::uint128{ 0, a }, k);
+		internal::uint128 y{ 0, b };
+		bool sticky = false;
+		for (int64_t i = k; i < shift && (y.upper != 0 || y.lower != 0); ++i) {
+			if (divide(y, 10u) != 0) sticky = true;
 		}
-		return *this;
+		int64_t q = qa - int64_t(k);
+		if (sa == sb) return round(sa, sum(x, y), q, sticky);
+		if (less(x, y)) return round(sb, difference(y, x), q, sticky);  // no digits of b were dropped
+		internal::uint128 d = difference(x, y);
+		if (d.upper == 0 && d.lower == 0) return zero(false);
+		// x - (y + f) with 0 < f < 1 is (x - y - 1) + (1 - f)
+		if (sticky) d = difference(d, internal::uint128{ 0, 1 });
+		return round(sa, d, q, sticky);
 	}
 
-	template<typename Ty>
-	dfloat& convert_ieee754(Ty& rhs) {
-		clear();
-		long long base = (long long)rhs;
-		*this = base;
-		return *this;
+	// NaN operands propagate: a signalling NaN wins over a quiet NaN
+	constexpr bool nan_operands(const dfloat& rhs) DFLOAT_EXCEPT {
+		if (!isnan() && !rhs.isnan()) return false;
+#if DFLOAT_THROW_ARITHMETIC_EXCEPTION
+		throw dfloat_operand_is_nan{};
+#else
+		setnan((isnan(NAN_TYPE_SIGNALLING) || rhs.isnan(NAN_TYPE_SIGNALLING)) ? NAN_TYPE_SIGNALLING : NAN_TYPE_QUIET);
+		return true;
+#endif
 	}
 
-	// convert to string with nrDigits of significant digits and return the scale
-	// value = str + "10^" + scale
-	int64_t trimmed(size_t nrDigits, std::string& number) const {
+	// convert to native floating-point: the decimal string is correctly rounded by strtod
+	template<typename Real>
+	Real convert_to_ieee754() const noexcept {
+		if (isnan()) return std::numeric_limits<Real>::quiet_NaN();
+		if (isinf()) return (sign() ? -std::numeric_limits<Real>::infinity() : std::numeric_limits<Real>::infinity());
+		if (iszero()) return (sign() ? -Real(0) : Real(0));
+		std::string txt = std::string(sign() ? "-" : "") + std::to_string(significand()) + "e" + std::to_string(exponent());
+		if constexpr (std::is_same_v<Real, float>) return std::strtof(txt.c_str(), nullptr);
+		else if constexpr (std::is_same_v<Real, double>) return std::strtod(txt.c_str(), nullptr);
+		else return static_cast<Real>(std::strtold(txt.c_str(), nullptr));
+	}
+
+	dfloat& convert_signed(int64_t v) noexcept {
+		uint64_t magnitude = (v < 0 ? uint64_t(0) - uint64_t(v) : uint64_t(v));
+		return round(v < 0, internal::uint128{ 0, magnitude }, 0);
+	}
 
-		return 0;
+	dfloat& convert_unsigned(uint64_t v) noexcept {
+		return round(false, internal::uint128{ 0, v }, 0);
 	}
 
+	// 40 significant digits of the binary value: far more than the 19 the rounding looks at
+	template<typename Real>
+	dfloat& convert_ieee754(Real rhs) noexcept {
+		if (std::isnan(rhs)) { setnan(NAN_TYPE_QUIET); return *this; }
+		if (std::isinf(rhs)) { setinf(rhs < 0); return *this; }
+		if (rhs == Real(0)) return zero(std::signbit(rhs));
+		char buffer[64];
+		if constexpr (std::is_same_v<Real, long double>) std::snprintf(buffer, sizeof(buffer), "%.39Le", rhs);
+		else std::snprintf(buffer, sizeof(buffer), "%.39e", double(rhs));
+		parse(buffer);
+		return *this;
+	}
 
 private:
 
 	// dfloat - dfloat logic comparisons
 	template<unsigned N, unsigned E, typename B>
 	friend bool operator==(const dfloat<N, E, B>& lhs, const dfloat<N, E, B>& rhs);
-
-	// dfloat - literal logic comparisons
 	template<unsigned N, unsigned E, typename B>
-	friend bool operator==(const dfloat<N, E, B>& lhs, const double rhs);
-
-	// literal - dfloat logic comparisons
-	template<unsigned N, unsigned E, typename B>
-	friend bool operator==(const double lhs, const dfloat<N, E, B>& rhs);
-
+	friend bool operator< (const dfloat<N, E, B>& lhs, const dfloat<N, E, B>& rhs);
 };
 
 
@@ -323,12 +633,28 @@ private:
 // divide dfloat a and b and return result argument
 template<unsigned ndigits, unsigned es, typename BlockType>
 void divide(const dfloat<ndigits, es, BlockType>& a, const dfloat<ndigits, es, BlockType>& b, dfloat<ndigits, es, BlockType>& quotient) {
+	quotient = a;
+	quotient /= b;
 }
 
+// the fields of the encoding: sign, exponent, significand
 template<unsigned ndigits, unsigned es, typename BlockType>
-inline std::string to_binary(const dfloat<ndigits, es, BlockType>& number) {
+inline std::string to_binary(const dfloat<ndigits, es, BlockType>& number, bool nibbleMarker = false) {
+	using Dfloat = dfloat<ndigits, es, BlockType>;
 	std::stringstream s;
-	s << "to_binary TBD";
+	s << "0b" << (number.sign() ? '1' : '0') << '.';
+	uint64_t exponentField = uint64_t(number.exponent() - Dfloat::qmin);
+	if (number.isinf() || number.isnan()) exponentField = Dfloat::EXPONENT_SPECIAL;
+	for (unsigned i = Dfloat::ebits; i > 0; --i) {
+		s << (((exponentField >> (i - 1)) & 1u) ? '1' : '0');
+		if (nibbleMarker && i > 1 && ((i - 1) % 4) == 0) s << '\'';
+	}
+	s << '.';
+	uint64_t significand = number.significand();
+	for (unsigned i = Dfloat::sbits; i > 0; --i) {
+		s << (((significand >> (i - 1)) & 1u) ? '1' : '0');
+		if (nibbleMarker && i > 1 && ((i - 1) % 4) == 0) s << '\'';
+	}
 	return s.str();
 }
 
@@ -336,7 +662,7 @@ inline std::string to_binary(const dfloat<ndigits, es, BlockType>& number) {
 
 template<unsigned ndigits, unsigned es, typename BlockType>
 inline dfloat<ndigits, es, BlockType> abs(const dfloat<ndigits, es, BlockType>& a) {
-	return a; // (a < 0 ? -a : a);
+	return (a.isneg() ? -a : a);
 }
 
 
@@ -355,7 +681,7 @@ inline std::ostream& operator<<(std::ostream& ostr, const dfloat<ndigits, es, Bl
 	std::ios_base::fmtflags ff;
 	ff = ostr.flags();
 	ss.flags(ff);
-	ss << std::setw(width) << std::setprecision(prec) << i.str(size_t(prec));
+	ss << std::setw(width) << i.str(size_t(prec));
 
 	return ostr << ss.str();
 }
@@ -366,7 +692,7 @@ inline std::istream& operator>>(std::istream& istr, dfloat<ndigits, es, BlockTyp
 	std::string txt;
 	istr >> txt;
 	if (!parse(txt, p)) {
-		std::cerr << "unable to parse -" << txt << "- into a posit value\n";
+		std::cerr << "unable to parse -" << txt << "- into a dfloat value\n";
 	}
 	return istr;
 }
@@ -376,18 +702,21 @@ inline std::istream& operator>>(std::istream& istr, dfloat<ndigits, es, BlockTyp
 // read a dfloat ASCII format and make a dfloat out of it
 template<unsigned ndigits, unsigned es, typename BlockType>
 bool parse(const std::string& number, dfloat<ndigits, es, BlockType>& value) {
-	bool bSuccess = false;
-
-	return bSuccess;
+	return value.parse(number);
 }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // dfloat - dfloat binary logic operators
 
-// equal: precondition is that the storage is properly nulled in all arithmetic paths
+// equal: the encodings are canonical, so only NaN and the signed zeros need care
 template<unsigned ndigits, unsigned es, typename BlockType>
 inline bool operator==(const dfloat<ndigits, es, BlockType>& lhs, const dfloat<ndigits, es, BlockType>& rhs) {
+	if (lhs.isnan() || rhs.isnan()) return false;
+	if (lhs.iszero() && rhs.iszero()) return true;
+	for (unsigned i = 0; i < dfloat<ndigits, es, BlockType>::nrBlocks; ++i) {
+		if (lhs._block[i] != rhs._block[i]) return false;
+	}
 	return true;
 }
 
@@ -396,9 +725,17 @@ inline bool operator!=(const dfloat<ndigits, es, BlockType>& lhs, const dfloat<n
 	return !operator==(lhs, rhs);
 }
 
+// less: magnitudes order as (exponent field, significand), infinity included
 template<unsigned ndigits, unsigned es, typename BlockType>
 inline bool operator< (const dfloat<ndigits, es, BlockType>& lhs, const dfloat<ndigits, es, BlockType>& rhs) {
-	return false; // lhs and rhs are the same
+	if (lhs.isnan() || rhs.isnan()) return false;
+	if (lhs.iszero()) return !rhs.iszero() && !rhs.sign();
+	if (rhs.iszero()) return lhs.sign();
+	if (lhs.sign() != rhs.sign()) return lhs.sign();
+	uint64_t le = lhs.exponent_field(), re = rhs.exponent_field();
+	bool smaller = (le < re) || (le == re && lhs.significand() < rhs.significand());
+	bool larger  = (le > re) || (le == re && lhs.significand() > rhs.significand());
+	return lhs.sign() ? larger : smaller;
 }
 
 template<unsigned ndigits, unsigned es, typename BlockType>
@@ -413,7 +750,7 @@ inline bool operator<=(const dfloat<ndigits, es, BlockType>& lhs, const dfloat<n
 
 template<unsigned ndigits, unsigned es, typename BlockType>
 inline bool operator>=(const dfloat<ndigits, es, BlockType>& lhs, const dfloat<ndigits, es, BlockType>& rhs) {
-	return !operator< (lhs, rhs);
+	return operator> (lhs, rhs) || operator==(lhs, rhs);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
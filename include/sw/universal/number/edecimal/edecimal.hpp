@@ -16,8 +16,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////
 /// required std libraries 
+#include <bit>
 #include <cstdint>
 #include <cassert>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
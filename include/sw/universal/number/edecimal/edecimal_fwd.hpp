@@ -12,9 +12,10 @@ namespace sw { namespace universal {
 
 	struct edecintdiv;
 
-	edecimal quotient(const edecimal&, const edecimal&);
-	edecimal remainder(const edecimal&, const edecimal&);
+	inline edecimal quotient(const edecimal&, const edecimal&);
+	inline edecimal remainder(const edecimal&, const edecimal&);
 
-	int findMsd(const edecimal&);
+	inline int findMsd(const edecimal&);
+	inline edecimal gcd(const edecimal&, const edecimal&);
 
 }} // namespace sw::universal
@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/internal/uint128/uint128.hpp>
 
 // ALPHA feature: occurrence is NOT an official API for any of the Universal number systems
 #if !defined(EDECIMAL_OPERATIONS_COUNT)
@@ -19,13 +20,19 @@ namespace sw { namespace universal {
 /// <summary>
 /// Adaptive precision decimal integer number type
 /// </summary>
-/// The digits are managed as a vector with the digit for 10^0 stored at index 0, 10^1 stored at index 1, etc.
-class edecimal : public std::vector<uint8_t> {
+/// The magnitude is managed as a vector of limbs in radix 10^19 with the limb for (10^19)^0 stored at index 0,
+/// (10^19)^1 stored at index 1, etc. Each uint64_t limb holds 19 decimal digits, so the arithmetic works on
+/// words while the decimal string conversions remain exact. The limbs are private: individual decimal
+/// digits are read through digit(i) and digits(), and written through parse() and setdigit().
+class edecimal {
 #if EDECIMAL_OPERATIONS_COUNT
 	static bool enableAdd;
 	static occurrence<edecimal> ops;
 #endif
 public:
+	static constexpr uint64_t RADIX           = 10'000'000'000'000'000'000ull;  // largest power of 10 in a uint64_t
+	static constexpr unsigned DIGITS_PER_LIMB = 19;
+
 	edecimal() { setzero(); }
 
 	edecimal(const edecimal&) = default;
@@ -74,90 +81,23 @@ public:
 
 	// arithmetic operators
 	edecimal& operator+=(const edecimal& rhs) {
-		edecimal _rhs(rhs);   // is this copy necessary? I introduced it to have a place to pad
-		if (negative != rhs.negative) {  // different signs
-			_rhs.setsign(!rhs.sign());
-			return operator-=(_rhs);
+		if (negative == rhs.negative) {
+			add_magnitude(rhs);
 		}
 		else {
-			// same sign implies this->negative is invariant
-		}
-		size_t l = size();
-		size_t r = _rhs.size();
-		// zero pad the shorter edecimal
-		if (l < r) {
-			insert(end(), r - l, 0);
+			subtract_magnitude(rhs);
 		}
-		else {
-			_rhs.insert(_rhs.end(), l - r, 0);
-		}
-		edecimal::iterator lit = begin();
-		edecimal::iterator rit = _rhs.begin();
-		uint8_t carry = 0;
-		for (; lit != end() || rit != _rhs.end(); ++lit, ++rit) {
-			*lit += *rit + carry;
-			if (*lit > 9) {
-				carry = 1;
-				*lit -= 10;
-			}
-			else {
-				carry = 0;
-			}
-		}
-		if (carry) push_back(1);
 #if EDECIMAL_OPERATIONS_COUNT
 		if (enableAdd) ++ops.add;
 #endif
 		return *this;
 	}
 	edecimal& operator-=(const edecimal& rhs) {
-		edecimal _rhs(rhs);   // is this copy necessary? I introduced it to have a place to pad
-		bool sign = this->sign();
 		if (negative != rhs.negative) {
-			_rhs.setsign(!rhs.sign());
-			return operator+=(_rhs);
-		}
-		// largest value must be subtracted from
-		size_t l = size();
-		size_t r = _rhs.size();
-		// zero pad the shorter edecimal
-		if (l < r) {
-			insert(end(), r - l, 0);
-			std::swap(*this, _rhs);
-			sign = !sign;
-		}
-		else if (r < l) {
-			_rhs.insert(_rhs.end(), l - r, 0);
-		}
-		else {
-			// the operands are the same size, thus we need to check their magnitude
-			this->setpos();
-			_rhs.setpos();
-			if (*this < _rhs) {
-				std::swap(*this, _rhs);
-				sign = !sign;
-			}
-		}
-		edecimal::iterator lit = begin();
-		edecimal::iterator rit = _rhs.begin();
-		uint8_t borrow = 0;
-		for (; lit != end() || rit != _rhs.end(); ++lit, ++rit) {
-			if (*rit > *lit - borrow) {
-				*lit = static_cast<uint8_t>(10 + *lit - borrow - *rit);
-				borrow = 1;
-			}
-			else {
-				*lit = static_cast<uint8_t>(*lit - borrow - *rit);
-				borrow = 0;
-			}
-		}
-		if (borrow) std::cout << "can this happen?" << std::endl;
-		unpad();
-		if (this->iszero()) { // special case of zero having positive sign
-			this->setpos();
+			add_magnitude(rhs);
 		}
 		else {
-			this->setsign(sign);
+			subtract_magnitude(rhs);
 		}
 #if EDECIMAL_OPERATIONS_COUNT
 		++ops.sub;
@@ -174,55 +114,26 @@ public:
 			return *this;
 		}
 		bool signOfFinalResult = (negative != rhs.negative) ? true : false;
+		// schoolbook multiplication on limbs: each partial product a_i * b_j + r_ij + carry < RADIX^2 is split into
+		// a limb and a carry by a division by RADIX
+		size_t l = _limb.size();
+		size_t r = rhs._limb.size();
 		edecimal product;
-#if EDECIMAL_OPERATIONS_COUNT
-		enableAdd = false;
-#endif
-		// find the smallest edecimal to minimize the amount of work
-		size_t l = size();
-		size_t r = rhs.size();
-		edecimal::const_iterator sit, bit; // sit = smallest iterator, bit = biggest iterator
-		if (l < r) {
-			int64_t position = 0;
-			for (sit = begin(); sit != end(); ++sit) {
-				edecimal partial_sum; partial_sum.clear(); // TODO: this is silly, create and immediately destruct to make the insert work
-				partial_sum.insert(partial_sum.end(), r + position, 0);
-				edecimal::iterator pit = partial_sum.begin() + position;
-				uint8_t carry = 0;
-				for (bit = rhs.begin(); bit != rhs.end() && pit != partial_sum.end(); ++bit, ++pit) {
-					uint8_t digit = static_cast<uint8_t>(*sit * *bit + carry);
-					*pit = static_cast<uint8_t>(digit % 10);
-					carry = static_cast<uint8_t>(digit / 10);
-				}
-				if (carry) partial_sum.push_back(carry);
-				product += partial_sum;
-				//				std::cout << "partial sum " << partial_sum << " intermediate product " << product << std::endl;
-				++position;
-			}
-		}
-		else {
-			int64_t position = 0;
-			for (sit = rhs.begin(); sit != rhs.end(); ++sit) {
-				edecimal partial_sum; partial_sum.clear(); // TODO: this is silly, create and immediately destruct to make the insert work
-				partial_sum.insert(partial_sum.end(), l + position, 0);
-				edecimal::iterator pit = partial_sum.begin() + position;
-				uint8_t carry = 0;
-				for (bit = begin(); bit != end() && pit != partial_sum.end(); ++bit, ++pit) {
-					uint8_t digit = static_cast<uint8_t>(*sit * *bit + carry);
-					*pit = static_cast<uint8_t>(digit % 10);
-					carry = static_cast<uint8_t>(digit / 10);
-				}
-				if (carry) partial_sum.push_back(carry);
-				product += partial_sum;
-				//				std::cout << "partial sum " << partial_sum << " intermediate product " << product << std::endl;
-				++position;
+		product._limb.assign(l + r, 0);
+		for (size_t j = 0; j < r; ++j) {
+			uint64_t bj = rhs._limb[j];
+			if (bj == 0) continue;
+			uint64_t carry{ 0 };
+			for (size_t i = 0; i < l; ++i) {
+				internal::uint128 p = internal::umac128(_limb[i], bj, product._limb[i + j], carry);
+				product._limb[i + j] = divide_by_radix(p, carry);
 			}
+			product._limb[l + j] = carry;
 		}
 		product.unpad();
-		*this = product;
+		_limb.swap(product._limb);
 		setsign(signOfFinalResult);
 #if EDECIMAL_OPERATIONS_COUNT
-		enableAdd = true;
 		++ops.mul;
 #endif
 		return *this;
@@ -241,28 +152,33 @@ public:
 #endif
 		return *this;
 	}
+	// shift by decimal digits: multiply by 10^shift
 	edecimal& operator<<=(int shift) {
-		if (shift == 0) return *this;
+		if (shift == 0 || iszero()) return *this;
 		if (shift < 0) {
 			return operator>>=(-shift);
 		}
-		for (int i = 0; i < shift; ++i) {
-			this->insert(this->begin(), 0);
-		}
+		unsigned digitShift = static_cast<unsigned>(shift) % DIGITS_PER_LIMB;
+		size_t limbShift = static_cast<size_t>(shift) / DIGITS_PER_LIMB;
+		if (digitShift > 0) multiply_by_limb(powerOf10(digitShift));
+		if (limbShift > 0) _limb.insert(_limb.begin(), limbShift, 0);
 		return *this;
 	}
+	// shift by decimal digits: divide by 10^shift, truncating the magnitude
 	edecimal& operator>>=(int shift) {
 		if (shift == 0) return *this;
 		if (shift < 0) {
 			return operator<<=(-shift);
 		}
-		if (signed(size()) <= shift) {
+		if (static_cast<int>(digits()) <= shift) {
 			this->setzero();
 		}
 		else {
-			for (int i = 0; i < shift; ++i) {
-				this->erase(this->begin());
-			}
+			unsigned digitShift = static_cast<unsigned>(shift) % DIGITS_PER_LIMB;
+			size_t limbShift = static_cast<size_t>(shift) / DIGITS_PER_LIMB;
+			if (limbShift > 0) _limb.erase(_limb.begin(), _limb.begin() + static_cast<std::ptrdiff_t>(limbShift));
+			if (digitShift > 0) divide_by_limb(powerOf10(digitShift));
+			unpad();
 		}
 		return *this;
 	}
@@ -315,37 +231,46 @@ public:
 
 	// selectors
 	inline bool iszero() const {
-		if (size() == 0) return true;
-		return std::all_of(begin(), end(), [](uint8_t i) { return 0 == i; });
+		if (_limb.size() == 0) return true;
+		return std::all_of(_limb.begin(), _limb.end(), [](uint64_t limb) { return 0 == limb; });
 	}
 	inline bool sign() const { return negative; }
 	inline bool isneg() const { return negative; }   // <  0
 	inline bool ispos() const { return !negative; }  // >= 0
 
+	// number of significant decimal digits, 0 for the value 0
+	unsigned digits() const {
+		size_t n = _limb.size();
+		while (n > 0 && _limb[n - 1] == 0) --n;
+		if (n == 0) return 0;
+		unsigned d = static_cast<unsigned>(n - 1) * DIGITS_PER_LIMB;
+		for (uint64_t msl = _limb[n - 1]; msl > 0; msl /= 10) ++d;
+		return d;
+	}
+	// decimal digit at position i, with the digit for 10^0 at position 0
+	uint8_t digit(unsigned i) const {
+		size_t limb = i / DIGITS_PER_LIMB;
+		if (limb >= _limb.size()) return 0;
+		return static_cast<uint8_t>((_limb[limb] / powerOf10(i % DIGITS_PER_LIMB)) % 10);
+	}
+
 	// modifiers
-	inline void setzero() { clear(); push_back(0); negative = false; }
+	inline void clear() { setzero(); }
+	inline void setzero() { _limb.clear(); _limb.push_back(0); negative = false; }
 	inline void setsign(bool sign) { negative = sign; }
 	inline void setneg() { negative = true; }
 	inline void setpos() { negative = false; }
 	inline void setdigit(uint8_t d, bool sign = false) {
 		assert(d <= 9); // test argument assumption
-		clear();
-		push_back(d);
+		_limb.clear();
+		_limb.push_back(d);
 		negative = sign;
 	}
 	inline void setbits(uint64_t v) { *this = v; } // API to be consistent with the other number systems
 
-	// remove any leading zeros from a edecimal representation
+	// remove any leading zero limbs from a edecimal representation
 	void unpad() {
-		int n = (int)size();
-		for (int i = n - 1; i > 0; --i) {
-			if (operator[](static_cast<size_t>(i)) == 0) {
-				pop_back();
-			}
-			else {
-				return;  // found the most significant digit
-			}
-		}
+		while (_limb.size() > 1 && _limb.back() == 0) _limb.pop_back();
 	}
 
 	// read a edecimal ASCII format and make a edecimal type out of it
@@ -357,59 +282,48 @@ public:
 		std::regex edecimal_regex("[+-]*[0123456789]+");
 		if (std::regex_match(digits, edecimal_regex)) {
 			// found a edecimal representation
-			clear();
-			auto it = digits.begin();
-			if (*it == '-') {
+			_limb.clear();
+			negative = false;
+			size_t first = 0;
+			if (digits[first] == '-') {
 				setneg();
-				++it;
+				++first;
 			}
-			else if (*it == '+') {
-				++it;
+			else if (digits[first] == '+') {
+				++first;
 			}
-			for (; it != digits.end(); ++it) {
-				uint8_t v;
-				switch (*it) {
-				case '0':
-					v = 0;
-					break;
-				case '1':
-					v = 1;
-					break;
-				case '2':
-					v = 2;
-					break;
-				case '3':
-					v = 3;
-					break;
-				case '4':
-					v = 4;
-					break;
-				case '5':
-					v = 5;
-					break;
-				case '6':
-					v = 6;
-					break;
-				case '7':
-					v = 7;
-					break;
-				case '8':
-					v = 8;
-					break;
-				case '9':
-					v = 9;
-					break;
-				default:
-					v = 0;
+			// collect the digits in limbs of 19, starting with the least significant digit
+			size_t last = digits.size();
+			while (last > first) {
+				size_t msd = (last - first > DIGITS_PER_LIMB ? last - DIGITS_PER_LIMB : first);
+				uint64_t limb{ 0 };
+				for (size_t i = msd; i < last; ++i) {
+					limb = limb * 10 + static_cast<uint64_t>(digits[i] - '0');
 				}
-				push_back(v);
+				_limb.push_back(limb);
+				last = msd;
 			}
-			std::reverse(begin(), end());
+			unpad();
+			if (iszero()) setpos();
 			bSuccess = true;
 		}
 		return bSuccess;
 	}
 
+	// decimal digits of the magnitude
+	std::string str() const {
+		size_t n = _limb.size();
+		while (n > 1 && _limb[n - 1] == 0) --n;
+		if (n == 0) return std::string("0");
+		std::string s = std::to_string(_limb[n - 1]);
+		for (size_t i = n - 1; i > 0; --i) {
+			std::string limb = std::to_string(_limb[i - 1]);
+			s.append(DIGITS_PER_LIMB - limb.size(), '0');
+			s.append(limb);
+		}
+		return s;
+	}
+
 #if EDECIMAL_OPERATIONS_COUNT
 	// reset the operation statistics
 	void resetStats() {
@@ -420,144 +334,232 @@ public:
 	}
 #endif
 
+	// 10^e for e in [0, 19]
+	static uint64_t powerOf10(unsigned e) {
+		static constexpr uint64_t pow10[20] = {
+			1ull, 10ull, 100ull, 1'000ull, 10'000ull, 100'000ull, 1'000'000ull, 10'000'000ull, 100'000'000ull,
+			1'000'000'000ull, 10'000'000'000ull, 100'000'000'000ull, 1'000'000'000'000ull, 10'000'000'000'000ull,
+			100'000'000'000'000ull, 1'000'000'000'000'000ull, 10'000'000'000'000'000ull, 100'000'000'000'000'000ull,
+			1'000'000'000'000'000'000ull, 10'000'000'000'000'000'000ull
+		};
+		return pow10[e];
+	}
+
+	// split u < RADIX * 2^64 into u / RADIX and u % RADIX
+	// RADIX has its most significant bit set, so the division can use the precomputed reciprocal
+	// v = floor((2^128 - 1) / RADIX) - 2^64 and two multiplications (Moller and Granlund, 2011)
+	static uint64_t divide_by_radix(internal::uint128 u, uint64_t& quotient) {
+		constexpr uint64_t v = 0xD83C'94FB'6D2A'C34Aull;
+		internal::uint128 q = internal::umul128(v, u.upper);
+		uint64_t q0 = q.lower + u.lower;
+		uint64_t q1 = q.upper + u.upper + 1u + (q0 < q.lower ? 1u : 0u);
+		uint64_t r = u.lower - q1 * RADIX;
+		if (r > q0) {
+			--q1;
+			r += RADIX;
+		}
+		if (r >= RADIX) {
+			++q1;
+			r -= RADIX;
+		}
+		quotient = q1;
+		return r;
+	}
+
 protected:
+	// magnitude *= m, with m < RADIX
+	void multiply_by_limb(uint64_t m) {
+		uint64_t carry{ 0 };
+		for (size_t i = 0; i < _limb.size(); ++i) {
+			internal::uint128 p = internal::umac128(_limb[i], m, carry, 0);
+			_limb[i] = divide_by_radix(p, carry);
+		}
+		if (carry != 0) _limb.push_back(carry);
+	}
+	// magnitude /= d, with 0 < d < RADIX, returns the remainder
+	uint64_t divide_by_limb(uint64_t d) {
+		uint64_t remainder{ 0 };
+		for (size_t i = _limb.size(); i > 0; --i) {
+			internal::uint128 dividend = internal::umac128(remainder, RADIX, _limb[i - 1], 0);
+			_limb[i - 1] = internal::udiv128(dividend, d, remainder);
+		}
+		unpad();
+		return remainder;
+	}
+
 	// HELPER methods
 
+	// compare the magnitudes, ignoring leading zero limbs: returns 1 if |a| > |b|, 0 if equal, -1 if |a| < |b|
+	static int compare_magnitude(const edecimal& a, const edecimal& b) {
+		size_t na = a._limb.size(), nb = b._limb.size();
+		while (na > 0 && a._limb[na - 1] == 0) --na;
+		while (nb > 0 && b._limb[nb - 1] == 0) --nb;
+		if (na != nb) return (na > nb ? 1 : -1);
+		for (size_t i = na; i > 0; --i) {
+			if (a._limb[i - 1] != b._limb[i - 1]) return (a._limb[i - 1] > b._limb[i - 1] ? 1 : -1);
+		}
+		return 0;
+	}
+
+	// |this| += |rhs|
+	void add_magnitude(const edecimal& rhs) {
+		size_t r = rhs._limb.size();
+		if (_limb.size() < r) _limb.resize(r, 0);
+		uint64_t carry{ 0 };
+		size_t i = 0;
+		for (; i < r; ++i) {
+			// a + b + carry can exceed 2^64, so compare against the complement instead
+			uint64_t a = _limb[i] + carry;
+			uint64_t complement = RADIX - rhs._limb[i];
+			if (a >= complement) {
+				_limb[i] = a - complement;
+				carry = 1;
+			}
+			else {
+				_limb[i] = a + rhs._limb[i];
+				carry = 0;
+			}
+		}
+		for (; carry != 0 && i < _limb.size(); ++i) {
+			uint64_t a = _limb[i] + 1u;
+			carry = (a == RADIX ? 1u : 0u);
+			_limb[i] = (carry ? 0u : a);
+		}
+		if (carry) _limb.push_back(1);
+	}
+
+	// |this| -= |rhs| with the sign of the result flipped when |rhs| > |this|
+	void subtract_magnitude(const edecimal& rhs) {
+		int magnitude = compare_magnitude(*this, rhs);
+		if (magnitude == 0) {
+			setzero();
+			return;
+		}
+		// subtract the smaller magnitude from the larger one
+		const edecimal* larger = this;
+		const edecimal* smaller = &rhs;
+		edecimal copy;
+		if (magnitude < 0) {
+			copy = *this;
+			larger = &rhs;
+			smaller = &copy;
+			_limb.resize(rhs._limb.size(), 0);
+			negative = !negative;
+		}
+		size_t n = larger->_limb.size();
+		size_t s = smaller->_limb.size();
+		uint64_t borrow{ 0 };
+		for (size_t i = 0; i < n; ++i) {
+			uint64_t a = larger->_limb[i];
+			uint64_t b = (i < s ? smaller->_limb[i] : 0u) + borrow;
+			if (a >= b) {
+				_limb[i] = a - b;
+				borrow = 0;
+			}
+			else {
+				_limb[i] = RADIX - (b - a);
+				borrow = 1;
+			}
+		}
+		unpad();
+	}
+
 	// conversion functions
 	inline short              to_short()       const noexcept { return short(to_long_long()); }
 	inline int                to_int()         const noexcept { return short(to_long_long()); }
 	inline long               to_long()        const noexcept { return short(to_long_long()); }
 	inline long long          to_long_long()   const noexcept {
-		long long v = 0;	
-		long long order = sign() ? -1 : 1;
-		for (edecimal::const_iterator it = this->begin(); it != this->end(); ++it) {
-			v += *it * order;
-			order *= 10;
+		uint64_t v = 0;
+		for (size_t i = _limb.size(); i > 0; --i) {
+			v = v * RADIX + _limb[i - 1];
 		}
-		return v;
+		return (sign() ? -static_cast<long long>(v) : static_cast<long long>(v));
 	}
 	inline unsigned short     to_ushort()      const noexcept { return static_cast<unsigned short>(to_ulong_long()); }
 	inline unsigned int       to_uint()        const noexcept { return static_cast<unsigned int>(to_ulong_long()); }
 	inline unsigned long      to_ulong()       const noexcept { return static_cast<unsigned long>(to_ulong_long()); }
 	inline unsigned long long to_ulong_long()  const noexcept { return static_cast<unsigned long long>(to_long_long()); }
-	inline float              to_float()       const noexcept {
-		float f = 0.0f;
-		float order = sign() ? -1.0f : 1.0f;
-		for (edecimal::const_iterator it = this->begin(); it != this->end(); ++it) {
-			f += *it * order;
-			order *= 10.0f;
-		}
-		return f;
-	}
-	inline double             to_double()      const noexcept {
-		double d{ 0.0 };
-		double order = sign() ? -1.0 : 1.0;
-		for (edecimal::const_iterator it = this->begin(); it != this->end(); ++it) {
-			d += *it * order;
-			order *= 10.0;
+	inline float              to_float()       const noexcept { return to_ieee754<float>(); }
+	inline double             to_double()      const noexcept { return to_ieee754<double>(); }
+	inline long double        to_long_double() const noexcept { return to_ieee754<long double>(); }
+
+	// correctly rounded conversion: a single limb converts exactly through uint64_t, larger values through strtod
+	template<typename Real>
+	Real to_ieee754() const noexcept {
+		size_t n = _limb.size();
+		while (n > 1 && _limb[n - 1] == 0) --n;
+		Real v{ 0 };
+		if (n <= 1) {
+			v = static_cast<Real>(n == 0 ? 0ull : _limb[0]);
 		}
-		return d;
-	}
-	inline long double        to_long_double() const noexcept {
-		long double ld{ 0.0l };
-		long double order = sign() ? -1.0l : 1.0l;
-		for (edecimal::const_iterator it = this->begin(); it != this->end(); ++it) {
-			ld += *it * order;
-			order *= 10.0l;
+		else {
+			std::string digits = str();
+			if constexpr (std::is_same_v<Real, long double>) {
+				v = std::strtold(digits.c_str(), nullptr);
+			}
+			else {
+				v = static_cast<Real>(std::strtod(digits.c_str(), nullptr));
+			}
 		}
-		return ld;
+		return (sign() ? -v : v);
 	}
 
 	// Convert integer types to a edecimal representation
-// TODO: needs SFINAE enable_if to constrain it to native integer types
 	template<typename Ty>
 	edecimal& convert_integer(Ty v) {
-		using namespace std;
-		//cout << numeric_limits<Ty>::digits << " max value " << numeric_limits<Ty>::max() << endl;
-		bool sign = false;
 		setzero(); // initialize the edecimal value to 0
 		if (v == 0) return *this;
-		if (numeric_limits<Ty>::is_signed) {
-			if (v < 0) {
-				sign = true; // negative number
-				// transform to sign-magnitude on positive side
-				v *= Ty(-1);
-			}
+		bool sign = false;
+		uint64_t magnitude{ 0 };
+		if constexpr (std::numeric_limits<Ty>::is_signed) {
+			long long s = static_cast<long long>(v);
+			sign = (s < 0);
+			// transform to sign-magnitude on positive side, including the most negative value
+			magnitude = (sign ? 0ull - static_cast<uint64_t>(s) : static_cast<uint64_t>(s));
 		}
-		uint64_t mask = 0x1;
-		// IMPORTANT: can't use initializer or assignment operator as it would yield 
-		// an infinite loop calling convert_integer. So we need to construct the
-		// edecimal from first principals
-		edecimal base; // can't use base(1) semantics here as it would cause an infinite loop
-		base.clear();
-		base.push_back(1);
-		while (v) { // minimum loop iterations; exits when no bits left
-			if (v & mask) {
-				*this += base;
-			}
-			base += base;
-			v >>= 1;
+		else {
+			magnitude = static_cast<uint64_t>(v);
 		}
+		_limb[0] = magnitude % RADIX;
+		if (magnitude >= RADIX) _limb.push_back(magnitude / RADIX);
 		// lastly, set the sign
 		setsign(sign);
 		return *this;
 	}
 	template<typename Ty>
 	edecimal& convert_ieee754(Ty rhs) {
-		clear();
+		setzero();
 		if (rhs <= 0.5 && rhs >= -0.5) {
-			return *this = 0;
+			return *this;
+		}
+		bool s{ false };
+		uint64_t unbiasedExponent{ 0 };
+		uint64_t fraction{ 0 };
+		uint64_t bits{ 0 };
+		extractFields(rhs, s, unbiasedExponent, fraction, bits);
+		// TODO: subnormals
+
+		fraction |= (1ull << ieee754_parameter<Ty>::fbits); // add in the hidden bit
+		int scale = static_cast<int>(unbiasedExponent) - ieee754_parameter<Ty>::bias; // original scale of the number
+		int correction = static_cast<int>(ieee754_parameter<Ty>::fbits) - scale;
+		if (correction >= 0) {
+			// truncate the fraction bits
+			convert_integer(correction < 64 ? (fraction >> correction) : 0ull);
 		}
 		else {
-			if (rhs < -0.5) negative = true; else negative = false;
-
-			bool s{ false };
-			uint64_t unbiasedExponent{ 0 };
-			uint64_t fraction{ 0 };
-			uint64_t bits{ 0 };
-			extractFields(rhs, s, unbiasedExponent, fraction, bits);
-			// TODO: subnormals
-
-			fraction |= (1ull << ieee754_parameter<Ty>::fbits); // add in the hidden bit
-			// scale up by fbits, convert, and then scale back
-			uint64_t mask = 0x1;
-			edecimal base; // can't use base(1) semantics here as it would cause an infinite loop
-			base[0] = 1;
-//			int i = 0;
-			while (fraction) { // minimum loop iterations; exits when no bits left
-//				std::cout << std::setw(3) << i++ << "  base : " << base << '\n';
-				if (fraction & mask) {
-					*this += base;
-				}
-				base += base;
-				fraction >>= 1;
-			}
-//			std::cout << "upconversion : " << *this << " : final bit value: " << base << '\n';
-			int scale = static_cast<int>(unbiasedExponent) - ieee754_parameter<Ty>::bias; // original scale of the number
-			int upScale = ieee754_parameter<Ty>::fbits;
-			int correction = upScale - scale;
-//			std::cout << "correction = " << correction << " scale = " << scale << " upscale = " << upScale << '\n';
-			if (correction >= 0) {
-				edecimal downConvert;
-				downConvert[0] = 1;
-				for (int i = 0; i < correction; ++i) downConvert += downConvert;
-//				std::cout << "downConvert : " << downConvert << '\n';
-				// divide the factor out
-				*this /= downConvert;
-			}
-			else {
-				edecimal upConvert;
-				upConvert[0] = 1;
-				for (int i = 0; i < -correction; ++i) upConvert += upConvert;
-//				std::cout << "upConvert : " << upConvert << '\n';
-				// multiply to add the missing factor
-				*this *= upConvert;
+			// multiply to add the missing factor, in steps of 2^60 < RADIX
+			convert_integer(fraction);
+			for (int shift = -correction; shift > 0; shift -= 60) {
+				multiply_by_limb(1ull << (shift < 60 ? shift : 60));
 			}
 		}
+		if (!iszero()) setsign(s);
 		return *this;
 	}
 
 private:
+	// magnitude limbs in radix 10^19, least significant limb first
+	std::vector<uint64_t> _limb;
 	// sign-magnitude number: indicate if number is positive or negative
 	bool negative;
 
@@ -571,16 +573,15 @@ private:
 	friend bool operator>(const edecimal& lhs, const edecimal& rhs);
 	friend bool operator<=(const edecimal& lhs, const edecimal& rhs);
 	friend bool operator>=(const edecimal& lhs, const edecimal& rhs);
+	friend struct decintdiv decint_divide(const edecimal& _a, const edecimal& _b);
+	friend edecimal gcd(const edecimal& _a, const edecimal& _b);
 };
 
 ////////////////// helper functions
 
-// find the order of the most significant digit, precondition edecimal is unpadded
+// find the order of the most significant digit, returns -1 if v == 0
 inline int findMsd(const edecimal& v) {
-	int msd = int(v.size()) - 1;
-	if (msd == 0 && v == 0) return -1; // no significant digit found, all digits are zero
-	assert(v.at(static_cast<size_t>(msd)) != 0); // indicates the edecimal wasn't unpadded
-	return msd;
+	return static_cast<int>(v.digits()) - 1;
 }
 
 
@@ -591,9 +592,7 @@ inline int findMsd(const edecimal& v) {
 inline std::string to_binary(const edecimal& d) {
 	std::stringstream s;
 	if (d.isneg()) s << '-';
-	for (edecimal::const_reverse_iterator rit = d.rbegin(); rit != d.rend(); ++rit) {
-		s << (int)*rit;
-	}
+	s << d.str();
 	return s.str();
 }
 
@@ -601,9 +600,7 @@ inline std::string to_binary(const edecimal& d) {
 inline std::string to_string(const edecimal& d) {
 	std::stringstream s;
 	if (d.isneg()) s << '-';
-	for (edecimal::const_reverse_iterator rit = d.rbegin(); rit != d.rend(); ++rit) {
-		s << (int)*rit;
-	}
+	s << d.str();
 	return s.str();
 }
 
@@ -618,9 +615,7 @@ inline std::ostream& operator<<(std::ostream& ostr, const edecimal& d) {
 	ff = ostr.flags();
 	ss.flags(ff);
 	if (d.isneg()) ss << '-';
-	for (edecimal::const_reverse_iterator rit = d.rbegin(); rit != d.rend(); ++rit) {
-		ss << (int)*rit;
-	}
+	ss << d.str();
 	return ostr << ss.str();
 }
 
@@ -680,48 +675,35 @@ inline edecimal operator>>(const edecimal& lhs, int shift) {
 
 	// edecimal - edecimal logic operators
 // equality test
-bool operator==(const edecimal& lhs, const edecimal& rhs) {
-	if (lhs.size() != rhs.size()) return false;
-	bool areEqual = std::equal(lhs.begin(), lhs.end(), rhs.begin()) && lhs.sign() == rhs.sign();
-	return areEqual;
+inline bool operator==(const edecimal& lhs, const edecimal& rhs) {
+	if (edecimal::compare_magnitude(lhs, rhs) != 0) return false;
+	return lhs.sign() == rhs.sign() || lhs.iszero();
 }
 // inequality test
-bool operator!=(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator!=(const edecimal& lhs, const edecimal& rhs) {
 	return !operator==(lhs, rhs);
 }
 // less-than test
-bool operator<(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator<(const edecimal& lhs, const edecimal& rhs) {
 	if (lhs.sign() != rhs.sign()) {
+		if (lhs.iszero() && rhs.iszero()) return false;
 		return lhs.sign() ? true : false;
 	}
-
 	// signs are the same
-	// this logic assumes that there is no padding in the operands
-	size_t l = lhs.size();
-	size_t r = rhs.size();
-	if (l < r) return lhs.sign() ? false : true;
-	if (l > r) return lhs.sign() ? true : false;
-	// numbers are the same size, need to compare magnitude
-	edecimal::const_reverse_iterator ritl = lhs.rbegin();
-	edecimal::const_reverse_iterator ritr = rhs.rbegin();
-	for (; ritl != lhs.rend() || ritr != rhs.rend(); ++ritl, ++ritr) {
-		if (*ritl < *ritr) return lhs.sign() ? false : true;
-		if (*ritl > *ritr) return lhs.sign() ? true : false;
-		// if the digits are equal we need to check the next set
-	}
-	// at this point we know the two operands are the same
-	return false;
+	int magnitude = edecimal::compare_magnitude(lhs, rhs);
+	if (magnitude == 0) return false;
+	return (lhs.sign() ? magnitude > 0 : magnitude < 0);
 }
 // greater-than test
-bool operator>(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator>(const edecimal& lhs, const edecimal& rhs) {
 	return operator<(rhs, lhs);
 }
 // less-or-equal test
-bool operator<=(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator<=(const edecimal& lhs, const edecimal& rhs) {
 	return operator<(lhs, rhs) || operator==(lhs, rhs);
 }
 // greater-or-equal test
-bool operator>=(const edecimal& lhs, const edecimal& rhs) {
+inline bool operator>=(const edecimal& lhs, const edecimal& rhs) {
 	return !operator<(lhs, rhs);
 }
 
@@ -766,9 +748,9 @@ inline bool operator>=(long lhs, const edecimal& rhs) {
 }
 
 ///////////////////////////////////////////////////////////////////////
-// 
-// find largest multiplier of rhs being less or equal to lhs by subtraction; assumes 0*rhs <= lhs <= 9*rhs 
-edecimal findLargestMultiple(const edecimal& lhs, const edecimal& rhs) {
+//
+// find largest multiplier of rhs being less or equal to lhs by subtraction; assumes 0*rhs <= lhs <= 9*rhs
+inline edecimal findLargestMultiple(const edecimal& lhs, const edecimal& rhs) {
 	// check argument assumption	assert(0 <= lhs && lhs >= 9 * rhs);
 	edecimal remainder = lhs;
 	remainder.setpos();
@@ -783,7 +765,7 @@ edecimal findLargestMultiple(const edecimal& lhs, const edecimal& rhs) {
 			if (remainder < 0) {  // we went too far
 				--multiplier;
 			}
-			// else implies remainder is 0										
+			// else implies remainder is 0
 			break;
 		}
 	}
@@ -799,70 +781,194 @@ struct decintdiv {
 };
 
 // divide integer edecimal a and b and return result argument
-decintdiv decint_divide(const edecimal& _a, const edecimal& _b) {
+// The long division runs on limbs with Knuth's algorithm D in radix 10^19: the operands are scaled
+// so that the most significant limb of the divisor is at least RADIX/2, which bounds the error
+// of the quotient limb estimated from the leading limbs to 2.
+inline decintdiv decint_divide(const edecimal& _a, const edecimal& _b) {
+	constexpr uint64_t RADIX = edecimal::RADIX;
+	decintdiv divresult;
 	if (_b.iszero()) {
 #if EDECIMAL_THROW_ARITHMETIC_EXCEPTION
 		throw edecimal_integer_divide_by_zero{};
 #else
 		std::cerr << "integer_divide_by_zero\n";
+		return divresult;
 #endif // EDECIMAL_THROW_ARITHMETIC_EXCEPTION
 	}
-	// generate the absolute values to do long division 
+	// generate the absolute values to do long division
 	bool a_negative = _a.sign();
 	bool b_negative = _b.sign();
 	bool result_negative = (a_negative ^ b_negative);
-	edecimal a(_a); a.setpos();
-	edecimal b(_b); b.setpos();
-	decintdiv divresult;
-	if (a < b) {
+	if (edecimal::compare_magnitude(_a, _b) < 0) {
 		divresult.quot = 0;
 		divresult.rem = _a; // a % b = a when a / b = 0
 		return divresult; // a / b = 0 when b > a
 	}
-	// initialize the long division
-	edecimal accumulator = a;
-	// prepare the subtractand
-	edecimal subtractand = b;
-	int msd_b = findMsd(b);
-	int msd_a = findMsd(a);
-	int shift = msd_a - msd_b;
-	subtractand <<= shift;
-	// long division
-	for (int i = shift; i >= 0; --i) {
-		if (subtractand <= accumulator) {
-			edecimal multiple = findLargestMultiple(accumulator, subtractand);
-			accumulator -= multiple * subtractand;
-			uint8_t multiplier = static_cast<uint8_t>(int(multiple)); // TODO: fix the ugly
-			divresult.quot.insert(divresult.quot.begin(), multiplier);
-		}
-		else {
-			divresult.quot.insert(divresult.quot.begin(), 0);
-		}
-		subtractand >>= 1;
-		if (subtractand == 0) break;
-	}
-	if (result_negative) {
-		divresult.quot.setneg();
-	}
-	if (_a < 0) {
-		divresult.rem = -accumulator;
+	edecimal a(_a); a.setpos(); a.unpad();
+	edecimal b(_b); b.setpos(); b.unpad();
+	size_t n = b._limb.size();
+	size_t m = a._limb.size() - n;
+	edecimal& q = divresult.quot;
+	q._limb.assign(m + 1, 0);
+
+	if (n == 1) {
+		// single limb divisor
+		q = a;
+		uint64_t r = q.divide_by_limb(b._limb[0]);
+		divresult.rem = r;
 	}
 	else {
-		divresult.rem = accumulator;
+		// normalize
+		uint64_t scale = RADIX / (b._limb[n - 1] + 1);
+		edecimal u(a), v(b);
+		u.multiply_by_limb(scale);
+		v.multiply_by_limb(scale);
+		u._limb.resize(m + n + 1, 0);
+		uint64_t vtop = v._limb[n - 1], vnext = v._limb[n - 2];
+		for (size_t j = m + 1; j > 0; --j) {
+			size_t k = j - 1;
+			// estimate the quotient limb from the leading two limbs of the running remainder
+			uint64_t rhat{ 0 };
+			uint64_t qhat = internal::udiv128(internal::umac128(u._limb[k + n], RADIX, u._limb[k + n - 1], 0), vtop, rhat);
+			// rhat + vtop can exceed 2^64: once rhat reaches RADIX the estimate is final, so saturate it there
+			auto decrement = [&]() {
+				--qhat;
+				rhat = (rhat >= RADIX - vtop ? RADIX : rhat + vtop);
+			};
+			while (qhat >= RADIX) decrement();
+			while (rhat < RADIX) {
+				internal::uint128 lhs = internal::umul128(qhat, vnext);
+				internal::uint128 rhs = internal::umac128(rhat, RADIX, u._limb[k + n - 2], 0);
+				if (lhs.upper < rhs.upper || (lhs.upper == rhs.upper && lhs.lower <= rhs.lower)) break;
+				decrement();
+			}
+			// multiply and subtract
+			uint64_t carry{ 0 }, borrow{ 0 };
+			for (size_t i = 0; i < n; ++i) {
+				uint64_t hi{ 0 };
+				uint64_t lo = edecimal::divide_by_radix(internal::umac128(qhat, v._limb[i], carry, 0), hi);
+				carry = hi;
+				uint64_t sub = lo + borrow;
+				if (u._limb[i + k] >= sub) {
+					u._limb[i + k] -= sub;
+					borrow = 0;
+				}
+				else {
+					u._limb[i + k] = RADIX - (sub - u._limb[i + k]);
+					borrow = 1;
+				}
+			}
+			uint64_t top = carry + borrow;
+			if (u._limb[k + n] >= top) {
+				u._limb[k + n] -= top;
+			}
+			else {
+				// subtracted too much, add back
+				u._limb[k + n] = RADIX - (top - u._limb[k + n]);
+				--qhat;
+				uint64_t c{ 0 };
+				for (size_t i = 0; i < n; ++i) {
+					uint64_t s = u._limb[i + k] + c;
+					uint64_t complement = RADIX - v._limb[i];
+					if (s >= complement) {
+						u._limb[i + k] = s - complement;
+						c = 1;
+					}
+					else {
+						u._limb[i + k] = s + v._limb[i];
+						c = 0;
+					}
+				}
+				u._limb[k + n] = (u._limb[k + n] + c) % RADIX;
+			}
+			q._limb[k] = qhat;
+		}
+		// the remainder is the running remainder scaled back
+		u._limb.resize(n);
+		u.divide_by_limb(scale);
+		divresult.rem = u;
 	}
-	divresult.quot.unpad();
+	q.unpad();
 	divresult.rem.unpad();
+	if (result_negative && !q.iszero()) {
+		q.setneg();
+	}
+	if (a_negative && !divresult.rem.iszero()) {
+		divresult.rem.setneg();
+	}
 	return divresult;
 }
 
 // return quotient of a edecimal integer division
-edecimal quotient(const edecimal& _a, const edecimal& _b) {
+inline edecimal quotient(const edecimal& _a, const edecimal& _b) {
 	return decint_divide(_a, _b).quot;
 }
 // return remainder of a edecimal integer division
-edecimal remainder(const edecimal& _a, const edecimal& _b) {
+inline edecimal remainder(const edecimal& _a, const edecimal& _b) {
 	return decint_divide(_a, _b).rem;
 }
 
-}} // namespace sw::universal
+// greatest common divisor of two words by Stein's binary algorithm
+inline uint64_t binary_gcd(uint64_t a, uint64_t b) {
+	if (a == 0) return b;
+	if (b == 0) return a;
+	int shift = std::countr_zero(a | b);
+	a >>= std::countr_zero(a);
+	do {
+		b >>= std::countr_zero(b);
+		if (a > b) std::swap(a, b);
+		b -= a;
+	} while (b != 0);
+	return a << shift;
+}
+
+// greatest common divisor of the magnitudes of a and b
+// Lehmer's algorithm: the Euclidean steps are simulated on the leading 18 decimal digits of a and b, and
+// the accumulated cosequence is applied to the full operands in one linear combination, so a multi-limb
+// remainder is only computed when the leading digits cannot decide the quotient. Once both operands fit
+// in a limb the binary gcd finishes the reduction.
+inline edecimal gcd(const edecimal& _a, const edecimal& _b) {
+	edecimal a(_a), b(_b);
+	a.setpos(); a.unpad();
+	b.setpos(); b.unpad();
+	if (a < b) std::swap(a, b);
+	// floor(v / 10^shift), which is less than 10^18 by the choice of shift
+	auto leading = [](const edecimal& v, unsigned shift) -> int64_t {
+		size_t k = shift / edecimal::DIGITS_PER_LIMB;
+		uint64_t hi = (k + 1 < v._limb.size() ? v._limb[k + 1] : 0);
+		uint64_t lo = (k < v._limb.size() ? v._limb[k] : 0);
+		uint64_t remainder{ 0 };
+		internal::uint128 n = internal::umac128(hi, edecimal::RADIX, lo, 0);
+		return static_cast<int64_t>(internal::udiv128(n, edecimal::powerOf10(shift % edecimal::DIGITS_PER_LIMB), remainder));
+	};
+	while (b._limb.size() > 1) {
+		unsigned shift = a.digits() - 18;
+		int64_t ah = leading(a, shift), bh = leading(b, shift);
+		int64_t A{ 1 }, B{ 0 }, C{ 0 }, D{ 1 };
+		while (bh + C > 0 && bh + D > 0) {
+			int64_t q = (ah + A) / (bh + C);
+			if (q != (ah + B) / (bh + D)) break;
+			int64_t t = A - q * C; A = C; C = t;
+			t = B - q * D; B = D; D = t;
+			t = ah - q * bh; ah = bh; bh = t;
+		}
+		if (B == 0) {
+			edecimal r = a % b;
+			a = std::move(b);
+			b = std::move(r);
+		}
+		else {
+			edecimal t = a * edecimal(A) + b * edecimal(B);
+			edecimal u = a * edecimal(C) + b * edecimal(D);
+			a = std::move(t);
+			b = std::move(u);
+		}
+		a.unpad();
+		b.unpad();
+	}
+	if (b.iszero()) return a;
+	uint64_t r = (a._limb.size() > 1 ? (a % b)._limb[0] : a._limb[0]);
+	return edecimal(binary_gcd(b._limb[0], r));
+}
 
+}} // namespace sw::universal
@@ -12,10 +12,14 @@
 #include <regex>
 #include <vector>
 #include <map>
+#include <algorithm>
+#include <bit>
 
 // supporting types and functions
 #include <universal/native/ieee754.hpp>   // IEEE-754 decoders
+#include <universal/internal/arena/limb_arena.hpp>
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/number/shared/decimal_format.hpp>
 
 /*
 The efloat arithmetic can be configured to:
@@ -39,13 +43,22 @@ enum class FloatingPointState {
 };
 
 // efloat is an adaptive precision linear floating-point type
+// The significand is a sequence of 32-bit limbs, most significant limb first, with the leading 1 in bit 31
+// of the first limb: value = (-1)^sign * 1.f * 2^exponent. Every result carries just the limbs it needs:
+// sums and products of short operands are exact and stay short, only results that do not terminate,
+// or that would exceed maxNrLimbs, are rounded to nearest even at maxNrLimbs limbs.
+// The limbs come from a thread-local arena, so the temporaries of an expression recycle their storage.
 template<unsigned nlimbs = 1024>
 class efloat {
 public:
 	static constexpr unsigned maxNrLimbs = nlimbs;
+	static_assert(nlimbs > 0, "efloat requires at least one limb");
+	static constexpr int64_t  maxNrBits = 32ll * nlimbs;
+
+	using Limbs = internal::arena_vector<uint32_t>;
 
 	// constructor
-	efloat() : _state{ FloatingPointState::Zero }, _sign{ false }, _exponent{ 0 }, _limb{ 0 } { }
+	efloat() : _state{ FloatingPointState::Zero }, _sign{ false }, _exponent{ 0 }, _limb{} { }
 
 	efloat(const efloat&) = default;
 	efloat(efloat&&) = default;
@@ -89,51 +102,110 @@ public:
 	efloat(long double iv)                      noexcept { *this = iv; }
 	efloat& operator=(long double rhs)          noexcept { return convert_ieee754(rhs); }
 	explicit operator long double()       const noexcept { return convert_to_ieee754<long double>(); }
-#endif 
+#endif
 
 	// prefix operators
 	efloat operator-() const {
 		efloat negated(*this);
+		if (_state != FloatingPointState::Zero) negated._sign = !_sign;
 		return negated;
 	}
 
 	// arithmetic operators
 	efloat& operator+=(const efloat& rhs) {
-		return *this;
+		return add(rhs, rhs._sign);
 	}
 	efloat& operator+=(double rhs) {
-		return *this;
+		return operator+=(efloat(rhs));
 	}
 	efloat& operator-=(const efloat& rhs) {
-		return *this;
+		return add(rhs, !rhs._sign);
 	}
 	efloat& operator-=(double rhs) {
-		return *this;
+		return operator-=(efloat(rhs));
 	}
 	efloat& operator*=(const efloat& rhs) {
-		return *this;
+		bool sign = (_sign != rhs._sign);
+		if (isnan() || rhs.isnan()) return setnan();
+		if (isinf() || rhs.isinf()) {
+			if (iszero() || rhs.iszero()) return setnan();
+			return setinf(sign);
+		}
+		if (iszero() || rhs.iszero()) {
+			setzero();
+			return *this;
+		}
+		// exact product of the integer significands, rounded when it exceeds maxNrLimbs
+		size_t na = _limb.size(), nb = rhs._limb.size();
+		Limbs product(na + nb, 0);
+		for (size_t i = 0; i < na; ++i) {
+			uint64_t a = _limb[na - 1 - i];
+			uint64_t carry{ 0 };
+			for (size_t j = 0; j < nb; ++j) {
+				uint64_t t = a * rhs._limb[nb - 1 - j] + product[i + j] + carry;
+				product[i + j] = static_cast<uint32_t>(t);
+				carry = t >> 32;
+			}
+			product[i + nb] = static_cast<uint32_t>(carry);
+		}
+		int64_t lsb = lsbExponent() + rhs.lsbExponent();
+		_sign = sign;
+		return round_and_pack(product, lsb, false);
 	}
 	efloat& operator*=(double rhs) {
-		return *this;
+		return operator*=(efloat(rhs));
 	}
 	efloat& operator/=(const efloat& rhs) {
-		return *this;
+		bool sign = (_sign != rhs._sign);
+		if (isnan() || rhs.isnan()) return setnan();
+		if (isinf()) {
+			if (rhs.isinf()) return setnan();
+			return setinf(sign);
+		}
+		if (rhs.iszero()) {
+			if (iszero()) return setnan();
+#if EFLOAT_THROW_ARITHMETIC_EXCEPTION
+			throw efloat_divide_by_zero();
+#else
+			return setinf(sign);
+#endif
+		}
+		if (iszero()) return *this;
+		if (rhs.isinf()) {
+			setzero();
+			return *this;
+		}
+		// quotient of the integer significands with the dividend extended so that the quotient has
+		// maxNrBits + 2 bits or more: the remainder only contributes a sticky bit
+		size_t na = _limb.size(), nb = rhs._limb.size();
+		size_t extension = static_cast<size_t>(nlimbs) + 2u + nb - na;   // na <= nlimbs
+		Limbs u(extension + na + 1, 0), v(nb, 0);
+		for (size_t i = 0; i < na; ++i) u[extension + i] = _limb[na - 1 - i];
+		for (size_t j = 0; j < nb; ++j) v[j] = rhs._limb[nb - 1 - j];
+		int64_t lsb = lsbExponent() - 32ll * static_cast<int64_t>(extension) - rhs.lsbExponent();
+		Limbs q;
+		bool sticky = divide_limbs(u, v, q);
+		_sign = sign;
+		return round_and_pack(q, lsb, sticky);
 	}
 	efloat& operator/=(double rhs) {
-		return *this;
+		return operator/=(efloat(rhs));
 	}
 
 	// modifiers
-	void clear() { _state = FloatingPointState::Normal;  _sign = false; _exponent = 0; _limb.clear(); }
+	void clear() { _state = FloatingPointState::Zero;  _sign = false; _exponent = 0; _limb.clear(); }
 	void setzero() { clear(); }
+	efloat& setinf(bool sign = false) { clear(); _state = FloatingPointState::Infinite; _sign = sign; return *this; }
+	efloat& setnan(bool signaling = false) { clear(); _state = (signaling ? FloatingPointState::SignalingNaN : FloatingPointState::QuietNaN); return *this; }
 
 	efloat& assign(const std::string& txt) {
+		if (!parse(txt, *this)) setnan();
 		return *this;
 	}
 
 	// selectors
 	bool iszero() const noexcept { return _state == FloatingPointState::Zero; }
-	bool isone()  const noexcept { return (_state == FloatingPointState::Normal && !_sign && _exponent == 0 && _limb.size() == 1 && _limb[0] == 0x8000'000); }
+	bool isone()  const noexcept { return (_state == FloatingPointState::Normal && !_sign && _exponent == 0 && _limb.size() == 1 && _limb[0] == 0x8000'0000); }
 	bool isodd()  const noexcept { return false; }
 	bool iseven() const noexcept { return !isodd(); }
 	bool ispos()  const noexcept { return (_state == FloatingPointState::Normal && !_sign); }
@@ -179,16 +251,266 @@ public:
 
 		return v;
 	}
-	std::vector<uint32_t> bits() const { return _limb; }
+	std::vector<uint32_t> bits() const { return std::vector<uint32_t>(_limb.begin(), _limb.end()); }
+	// number of limbs, which is the precision this value carries
+	unsigned precision() const noexcept { return static_cast<unsigned>(_limb.size()); }
+
+	// three-way comparison of two ordered values: -1, 0, or +1
+	int compare(const efloat& rhs) const noexcept {
+		if (iszero() && rhs.iszero()) return 0;
+		int sl = (iszero() ? 0 : sign());
+		int sr = (rhs.iszero() ? 0 : rhs.sign());
+		if (sl != sr) return (sl < sr ? -1 : 1);
+		// same sign, both nonzero
+		int m{ 0 };
+		if (isinf() || rhs.isinf()) {
+			m = (isinf() ? (rhs.isinf() ? 0 : 1) : -1);
+		}
+		else {
+			m = compare_magnitude(rhs);
+		}
+		return (_sign ? -m : m);
+	}
 
 protected:
 	FloatingPointState    _state;    // exceptional state
 	bool                  _sign;     // sign of the number: -1 if true, +1 if false, zero is positive
 	int64_t               _exponent; // exponent of the number
-	std::vector<uint32_t> _limb;     // limbs of the representation
+	Limbs                 _limb;     // limbs of the representation
 
 	// HELPER methods
 
+	// weight of the least significant bit of the limbs
+	int64_t lsbExponent() const noexcept { return _exponent - 32ll * static_cast<int64_t>(_limb.size()) + 1; }
+
+	// compare |this| and |rhs| of two normal values
+	int compare_magnitude(const efloat& rhs) const noexcept {
+		if (_exponent != rhs._exponent) return (_exponent > rhs._exponent ? 1 : -1);
+		size_t n = std::max(_limb.size(), rhs._limb.size());
+		for (size_t i = 0; i < n; ++i) {
+			uint32_t a = (i < _limb.size() ? _limb[i] : 0u);
+			uint32_t b = (i < rhs._limb.size() ? rhs._limb[i] : 0u);
+			if (a != b) return (a > b ? 1 : -1);
+		}
+		return 0;
+	}
+
+	// write the significand of x into the least-significant-first limbs w with its lsb at bit offset
+	// offset; bits that fall below bit 0 are folded into the sticky bit
+	static void place(Limbs& w, const efloat& x, int64_t offset, bool& sticky) {
+		size_t n = x._limb.size();
+		for (size_t i = 0; i < n; ++i) {
+			uint32_t limb = x._limb[n - 1 - i];
+			int64_t bitpos = offset + 32ll * static_cast<int64_t>(i);
+			if (bitpos >= 0) {
+				size_t index = static_cast<size_t>(bitpos / 32);
+				unsigned shift = static_cast<unsigned>(bitpos % 32);
+				w[index] |= (limb << shift);
+				if (shift > 0) w[index + 1] |= (limb >> (32 - shift));
+			}
+			else if (bitpos <= -32) {
+				sticky = sticky || (limb != 0);
+			}
+			else {
+				unsigned shift = static_cast<unsigned>(-bitpos);
+				sticky = sticky || ((limb & ((1u << shift) - 1u)) != 0);
+				w[0] |= (limb >> shift);
+			}
+		}
+	}
+
+	// this + (-1)^negate * |rhs|
+	efloat& add(const efloat& rhs, bool rhsSign) {
+		if (isnan() || rhs.isnan()) return setnan();
+		if (isinf() || rhs.isinf()) {
+			if (isinf() && rhs.isinf() && _sign != rhsSign) return setnan();
+			return (isinf() ? *this : setinf(rhsSign));
+		}
+		if (rhs.iszero()) return *this;
+		if (iszero()) {
+			*this = rhs;
+			_sign = rhsSign;
+			return *this;
+		}
+		bool subtract = (_sign != rhsSign);
+		// order the operands by magnitude so a subtraction never goes negative
+		const efloat* big = this;
+		const efloat* small = &rhs;
+		bool resultSign = _sign;
+		int order = compare_magnitude(rhs);
+		if (order < 0) {
+			big = &rhs;
+			small = this;
+			resultSign = rhsSign;
+		}
+		else if (order == 0 && subtract) {
+			setzero();
+			return *this;
+		}
+		// the sum is exact down to the smaller lsb, but never needs more than maxNrBits + 3 bits below the
+		// leading bit: anything below that is summarized in a sticky bit
+		int64_t emax = big->_exponent;
+		int64_t lsb = std::min(lsbExponent(), rhs.lsbExponent());
+		lsb = std::max(lsb, emax - maxNrBits - 3);
+		size_t nw = static_cast<size_t>((emax - lsb + 2) / 32 + 2);
+		Limbs wa(nw, 0), wb(nw, 0);
+		bool stickyA{ false }, stickyB{ false };
+		place(wa, *big, big->lsbExponent() - lsb, stickyA);
+		place(wb, *small, small->lsbExponent() - lsb, stickyB);
+		bool sticky = stickyA || stickyB;
+		if (!subtract) {
+			uint64_t carry{ 0 };
+			for (size_t i = 0; i < nw; ++i) {
+				uint64_t t = uint64_t(wa[i]) + wb[i] + carry;
+				wa[i] = static_cast<uint32_t>(t);
+				carry = t >> 32;
+			}
+		}
+		else {
+			// the truncated part of the smaller operand is subtracted as one unit, and its complement
+			// within that unit becomes the sticky bit
+			uint64_t borrow = (stickyB ? 1u : 0u);
+			for (size_t i = 0; i < nw; ++i) {
+				uint64_t t = uint64_t(wa[i]) - wb[i] - borrow;
+				wa[i] = static_cast<uint32_t>(t);
+				borrow = (t >> 63);
+			}
+		}
+		_sign = resultSign;
+		return round_and_pack(wa, lsb, sticky);
+	}
+
+	// normalize the least-significant-first magnitude w * 2^lsb (+ sticky), round it to nearest even at
+	// maxNrBits, and store it as most-significant-first limbs without trailing zero limbs
+	efloat& round_and_pack(Limbs& w, int64_t lsb, bool sticky) {
+		while (!w.empty() && w.back() == 0) w.pop_back();
+		if (w.empty()) {
+			setzero();
+			return *this;
+		}
+		int64_t nbits = 32ll * static_cast<int64_t>(w.size() - 1) + std::bit_width(w.back());
+		if (nbits > maxNrBits) {
+			int64_t drop = nbits - maxNrBits;
+			bool roundBit = bit(w, drop - 1);
+			int64_t fullLimbs = (drop - 1) / 32;
+			for (int64_t i = 0; i < fullLimbs && !sticky; ++i) sticky = (w[static_cast<size_t>(i)] != 0);
+			for (int64_t i = 32 * fullLimbs; i < drop - 1 && !sticky; ++i) sticky = bit(w, i);
+			shift_right(w, drop);
+			lsb += drop;
+			if (roundBit && (sticky || (w[0] & 1u))) {
+				uint64_t carry{ 1 };
+				for (size_t i = 0; i < w.size() && carry; ++i) {
+					uint64_t t = uint64_t(w[i]) + carry;
+					w[i] = static_cast<uint32_t>(t);
+					carry = t >> 32;
+				}
+				if (carry) w.push_back(1u);
+			}
+			while (!w.empty() && w.back() == 0) w.pop_back();
+			nbits = 32ll * static_cast<int64_t>(w.size() - 1) + std::bit_width(w.back());
+			if (nbits > maxNrBits) {
+				// rounding carried into a new bit: the value is a power of 2
+				shift_right(w, 1);
+				lsb += 1;
+				--nbits;
+				while (!w.empty() && w.back() == 0) w.pop_back();
+			}
+		}
+		// left align the leading bit in bit 31 of the most significant limb
+		unsigned align = static_cast<unsigned>((32 - nbits % 32) % 32);
+		if (align > 0) {
+			for (size_t i = w.size() - 1; i > 0; --i) {
+				w[i] = (w[i] << align) | (w[i - 1] >> (32 - align));
+			}
+			w[0] <<= align;
+		}
+		_state = FloatingPointState::Normal;
+		_exponent = lsb + nbits - 1;
+		size_t first = 0;
+		while (w[first] == 0) ++first;   // trailing zero limbs of the significand
+		_limb.assign(w.rbegin(), w.rend() - static_cast<std::ptrdiff_t>(first));
+		return *this;
+	}
+
+	static bool bit(const Limbs& w, int64_t i) noexcept {
+		return (w[static_cast<size_t>(i / 32)] >> (i % 32)) & 1u;
+	}
+	static void shift_right(Limbs& w, int64_t shift) {
+		size_t limbShift = static_cast<size_t>(shift / 32);
+		unsigned bitShift = static_cast<unsigned>(shift % 32);
+		size_t n = w.size();
+		for (size_t i = 0; i + limbShift < n; ++i) {
+			uint32_t lo = w[i + limbShift] >> bitShift;
+			uint32_t hi = (bitShift > 0 && i + limbShift + 1 < n ? w[i + limbShift + 1] << (32 - bitShift) : 0u);
+			w[i] = lo | hi;
+		}
+		w.resize(n - std::min(n, limbShift));
+	}
+
+	// q = u / v on least-significant-first limbs with Knuth's algorithm D, returns true for a nonzero remainder
+	// precondition: the most significant limb of v is nonzero, u has a zero limb on top
+	static bool divide_limbs(Limbs& u, const Limbs& v, Limbs& q) {
+		size_t n = v.size();
+		size_t m = u.size() - n;
+		q.assign(m, 0);
+		if (n == 1) {
+			uint64_t remainder{ 0 };
+			for (size_t i = u.size(); i > 0; --i) {
+				uint64_t t = (remainder << 32) | u[i - 1];
+				if (i - 1 < m) q[i - 1] = static_cast<uint32_t>(t / v[0]);
+				remainder = t % v[0];
+			}
+			return remainder != 0;
+		}
+		// normalize so the top bit of the divisor is set
+		unsigned s = static_cast<unsigned>(std::countl_zero(v[n - 1]));
+		Limbs vn(n), un(u.size());
+		for (size_t i = n - 1; i > 0; --i) vn[i] = (v[i] << s) | (s ? v[i - 1] >> (32 - s) : 0u);
+		vn[0] = v[0] << s;
+		for (size_t i = u.size() - 1; i > 0; --i) un[i] = (u[i] << s) | (s ? u[i - 1] >> (32 - s) : 0u);
+		un[0] = u[0] << s;
+		constexpr uint64_t b = 1ull << 32;
+		for (size_t j = m; j > 0; --j) {
+			size_t k = j - 1;
+			uint64_t numerator = (uint64_t(un[k + n]) << 32) | un[k + n - 1];
+			uint64_t qhat = numerator / vn[n - 1];
+			uint64_t rhat = numerator % vn[n - 1];
+			while (qhat >= b || qhat * vn[n - 2] > ((rhat << 32) | un[k + n - 2])) {
+				--qhat;
+				rhat += vn[n - 1];
+				if (rhat >= b) break;
+			}
+			// multiply and subtract
+			int64_t borrow{ 0 };
+			uint64_t carry{ 0 };
+			for (size_t i = 0; i < n; ++i) {
+				uint64_t p = qhat * vn[i] + carry;
+				carry = p >> 32;
+				int64_t t = int64_t(un[i + k]) - borrow - int64_t(p & 0xFFFF'FFFF);
+				un[i + k] = static_cast<uint32_t>(t);
+				borrow = (t < 0 ? 1 : 0);
+			}
+			int64_t t = int64_t(un[k + n]) - borrow - int64_t(carry);
+			un[k + n] = static_cast<uint32_t>(t);
+			if (t < 0) {
+				// add back
+				--qhat;
+				uint64_t c{ 0 };
+				for (size_t i = 0; i < n; ++i) {
+					uint64_t sum = uint64_t(un[i + k]) + vn[i] + c;
+					un[i + k] = static_cast<uint32_t>(sum);
+					c = sum >> 32;
+				}
+				un[k + n] = static_cast<uint32_t>(uint64_t(un[k + n]) + c);
+			}
+			q[k] = static_cast<uint32_t>(qhat);
+		}
+		for (size_t i = 0; i < n; ++i) {
+			if (un[i] != 0) return true;
+		}
+		return false;
+	}
+
 	// convert arithmetic types into an elastic floating-point
 	template<typename SignedInt,
 		typename = typename std::enable_if< std::is_integral<SignedInt>::value, SignedInt >::type>
@@ -197,7 +519,9 @@ protected:
 			setzero();
 		}
 		else {
-
+			uint64_t magnitude = (v < 0 ? uint64_t(0) - static_cast<uint64_t>(static_cast<int64_t>(v)) : static_cast<uint64_t>(v));
+			convert_unsigned(magnitude);
+			_sign = (v < 0);
 		}
 		return *this;
 	}
@@ -209,7 +533,10 @@ protected:
 			setzero();
 		}
 		else {
-
+			uint64_t bits = static_cast<uint64_t>(v);
+			Limbs w{ static_cast<uint32_t>(bits), static_cast<uint32_t>(bits >> 32) };
+			_sign = false;
+			round_and_pack(w, 0, false);
 		}
 		return *this;
 	}
@@ -254,6 +581,7 @@ protected:
 			break;
 		}
 
+		_state = FloatingPointState::Normal;
 		_sign = sw::universal::sign(rhs);
 		_exponent = sw::universal::scale(rhs); // scale already deals with subnormal numbers
 		if constexpr (sizeof(Real) == 4) {
@@ -290,7 +618,22 @@ protected:
 			_limb.push_back(static_cast<uint32_t>(bits & 0xFFFF'FFFF));
 		}
 		else {
-			static_assert(true);
+			// extended precision: the significand is an exact multiple of its unit in the last place
+			int e{ 0 };
+			Real f = std::frexp(std::fabs(rhs), &e);   // f in [0.5, 1)
+			_exponent = e - 1;
+			while (f != Real(0)) {
+				f = std::ldexp(f, 32);
+				Real limb = std::floor(f);
+				_limb.push_back(static_cast<uint32_t>(limb));
+				f -= limb;
+			}
+		}
+		// drop trailing zero limbs, and round to the precision of the type
+		while (!_limb.empty() && _limb.back() == 0) _limb.pop_back();
+		if (_limb.size() > nlimbs) {
+			Limbs w(_limb.rbegin(), _limb.rend());
+			round_and_pack(w, lsbExponent(), false);
 		}
 		return *this;
 	}
@@ -314,7 +657,18 @@ protected:
 			v = (_sign ? -std::numeric_limits<Real>::infinity() : +std::numeric_limits<Real>::infinity());
 			break;
 		case FloatingPointState::Normal:
-			v = Real(sign()) * std::pow(Real(2.0), Real(scale())) * Real(significant());
+			{
+				// the leading 64 bits, with the remaining limbs jammed into the lsb when the target
+				// has fewer bits, so that the conversion of the integer rounds correctly
+				uint64_t top = uint64_t(_limb[0]) << 32;
+				if (_limb.size() > 1) top |= _limb[1];
+				bool sticky{ false };
+				for (size_t i = 2; i < _limb.size(); ++i) sticky = sticky || (_limb[i] != 0);
+				if (sticky && std::numeric_limits<Real>::digits < 64) top |= 1u;
+				v = std::ldexp(static_cast<Real>(top), static_cast<int>(std::clamp<int64_t>(_exponent - 63, -100000, 100000)));
+				if (_sign) v = -v;
+			}
+			break;
 		}
 		return v;
 	}
@@ -343,18 +697,63 @@ private:
 
 template<unsigned nlimbs>
 inline efloat<nlimbs> abs(const efloat<nlimbs>& a) {
-	return a; // (a < 0 ? -a : a);
+	return (a.isneg() ? -a : a);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// stream operators
 
 // read a efloat ASCII format and make a binary efloat out of it
+// format: [+-]digits[.digits][(e|E)[+-]digits], inf, nan
 template<unsigned nlimbs>
 bool parse(const std::string& txt, efloat<nlimbs>& value) {
-	bool bSuccess = false;
 	value.clear();
-	return bSuccess;
+	std::string number(txt);
+	std::regex decimal_regex("^[+-]?([0-9]+\\.?[0-9]*|\\.[0-9]+)([eE][+-]?[0-9]+)?$");
+	if (number == "inf" || number == "+inf" || number == "-inf") {
+		value.setinf(number[0] == '-');
+		return true;
+	}
+	if (number == "nan") {
+		value.setnan();
+		return true;
+	}
+	if (!std::regex_match(number, decimal_regex)) return false;
+	bool negative = (number[0] == '-');
+	size_t i = (number[0] == '-' || number[0] == '+' ? 1 : 0);
+	// accumulate the digits as an exact integer, in chunks of 9 digits
+	efloat<nlimbs> mantissa(0);
+	int64_t exponent{ 0 };
+	uint32_t chunk{ 0 }, chunkScale{ 1 };
+	bool fraction{ false };
+	for (; i < number.size() && number[i] != 'e' && number[i] != 'E'; ++i) {
+		if (number[i] == '.') {
+			fraction = true;
+			continue;
+		}
+		chunk = chunk * 10 + static_cast<uint32_t>(number[i] - '0');
+		chunkScale *= 10;
+		if (fraction) --exponent;
+		if (chunkScale == 1'000'000'000) {
+			mantissa *= efloat<nlimbs>(chunkScale);
+			mantissa += efloat<nlimbs>(chunk);
+			chunk = 0;
+			chunkScale = 1;
+		}
+	}
+	if (chunkScale > 1) {
+		mantissa *= efloat<nlimbs>(chunkScale);
+		mantissa += efloat<nlimbs>(chunk);
+	}
+	if (i < number.size()) exponent += std::stoll(number.substr(i + 1));
+	efloat<nlimbs> power(1), base(10);
+	for (uint64_t e = static_cast<uint64_t>(exponent < 0 ? -exponent : exponent); e > 0; e >>= 1) {
+		if (e & 1) power *= base;
+		if (e > 1) base *= base;
+	}
+	if (exponent > 0) mantissa *= power; else if (exponent < 0) mantissa /= power;
+	value = (negative ? -mantissa : mantissa);
+	return true;
 }
 
 // generate an efloat format ASCII format
@@ -374,12 +773,11 @@ inline std::ostream& operator<<(std::ostream& ostr, const efloat<nlimbs>& rhs) {
 		ss << "nan(snan)";
 	}
 	else {
-		std::streamsize prec = ostr.precision();
 		std::streamsize width = ostr.width();
 		std::ios_base::fmtflags ff;
 		ff = ostr.flags();
 		ss.flags(ff);
-		ss << std::setw(width) << std::setprecision(prec) << "TBD";
+		ss << std::setw(width) << to_decimal_string(rhs, ostr.precision(), ff);
 	}
 
 	return ostr << ss.str();
@@ -402,10 +800,11 @@ inline std::istream& operator>>(std::istream& istr, efloat<nlimbs>& p) {
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // efloat - efloat binary logic operators
 
-// equal: precondition is that the storage is properly nulled in all arithmetic paths
+// equal: NaN is unordered and compares unequal to everything
 template<unsigned nlimbs>
 inline bool operator==(const efloat<nlimbs>& lhs, const efloat<nlimbs>& rhs) {
-	return true;
+	if (lhs.isnan() || rhs.isnan()) return false;
+	return lhs.compare(rhs) == 0;
 }
 template<unsigned nlimbs>
 inline bool operator!=(const efloat<nlimbs>& lhs, const efloat<nlimbs>& rhs) {
@@ -413,7 +812,8 @@ inline bool operator!=(const efloat<nlimbs>& lhs, const efloat<nlimbs>& rhs) {
 }
 template<unsigned nlimbs>
 inline bool operator< (const efloat<nlimbs>& lhs, const efloat<nlimbs>& rhs) {
-	return false; // lhs and rhs are the same
+	if (lhs.isnan() || rhs.isnan()) return false;
+	return lhs.compare(rhs) < 0;
 }
 template<unsigned nlimbs>
 inline bool operator> (const efloat<nlimbs>& lhs, const efloat<nlimbs>& rhs) {
@@ -425,12 +825,11 @@ inline bool operator<=(const efloat<nlimbs>& lhs, const efloat<nlimbs>& rhs) {
 }
 template<unsigned nlimbs>
 inline bool operator>=(const efloat<nlimbs>& lhs, const efloat<nlimbs>& rhs) {
-	return !operator< (lhs, rhs);
+	return operator< (rhs, lhs) || operator==(lhs, rhs);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // efloat - literal binary logic operators
-// equal: precondition is that the byte-storage is properly nulled in all arithmetic paths
 template<unsigned nlimbs>
 inline bool operator==(const efloat<nlimbs>& lhs, double rhs) {
 	return operator==(lhs, efloat<nlimbs>(rhs));
@@ -453,12 +852,11 @@ inline bool operator<=(const efloat<nlimbs>& lhs, double rhs) {
 }
 template<unsigned nlimbs>
 inline bool operator>=(const efloat<nlimbs>& lhs, double rhs) {
-	return !operator< (lhs, rhs);
+	return operator> (lhs, rhs) || operator==(lhs, rhs);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // literal - efloat binary logic operators
-// precondition is that the byte-storage is properly nulled in all arithmetic paths
 
 template<unsigned nlimbs>
 inline bool operator==(double lhs, const efloat<nlimbs>& rhs) {
@@ -482,7 +880,7 @@ inline bool operator<=(double lhs, const efloat<nlimbs>& rhs) {
 }
 template<unsigned nlimbs>
 inline bool operator>=(double lhs, const efloat<nlimbs>& rhs) {
-	return !operator< (lhs, rhs);
+	return operator> (lhs, rhs) || operator==(lhs, rhs);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@
 
 #include <universal/number/einteger/exceptions.hpp>
 #include <universal/number/einteger/einteger_fwd.hpp>
+#include <universal/number/einteger/multiplication.hpp>
 
 // supporting types and functions
 #include <universal/native/ieee754.hpp>
@@ -277,24 +278,14 @@ public:
 			clear();
 			return *this;
 		}
-		einteger base(*this);
-		bool ls = sign();
-		unsigned ll = limbs();
-		bool rs = rhs.sign();
-		unsigned rl = rhs.limbs();
-
-		clear();
-		std::uint64_t segment(0);
-		for (unsigned i = 0; i < ll; ++i) {
-			for (unsigned j = 0; j < rl; ++j) {
-				segment += static_cast<std::uint64_t>(base.block(i)) * static_cast<std::uint64_t>(rhs.block(j));
-				segment += block(i + j);
-				setblock(i + j, static_cast<bt>(segment));
-				segment >>= bitsInBlock;
-			}
-		}
-		if (segment != 0) setblock(ll + rl - 1, static_cast<bt>(segment));
-		setsign(ls ^ rs);
+		bool square = (this == &rhs) || (_block == rhs._block);
+		size_t ll = _block.size();
+		size_t rl = rhs._block.size();
+		std::vector<BlockType> product(ll + rl);
+		internal::limb_multiply(product.data(), _block.data(), ll, rhs._block.data(), rl, square);
+		_block.swap(product);
+		remove_leading_zeros();
+		setsign(sign() ^ rhs.sign());
 		return *this;
 	}
 	einteger& operator*=(long long rhs) {
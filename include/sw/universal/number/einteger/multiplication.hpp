@@ -0,0 +1,420 @@
+#pragma once
+// multiplication.hpp: subquadratic multiplication kernels for the limbs of an einteger
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*
+ * The kernels multiply unsigned magnitudes stored as little-endian arrays of limbs.
+ * The algorithm is selected by the length of the operands:
+ *   - schoolbook multiplication, and a squaring kernel that computes each cross product once,
+ *     below EINTEGER_KARATSUBA_THRESHOLD limbs
+ *   - Karatsuba, which replaces the four half-size products by three
+ *   - Toom-Cook 3-way at EINTEGER_TOOM3_THRESHOLD limbs and above, which replaces the nine
+ *     third-size products by five, evaluated at 0, 1, -1, 2, and infinity
+ * Operands of very different length are cut into chunks of the length of the shorter operand.
+ *
+ * The temporaries of all recursion levels are carved out of a single scratch buffer that
+ * is sized once for the top-level product and reused by subsequent multiplications.
+ */
+
+// crossover points, in limbs, between the multiplication algorithms
+#if !defined(EINTEGER_KARATSUBA_THRESHOLD)
+#define EINTEGER_KARATSUBA_THRESHOLD 32
+#endif
+#if !defined(EINTEGER_TOOM3_THRESHOLD)
+#define EINTEGER_TOOM3_THRESHOLD 250
+#endif
+
+namespace sw { namespace universal {
+
+	// the sums of the halves must be shorter than the operands for the recursion to terminate
+	static_assert(EINTEGER_KARATSUBA_THRESHOLD >= 4, "EINTEGER_KARATSUBA_THRESHOLD must be at least 4 limbs");
+
+	namespace internal {
+
+		// bump allocator over a buffer of limbs; allocations are released in LIFO order by resetting the mark
+		template<typename BlockType>
+		class limb_scratch {
+		public:
+			explicit limb_scratch(std::vector<BlockType>& storage) : _storage(storage), _top(0) {}
+			BlockType* allocate(size_t n) {
+				BlockType* p = _storage.data() + _top;
+				_top += n;
+				return p;
+			}
+			size_t mark() const noexcept { return _top; }
+			void release(size_t mark) noexcept { _top = mark; }
+		private:
+			std::vector<BlockType>& _storage;
+			size_t _top;
+		};
+
+		// upper bound on the scratch limbs used by a product with n-limb operands
+		inline size_t limb_scratch_size(size_t n) {
+			size_t size = 64;
+			while (n >= static_cast<size_t>(EINTEGER_KARATSUBA_THRESHOLD)) {
+				size += 6 * n + 64;
+				n = (n + 1) / 2 + 1;   // the operands of the middle product of Karatsuba
+			}
+			return size;
+		}
+
+		template<typename BlockType>
+		inline void limb_zero(BlockType* r, size_t n) {
+			for (size_t i = 0; i < n; ++i) r[i] = BlockType(0);
+		}
+
+		template<typename BlockType>
+		inline void limb_copy(BlockType* r, const BlockType* a, size_t n) {
+			for (size_t i = 0; i < n; ++i) r[i] = a[i];
+		}
+
+		// r[0, n) = a[0, na) + b[0, nb) with na, nb <= n, returns the carry
+		template<typename BlockType>
+		inline BlockType limb_add(BlockType* r, size_t n, const BlockType* a, size_t na, const BlockType* b, size_t nb) {
+			constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+			std::uint64_t carry{ 0 };
+			for (size_t i = 0; i < n; ++i) {
+				carry += (i < na ? static_cast<std::uint64_t>(a[i]) : 0ull) + (i < nb ? static_cast<std::uint64_t>(b[i]) : 0ull);
+				r[i] = static_cast<BlockType>(carry);
+				carry >>= bitsInBlock;
+			}
+			return static_cast<BlockType>(carry);
+		}
+
+		// r[0, n) += a[0, na) with na <= n, returns the carry out of r[n-1]
+		template<typename BlockType>
+		inline BlockType limb_add_to(BlockType* r, size_t n, const BlockType* a, size_t na) {
+			constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+			std::uint64_t carry{ 0 };
+			size_t i = 0;
+			for (; i < na; ++i) {
+				carry += static_cast<std::uint64_t>(r[i]) + static_cast<std::uint64_t>(a[i]);
+				r[i] = static_cast<BlockType>(carry);
+				carry >>= bitsInBlock;
+			}
+			for (; carry != 0 && i < n; ++i) {
+				carry += static_cast<std::uint64_t>(r[i]);
+				r[i] = static_cast<BlockType>(carry);
+				carry >>= bitsInBlock;
+			}
+			return static_cast<BlockType>(carry);
+		}
+
+		// r[0, n) -= a[0, na) with na <= n, modulo the base raised to n: returns the borrow out of r[n-1]
+		template<typename BlockType>
+		inline BlockType limb_sub_from(BlockType* r, size_t n, const BlockType* a, size_t na) {
+			constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+			std::uint64_t borrow{ 0 };
+			size_t i = 0;
+			for (; i < na; ++i) {
+				borrow = static_cast<std::uint64_t>(r[i]) - static_cast<std::uint64_t>(a[i]) - borrow;
+				r[i] = static_cast<BlockType>(borrow);
+				borrow = (borrow >> bitsInBlock) & 0x1u;
+			}
+			for (; borrow != 0 && i < n; ++i) {
+				borrow = static_cast<std::uint64_t>(r[i]) - borrow;
+				r[i] = static_cast<BlockType>(borrow);
+				borrow = (borrow >> bitsInBlock) & 0x1u;
+			}
+			return static_cast<BlockType>(borrow);
+		}
+
+		// compares a[0, n) and b[0, n): returns 1 if a > b, 0 if equal, -1 if a < b
+		template<typename BlockType>
+		inline int limb_compare(const BlockType* a, const BlockType* b, size_t n) {
+			for (size_t i = n; i > 0; --i) {
+				if (a[i - 1] != b[i - 1]) return (a[i - 1] > b[i - 1] ? 1 : -1);
+			}
+			return 0;
+		}
+
+		// r[0, n) = a[0, n) << 1, the bit shifted out of a[n-1] is dropped
+		template<typename BlockType>
+		inline void limb_shift_left1(BlockType* r, const BlockType* a, size_t n) {
+			constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+			BlockType carry{ 0 };
+			for (size_t i = 0; i < n; ++i) {
+				BlockType next = static_cast<BlockType>(a[i] >> (bitsInBlock - 1));
+				r[i] = static_cast<BlockType>((a[i] << 1) | carry);
+				carry = next;
+			}
+		}
+
+		// r[0, n) = r[0, n) >> 1
+		template<typename BlockType>
+		inline void limb_shift_right1(BlockType* r, size_t n) {
+			constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+			for (size_t i = 0; i + 1 < n; ++i) {
+				r[i] = static_cast<BlockType>((r[i] >> 1) | (r[i + 1] << (bitsInBlock - 1)));
+			}
+			if (n > 0) r[n - 1] = static_cast<BlockType>(r[n - 1] >> 1);
+		}
+
+		// r[0, n) = r[0, n) / 3, the division must be exact
+		template<typename BlockType>
+		inline void limb_divide_by_3(BlockType* r, size_t n) {
+			constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+			std::uint64_t remainder{ 0 };
+			for (size_t i = n; i > 0; --i) {
+				std::uint64_t dividend = (remainder << bitsInBlock) | static_cast<std::uint64_t>(r[i - 1]);
+				r[i - 1] = static_cast<BlockType>(dividend / 3);
+				remainder = dividend % 3;
+			}
+		}
+
+		// two's complement negation of r[0, n)
+		template<typename BlockType>
+		inline void limb_negate(BlockType* r, size_t n) {
+			constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+			std::uint64_t carry{ 1 };
+			for (size_t i = 0; i < n; ++i) {
+				carry += static_cast<std::uint64_t>(static_cast<BlockType>(~r[i]));
+				r[i] = static_cast<BlockType>(carry);
+				carry >>= bitsInBlock;
+			}
+		}
+
+		// r = |a - b| for a[0, n) and b[0, n): returns true if a < b
+		template<typename BlockType>
+		inline bool limb_abs_difference(BlockType* r, const BlockType* a, const BlockType* b, size_t n) {
+			bool negative = (limb_compare(a, b, n) < 0);
+			if (negative) std::swap(a, b);
+			limb_copy(r, a, n);
+			limb_sub_from(r, n, b, n);
+			return negative;
+		}
+
+		// schoolbook multiplication: r[0, na + nb) = a[0, na) * b[0, nb)
+		template<typename BlockType>
+		inline void limb_mul_basecase(BlockType* r, const BlockType* a, size_t na, const BlockType* b, size_t nb) {
+			constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+			limb_zero(r, na + nb);
+			for (size_t j = 0; j < nb; ++j) {
+				std::uint64_t bj = b[j];
+				if (bj == 0) continue;
+				std::uint64_t carry{ 0 };
+				for (size_t i = 0; i < na; ++i) {
+					carry += static_cast<std::uint64_t>(a[i]) * bj + static_cast<std::uint64_t>(r[i + j]);
+					r[i + j] = static_cast<BlockType>(carry);
+					carry >>= bitsInBlock;
+				}
+				r[na + j] = static_cast<BlockType>(carry);
+			}
+		}
+
+		// schoolbook squaring: r[0, 2n) = a[0, n)^2, the cross products a_i * a_j, i < j, are computed once and doubled
+		template<typename BlockType>
+		inline void limb_sqr_basecase(BlockType* r, const BlockType* a, size_t n) {
+			constexpr unsigned bitsInBlock = sizeof(BlockType) * 8;
+			limb_zero(r, 2 * n);
+			for (size_t i = 0; i + 1 < n; ++i) {
+				std::uint64_t ai = a[i];
+				if (ai == 0) continue;
+				std::uint64_t carry{ 0 };
+				for (size_t j = i + 1; j < n; ++j) {
+					carry += ai * static_cast<std::uint64_t>(a[j]) + static_cast<std::uint64_t>(r[i + j]);
+					r[i + j] = static_cast<BlockType>(carry);
+					carry >>= bitsInBlock;
+				}
+				r[i + n] = static_cast<BlockType>(carry);
+			}
+			limb_shift_left1(r, r, 2 * n);
+			std::uint64_t carry{ 0 };
+			for (size_t i = 0; i < n; ++i) {
+				std::uint64_t square = static_cast<std::uint64_t>(a[i]) * static_cast<std::uint64_t>(a[i]);
+				carry += static_cast<std::uint64_t>(r[2 * i]) + (square & BlockType(~BlockType(0)));
+				r[2 * i] = static_cast<BlockType>(carry);
+				carry >>= bitsInBlock;
+				carry += static_cast<std::uint64_t>(r[2 * i + 1]) + (square >> bitsInBlock);
+				r[2 * i + 1] = static_cast<BlockType>(carry);
+				carry >>= bitsInBlock;
+			}
+		}
+
+		template<typename BlockType>
+		void limb_mul(BlockType* r, const BlockType* a, size_t na, const BlockType* b, size_t nb, bool square, limb_scratch<BlockType>& scratch);
+
+		// Karatsuba: with a = a1 B^k + a0 and b = b1 B^k + b0,
+		// a * b = a1 b1 B^2k + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) B^k + a0 b0
+		template<typename BlockType>
+		void limb_mul_karatsuba(BlockType* r, const BlockType* a, size_t na, const BlockType* b, size_t nb, bool square, limb_scratch<BlockType>& scratch) {
+			size_t k = (na + 1) / 2;   // na >= nb > na / 2
+			size_t na1 = na - k, nb1 = (nb > k ? nb - k : 0);
+			size_t nb0 = (nb > k ? k : nb);
+			size_t mark = scratch.mark();
+
+			// the outer products go directly into their place in the result
+			limb_mul(r, a, k, b, nb0, square, scratch);
+			limb_zero(r + k + nb0, na + nb - k - nb0);
+			if (nb1 > 0) limb_mul(r + 2 * k, a + k, na1, b + k, nb1, square, scratch);
+
+			// middle product of the sums, k + 1 limbs each
+			BlockType* sa = scratch.allocate(k + 1);
+			BlockType* sb = (square ? sa : scratch.allocate(k + 1));
+			BlockType* t  = scratch.allocate(2 * k + 2);
+			sa[k] = limb_add(sa, k, a, k, a + k, na1);
+			if (!square) sb[k] = limb_add(sb, k, b, nb0, b + k, nb1);
+			limb_mul(t, sa, k + 1, sb, k + 1, square, scratch);
+			limb_sub_from(t, 2 * k + 2, r, k + nb0);
+			if (nb1 > 0) limb_sub_from(t, 2 * k + 2, r + 2 * k, na1 + nb1);
+			// the middle term is smaller than the product, trim it to the limbs that remain above B^k
+			size_t nt = 2 * k + 2;
+			while (nt > 0 && t[nt - 1] == 0) --nt;
+			limb_add_to(r + k, na + nb - k, t, nt);
+			scratch.release(mark);
+		}
+
+		// Toom-Cook 3-way: a and b are split in three parts of k limbs, the product polynomial of degree 4
+		// is evaluated at 0, 1, -1, 2, and infinity, and interpolated with the sequence of Bodrato.
+		// The intermediate values are kept in two's complement on w limbs, which covers their range.
+		template<typename BlockType>
+		void limb_mul_toom3(BlockType* r, const BlockType* a, size_t na, const BlockType* b, size_t nb, bool square, limb_scratch<BlockType>& scratch) {
+			size_t k = (na + 2) / 3;   // na >= nb > 2k
+			size_t na2 = na - 2 * k, nb2 = nb - 2 * k;
+			size_t w = 2 * k + 3;
+			size_t mark = scratch.mark();
+
+			// evaluation of a and b at 1, -1, and 2
+			auto evaluate = [&](const BlockType* x, size_t n2, BlockType* p1, BlockType* pm1, BlockType* p2) -> bool {
+				const BlockType* x0 = x;
+				const BlockType* x1 = x + k;
+				const BlockType* x2 = x + 2 * k;
+				// p1 = x0 + x2, pm1 = |x0 + x2 - x1|, p1 += x1
+				p1[k] = limb_add(p1, k, x0, k, x2, n2);
+				size_t x1mark = scratch.mark();
+				BlockType* x1x = scratch.allocate(k + 1);   // x1 extended to k + 1 limbs
+				limb_copy(x1x, x1, k);
+				x1x[k] = 0;
+				bool negative = limb_abs_difference(pm1, p1, x1x, k + 1);
+				scratch.release(x1mark);
+				limb_add_to(p1, k + 1, x1, k);
+				// p2 = x0 + 2 x1 + 4 x2 = ((x2 * 2 + x1) * 2) + x0
+				limb_zero(p2, k + 1);
+				limb_copy(p2, x2, n2);
+				limb_shift_left1(p2, p2, k + 1);
+				limb_add_to(p2, k + 1, x1, k);
+				limb_shift_left1(p2, p2, k + 1);
+				limb_add_to(p2, k + 1, x0, k);
+				return negative;
+			};
+
+			BlockType* ap1  = scratch.allocate(k + 1);
+			BlockType* apm1 = scratch.allocate(k + 1);
+			BlockType* ap2  = scratch.allocate(k + 1);
+			bool aNegative = evaluate(a, na2, ap1, apm1, ap2);
+			BlockType* bp1 = ap1, * bpm1 = apm1, * bp2 = ap2;
+			bool bNegative = aNegative;
+			if (!square) {
+				bp1  = scratch.allocate(k + 1);
+				bpm1 = scratch.allocate(k + 1);
+				bp2  = scratch.allocate(k + 1);
+				bNegative = evaluate(b, nb2, bp1, bpm1, bp2);
+			}
+
+			// pointwise products: v0 and vinf go directly into their place in the result
+			BlockType* v1  = scratch.allocate(w);
+			BlockType* vm1 = scratch.allocate(w);
+			BlockType* v2  = scratch.allocate(w);
+			limb_zero(v1 + 2 * k + 2, 1);
+			limb_zero(vm1 + 2 * k + 2, 1);
+			limb_zero(v2 + 2 * k + 2, 1);
+			limb_mul(v1, ap1, k + 1, bp1, k + 1, square, scratch);
+			limb_mul(vm1, apm1, k + 1, bpm1, k + 1, square, scratch);
+			if (aNegative != bNegative) limb_negate(vm1, w);
+			limb_mul(v2, ap2, k + 1, bp2, k + 1, square, scratch);
+			limb_mul(r, a, k, b, k, square, scratch);                       // v0
+			limb_mul(r + 4 * k, a + 2 * k, na2, b + 2 * k, nb2, square, scratch);  // vinf
+			const BlockType* v0 = r;
+			const BlockType* vinf = r + 4 * k;
+			size_t nvinf = na2 + nb2;
+
+			// interpolation
+			// r3 = (v2 - vm1) / 3
+			limb_sub_from(v2, w, vm1, w);
+			limb_divide_by_3(v2, w);
+			// r1 = (v1 - vm1) / 2
+			limb_sub_from(v1, w, vm1, w);
+			limb_shift_right1(v1, w);
+			// r2 = vm1 - v0
+			limb_sub_from(vm1, w, v0, 2 * k);
+			// r3 = (r3 - r2) / 2 - 2 vinf
+			limb_sub_from(v2, w, vm1, w);
+			limb_shift_right1(v2, w);
+			limb_sub_from(v2, w, vinf, nvinf);
+			limb_sub_from(v2, w, vinf, nvinf);
+			// r2 = r2 + r1 - vinf
+			limb_add_to(vm1, w, v1, w);
+			limb_sub_from(vm1, w, vinf, nvinf);
+			// r3 = r3 - r1, r1 = r1 - r3
+			limb_sub_from(v2, w, v1, w);
+			limb_sub_from(v1, w, v2, w);
+
+			// recomposition: r += c1 B^k + c2 B^2k + c3 B^3k, the coefficients are non-negative
+			size_t n = na + nb;
+			limb_zero(r + 2 * k, 2 * k);
+			auto accumulate = [&](size_t offset, const BlockType* c) {
+				size_t nc = w;
+				while (nc > 0 && c[nc - 1] == 0) --nc;
+				limb_add_to(r + offset, n - offset, c, nc);
+			};
+			accumulate(k, v1);
+			accumulate(2 * k, vm1);
+			accumulate(3 * k, v2);
+			scratch.release(mark);
+		}
+
+		// r[0, na + nb) = a[0, na) * b[0, nb); square indicates that a and b are the same operand
+		template<typename BlockType>
+		void limb_mul(BlockType* r, const BlockType* a, size_t na, const BlockType* b, size_t nb, bool square, limb_scratch<BlockType>& scratch) {
+			if (na < nb) {
+				std::swap(a, b);
+				std::swap(na, nb);
+			}
+			if (nb < static_cast<size_t>(EINTEGER_KARATSUBA_THRESHOLD)) {
+				if (square && na == nb) limb_sqr_basecase(r, a, na); else limb_mul_basecase(r, a, na, b, nb);
+			}
+			else if (2 * nb <= na) {
+				// unbalanced operands: multiply b by chunks of a of nb limbs
+				size_t mark = scratch.mark();
+				BlockType* t = scratch.allocate(2 * nb);
+				limb_zero(r, na + nb);
+				for (size_t offset = 0; offset < na; offset += nb) {
+					size_t nc = (na - offset < nb ? na - offset : nb);
+					limb_mul(t, a + offset, nc, b, nb, false, scratch);
+					limb_add_to(r + offset, na + nb - offset, t, nc + nb);
+				}
+				scratch.release(mark);
+			}
+			else if (nb < static_cast<size_t>(EINTEGER_TOOM3_THRESHOLD) || 3 * nb <= 2 * na + 2) {
+				limb_mul_karatsuba(r, a, na, b, nb, square, scratch);
+			}
+			else {
+				limb_mul_toom3(r, a, na, b, nb, square, scratch);
+			}
+		}
+
+		// r[0, na + nb) = a[0, na) * b[0, nb), using a scratch buffer that persists across calls
+		template<typename BlockType>
+		void limb_multiply(BlockType* r, const BlockType* a, size_t na, const BlockType* b, size_t nb, bool square) {
+			if (na < static_cast<size_t>(EINTEGER_KARATSUBA_THRESHOLD) || nb < static_cast<size_t>(EINTEGER_KARATSUBA_THRESHOLD)) {
+				if (square) limb_sqr_basecase(r, a, na); else limb_mul_basecase(r, a, na, b, nb);
+				return;
+			}
+			thread_local std::vector<BlockType> storage;
+			size_t size = limb_scratch_size(na > nb ? na : nb);
+			if (storage.size() < size) storage.resize(size);
+			limb_scratch<BlockType> scratch(storage);
+			limb_mul(r, a, na, b, nb, square, scratch);
+		}
+
+	}  // namespace internal
+
+}} // namespace sw::universal
@@ -38,6 +38,14 @@
 #define ERATIONAL_THROW_ARITHMETIC_EXCEPTION 0
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// defer the gcd normalization of the numerator/denominator pair
+// 0 keeps every result in lowest terms, a positive value lets the pair grow to that many
+// decimal digits before it is reduced, or until canonicalize() is called
+#if !defined(ERATIONAL_NORMALIZATION_THRESHOLD)
+#define ERATIONAL_NORMALIZATION_THRESHOLD 0
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////
 /// INCLUDE FILES that make up the library
 #include <universal/number/erational/exceptions.hpp>
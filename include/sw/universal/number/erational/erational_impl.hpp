@@ -37,8 +37,9 @@ public:
 	erational& operator=(const erational&) = default;
 	erational& operator=(erational&&) = default;
 
-	erational(std::int64_t n, std::uint64_t d) : negative{ false }, numerator { n }, denominator{ d } {
-		negative = ((n < 0) ^ (d < 0));
+	erational(std::int64_t n, std::uint64_t d) : negative{ n < 0 }, numerator{ n }, denominator{ d } {
+		numerator.setpos();
+		normalize();
 	}
 
 	// initializers for native types
@@ -119,50 +120,25 @@ public:
 
 	// arithmetic operators
 	erational& operator+=(const erational& rhs) {
-		edecimal a = (negative ? -numerator : numerator);
-		edecimal b = denominator;
-		edecimal c = (rhs.negative ? -rhs.numerator : rhs.numerator);
-		edecimal d = rhs.denominator;
-		if (denominator == rhs.denominator) {
-			edecimal num = a + c;
-			negative = num.isneg();
-			numerator = (negative ? -num : num);
-		}
-		else {
-			edecimal e = a * d + b * c;
-			edecimal f = b * d;
-			negative = e.isneg();
-			numerator = (negative ? -e : e);
-			denominator = f;
-		}
-		normalize();
-		return *this;
+		return accumulate(rhs, rhs.negative);
 	}
 	erational& operator-=(const erational& rhs) {
-		edecimal a = (negative ? -numerator : numerator);
-		edecimal b = denominator;
-		edecimal c = (rhs.negative ? -rhs.numerator : rhs.numerator);
-		edecimal d = rhs.denominator;
-		if (denominator == rhs.denominator) {
-			edecimal num = a - c;
-			negative = num.isneg();
-			numerator = (negative ? -num : num);
-		}
-		else {
-			edecimal e = a * d - b * c;
-			edecimal f = b * d;
-			negative = e.isneg();
-			numerator = (negative ? -e : e);
-			denominator = f;
-		}
-		normalize();
-		return *this;
+		return accumulate(rhs, !rhs.negative);
 	}
 	erational& operator*=(const erational& rhs) {
+		negative = (negative != rhs.negative);
+#if ERATIONAL_NORMALIZATION_THRESHOLD
 		numerator *= rhs.numerator;
 		denominator *= rhs.denominator;
-		negative = !((negative && rhs.negative) || (!negative && !rhs.negative));
-		normalize();
+		reduce_if_large();
+#else
+		// (a/b) * (c/d) with gcd(a, d) and gcd(c, b) removed first is in lowest terms when the operands are
+		edecimal g1 = gcd(numerator, rhs.denominator);
+		edecimal g2 = gcd(rhs.numerator, denominator);
+		numerator   = (numerator / g1) * (rhs.numerator / g2);
+		denominator = (denominator / g2) * (rhs.denominator / g1);
+		if (numerator.iszero()) setzero();
+#endif
 		return *this;
 	}
 	erational& operator/=(const erational& rhs) {
@@ -171,12 +147,25 @@ public:
 			throw erational_divide_by_zero();
 #else
 			std::cerr << "erational_divide_by_zero\n";
+			numerator = 0;
+			denominator = 0;
+			return *this;
 #endif
 		}
-		negative = !((negative && rhs.negative) || (!negative && !rhs.negative));
+		negative = (negative != rhs.negative);
+#if ERATIONAL_NORMALIZATION_THRESHOLD
+		edecimal c = rhs.numerator;  // rhs may alias *this
 		numerator *= rhs.denominator;
-		denominator *= rhs.numerator;
-		normalize();
+		denominator *= c;
+		reduce_if_large();
+#else
+		// (a/b) / (c/d) = (a/g1 * d/g2) / (b/g2 * c/g1) with g1 = gcd(a, c) and g2 = gcd(d, b)
+		edecimal g1 = gcd(numerator, rhs.numerator);
+		edecimal g2 = gcd(rhs.denominator, denominator);
+		numerator   = (numerator / g1) * (rhs.denominator / g2);
+		denominator = (denominator / g2) * (rhs.numerator / g1);
+		if (numerator.iszero()) setzero();
+#endif
 		return *this;
 	}
 
@@ -215,7 +204,6 @@ public:
 		std::regex erational_regex("[+-]*[0123456789]+");
 		if (std::regex_match(digits, erational_regex)) {
 			// found a erational representation
-			numerator.clear();
 			auto it = digits.begin();
 			if (*it == '-') {
 				setneg();
@@ -224,76 +212,123 @@ public:
 			else if (*it == '+') {
 				++it;
 			}
-			for (; it != digits.end(); ++it) {
-				uint8_t v;
-				switch (*it) {
-				case '0':
-					v = 0;
-					break;
-				case '1':
-					v = 1;
-					break;
-				case '2':
-					v = 2;
-					break;
-				case '3':
-					v = 3;
-					break;
-				case '4':
-					v = 4;
-					break;
-				case '5':
-					v = 5;
-					break;
-				case '6':
-					v = 6;
-					break;
-				case '7':
-					v = 7;
-					break;
-				case '8':
-					v = 8;
-					break;
-				case '9':
-					v = 9;
-					break;
-				default:
-					v = 0;
-				}
-				numerator.push_back(v);
-			}
-			std::reverse(numerator.begin(), numerator.end());
+			numerator.parse(std::string(it, digits.end()));
+			denominator = 1;
 			bSuccess = true;
 		}
 		return bSuccess;
 	}
 
+	// bring the numerator/denominator pair into lowest terms: a no-op unless normalization is deferred
+	erational& canonicalize() {
+		normalize();
+		return *this;
+	}
+
 protected:
 	// HELPER methods
 
 	// remove greatest common divisor out of the numerator/denominator pair
 	void normalize() {
-		edecimal a, b, r;
-		a = numerator; b = denominator;  // precondition is numerator and denominator are positive
-
-		if (b.iszero()) {
+		// precondition is numerator and denominator are positive
+		if (denominator.iszero()) {
 #if ERATIONAL_THROW_ARITHMETIC_EXCEPTION
 			throw erational_divide_by_zero();
 #else
 			std::cerr << "erational_divide_by_zero\n";
 			denominator = 0;
 			numerator = 0;
+			return;
+#endif
+		}
+		if (numerator.iszero()) {
+			setzero();
+			return;
+		}
+		edecimal g = gcd(numerator, denominator);
+		if (g != 1) {
+			numerator /= g;
+			denominator /= g;
+		}
+	}
+
+	// a/b +- c/d following Henrici: with g = gcd(b, d) the sum is formed over lcm(b, d) = b * (d/g), and
+	// only g can share a factor with the new numerator, so the final reduction is a gcd against g
+	erational& accumulate(const erational& rhs, bool subtrahend) {
+		edecimal a = (negative ? -numerator : numerator);
+		edecimal c = (subtrahend ? -rhs.numerator : rhs.numerator);
+		edecimal e, f;
+		if (denominator == rhs.denominator) {
+			e = a + c;
+			f = denominator;
+			setmagnitude(e, f);
+#if ERATIONAL_NORMALIZATION_THRESHOLD
+			reduce_if_large();
+#else
+			normalize();
 #endif
+			return *this;
+		}
+		edecimal g = gcd(denominator, rhs.denominator);
+		if (g == 1) {
+			e = a * rhs.denominator + denominator * c;
+			f = denominator * rhs.denominator;
 		}
-		while (a % b > 0) {
-			r = a % b;
-			a = b;
-			b = r;
+		else {
+			edecimal bg = denominator / g;
+			e = a * (rhs.denominator / g) + bg * c;
+#if ERATIONAL_NORMALIZATION_THRESHOLD
+			f = bg * rhs.denominator;
+#else
+			edecimal g2 = gcd(e, g);
+			if (g2 != 1) {
+				e /= g2;
+				f = bg * (rhs.denominator / g2);
+			}
+			else {
+				f = bg * rhs.denominator;
+			}
+#endif
 		}
-		numerator /= b;
-		denominator /= b;
+		setmagnitude(e, f);
+#if ERATIONAL_NORMALIZATION_THRESHOLD
+		reduce_if_large();
+#else
+		if (numerator.iszero()) setzero();
+#endif
+		return *this;
 	}
-	
+
+	// set the sign and magnitude from a signed numerator and a positive denominator
+	void setmagnitude(edecimal& e, edecimal& f) {
+		negative = e.isneg();
+		e.setpos();
+		numerator = std::move(e);
+		denominator = std::move(f);
+	}
+
+#if ERATIONAL_NORMALIZATION_THRESHOLD
+	// deferred normalization: reduce when the pair has grown past ERATIONAL_NORMALIZATION_THRESHOLD digits and
+	// past twice its size after the previous reduction, so a value whose lowest terms are already larger than
+	// the threshold does not pay for a gcd on every operation
+	void reduce_if_large() {
+		unsigned size = numerator.digits() + denominator.digits();
+		if (size > ERATIONAL_NORMALIZATION_THRESHOLD && size > 2 * reducedSize) {
+			normalize();
+			reducedSize = numerator.digits() + denominator.digits();
+		}
+	}
+#endif
+
+	// lowest terms copy for output and conversion
+	erational canonical() const {
+		erational c(*this);
+#if ERATIONAL_NORMALIZATION_THRESHOLD
+		c.normalize();
+#endif
+		return c;
+	}
+
 	////////////////////////////////////////////////////////////////////////////////////////////
 	// conversion helpers
 
@@ -308,7 +343,11 @@ protected:
 	// convert to ieee-754
 	template<typename Real,
 		typename = typename std::enable_if< std::is_floating_point<Real>::value, Real >::type>
-	Real to_ieee754() const { return Real(numerator) / Real(denominator); }
+	Real to_ieee754() const {
+		erational c = canonical();
+		Real v = Real(c.numerator) / Real(c.denominator);
+		return (negative ? -v : v);
+	}
 
 	template<typename SignedInt,
 		typename = typename std::enable_if< std::is_integral<SignedInt>::value, SignedInt >::type>
@@ -359,6 +398,9 @@ private:
 	bool negative;
 	edecimal numerator; // will be managed as a positive number
 	edecimal denominator; // will be managed as a positive number
+#if ERATIONAL_NORMALIZATION_THRESHOLD
+	unsigned reducedSize{ 0 }; // digits of the pair after the last deferred reduction
+#endif
 
 	friend std::ostream& operator<<(std::ostream& ostr, const erational& d);
 	friend std::istream& operator>>(std::istream& istr, erational& d);
@@ -391,8 +433,9 @@ inline std::string to_string(const erational& d) {
 inline std::ostream& operator<<(std::ostream& ostr, const erational& d) {
 	// make certain that setw and left/right operators work properly
 	std::stringstream str;
-	if (d.isneg()) str << '-';
-	str << d.numerator << '/' << d.denominator;
+	erational c = d.canonical();
+	if (c.isneg()) str << '-';
+	str << c.numerator << '/' << c.denominator;
 	return ostr << str.str();
 }
 
@@ -440,7 +483,13 @@ inline erational operator/(const erational& lhs, const erational& rhs) {
 
 // equality test
 bool operator==(const erational& lhs, const erational& rhs) {
+#if ERATIONAL_NORMALIZATION_THRESHOLD
+	// the pairs need not be in lowest terms, so compare the cross products
+	if (lhs.denominator == rhs.denominator) return lhs.numerator == rhs.numerator;
+	return lhs.numerator * rhs.denominator == rhs.numerator * lhs.denominator;
+#else
 	return lhs.numerator == rhs.numerator && lhs.denominator == rhs.denominator;
+#endif
 }
 // inequality test
 bool operator!=(const erational& lhs, const erational& rhs) {
@@ -12,6 +12,7 @@ namespace sw { namespace universal {
 template<unsigned maxLimbs> class ereal;
 template<unsigned maxLimbs> ereal<maxLimbs> abs(const ereal<maxLimbs>&);
 template<unsigned maxLimbs> ereal<maxLimbs> fabs(const ereal<maxLimbs>&);
+template<unsigned maxLimbs> bool parse(const std::string& number, ereal<maxLimbs>& v);
 
 }} // namespace sw::universal
 
@@ -12,10 +12,16 @@
 #include <regex>
 #include <vector>
 #include <map>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 
 // supporting types and functions
 #include <universal/native/ieee754.hpp>   // IEEE-754 decoders
+#include <universal/numerics/error_free_ops.hpp>
+#include <universal/internal/arena/limb_arena.hpp>
 #include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/number/shared/decimal_format.hpp>
 
 /*
 The ereal arithmetic can be configured to:
@@ -32,13 +38,23 @@ namespace sw { namespace universal {
 
 
 // ereal is a multi-component arbitrary-precision arithmetic type
+//
+// The value is an unevaluated sum of doubles, a floating-point expansion in the sense of Priest and Shewchuk.
+// The components are non-overlapping and stored in order of increasing magnitude, so the last limb is the
+// leading component that approximates the value. Sums, differences and products are exact as long as
+// the result fits in maxlimbs components; only the quotient, and results that need more than maxlimbs
+// components, are approximations. A result carries only as many components as it needs, so the
+// precision grows with cancellation and stays at a single double for simple values. The components
+// share the exponent range of double, so a value near 1 carries at most about 2000 bits.
 template<unsigned maxlimbs = 1024>
 class ereal {
+	using Limbs = internal::arena_vector<double>;
 public:
 	static constexpr unsigned maxNrLimbs = maxlimbs;
+	static_assert(maxlimbs > 0, "ereal needs at least one limb");
 
 	// constructor
-	ereal() : _limb{ 0 } { }
+	ereal() : _limb{ 0.0 } { }
 
 	ereal(const ereal&) = default;
 	ereal(ereal&&) = default;
@@ -82,38 +98,84 @@ public:
 	ereal(long double iv)                      noexcept { *this = iv; }
 	ereal& operator=(long double rhs)          noexcept { return convert_ieee754(rhs); }
 	explicit operator long double()       const noexcept { return convert_to_ieee754<long double>(); }
-#endif 
+#endif
 
 	// prefix operators
 	ereal operator-() const {
 		ereal negated(*this);
+		for (auto& v : negated._limb) v = -v;
 		return negated;
 	}
 
 	// arithmetic operators
 	ereal& operator+=(const ereal& rhs) {
-		return *this;
+		if (!isfinite() || !rhs.isfinite()) return setspecial(leading() + rhs.leading());
+		Limbs sum;
+		expansion_sum(_limb, rhs._limb, sum, false);
+		return normalize(sum);
 	}
 	ereal& operator+=(double rhs) {
-		return *this;
+		return operator+=(ereal(rhs));
 	}
 	ereal& operator-=(const ereal& rhs) {
-		return *this;
+		if (!isfinite() || !rhs.isfinite()) return setspecial(leading() - rhs.leading());
+		Limbs difference;
+		expansion_sum(_limb, rhs._limb, difference, true);
+		return normalize(difference);
 	}
 	ereal& operator-=(double rhs) {
-		return *this;
+		return operator-=(ereal(rhs));
 	}
 	ereal& operator*=(const ereal& rhs) {
-		return *this;
+		if (!isfinite() || !rhs.isfinite()) return setspecial(leading() * rhs.leading());
+		if (iszero() || rhs.iszero()) return setsignedzero(leading() * rhs.leading());
+		// the shorter operand drives the partial products: each one is exact, and the running
+		// sum is compressed so that it stays at the size of the exact product
+		const Limbs& a = (_limb.size() >= rhs._limb.size() ? _limb : rhs._limb);
+		const Limbs& b = (_limb.size() >= rhs._limb.size() ? rhs._limb : _limb);
+		Limbs product, partial, sum;
+		for (double bj : b) {
+			scale_expansion(a, bj, partial);
+			expansion_sum(product, partial, sum, false);
+			compress(sum, product);
+		}
+		return normalize(product);
 	}
 	ereal& operator*=(double rhs) {
-		return *this;
+		return operator*=(ereal(rhs));
 	}
 	ereal& operator/=(const ereal& rhs) {
-		return *this;
+		if (!isfinite() || !rhs.isfinite() || rhs.iszero()) {
+#if EREAL_THROW_ARITHMETIC_EXCEPTION
+			if (rhs.iszero() && isfinite()) throw ereal_divide_by_zero();
+#endif
+			return setspecial(leading() / rhs.leading());
+		}
+		if (iszero()) return setsignedzero(leading() / rhs.leading());
+		// long division: every step divides the leading components of the remainder and the divisor
+		// and removes the exact product of that quotient digit and the divisor from the remainder
+		const double divisor = rhs.leading();
+		Limbs quotient, remainder(_limb), partial, difference, sum;
+		for (unsigned i = 0; i < maxlimbs + 1u && remainder.back() != 0.0; ++i) {
+			double q = remainder.back() / divisor;
+			if (q == 0.0 || !std::isfinite(q)) break;
+			scale_expansion(rhs._limb, q, partial);
+			expansion_sum(remainder, partial, difference, true);
+			compress(difference, remainder);
+			quotient.push_back(q);
+		}
+		// the quotient digits come out in decreasing magnitude and may overlap by a bit
+		std::reverse(quotient.begin(), quotient.end());
+		Limbs digit(1);
+		for (double q : quotient) {
+			digit[0] = q;
+			expansion_sum(sum, digit, difference, false);
+			sum.swap(difference);
+		}
+		return normalize(sum);
 	}
 	ereal& operator/=(double rhs) {
-		return *this;
+		return operator/=(ereal(rhs));
 	}
 
 	// modifiers
@@ -121,31 +183,138 @@ public:
 	void setzero() { clear(); }
 
 	ereal& assign(const std::string& txt) {
+		if (!parse(txt, *this)) setspecial(std::numeric_limits<double>::quiet_NaN());
 		return *this;
 	}
 
 	// selectors
-	bool iszero() const noexcept { return _limb[0] == 0.0; }
-	bool isone()  const noexcept { return _limb[0] == 1.0; }
-	bool ispos()  const noexcept { return _limb[0] > 0.0; }
-	bool isneg()  const noexcept { return _limb[0] < 0.0; }
-	bool isinf()  const noexcept { return false; }
-	bool isnan()  const noexcept { return false; }
-	bool isqnan()  const noexcept { return false; }
-	bool issnan()  const noexcept { return false; }
+	bool iszero() const noexcept { return leading() == 0.0; }
+	bool isone()  const noexcept { return _limb.size() == 1 && leading() == 1.0; }
+	bool ispos()  const noexcept { return leading() > 0.0; }
+	bool isneg()  const noexcept { return leading() < 0.0; }
+	bool isinf()  const noexcept { return std::isinf(leading()); }
+	bool isnan()  const noexcept { return std::isnan(leading()); }
+	bool isqnan()  const noexcept { return isnan() && nan_type() == NAN_TYPE_QUIET; }
+	bool issnan()  const noexcept { return isnan() && nan_type() == NAN_TYPE_SIGNALLING; }
+	bool isfinite() const noexcept { return std::isfinite(leading()); }
 
 
 	// value information selectors
 	int     sign()        const noexcept { return (isneg() ? -1 : 1); }
-	int64_t scale()       const noexcept { return sw::universal::scale(_limb[0]); }
-	double  significant() const noexcept { return _limb[0]; }
-	//std::vector<uint32_t> bits() const { return _limb; }
+	int64_t scale()       const noexcept { return sw::universal::scale(leading()); }
+	double  significant() const noexcept { return leading(); }
+	// number of components the value carries
+	size_t  precision()   const noexcept { return _limb.size(); }
+	// components in order of increasing magnitude
+	std::vector<double> limbs() const { return std::vector<double>(_limb.begin(), _limb.end()); }
 
 protected:
-	std::vector<double> _limb;     // components of the real value
+	Limbs _limb;     // components of the real value, in order of increasing magnitude
 
 	// HELPER methods
 
+	double leading() const noexcept { return _limb.back(); }
+
+	int nan_type() const noexcept {
+		int type{ NAN_TYPE_NEITHER };
+		checkNaN(leading(), type);
+		return type;
+	}
+
+	// infinities and NaNs are carried by a single component and follow the IEEE-754 rules of double
+	ereal& setspecial(double v) noexcept {
+		_limb.clear();
+		_limb.push_back(v);
+		return *this;
+	}
+	ereal& setsignedzero(double v) noexcept {
+		return setspecial(std::copysign(0.0, v));
+	}
+
+	// h = e + f, or e - f, with e and f non-overlapping and sorted by increasing magnitude (Shewchuk)
+	static void expansion_sum(const Limbs& e, const Limbs& f, Limbs& h, bool subtract) {
+		h.clear();
+		h.reserve(e.size() + f.size());
+		size_t i = 0, j = 0;
+		double q{ 0.0 };
+		bool first = true;
+		auto next = [&]() {
+			double g;
+			if (j == f.size() || (i < e.size() && std::abs(e[i]) < std::abs(f[j]))) {
+				g = e[i++];
+			}
+			else {
+				g = (subtract ? -f[j++] : f[j++]);
+			}
+			return g;
+		};
+		while (i < e.size() || j < f.size()) {
+			double g = next();
+			if (g == 0.0) continue;
+			if (first) {
+				q = g;
+				first = false;
+				continue;
+			}
+			volatile double r;
+			q = two_sum(q, g, r);
+			if (r != 0.0) h.push_back(double(r));
+		}
+		if (q != 0.0 || h.empty()) h.push_back(q);
+	}
+
+	// h = e * b exactly, with e non-overlapping and sorted by increasing magnitude (Shewchuk)
+	static void scale_expansion(const Limbs& e, double b, Limbs& h) {
+		h.clear();
+		h.reserve(2 * e.size());
+		volatile double r;
+		double q = two_prod(e[0], b, r);
+		if (r != 0.0) h.push_back(double(r));
+		for (size_t i = 1; i < e.size(); ++i) {
+			volatile double lo;
+			double hi = two_prod(e[i], b, lo);
+			double sum = two_sum(q, lo, r);
+			if (r != 0.0) h.push_back(double(r));
+			q = quick_two_sum(hi, sum, r);
+			if (r != 0.0) h.push_back(double(r));
+		}
+		if (q != 0.0 || h.empty()) h.push_back(q);
+	}
+
+	// h = e with the fewest components, the largest of which approximates the sum (Shewchuk)
+	static void compress(const Limbs& e, Limbs& h) {
+		size_t m = e.size();
+		Limbs g(m);
+		size_t bottom = m - 1;
+		volatile double r;
+		double q = e[m - 1];
+		for (size_t i = m - 1; i > 0; --i) {
+			double sum = quick_two_sum(q, e[i - 1], r);
+			if (r != 0.0) {
+				g[bottom--] = sum;
+				q = r;
+			}
+			else {
+				q = sum;
+			}
+		}
+		g[bottom] = q;
+		h.clear();
+		for (size_t i = bottom + 1; i < m; ++i) {
+			double sum = quick_two_sum(g[i], q, r);
+			if (r != 0.0) h.push_back(double(r));
+			q = sum;
+		}
+		h.push_back(q);
+	}
+
+	// compress the expansion and keep the maxlimbs leading components
+	ereal& normalize(const Limbs& e) {
+		compress(e, _limb);
+		if (_limb.size() > maxlimbs) _limb.erase(_limb.begin(), _limb.end() - maxlimbs);
+		return *this;
+	}
+
 	// convert arithmetic types into an elastic floating-point
 	template<typename SignedInt,
 		typename = typename std::enable_if< std::is_integral<SignedInt>::value, SignedInt >::type>
@@ -154,7 +323,9 @@ protected:
 			setzero();
 		}
 		else {
-
+			uint64_t magnitude = (v < 0 ? 0ull - static_cast<uint64_t>(v) : static_cast<uint64_t>(v));
+			convert_unsigned(magnitude);
+			if (v < 0) for (auto& c : _limb) c = -c;
 		}
 		return *this;
 	}
@@ -166,7 +337,15 @@ protected:
 			setzero();
 		}
 		else {
-
+			// both halves are exact doubles and their sum is exact as a two-component expansion
+			uint64_t u = static_cast<uint64_t>(v);
+			double hi = std::ldexp(static_cast<double>(u >> 32), 32);
+			double lo = static_cast<double>(u & 0xFFFF'FFFFull);
+			volatile double r;
+			double sum = two_sum(hi, lo, r);
+			_limb.clear();
+			if (r != 0.0) _limb.push_back(double(r));
+			_limb.push_back(sum);
 		}
 		return *this;
 	}
@@ -174,32 +353,49 @@ protected:
 	template<typename Real,
 		typename = typename std::enable_if< std::is_floating_point<Real>::value, Real >::type>
 	ereal& convert_ieee754(Real rhs) noexcept {
-		clear();
-		_limb[0] = rhs;
+		double hi = static_cast<double>(rhs);
+		setspecial(hi);
+		if (std::isfinite(hi)) {
+			// a long double has up to 11 more significand bits than the leading double
+			double lo = static_cast<double>(rhs - static_cast<Real>(hi));
+			if (lo != 0.0) _limb.insert(_limb.begin(), lo);
+		}
 		return *this;
 	}
 
-
-	// convert elastic floating-point to native ieee-754
+	// convert elastic floating-point to native ieee-754, rounded to nearest, ties to even
 	template<typename Real,
 		typename = typename std::enable_if< std::is_floating_point<Real>::value, Real >::type>
 	Real convert_to_ieee754() const noexcept {
-		return _limb[0];
+		if (!isfinite() || _limb.size() == 1) return static_cast<Real>(leading());
+		Real s{ 0 };
+		for (double c : _limb) s += static_cast<Real>(c);
+		// s is within a few ulps: step to the neighbor while the exact residual exceeds half an ulp
+		for (int i = 0; i < 8 && std::isfinite(s); ++i) {
+			ereal residual = *this - ereal(s);
+			if (residual.iszero()) break;
+			Real neighbor = std::nextafter(s, residual.isneg() ? -std::numeric_limits<Real>::infinity() : std::numeric_limits<Real>::infinity());
+			if (!std::isfinite(neighbor)) break;
+			ereal halfUlp = (ereal(neighbor) - ereal(s)) * ereal(0.5);
+			ereal excess = (residual.isneg() ? -residual : residual) - (halfUlp.isneg() ? -halfUlp : halfUlp);
+			if (excess.isneg()) break;
+			if (excess.iszero()) {
+				int e{ 0 };
+				Real fraction = std::frexp(s, &e);
+				Real significand = std::ldexp(fraction, std::numeric_limits<Real>::digits);
+				if (std::fmod(significand, Real(2)) != Real(0)) s = neighbor;
+				break;
+			}
+			s = neighbor;
+		}
+		return s;
 	}
 
 private:
 
-	// ereal - ereal logic comparisons
-	friend bool operator==(const ereal& lhs, const ereal& rhs);
-
-	// ereal - literal logic comparisons
-	friend bool operator==(const ereal& lhs, const long long rhs);
-
-	// literal - ereal logic comparisons
-	friend bool operator==(const long long lhs, const ereal& rhs);
-
 	// find the most significant bit set
-	friend signed findMsb(const ereal& v);
+	template<unsigned N>
+	friend signed findMsb(const ereal<N>& v);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -207,7 +403,7 @@ private:
 
 template<unsigned nlimbs>
 inline ereal<nlimbs> abs(const ereal<nlimbs>& a) {
-	return a; // (a < 0 ? -a : a);
+	return (a.isneg() ? -a : a);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -216,9 +412,53 @@ inline ereal<nlimbs> abs(const ereal<nlimbs>& a) {
 // read a ereal ASCII format and make a binary ereal out of it
 template<unsigned nlimbs>
 bool parse(const std::string& txt, ereal<nlimbs>& value) {
-	bool bSuccess = false;
 	value.clear();
-	return bSuccess;
+	std::string number(txt);
+	std::regex decimal_regex("^[+-]?([0-9]+\\.?[0-9]*|\\.[0-9]+)([eE][+-]?[0-9]+)?$");
+	if (number == "inf" || number == "+inf" || number == "-inf") {
+		value = (number[0] == '-' ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity());
+		return true;
+	}
+	if (number == "nan") {
+		value = std::numeric_limits<double>::quiet_NaN();
+		return true;
+	}
+	if (!std::regex_match(number, decimal_regex)) return false;
+	bool negative = (number[0] == '-');
+	size_t i = (number[0] == '-' || number[0] == '+' ? 1 : 0);
+	// accumulate the digits as an exact integer, in chunks of 15 digits that are exact doubles
+	ereal<nlimbs> mantissa(0);
+	int64_t exponent{ 0 };
+	uint64_t chunk{ 0 }, chunkScale{ 1 };
+	bool fraction{ false };
+	for (; i < number.size() && number[i] != 'e' && number[i] != 'E'; ++i) {
+		if (number[i] == '.') {
+			fraction = true;
+			continue;
+		}
+		chunk = chunk * 10 + static_cast<uint64_t>(number[i] - '0');
+		chunkScale *= 10;
+		if (fraction) --exponent;
+		if (chunkScale == 1'000'000'000'000'000ull) {
+			mantissa *= ereal<nlimbs>(chunkScale);
+			mantissa += ereal<nlimbs>(chunk);
+			chunk = 0;
+			chunkScale = 1;
+		}
+	}
+	if (chunkScale > 1) {
+		mantissa *= ereal<nlimbs>(chunkScale);
+		mantissa += ereal<nlimbs>(chunk);
+	}
+	if (i < number.size()) exponent += std::stoll(number.substr(i + 1));
+	ereal<nlimbs> power(1), base(10);
+	for (uint64_t e = static_cast<uint64_t>(exponent < 0 ? -exponent : exponent); e > 0; e >>= 1) {
+		if (e & 1) power *= base;
+		if (e > 1) base *= base;
+	}
+	if (exponent > 0) mantissa *= power; else if (exponent < 0) mantissa /= power;
+	value = (negative ? -mantissa : mantissa);
+	return true;
 }
 
 // generate an ereal format ASCII format
@@ -238,12 +478,11 @@ inline std::ostream& operator<<(std::ostream& ostr, const ereal<nlimbs>& rhs) {
 		ss << "nan(snan)";
 	}
 	else {
-		std::streamsize prec = ostr.precision();
 		std::streamsize width = ostr.width();
 		std::ios_base::fmtflags ff;
 		ff = ostr.flags();
 		ss.flags(ff);
-		ss << std::setw(width) << std::setprecision(prec) << "TBD";
+		ss << std::setw(width) << to_decimal_string(rhs, ostr.precision(), ff);
 	}
 
 	return ostr << ss.str();
@@ -266,10 +505,12 @@ inline std::istream& operator>>(std::istream& istr, ereal<nlimbs>& p) {
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 // ereal - ereal binary logic operators
 
-// equal: precondition is that the storage is properly nulled in all arithmetic paths
+// the sign of the exact difference decides, NaN is unordered
 template<unsigned nlimbs>
 inline bool operator==(const ereal<nlimbs>& lhs, const ereal<nlimbs>& rhs) {
-	return true;
+	if (lhs.isnan() || rhs.isnan()) return false;
+	if (lhs.isinf() || rhs.isinf()) return lhs.significant() == rhs.significant();
+	return (lhs - rhs).iszero();
 }
 template<unsigned nlimbs>
 inline bool operator!=(const ereal<nlimbs>& lhs, const ereal<nlimbs>& rhs) {
@@ -277,7 +518,9 @@ inline bool operator!=(const ereal<nlimbs>& lhs, const ereal<nlimbs>& rhs) {
 }
 template<unsigned nlimbs>
 inline bool operator< (const ereal<nlimbs>& lhs, const ereal<nlimbs>& rhs) {
-	return false; // lhs and rhs are the same
+	if (lhs.isnan() || rhs.isnan()) return false;
+	if (lhs.isinf() || rhs.isinf()) return lhs.significant() < rhs.significant();
+	return (lhs - rhs).isneg();
 }
 template<unsigned nlimbs>
 inline bool operator> (const ereal<nlimbs>& lhs, const ereal<nlimbs>& rhs) {
@@ -289,10 +532,10 @@ inline bool operator<=(const ereal<nlimbs>& lhs, const ereal<nlimbs>& rhs) {
 }
 template<unsigned nlimbs>
 inline bool operator>=(const ereal<nlimbs>& lhs, const ereal<nlimbs>& rhs) {
-	return !operator< (lhs, rhs);
+	return operator< (rhs, lhs) || operator==(lhs, rhs);
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ereal - literal binary logic operators
 // equal: precondition is that the byte-storage is properly nulled in all arithmetic paths
 template<unsigned nlimbs>
@@ -4,7 +4,14 @@
 // Copyright (C) 2017-2023 Stillwater Supercomputing, Inc.
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <bit>
+#include <string>
+#include <iostream>
+#include <universal/utility/find_msb.hpp>
 #include <universal/utility/boolean_logic_operators.hpp>
+#include <universal/internal/uint128/uint128.hpp>
 #include <universal/internal/value/value.hpp>
 #include <universal/number/quire/exceptions.hpp>
 
@@ -30,11 +37,17 @@ public:
 	static constexpr unsigned mbits = nbits - es;
 	static constexpr unsigned escale = 2*((unsigned(1) << es) + mbits + 1);
 	static constexpr unsigned range = escale; 		  // dynamic range of the float configuration
-	static constexpr unsigned half_range = range >> 1;          // position of the fixed point
-	static constexpr unsigned upper_range = half_range + 1;     // size of the upper accumulator
-	static constexpr unsigned qbits = range + capacity;         // size of the quire minus the sign bit: we are managing the sign explicitly
-	
-	quire() : _sign(false) { _capacity.reset(); _upper.reset(); _lower.reset(); }
+	// the product of the largest values (including supernormals) is smaller than 2^(2^es + 2),
+	// the lower accumulator takes the rest of the range, which covers the product of the smallest subnormals
+	static constexpr unsigned upper_range = (unsigned(1) << es) + 2;  // size of the upper accumulator
+	static constexpr unsigned half_range = range - upper_range;       // size of the lower accumulator: position of the fixed point
+	static constexpr unsigned qbits = range + capacity;         // size of the quire minus the sign bit
+
+	// The accumulator is a single two's complement fixed-point number stored in 64-bit limbs,
+	// with the lower, upper, and capacity segments followed by the sign bit.
+	static constexpr unsigned nrLimbs = (qbits + 1 + 63) / 64;
+
+	quire() { reset(); }
 	quire(int8_t initial_value) {		*this = initial_value;	}
 	quire(int16_t initial_value) {		*this = initial_value;	}
 	quire(int32_t initial_value) {		*this = initial_value;	}
@@ -44,47 +57,14 @@ public:
 	quire(double initial_value) {		*this = initial_value;	}
 	template<unsigned fbits>
 	quire(const sw::universal::internal::value<fbits>& rhs) { *this = rhs; }  // TODO: an internal type in a public interface
-	
+
 	// TODO: we are clamping the values of the RHS to be withing the dynamic range of the float
 	// TODO: however, on the upper side we also have the capacity bits, which gives us the opportunity to accept larger scale values than the dynamic range of the float.
 	// TODO: is that a good idea?
 	template<unsigned fbits>
 	quire& operator=(const value<fbits>& rhs) {
 		reset();
-		_sign = rhs.sign();
-		int i,f, scale = rhs.scale();
-		if (scale > int(half_range)) {
-			throw operand_too_large_for_quire{};
-		}
-		if (scale < -int(half_range)) {
-			throw operand_too_small_for_quire{};
-		}
-		sw::universal::internal::bitblock<fbits+1> fraction = rhs.get_fixed_point();
-		// divide bits between upper and lower accumulator
-		if (scale - int(fbits) >= 0) {
-			// all upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-		}
-		else if (scale < 0) {
-			// all lower accumulator
-			for (i = half_range + scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
-		else {
-			// part upper, and part lower accumulator
-			// first assign the bits in the upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[i] = fraction[f];
-			}
-			// next assign the bits in the lower accumulator
-			for (i = half_range - 1; i >= 0 && f >= 0; i--, f--) {
-				_lower[i] = fraction[f];
-			}
-		}
-		return *this;
+		return *this += rhs;
 	}
 	quire& operator=(signed char rhs) {
 		*this = (long long)(rhs);
@@ -101,51 +81,24 @@ public:
 	quire& operator=(long long rhs) {
 		clear();
 		// transform to sign-magnitude
-		_sign = rhs & 0x8000000000000000;
-		unsigned long long magnitude;
-		magnitude = _sign ? -rhs : rhs;
+		bool negative = rhs < 0;
+		uint64_t magnitude = negative ? (0ull - static_cast<uint64_t>(rhs)) : static_cast<uint64_t>(rhs);
 		unsigned msb = find_msb(magnitude);
-		if (msb > half_range + capacity) {
+		if (msb > upper_range + capacity) {
 			throw operand_too_large_for_quire{};
 		}
-		else {
-			// copy the value into the quire
-			uint64_t mask = uint64_t(1);
-			for (unsigned i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = magnitude & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				unsigned c = 0;
-				for (unsigned i = half_range; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = magnitude & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		// the integer's lsb aligns with the radix point
+		accumulate(&magnitude, 1, int(half_range), negative);
 		return *this;
 	}
 	quire& operator=(long long unsigned rhs) {
 		reset();
 		unsigned msb = find_msb(rhs);
-		if (msb > half_range + capacity) {
+		if (msb > upper_range + capacity) {
 			throw operand_too_large_for_quire{};
 		}
-		else {
-			// copy the value into the quire
-			uint64_t mask = uint64_t(1);
-			for (unsigned i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = rhs & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				unsigned c = 0;
-				for (unsigned i = half_range; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = rhs & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		uint64_t magnitude = rhs;
+		accumulate(&magnitude, 1, int(half_range), false);
 		return *this;
 	}
 	quire& operator=(float rhs) {
@@ -159,336 +112,201 @@ public:
 		return *this;
 	}
 	quire& operator=(long double rhs) {
-		constexpr int bits = std::numeric_limits<long double>::digits - 1;	
+		constexpr int bits = std::numeric_limits<long double>::digits - 1;
 		*this = sw::universal::internal::value<bits>(rhs);
 		return *this;
 	}
-	
+
+	// add a normalized (sign, scale, fraction) triple: a negative value is subtracted in two's complement
+	// scale is the location of the msb in the fixed point representation, bits below the lower accumulator are truncated
 	template<unsigned fbits>
 	quire& operator+=(const value<fbits>& rhs) {
 		if (rhs.iszero()) return *this;
-		int i, f, scale = rhs.scale();
-		if (scale >  int(half_range)) {
+		int scale = rhs.scale();
+		if (scale >= int(upper_range + capacity)) {
 			throw operand_too_large_for_quire{};
 		}
 		if (scale < -int(half_range)) {
 			throw operand_too_small_for_quire{};
 		}
-		if (rhs.sign()) {			// subtract
-			// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
-			int lsb = scale - int(fbits);  
-			bool borrow = false;
-			bitblock<fbits + 1> fraction = rhs.get_fixed_point();
-			// divide bits between upper and lower accumulator
-			if (scale < 0) {		// all lower accumulator
-				int lsb = int(half_range) + scale - int(fbits);
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = bxor(_a, _b, borrow);
-					borrow = (!_a && _b) || (bxnor(!_a, !_b) && borrow);
-				}
-				// propagate any borrows to the end of the lower accumulator
-				while (borrow && i < int(half_range)) {
-					bool _a = _lower[i];
-					_lower[i] = bxor(_a, borrow);
-					borrow = borrow && !_a;
-					i++;
-				}
-				if (borrow) { // borrow propagate to the _upper accumulator
-							  // need to decrement the _upper
-					i = 0;
-					while (borrow && i < int(upper_range)) {
-						bool _a = _upper[i];
-						_upper[i] = bxor(_a, borrow);
-						borrow = borrow && !_a;
-						i++;
-					}
-					if (borrow) {
-						// propagate the borrow into the capacity segment
-						i = 0;
-						while (borrow && i < int(capacity)) {
-							bool _a = _capacity[i];
-							_capacity[i] = bxor(_a, borrow);
-							borrow = borrow && !_a;
-							i++;
-						}
-					}
-				}
-			}
-			else if (lsb >= 0) {	// all upper accumulator
-				for (i = lsb, f = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = sw::universal::bxor(_a, _b, borrow);
-					borrow = (!_a && _b) || (sw::universal::bxnor(!_a, !_b) && borrow);
-				}
-				// propagate any borrows to the end of the upper accumulator
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = sw::universal::bxor(_a, borrow);
-					borrow = borrow && !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = sw::universal::bxor(_a, borrow);
-						borrow = borrow && !_a;
-						i++;
-					}
-				}
-			}
-			else {   // lsb < 0 && scale >= 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-				lsb = int(half_range) + lsb; // remember lsb is negative in this block
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = sw::universal::bxor(_a, _b, borrow);
-					borrow = (!_a && _b) || (sw::universal::bxnor(!_a, !_b) && borrow);
-				}
-				// next add the bits in the upper accumulator
-				for (i = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = sw::universal::bxor(_a, _b, borrow);
-					borrow = (!_a && _b) || (sw::universal::bxnor(!_a, !_b) && borrow);
-				}
-				// propagate any borrows to the end of the upper accumulator
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ borrow;
-					borrow = borrow && !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ borrow;
-						borrow = borrow && !_a;
-						i++;
-					}
-				}			
-			}
-		}
-		else {			// add
-			// scale is the location of the msb in the fixed point representation
-			// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
-			// and scale = -1 is the first bit of the fraction
-			// we manage scale >= 0 in the _upper accumulator, and scale < 0 in the _lower accumulator
-			int lsb = scale - int(fbits);
-			bool carry = false;
-			bitblock<fbits + 1> fraction = rhs.get_fixed_point();
-			// divide bits between upper and lower accumulator
-			if (scale < 0) {		// all lower accumulator
-				int lsb = int(half_range) + scale - int(fbits);
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = sw::universal::bxor(_a, _b, carry);
-					carry = (_a && _b) || (carry && sw::universal::bxor(_a, _b));
-				}
-				// propagate any carries to the end of the lower accumulator
-				while (carry && i < int(half_range)) {
-					bool _a = _lower[i];
-					_lower[i] = _a ^ carry;
-					carry = carry && _a;
-					i++;
-				}
-				if (carry) {  // carry propagate to the _upper accumulator
-							  // need to increment the _upper
-					i = 0;
-					while (carry && i < int(upper_range)) {
-						bool _a = _upper[i];
-						_upper[i] = _a ^ carry;
-						carry = carry && _a;
-						i++;
-					}
-					if (carry) {
-						// next add the bits to the capacity segment
-						i = 0;
-						while (carry && i < int(capacity)) {
-							bool _a = _capacity[i];
-							_capacity[i] = _a ^ carry;
-							carry = carry && _a;
-							i++;
-						}
-					}
-				}
-			}
-			else if (lsb >= 0) {	// all upper accumulator
-				for (i = lsb, f = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = sw::universal::bxor(_a, _b, carry);
-					carry = (_a && _b) || (carry && sw::universal::bxor(_a, _b));
-				}
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ carry;
-					carry = carry && _a;
-					i++;
-				}
-				if (carry) {
-					// next add the bits to the capacity segment
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ carry;
-						carry = carry && _a;
-						i++;
-					}
-				}
-			}
-			else {  // lsb < 0 && scale > 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-				lsb = int(half_range) + lsb; // remember lsb is negative in this block
-				int qlsb = lsb > 0 ? lsb : 0;
-				int flsb = lsb >= 0 ? 0 : -lsb;
-				for (i = qlsb, f = flsb; i < int(half_range) && f <= int(fbits); i++, f++) {
-					bool _a = _lower[i];
-					bool _b = fraction[f];
-					_lower[i] = sw::universal::bxor(_a, _b, carry);
-					carry = (_a && _b) || (carry && sw::universal::bxor(_a, _b));
-				}
-				// next add the bits in the upper accumulator
-				for (i = 0; i <= scale && f <= int(fbits); i++, f++) {
-					bool _a = _upper[i];
-					bool _b = fraction[f];
-					_upper[i] = sw::universal::bxor(_a, _b, carry);
-					carry = (_a && _b) || (carry && sw::universal::bxor(_a, _b));
-				}
-				// propagate any carries to the end of the upper accumulator
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[i];
-					_upper[i] = _a ^ carry;
-					carry = carry && _a;
-					i++;
-				}
-				// next add the bits to the capacity segment
-				if (carry) {
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[i];
-						_capacity[i] = _a ^ carry;
-						carry = carry && _a;
-						i++;
-					}
-				}
-			}
+		constexpr unsigned nrFixedLimbs = (fbits + 1 + 63) / 64;
+		uint64_t fixed[nrFixedLimbs];
+		to_limbs(rhs.get_fixed_point(), fixed);
+		accumulate(fixed, int(nrFixedLimbs), int(half_range) + scale - int(fbits), rhs.sign());
+		return *this;
+	}
+	template<unsigned fbits>
+	quire& operator-=(const value<fbits>& rhs) {
+		return *this += -rhs;
+	}
+	// add two quires: both are aligned at the same radix point, so this is a plain multi-limb add
+	quire& operator+=(const quire& q) {
+		uint64_t carry = 0;
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			uint64_t a = _limb[i];
+			uint64_t s = a + q._limb[i];
+			uint64_t c = (s < a ? 1u : 0u);
+			_limb[i] = s + carry;
+			carry = c | (_limb[i] < s ? 1u : 0u);
 		}
 		return *this;
 	}
 	// reset the state of a quire to zero
 	void reset() {
-		_sign  = false;
-		_lower.reset();
-		_upper.reset();
-		_capacity.reset();
+		for (unsigned i = 0; i < nrLimbs; ++i) _limb[i] = 0;
 	}
 	// clear the state of a quire to zero
 	void clear() { reset(); }
 	int dynamic_range() const { return range; }
 	int radix_point() const { return half_range; }
-	int max_scale() const { return half_range; }
+	int max_scale() const { return int(upper_range) - 1; }
 	int min_scale() const { return -int(half_range); }
 	int capacity_range() const { return capacity; }
-	bool isneg() const { return _sign; }
-	bool ispos() const { return !_sign; }
-	bool iszero() const { return _capacity.none() && _upper.none() && _lower.none(); }
+	bool isneg() const { return get_sign(); }
+	bool ispos() const { return !get_sign(); }
+	// the quire is zero when the bits of the magnitude are, it wraps around on overflow
+	bool iszero() const {
+		uint64_t magnitude[nrLimbs];
+		get_magnitude(magnitude);
+		for (unsigned i = 0; i < nrLimbs; ++i) if (magnitude[i]) return false;
+		return true;
+	}
 
 	// Return value of the sign bit: true indicates a negative number, false a positive number or zero
-	bool get_sign() const { return _sign; }
-	float sign_value() const {	return (_sign ? -1.0 : 1.0); }
+	bool get_sign() const { return (_limb[nrLimbs - 1] >> 63) != 0; }
+	float sign_value() const {	return (get_sign() ? -1.0f : 1.0f); }
 	value<qbits> to_value() const {
-		// find the MSB and build the fraction
-		bitblock<qbits> fraction;
-		bool isZero = false;
-		bool isNaR = false;   // TODO
-		int i;
-		int qbit = int(qbits);
-		int fbit = qbit - 1;
-		int scale = qbits;
-		for (i = int(capacity) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_capacity.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _capacity[i];
-			}
+		uint64_t magnitude[nrLimbs];
+		get_magnitude(magnitude);
+		int msbIndex = msb(magnitude);
+		if (msbIndex < 0) return value<qbits>(false, 0, bitblock<qbits>(), true, false);
+		// left-align the bits below the msb in the fraction, the msb becomes the hidden bit
+		shift_left(magnitude, unsigned(int(qbits) - msbIndex));
+		bitblock<qbits> fraction = from_limbs<qbits>(magnitude);
+		return value<qbits>(get_sign(), msbIndex - int(half_range), fraction, false, false);
+	}
+	// scale of the most significant bit of the unrounded sum, min_scale() - 1 for zero
+	int scale() const {
+		uint64_t magnitude[nrLimbs];
+		get_magnitude(magnitude);
+		return msb(magnitude) - int(half_range);
+	}
+	// round to a binary format with precision <= 53 significant bits and a smallest subnormal of 2^minScale,
+	// ties to even, the result is exactly representable as a double as long as it is in range
+	double to_double(unsigned precision = 53, int minScale = -1074) const {
+		uint64_t magnitude[nrLimbs];
+		get_magnitude(magnitude);
+		int msbIndex = msb(magnitude);
+		if (msbIndex < 0) return 0.0;
+		int scale = msbIndex - int(half_range);
+		int lsbScale = scale - int(precision) + 1;
+		if (lsbScale < minScale) lsbScale = minScale;
+		int lsbIndex = lsbScale + int(half_range);  // quire bit of the last bit that is kept
+		uint64_t m = (lsbIndex > msbIndex ? 0 : extract64(magnitude, int(nrLimbs), lsbIndex));
+		bool guard = (lsbIndex >= 1 && lsbIndex - 1 <= msbIndex) ? ((magnitude[unsigned(lsbIndex - 1) / 64] >> (unsigned(lsbIndex - 1) % 64)) & 0x1) : false;
+		bool sticky = false;
+		if (lsbIndex >= 2) {
+			int stickyMsb = (lsbIndex - 2 < msbIndex ? lsbIndex - 2 : msbIndex);
+			unsigned top = unsigned(stickyMsb) / 64;
+			for (unsigned i = 0; i < top && !sticky; ++i) sticky = (magnitude[i] != 0);
+			if (!sticky) sticky = (magnitude[top] << (63u - unsigned(stickyMsb) % 64)) != 0;
 		}
-		for (i = int(upper_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_upper.test(i)) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[fbit--] = _upper[i];
+		if (guard && (sticky || (m & 0x1))) ++m;
+		double v = std::ldexp(static_cast<double>(m), lsbScale);
+		return (get_sign() ? -v : v);
+	}
+
+private:
+	uint64_t _limb[nrLimbs];   // two's complement fixed-point, least significant limb first
+
+	// magnitude of the segmented sign-magnitude view
+	void get_magnitude(uint64_t* magnitude) const {
+		for (unsigned i = 0; i < nrLimbs; ++i) magnitude[i] = _limb[i];
+		if (get_sign()) {
+			uint64_t carry = 1;
+			for (unsigned i = 0; i < nrLimbs; ++i) {
+				magnitude[i] = ~magnitude[i] + carry;
+				carry = (carry && magnitude[i] == 0) ? 1u : 0u;
 			}
 		}
-		for (i = int(half_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_lower.test(i)) scale = qbit - int(half_range);
+		// bits beyond the capacity segment are overflow
+		constexpr unsigned topBits = qbits - 64 * (nrLimbs - 1);
+		if constexpr (topBits < 64) magnitude[nrLimbs - 1] &= (uint64_t(1) << topBits) - 1;
+	}
+	// position of the most significant bit of a magnitude, -1 if zero
+	static int msb(const uint64_t* magnitude) {
+		for (int i = int(nrLimbs) - 1; i >= 0; --i) {
+			if (magnitude[i]) return 64 * i + 63 - std::countl_zero(magnitude[i]);
+		}
+		return -1;
+	}
+	static void shift_left(uint64_t* limbs, unsigned shift) {
+		unsigned limbShift = shift / 64;
+		unsigned bitShift = shift % 64;
+		for (int i = int(nrLimbs) - 1; i >= 0; --i) {
+			int src = i - int(limbShift);
+			uint64_t hi = (src >= 0 ? limbs[src] : 0);
+			uint64_t lo = (src >= 1 ? limbs[src - 1] : 0);
+			limbs[i] = (bitShift == 0 ? hi : (hi << bitShift) | (lo >> (64 - bitShift)));
+		}
+	}
+	// 64 bits of a little-endian limb array starting at bit position pos, bits outside the array read as 0
+	static uint64_t extract64(const uint64_t* limbs, int nrSrcLimbs, int pos) {
+		int index = pos >> 6;    // floor(pos / 64), also for negative positions
+		unsigned offset = unsigned(pos & 63);
+		uint64_t lo = (index >= 0 && index < nrSrcLimbs ? limbs[index] : 0);
+		if (offset == 0) return lo;
+		uint64_t hi = (index + 1 >= 0 && index + 1 < nrSrcLimbs ? limbs[index + 1] : 0);
+		return (lo >> offset) | (hi << (64 - offset));
+	}
+	// add, or subtract, a magnitude stored in nrSrcLimbs limbs with its lsb at quire bit lsb
+	void accumulate(const uint64_t* magnitude, int nrSrcLimbs, int lsb, bool subtract) {
+		int lowest = (lsb > 0 ? lsb : 0);
+		int highest = lsb + 64 * nrSrcLimbs - 1;
+		if (highest < 0) return;
+		unsigned first = unsigned(lowest) / 64;
+		unsigned last = unsigned(highest) / 64;
+		if (last >= nrLimbs) last = nrLimbs - 1;
+		uint64_t carry = 0;
+		unsigned i = first;
+		if (subtract) {
+			for (; i <= last; ++i) {
+				uint64_t b = extract64(magnitude, nrSrcLimbs, int(64 * i) - lsb);
+				uint64_t a = _limb[i];
+				uint64_t d = a - b;
+				uint64_t borrow = (d > a ? 1u : 0u);
+				_limb[i] = d - carry;
+				carry = borrow | (_limb[i] > d ? 1u : 0u);
 			}
-			else {
-				fraction[fbit--] = _lower[i];
+			for (; carry && i < nrLimbs; ++i) carry = (_limb[i]-- == 0 ? 1u : 0u);
+		}
+		else {
+			for (; i <= last; ++i) {
+				uint64_t b = extract64(magnitude, nrSrcLimbs, int(64 * i) - lsb);
+				uint64_t a = _limb[i];
+				uint64_t s = a + b;
+				uint64_t c = (s < a ? 1u : 0u);
+				_limb[i] = s + carry;
+				carry = c | (_limb[i] < s ? 1u : 0u);
 			}
+			for (; carry && i < nrLimbs; ++i) carry = (++_limb[i] == 0 ? 1u : 0u);
 		}
-		if (scale == qbits) {
-			isZero = true;
-			scale = 0;
+	}
+	// signed comparison of two quires: -1, 0, or 1
+	static int compare(const quire& lhs, const quire& rhs) {
+		bool lneg = lhs.get_sign(), rneg = rhs.get_sign();
+		if (lneg != rneg) return (lneg ? -1 : 1);
+		// same sign: two's complement values order like their unsigned bit patterns
+		for (int i = int(nrLimbs) - 1; i >= 0; --i) {
+			if (lhs._limb[i] < rhs._limb[i]) return -1;
+			if (lhs._limb[i] > rhs._limb[i]) return 1;
 		}
-		return value<qbits>(_sign, scale, fraction, isZero, isNaR);
+		return 0;
 	}
 
-private:
-	bool				   _sign;
-	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
-	bitblock<half_range>   _lower;
-	bitblock<upper_range>  _upper;
-	bitblock<capacity>     _capacity;
-
-#if TEMPLATIZED_TYPE
-	//  when we figure out how to templatize the extraction of exponent bits from type
-
-	// template parameters need names different from class template parameters (for gcc and clang)
-	template<typename TTy, unsigned ncapacity>
-	friend std::ostream& operator<< (std::ostream& ostr, const quire<TTy,ncapacity>& q);
-	template<typename TTy, unsigned ncapacity>
-	friend std::istream& operator>> (std::istream& istr, quire<TTy, ncapacity>& q);
-
-	template<unsigned nnbits, unsigned nes, unsigned ncapacity>
-	friend bool operator==(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, unsigned ncapacity>
-	friend bool operator!=(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, unsigned ncapacity>
-	friend bool operator< (const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, unsigned ncapacity>
-	friend bool operator> (const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, unsigned ncapacity>
-	friend bool operator<=(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-	template<typename TTy, unsigned ncapacity>
-	friend bool operator>=(const quire<TTy, ncapacity>& lhs, const quire<TTy, ncapacity>& rhs);
-
-#else
-
 	// template parameters need names different from class template parameters (for gcc and clang)
 	template<unsigned nnbits, unsigned nes, unsigned ncapacity>
 	friend std::ostream& operator<< (std::ostream& ostr, const quire<nnbits, nes, ncapacity>& q);
-	template<unsigned nnbits, unsigned nes, unsigned ncapacity>
-	friend std::istream& operator>> (std::istream& istr, quire<nnbits, nes, ncapacity>& q);
 
 	template<unsigned nnbits, unsigned nes, unsigned ncapacity>
 	friend bool operator==(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
@@ -502,66 +320,8 @@ private:
 	friend bool operator<=(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
 	template<unsigned nnbits, unsigned nes, unsigned ncapacity>
 	friend bool operator>=(const quire<nnbits, nes, ncapacity>& lhs, const quire<nnbits, nes, ncapacity>& rhs);
-
-#endif // TEMPLATIZED_TYPE
 };
 
-#if TEMPLATIZED_TYPE
-
-// QUIRE BINARY ARITHMETIC OPERATORS
-template<typename Ty, unsigned capacity>
-inline quire<Ty, capacity> operator+(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) {
-	quire<Ty, capacity> sum = lhs;
-	sum += rhs;
-	return sum;
-}
-
-
-////////////////// QUIRE operators
-template<typename Ty, unsigned capacity>
-inline std::ostream& operator<<(std::ostream& ostr, const quire<Ty, capacity>& q) {
-	ostr << (q._sign ? "-1" : " 1") << ": " << q._capacity << "_" << q._upper << "." << q._lower;
-	return ostr;
-}
-
-template<typename Ty, unsigned capacity>
-inline std::istream& operator>> (std::istream& istr, const quire<Ty, capacity>& q) {
-	istr >> q._accu;
-	return istr;
-}
-
-template<typename Ty, unsigned capacity>
-inline bool operator==(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
-template<typename Ty, unsigned capacity>
-inline bool operator!=(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return !operator==(lhs, rhs); }
-template<typename Ty, unsigned capacity>
-inline bool operator< (const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { 
-	bool bSmaller = false;
-	if (!lhs._sign && rhs._sign) {
-		bSmaller = true;
-	}
-	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-			bSmaller = true;
-		}
-	}
-	return bSmaller;
-}
-template<typename Ty, unsigned capacity>
-inline bool operator> (const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return  operator< (rhs, lhs); }
-template<typename Ty, unsigned capacity>
-inline bool operator<=(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return !operator> (lhs, rhs) || lhs == rhs; }
-template<typename Ty, unsigned capacity>
-inline bool operator>=(const quire<Ty, capacity>& lhs, const quire<Ty, capacity>& rhs) { return !operator< (lhs, rhs) || lhs == rhs; }
-
-#else
-
 // QUIRE BINARY ARITHMETIC OPERATORS
 template<unsigned nbits, unsigned es, unsigned capacity>
 inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
@@ -574,45 +334,66 @@ inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lh
 ////////////////// QUIRE operators
 template<unsigned nnbits, unsigned nes, unsigned capacity>
 inline std::ostream& operator<<(std::ostream& ostr, const quire<nnbits, nes, capacity>& q) {
-	ostr << (q._sign ? "-1" : " 1") << ": " << q._capacity << "_" << q._upper << "." << q._lower;
-	return ostr;
-}
-
-template<unsigned nnbits, unsigned nes, unsigned capacity>
-inline std::istream& operator>> (std::istream& istr, const quire<nnbits, nes, capacity>& q) {
-	istr >> q._accu;
-	return istr;
+	using Quire = quire<nnbits, nes, capacity>;
+	// sign-magnitude format: sign: capacity_upper.lower
+	uint64_t magnitude[Quire::nrLimbs];
+	q.get_magnitude(magnitude);
+	std::string bits;
+	bits.reserve(Quire::qbits + 6);
+	bits += (q.get_sign() ? "-1: " : " 1: ");
+	for (int i = int(Quire::qbits) - 1; i >= 0; --i) {
+		if (i == int(Quire::half_range + Quire::upper_range) - 1) bits += '_';
+		if (i == int(Quire::half_range) - 1) bits += '.';
+		bits += ((magnitude[unsigned(i) / 64] >> (unsigned(i) % 64)) & 0x1) ? '1' : '0';
+	}
+	return ostr << bits;
 }
 
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
+inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return quire<nbits, es, capacity>::compare(lhs, rhs) == 0; }
 template<unsigned nbits, unsigned es, unsigned capacity>
 inline bool operator!=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) {
-	bool bSmaller = false;
-	if (!lhs._sign && rhs._sign) {
-		bSmaller = true;
-	}
-	else if (lhs._sign == rhs._sign) {
-	    if (lhs._capacity < rhs._capacity) {
-		 bSmaller = true;
-	    }
-	    else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-		 bSmaller = true;
-	    }
-	    else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-		 bSmaller = true;
-	    }
-        }
-        return bSmaller;
-}
+inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return quire<nbits, es, capacity>::compare(lhs, rhs) < 0; }
 template<unsigned nbits, unsigned es, unsigned capacity>
 inline bool operator> (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return  operator< (rhs, lhs); }
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator<=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator> (lhs, rhs) || lhs == rhs; }
+inline bool operator<=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator> (lhs, rhs); }
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator>=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator< (lhs, rhs) || lhs == rhs; }
-#endif
+inline bool operator>=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator< (lhs, rhs); }
+
+// QUIRE OPERATORS
+
+// unrounded product of two normalized significands of fhbits <= 64 bits, hidden bit included
+template<unsigned fhbits>
+value<2 * fhbits> quire_mul(bool sign, int scale, uint64_t lhs, uint64_t rhs) {
+	static_assert(fhbits > 0 && fhbits <= 64, "quire_mul: significands need to fit in a single limb");
+	constexpr unsigned mbits = 2 * fhbits;
+	uint128 p = umul128(lhs, rhs);
+	// the product of two significands in [1, 2) is in [1, 4): shift the hidden bit out
+	bool carry = (mbits > 64 ? (p.upper >> (mbits - 65)) : (p.lower >> (mbits - 1))) & 0x1;
+	unsigned shift = carry ? 1u : 2u;
+	if (carry) ++scale;
+	uint64_t limbs[2] = { p.lower << shift, (p.upper << shift) | (p.lower >> (64 - shift)) };
+	return value<mbits>(sign, scale, from_limbs<mbits>(limbs), false, false);
+}
+
+// unrounded product of two native IEEE-754 values
+template<typename Real>
+value<2 * std::numeric_limits<Real>::digits> quire_mul(Real lhs, Real rhs) {
+	static_assert(std::numeric_limits<Real>::digits <= 64, "quire_mul: native significand too wide");
+	constexpr unsigned fhbits = std::numeric_limits<Real>::digits;
+	value<2 * fhbits> product;  // constructs to zero value
+	if (std::isnan(lhs) || std::isnan(rhs)) { product.setnan(); return product; }
+	if (std::isinf(lhs) || std::isinf(rhs)) { product.setinf(); return product; }
+	if (lhs == 0 || rhs == 0) return product;
+	// frexp normalizes subnormals, so the significands are exact fhbits integers
+	int lexp{ 0 }, rexp{ 0 };
+	Real lfrac = std::frexp(lhs, &lexp);
+	Real rfrac = std::frexp(rhs, &rexp);
+	uint64_t a = static_cast<uint64_t>(std::ldexp(std::fabs(lfrac), int(fhbits)));
+	uint64_t b = static_cast<uint64_t>(std::ldexp(std::fabs(rfrac), int(fhbits)));
+	return quire_mul<fhbits>(std::signbit(lhs) != std::signbit(rhs), (lexp - 1) + (rexp - 1), a, b);
+}
 
 }  // namespace sw::ieee
@@ -0,0 +1,207 @@
+#pragma once
+// gaussian_log.hpp: Gaussian logarithms sb(z) and db(z) for native logarithmic addition and subtraction
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdint>
+#include <cmath>
+#include <array>
+
+/*
+   Addition and subtraction in a logarithmic number system are expressed
+   through the Gaussian logarithms. For |x| = 2^a >= |y| = 2^b and z = b - a <= 0
+
+      log2(|x| + |y|) = a + sb(z),   sb(z) = log2(1 + 2^z)
+      log2(|x| - |y|) = a + db(z),   db(z) = log2(1 - 2^z)
+
+   The lns exponent is a fixed-point number with rbits fraction bits, so the
+   Gaussian logarithms are sampled and rounded to the same grid. Both functions
+   decay as 2^z, and for z < -(rbits + 3) they round to zero, which bounds
+   the domain we need to cover to (rbits + 3) * 2^rbits ulps.
+
+   Depending on rbits, three evaluation strategies are used:
+     - rbits <= 8  : the full domain is tabulated at compile time, and evaluation is a single lookup
+     - rbits <= 20 : sb and db are tabulated at compile time at 2^-8 spacing and quadratically interpolated,
+                     which keeps the error within 0.502 ulp, that is, the result is faithfully rounded
+     - rbits  > 20 : direct evaluation in extended precision
+   db(z) has a logarithmic singularity at z = 0, which interpolation can't follow.
+   Close to the singularity, db is evaluated through the co-transformed argument
+   db(z) = log2(-expm1(z * ln(2))), which is well-conditioned for small |z|.
+ */
+namespace sw { namespace universal {
+
+	// constexpr kernels to generate the Gaussian logarithm tables at compile time
+	namespace gaussian_log_kernels {
+
+		constexpr double LN2 = 0.693147180559945309417232121458176568;
+
+		// e^t - 1 for |t| < 1, Taylor series
+		constexpr double expm1(double t) {
+			double term = t, sum = t;
+			for (int k = 2; k < 40 && term != 0.0; ++k) {
+				term *= t / k;
+				sum += term;
+			}
+			return sum;
+		}
+
+		// 2^x - 1 for x <= 0
+		constexpr double exp2m1(double x) {
+			if (x > -1.0) return expm1(x * LN2); // accurate around the origin
+			int n = static_cast<int>(x);         // truncates toward zero: x = n + f, f in (-1, 0]
+			double f = x - n;
+			double p = expm1(f * LN2) + 1.0;
+			for (int i = n; i < 0; ++i) p *= 0.5; // exact scaling
+			return p - 1.0;
+		}
+
+		// natural logarithm of u > 0
+		constexpr double ln(double u) {
+			// reduce u = m * 2^p with m in [sqrt(1/2), sqrt(2)), the scaling is exact
+			int p = 0;
+			while (u >= 1.4142135623730950488) { u *= 0.5; ++p; }
+			while (u < 0.7071067811865475244) { u *= 2.0; --p; }
+			// ln(m) = 2 atanh(y), y = (m - 1)/(m + 1), |y| < 0.172
+			double y = (u - 1.0) / (u + 1.0);
+			double y2 = y * y;
+			double term = y, sum = y;
+			for (int k = 3; k < 61; k += 2) {
+				term *= y2;
+				sum += term / k;
+			}
+			return p * LN2 + 2.0 * sum;
+		}
+
+		// sb(z) = log2(1 + 2^z) for z <= 0
+		constexpr double sb(double z) {
+			return ln(2.0 + exp2m1(z)) / LN2;
+		}
+
+		// db(z) = log2(1 - 2^z) for z < 0: the co-transformed argument -(2^z - 1) keeps full relative precision near z = 0
+		constexpr double db(double z) {
+			return ln(-exp2m1(z)) / LN2;
+		}
+
+		// round to nearest, ties to even
+		constexpr int64_t round_to_even(double v) {
+			int64_t i = static_cast<int64_t>(v);
+			if (static_cast<double>(i) > v) --i; // floor
+			double frac = v - static_cast<double>(i);
+			if (frac > 0.5 || (frac == 0.5 && (i & 0x1))) ++i;
+			return i;
+		}
+
+		// sb and db rounded to ulps at every grid point k = 0, 1, ..., N-1 of a grid with rbits fraction bits
+		template<unsigned rbits, size_t N>
+		struct LookupTable {
+			std::array<int32_t, N> sb{}, db{};
+			constexpr LookupTable() {
+				constexpr double scale = static_cast<double>(1ull << rbits);
+				for (size_t k = 0; k < N; ++k) {
+					double z = -static_cast<double>(k) / scale;
+					sb[k] = static_cast<int32_t>(round_to_even(gaussian_log_kernels::sb(z) * scale));
+					db[k] = (k == 0 ? 0 : static_cast<int32_t>(round_to_even(gaussian_log_kernels::db(z) * scale))); // db(0) = -inf is never requested
+				}
+			}
+		};
+
+		// sb and db sampled at z = -i * 2^-sampleBits, i = 0, 1, ..., N-1
+		template<unsigned sampleBits, size_t N>
+		struct SampleTable {
+			std::array<double, N> sb{}, db{};
+			constexpr SampleTable() {
+				constexpr double spacing = 1.0 / static_cast<double>(1ull << sampleBits);
+				for (size_t i = 0; i < N; ++i) {
+					double z = -static_cast<double>(i) * spacing;
+					sb[i] = gaussian_log_kernels::sb(z);
+					db[i] = (i == 0 ? 0.0 : gaussian_log_kernels::db(z)); // db(0) = -inf is never interpolated
+				}
+			}
+		};
+
+	} // namespace gaussian_log_kernels
+
+	// Gaussian logarithms rounded to a fixed-point grid with rbits fraction bits.
+	// Arguments and results are expressed in ulps of that grid: k = -z * 2^rbits
+	template<unsigned rbits>
+	class gaussian_log {
+	public:
+		static_assert(rbits <= 56, "gaussian_log: Gaussian logarithms in ulps need to fit in an int64_t");
+		static constexpr unsigned lookupRbits = 8;              // fully tabulated up to this many fraction bits
+		static constexpr unsigned interpolationRbits = 20;      // quadratically interpolated up to this many fraction bits
+		static constexpr unsigned sampleBits = 8;               // interpolation tables sample at 2^-sampleBits spacing
+		static constexpr int64_t ulpsPerUnit = (int64_t(1) << rbits);
+		static constexpr int64_t cutoff = (int64_t(rbits) + 3) * ulpsPerUnit; // for k >= cutoff, sb and db round to 0
+
+		// sb(-k * 2^-rbits) in ulps, k >= 0
+		static int64_t sb(int64_t k) noexcept {
+			if (k >= cutoff) return 0;
+			if constexpr (rbits <= lookupRbits) {
+				return static_cast<int64_t>(lookup.sb[static_cast<size_t>(k)]);
+			}
+			else if constexpr (rbits <= interpolationRbits) {
+				return interpolate(samples.sb, k);
+			}
+			else {
+				return direct(k, false);
+			}
+		}
+		// db(-k * 2^-rbits) in ulps, k > 0
+		static int64_t db(int64_t k) noexcept {
+			if (k >= cutoff) return 0;
+			if constexpr (rbits <= lookupRbits) {
+				return static_cast<int64_t>(lookup.db[static_cast<size_t>(k)]);
+			}
+			else if constexpr (rbits <= interpolationRbits) {
+				// close to the singularity at z = 0 the interpolant doesn't converge: evaluate the co-transformed form
+				if (k < singularityUlps) return direct(k, true);
+				return interpolate(samples.db, k);
+			}
+			else {
+				return direct(k, true);
+			}
+		}
+
+	private:
+		// db is evaluated directly within two units of the singularity
+		static constexpr int64_t singularityUlps = 2 * ulpsPerUnit;
+
+		static constexpr size_t nrLookups = static_cast<size_t>(rbits <= lookupRbits ? cutoff : 1);
+		static constexpr gaussian_log_kernels::LookupTable<(rbits <= lookupRbits ? rbits : 0), nrLookups> lookup{};
+
+		// samples at 2^-sampleBits spacing, with two extra samples for the quadratic interpolant at the end of the domain
+		static constexpr bool interpolated = (rbits > lookupRbits && rbits <= interpolationRbits);
+		static constexpr size_t nrSamples = (interpolated ? static_cast<size_t>(rbits + 3) * (size_t(1) << sampleBits) + 3 : 1);
+		static constexpr gaussian_log_kernels::SampleTable<sampleBits, nrSamples> samples{};
+
+		// Newton forward-difference quadratic interpolation between samples i, i+1, i+2
+		template<typename Table>
+		static int64_t interpolate(const Table& f, int64_t k) noexcept {
+			constexpr unsigned shift = (rbits > sampleBits ? rbits - sampleBits : 0);
+			constexpr int64_t mask = (int64_t(1) << shift) - 1;
+			size_t i = static_cast<size_t>(k >> shift);
+			double t = static_cast<double>(k & mask) / static_cast<double>(int64_t(1) << shift);
+			double f0 = f[i], f1 = f[i + 1], f2 = f[i + 2];
+			double d1 = f1 - f0;
+			double d2 = f2 - 2.0 * f1 + f0;
+			double v = f0 + t * d1 + 0.5 * t * (t - 1.0) * d2;
+			return static_cast<int64_t>(std::nearbyint(std::ldexp(v, static_cast<int>(rbits))));
+		}
+
+#if LONG_DOUBLE_SUPPORT
+		using Real = long double;
+#else
+		using Real = double;
+#endif
+		// evaluate in the widest native precision
+		static int64_t direct(int64_t k, bool subtract) noexcept {
+			const Real ln2 = std::log(Real(2.0));
+			Real z = -std::ldexp(static_cast<Real>(k), -static_cast<int>(rbits));
+			Real v = subtract ? std::log2(-std::expm1(z * ln2)) : std::log1p(std::exp2(z)) / ln2;
+			return static_cast<int64_t>(std::nearbyint(std::ldexp(v, static_cast<int>(rbits))));
+		}
+	};
+
+}} // namespace sw::universal
@@ -14,6 +14,7 @@
 #include <universal/number/shared/specific_value_encoding.hpp>
 #include <universal/behavior/arithmetic.hpp>
 #include <universal/number/lns/lns_fwd.hpp>
+#include <universal/number/lns/gaussian_log.hpp>
 
 namespace sw { namespace universal {
 		
@@ -100,6 +101,12 @@ public:
 	using BlockBinary = blockbinary<nbits, bt, BinaryNumberType::Signed>; // sign + lns exponent
 	using ExponentBlockBinary = blockbinary<nbits-1, bt, BinaryNumberType::Signed>;  // just the lns exponent
 
+	// addition and subtraction evaluate the Gaussian logarithms on the fixed-point grid of the exponent
+	static constexpr unsigned GaussianLogMaxRbits = 56;
+	using GaussianLog = gaussian_log<(rbits <= GaussianLogMaxRbits ? rbits : 0)>;
+	static constexpr int64_t  max_exponent_ulps = (nbits <= 64) ? static_cast<int64_t>((1ull << ((nbits - 2) % 64)) - 1) : 0; // maxpos encoding
+	static constexpr int64_t  min_exponent_ulps = -max_exponent_ulps - 1;                                             // zero encoding
+
 	/// trivial constructor
 	lns() = default;
 
@@ -179,33 +186,119 @@ public:
 	constexpr lns operator-() const noexcept {
 		if (isnan() || iszero()) return *this;
 		lns negate(*this);
-		negate.setbit(nbits - 1, !sign());
+		negate.setsign(!sign());
 		return negate;
 	}
 
 	// in-place arithmetic assignment operators
 	lns& operator+=(const lns& rhs) {
-		double sum{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
+		if constexpr (rbits > GaussianLogMaxRbits) {
+			// Gaussian logarithms in ulps don't fit in 64 bits: saturation happens in the assignment
+			double sum = double(*this) + double(rhs);
+			if constexpr (behavior != Behavior::Saturating) {
+				constexpr lns maxpos(SpecificValue::maxpos);
+				// lns has no infinite encoding; double(maxpos) rounds up to the first power of two beyond the range
+				if (std::isinf(sum) || std::abs(sum) >= double(maxpos)) {
+					setnan();
+					return *this;
+				}
+			}
+			return *this = sum;
 		}
 		else {
-			sum = double(*this) + double(rhs);  // TODO: native implementation
+			if (isnan()) return *this;
+			if (rhs.isnan()) {
+				setnan();
+				return *this;
+			}
+			if (rhs.iszero()) return *this;
+			if (iszero()) return *this = rhs;
+
+			// log2(|x| +/- |y|) = a + sb(b - a) or a + db(b - a) with a = log2(|x|) >= b = log2(|y|)
+			bool subtract = sign() ^ rhs.sign();
+			if constexpr (nbits <= 64) {
+				int64_t a = exponent(), b = rhs.exponent();
+				bool negative = sign();
+				if (a < b) {
+					std::swap(a, b);
+					negative = rhs.sign();
+				}
+				int64_t k = a - b;
+				if (subtract) {
+					if (k == 0) { // x - x
+						setzero();
+						return *this;
+					}
+					a += GaussianLog::db(k);
+				}
+				else {
+					a += GaussianLog::sb(k);
+				}
+				if (a > max_exponent_ulps) {
+					if constexpr (behavior == Behavior::Saturating) { // saturating, no infinite
+						a = max_exponent_ulps;
+					}
+					else {  // lns has no infinite encoding: overflow yields NaN instead of a wrapped exponent
+						setnan();
+						return *this;
+					}
+				}
+				if (a <= min_exponent_ulps) { // underflow to the zero encoding
+					setzero();
+					return *this;
+				}
+				setbits(static_cast<uint64_t>(a)); // this might set the lns sign, but we are going to explicitly set it before returning
+				setsign(negative);
+			}
+			else {
+				using ExpandedExponent = blockbinary<nbits, bt, BinaryNumberType::Signed>;
+				ExponentBlockBinary lexp(_block), rexp(rhs._block); // strip the lns sign bit to yield the exponents
+				ExpandedExponent a(lexp), b(rexp);                  // expand and sign extend
+				bool negative = sign();
+				if (a < b) {
+					std::swap(a, b);
+					negative = rhs.sign();
+				}
+				ExpandedExponent diff = ursub(a, b);  // 0 <= diff < 2^(nbits - 1)
+				if (subtract && diff.iszero()) { // x - x
+					setzero();
+					return *this;
+				}
+				static constexpr ExpandedExponent cutoff(GaussianLog::cutoff);
+				if (diff < cutoff) { // beyond the cutoff sb and db round to 0, and the larger operand is the result
+					int64_t k = static_cast<int64_t>(diff.block(0));
+					for (unsigned i = 1; i < ExpandedExponent::nrBlocks && i * bitsInBlock < 64; ++i) {
+						k |= static_cast<int64_t>(diff.block(i)) << (i * bitsInBlock);
+					}
+					ExpandedExponent d(subtract ? GaussianLog::db(k) : GaussianLog::sb(k));
+					a = uradd(a, d);
+				}
+				static constexpr ExponentBlockBinary maxexp(SpecificValue::maxpos), minexp(SpecificValue::maxneg);
+				static const ExpandedExponent maxpos(maxexp), maxneg(minexp); // expand into type of sum
+				if (a > maxpos) {
+					if constexpr (behavior == Behavior::Saturating) { // saturating, no infinite
+						a = maxpos;
+					}
+					else {  // lns has no infinite encoding: overflow yields NaN instead of a wrapped exponent
+						setnan();
+						return *this;
+					}
+				}
+				else if (a <= maxneg) { // underflow to the zero encoding
+					setzero();
+					return *this;
+				}
+				_block.assign(a); // this might set the lns sign, but we are going to explicitly set it before returning
+				setsign(negative);
+			}
+			return *this;
 		}
-		return *this = sum; // <-- saturation happens in the assignment
 	}
 	lns& operator+=(double rhs) { 
 		return operator+=(lns(rhs));
 	}
 	lns& operator-=(const lns& rhs) { 
-		double diff{ 0.0 };
-		if constexpr (behavior == Behavior::Saturating) {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
-		}
-		else {
-			diff = double(*this) - double(rhs);  // TODO: native implementation
-		}
-		return *this = diff; // <-- saturation happens in the assignment
+		return operator+=(-rhs);
 	}
 	lns& operator-=(double rhs) {
 		return operator-=(lns(rhs));
@@ -322,7 +415,10 @@ public:
 	constexpr void setzero()                       noexcept { _block.clear(); setbit(nbits - 2, true); }
 	constexpr void setnan(bool sign = false)       noexcept { (sign ? clear() : _block.clear()); setbit(nbits - 1); setbit(nbits - 2); }
 	constexpr void setinf(bool sign)               noexcept { (sign ? maxneg() : maxpos()); } // TODO: is that what we want?
-	constexpr void setsign(bool s = true)          noexcept { setbit(nbits - 1, s); }
+	constexpr void setsign(bool s = true)          noexcept {
+		bt msu = _block[MSU];
+		_block.setblock(MSU, (s ? bt(msu | SIGN_BIT_MASK) : bt(msu & ~SIGN_BIT_MASK)));
+	}
 	constexpr void setbit(unsigned i, bool v = true) noexcept {
 		unsigned blockIndex = i / bitsInBlock;
 		if (i < nbits) {
@@ -529,6 +625,17 @@ protected:
 		return *this;
 	}
 
+	// the sign extended fixed-point exponent in ulps, only available when the encoding fits in 64 bits
+	constexpr int64_t exponent() const noexcept {
+		static_assert(nbits <= 64, "lns exponent() requires nbits <= 64");
+		uint64_t bits = static_cast<uint64_t>(_block[0]);
+		for (unsigned i = 1; i < nrBlocks; ++i) {
+			bits |= static_cast<uint64_t>(_block[i]) << (i * bitsInBlock);
+		}
+		constexpr unsigned unusedBits = 65u - nbits; // sign bit of the lns and the bits above nbits
+		return static_cast<int64_t>(bits << unusedBits) >> unusedBits;
+	}
+
 	/// <summary>
 	/// assign the value of the string representation to the cfloat
 	/// </summary>
@@ -621,7 +728,7 @@ protected:
 		Real logv = std::log2(v);
 		if (logv == 0.0) {
 			_block.clear();
-			_block.setbit(nbits - 1, negative);
+			setsign(negative);
 			return *this;
 		}
 
@@ -671,17 +778,17 @@ protected:
 					if (lsb && (!round && !sticky)) ++rawFraction; // round to even
 					if (round || sticky) ++rawFraction;
 				}
-				rawFraction = (s ? (~rawFraction + 1) : rawFraction); // if negative, map to two's complement
 			}
 			lnsExponent.setbits(rawFraction);
+			if (s) lnsExponent.twosComplement(); // if negative, map to two's complement across the full width of the exponent
 		}
 		else {
 			int shiftLeft = -shiftRight;
 			if (shiftLeft < (64 - ieee754_parameter<Real>::fbits)) {  // what is the distance between the MSB and 64?
 				// no need to round, just shift the bits in place
 				rawFraction <<= shiftLeft;
-				rawFraction = (s ? (~rawFraction + 1) : rawFraction); // if negative, map to two's complement
 				lnsExponent.setbits(rawFraction);
+				if (s) lnsExponent.twosComplement(); // if negative, map to two's complement across the full width of the exponent
 			}
 			else {
 				// we need to project the bits we have on the fixpnt
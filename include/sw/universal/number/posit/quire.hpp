@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
 #include <universal/utility/boolean_logic_operators.hpp>
 #include <universal/number/quire/exceptions.hpp>
 
@@ -109,9 +110,17 @@ public:
 	// the upper is 1 bit bigger than the lower because maxpos^2 has that scale
 	static constexpr unsigned upper_range = half_range + 1;     // size of the upper accumulator
 	static constexpr unsigned qbits = range + capacity;		  // size of the quire minus the sign bit: we are managing the sign explicitly
-	
+
+	// The accumulator is a single two's complement fixed-point number stored in 64-bit limbs.
+	// Bit 0 is the lsb of the lower segment, the radix point sits at bit half_range, and the
+	// lower, upper, and capacity segments are followed by the sign bit. Products and sums
+	// are added and subtracted a limb at a time with carry/borrow propagation, and
+	// a change of sign simply falls out of the two's complement arithmetic.
+	static constexpr unsigned mbits = half_range + upper_range + capacity;  // magnitude bits of the segmented view
+	static constexpr unsigned nrLimbs = (mbits + 1 + 63) / 64;            // magnitude bits + sign bit
+
 	// Constructors
-	quire() : _sign(false) { _capacity.reset(); _upper.reset(); _lower.reset(); }
+	quire() { reset(); }
 
 	quire(int8_t initial_value)   { *this = initial_value; }
 	quire(int16_t initial_value)  { *this = initial_value; }
@@ -132,43 +141,11 @@ public:
 		reset();
 		if (rhs.iszero()) return *this;
 		if (rhs.isinf() || rhs.isnan()) throw posit_operand_is_nar{};
-		_sign = rhs.sign();
-
-		int scale = rhs.scale();
 		// TODO: we are clamping the values of the RHS to be within the dynamic range of the posit
 		// TODO: however, on the upper side we also have the capacity bits, which gives us the opportunity 
 		// TODO: to accept larger scale values than the dynamic range of the posit.
 		// TODO: When you are assigning the sum of quires you could hit this condition.
-		if (scale >  int(half_range)) 	throw operand_too_large_for_quire{};
-		if (scale < -int(half_range)) 	throw operand_too_small_for_quire{};
-
-		int i, f; // running bit pointers, i for the quire, f for the incoming fraction
-		sw::universal::bitblock<fbits+1> fraction = rhs.get_fixed_point();
-		// divide bits between upper and lower accumulator
-		if (scale - int(fbits) >= 0) {
-			// all upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[static_cast<unsigned>(i)] = fraction[static_cast<unsigned>(f)];
-			}
-		}
-		else if (scale < 0) {
-			// all lower accumulator
-			for (i = int(half_range) + scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_lower[static_cast<unsigned>(i)] = fraction[static_cast<unsigned>(f)];
-			}
-		}
-		else {
-			// part upper, and part lower accumulator
-			// first assign the bits in the upper accumulator
-			for (i = scale, f = int(fbits); i >= 0 && f >= 0; i--, f--) {
-				_upper[static_cast<unsigned>(i)] = fraction[static_cast<unsigned>(f)];
-			}
-			// next assign the bits in the lower accumulator
-			for (i = int(half_range) - 1; i >= 0 && f >= 0; i--, f--) {
-				_lower[static_cast<unsigned>(i)] = fraction[static_cast<unsigned>(f)];
-			}
-		}
-		return *this;
+		return *this += rhs;
 	}
 	quire& operator=(const posit<nbits, es>& rhs) {
 		*this = rhs.to_value();
@@ -189,29 +166,14 @@ public:
 	quire& operator=(int64_t rhs) {
 		clear();
 		// transform to sign-magnitude
-		_sign = rhs & 0x8000000000000000;
-		unsigned long long magnitude;
-		magnitude = static_cast<unsigned long long>(_sign ? -rhs : rhs);
+		bool negative = rhs < 0;
+		uint64_t magnitude = negative ? (0ull - static_cast<uint64_t>(rhs)) : static_cast<uint64_t>(rhs);
 		unsigned msb = find_msb(magnitude);
 		if (msb > half_range + capacity) {
 			throw operand_too_large_for_quire{};
 		}
-		else {
-			// copy the value into the quire
-			uint32_t i;
-			uint64_t mask = uint64_t(1);
-			for (i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = magnitude & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				uint32_t c;
-				for (i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = magnitude & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		// the integer's lsb aligns with the radix point
+		accumulate(&magnitude, 1, int(radix_point), negative);
 		return *this;
 	}
 	quire& operator=(unsigned long long rhs) {
@@ -220,20 +182,8 @@ public:
 		if (msb > half_range + capacity) {
 			throw operand_too_large_for_quire{};
 		}
-		else {
-			// copy the value into the quire
-			uint64_t mask = uint64_t(1);
-			for (unsigned i = 0; i < msb && i < half_range; i++) {
-				_upper[i] = rhs & mask;
-				mask <<= 1;
-			}
-			if (msb >= half_range) {
-				for (unsigned i = half_range, c = 0; i < msb && i < half_range + capacity; i++, c++) {
-					_capacity[c] = rhs & mask;
-					mask <<= 1;
-				}
-			}
-		}
+		uint64_t magnitude = rhs;
+		accumulate(&magnitude, 1, int(radix_point), false);
 		return *this;
 	}
 	quire& operator=(float rhs) {
@@ -265,36 +215,7 @@ public:
 		if (rhs.scale() < -int(half_range)) {
 			throw operand_too_small_for_quire{};
 		}
-		// sign/magnitude classification
-		// operation      add magnitudes           subtract magnitudes
-		//                                     a < b       a = b      a > b
-		// (+a) + (+b)      +(a + b)
-		// (+a) + (-b)                       -(b - a)    +(a - b)   +(a - b)
-		// (-a) + (+b)                       +(b - a)    +(a - b)   -(a - b)
-		// (-a) + (-b)      -(a + b)
-		if (_sign == rhs.sign()) {
-			add_value(rhs);
-			// _sign stays the same, so nothing new to assign
-		}
-		else {
-			// subtract magnitudes
-			int cmp = CompareMagnitude(rhs);
-			if (cmp < 0) {
-				// TODO: is there a way to NOT have to swap the whole quire?
-				internal::value<qbits> subtractend = this->to_value();
-				*this = rhs;
-				subtract_value(subtractend);
-				_sign = rhs.sign();
-			}
-			else if (cmp > 0) {
-				subtract_value(rhs);
-				// _sign stays the same
-			}
-			else {
-				subtract_value(rhs);
-				_sign = false;
-			}
-		}
+		accumulate_value(rhs, rhs.sign());
 		return *this;
 	}
 	// Subtract a normalized value from the quire value
@@ -312,21 +233,37 @@ public:
 		return operator-=(rhs.to_value());
 	}
 
-	// add two quires
+	// add two quires: both are aligned at the same radix point, so this is a plain multi-limb add
 	quire& operator+=(const quire& q) {
-		return operator+=(q.to_value());
+		uint64_t carry = 0;
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			uint64_t a = _limb[i];
+			uint64_t s = a + q._limb[i];
+			uint64_t c = (s < a ? 1u : 0u);
+			_limb[i] = s + carry;
+			carry = c | (_limb[i] < s ? 1u : 0u);
+		}
+		return *this;
 	}
 	// subtract two quires
 	quire& operator-=(const quire& q) {
-		return operator-=(q.to_value());
+		uint64_t borrow = 0;
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			uint64_t a = _limb[i];
+			uint64_t d = a - q._limb[i];
+			uint64_t b = (d > a ? 1u : 0u);
+			_limb[i] = d - borrow;
+			borrow = b | (_limb[i] > d ? 1u : 0u);
+		}
+		return *this;
 	}
 	
-	// bit addressing operator
+	// bit addressing operator: returns the bits of the magnitude
 	bool operator[](int index) const {
-		if (index < int(radix_point)) return _lower[static_cast<unsigned>(index)];
-		if (index < int(radix_point + upper_range)) return _upper[static_cast<unsigned>(index) - radix_point];
-		if (index < int(radix_point + upper_range + capacity)) return _capacity[static_cast<unsigned>(index) - radix_point - upper_range];
-		throw "index out of range";
+		if (index < 0 || index >= int(mbits)) throw "index out of range";
+		if (!sign()) return bit(unsigned(index));
+		// the magnitude of a negative quire is its two's complement: a bit flips when any lower bit is set
+		return bit(unsigned(index)) != anyAfter(index - 1);
 	}
 
 // Modifiers
@@ -334,23 +271,21 @@ public:
 	// state management operators
 	// reset the state of a quire to zero
 	void reset() {
-		_sign = false;
-		_lower.reset();
-		_upper.reset();
-		_capacity.reset();
+		for (unsigned i = 0; i < nrLimbs; ++i) _limb[i] = 0;
 	}
 	// semantic sugar: clear the state of a quire to zero
 	void clear() { reset(); }
-	void set_sign(bool v) { _sign = v; }
+	void set_sign(bool v) { if (v != sign() && !iszero()) negate(); }
 	bool load_bits(const std::string& string_of_bits) {
 		reset();
 		// format is "+:0000_000000000.000000000"
 		std::string::const_iterator it = string_of_bits.begin();
+		bool negative = false;
 		if (*it == '-') {
-			_sign = true;
+			negative = true;
 		}
 		else if (string_of_bits[0] == '+') {
-			_sign = false;
+			negative = false;
 		}
 		else {
 			return false; // fail
@@ -362,52 +297,22 @@ public:
 		else {
 			return false; // fail, wrong format
 		}
-		int segment = 0; // capacity segment = 0, upper segment = 1, lower segment = 2
-		int msb_c = capacity - 1;
-		int msb_u = upper_range - 1;
-		int msb_l = half_range - 1;
+		// capacity segment ends at bit half_range + upper_range, the upper segment at the radix point
+		int msb = int(mbits) - 1;
 		for (; it != string_of_bits.end(); ++it) {
 			if (*it == '_') {
-				if (msb_c != -1) return false; // fail: incorrect format
-				segment = 1;
+				if (msb != int(half_range + upper_range) - 1) return false; // fail: incorrect format
 			}
 			else if (*it == '.') {
-				if (msb_u != -1) return false; // fail, incorrect format
-				segment = 2;
-			}
-			else if (*it == '1') {
-				switch (segment) {
-				case 0:
-					_capacity.set(msb_c--);
-					break;
-				case 1:
-					_upper.set(msb_u--);
-					break;
-				case 2:
-					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.set(msb_l--);
-					break;
-				default:
-					return false; // fail, incorrect state
-				}
+				if (msb != int(half_range) - 1) return false; // fail, incorrect format
 			}
 			else {
-				switch (segment) {
-				case 0:
-					_capacity.reset(msb_c--);
-					break;
-				case 1:
-					_upper.reset(msb_u--);
-					break;
-				case 2:
-					if (msb_l < 0) return false; // fail, incorrect format
-					_lower.reset(msb_l--);
-					break;
-				default:
-					return false; // fail, incorrect state
-				}
+				if (msb < 0) return false; // fail, incorrect format
+				if (*it == '1') _limb[unsigned(msb) / 64] |= (uint64_t(1) << (unsigned(msb) % 64));
+				--msb;
 			}
 		}
+		if (negative) negate();
 		return true;
 	}
 
@@ -415,18 +320,11 @@ public:
 	
 	// Compare magnitudes between quire and value: returns -1 if q < v, 0 if q == v, and 1 if q > v
 	template<unsigned fbits>
-	int CompareMagnitude(const internal::value<fbits>& v) {
-		// inefficient as we are copying a whole quire just to reset the sign bit, but we are leveraging the comparison logic
+	int CompareMagnitude(const internal::value<fbits>& v) const {
 		quire<nbits, es, capacity> absq = abs(*this);
-		//value<qbits> absq = abs(*this);
-		internal::value<fbits> absv = abs(v);
-		if (absq < absv) {
-			return -1;
-		}
-		else if (absq > absv) {
-			return 1;
-		}
-		return 0;
+		quire<nbits, es, capacity> absv;
+		absv.accumulate_value(v, false);
+		return compare(absq, absv);
 	}
 	// query functions for quire attributes
 	inline int dynamic_range() const { return int(range); }
@@ -434,86 +332,33 @@ public:
 	inline int min_scale() const { return -int(half_range); }
 	inline int capacity_range() const { return int(capacity); }
 	inline unsigned total_bits() const { return qbits + 1; }
-	inline bool isneg() const { return _sign; }
-	inline bool ispos() const { return _sign; }
-	inline bool iszero() const { return _capacity.none() && _upper.none() && _lower.none(); }
+	inline bool isneg() const { return sign(); }
+	inline bool ispos() const { return !sign(); }
+	// the quire is zero when the bits of the magnitude are, like the segmented accumulator, it wraps around on overflow
+	inline bool iszero() const { return !anyAfter(int(mbits) - 1); }
 	int scale() const {
-		int msb = int(capacity)-1; // indicative of no bits set
-		for (; msb >= 0; msb--) {
-			if (_capacity.test(static_cast<unsigned>(msb))) break;
-		}
-		if (msb >= 0) return msb + int(upper_range);
-		for (msb = int(upper_range) - 1; msb >= 0; msb--) {
-			if (_upper.test(static_cast<unsigned>(msb))) break;
-		}
-		if (msb >= 0) return msb;
-		for (int i = int(half_range) - 1; i >= 0; i--, msb--) {
-			if (_lower.test(static_cast<unsigned>(i))) break;
-		}
-		return msb;
+		uint64_t magnitude[nrLimbs];
+		get_magnitude(magnitude);
+		return msb(magnitude) - int(half_range);
 	}
 
 	// Return value of the sign bit: true indicates a negative number, false a positive number or zero
-	inline bool sign() const { return _sign; }
-	inline float sign_value() const {	return (_sign ? -1.0 : 1.0); }
+	inline bool sign() const { return (_limb[nrLimbs - 1] >> 63) != 0; }
+	inline float sign_value() const {	return (sign() ? -1.0f : 1.0f); }
 	internal::bitblock<qbits+1> get() const {
-		internal::bitblock<qbits+1> q;
-		int msb = 0;
-		for (int i = 0; i < half_range; i++) {
-			q[msb] = _lower[i];
-			msb++;
-		}
-		for (int i = 0; i < upper_range; i++) {
-			q[msb] = _upper[i];
-			msb++;
-		}
-		for (int i = 0; i < capacity; i++) {
-			q[msb] = _capacity[i];
-			msb++;
-		}
-		return q;
+		uint64_t magnitude[nrLimbs];
+		get_magnitude(magnitude);
+		return internal::from_limbs<qbits + 1>(magnitude);
 	}
 	internal::value<qbits> to_value() const {
-		// find the MSB and build the fraction
-		internal::bitblock<qbits> fraction;
-		bool isZero = false;
-		bool isNaR = false;   // TODO
-		int i;
-		int qbit = int(qbits);
-		int fbit = qbit - 1;
-		int scale = qbits;
-		for (i = int(capacity) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_capacity.test(static_cast<unsigned>(i))) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[static_cast<unsigned>(fbit)] = _capacity[static_cast<unsigned>(i)];
-				--fbit;
-			}
-		}
-		for (i = int(upper_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_upper.test(static_cast<unsigned>(i))) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[static_cast<unsigned>(fbit)] = _upper[static_cast<unsigned>(i)];
-				--fbit;
-			}
-		}
-		for (i = int(half_range) - 1; i >= 0; i--, qbit--) {
-			if (scale == qbits) {
-				if (_lower.test(static_cast<unsigned>(i))) scale = qbit - int(half_range);
-			}
-			else {
-				fraction[static_cast<unsigned>(fbit)] = _lower[static_cast<unsigned>(i)];
-				--fbit;
-			}
-		}
-		if (scale == qbits) {
-			isZero = true;
-			scale = 0;
-		}
-		return internal::value<qbits>(_sign, scale, fraction, isZero, isNaR);
+		uint64_t magnitude[nrLimbs];
+		get_magnitude(magnitude);
+		int msbIndex = msb(magnitude);
+		if (msbIndex < 0) return internal::value<qbits>(false, 0, internal::bitblock<qbits>(), true, false);
+		// left-align the bits below the msb in the fraction, the msb becomes the hidden bit
+		shift_left(magnitude, unsigned(int(qbits) - msbIndex));
+		internal::bitblock<qbits> fraction = internal::from_limbs<qbits>(magnitude);
+		return internal::value<qbits>(sign(), msbIndex - int(half_range), fraction, false, false);
 	}
 	template <typename ToValue>
 	ToValue convert_to() const {
@@ -521,246 +366,134 @@ public:
             convert(to_value(), v);
             return v;
         }
+	// any bit of the magnitude set at or below index
 	bool anyAfter(int index) const {
-		for (int i = index; i >= 0; i--) {
-			if (this->operator[](i)) return true;
-		}
-		return false;
+		if (index < 0) return false;
+		if (index >= int(mbits)) index = int(mbits) - 1;
+		// the lowest set bit of x and -x are the same, so we can test the two's complement bits
+		unsigned top = unsigned(index) / 64;
+		for (unsigned i = 0; i < top; ++i) if (_limb[i]) return true;
+		unsigned shift = 63u - unsigned(index) % 64;
+		return (_limb[top] << shift) != 0;
 	}
 
 private:
-	bool				   _sign;
-	// segmented accumulator to demonstrate potential hw concurrency for high performance quires
-	bitblock<half_range>   _lower;
-	bitblock<upper_range>  _upper;
-	bitblock<capacity>     _capacity;
-
-	// add a value to the quire
-	template<unsigned fbits>
-	void add_value(const internal::value<fbits>& v) {
-		if (v.iszero()) return;
-		// scale is the location of the msb in the fixed point representation
-		// so scale  =  0 is the hidden bit at location 0, scale 1 = bit 1, etc.
-		// and scale = -1 is the first bit of the fraction
-		// we manage scale >= 0 in the _upper accumulator, and scale < 0 in the _lower accumulator
-		int lsb = v.scale() - static_cast<int>(fbits);
-		bool carry = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			lsb = int(half_range) + v.scale() - int(fbits); /// TODO: double check this fix works
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[static_cast<unsigned>(i)];
-				bool _b = fraction[static_cast<unsigned>(f)];
-				_lower[static_cast<unsigned>(i)] = _a ^ _b ^ carry;
-				carry = (_a && _b) || (carry && (_a ^ _b));
-			}
-			// propagate any carries to the end of the lower accumulator
-			while (carry && i < int(half_range)) {
-				bool _a = _lower[static_cast<unsigned>(i)];
-				_lower[static_cast<unsigned>(i)] = _a ^ carry;
-				carry = carry && _a;
-				i++;
-			}
-			if (carry) {  // carry propagate to the _upper accumulator
-						  // need to increment the _upper
-				i = 0;
-				while (carry && i < int(upper_range)) {
-					bool _a = _upper[static_cast<unsigned>(i)];
-					_upper[static_cast<unsigned>(i)] = _a ^ carry;
-					carry = carry && _a;
-					i++;
-				}
-				if (carry) {
-					// next add the bits to the capacity segment
-					i = 0;
-					while (carry && i < int(capacity)) {
-						bool _a = _capacity[static_cast<unsigned>(i)];
-						_capacity[static_cast<unsigned>(i)] = _a ^ carry;
-						carry = carry && _a;
-						i++;
-					}
-				}
-			}
+	uint64_t _limb[nrLimbs];   // two's complement fixed-point, least significant limb first
+
+	bool bit(unsigned index) const { return (_limb[index / 64] >> (index % 64)) & 0x1; }
+
+	// two's complement negation
+	void negate() {
+		uint64_t carry = 1;
+		for (unsigned i = 0; i < nrLimbs; ++i) {
+			_limb[i] = ~_limb[i] + carry;
+			carry = (carry && _limb[i] == 0) ? 1u : 0u;
+		}
+	}
+	// magnitude of the segmented sign-magnitude view
+	void get_magnitude(uint64_t* magnitude) const {
+		for (unsigned i = 0; i < nrLimbs; ++i) magnitude[i] = _limb[i];
+		if (sign()) {
+			uint64_t carry = 1;
+			for (unsigned i = 0; i < nrLimbs; ++i) {
+				magnitude[i] = ~magnitude[i] + carry;
+				carry = (carry && magnitude[i] == 0) ? 1u : 0u;
+			}
+		}
+		// bits beyond the capacity segment are overflow
+		constexpr unsigned topBits = mbits - 64 * (nrLimbs - 1);
+		if constexpr (topBits < 64) magnitude[nrLimbs - 1] &= (uint64_t(1) << topBits) - 1;
+	}
+	// position of the most significant bit of a magnitude, -1 if zero
+	static int msb(const uint64_t* magnitude) {
+		for (int i = int(nrLimbs) - 1; i >= 0; --i) {
+			if (magnitude[i]) return 64 * i + 63 - std::countl_zero(magnitude[i]);
+		}
+		return -1;
+	}
+	static void shift_left(uint64_t* limbs, unsigned shift) {
+		unsigned limbShift = shift / 64;
+		unsigned bitShift = shift % 64;
+		for (int i = int(nrLimbs) - 1; i >= 0; --i) {
+			int src = i - int(limbShift);
+			uint64_t hi = (src >= 0 ? limbs[src] : 0);
+			uint64_t lo = (src >= 1 ? limbs[src - 1] : 0);
+			limbs[i] = (bitShift == 0 ? hi : (hi << bitShift) | (lo >> (64 - bitShift)));
+		}
+	}
+	// 64 bits of a little-endian limb array starting at bit position pos, bits outside the array read as 0
+	static uint64_t extract64(const uint64_t* limbs, int nrSrcLimbs, int pos) {
+		int index = pos >> 6;    // floor(pos / 64), also for negative positions
+		unsigned offset = unsigned(pos & 63);
+		uint64_t lo = (index >= 0 && index < nrSrcLimbs ? limbs[index] : 0);
+		if (offset == 0) return lo;
+		uint64_t hi = (index + 1 >= 0 && index + 1 < nrSrcLimbs ? limbs[index + 1] : 0);
+		return (lo >> offset) | (hi << (64 - offset));
+	}
+
+	// add, or subtract, a magnitude stored in nrSrcLimbs limbs with its lsb at quire bit lsb
+	// bits that fall below the lsb of the quire are truncated
+	void accumulate(const uint64_t* magnitude, int nrSrcLimbs, int lsb, bool subtract) {
+		int lowest = (lsb > 0 ? lsb : 0);
+		int highest = lsb + 64 * nrSrcLimbs - 1;
+		if (highest < 0) return;
+		unsigned first = unsigned(lowest) / 64;
+		unsigned last = unsigned(highest) / 64;
+		if (last >= nrLimbs) last = nrLimbs - 1;
+		uint64_t carry = 0;
+		unsigned i = first;
+		if (subtract) {
+			for (; i <= last; ++i) {
+				uint64_t b = extract64(magnitude, nrSrcLimbs, int(64 * i) - lsb);
+				uint64_t a = _limb[i];
+				uint64_t d = a - b;
+				uint64_t borrow = (d > a ? 1u : 0u);
+				_limb[i] = d - carry;
+				carry = borrow | (_limb[i] > d ? 1u : 0u);
+			}
+			for (; carry && i < nrLimbs; ++i) carry = (_limb[i]-- == 0 ? 1u : 0u);
 		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[static_cast<unsigned>(i)];
-				bool _b = fraction[static_cast<unsigned>(f)];
-				_upper[static_cast<unsigned>(i)] = _a ^ _b ^ carry;
-				carry = (_a && _b) || (carry && (_a ^ _b));
-			}
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[static_cast<unsigned>(i)];
-				_upper[static_cast<unsigned>(i)] = _a ^ carry;
-				carry = carry && _a;
-				i++;
-			}
-			if (carry) {
-				// next add the bits to the capacity segment
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[static_cast<unsigned>(i)];
-					_capacity[static_cast<unsigned>(i)] = _a ^ carry;
-					carry = carry && _a;
-					i++;
-				}
-			}
-		}
-		else {  // lsb < 0 && scale > 0
-				// part upper, and part lower accumulator
-				// first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[static_cast<unsigned>(i)];
-				bool _b = fraction[static_cast<unsigned>(f)];
-				_lower[static_cast<unsigned>(i)] = _a ^ _b ^ carry;
-				carry = (_a && _b) || (carry && (_a ^ _b));
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[static_cast<unsigned>(i)];
-				bool _b = fraction[static_cast<unsigned>(f)];
-				_upper[static_cast<unsigned>(i)] = _a ^ _b ^ carry;
-				carry = (_a && _b) || (carry && (_a ^ _b));
-			}
-			// propagate any carries to the end of the upper accumulator
-			while (carry && i < int(upper_range)) {
-				bool _a = _upper[static_cast<unsigned>(i)];
-				_upper[static_cast<unsigned>(i)] = _a ^ carry;
-				carry = carry && _a;
-				i++;
-			}
-			// next add the bits to the capacity segment
-			if (carry) {
-				i = 0;
-				while (carry && i < int(capacity)) {
-					bool _a = _capacity[static_cast<unsigned>(i)];
-					_capacity[static_cast<unsigned>(i)] = _a ^ carry;
-					carry = carry && _a;
-					i++;
-				}
+		else {
+			for (; i <= last; ++i) {
+				uint64_t b = extract64(magnitude, nrSrcLimbs, int(64 * i) - lsb);
+				uint64_t a = _limb[i];
+				uint64_t s = a + b;
+				uint64_t c = (s < a ? 1u : 0u);
+				_limb[i] = s + carry;
+				carry = c | (_limb[i] < s ? 1u : 0u);
 			}
+			for (; carry && i < nrLimbs; ++i) carry = (++_limb[i] == 0 ? 1u : 0u);
 		}
 	}
-
-	// subtract a value from the quire
+	// add a normalized value with the given sign to the quire
 	template<unsigned fbits>
-	void subtract_value(const internal::value<fbits>& v) {
+	void accumulate_value(const internal::value<fbits>& v, bool negative) {
 		if (v.iszero()) return;
-		// lsb in the quire of the lowest bit of the explicit fixed point value including the hidden bit of the fraction
-		int lsb = v.scale() - static_cast<int>(fbits);
-		bool borrow = false;
-		bitblock<fbits + 1> fraction = v.get_fixed_point();
-		int i, f;  // bit pointers, i pointing to the quire bits, f pointing to the fraction bits of rhs
-		// divide bits between upper and lower accumulator
-		if (v.scale() < 0) {		// all lower accumulator
-			lsb = int(half_range) + v.scale() - static_cast<int>(fbits);
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[unsigned(i)];
-				bool _b = fraction[unsigned(f)];
-				_lower[unsigned(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a && _b) || (bxnor(!_a, !_b) && borrow);
-			}
-			// propagate any borrows to the end of the lower accumulator
-			while (borrow && i < int(half_range)) {
-				bool _a = _lower[unsigned(i)];
-				_lower[unsigned(i)] = _a ^ borrow;
-				borrow = borrow && !_a;
-				i++;
-			}
-			if (borrow) { // borrow propagate to the _upper accumulator
-						  // need to decrement the _upper
-				i = 0;
-				while (borrow && i < int(upper_range)) {
-					bool _a = _upper[unsigned(i)];
-					_upper[unsigned(i)] = _a ^ borrow;
-					borrow = borrow && !_a;
-					i++;
-				}
-				if (borrow) {
-					// propagate the borrow into the capacity segment
-					i = 0;
-					while (borrow && i < int(capacity)) {
-						bool _a = _capacity[unsigned(i)];
-						_capacity[unsigned(i)] = _a ^ borrow;
-						borrow = borrow && !_a;
-						i++;
-					}
-				}
-			}
-		}
-		else if (lsb >= 0) {	// all upper accumulator
-			int upper_bound = v.scale();
-			for (i = lsb, f = 0; i <= upper_bound && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[unsigned(i)];
-				bool _b = fraction[unsigned(f)];
-				_upper[unsigned(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a && _b) || (bxnor(!_a, !_b) && borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[unsigned(i)];
-				_upper[unsigned(i)] = _a ^ borrow;
-				borrow = borrow && !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[unsigned(i)];
-					_capacity[unsigned(i)] = _a ^ borrow;
-					borrow = borrow && !_a;
-					i++;
-				}
-			}
-		}
-		else {   // lsb < 0 && scale >= 0
-				 // part upper, and part lower accumulator
-				 // first add the lower accumulator component
-			lsb = int(half_range) + lsb; // remember lsb is negative in this block
-			int qlsb = lsb > 0 ? lsb : 0;
-			int flsb = lsb >= 0 ? 0 : -lsb;
-			for (i = qlsb, f = flsb; i < int(half_range) && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _lower[unsigned(i)];
-				bool _b = fraction[unsigned(f)];
-				_lower[unsigned(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a && _b) || (bxnor(!_a, !_b) && borrow);
-			}
-			// next add the bits in the upper accumulator
-			for (i = 0; i <= v.scale() && f <= static_cast<int>(fbits); i++, f++) {
-				bool _a = _upper[unsigned(i)];
-				bool _b = fraction[unsigned(f)];
-				_upper[unsigned(i)] = _a ^ _b ^ borrow;
-				borrow = (!_a && _b) || (bxnor(!_a, !_b) && borrow);
-			}
-			// propagate any borrows to the end of the upper accumulator
-			while (borrow && i < int(upper_range)) {
-				bool _a = _upper[unsigned(i)];
-				_upper[unsigned(i)] = _a ^ borrow;
-				borrow = borrow && !_a;
-				i++;
-			}
-			if (borrow) {
-				// propagate the borrow into the capacity segment
-				i = 0;
-				while (borrow && i < int(capacity)) {
-					bool _a = _capacity[unsigned(i)];
-					_capacity[unsigned(i)] = _a ^ borrow;
-					borrow = borrow && !_a;
-					i++;
-				}
-			}
+		// scale is the location of the msb in the fixed point representation
+		// so scale  =  0 is the hidden bit at the radix point, and the lsb of the fraction is fbits below it
+		constexpr unsigned nrFixedLimbs = (fbits + 1 + 63) / 64;
+		uint64_t fixed[nrFixedLimbs];
+		internal::to_limbs(v.get_fixed_point(), fixed);
+		accumulate(fixed, int(nrFixedLimbs), int(radix_point) + v.scale() - int(fbits), negative);
+	}
+
+	// signed comparison of two quires: -1, 0, or 1
+	static int compare(const quire& lhs, const quire& rhs) {
+		bool lneg = lhs.sign(), rneg = rhs.sign();
+		if (lneg != rneg) return (lneg ? -1 : 1);
+		// same sign: two's complement values order like their unsigned bit patterns
+		for (int i = int(nrLimbs) - 1; i >= 0; --i) {
+			if (lhs._limb[i] < rhs._limb[i]) return -1;
+			if (lhs._limb[i] > rhs._limb[i]) return 1;
 		}
+		return 0;
+	}
+	// signed comparison between the quire and a value, value bits below the lsb of the quire are ignored
+	template<unsigned fbits>
+	int compare(const internal::value<fbits>& v) const {
+		quire<nbits, es, capacity> q;
+		q.accumulate_value(v, v.sign());
+		return compare(*this, q);
 	}
 
 	// template parameters need names different from class template parameters (for gcc and clang)
@@ -821,8 +554,19 @@ inline quire<nbits, es, capacity> operator+(const quire<nbits, es, capacity>& lh
 ////////////////// QUIRE stream operators
 template<unsigned nbits, unsigned es, unsigned capacity>
 inline std::ostream& operator<<(std::ostream& ostr, const quire<nbits, es, capacity>& q) {
-	ostr << (q._sign ? "-:" : "+:") << q._capacity << "_" << q._upper << "." << q._lower;
-	return ostr;
+	using Quire = quire<nbits, es, capacity>;
+	// sign-magnitude format: sign:capacity_upper.lower
+	uint64_t magnitude[Quire::nrLimbs];
+	q.get_magnitude(magnitude);
+	std::string bits;
+	bits.reserve(Quire::mbits + 4);
+	bits += (q.sign() ? "-:" : "+:");
+	for (int i = int(Quire::mbits) - 1; i >= 0; --i) {
+		if (i == int(Quire::half_range + Quire::upper_range) - 1) bits += '_';
+		if (i == int(Quire::half_range) - 1) bits += '.';
+		bits += ((magnitude[unsigned(i) / 64] >> (unsigned(i) % 64)) & 0x1) ? '1' : '0';
+	}
+	return ostr << bits;
 }
 
 template<unsigned nbits, unsigned es, unsigned capacity>
@@ -832,116 +576,25 @@ inline std::istream& operator>> (std::istream& istr, const quire<nbits, es, capa
 }
 
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return lhs._sign == rhs._sign && lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower == rhs._lower; }
+inline bool operator==(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return quire<nbits, es, capacity>::compare(lhs, rhs) == 0; }
 template<unsigned nbits, unsigned es, unsigned capacity>
 inline bool operator!=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator==(lhs, rhs); }
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { 
-	bool bSmaller = false;
-	if (!lhs._sign && rhs._sign) {
-		bSmaller = true;
-	}
-	else if (lhs._sign == rhs._sign) {
-		if (lhs._capacity < rhs._capacity) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper < rhs._upper) {
-			bSmaller = true;
-		}
-		else if (lhs._capacity == rhs._capacity && lhs._upper == rhs._upper && lhs._lower < rhs._lower) {
-			bSmaller = true;
-		}
-	}
-	return bSmaller;
-}
+inline bool operator< (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return quire<nbits, es, capacity>::compare(lhs, rhs) < 0; }
 template<unsigned nbits, unsigned es, unsigned capacity>
 inline bool operator> (const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return  operator< (rhs, lhs); }
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator<=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator> (lhs, rhs) || lhs == rhs; }
+inline bool operator<=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator> (lhs, rhs); }
 template<unsigned nbits, unsigned es, unsigned capacity>
-inline bool operator>=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator< (lhs, rhs) || lhs == rhs; }
+inline bool operator>=(const quire<nbits, es, capacity>& lhs, const quire<nbits, es, capacity>& rhs) { return !operator< (lhs, rhs); }
 
-// magnitude comparison between quire and value
+// comparison between quire and value
 template<unsigned nbits, unsigned es, unsigned capacity, unsigned fbits>
-inline bool operator== (const quire<nbits, es, capacity>& q, const internal::value<fbits>& v) {
-	// not efficient, but leverages < and >
-	return !(q < v) && !(q > v);
-}
+inline bool operator== (const quire<nbits, es, capacity>& q, const internal::value<fbits>& v) { return q.compare(v) == 0; }
 template<unsigned nbits, unsigned es, unsigned capacity, unsigned fbits>
-inline bool operator< (const quire<nbits, es, capacity>& q, const internal::value<fbits>& v) {
-	bool bSmaller = false;  // default fall through is quire q is bigger than value v
-	if (!v.sign() && q.sign()) {
-		bSmaller = true;
-	}
-	else if (q.sign() == v.sign()) {
-		// compare magnitudes
-		int qscale = q.scale();
-		int vscale = v.scale();
-		if (qscale < vscale) {
-			bSmaller = true;
-		}
-		else if (qscale == vscale) {
-			// got to compare the fraction bits
-			bitblock<fbits + 1> fixed = v.get_fixed_point();
-			int i, f;  // bit pointers, i for the quire, f for the fraction in v
-			bool undecided = true;
-			for (i = int(quire<nbits, es, capacity>::radix_point) + qscale, f = int(fbits); i >= 0 && f >= 0; --i, --f) {
-				if (!q[i] && fixed[static_cast<unsigned>(f)]) {
-					bSmaller = true;
-					undecided = false;
-					break;
-				}
-				else if (q[i] && !fixed[static_cast<unsigned>(f)]) {
-					bSmaller = false;
-					undecided = false;
-					break;
-				}
-			}
-			if (undecided && i >= 0) { // fraction bits have been identical
-				// any bit set will make the quire bigger than the value
-				if (q.anyAfter(i)) {
-					bSmaller = false;
-				}
-			}
-		}
-	}
-	return bSmaller;
-}
+inline bool operator< (const quire<nbits, es, capacity>& q, const internal::value<fbits>& v) { return q.compare(v) < 0; }
 template<unsigned nbits, unsigned es, unsigned capacity, unsigned fbits>
-inline bool operator> (const quire<nbits, es, capacity>& q, const internal::value<fbits>& v) {
-	bool bBigger = false;  // default fall through is quire q is smaller than value v
-	if (!q.sign() && v.sign()) {
-		bBigger = true;
-	}
-	else if (q.sign() == v.sign()) {
-		// compare magnitudes
-		int qscale = q.scale();
-		int vscale = v.scale();
-		if (qscale > vscale) {
-			bBigger = true;
-		}
-		else if (qscale == vscale) {
-			// got to compare the fraction bits
-			bitblock<fbits + 1> fixed_point = v.get_fixed_point();
-			int i, f;  // bit pointers, i for the quire, f for the fraction in v
-			bool undecided = true;
-			for (i = int(quire<nbits, es, capacity>::radix_point) + qscale, f = int(fbits); i >= 0 && f >= 0; --i, --f) {
-				if (q[i] && !fixed_point[static_cast<unsigned>(f)]) {
-					bBigger = true;
-					undecided = false;
-					break;
-				}
-			}
-			if (undecided && i >= 0) { // fraction bits have been identical
-									   // any bit set will make the quire bigger
-				if (q.anyAfter(i)) {
-					bBigger = true;
-				}
-			}
-		}
-	}
-	return bBigger;
-}
+inline bool operator> (const quire<nbits, es, capacity>& q, const internal::value<fbits>& v) { return q.compare(v) > 0; }
 
 
 
@@ -980,17 +633,32 @@ internal::value<2 * (nbits - 2 - es)> quire_mul(const posit<nbits, es>& lhs, con
 	static constexpr unsigned mbits = 2 * fhbits;      // size of the multiplier output
 
 	internal::value<mbits> product;  // constructs to zero value
-	internal::value<fbits> a, b;
 
 	// special case handling
 	if (lhs.isnar() || rhs.isnar()) { product.setinf(); return product; }
 	if (lhs.iszero() || rhs.iszero()) return product;
 
-	// transform the inputs into (sign,scale,fraction) triples
-	a.set(sign(lhs), scale(lhs), extract_fraction<nbits, es, fbits>(lhs), lhs.iszero(), lhs.isnar());
-	b.set(sign(rhs), scale(rhs), extract_fraction<nbits, es, fbits>(rhs), rhs.iszero(), rhs.isnar());
-	module_multiply(a, b, product);    // multiply the two inputs
-
+	if constexpr (fhbits <= 64) {
+		// significands fit a limb: a single 64x64->128 bit multiply generates the full product
+		bool new_sign = sign(lhs) ^ sign(rhs);
+		int new_scale = scale(lhs) + scale(rhs);
+		uint64_t a = extract_fraction<nbits, es, fbits>(lhs).to_ullong() | (uint64_t(1) << fbits);
+		uint64_t b = extract_fraction<nbits, es, fbits>(rhs).to_ullong() | (uint64_t(1) << fbits);
+		internal::uint128 p = internal::umul128(a, b);
+		// the product of two significands in [1, 2) is in [1, 4): shift the hidden bit out
+		bool carry = (mbits > 64 ? (p.upper >> (mbits - 65)) : (p.lower >> (mbits - 1))) & 0x1;
+		unsigned shift = carry ? 1u : 2u;
+		if (carry) ++new_scale;
+		uint64_t limbs[2] = { p.lower << shift, (p.upper << shift) | (p.lower >> (64 - shift)) };
+		product.set(new_sign, new_scale, internal::from_limbs<mbits>(limbs), false, false, false);
+	}
+	else {
+		internal::value<fbits> a, b;
+		// transform the inputs into (sign,scale,fraction) triples
+		a.set(sign(lhs), scale(lhs), extract_fraction<nbits, es, fbits>(lhs), lhs.iszero(), lhs.isnar());
+		b.set(sign(rhs), scale(rhs), extract_fraction<nbits, es, fbits>(rhs), rhs.iszero(), rhs.isnar());
+		module_multiply(a, b, product);    // multiply the two inputs
+	}
 	return product;
 }
 
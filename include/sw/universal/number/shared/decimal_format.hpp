@@ -0,0 +1,125 @@
+#pragma once
+// decimal_format.hpp: decimal string conversion for the adaptive precision floating-point types
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cmath>
+#include <cstdint>
+#include <ios>
+#include <string>
+
+namespace sw { namespace universal {
+
+/// <summary>
+/// decimal representation of an adaptive precision value following the iostream conventions
+/// </summary>
+/// The value is scaled into [1, 10) and the digits are peeled off with the arithmetic of the type itself,
+/// so they are exact up to the precision the value carries. The last digit is rounded half up.
+/// Real needs iszero(), isneg(), scale(), an explicit conversion to double, and the arithmetic operators.
+template<typename Real>
+std::string to_decimal_string(const Real& v, std::streamsize precision, std::ios_base::fmtflags flags) {
+	const bool fixed      = (flags & std::ios_base::floatfield) == std::ios_base::fixed;
+	const bool scientific = (flags & std::ios_base::floatfield) == std::ios_base::scientific;
+	const bool general    = !fixed && !scientific;
+	const bool showpoint  = (flags & std::ios_base::showpoint) != 0;
+	if (precision < 0) precision = 6;
+	if (general && precision == 0) precision = 1;
+
+	std::string sign = (v.isneg() ? "-" : ((flags & std::ios_base::showpos) ? "+" : ""));
+	std::string digits;
+	int64_t k{ 0 };     // the first digit has weight 10^k
+	if (!v.iszero()) {
+		const Real one(1), five(5), ten(10);
+		Real y = (v.isneg() ? -v : v);
+		k = static_cast<int64_t>(std::floor(static_cast<double>(y.scale()) * 0.30102999566398120));
+		// y /= 10^k with the power formed by squaring
+		Real power(1), base(ten);
+		for (uint64_t e = static_cast<uint64_t>(k < 0 ? -k : k); e > 0; e >>= 1) {
+			if (e & 1) power *= base;
+			if (e > 1) base *= base;
+		}
+		if (k > 0) y /= power; else if (k < 0) y *= power;
+		while (y >= ten) { y /= ten; ++k; }
+		while (y < one) { y *= ten; --k; }
+
+		int64_t nrDigits = (fixed ? k + 1 + precision : (scientific ? precision + 1 : precision));
+		if (nrDigits > 0) {
+			for (int64_t i = 0; i < nrDigits; ++i) {
+				int d = static_cast<int>(static_cast<double>(y));
+				if (d > 9) d = 9;
+				Real rd(d);
+				if (y < rd) rd = Real(--d);
+				y -= rd;
+				digits.push_back(static_cast<char>('0' + d));
+				y *= ten;
+			}
+			if (y >= five) {
+				int64_t i = nrDigits - 1;
+				while (i >= 0 && digits[static_cast<size_t>(i)] == '9') digits[static_cast<size_t>(i--)] = '0';
+				if (i >= 0) {
+					++digits[static_cast<size_t>(i)];
+				}
+				else {
+					digits.insert(digits.begin(), '1');
+					++k;
+					if (!fixed) digits.pop_back();
+				}
+			}
+		}
+		else if (nrDigits == 0 && y >= five) {
+			digits = "1";
+			++k;
+		}
+		else {
+			k = 0;
+		}
+	}
+
+	auto digitAt = [&](int64_t weight) -> char {
+		int64_t i = k - weight;
+		return (i >= 0 && i < static_cast<int64_t>(digits.size()) ? digits[static_cast<size_t>(i)] : '0');
+	};
+	auto stripZeros = [&](std::string& fraction) {
+		if (general && !showpoint) {
+			while (!fraction.empty() && fraction.back() == '0') fraction.pop_back();
+		}
+	};
+
+	bool useScientific = scientific || (general && !digits.empty() && (k < -4 || k >= precision));
+	std::string s(sign);
+	if (useScientific) {
+		if (digits.empty()) digits = "0";
+		std::string fraction = digits.substr(1);
+		fraction.resize(static_cast<size_t>(general ? precision - 1 : precision), '0');
+		stripZeros(fraction);
+		s.push_back(digits[0]);
+		if (!fraction.empty() || showpoint) s.push_back('.');
+		s += fraction;
+		int64_t e = (digits == "0" ? 0 : k);
+		s.push_back('e');
+		s.push_back(e < 0 ? '-' : '+');
+		std::string exponent = std::to_string(e < 0 ? -e : e);
+		if (exponent.size() < 2) s.push_back('0');
+		s += exponent;
+	}
+	else {
+		int64_t nrDecimals = (general ? (digits.empty() ? precision - 1 : precision - 1 - k) : precision);
+		if (nrDecimals < 0) nrDecimals = 0;
+		if (k >= 0 && !digits.empty()) {
+			for (int64_t w = k; w >= 0; --w) s.push_back(digitAt(w));
+		}
+		else {
+			s.push_back('0');
+		}
+		std::string fraction;
+		for (int64_t w = -1; w >= -nrDecimals; --w) fraction.push_back(digitAt(w));
+		stripZeros(fraction);
+		if (!fraction.empty() || showpoint) s.push_back('.');
+		s += fraction;
+	}
+	return s;
+}
+
+}} // namespace sw::universal
@@ -0,0 +1,218 @@
+#pragma once
+// lookup_arithmetic.hpp: table-driven arithmetic for number systems with encodings of 8 bits or fewer
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+/*
+ * A number system with nbits <= 8 has at most 256 encodings, so each binary operator
+ * is a table of at most 256 x 256 result encodings. lookup_arithmetic<Real> tabulates
+ * +, -, *, /, negation, and the comparisons using the arithmetic of Real itself, so the
+ * tables reproduce Real bit for bit, including its rounding, saturation, and special
+ * value rules. Operand pairs for which Real throws an arithmetic exception hold the
+ * EXCEPTIONAL marker in place of a result encoding, and those pairs are evaluated by
+ * Real at run time so the exception is raised as before.
+ *
+ * The arithmetic of most Real types is not constexpr, and the 4 x 64K evaluations would
+ * exceed the constexpr step limits of the compilers anyway, so the tables are generated
+ * at run time, on first use, in a function-local static. Programs that never use the tables
+ * of a Real do not pay for them, and the initializers of other static objects may use them,
+ * as the first call builds them whatever the initialization order of the translation units.
+ * The cost on the hot path is the guard check of the local static, a load and a predictable branch.
+ *
+ * tabulated<Real> wraps an encoding of Real with operators that use the tables, so any
+ * configuration of 8 bits or fewer opts into the table-driven backend with
+ *     using fp8 = tabulated< cfloat<8, 4, uint8_t, true, false, false> >;
+ */
+namespace sw { namespace universal {
+
+	// raw encoding of a number system value in the lower nbits of a uint64_t
+	template<typename Real>
+	constexpr uint64_t lookup_encoding(const Real& v) {
+		constexpr uint64_t mask = (Real::nbits < 64 ? (uint64_t(1) << Real::nbits) : 0) - 1;
+		if constexpr (requires { v.block(0); }) {
+			return static_cast<uint64_t>(v.block(0)) & mask;
+		}
+		else if constexpr (requires { v.bits().block(0); }) {
+			return static_cast<uint64_t>(v.bits().block(0)) & mask;
+		}
+		else {
+			return static_cast<uint64_t>(v.bits()) & mask;
+		}
+	}
+
+	template<typename Real>
+	class lookup_arithmetic {
+	public:
+		static_assert(Real::nbits <= 8, "lookup_arithmetic is limited to encodings of 8 bits or fewer");
+		static constexpr unsigned nbits = Real::nbits;
+		static constexpr size_t NR_ENCODINGS = size_t(1) << nbits;
+		static constexpr size_t NR_PAIRS = NR_ENCODINGS * NR_ENCODINGS;
+
+		enum Operator : unsigned { ADD = 0, SUB = 1, MUL = 2, DIV = 3, NR_OPERATORS = 4 };
+		// result entry of an operand pair for which Real throws
+		static constexpr uint16_t EXCEPTIONAL = 0x100;
+		// relation entry of an operand pair: the outcome of Real's ==, <, and <=
+		enum Relation : uint8_t { EQ = 1, LT = 2, LE = 4 };
+
+		// result encoding of a op b
+		static uint8_t apply(Operator op, uint8_t a, uint8_t b) {
+			uint16_t c = table().result[op][pair(a, b)];
+			if (c == EXCEPTIONAL) return evaluate(op, a, b);  // raises the exception of Real
+			return static_cast<uint8_t>(c);
+		}
+		static uint8_t negate(uint8_t a) { return table().negation[a]; }
+		static double to_double(uint8_t a) { return table().value[a]; }
+
+		static uint8_t add(uint8_t a, uint8_t b) { return apply(ADD, a, b); }
+		static uint8_t sub(uint8_t a, uint8_t b) { return apply(SUB, a, b); }
+		static uint8_t mul(uint8_t a, uint8_t b) { return apply(MUL, a, b); }
+		static uint8_t div(uint8_t a, uint8_t b) { return apply(DIV, a, b); }
+
+		static bool equal(uint8_t a, uint8_t b)      { return (table().relation[pair(a, b)] & EQ) != 0; }
+		static bool less(uint8_t a, uint8_t b)       { return (table().relation[pair(a, b)] & LT) != 0; }
+		static bool less_equal(uint8_t a, uint8_t b) { return (table().relation[pair(a, b)] & LE) != 0; }
+
+		// Real-valued interface
+		static Real add(const Real& a, const Real& b) { return decode(add(encode(a), encode(b))); }
+		static Real sub(const Real& a, const Real& b) { return decode(sub(encode(a), encode(b))); }
+		static Real mul(const Real& a, const Real& b) { return decode(mul(encode(a), encode(b))); }
+		static Real div(const Real& a, const Real& b) { return decode(div(encode(a), encode(b))); }
+
+		static uint8_t encode(const Real& v) { return static_cast<uint8_t>(lookup_encoding(v)); }
+		static Real decode(uint8_t bits) {
+			Real v;
+			v.setbits(bits);
+			return v;
+		}
+
+	private:
+		static constexpr size_t pair(uint8_t a, uint8_t b) { return (size_t(a) << nbits) | b; }
+
+		static uint8_t evaluate(Operator op, uint8_t a, uint8_t b) {
+			Real ra = decode(a), rb = decode(b), c;
+			switch (op) {
+			case ADD: c = ra + rb; break;
+			case SUB: c = ra - rb; break;
+			case MUL: c = ra * rb; break;
+			case DIV: c = ra / rb; break;
+			default:  break;
+			}
+			return encode(c);
+		}
+
+		struct tables {
+			std::array<std::array<uint16_t, NR_PAIRS>, NR_OPERATORS> result;
+			std::array<uint8_t, NR_PAIRS>                            relation;
+			std::array<uint8_t, NR_ENCODINGS>                        negation;
+			std::array<double, NR_ENCODINGS>                         value;
+
+			tables() {
+				for (size_t a = 0; a < NR_ENCODINGS; ++a) {
+					Real ra = decode(static_cast<uint8_t>(a));
+					value[a] = double(ra);
+					negation[a] = encode(-ra);
+					for (size_t b = 0; b < NR_ENCODINGS; ++b) {
+						Real rb = decode(static_cast<uint8_t>(b));
+						size_t index = pair(static_cast<uint8_t>(a), static_cast<uint8_t>(b));
+						relation[index] = static_cast<uint8_t>((ra == rb ? EQ : 0) | (ra < rb ? LT : 0) | (ra <= rb ? LE : 0));
+						for (unsigned op = 0; op < NR_OPERATORS; ++op) {
+							try {
+								result[op][index] = evaluate(static_cast<Operator>(op), static_cast<uint8_t>(a), static_cast<uint8_t>(b));
+							}
+							catch (...) {
+								result[op][index] = EXCEPTIONAL;
+							}
+						}
+					}
+				}
+			}
+		};
+
+		// built on first use: thread-safe, and independent of the static initialization order
+		static const tables& table() {
+			static const tables instance{};
+			return instance;
+		}
+	};
+
+	// a value of Real whose arithmetic operators are served from the lookup tables
+	template<typename Real>
+	class tabulated {
+	public:
+		using engine = lookup_arithmetic<Real>;
+		using value_type = Real;
+		static constexpr unsigned nbits = Real::nbits;
+
+		tabulated() = default;
+		tabulated(const tabulated&) = default;
+		tabulated& operator=(const tabulated&) = default;
+
+		tabulated(const Real& v) : _bits{ engine::encode(v) } {}
+		template<typename Arithmetic, std::enable_if_t<std::is_arithmetic_v<Arithmetic>, bool> = true>
+		tabulated(Arithmetic v) : _bits{ engine::encode(Real(v)) } {}
+		template<typename Arithmetic, std::enable_if_t<std::is_arithmetic_v<Arithmetic>, bool> = true>
+		tabulated& operator=(Arithmetic v) { _bits = engine::encode(Real(v)); return *this; }
+
+		explicit operator Real() const { return engine::decode(_bits); }
+		explicit operator double() const { return engine::to_double(_bits); }
+		explicit operator float() const { return float(engine::to_double(_bits)); }
+
+		tabulated operator-() const { return fromBits(engine::negate(_bits)); }
+		tabulated& operator+=(const tabulated& rhs) { _bits = engine::add(_bits, rhs._bits); return *this; }
+		tabulated& operator-=(const tabulated& rhs) { _bits = engine::sub(_bits, rhs._bits); return *this; }
+		tabulated& operator*=(const tabulated& rhs) { _bits = engine::mul(_bits, rhs._bits); return *this; }
+		tabulated& operator/=(const tabulated& rhs) { _bits = engine::div(_bits, rhs._bits); return *this; }
+
+		void setbits(uint64_t value) noexcept { _bits = static_cast<uint8_t>(value & ((uint64_t(1) << nbits) - 1)); }
+		uint8_t bits() const noexcept { return _bits; }
+		Real value() const { return engine::decode(_bits); }
+
+		static tabulated fromBits(uint8_t bits) {
+			tabulated t;
+			t._bits = bits;
+			return t;
+		}
+
+	private:
+		uint8_t _bits{ 0 };
+	};
+
+	template<typename Real>
+	inline tabulated<Real> operator+(tabulated<Real> lhs, const tabulated<Real>& rhs) { return lhs += rhs; }
+	template<typename Real>
+	inline tabulated<Real> operator-(tabulated<Real> lhs, const tabulated<Real>& rhs) { return lhs -= rhs; }
+	template<typename Real>
+	inline tabulated<Real> operator*(tabulated<Real> lhs, const tabulated<Real>& rhs) { return lhs *= rhs; }
+	template<typename Real>
+	inline tabulated<Real> operator/(tabulated<Real> lhs, const tabulated<Real>& rhs) { return lhs /= rhs; }
+
+	// comparisons are served from the relation table of the encodings, so they follow the rules of Real, such as NaN != NaN and -0 == +0
+	template<typename Real>
+	inline bool operator==(const tabulated<Real>& lhs, const tabulated<Real>& rhs) { return lookup_arithmetic<Real>::equal(lhs.bits(), rhs.bits()); }
+	template<typename Real>
+	inline bool operator!=(const tabulated<Real>& lhs, const tabulated<Real>& rhs) { return !(lhs == rhs); }
+	template<typename Real>
+	inline bool operator< (const tabulated<Real>& lhs, const tabulated<Real>& rhs) { return lookup_arithmetic<Real>::less(lhs.bits(), rhs.bits()); }
+	template<typename Real>
+	inline bool operator> (const tabulated<Real>& lhs, const tabulated<Real>& rhs) { return rhs < lhs; }
+	template<typename Real>
+	inline bool operator<=(const tabulated<Real>& lhs, const tabulated<Real>& rhs) { return lookup_arithmetic<Real>::less_equal(lhs.bits(), rhs.bits()); }
+	template<typename Real>
+	inline bool operator>=(const tabulated<Real>& lhs, const tabulated<Real>& rhs) { return rhs <= lhs; }
+
+	template<typename Real>
+	inline std::ostream& operator<<(std::ostream& ostr, const tabulated<Real>& v) { return ostr << v.value(); }
+
+	template<typename Real>
+	inline std::string type_tag(const tabulated<Real>& v) { return std::string("tabulated<") + type_tag(v.value()) + '>'; }
+
+}} // namespace sw::universal
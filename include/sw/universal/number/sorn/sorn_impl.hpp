@@ -4,12 +4,13 @@
 // Copyright (C) 2022 ITEM, University of Bremen.
 //
 // This file is aimed to provide an addition and to be included in the universal numbers project.
-#include <cassert>
 #include <cstdint>
 #include <cmath>
+#include <array>
+#include <bit>
 #include <iostream>
 #include <sstream>
-#include <vector>
+#include <limits>
 #include <bitset>
 
 #include <universal/number/shared/specific_value_encoding.hpp>
@@ -17,14 +18,14 @@
 namespace sw { namespace universal {
 
 // struct sornInterval: a struct defining a SORN interval with two interval bound values and open/closed conditions.
-template<typename Real> 
+template<typename Real>
 struct sornInterval {
 	Real lowerBound;
 	Real upperBound;
 	bool lowerIsOpen;
 	bool upperIsOpen;
 
-	std::string getInt() {
+	std::string getInt() const {
 		std::stringstream configStream;
 		if ((this->lowerBound == this->upperBound) && (not this->lowerIsOpen && not this->upperIsOpen)) {
 			configStream << this->lowerBound;
@@ -35,116 +36,236 @@ struct sornInterval {
 		return configStream.str();
 	}
 
-	bool isZero() const noexcept {
-		if (this->lowerBound == 0 && this->upperBound == 0 && not this->lowerIsOpen && not this->upperIsOpen) {
-			return true;
-		} 
-		else {
-			return false;
-		}
+	constexpr bool isZero() const noexcept {
+		return (this->lowerBound == 0 && this->upperBound == 0 && not this->lowerIsOpen && not this->upperIsOpen);
 	}
 
 };
 
-// setSornDT: function to create a SORN datatype
-template<typename Real>
-inline std::vector<sornInterval<Real>> setSornDT(signed int start, signed int stop, unsigned int steps, float stepSize,
-									bool flagNeg, bool flagInf, bool flagZero, bool flagLin,
-									bool flagLog, bool flagHalfopen, bool flagOpen, size_t sornBits ) {
-	using SORN_INTERVAL = sornInterval<Real>;
-	using std::pow;
-	using std::fmax;
-
-	std::vector<SORN_INTERVAL> sornDT;
-	// 1. halfopen config
-	if (flagHalfopen) {
-		// 1.1. zero
-		if (flagZero) {
-			SORN_INTERVAL structInt;
-			structInt.lowerBound = 0;
-			structInt.upperBound = 0;
-			structInt.lowerIsOpen = false;
-			structInt.upperIsOpen = false;
-			sornDT.push_back(structInt);
-		}
-		// 1.2. positive part
-		if (flagLin) {
-			// 1.2.1 linear config
-			assert(start == 0 && "%% ERROR %% Start value has to be set to 0 for linear halfopen configuration.");
-			for (int b = 0; b < (int)steps; b++) {
-				SORN_INTERVAL structInt;
-				structInt.lowerBound = b * stepSize;
-				structInt.upperBound = (b + 1) * stepSize;
-				structInt.lowerIsOpen = (b == 0 && not flagZero ? false : true);
-				structInt.upperIsOpen = false;
-				sornDT.push_back(structInt);
-			}
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// SORN lattice and operator tables
+//
+// The lattice of a SORN configuration, the ordered set of disjoint intervals that together cover
+// the real numbers of the configuration, is a static constexpr table shared by all values of the
+// configuration. A SORN value is a bitset over the lattice, and bit k is set when the value
+// contains lattice interval k.
+//
+// For each operator, the table entry of the pair (i, j) of lattice intervals is the contiguous
+// range of lattice intervals that cover (interval i) op (interval j). The result of a SORN
+// operation is the union of the table entries of all pairs of set bits, so an operation on two
+// SORNs with a single set bit each is a single table lookup. The tables are generated at compile
+// time by the same interval arithmetic that serves the operations with scalar operands.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum class SornOperator : unsigned { ADD = 0, SUB = 1, MUL = 2, DIV = 3 };
+
+// sornRange: the lattice intervals [first, last] covered by the result of an interval operation,
+// empty when first > last. pole is set for the division of a non-zero interval by exact zero.
+struct sornRange {
+	std::uint16_t first;
+	std::uint16_t last;
+	bool pole;
+
+	constexpr bool empty() const noexcept { return first > last; }
+};
+
+// sornPow2: constexpr 2^e for the bounds of the logarithmic lattices
+constexpr float sornPow2(int e) {
+	float v = 1.0f;
+	for (int i = 0; i < e; ++i) v *= 2.0f;
+	for (int i = e; i < 0; ++i) v /= 2.0f;
+	return v;
+}
+
+// sornLattice: create the lattice of a halfopen SORN configuration
+template<typename Real, size_t sornBits>
+constexpr std::array<sornInterval<Real>, sornBits> sornLattice(signed int start, signed int stop, unsigned int steps, float stepSize,
+	                                                           bool flagNeg, bool flagInf, bool flagZero, bool flagLin) {
+	std::array<sornInterval<Real>, sornBits> positive{}, lattice{};
+	size_t n = 0;
+	// 1. zero
+	if (flagZero) {
+		positive[n++] = { Real(0), Real(0), false, false };
+	}
+	// 2. positive part
+	if (flagLin) {
+		// 2.1 linear config
+		for (int b = 0; b < (int)steps; b++) {
+			positive[n++] = { Real(b * stepSize), Real((b + 1) * stepSize), (b == 0 && not flagZero ? false : true), false };
 		}
-		else if (flagLog) {
-			// 1.2.2 logarithmic config (Note: "steps" value is ignored for logarithmic configuration)
-			for (int b = start; b < (stop + 1); b++) {
-				SORN_INTERVAL structInt;
-				structInt.lowerBound = (b == start ? 0 : (float)pow(2, (b - 1)));
-				structInt.upperBound = (float)pow(2, b);
-				structInt.lowerIsOpen = (b == 0 && not flagZero ? false : true);
-				structInt.upperIsOpen = false;
-				sornDT.push_back(structInt);
-			}
+	}
+	else {
+		// 2.2 logarithmic config (Note: "steps" value is ignored for logarithmic configuration)
+		for (int b = start; b < (stop + 1); b++) {
+			positive[n++] = { (b == start ? Real(0) : Real(sornPow2(b - 1))), Real(sornPow2(b)), (b == start && not flagZero ? false : true), false };
 		}
-		// 1.3. infinity
-		if (flagInf) {
-			SORN_INTERVAL structInt;
-			structInt.lowerBound = sornDT[sornDT.size() - 1].upperBound;
-			structInt.upperBound = std::numeric_limits<float>::infinity();
-			structInt.lowerIsOpen = true;
-			structInt.upperIsOpen = false;
-			sornDT.push_back(structInt);
+	}
+	// 3. infinity
+	if (flagInf) {
+		positive[n] = { positive[n - 1].upperBound, std::numeric_limits<Real>::infinity(), true, false };
+		++n;
+	}
+	// 4. negative intervals, mirrored in front of the positive part
+	size_t k = 0;
+	if (flagNeg) {
+		for (size_t b = n; b > (flagZero ? 1u : 0u); --b) {
+			const sornInterval<Real>& p = positive[b - 1];
+			lattice[k++] = { -p.upperBound, (p.lowerBound == 0 ? p.lowerBound : -p.lowerBound), false, true };
 		}
-		// 1.4. negative intervals
-		if (flagNeg) {
-			std::vector<SORN_INTERVAL> negDT;
-			for (int b = (flagZero ? 1 : 0); b < sornDT.size(); b++) {
-				SORN_INTERVAL structInt;
-				structInt.lowerBound = -sornDT[b].upperBound;
-				structInt.upperBound = (sornDT[b].lowerBound == 0 ? sornDT[b].lowerBound : -sornDT[b].lowerBound);
-				structInt.lowerIsOpen = false;
-				structInt.upperIsOpen = true;
-				negDT.insert(negDT.begin(), structInt);
+	}
+	for (size_t b = 0; b < n; ++b) lattice[k++] = positive[b];
+	return lattice;
+}
+
+// interval bounds of an intermediate result of the interval arithmetic
+struct sornBounds {
+	double lower;
+	double upper;
+	bool lowerIsOpen;
+	bool upperIsOpen;
+
+	constexpr bool isZero() const noexcept { return lower == 0 && upper == 0 && not lowerIsOpen && not upperIsOpen; }
+};
+
+constexpr bool sornIsInf(double v) { return v == std::numeric_limits<double>::infinity() || v == -std::numeric_limits<double>::infinity(); }
+
+template<typename Real>
+constexpr sornBounds sornToBounds(const sornInterval<Real>& v) {
+	return { double(v.lowerBound), double(v.upperBound), v.lowerIsOpen, v.upperIsOpen };
+}
+
+// sornCover: the contiguous range of lattice intervals that intersect [lower, upper], clamped to the lattice
+template<typename Real, size_t sornBits>
+constexpr sornRange sornCover(const std::array<sornInterval<Real>, sornBits>& lattice, const sornBounds& v) {
+	// first interval that does not lie entirely below the lower bound
+	size_t lo = 0, hi = sornBits;
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		double up = double(lattice[mid].upperBound);
+		bool below = (up < v.lower) || (up == v.lower && (lattice[mid].upperIsOpen || v.lowerIsOpen));
+		if (below) lo = mid + 1; else hi = mid;
+	}
+	size_t first = lo;
+	// first interval that lies entirely above the upper bound
+	lo = first; hi = sornBits;
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+		double low = double(lattice[mid].lowerBound);
+		bool above = (low > v.upper) || (low == v.upper && (lattice[mid].lowerIsOpen || v.upperIsOpen));
+		if (above) hi = mid; else lo = mid + 1;
+	}
+	size_t last = (lo == 0 ? 0 : lo - 1);
+	// values beyond the lattice saturate to its first or last interval
+	if (first >= sornBits) first = sornBits - 1;
+	if (last < first) last = first;
+	return { std::uint16_t(first), std::uint16_t(last), false };
+}
+
+// sornIsOpenSum: a closed bound of inf yields inf for every value of the other interval
+constexpr bool sornIsOpenSum(double x, bool xIsOpen, double y, bool yIsOpen) {
+	if ((!xIsOpen && sornIsInf(x)) || (!yIsOpen && sornIsInf(y))) return false;
+	return xIsOpen || yIsOpen;
+}
+
+// sornProduct: product of two interval bounds, false for the indeterminate 0 * inf
+constexpr bool sornProduct(double x, bool xIsOpen, double y, bool yIsOpen, double& v, bool& isOpen) {
+	if ((x == 0 && sornIsInf(y)) || (sornIsInf(x) && y == 0)) return false;
+	v = x * y;
+	if (v == 0) v = 0; // remove -0
+	// a closed bound of 0 or inf yields 0 or inf for every value of the other interval
+	isOpen = ((!xIsOpen && (x == 0 || sornIsInf(x))) || (!yIsOpen && (y == 0 || sornIsInf(y)))) ? false : (xIsOpen || yIsOpen);
+	return true;
+}
+
+// sornCombine: the lattice intervals covered by a op b, following the interval arithmetic rules
+template<typename Real, size_t sornBits>
+constexpr sornRange sornCombine(const std::array<sornInterval<Real>, sornBits>& lattice, SornOperator op, sornBounds a, sornBounds b) {
+	constexpr double inf = std::numeric_limits<double>::infinity();
+	constexpr sornRange empty{ 1, 0, false };
+	constexpr sornRange pole{ 1, 0, true };
+	switch (op) {
+	case SornOperator::SUB:
+		b = { -b.upper, -b.lower, b.upperIsOpen, b.lowerIsOpen };
+		[[fallthrough]];
+	case SornOperator::ADD:
+	{
+		sornBounds sum{};
+		// inf - inf is indeterminate and covers the whole lattice
+		if (sornIsInf(a.lower) && sornIsInf(b.lower) && a.lower != b.lower) { sum.lower = -inf; sum.lowerIsOpen = false; }
+		else { sum.lower = a.lower + b.lower; sum.lowerIsOpen = sornIsOpenSum(a.lower, a.lowerIsOpen, b.lower, b.lowerIsOpen); }
+		if (sornIsInf(a.upper) && sornIsInf(b.upper) && a.upper != b.upper) { sum.upper = inf; sum.upperIsOpen = false; }
+		else { sum.upper = a.upper + b.upper; sum.upperIsOpen = sornIsOpenSum(a.upper, a.upperIsOpen, b.upper, b.upperIsOpen); }
+		return sornCover(lattice, sum);
+	}
+	case SornOperator::DIV:
+		if (b.isZero()) return (a.isZero() ? empty : pole);
+		if (a.isZero()) return sornCover(lattice, a);
+		// lattice intervals do not straddle zero, so the reciprocal of b is a single interval
+		b = { (b.upper == 0 ? -inf : (sornIsInf(b.upper) ? 0.0 : 1.0 / b.upper)),
+		      (b.lower == 0 ?  inf : (sornIsInf(b.lower) ? 0.0 : 1.0 / b.lower)),
+		      b.upperIsOpen, b.lowerIsOpen };
+		[[fallthrough]];
+	case SornOperator::MUL:
+	default:
+	{
+		if (a.isZero() || b.isZero()) return sornCover(lattice, sornBounds{ 0.0, 0.0, false, false });
+		const double ax[2] = { a.lower, a.upper }, bx[2] = { b.lower, b.upper };
+		const bool   ao[2] = { a.lowerIsOpen, a.upperIsOpen }, bo[2] = { b.lowerIsOpen, b.upperIsOpen };
+		sornBounds prod{ inf, -inf, true, true };
+		bool valid = false;
+		for (int i = 0; i < 2; ++i) {
+			for (int j = 0; j < 2; ++j) {
+				double v{ 0 };
+				bool isOpen{ false };
+				if (!sornProduct(ax[i], ao[i], bx[j], bo[j], v, isOpen)) continue;
+				valid = true;
+				if (v < prod.lower) { prod.lower = v; prod.lowerIsOpen = isOpen; }
+				else if (v == prod.lower) { prod.lowerIsOpen = prod.lowerIsOpen && isOpen; }
+				if (v > prod.upper) { prod.upper = v; prod.upperIsOpen = isOpen; }
+				else if (v == prod.upper) { prod.upperIsOpen = prod.upperIsOpen && isOpen; }
 			}
-			sornDT.insert(sornDT.begin(), negDT.begin(), negDT.end());
 		}
+		if (!valid) prod = { -inf, inf, false, false };
+		return sornCover(lattice, prod);
 	}
-	// 2. open config (TODO)
-	else if (flagOpen) {
-		assert(not flagOpen && "%% WARNING %% Open interval datatypes not implemented.");
 	}
-	// 3. check config
-	assert(sornDT.size() == sornBits && "Something is wrong with the Datatype size. Check sornDT and sornBits.");
-	// 4. return DT
-	return sornDT;
 }
 
-// float2SORN: a function converting a single float input to a SORN interval
-template<typename Real>
-sornInterval<Real> float2SORN(float operand, std::vector<sornInterval<Real>> sornDT, sornInterval<Real>& sornIntVal) {
-	for (int b = 0; b < sornDT.size(); b++) {
-		if (	( (operand > sornDT[b].lowerBound) || (operand == sornDT[b].lowerBound && not sornDT[b].lowerIsOpen) ) &&
-				( (operand < sornDT[b].upperBound) || (operand == sornDT[b].upperBound && not sornDT[b].upperIsOpen) )		) {
-			sornIntVal = sornDT[b];
+// sornOperatorTable: the lattice ranges covered by all pairs of lattice intervals
+template<typename Real, size_t sornBits>
+constexpr std::array<sornRange, sornBits * sornBits> sornOperatorTable(const std::array<sornInterval<Real>, sornBits>& lattice, SornOperator op) {
+	std::array<sornRange, sornBits * sornBits> table{};
+	for (size_t i = 0; i < sornBits; ++i) {
+		for (size_t j = 0; j < sornBits; ++j) {
+			table[i * sornBits + j] = sornCombine(lattice, op, sornToBounds(lattice[i]), sornToBounds(lattice[j]));
+		}
+	}
+	return table;
+}
+
+// sornUnaryTable: the lattice ranges covered by the negation or the absolute value of each lattice interval
+template<typename Real, size_t sornBits>
+constexpr std::array<sornRange, sornBits> sornUnaryTable(const std::array<sornInterval<Real>, sornBits>& lattice, bool absolute) {
+	std::array<sornRange, sornBits> table{};
+	for (size_t i = 0; i < sornBits; ++i) {
+		sornBounds v = sornToBounds(lattice[i]);
+		if (!absolute || v.upper <= 0) {
+			v = { (v.upper == 0 ? 0.0 : -v.upper), (v.lower == 0 ? 0.0 : -v.lower), v.upperIsOpen, v.lowerIsOpen };
 		}
+		table[i] = sornCover(lattice, v);
 	}
-	return sornIntVal;
+	return table;
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
-// class sorn: a class for defining a SORN format:	sorn<start,stop,steps,lin,halfopen,neg,inf,zero>					 
-// 
-// -- Mandatory configuration parameters:	
-//		start:	lowest value in the SORN lattice // for "lin" start=0 // for "log" -inf<start<inf, lattice begins with 2^start 
+// class sorn: a class for defining a SORN format:	sorn<start,stop,steps,lin,halfopen,neg,inf,zero>
+//
+// -- Mandatory configuration parameters:
+//		start:	lowest value in the SORN lattice // for "lin" start=0 // for "log" -inf<start<inf, lattice begins with 2^start
 //		stop:	highest non-infinity value in the SORN lattice // for "lin" start<stop // for "log" start<stop, lattice ends with 2^stop
 //		steps:	number of intervals/steps within the SORN representation between "start" and "stop" for "lin" (positive part),
 //				not required for "log" distribution (any positve value allowed)
-// 
+//
 // -- Optional configuration parameters: (all "true" by default)
 //		lin:		set the SORN interval distribution to "linear" (true) or "logarithmic" (false)
 //		halfopen:	set the SORN interval distribution to "halfopen bounds, no exact values" (true) or "open bounds,
@@ -152,6 +273,9 @@ sornInterval<Real> float2SORN(float operand, std::vector<sornInterval<Real>> sor
 //		neg:		include negative values/intervals in the SORN datatype, symmetric to positive part
 //		inf:		inlcude infinity value/interval bounds to the SORN datatype
 //		zero:		inlcude the exact zero value in the SORN datatype
+//
+// A sorn value is the set of lattice intervals marked in its bitset: the empty set is the result
+// of indeterminate operations, such as 0/0, and plays the role of NaN.
 //////////////////////////////////////////////////////////////////////////////////////////////////
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg=1, bool _inf=1, bool _zero=1>
 class sorn {
@@ -163,8 +287,8 @@ public:
 private:
 
 	// input configuration parameters
-	static constexpr signed int start	= _start;	// lowest non-zero value in the SORN lattice 
-	static constexpr signed int stop	= _stop;	// highest non-infinity value in the SORN lattice 
+	static constexpr signed int start	= _start;	// lowest non-zero value in the SORN lattice
+	static constexpr signed int stop	= _stop;	// highest non-infinity value in the SORN lattice
 	static constexpr unsigned int steps	= _steps;	// number of intervals/steps within the SORN representation between start and stop (only for positive part, only for linear distribution)
 	static constexpr float stepSize = (float)(stop - start) / (float)steps;
 
@@ -175,15 +299,15 @@ private:
 	static constexpr bool flagLin		= _lin;			// set the SORN interval distribution to "linear"										(default: true)
 	static constexpr bool flagLog		= not _lin;		// set the SORN interval distribution to "logarithmic"									(default: false)
 	static constexpr bool flagHalfopen	= _halfopen;	// set the SORN interval distribution to halfopen without exacts						(default: true)
-	static constexpr bool flagOpen		= not _halfopen;// set the SORN interval distribution to open with intermediate exacts					(default: false) 
+	static constexpr bool flagOpen		= not _halfopen;// set the SORN interval distribution to open with intermediate exacts					(default: false)
 
-public:
+	static_assert(flagHalfopen, "open interval SORN datatypes are not implemented");
+	static_assert(flagLog || start == 0, "start value has to be set to 0 for linear halfopen configuration");
 
-	// SORN value with NaN initialisation
-	SORN_INTERVAL sornIntVal = { std::numeric_limits<Real>::quiet_NaN() , std::numeric_limits<Real>::quiet_NaN() , false , false };
+public:
 
-	// SORN bitwidth (redundant with sornDT.size())
-	static constexpr size_t sornBits =	( 
+	// SORN bitwidth (equal to sornDT.size())
+	static constexpr size_t sornBits =	(
 											( (flagLin ? steps : stop - start + 1) + (flagInf ? 1 : 0) ) *		// determine number of intervals (either halfopen or open)
 											(flagOpen ? 2 : 1)													// double if open intervals with intermediate exact values are used
 										) *
@@ -192,43 +316,49 @@ public:
 										((flagOpen & flagInf & flagNeg) ? 1 : 0);									// for open intervals only one value for +-inf is used
 	static constexpr size_t nbits = sornBits;
 
-	// SORN datatype
-	std::vector<SORN_INTERVAL> sornDT = setSornDT<Real>(start, stop, steps, stepSize, flagNeg, flagInf, flagZero, flagLin, flagLog, flagHalfopen, flagOpen, sornBits);
+	// SORN datatype: the lattice shared by all values of the configuration
+	static constexpr std::array<SORN_INTERVAL, sornBits> sornDT = sornLattice<Real, sornBits>(start, stop, steps, stepSize, flagNeg, flagInf, flagZero, flagLin);
 
-	// constructors
-	sorn() {}
+private:
+	// precomputed interval-union tables of the arithmetic operators
+	static constexpr std::array<sornRange, sornBits * sornBits> addTable = sornOperatorTable(sornDT, SornOperator::ADD);
+	static constexpr std::array<sornRange, sornBits * sornBits> subTable = sornOperatorTable(sornDT, SornOperator::SUB);
+	static constexpr std::array<sornRange, sornBits * sornBits> mulTable = sornOperatorTable(sornDT, SornOperator::MUL);
+	static constexpr std::array<sornRange, sornBits * sornBits> divTable = sornOperatorTable(sornDT, SornOperator::DIV);
+	static constexpr std::array<sornRange, sornBits> negTable = sornUnaryTable(sornDT, false);
+	static constexpr std::array<sornRange, sornBits> absTable = sornUnaryTable(sornDT, true);
+
+public:
+
+	// constructors: the default value is the empty set
+	sorn() = default;
 
 	// specific value constructor
-	constexpr sorn(const SpecificValue code) noexcept {
+	sorn(const SpecificValue code) noexcept {
+		constexpr size_t zeroIndex = (flagNeg ? sornBits / 2 : 0);
 		switch (code) {
 		case SpecificValue::maxpos:
-			//maxpos();
+		case SpecificValue::infpos:
+			_bits.set(sornBits - 1);
 			break;
 		case SpecificValue::minpos:
-			//minpos();
+			_bits.set(flagZero ? zeroIndex + 1 : zeroIndex);
 			break;
 		case SpecificValue::zero:
 		default:
-			//zero();
+			setzero();
 			break;
 		case SpecificValue::minneg:
-			//minneg();
+			_bits.set(flagNeg ? zeroIndex - 1 : 0);
 			break;
 		case SpecificValue::maxneg:
-			//maxneg();
-			break;
-		case SpecificValue::infpos:
-			//setinf(false);
-			break;
 		case SpecificValue::infneg:
-			//setinf(true);
+			_bits.set(0);
 			break;
 		case SpecificValue::nar: // approximation as IEEE-754 SORNs don't have a NaR
 		case SpecificValue::qnan:
-			//setnan(NAN_TYPE_QUIET);
-			break;
 		case SpecificValue::snan:
-			//setnan(NAN_TYPE_SIGNALLING);
+			_bits.reset();
 			break;
 		}
 	}
@@ -249,211 +379,59 @@ public:
 	sorn(long double initial_value)			{ *this = initial_value; }
 
 	// assignment operators for native types
-	sorn operator=(signed char rhs)			{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(short rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(int rhs)					{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(long rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(long long rhs)			{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(char rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(unsigned short rhs)		{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(unsigned int rhs)		{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(unsigned long rhs)		{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(unsigned long long rhs)	{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(float rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(double rhs)				{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
-	sorn operator=(long double rhs)			{ float2SORN( (float)rhs, sornDT, this->sornIntVal); return *this; }
+	sorn& operator=(signed char rhs)		{ return assign((double)rhs); }
+	sorn& operator=(short rhs)				{ return assign((double)rhs); }
+	sorn& operator=(int rhs)				{ return assign((double)rhs); }
+	sorn& operator=(long rhs)				{ return assign((double)rhs); }
+	sorn& operator=(long long rhs)			{ return assign((double)rhs); }
+	sorn& operator=(char rhs)				{ return assign((double)rhs); }
+	sorn& operator=(unsigned short rhs)		{ return assign((double)rhs); }
+	sorn& operator=(unsigned int rhs)		{ return assign((double)rhs); }
+	sorn& operator=(unsigned long rhs)		{ return assign((double)rhs); }
+	sorn& operator=(unsigned long long rhs)	{ return assign((double)rhs); }
+	sorn& operator=(float rhs)				{ return assign((double)rhs); }
+	sorn& operator=(double rhs)				{ return assign(rhs); }
+	sorn& operator=(long double rhs)		{ return assign((double)rhs); }
 
 	///////////////////////////////
 	////////// operators //////////
 	///////////////////////////////
 
-	// write to output
-	friend std::ostream& operator<< (std::ostream& ostr, sorn& s) {
-		return ostr << s.sornIntVal.getInt();
-	}
-
-	// arithmetics	(TODO: div, comparison?)
+	// arithmetic operators; sets are unordered, they only compare for equality (operator== below the class)
 
 	// negation operator
-	sorn operator-() {
-		if (iszero()) {
-			return *this;
-		}
-		else {
-			sorn negated;
-			negated.sornIntVal.lowerBound = (this->sornIntVal.upperBound == 0 ? this->sornIntVal.upperBound : -this->sornIntVal.upperBound);
-			negated.sornIntVal.upperBound = (this->sornIntVal.lowerBound == 0 ? this->sornIntVal.lowerBound : -this->sornIntVal.lowerBound);
-			negated.sornIntVal.lowerIsOpen = this->sornIntVal.upperIsOpen;
-			negated.sornIntVal.upperIsOpen = this->sornIntVal.lowerIsOpen;
-			return negated;
-		}
-	}
-
-	// single operand addition 
-	
-	// sorn + sorn
-	sorn& operator+=(sorn& rhs) {
-		if (rhs.iszero()) {
-			return *this;
-		}
-		else if (this->iszero()) {
-			*this = rhs;
-			return *this;
-		}
-		else {
-			this->sornIntVal.lowerBound += rhs.sornIntVal.lowerBound;
-			this->sornIntVal.upperBound += rhs.sornIntVal.upperBound;
-			this->sornIntVal.lowerIsOpen = (this->sornIntVal.lowerIsOpen || rhs.sornIntVal.lowerIsOpen);
-			this->sornIntVal.upperIsOpen = (this->sornIntVal.upperIsOpen || rhs.sornIntVal.upperIsOpen);
-			adaptToDT();
-			return *this;
-		}
+	sorn operator-() const {
+		sorn negated;
+		forEachBit(_bits, [&](size_t i) { negated.include(negTable[i]); });
+		return negated;
 	}
-	// sorn + int
-	sorn& operator+=(int rhs) {
-		this->sornIntVal.lowerBound += rhs;
-		this->sornIntVal.upperBound += rhs;
-		adaptToDT();
-		return *this;
-	}
-	// sorn + float
-	sorn& operator+=(float rhs) {
-		this->sornIntVal.lowerBound += rhs;
-		this->sornIntVal.upperBound += rhs;
-		adaptToDT();
-		return *this;
-	}
-	// sorn + double
-	sorn& operator+=(double rhs) {
-		this->sornIntVal.lowerBound += (float)rhs;
-		this->sornIntVal.upperBound += (float)rhs;
-		adaptToDT();
-		return *this;
-	}
-
-	// single operand subtraction
 
-	// sorn - sorn
-	sorn& operator-=(sorn& rhs) {
-		if (rhs.iszero()) {
-			return *this;
-		}
-		else if (this->iszero()) {
-			*this = -rhs;
-			return *this;
-		}
-		else {
-			this->sornIntVal.lowerBound -= rhs.sornIntVal.upperBound;
-			this->sornIntVal.upperBound -= rhs.sornIntVal.lowerBound;
-			this->sornIntVal.lowerIsOpen = (this->sornIntVal.lowerIsOpen || rhs.sornIntVal.upperIsOpen);
-			this->sornIntVal.upperIsOpen = (this->sornIntVal.upperIsOpen || rhs.sornIntVal.lowerIsOpen);
-			adaptToDT();
-			return *this;
-		}
-	}
-	// sorn - int
-	sorn& operator-=(int rhs) {
-		this->sornIntVal.lowerBound -= rhs;
-		this->sornIntVal.upperBound -= rhs;
-		adaptToDT();
-		return *this;
-	}
-	// sorn - float
-	sorn& operator-=(float rhs) {
-		this->sornIntVal.lowerBound -= rhs;
-		this->sornIntVal.upperBound -= rhs;
-		adaptToDT();
-		return *this;
-	}
-	// sorn - double
-	sorn& operator-=(double rhs) {
-		this->sornIntVal.lowerBound -= (float)rhs;
-		this->sornIntVal.upperBound -= (float)rhs;
-		adaptToDT();
-		return *this;
-	}
-
-	// single operand multiplication
-
-	// sorn * sorn
-	sorn& operator*=(sorn& rhs) {
-		// 1. create references and intermediate values for the bounds
-		float &lhsLOW	= this->sornIntVal.lowerBound;
-		float &lhsUP	= this->sornIntVal.upperBound;
-		float &rhsLOW	= rhs.sornIntVal.lowerBound;
-		float &rhsUP	= rhs.sornIntVal.upperBound;
-		float resLOW;
-		float resUP;
-		// 2. create references and intermediate values for the conditions
-		bool &lhsLOWc	= this->sornIntVal.lowerIsOpen;
-		bool &lhsUPc	= this->sornIntVal.upperIsOpen;
-		bool &rhsLOWc	= rhs.sornIntVal.lowerIsOpen;
-		bool &rhsUPc	= rhs.sornIntVal.upperIsOpen;
-		bool resLOWc;
-		bool resUPc;
-		// 3. check zero case
-		if (rhs.iszero() || this->iszero()) {
-			setzero();
-			return *this;
-		}
-		else { // 4. follow interval arithmetic rules for multiplication
-			if (lhsLOW >= 0) { //					  lower bound					upper bound					lower condition					upper condition
-				if		(rhsLOW >= 0)				{ resLOW = lhsLOW * rhsLOW;		resUP = lhsUP  * rhsUP;		resLOWc = lhsLOWc || rhsLOWc;	resUPc = lhsUPc  || rhsUPc; }
-				else if (rhsLOW < 0 && rhsUP >= 0)	{ resLOW = lhsUP  * rhsLOW;		resUP = lhsUP  * rhsUP;		resLOWc = lhsUPc  || rhsLOWc;	resUPc = lhsUPc  || rhsUPc; }
-				else if (rhsUP < 0)					{ resLOW = lhsUP  * rhsLOW;		resUP = lhsLOW * rhsUP;		resLOWc = lhsUPc  || rhsLOWc;	resUPc = lhsLOWc || rhsUPc; }
-				else                                { resLOW = 0              ;		resUP = 0             ;		resLOWc = 0                 ;	resUPc = 0                ; } // ETLO added
-			}
-			else if (lhsLOW < 0 && lhsUP >= 0) {
-				if		(rhsLOW >= 0)				{ resLOW = lhsLOW * rhsUP;		resUP = lhsUP  * rhsUP;		resLOWc = lhsLOWc || rhsUPc;	resUPc = lhsUPc  || rhsUPc; }
-				else if (rhsLOW < 0 && rhsUP >= 0)	{ resLOW = fmin(lhsLOW * rhsUP  , lhsUP * rhsLOW);			resLOWc = (lhsLOW * rhsUP  < lhsUP*rhsLOW ? lhsLOWc || rhsUPc  : lhsUPc || rhsLOWc);	// lower bound & condition
-													  resUP  = fmax(lhsLOW * rhsLOW , lhsUP * rhsUP );			resUPc  = (lhsLOW * rhsLOW > lhsUP*rhsUP  ? lhsLOWc || rhsLOWc : lhsUPc || rhsUPc ); }	// upper bound & condition
-				else if (rhsUP < 0)					{ resLOW = lhsUP  * rhsLOW;		resUP = lhsLOW * rhsLOW;	resLOWc = lhsUPc  || rhsLOWc;	resUPc = lhsLOWc || rhsLOWc;}
-				else                                { resLOW = 0              ;		resUP = 0             ;		resLOWc = 0                 ;	resUPc = 0                ; } // ETLO added 
-			}
-			else if (lhsUP < 0) {
-				if		(rhsLOW >= 0)				{ resLOW = lhsLOW * rhsUP;		resUP = lhsUP  * rhsLOW;	resLOWc = lhsLOWc || rhsUPc;	resUPc = lhsUPc  || rhsLOWc;}
-				else if (rhsLOW < 0 && rhsUP >= 0)	{ resLOW = lhsLOW * rhsUP;		resUP = lhsLOW * rhsLOW;	resLOWc = lhsLOWc || rhsUPc;	resUPc = lhsLOWc || rhsLOWc;}
-				else if (rhsUP < 0)					{ resLOW = lhsUP  * rhsUP;		resUP = lhsLOW * rhsLOW;	resLOWc = lhsUPc  || rhsUPc;	resUPc = lhsLOWc || rhsLOWc;}
-				else                                { resLOW = 0              ;		resUP = 0             ;		resLOWc = 0                 ;	resUPc = 0                ; } // ETLO added
-			}
-			else {
-				{ resLOW = 0              ;		resUP = 0             ;		resLOWc = 0                 ;	resUPc = 0                ; } // ETLO added
-			}
-			// 5. set results
-			if (resLOW == -0) { resLOW = 0; } // remove -0
-			if (resUP  == -0) { resUP  = 0; } // remove -0
-			this->sornIntVal.lowerBound	 = resLOW;
-			this->sornIntVal.upperBound	 = resUP;
-			this->sornIntVal.lowerIsOpen = resLOWc;
-			this->sornIntVal.upperIsOpen = resUPc;
-			// 6. return
-			adaptToDT();
-			return *this;
-		}
-	}
-	// sorn * int
-	sorn& operator*=(int rhs) {
-		this->sornIntVal.lowerBound *= rhs;
-		this->sornIntVal.upperBound *= rhs;
-		if (rhs < 0) { switchBounds(); }
-		adaptToDT();
-		return *this;
-	}
-	// sorn * float
-	sorn& operator*=(float rhs) {
-		this->sornIntVal.lowerBound *= rhs;
-		this->sornIntVal.upperBound *= rhs;
-		if (rhs < 0) { switchBounds(); }
-		adaptToDT();
-		return *this;
-	}
-	// sorn * double
-	sorn& operator*=(double rhs) {
-		this->sornIntVal.lowerBound *= (float)rhs;
-		this->sornIntVal.upperBound *= (float)rhs;
-		if (rhs < 0) { switchBounds(); }
-		adaptToDT();
-		return *this;
+	// single operand arithmetic: the union of the table entries of all pairs of set bits
+	sorn& operator+=(const sorn& rhs) { return *this = apply(addTable, *this, rhs); }
+	sorn& operator-=(const sorn& rhs) { return *this = apply(subTable, *this, rhs); }
+	sorn& operator*=(const sorn& rhs) { return *this = apply(mulTable, *this, rhs); }
+	sorn& operator/=(const sorn& rhs) { return *this = apply(divTable, *this, rhs); }
+
+	// single operand arithmetic with exact scalars
+	sorn& operator+=(int rhs)    { return applyScalar(SornOperator::ADD, (double)rhs); }
+	sorn& operator+=(float rhs)  { return applyScalar(SornOperator::ADD, (double)rhs); }
+	sorn& operator+=(double rhs) { return applyScalar(SornOperator::ADD, rhs); }
+	sorn& operator-=(int rhs)    { return applyScalar(SornOperator::SUB, (double)rhs); }
+	sorn& operator-=(float rhs)  { return applyScalar(SornOperator::SUB, (double)rhs); }
+	sorn& operator-=(double rhs) { return applyScalar(SornOperator::SUB, rhs); }
+	sorn& operator*=(int rhs)    { return applyScalar(SornOperator::MUL, (double)rhs); }
+	sorn& operator*=(float rhs)  { return applyScalar(SornOperator::MUL, (double)rhs); }
+	sorn& operator*=(double rhs) { return applyScalar(SornOperator::MUL, rhs); }
+	sorn& operator/=(int rhs)    { return applyScalar(SornOperator::DIV, (double)rhs); }
+	sorn& operator/=(float rhs)  { return applyScalar(SornOperator::DIV, (double)rhs); }
+	sorn& operator/=(double rhs) { return applyScalar(SornOperator::DIV, rhs); }
+
+	// scalar op sorn, for the operators that do not commute
+	static sorn scalarOp(SornOperator op, double lhs, const sorn& rhs) {
+		sorn result;
+		sornBounds scalar{ lhs, lhs, false, false };
+		forEachBit(rhs._bits, [&](size_t j) { result.include(sornCombine(sornDT, op, scalar, sornToBounds(sornDT[j]))); });
+		return result;
 	}
 
 	//////////////////////////////////////////
@@ -461,33 +439,21 @@ public:
 	//////////////////////////////////////////
 
 	// absolute value
-	sorn abs() {
+	sorn abs() const {
 		sorn absVal;
-		if (this->sornIntVal.upperBound <= 0) {
-			absVal = -*this;
-		}
-		else if (this->sornIntVal.lowerBound < 0) {
-			absVal.sornIntVal.lowerBound = 0;
-			absVal.sornIntVal.lowerIsOpen = false;
-			if (std::abs(this->sornIntVal.lowerBound) > std::abs(this->sornIntVal.upperBound)) {
-				absVal.sornIntVal.upperBound = std::abs(this->sornIntVal.lowerBound);
-				absVal.sornIntVal.upperIsOpen = this->sornIntVal.lowerIsOpen;
-			}
-			else {
-				absVal.sornIntVal.upperBound = this->sornIntVal.upperBound;
-				absVal.sornIntVal.upperIsOpen = this->sornIntVal.upperIsOpen;
-			}
-		}
-		else {
-			absVal = *this;
-		};
-		absVal.adaptToDT();
+		forEachBit(_bits, [&](size_t i) { absVal.include(absTable[i]); });
 		return absVal;
 	}
 
-	template<typename Real>
-	Real to_native() const noexcept {
-		return Real(0.0f);
+	// to_native: the midpoint of the hull of the set, NaN for the empty set
+	// a hull that is unbounded on one side yields that infinity, the full real line yields 0
+	template<typename Native>
+	Native to_native() const noexcept {
+		SORN_INTERVAL hull = interval();
+		if (std::isnan(hull.lowerBound)) return std::numeric_limits<Native>::quiet_NaN();
+		double lo = double(hull.lowerBound), hi = double(hull.upperBound);
+		if (std::isinf(lo) && std::isinf(hi)) return Native(0);
+		return Native(0.5 * (lo + hi));
 	}
 	// make conversions to native types explicit
 	//explicit operator int()       const noexcept { return to_int(); }
@@ -501,129 +467,40 @@ public:
 	///////////////////////////////////////
 
 	// special value functions
-	bool iszero() const noexcept { return this->sornIntVal.isZero(); }
-	bool isnan() const noexcept { return false; }
-
-	sorn& setzero() { this->sornIntVal = { 0,0,0,0 }; return *this; }
-
-	Real minVal() const noexcept { return sornDT[0].lowerBound; }
-	Real maxVal() const noexcept { return sornDT[sornDT.size() - 1].upperBound; }
-
-	// adaptToDT: adapt the variable sornIntVal to the defined datatype
-	SORN_INTERVAL& adaptToDT() {
-		// 1. lower bound
-		bool lowerExists = false;
-		// 1.1. check if lower bound already exisits in DT
-		for (int b = 0; b < sornDT.size(); b++) {
-			if (this->sornIntVal.lowerBound == sornDT[b].lowerBound && this->sornIntVal.lowerIsOpen == sornDT[b].lowerIsOpen) {
-				lowerExists = true;
-			}
-		}
-		// 1.2. adapt lower bound to DT
-		if (not lowerExists) {
-			// 1.2.1. lower bound < min value
-			if (this->sornIntVal.lowerBound < minVal()) {
-				this->sornIntVal.lowerBound = minVal();
-				this->sornIntVal.lowerIsOpen = this->sornDT[0].lowerIsOpen;
-			}
-			else {
-				for (int b = 0; b < sornDT.size(); b++) {
-					// 1.2.2. lower bound value between two possible values (from DT)
-					if (this->sornIntVal.lowerBound > sornDT[b].lowerBound && this->sornIntVal.lowerBound < sornDT[b].upperBound) {
-						this->sornIntVal.lowerBound = sornDT[b].lowerBound;
-						this->sornIntVal.lowerIsOpen = sornDT[b].lowerIsOpen;
-					} // 1.2.3. lower bound in DT but open/close condition does not match
-					else if (this->sornIntVal.lowerBound == sornDT[b].lowerBound && this->sornIntVal.lowerIsOpen != sornDT[b].lowerIsOpen) {
-						// cond. is "open" but has to be "closed"
-						if (this->sornIntVal.lowerIsOpen) {
-							this->sornIntVal.lowerBound = sornDT[b].lowerBound;
-							this->sornIntVal.lowerIsOpen = sornDT[b].lowerIsOpen;
-						}
-						// cond. is "closed" but has to be "open" --> utilize prevoius interval
-						else if (not this->sornIntVal.lowerIsOpen) {
-							this->sornIntVal.lowerBound = sornDT[b - 1].lowerBound;
-							this->sornIntVal.lowerIsOpen = sornDT[b - 1].lowerIsOpen;
-						}
-					}
-				}
-			}
-		}
-		// 2. upper bound
-		bool upperExists = false;
-		// 2.1.check if upper bound already exisits in DT
-		for (int b = 0; b < sornDT.size(); b++) {
-			if (this->sornIntVal.upperBound == sornDT[b].upperBound && this->sornIntVal.upperIsOpen == sornDT[b].upperIsOpen) {
-				upperExists = true;
-			}
-		}
-		// 2.2. adapt upper bound to DT
-		if (not upperExists) {
-			// 2.2.1 upper bound > max value
-			if (this->sornIntVal.upperBound > maxVal()) {
-				this->sornIntVal.upperBound = maxVal();
-				this->sornIntVal.upperIsOpen = this->sornDT[sornDT.size() - 1].upperIsOpen;
-			}
-			else {
-				for (int b = 0; b < sornDT.size(); b++) {
-					// 2.2.2. upper bound value between two possible values (from DT)
-					if (this->sornIntVal.upperBound > sornDT[b].lowerBound && this->sornIntVal.upperBound < sornDT[b].upperBound) {
-						this->sornIntVal.upperBound = sornDT[b].upperBound;
-						this->sornIntVal.upperIsOpen = sornDT[b].upperIsOpen;
-						break; // when the upper bound it set to open zero the next iteration would set it to closed zero
-					} // 2.2.3. upper bound in DT but open/close condition does not match
-					else if (this->sornIntVal.upperBound == sornDT[b].upperBound && this->sornIntVal.upperIsOpen != sornDT[b].upperIsOpen) {
-						// cond. is "open" but has to be "closed"
-						if (this->sornIntVal.upperIsOpen) {
-							this->sornIntVal.upperBound = sornDT[b].upperBound;
-							this->sornIntVal.upperIsOpen = sornDT[b].upperIsOpen;
-						} // cond. is "closed" but has to be "open" --> utilize next interval
-						else if (not this->sornIntVal.upperIsOpen) {
-							this->sornIntVal.upperBound = sornDT[b+1].upperBound;
-							this->sornIntVal.upperIsOpen = sornDT[b+1].upperIsOpen;
-						}
-						break;
-					}
-				}
-			}
-		}
-		// 3. return value
-		return this->sornIntVal;
-	}
+	bool iszero() const noexcept { return _bits.count() == 1 && sornDT[lowestBit()].isZero(); }
+	bool isnan() const noexcept { return _bits.none(); }
 
-	// switchBounds: switch Boundaries of sornIntVal
-	SORN_INTERVAL& switchBounds() {
-		float newLow  = this->sornIntVal.upperBound;
-		float newUp   = this->sornIntVal.lowerBound;
-		bool  newLowC = this->sornIntVal.upperIsOpen;
-		bool  newUpC  = this->sornIntVal.lowerIsOpen;
-		this->sornIntVal = { newLow,newUp,newLowC,newUpC };
-		return this->sornIntVal;
+	sorn& setzero() {
+		_bits.reset();
+		if constexpr (flagZero) _bits.set(flagNeg ? sornBits / 2 : 0); else include(sornCover(sornDT, sornBounds{ 0.0, 0.0, false, false }));
+		return *this;
 	}
 
-	void setbits(std::uint64_t v) noexcept {}
+	static constexpr Real minVal() noexcept { return sornDT[0].lowerBound; }
+	static constexpr Real maxVal() noexcept { return sornDT[sornBits - 1].upperBound; }
 
-	// setBits: set the sornIntVal parameter via binary input (input type: bitset)
-	SORN_INTERVAL& setBits(std::bitset<sornBits> bin) {
-		bool lowerSet = false;
-		for (int b = 0; b < sornBits; b++) {
-			if (bin[b] == 1 && not lowerSet) {
-				this->sornIntVal = this->sornDT[b];
-				lowerSet = true;
-			}
-			else if (bin[b] == 1 && lowerSet) {
-				this->sornIntVal.upperBound = this->sornDT[b].upperBound;
-				this->sornIntVal.upperIsOpen = this->sornDT[b].upperIsOpen;
-			}
-		}
-		return this->sornIntVal;
+	// interval: the smallest interval that contains the value, the NaN interval for the empty set
+	SORN_INTERVAL interval() const noexcept {
+		if (isnan()) return { std::numeric_limits<Real>::quiet_NaN(), std::numeric_limits<Real>::quiet_NaN(), false, false };
+		const SORN_INTERVAL& lower = sornDT[lowestBit()];
+		const SORN_INTERVAL& upper = sornDT[highestBit()];
+		return { lower.lowerBound, upper.upperBound, lower.lowerIsOpen, upper.upperIsOpen };
+	}
+
+	void setbits(std::uint64_t v) noexcept {
+		_bits.reset();
+		for (size_t b = 0; b < sornBits && b < 64; ++b) _bits[b] = (v >> b) & 0x1;
 	}
 
+	// setBits: set the value via binary input (input type: bitset)
+	sorn& setBits(const std::bitset<sornBits>& bin) noexcept { _bits = bin; return *this; }
+
 	//////////////////////////////////////
 	////////// getter functions //////////
 	//////////////////////////////////////
 
 	// getConfig: writes all configuration parameters and flags to a string
-	std::string getConfig() {
+	std::string getConfig() const {
 		std::stringstream configStream;
 		configStream << "-- configuration parameters:" << '\t' << "start: " << start << ", stop: " << stop << ", steps: " << steps << ", stepSize: " << stepSize << '\n';
 		configStream << "-- configuration flags:" << "\t\t";
@@ -637,10 +514,10 @@ public:
 	}
 
 	// getDT: writes the SORN datatype configuration to a string
-	std::string getDT() {
+	std::string getDT() const {
 		std::stringstream DTstream;
 		DTstream << "-- SORN datatype:" << "\t\t";
-		for (int b = 0; b < sornDT.size(); b++) {
+		for (size_t b = 0; b < sornDT.size(); b++) {
 			DTstream << sornDT[b].getInt() << ' ';
 		}
 		DTstream << '\n';
@@ -648,39 +525,110 @@ public:
 	}
 
 	// getBits: returns the binary representation of a SORN value using bitset class (note: displayed from max downto 0 when using << operator)
-	std::bitset<sornBits> getBits() {
-		std::bitset<sornBits> raw_bits;
-		for (int b = 0; b < sornBits; b++) {
-			if ((sornIntVal.lowerBound == sornDT[b].lowerBound && sornIntVal.lowerIsOpen == sornDT[b].lowerIsOpen) ||
-				(sornIntVal.upperBound == sornDT[b].upperBound && sornIntVal.upperIsOpen == sornDT[b].upperIsOpen)) {
-				raw_bits[b] = 0b1;
-			}
-			else {
-				raw_bits[b] = 0b0;
-			}
+	const std::bitset<sornBits>& getBits() const noexcept { return _bits; }
+
+	// getInt: the value as the union of its contiguous runs of lattice intervals
+	std::string getInt() const {
+		if (isnan()) return std::string("{}");
+		std::stringstream s;
+		size_t b = 0;
+		bool first = true;
+		while (b < sornBits) {
+			if (!_bits[b]) { ++b; continue; }
+			size_t e = b;
+			while (e + 1 < sornBits && _bits[e + 1]) ++e;
+			SORN_INTERVAL run{ sornDT[b].lowerBound, sornDT[e].upperBound, sornDT[b].lowerIsOpen, sornDT[e].upperIsOpen };
+			s << (first ? "" : " U ") << run.getInt();
+			first = false;
+			b = e + 1;
 		}
-		return raw_bits;
+		return s.str();
 	}
 
 private:
-	template<signed int _sstart, signed int _sstop, unsigned int _ssteps, bool _llin, bool _hhalfopen, bool _nneg, bool _iinf, bool _zzero>
-	friend bool operator!=(const sorn< _sstart, _sstop, _ssteps, _llin, _hhalfopen, _nneg, _iinf, _zzero>& lhs, const sorn< _sstart, _sstop, _ssteps, _llin, _hhalfopen, _nneg, _iinf, _zzero>&);
+	std::bitset<sornBits> _bits;
+
+	sorn& assign(double v) {
+		_bits.reset();
+		if (v == v) include(sornCover(sornDT, sornBounds{ v, v, false, false }));  // NaN converts to the empty set
+		return *this;
+	}
+
+	// include: add the lattice intervals of a table entry to the value
+	void include(const sornRange& r) noexcept {
+		if (r.pole) {
+			_bits.set(sornBits - 1);
+			if constexpr (flagNeg) _bits.set(0);
+		}
+		if (r.empty()) return;
+		if constexpr (sornBits <= 64) {
+			std::uint64_t mask = (~std::uint64_t(0) >> (63 - r.last)) & (~std::uint64_t(0) << r.first);
+			_bits |= std::bitset<sornBits>(mask);
+		}
+		else {
+			for (size_t b = r.first; b <= r.last; ++b) _bits.set(b);
+		}
+	}
+
+	template<typename Function>
+	static void forEachBit(const std::bitset<sornBits>& bits, Function&& f) {
+		if constexpr (sornBits <= 64) {
+			std::uint64_t word = bits.to_ullong();
+			while (word) {
+				f(size_t(std::countr_zero(word)));
+				word &= word - 1;
+			}
+		}
+		else {
+			for (size_t b = 0; b < sornBits; ++b) if (bits[b]) f(b);
+		}
+	}
+
+	size_t lowestBit() const noexcept {
+		for (size_t b = 0; b < sornBits; ++b) if (_bits[b]) return b;
+		return sornBits;
+	}
+	size_t highestBit() const noexcept {
+		for (size_t b = sornBits; b > 0; --b) if (_bits[b - 1]) return b - 1;
+		return sornBits;
+	}
+
+	static sorn apply(const std::array<sornRange, sornBits * sornBits>& table, const sorn& lhs, const sorn& rhs) {
+		sorn result;
+		forEachBit(lhs._bits, [&](size_t i) {
+			const sornRange* row = &table[i * sornBits];
+			forEachBit(rhs._bits, [&](size_t j) { result.include(row[j]); });
+		});
+		return result;
+	}
+
+	sorn& applyScalar(SornOperator op, double rhs) {
+		sorn result;
+		sornBounds scalar{ rhs, rhs, false, false };
+		forEachBit(_bits, [&](size_t i) { result.include(sornCombine(sornDT, op, sornToBounds(sornDT[i]), scalar)); });
+		return *this = result;
+	}
 
 	template<signed int _sstart, signed int _sstop, unsigned int _ssteps, bool _llin, bool _hhalfopen, bool _nneg, bool _iinf, bool _zzero>
-	friend std::ostream& operator<<(std::ostream&, const sorn< _sstart, _sstop, _ssteps, _llin, _hhalfopen, _nneg, _iinf, _zzero>&);
+	friend bool operator==(const sorn< _sstart, _sstop, _ssteps, _llin, _hhalfopen, _nneg, _iinf, _zzero>& lhs, const sorn< _sstart, _sstop, _ssteps, _llin, _hhalfopen, _nneg, _iinf, _zzero>&);
 
 }; // end class sorn
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
-inline bool operator!=(const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) { 
-	return false; 
+inline bool operator==(const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return lhs._bits == rhs._bits;
+}
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+inline bool operator!=(const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return !(lhs == rhs);
 }
 
+// write to output
 template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
-inline std::ostream& operator<<(std::ostream& ostr, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs) { 
-	return ostr << "[ " << lhs.minVal() << ", " << lhs.maxVal() << "]";
+inline std::ostream& operator<<(std::ostream& ostr, const sorn< _start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& s) {
+	return ostr << s.getInt();
 }
 
 
@@ -689,45 +637,45 @@ inline std::ostream& operator<<(std::ostream& ostr, const sorn< _start, _stop, _
 //////////////////////////////////////////
 
 // sorn + sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
-																		   sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
+																		   const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = lhs;
 	return sum += rhs;
 }
 // sorn + int
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = lhs;
 	return sum += rhs;
 }
 // sorn + float
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = lhs;
 	return sum += rhs;
 }
 // sorn + double
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = lhs;
 	return sum += rhs;
 }
 // int + sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (int lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (int lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = rhs;
 	return sum += lhs;
 }
 // float + sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (float lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (float lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = rhs;
 	return sum += lhs;
 }
 // double + sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (double lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (double lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> sum = rhs;
 	return sum += lhs;
 }
@@ -737,47 +685,44 @@ sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator+ (doubl
 /////////////////////////////////////////////
 
 // sorn - sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
+	const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = lhs;
 	return dif -= rhs;
 }
 // sorn - int
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = lhs;
 	return dif -= rhs;
 }
 // sorn - float
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = lhs;
 	return dif -= rhs;
 }
 // sorn - double
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = lhs;
 	return dif -= rhs;
 }
 // int - sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (int lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = -rhs;
-	return dif += lhs;
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (int lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>::scalarOp(SornOperator::SUB, (double)lhs, rhs);
 }
 // float - sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (float lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = -rhs;
-	return dif += lhs;
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (float lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>::scalarOp(SornOperator::SUB, (double)lhs, rhs);
 }
 // double - sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (double lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> dif = -rhs;
-	return dif += lhs;
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (double lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>::scalarOp(SornOperator::SUB, lhs, rhs);
 }
 
 ////////////////////////////////////////////////
@@ -785,76 +730,121 @@ sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator- (doubl
 ////////////////////////////////////////////////
 
 // sorn * sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
+	const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = lhs;
 	return prod *= rhs;
 }
 // sorn * int
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = lhs;
 	return prod *= rhs;
 }
 // sorn * float
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = lhs;
 	return prod *= rhs;
 }
 // sorn * double
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = lhs;
 	return prod *= rhs;
 }
 // int * sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (int lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (int lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = rhs;
 	return prod *= lhs;
 }
 // float * sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (float lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (float lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = rhs;
 	return prod *= lhs;
 }
 // double * sorn
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (double lhs, sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator* (double lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
 	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> prod = rhs;
 	return prod *= lhs;
 }
 
+//////////////////////////////////////////
+////////// two operand division //////////
+//////////////////////////////////////////
+
+// sorn / sorn
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
+	const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> ratio = lhs;
+	return ratio /= rhs;
+}
+// sorn / int
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, int rhs) {
+	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> ratio = lhs;
+	return ratio /= rhs;
+}
+// sorn / float
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, float rhs) {
+	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> ratio = lhs;
+	return ratio /= rhs;
+}
+// sorn / double
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs, double rhs) {
+	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> ratio = lhs;
+	return ratio /= rhs;
+}
+// int / sorn
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (int lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>::scalarOp(SornOperator::DIV, (double)lhs, rhs);
+}
+// float / sorn
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (float lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>::scalarOp(SornOperator::DIV, (double)lhs, rhs);
+}
+// double / sorn
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> operator/ (double lhs, const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	return sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>::scalarOp(SornOperator::DIV, lhs, rhs);
+}
+
 ///////////////////////////////////////////
 ////////// arithmetic operations //////////
 ///////////////////////////////////////////
 
 // absolute value
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
 sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> abs(sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> op) {
 	return op.abs();
 }
 
 // hypot(sorn,sorn)
-template<signed int _start, signed int _stop, unsigned int _steps, bool _lin = 1, bool _halfopen = 1, bool _neg = 1, bool _inf = 1, bool _zero = 1>
-sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> hypot(sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> lhs,
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> rhs) {
+template<signed int _start, signed int _stop, unsigned int _steps, bool _lin, bool _halfopen, bool _neg, bool _inf, bool _zero>
+sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> hypot(const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& lhs,
+	const sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>& rhs) {
+	using Sorn = sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero>;
 	using std::sqrt;
-	sorn<_start, _stop, _steps, _lin, _halfopen, _neg, _inf, _zero> res, lhsAbs, rhsAbs;
-	// take abs value of inputs
-	lhsAbs = lhs.abs();
-	rhsAbs = rhs.abs();
+	Sorn res;
+	if (lhs.isnan() || rhs.isnan()) return res;
 	// carry out hypot on the abs values of the inputs
-	res.sornIntVal.lowerBound = sqrt(lhsAbs.sornIntVal.lowerBound * lhsAbs.sornIntVal.lowerBound + rhsAbs.sornIntVal.lowerBound * rhsAbs.sornIntVal.lowerBound);
-	res.sornIntVal.upperBound = sqrt(lhsAbs.sornIntVal.upperBound * lhsAbs.sornIntVal.upperBound + rhsAbs.sornIntVal.upperBound * rhsAbs.sornIntVal.upperBound);
-	res.sornIntVal.lowerIsOpen = lhsAbs.sornIntVal.lowerIsOpen || rhsAbs.sornIntVal.lowerIsOpen;
-	res.sornIntVal.upperIsOpen = lhsAbs.sornIntVal.upperIsOpen || rhsAbs.sornIntVal.upperIsOpen;
-	res.adaptToDT();
-	return res;
+	auto lhsAbs = lhs.abs().interval();
+	auto rhsAbs = rhs.abs().interval();
+	double lo = sqrt(double(lhsAbs.lowerBound) * lhsAbs.lowerBound + double(rhsAbs.lowerBound) * rhsAbs.lowerBound);
+	double hi = sqrt(double(lhsAbs.upperBound) * lhsAbs.upperBound + double(rhsAbs.upperBound) * rhsAbs.upperBound);
+	std::bitset<Sorn::sornBits> bits;
+	sornRange r = sornCover(Sorn::sornDT, sornBounds{ lo, hi, lhsAbs.lowerIsOpen || rhsAbs.lowerIsOpen, lhsAbs.upperIsOpen || rhsAbs.upperIsOpen });
+	for (size_t b = r.first; b <= r.last; ++b) bits.set(b);
+	return res.setBits(bits);
 }
 
 }} // end namespace sw::universal
-
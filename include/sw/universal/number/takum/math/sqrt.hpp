@@ -0,0 +1,61 @@
+#pragma once
+// sqrt.hpp: sqrt function for takums
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
+#include <cstdint>
+
+namespace sw { namespace universal {
+
+	/// <summary>
+	/// correctly rounded square root of a takum
+	/// The significand 1.f * 2^scale is scaled to an integer X with an even exponent, and the
+	/// integer square root of X is computed digit by digit, two bits of X at a time, with
+	/// enough bits for the mantissa and a guard bit. The remainder provides the sticky bit.
+	/// </summary>
+	/// <param name="a">the argument</param>
+	/// <returns>sqrt(a), NaR for NaR and negative arguments</returns>
+	template<unsigned nbits, typename bt>
+	inline takum<nbits, bt> sqrt(const takum<nbits, bt>& a) {
+		using Takum = takum<nbits, bt>;
+		constexpr int F = static_cast<int>(Takum::fbits);
+		static_assert(F <= 58, "takum sqrt is limited to 63 bits");
+		Takum result;
+		if (a.isnar() || a.isneg()) {
+			result.setnar();
+			return result;
+		}
+		if (a.iszero()) return a;
+
+		takum_decoded d = takum_decode<nbits>(a.bits());
+		uint64_t S = (1ull << F) | (d.fraction >> (64 - F));   // 1.f * 2^F
+		int sBits = F + 1;
+		// X = S * 2^k must have 2F + 4 bits or more, and an even exponent d.scale - F - k
+		int k = 2 * F + 4 - sBits;
+		if ((d.scale - F - k) & 1) ++k;
+		int xBits = sBits + k;
+		int nrPairs = (xBits + 1) / 2;
+		auto xbit = [&](int b) -> uint64_t { return (b >= k ? (S >> (b - k)) & 1ull : 0ull); };
+
+		uint64_t root{ 0 }, remainder{ 0 };
+		for (int i = nrPairs - 1; i >= 0; --i) {
+			remainder = (remainder << 2) | (xbit(2 * i + 1) << 1) | xbit(2 * i);
+			uint64_t trial = (root << 2) | 1ull;
+			if (remainder >= trial) {
+				remainder -= trial;
+				root = (root << 1) | 1ull;
+			}
+			else {
+				root <<= 1;
+			}
+		}
+		int msb = static_cast<int>(std::bit_width(root)) - 1;
+		int scale = (d.scale - F - k) / 2 + msb;
+		result.setbits(takum_round<nbits>(false, scale, root << (63 - msb), remainder != 0));
+		return result;
+	}
+
+}}  // namespace sw::universal
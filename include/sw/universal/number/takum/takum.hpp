@@ -37,6 +37,13 @@
 #define TAKUM_THROW_ARITHMETIC_EXCEPTION 0
 #endif
 
+////////////////////////////////////////////////////////////////////////////////////////
+// enable/disable the decode cache for takums of 16 bits or fewer
+#if !defined(TAKUM_DECODE_CACHE)
+// default is to decode through the cache
+#define TAKUM_DECODE_CACHE 1
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////////////
 // bring in the trait functions
 #include <universal/traits/number_traits.hpp>
@@ -58,5 +65,6 @@
 ///////////////////////////////////////////////////////////////////////////////////////
 /// math functions
 //#include <universal/number/takum/mathlib.hpp>
+#include <universal/number/takum/math/sqrt.hpp>
 
 #endif
@@ -5,30 +5,143 @@
 // SPDX-License-Identifier: MIT
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <bit>
 #include <cassert>
+#include <cmath>
 #include <limits>
+#include <vector>
 
 #include <universal/native/ieee754.hpp>
 #include <universal/internal/blockbinary/blockbinary.hpp>
 #include <universal/internal/abstract/triple.hpp>
+#include <universal/internal/blocktriple/blocktriple.hpp>
 
 namespace sw {	namespace universal {
 		
 // Forward definitions
 template<unsigned nbits, typename bt> class takum;
 
-// convert a floating-point value to a specific takum configuration. Semantically, p = v, return reference to p
-template<unsigned nbits, typename bt>
-inline takum<nbits, bt>& convert(const triple<nbits, bt>& v, takum<nbits, bt>& p) {
-	if (v.iszero()) {
-		p.setzero();
-		return p;
+/*
+ * A takum encodes the value (-1)^S * 1.M * 2^c, with the characteristic c in [-255, 254]
+ *     S D RRR C..C M..M
+ * D is the direction, R the regime, and the r = (D ? R : 7 - R) characteristic bits C follow the regime:
+ *     D = 1 : c = 2^r - 1 + C                   c in [0, 254]
+ *     D = 0 : c = C - 2^(r+1) + 1               c in [-255, -1]
+ * The remaining nbits - 5 - r bits are the mantissa M. Negative values are the two's complement of the
+ * encoding of their magnitude, so the encodings are ordered like the integers, as for posits.
+ * Characteristic bits that do not fit in nbits are 0, and rounding happens on the encoding: a
+ * non-zero value never rounds to 0 or NaR, but saturates to minpos or maxpos.
+ */
+
+// decoded takum: (-1)^sign * 1.fraction * 2^scale, with the fraction left aligned in 64 bits
+struct takum_decoded {
+	bool     sign;
+	int      scale;
+	uint64_t fraction;
+};
+
+// decode a takum encoding that is not 0 or NaR
+template<unsigned nbits>
+constexpr takum_decoded takum_decode(uint64_t raw) noexcept {
+	constexpr uint64_t mask = (nbits < 64 ? (1ull << nbits) : 0ull) - 1ull;
+	bool sign = (raw >> (nbits - 1)) & 1ull;
+	if (sign) raw = (~raw + 1ull) & mask;
+	uint64_t w = raw << (65 - nbits);   // direction bit at bit 63
+	bool direction = (w >> 63);
+	unsigned regime = static_cast<unsigned>((w >> 60) & 0x7ull);
+	unsigned r = (direction ? regime : 7 - regime);
+	uint64_t C = (r > 0 ? ((w << 4) >> (64 - r)) : 0ull);
+	int c = (direction ? static_cast<int>((1ull << r) - 1ull + C) : static_cast<int>(C) - static_cast<int>(2ull << r) + 1);
+	return { sign, c, w << (4 + r) };
+}
+
+/// <summary>
+/// round (-1)^sign * 1.fff * 2^scale to the nearest takum encoding, ties to even
+/// </summary>
+/// <param name="significand">the leading 1 at bit 63, followed by the fraction bits</param>
+/// <param name="sticky">true when there are non-zero bits below the significand</param>
+/// <returns>the takum encoding</returns>
+template<unsigned nbits>
+constexpr uint64_t takum_round(bool sign, int scale, uint64_t significand, bool sticky) noexcept {
+	static_assert(nbits < 64, "takum rounding is limited to encodings of less than 64 bits");
+	constexpr uint64_t mask = (1ull << nbits) - 1ull;
+	constexpr uint64_t maxposBits = (1ull << (nbits - 1)) - 1ull;
+	uint64_t raw{ 0 };
+	if (scale > 254) {
+		raw = maxposBits;
+	}
+	else if (scale < -255) {
+		raw = 1;  // minpos
+	}
+	else {
+		uint64_t direction, regime, C;
+		unsigned r;
+		if (scale >= 0) {
+			direction = 1;
+			r = static_cast<unsigned>(std::bit_width(static_cast<unsigned>(scale + 1)) - 1);
+			regime = r;
+			C = static_cast<uint64_t>(scale + 1) - (1ull << r);
+		}
+		else {
+			direction = 0;
+			r = static_cast<unsigned>(std::bit_width(static_cast<unsigned>(-scale)) - 1);
+			regime = 7 - r;
+			C = static_cast<uint64_t>(scale + static_cast<int>(2u << r) - 1);
+		}
+		uint64_t header = (((direction << 3) | regime) << r) | C;   // 4 + r bits
+		uint64_t fraction = significand << 1;                         // drop the hidden bit
+		int m = static_cast<int>(nbits) - 5 - static_cast<int>(r);    // mantissa bits in the encoding
+		bool guard{ false };
+		if (m >= 0) {
+			raw = (header << m) | (m > 0 ? (fraction >> (64 - m)) : 0ull);
+			guard = (fraction >> (63 - m)) & 1ull;
+			sticky = sticky || ((fraction << (m + 1)) != 0);
+		}
+		else {
+			// the characteristic is wider than the encoding
+			unsigned drop = static_cast<unsigned>(-m);
+			raw = header >> drop;
+			guard = (header >> (drop - 1)) & 1ull;
+			sticky = sticky || ((header & ((1ull << (drop - 1)) - 1ull)) != 0) || (fraction != 0);
+		}
+		if (guard && (sticky || (raw & 1ull))) ++raw;
+		if (raw == 0) raw = 1;                       // never round to 0
+		if (raw > maxposBits) raw = maxposBits;      // never round to NaR
 	}
-	if (v.isnan() || v.isinf()) {
-		p.setnan();
-		return p;
+	return (sign ? ((~raw + 1ull) & mask) : raw);
+}
+
+// convert an unrounded blocktriple from the arithmetic engine to a takum
+template<unsigned srcbits, BlockTripleOperator op, unsigned nbits, typename bt>
+inline void convert(const blocktriple<srcbits, op, bt>& src, takum<nbits, bt>& tgt) {
+	using BlockTriple = blocktriple<srcbits, op, bt>;
+	if (src.isnan() || src.isinf()) {
+		tgt.setnar();
+		return;
 	}
-	return p;
+	if (src.iszero()) {
+		tgt.setzero();
+		return;
+	}
+	// the leading 1 may be left of the radix point after an addition or multiplication overflow
+	int msb{ 0 };
+	uint64_t significand{ 0 };
+	bool sticky{ false };
+	if constexpr (BlockTriple::bfbits <= 64) {
+		uint64_t raw = src.significant_ull();
+		msb = static_cast<int>(std::bit_width(raw)) - 1;
+		significand = raw << (63 - msb);
+	}
+	else {
+		msb = static_cast<int>(BlockTriple::bfbits) - 1;
+		while (msb > 0 && !src.at(static_cast<unsigned>(msb))) --msb;
+		for (int i = 0; i < 64 && msb - i >= 0; ++i) {
+			if (src.at(static_cast<unsigned>(msb - i))) significand |= (1ull << (63 - i));
+		}
+		sticky = (msb >= 64) && src.any(static_cast<unsigned>(msb - 64));
+	}
+	int scale = src.scale() + msb - BlockTriple::radix;
+	tgt.setbits(takum_round<nbits>(src.sign(), scale, significand, sticky));
 }
 
 // template class representing a value in scientific notation, using a template size for the number of fraction bits
@@ -55,6 +168,9 @@ public:
 	static constexpr unsigned MSB_UNIT = (1ull + ((nbits - 2) / bitsInBlock)) - 1ull;
 	static constexpr bt       MSB_BIT_MASK = bt(1ull << ((nbits - 2ull) % bitsInBlock));
 
+	static constexpr unsigned fbits = (nbits > 5 ? nbits - 5 : 1);  // the widest mantissa, which is the mantissa of the values with r = 0
+	static constexpr bool     hasDecodeCache = (TAKUM_DECODE_CACHE != 0) && (nbits <= 16);
+
 	using BlockBinary = blockbinary<nbits, bt, BinaryNumberType::Unsigned>;
 
 	/// trivial constructor
@@ -132,23 +248,85 @@ public:
 #endif
 
 	// arithmetic operators
-	// prefix operator
-	takum operator-() const {				
-		return *this;
+	// prefix operator: the two's complement of the encoding, which leaves 0 and NaR invariant
+	takum operator-() const {
+		takum negated;
+		negated.setbits(~bits() + 1ull);
+		return negated;
 	}
 
 	// in-place arithmetic assignment operators
-	takum& operator+=(const takum& rhs) { return *this; }
+	takum& operator+=(const takum& rhs) {
+		if (isnar() || rhs.isnar()) {
+#if TAKUM_THROW_ARITHMETIC_EXCEPTION
+			throw takum_operand_is_nar{};
+#else
+			setnar();
+			return *this;
+#endif
+		}
+		if (iszero()) return *this = rhs;
+		if (rhs.iszero()) return *this;
+
+		blocktriple<fbits, BlockTripleOperator::ADD, bt> a, b, sum;
+		normalize(a);
+		rhs.normalize(b);
+		sum.add(a, b);
+		convert(sum, *this);
+		return *this;
+	}
 	takum& operator+=(double rhs) { return *this += takum(rhs); }
-	takum& operator-=(const takum& rhs) { return *this; }
+	takum& operator-=(const takum& rhs) { return *this += -rhs; }
 	takum& operator-=(double rhs) { return *this -= takum(rhs); }
-	takum& operator*=(const takum& rhs) { return *this; }
+	takum& operator*=(const takum& rhs) {
+		if (isnar() || rhs.isnar()) {
+#if TAKUM_THROW_ARITHMETIC_EXCEPTION
+			throw takum_operand_is_nar{};
+#else
+			setnar();
+			return *this;
+#endif
+		}
+		if (iszero() || rhs.iszero()) {
+			setzero();
+			return *this;
+		}
+
+		blocktriple<fbits, BlockTripleOperator::MUL, bt> a, b, product;
+		normalize(a);
+		rhs.normalize(b);
+		product.mul(a, b);
+		convert(product, *this);
+		return *this;
+	}
 	takum& operator*=(double rhs) { return *this *= takum(rhs); }
-	takum& operator/=(const takum& rhs) { return *this; }
+	takum& operator/=(const takum& rhs) {
+#if TAKUM_THROW_ARITHMETIC_EXCEPTION
+		if (rhs.iszero()) throw takum_divide_by_zero{};
+		if (rhs.isnar()) throw takum_divide_by_nar{};
+		if (isnar()) throw takum_numerator_is_nar{};
+#else
+		if (isnar() || rhs.isnar() || rhs.iszero()) {
+			setnar();
+			return *this;
+		}
+#endif
+		if (iszero()) return *this;
+
+		using BlockTriple = blocktriple<fbits, BlockTripleOperator::DIV, bt>;
+		BlockTriple a, b, quotient;
+		normalize(a);
+		rhs.normalize(b);
+		quotient.div(a, b);
+		quotient.setradix(BlockTriple::radix);
+		convert(quotient, *this);
+		return *this;
+	}
 	takum& operator/=(double rhs) { return *this /= takum(rhs); }
 
-	// prefix/postfix operators
+	// prefix/postfix operators: move to the next encoding, which is the next value
 	takum& operator++() {
+		setbits(bits() + 1ull);
 		return *this;
 	}
 	takum operator++(int) {
@@ -157,6 +335,7 @@ public:
 		return tmp;
 	}
 	takum& operator--() {
+		setbits(bits() - 1ull);
 		return *this;
 	}
 	takum operator--(int) {
@@ -207,31 +386,27 @@ public:
 		return *this;
 	}
 	constexpr takum& minpos() noexcept {
-		// minimum positive value has this bit pattern: 0-100-00...01, that is, sign = 0, integer = 10..00, fraction = 00..01
+		// minimum positive value has this bit pattern: 0-000-00...01, that is, c = -255 and the smallest mantissa
 		clear();
-		setbit(nbits - 2, true);    // msb  = 1
 		setbit(0, true);            // lsb  = 1
 		return *this;
 	}
 	constexpr takum& zero() noexcept {
-		// the zero value has this bit pattern: 0-100..00-00..000, sign = 0, msb = 1, rest 0
+		// the zero value has this bit pattern: 0-000..00-00..000
 		clear();
-		setbit(nbits - 2, true);    // msb = 1
 		return *this;
 	}
 	constexpr takum& minneg() noexcept {
-		// minimum negative value has this bit pattern: 1-100-00...01, that is, sign = 1, integer = 10..00, fraction = 00..01
+		// minimum negative value is the two's complement of minpos: 1-111-11...11
 		clear();
-		setbit(nbits - 1ull, true); // sign = 1
-		setbit(nbits - 2, true);    // msb  = 1
-		setbit(0, true);            // lsb  = 1
+		flip();
 		return *this;
 	}
 	constexpr takum& maxneg() noexcept {
-		// maximum negative value has this bit pattern: 1-01..1-11..11, that is, sign = 1, integer = 01..1, fraction = 11..11
+		// maximum negative value is the two's complement of maxpos: 1-000-00...01
 		clear();
-		flip();
-		setbit(nbits - 2ull, false); // msb  = 0
+		setbit(nbits - 1ull, true); // sign = 1
+		setbit(0, true);            // lsb  = 1
 		return *this;
 	}
 
@@ -251,7 +426,7 @@ public:
 	}
 	constexpr bool sign()      const noexcept { return _block.sign(); }
 	constexpr bool direct()    const noexcept { return _block.test(nbits - 2); }
-	constexpr int  scale()     const noexcept { return -100; }
+	constexpr int  scale()     const noexcept { return (iszero() || isnar()) ? 0 : takum_decode<nbits>(bits()).scale; }
 	constexpr unsigned regime()    const noexcept {
 		unsigned r{ 0 };
 		if constexpr (nrBlocks == 1) {
@@ -275,6 +450,28 @@ public:
 		bt mask = bt(1ull << (bitIndex % bitsInBlock));
 		return (word & mask);
 	}
+	// the encoding in the lower nbits of a uint64_t
+	constexpr uint64_t bits() const noexcept {
+		if constexpr (nrBlocks == 1) {
+			return static_cast<uint64_t>(_block[0]);
+		}
+		else {
+			uint64_t raw{ 0 };
+			for (unsigned i = nrBlocks; i-- > 0;) raw = (raw << bitsInBlock) | static_cast<uint64_t>(_block[i]);
+			return raw;
+		}
+	}
+	// sign, scale, and fraction of a takum that is not 0 or NaR, served from the decode cache for nbits <= 16
+	takum_decoded decode() const noexcept {
+		if constexpr (hasDecodeCache) {
+			uint64_t raw = bits();
+			const DecodeCacheEntry& entry = decodeCache()[raw];
+			return { static_cast<bool>((raw >> (nbits - 1)) & 1ull), entry.scale, static_cast<uint64_t>(entry.fraction) << 48 };
+		}
+		else {
+			return takum_decode<nbits>(bits());
+		}
+	}
 	constexpr bt block(unsigned b) const noexcept {
 		if (b < nrBlocks) return _block[b];
 		return bt(0); // return 0 when block index out of bounds
@@ -313,6 +510,47 @@ public:
 
 protected:
 
+		// decode cache for the takums of 16 bits or fewer: 4 bytes per encoding, generated on first use
+		struct DecodeCacheEntry {
+			int16_t  scale;
+			uint16_t fraction;  // the upper 16 bits of the left-aligned fraction
+		};
+		static const std::vector<DecodeCacheEntry>& decodeCache() {
+			static const std::vector<DecodeCacheEntry> cache = [] {
+				std::vector<DecodeCacheEntry> entries(size_t(1) << nbits, DecodeCacheEntry{ 0, 0 });
+				for (uint64_t raw = 0; raw < entries.size(); ++raw) {
+					if (raw == 0 || raw == (1ull << (nbits - 1))) continue;  // 0 and NaR are handled by the callers
+					takum_decoded d = takum_decode<nbits>(raw);
+					entries[raw] = { static_cast<int16_t>(d.scale), static_cast<uint16_t>(d.fraction >> 48) };
+				}
+				return entries;
+			}();
+			return cache;
+		}
+
+		// normalize the takum to the blocktriple input format of the arithmetic operator
+		//   ADD : 00h.fffffrrr  with the rounding bits
+		//   MUL : 0'00001.fffff with the radix at fbits
+		//   DIV : h.fffff0...0  shifted to the output radix
+		template<BlockTripleOperator op>
+		void normalize(blocktriple<fbits, op, bt>& tgt) const {
+			using BlockTriple = blocktriple<fbits, op, bt>;
+			constexpr unsigned shift = (op == BlockTripleOperator::ADD ? BlockTriple::rbits : (op == BlockTripleOperator::DIV ? BlockTriple::divshift : 0u));
+			takum_decoded d = decode();
+			tgt.setnormal();
+			tgt.setsign(d.sign);
+			tgt.setscale(d.scale);
+			uint64_t raw = (d.fraction >> (64 - fbits)) | (1ull << fbits);
+			if constexpr (fbits + 1 + shift < 64) {
+				tgt.setbits(raw << shift);
+			}
+			else {
+				tgt.setbits(raw);
+				tgt.bitShift(static_cast<int>(shift));
+			}
+			tgt.setradix(op == BlockTripleOperator::MUL ? static_cast<int>(fbits) : BlockTriple::radix);
+		}
+
 		/// <summary>
 		/// 1's complement of the encoding. Used internally to create specific bit patterns
 		/// </summary>
@@ -351,82 +589,25 @@ protected:
 		}
 		template<typename Real>
 		CONSTEXPRESSION takum& convert_ieee754(Real rhs) noexcept {
-			using std::log2;
-			using std::floor;
-			using sw::universal::scale;
+			// takums have no infinities: NaN and the infinities map to NaR
+			double v = static_cast<double>(rhs);
 			bool s{ false };
 			uint64_t rawExponent{ 0 };
 			uint64_t rawFraction{ 0 };
 			uint64_t bits{ 0 };
-			extractFields(rhs, s, rawExponent, rawFraction, bits);
-			if (rawExponent == ieee754_parameter<Real>::eallset) { // nan and inf need to be remapped
-				if (rawFraction == (ieee754_parameter<Real>::fmask & ieee754_parameter<Real>::snanmask) ||
-					rawFraction == (ieee754_parameter<Real>::fmask & (ieee754_parameter<Real>::qnanmask | ieee754_parameter<Real>::snanmask))) {
-					// 1.11111111.00000000.......00000001 signalling nan
-					// 0.11111111.00000000000000000000001 signalling nan
-					// MSVC
-					// 1.11111111.10000000.......00000001 signalling nan
-					// 0.11111111.10000000.......00000001 signalling nan
-					setnar();
-					return *this;
-				}
-				if (rawFraction == (ieee754_parameter<Real>::fmask & ieee754_parameter<Real>::qnanmask)) {
-					// 1.11111111.10000000.......00000000 quiet nan
-					// 0.11111111.10000000.......00000000 quiet nan
-					setnar();
-					return *this;
-				}
-				if (rawFraction == 0ull) {
-					// 1.11111111.0000000.......000000000 -inf
-					// 0.11111111.0000000.......000000000 +inf
-					(s ? maxneg() : maxpos());
-					return *this;
-				}
+			extractFields(v, s, rawExponent, rawFraction, bits);
+			if (rawExponent == ieee754_parameter<double>::eallset) {
+				setnar();
+				return *this;
 			}
-
-			if (rhs == 0.0) {
+			if (rawExponent == 0 && rawFraction == 0) {
 				setzero();
 				return *this;
 			}
-
-			// convert input to double
-			double v{ rhs };
-			uint64_t S = s ? 1 : 0;
-			// bool d{ false };
-			uint64_t D{ 0 }, R{ 0 };
-			uint64_t r{ 0 };
-			long a{ 0 }; //, b{ 0 };
-			long h = scale(v);
-			double fs = log2(1.0 + fraction(v));
-			double l = h + fs;
-			long amb = static_cast<int>(floor((s ? -1 : 1) * l));
-			if (amb >= 0) {
-				D = 1;
-				r = static_cast<int>(floor(log2(amb + 1)));
-				R = r;
-				a = amb;
-			}
-			else {
-				D = 0;
-				r = static_cast<int>(floor(log2(-amb)));
-				R = 7 - r;
-				a = amb + 3 * (1ul << r) - 2;
-			}
-			uint64_t A = a - (1ul << r) + 1ul;
-			double f = (s ? -1 : 1) * l - amb;
-			int m = nbits - 5 - r;
-			uint64_t F = static_cast<uint64_t>((1ull << m) * f);
-
-			// compose the takum
-			static_assert(nbits < 64, "requested takum straddles multiple uint64_ts");
-			uint64_t raw{ 0 };
-			raw |= (S << (nbits - 1));
-			raw |= (D << (nbits - 2));
-			raw |= (R << (nbits - 5));
-			raw |= (A << (nbits - 5 - r));
-			raw |= (F);
-			setbits(raw);
-
+			// subnormal doubles are far below minpos and saturate to minpos
+			int scale = (rawExponent == 0 ? -1023 : static_cast<int>(rawExponent) - ieee754_parameter<double>::bias);
+			uint64_t significand = ((1ull << 52) | rawFraction) << 11;
+			setbits(takum_round<nbits>(s, scale, significand, false));
 			return *this;
 		}
 
@@ -445,68 +626,23 @@ protected:
 		}
 		template<typename TargetFloat>
 		CONSTEXPRESSION TargetFloat to_ieee754() const noexcept {
-			TargetFloat value{ 0 };
-			if (iszero()) return value;
+			if (iszero()) return TargetFloat(0);
 			if (isnar()) return std::numeric_limits<TargetFloat>::quiet_NaN();
-
-			bool negative, direction;
-			unsigned regime, r;
-			if constexpr (nrBlocks == 1) {
-				bt msu = _block[MSU];
-				negative = (msu & SIGN_BIT_MASK);
-				direction = (msu & DIRECTION_BIT_MASK);
-				//std::cout << "bitsInMSU     : " << bitsInMSU << '\n';
-				regime = static_cast<unsigned>((msu & REGIME_FIELD_MASK) >> (bitsInMSU - 5));
-				r = direction ? regime :  7 - regime;
-				unsigned m = (r > nbits - 5) ? 0 : nbits - 5 - r;
-				// construct the exponent field mask
-				//std::cout << "regime        : " << int(regime) << '\n';
-				//std::cout << "r             : " << r << '\n';
-				//std::cout << "m             : " << m << '\n';
-				bt exponentFieldMask = static_cast<bt>((r > 0 ? (0xFFFF'FFFF'FFFF'FFFFull >> (64 - r)) : 0));
-				//std::cout << to_binary(exponentFieldMask) << '\n';
-				exponentFieldMask <<= m;
-				//std::cout << to_binary(exponentFieldMask) << '\n';
-				bt A = static_cast<bt>((msu & exponentFieldMask) >> m);
-				//std::cout << "A             : " << int(A) << '\n';
-				TargetFloat a = static_cast<TargetFloat>((1ull << r) - 1ull + A);
-				//std::cout << "a             : " << a << '\n';
-				TargetFloat b = static_cast<TargetFloat>(direction ? 0 : (3*(1ull << r) - 2ull));
-				//std::cout << "b             : " << b << '\n';
-				TargetFloat s = (negative ? 1.0f : 0.0f);
-				TargetFloat e = (1.0f - 2.0f * s) * (a - b + s);
-				//std::cout << "e             : " << e << '\n';
-
-				bt fractionFieldMask = static_cast<bt>(0xFFFF'FFFF'FFFF'FFFFull >> (64 - m));
-				//std::cout << to_binary(fractionFieldMask) << '\n';
-				bt fraction = static_cast<bt>(msu & fractionFieldMask);
-				//std::cout << to_binary(fraction) << '\n';
-				TargetFloat f = 0.0f;
-				TargetFloat bitValue = 0.5f;
-				bt bitMask = static_cast<bt>(1ull << (m - 1));
-				for (unsigned i = 0; i < m; ++i) {
-					f += (fraction & bitMask) ? bitValue : 0.0f;
-					bitMask >>= 1;
-					bitValue *= 0.5f;
-				}
-				//std::cout << "f             : " << f << '\n';
-				value = ((1 - 3 * s) + f) * std::exp2(e);
+			takum_decoded d = takum_decode<nbits>(bits());
+			if constexpr (sizeof(TargetFloat) > sizeof(double)) {
+				// the mantissa of a long double holds the widest takum mantissa
+				TargetFloat m = TargetFloat(1) + TargetFloat(d.fraction >> 1) / TargetFloat(9223372036854775808.0);
+				TargetFloat value = std::ldexp(m, d.scale);
+				return (d.sign ? -value : value);
 			}
 			else {
-				if constexpr (MSU_CONTAINS_REGIME) {
-					bt msu = _block[MSU];
-					negative = (msu & SIGN_BIT_MASK);
-					direction = (msu & DIRECTION_BIT_MASK);
-					regime = static_cast<uint8_t>((msu & REGIME_FIELD_MASK) >> (bitsInMSU - 5));
-				}
-				else {
-					negative = sign();
-					direction = direct();
-					regime = 0;
-				}
+				// round the mantissa to 52 bits, the characteristic is always in the normal range of a double
+				uint64_t mantissa = d.fraction >> 12;
+				uint64_t remainder = d.fraction & 0xFFFull;
+				if (remainder > 0x800ull || (remainder == 0x800ull && (mantissa & 1ull))) ++mantissa;
+				double value = std::ldexp(1.0 + static_cast<double>(mantissa) / 4503599627370496.0, d.scale);
+				return static_cast<TargetFloat>(d.sign ? -value : value);
 			}
-
-			return value;
 		}
 
 private:
@@ -588,10 +724,10 @@ inline bool operator==(const takum<nnbits, nbt>& lhs, const takum<nnbits, nbt>&
 }
 template<unsigned nnbits, typename nbt>
 inline bool operator!=(const takum<nnbits, nbt>& lhs, const takum<nnbits, nbt>& rhs) { return !operator==(lhs, rhs); }
+// the encodings are ordered like two's complement integers, with NaR as the smallest value
 template<unsigned nnbits, typename nbt>
 inline bool operator< (const takum<nnbits, nbt>& lhs, const takum<nnbits, nbt>& rhs) {
-	std::cerr << "operator<() TBD\n";
-	return false; 
+	return static_cast<int64_t>(lhs.bits() << (64 - nnbits)) < static_cast<int64_t>(rhs.bits() << (64 - nnbits));
 }
 template<unsigned nnbits, typename nbt>
 inline bool operator> (const takum<nnbits, nbt>& lhs, const takum<nnbits, nbt>& rhs) { return  operator< (rhs, lhs); }
@@ -600,6 +736,36 @@ inline bool operator<=(const takum<nnbits, nbt>& lhs, const takum<nnbits, nbt>&
 template<unsigned nnbits, typename nbt>
 inline bool operator>=(const takum<nnbits, nbt>& lhs, const takum<nnbits, nbt>& rhs) { return !operator< (lhs, rhs); }
 
+#if TAKUM_ENABLE_LITERALS
+// takum - literal logic operators
+template<unsigned nbits, typename bt>
+inline bool operator==(const takum<nbits, bt>& lhs, double rhs) { return operator==(lhs, takum<nbits, bt>(rhs)); }
+template<unsigned nbits, typename bt>
+inline bool operator!=(const takum<nbits, bt>& lhs, double rhs) { return operator!=(lhs, takum<nbits, bt>(rhs)); }
+template<unsigned nbits, typename bt>
+inline bool operator< (const takum<nbits, bt>& lhs, double rhs) { return operator< (lhs, takum<nbits, bt>(rhs)); }
+template<unsigned nbits, typename bt>
+inline bool operator> (const takum<nbits, bt>& lhs, double rhs) { return operator> (lhs, takum<nbits, bt>(rhs)); }
+template<unsigned nbits, typename bt>
+inline bool operator<=(const takum<nbits, bt>& lhs, double rhs) { return operator<=(lhs, takum<nbits, bt>(rhs)); }
+template<unsigned nbits, typename bt>
+inline bool operator>=(const takum<nbits, bt>& lhs, double rhs) { return operator>=(lhs, takum<nbits, bt>(rhs)); }
+
+// literal - takum logic operators
+template<unsigned nbits, typename bt>
+inline bool operator==(double lhs, const takum<nbits, bt>& rhs) { return operator==(takum<nbits, bt>(lhs), rhs); }
+template<unsigned nbits, typename bt>
+inline bool operator!=(double lhs, const takum<nbits, bt>& rhs) { return operator!=(takum<nbits, bt>(lhs), rhs); }
+template<unsigned nbits, typename bt>
+inline bool operator< (double lhs, const takum<nbits, bt>& rhs) { return operator< (takum<nbits, bt>(lhs), rhs); }
+template<unsigned nbits, typename bt>
+inline bool operator> (double lhs, const takum<nbits, bt>& rhs) { return operator> (takum<nbits, bt>(lhs), rhs); }
+template<unsigned nbits, typename bt>
+inline bool operator<=(double lhs, const takum<nbits, bt>& rhs) { return operator<=(takum<nbits, bt>(lhs), rhs); }
+template<unsigned nbits, typename bt>
+inline bool operator>=(double lhs, const takum<nbits, bt>& rhs) { return operator>=(takum<nbits, bt>(lhs), rhs); }
+#endif // TAKUM_ENABLE_LITERALS
+
 // takum - takum binary arithmetic operators
 // BINARY ADDITION
 template<unsigned nbits, typename bt>
@@ -9,6 +9,7 @@
 
 #include <universal/number/valid/exceptions.hpp>
 #include <universal/number/valid/valid_impl.hpp>
+#include <universal/number/valid/valid_kernels.hpp>
 #include <universal/number/valid/manipulators.hpp>
 #include <universal/number/valid/attributes.hpp>
 
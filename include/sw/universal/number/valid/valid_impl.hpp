@@ -5,11 +5,48 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
+#include <cmath>
 #include <limits>
 #include <universal/number/posit/posit_impl.hpp>
 
 namespace sw { namespace universal {
 
+/*
+ * valid arithmetic is interval arithmetic on posit bounds: the lower bound of a result is
+ * rounded down and the upper bound is rounded up, and a bound is closed when it is an exact
+ * bound of the result. A NaR bound stands for an unbounded side, -inf as lower bound and
+ * +inf as upper bound.
+ *
+ * The bounds are decoded once into valid_endpoint records, the candidate bounds of the
+ * result are computed from the endpoints, and the two result bounds are encoded once.
+ * When the posit configuration fits in a double, and the products and quotients of its
+ * values do not underflow, the endpoints carry their double value and the result bounds
+ * are computed with error-free transformations: the exact result is hi + lo, and a single
+ * conversion of hi to the posit followed by at most one step to the adjacent posit yields
+ * the directed rounding. Wider configurations use the posit arithmetic and round outward
+ * by one posit, which is rigorous but one posit wider when the result happens to be exact.
+ */
+enum class ValidOperator : unsigned { ADD = 0, SUB = 1, MUL = 2, DIV = 3 };
+
+// bound of a valid: a finite posit, or an unbounded side
+template<unsigned nbits, unsigned es>
+struct valid_endpoint {
+	posit<nbits, es> p;  // finite bound
+	double v;            // value of the finite bound, only decoded when the native endpoint arithmetic applies
+	int inf;             // -1 for -inf, +1 for +inf, 0 for a finite bound
+	bool closed;         // bound is included in the interval
+};
+
+// valid_native_endpoints: the values, and the error terms of the sums, products, and quotients,
+// of the posit configuration are exact in double precision
+template<unsigned nbits, unsigned es>
+constexpr bool valid_native_endpoints() {
+	constexpr int fbits = int(nbits) - 3 - int(es);
+	if (fbits > 52 || es > 8) return false;
+	constexpr long maxscale = long(nbits - 2) << es;
+	return maxscale < 300;  // the division residual, of order 2^(-3 * maxscale - 104), stays clear of the double subnormals
+}
+
 template<unsigned nbits, unsigned es>
 class valid {
 
@@ -18,10 +55,18 @@ class valid {
 
 	template <typename T>
 	valid<nbits, es>& _assign(const T& rhs) {
-		constexpr int fbits = std::numeric_limits<T>::digits - 1;
-		internal::value<fbits> v((T)rhs);
-
-		return *this;
+		// split the value into an unevaluated sum hi + lo of doubles, which is exact for the integer types and long double
+		long double x = static_cast<long double>(rhs);
+		if (x != x || x == std::numeric_limits<long double>::infinity() || x == -std::numeric_limits<long double>::infinity()) {
+			setinclusive();
+			return *this;
+		}
+		double hi = static_cast<double>(x);
+		double lo = static_cast<double>(x - static_cast<long double>(hi));
+		valid_endpoint<nbits, es> l{}, u{};
+		bool exact = round_bounds(hi, lo, l, u);
+		l.closed = u.closed = exact;
+		return assign_bounds(l, u);
 	}
 
 public:
@@ -46,17 +91,16 @@ public:
 	valid& operator=(double rhs) { return _assign(rhs); }
 	valid& operator=(long double rhs) { return _assign(rhs); }
 
-	valid& operator+=(const valid& rhs) {
-		return *this;
-	}
-	valid& operator-=(const valid& rhs) {
-		return *this;
-	}
-	valid& operator*=(const valid& rhs) {
-		return *this;
-	}
-	valid& operator/=(const valid& rhs) {
-		return *this;
+	valid& operator+=(const valid& rhs) { return apply(ValidOperator::ADD, rhs); }
+	valid& operator-=(const valid& rhs) { return apply(ValidOperator::SUB, rhs); }
+	valid& operator*=(const valid& rhs) { return apply(ValidOperator::MUL, rhs); }
+	valid& operator/=(const valid& rhs) { return apply(ValidOperator::DIV, rhs); }
+
+	valid operator-() const {
+		valid negated;
+		negated.lb = -ub; negated.lubit = uubit;
+		negated.ub = -lb; negated.uubit = lubit;
+		return negated;
 	}
 
 	// conversion operators
@@ -69,10 +113,10 @@ public:
 		return lubit && uubit;
 	}
 	inline bool isopenlower() const {
-		return lubit;
+		return !lubit;
 	}
 	inline bool isopenupper() const {
-		return uubit;
+		return !uubit;
 	}
 	inline bool getlb(sw::universal::posit<nbits, es>& _lb) const {
 		_lb = lb;
@@ -106,6 +150,62 @@ public:
 		ub = _ub;
 		uubit = ubit;
 	}
+	// endpoint interface of the valid arithmetic and the batch kernels
+	valid_endpoint<nbits, es> lower() const { return decode(lb, lubit, -1); }
+	valid_endpoint<nbits, es> upper() const { return decode(ub, uubit, +1); }
+	valid& assign_bounds(const valid_endpoint<nbits, es>& l, const valid_endpoint<nbits, es>& u) {
+		if (l.inf != 0) lb.setnar(); else lb = l.p;
+		if (u.inf != 0) ub.setnar(); else ub = u.p;
+		lubit = l.closed;
+		uubit = u.closed;
+		return *this;
+	}
+
+	/// <summary>
+	/// the bounds of [a_lo, a_hi] op [b_lo, b_hi]
+	/// </summary>
+	/// <returns>false when the result is the whole projective line, such as for a divisor that contains 0</returns>
+	static bool combine(ValidOperator op, valid_endpoint<nbits, es> al, valid_endpoint<nbits, es> au, valid_endpoint<nbits, es> bl, valid_endpoint<nbits, es> bu,
+	                    valid_endpoint<nbits, es>& rl, valid_endpoint<nbits, es>& ru) {
+		using Endpoint = valid_endpoint<nbits, es>;
+		switch (op) {
+		case ValidOperator::SUB:
+		{
+			Endpoint nl = negate(bu), nu = negate(bl);
+			bl = nl; bu = nu;
+		}
+		[[fallthrough]];
+		case ValidOperator::ADD:
+			candidate(ValidOperator::ADD, al, bl, rl, true);
+			candidate(ValidOperator::ADD, au, bu, ru, false);
+			return true;
+		case ValidOperator::DIV:
+		case ValidOperator::MUL:
+		default:
+		{
+			// sign of the values of the divisor, which must exclude 0
+			int divisorSign = (sign(bl) != 0 ? sign(bl) : sign(bu));
+			if (op == ValidOperator::DIV && (contains_zero(bl, bu) || divisorSign == 0)) return false;
+			const Endpoint* a[2] = { &al, &au };
+			const Endpoint* b[2] = { &bl, &bu };
+			bool valid_lower = false, valid_upper = false;
+			for (int i = 0; i < 2; ++i) {
+				for (int j = 0; j < 2; ++j) {
+					Endpoint down{}, up{};
+					if (!candidate(op, *a[i], *b[j], down, true, divisorSign)) continue;
+					candidate(op, *a[i], *b[j], up, false, divisorSign);
+					if (!valid_lower || less(down, rl)) { rl = down; }
+					else if (equal(down, rl)) { rl.closed = rl.closed || down.closed; }
+					if (!valid_upper || less(ru, up)) { ru = up; }
+					else if (equal(up, ru)) { ru.closed = ru.closed || up.closed; }
+					valid_lower = valid_upper = true;
+				}
+			}
+			return valid_lower;
+		}
+		}
+	}
+
 	inline void setbits(uint64_t v) { // API to be consistent with the other number systems
 		lb.setbits(v & 0xFFFFFFFFul);
 		ub.setbits((v >> 32) & 0xFFFFFFFFul);
@@ -133,6 +233,150 @@ private:
 
 	// helper methods	
 
+	valid& apply(ValidOperator op, const valid& rhs) {
+		valid_endpoint<nbits, es> l{}, u{};
+		if (!combine(op, lower(), upper(), rhs.lower(), rhs.upper(), l, u)) {
+			setinclusive();
+			return *this;
+		}
+		return assign_bounds(l, u);
+	}
+
+	static valid_endpoint<nbits, es> decode(const posit<nbits, es>& p, bool closed, int side) {
+		valid_endpoint<nbits, es> e{ p, 0.0, 0, closed };
+		if (p.isnar()) {
+			e.inf = side;
+			e.v = side * std::numeric_limits<double>::infinity();
+		}
+		else if constexpr (valid_native_endpoints<nbits, es>()) {
+			e.v = double(p);
+		}
+		return e;
+	}
+
+	static valid_endpoint<nbits, es> negate(const valid_endpoint<nbits, es>& e) {
+		return { -e.p, -e.v, -e.inf, e.closed };
+	}
+
+	static bool iszero(const valid_endpoint<nbits, es>& e) { return e.inf == 0 && e.p.iszero(); }
+	static int sign(const valid_endpoint<nbits, es>& e) { return (e.inf != 0 ? e.inf : (e.p.iszero() ? 0 : (e.p.isneg() ? -1 : 1))); }
+
+	static bool less(const valid_endpoint<nbits, es>& a, const valid_endpoint<nbits, es>& b) {
+		if (a.inf != 0 || b.inf != 0) return a.inf < b.inf || (a.inf == 0 && b.inf > 0) || (a.inf < 0 && b.inf == 0);
+		return a.p < b.p;
+	}
+	static bool equal(const valid_endpoint<nbits, es>& a, const valid_endpoint<nbits, es>& b) {
+		if (a.inf != 0 || b.inf != 0) return a.inf == b.inf;
+		return a.p == b.p;
+	}
+
+	// the divisor interval contains 0 unless 0 is an excluded bound
+	static bool contains_zero(const valid_endpoint<nbits, es>& l, const valid_endpoint<nbits, es>& u) {
+		int sl = sign(l), su = sign(u);
+		return (sl < 0 || (sl == 0 && l.closed)) && (su > 0 || (su == 0 && u.closed));
+	}
+
+	static valid_endpoint<nbits, es> infinite(int side, bool closed) {
+		return { posit<nbits, es>(0), side * std::numeric_limits<double>::infinity(), side, closed };
+	}
+	static valid_endpoint<nbits, es> zero(bool closed) {
+		return { posit<nbits, es>(0), 0.0, 0, closed };
+	}
+
+	/// <summary>
+	/// one candidate bound a op b, rounded down for a lower bound and up for an upper bound
+	/// </summary>
+	/// <returns>false for the indeterminate forms 0 * inf, 0 / 0, and inf / inf, which do not bound the result</returns>
+	static bool candidate(ValidOperator op, const valid_endpoint<nbits, es>& a, const valid_endpoint<nbits, es>& b, valid_endpoint<nbits, es>& r, bool down, int divisorSign = 0) {
+		bool closed = a.closed && b.closed;
+		int sa = sign(a), sb = sign(b);
+		switch (op) {
+		case ValidOperator::ADD:
+		case ValidOperator::SUB:
+			// a lower bound is never +inf and an upper bound never -inf, so inf - inf does not occur
+			if (a.inf != 0 || b.inf != 0) { r = infinite(a.inf != 0 ? a.inf : b.inf, closed); return true; }
+			if (sa == 0) { r = b; r.closed = closed; return true; }
+			if (sb == 0) { r = a; r.closed = closed; return true; }
+			break;
+		case ValidOperator::MUL:
+			if ((sa == 0 && b.inf != 0) || (a.inf != 0 && sb == 0)) return false;
+			if (sa == 0) { r = zero(a.closed); return true; }  // a closed 0 yields 0 for every value of the other interval
+			if (sb == 0) { r = zero(b.closed); return true; }
+			if (a.inf != 0 || b.inf != 0) { r = infinite(sa * sb, closed); return true; }
+			break;
+		case ValidOperator::DIV:
+		default:
+			// the divisor does not contain 0, so a divisor bound of 0 is excluded and is approached from one side
+			if ((sa == 0 && sb == 0) || (a.inf != 0 && b.inf != 0)) return false;
+			if (sa == 0) { r = zero(a.closed); return true; }
+			if (sb == 0) { r = infinite(sa * divisorSign, false); return true; }
+			if (a.inf != 0) { r = infinite(sa * sb, closed); return true; }
+			if (b.inf != 0) { r = zero(closed); return true; }
+			break;
+		}
+		r.inf = 0;
+		bool exact = round_finite(op, a, b, r, down);
+		r.closed = closed && exact;
+		if (r.p.isnar()) r = infinite(down ? -1 : 1, false);  // rounded beyond maxpos or maxneg
+		return true;
+	}
+
+	// directed rounding of a op b for finite, non-zero a and b, returns true when the result is exact
+	static bool round_finite(ValidOperator op, const valid_endpoint<nbits, es>& a, const valid_endpoint<nbits, es>& b, valid_endpoint<nbits, es>& r, bool down) {
+		if constexpr (valid_native_endpoints<nbits, es>()) {
+			double x = a.v, y = b.v, hi{ 0 }, lo{ 0 };
+			switch (op) {
+			case ValidOperator::ADD:
+			case ValidOperator::SUB: {
+				hi = x + y;  // TwoSum
+				double yy = hi - x;
+				lo = (x - (hi - yy)) + (y - yy);
+				break;
+			}
+			case ValidOperator::MUL:
+				hi = x * y;
+				lo = std::fma(x, y, -hi);
+				break;
+			case ValidOperator::DIV:
+			default:
+				hi = x / y;
+				lo = -std::fma(hi, y, -x) / y;  // only the sign of the exact residual is used
+				break;
+			}
+			valid_endpoint<nbits, es> l{}, u{};
+			bool exact = round_bounds(hi, lo, l, u);
+			r.p = (down ? l.p : u.p);
+			return exact;
+		}
+		else {
+			posit<nbits, es> p = a.p;
+			switch (op) {
+			case ValidOperator::ADD:
+			case ValidOperator::SUB:	p += b.p; break;
+			case ValidOperator::MUL:	p *= b.p; break;
+			case ValidOperator::DIV:
+			default:					p /= b.p; break;
+			}
+			// the exactness of the posit result is unknown: step outward by one posit
+			if (down) --p; else ++p;
+			r.p = p;
+			return false;
+		}
+	}
+
+	// round the exact value hi + lo down and up to the posit configuration, returns true when it is exact
+	static bool round_bounds(double hi, double lo, valid_endpoint<nbits, es>& l, valid_endpoint<nbits, es>& u) {
+		posit<nbits, es> p(hi);
+		double v = double(p);
+		int order = (v < hi ? -1 : (v > hi ? 1 : (lo > 0 ? -1 : (lo < 0 ? 1 : 0))));  // sign of p - (hi + lo)
+		l = u = valid_endpoint<nbits, es>{ p, v, 0, true };
+		if (order > 0) --l.p;
+		if (order < 0) ++u.p;
+		if (l.p.isnar()) { l.inf = -1; l.v = -std::numeric_limits<double>::infinity(); }
+		if (u.p.isnar()) { u.inf = +1; u.v = std::numeric_limits<double>::infinity(); }
+		return order == 0;
+	}
+
 	// special case check for projecting values between (0, minpos] to minpos and [maxpos, inf) to maxpos
 	// Returns true if the scale is too small or too large for this posit config
 	bool check_inward_projection_range(int scale) {
@@ -258,11 +502,18 @@ inline std::istream& operator>> (std::istream& istr, const valid<nbits, es>& v)
 
 // valid - logic operators
 template<unsigned nnbits, unsigned ees>
-inline bool operator==(const valid<nnbits, ees>& lhs, const valid<nnbits, ees>& rhs) { return false; }
+inline bool operator==(const valid<nnbits, ees>& lhs, const valid<nnbits, ees>& rhs) {
+	return lhs.lb == rhs.lb && lhs.ub == rhs.ub && lhs.lubit == rhs.lubit && lhs.uubit == rhs.uubit;
+}
 template<unsigned nnbits, unsigned ees>
 inline bool operator!=(const valid<nnbits, ees>& lhs, const valid<nnbits, ees>& rhs) { return !operator==(lhs, rhs); }
+// lhs < rhs when every value of lhs is less than every value of rhs
 template<unsigned nnbits, unsigned ees>
-inline bool operator< (const valid<nnbits, ees>& lhs, const valid<nnbits, ees>& rhs) { return false; }
+inline bool operator< (const valid<nnbits, ees>& lhs, const valid<nnbits, ees>& rhs) {
+	using Valid = valid<nnbits, ees>;
+	auto u = lhs.upper(), l = rhs.lower();
+	return Valid::less(u, l) || (Valid::equal(u, l) && (!u.closed || !l.closed));
+}
 template<unsigned nnbits, unsigned ees>
 inline bool operator> (const valid<nnbits, ees>& lhs, const valid<nnbits, ees>& rhs) { return  operator< (rhs, lhs); }
 template<unsigned nnbits, unsigned ees>
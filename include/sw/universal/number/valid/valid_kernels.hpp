@@ -0,0 +1,74 @@
+#pragma once
+// valid_kernels.hpp: batch kernels over contiguous arrays of valids
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <universal/number/valid/valid_impl.hpp>
+
+/*
+ * The kernels process the arrays in blocks: the four posit bounds of each pair of operands
+ * are decoded into endpoint arrays in one pass, the result bounds are computed from the
+ * endpoint arrays in a second pass, and encoded in a third. Each bound is decoded once,
+ * and the decode loops are free of the branches of the interval rules, which keeps the
+ * cost of an interval operation close to two posit operations.
+ * The kernels produce the same valids as a loop over the scalar operators, and the
+ * result array may alias either operand array.
+ */
+namespace sw { namespace universal {
+
+	namespace internal {
+
+		template<unsigned nbits, unsigned es>
+		void valid_batch(ValidOperator op, size_t n, const valid<nbits, es>* x, const valid<nbits, es>* y, valid<nbits, es>* z) {
+			using Valid = valid<nbits, es>;
+			using Endpoint = valid_endpoint<nbits, es>;
+			constexpr size_t BLOCK = 64;
+			Endpoint xl[BLOCK], xu[BLOCK], yl[BLOCK], yu[BLOCK], rl[BLOCK], ru[BLOCK];
+			bool bounded[BLOCK];
+			for (size_t base = 0; base < n; base += BLOCK) {
+				size_t m = (n - base < BLOCK ? n - base : BLOCK);
+				for (size_t i = 0; i < m; ++i) {
+					xl[i] = x[base + i].lower();
+					xu[i] = x[base + i].upper();
+					yl[i] = y[base + i].lower();
+					yu[i] = y[base + i].upper();
+				}
+				for (size_t i = 0; i < m; ++i) {
+					bounded[i] = Valid::combine(op, xl[i], xu[i], yl[i], yu[i], rl[i], ru[i]);
+				}
+				for (size_t i = 0; i < m; ++i) {
+					if (bounded[i]) z[base + i].assign_bounds(rl[i], ru[i]); else z[base + i].setinclusive();
+				}
+			}
+		}
+
+	}  // namespace internal
+
+	// z[i] = x[i] + y[i]
+	template<unsigned nbits, unsigned es>
+	void valid_add(size_t n, const valid<nbits, es>* x, const valid<nbits, es>* y, valid<nbits, es>* z) {
+		internal::valid_batch(ValidOperator::ADD, n, x, y, z);
+	}
+
+	// z[i] = x[i] - y[i]
+	template<unsigned nbits, unsigned es>
+	void valid_sub(size_t n, const valid<nbits, es>* x, const valid<nbits, es>* y, valid<nbits, es>* z) {
+		internal::valid_batch(ValidOperator::SUB, n, x, y, z);
+	}
+
+	// z[i] = x[i] * y[i]
+	template<unsigned nbits, unsigned es>
+	void valid_mul(size_t n, const valid<nbits, es>* x, const valid<nbits, es>* y, valid<nbits, es>* z) {
+		internal::valid_batch(ValidOperator::MUL, n, x, y, z);
+	}
+
+	// z[i] = x[i] / y[i]
+	template<unsigned nbits, unsigned es>
+	void valid_div(size_t n, const valid<nbits, es>* x, const valid<nbits, es>* y, valid<nbits, es>* z) {
+		internal::valid_batch(ValidOperator::DIV, n, x, y, z);
+	}
+
+}} // namespace sw::universal
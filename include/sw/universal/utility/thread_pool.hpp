@@ -0,0 +1,131 @@
+#pragma once
+// thread_pool.hpp: fixed-size pool of worker threads to run data-parallel loops
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sw { namespace universal {
+
+	// thread_pool runs the iterations of a parallel_for on a fixed set of worker threads.
+	// The calling thread participates in the loop, so a pool of size 1 has no workers and
+	// executes the loop inline. Iterations are handed out dynamically, one index at a time.
+	class thread_pool {
+	public:
+		explicit thread_pool(unsigned nrThreads = std::thread::hardware_concurrency()) : _stop{ false }, _generation{ 0 }, _busy{ 0 } {
+			if (nrThreads == 0) nrThreads = 1;
+			for (unsigned i = 1; i < nrThreads; ++i) {
+				_workers.emplace_back([this] { work(); });
+			}
+		}
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+		~thread_pool() {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			_wakeup.notify_all();
+			for (auto& t : _workers) t.join();
+		}
+
+		unsigned size() const noexcept { return static_cast<unsigned>(_workers.size()) + 1; }
+
+		// call body(i) for i in [0, n) and return when all iterations have completed
+		// the first exception thrown by an iteration is rethrown in the calling thread
+		void parallel_for(size_t n, const std::function<void(size_t)>& body) {
+			if (n == 0) return;
+			if (_workers.empty() || n == 1 || inside_loop()) {  // nested loops run inline
+				for (size_t i = 0; i < n; ++i) body(i);
+				return;
+			}
+			std::lock_guard<std::mutex> serialize(_submit);  // one loop at a time
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_body = &body;
+				_n = n;
+				_next = 0;
+				_error = nullptr;
+				_busy = static_cast<unsigned>(_workers.size());
+				++_generation;
+			}
+			_wakeup.notify_all();
+			run();
+			std::unique_lock<std::mutex> lock(_mutex);
+			_done.wait(lock, [this] { return _busy == 0; });
+			_body = nullptr;
+			if (_error) std::rethrow_exception(_error);
+		}
+
+	private:
+		std::vector<std::thread> _workers;
+		std::mutex _submit, _mutex;
+		std::condition_variable _wakeup, _done;
+		bool _stop;
+		size_t _generation;
+		unsigned _busy;                                       // workers that have not finished the current loop
+		const std::function<void(size_t)>* _body{ nullptr };
+		size_t _n{ 0 };
+		std::atomic<size_t> _next{ 0 };
+		std::exception_ptr _error;
+
+		static bool& inside_loop() {
+			static thread_local bool inside = false;
+			return inside;
+		}
+		// claim iterations until the loop is exhausted
+		void run() {
+			inside_loop() = true;
+			for (size_t i = _next++; i < _n; i = _next++) {
+				try {
+					(*_body)(i);
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (!_error) _error = std::current_exception();
+					_next = _n;  // abandon the remaining iterations
+				}
+			}
+			inside_loop() = false;
+		}
+		void work() {
+			size_t seen = 0;
+			for (;;) {
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_wakeup.wait(lock, [&] { return _stop || _generation != seen; });
+					if (_stop) return;
+					seen = _generation;
+				}
+				run();
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					if (--_busy == 0) _done.notify_one();
+				}
+			}
+		}
+	};
+
+	// number types that may be evaluated on several threads at once: only arithmetic and trivially
+	// copyable types are handed to worker threads. Types that own heap storage or keep class-wide
+	// state, such as edecimal with its operation counters, run on the calling thread.
+	template<typename... Scalars>
+	inline constexpr bool is_parallel_safe = ((std::is_arithmetic_v<Scalars> || std::is_trivially_copyable_v<Scalars>) && ...);
+
+	// process-wide pool sized to the hardware concurrency, created on first use
+	inline thread_pool& default_thread_pool() {
+		static thread_pool pool;
+		return pool;
+	}
+
+}} // namespace sw::universal
@@ -168,54 +168,66 @@ int VerifyBlockSignificantMultiplication(bool reportTestCases) {
 	return nrOfFailedTests;
 }
 
-// enumerate all division cases for an blocksignificant<nbits,BlockType> configuration
-// TODO: fix test failures in VerifyBlockSignificantDivision<blocksignificantConfiguration>
+// enumerate all normalized division cases for an blocksignificant<nbits,BlockType> configuration
+// The operands are of the form 001.ffff with the hidden bit at the radix, and fbits = radix/2 fraction bits.
+// The golden reference is the integer quotient (a << 2*fbits) / b computed with a blockbinary of 2*nbits.
+// For large configurations the top 8 fraction bits are enumerated and the lower bits are filled pseudo-randomly.
 template<typename blocksignificantConfiguration>
 int VerifyBlockSignificantDivision(bool reportTestCases) {
 	constexpr unsigned nbits = blocksignificantConfiguration::nbits;
 	using BlockType = typename blocksignificantConfiguration::BlockType;
-
-	constexpr unsigned NR_VALUES = (1u << nbits);
+	constexpr unsigned radix = nbits - 2;   // 2 integer bits to capture overflow
+	constexpr unsigned fbits = (radix >> 1);
+	constexpr unsigned lsb = radix - 2 * fbits; // position of the lsb of the quotient
+	constexpr unsigned ebits = (fbits < 8 ? fbits : 8);  // enumerated fraction bits
+	constexpr uint64_t NR_VALUES = (1ull << ebits);
 	using namespace sw::universal;
 
-	//	cout << endl;
-	//	cout << "blocksignificant<" << nbits << ',' << typeid(BlockType).name() << '>' << endl;
-
 	int nrOfFailedTests = 0;
 
-	blocksignificant<nbits, BlockType> a, b, c;
-	// nbits = 2 * fhbits
-	constexpr unsigned fhbits = (nbits >> 1);
-	constexpr unsigned fbits = fhbits - 1;
-	a.setradix(2 * fbits);
-	b.setradix(2 * fbits);
-	a.setradix(2 * fbits);
-	blockbinary<nbits, BlockType> aref, bref, cref, refResult;
-	constexpr unsigned nrBlocks = blockbinary<nbits, BlockType>::nrBlocks;
-	for (unsigned i = 0; i < NR_VALUES; i++) {
-		a.setbits(i);
-		aref.setbits(i);
-		for (unsigned j = 0; j < NR_VALUES; j++) {
-			b.setbits(j);
-			bref.setbits(j);
+	blocksignificant<nbits, BlockType> a, b, c, refResult;
+	blockbinary<2 * nbits, uint32_t> aref, bref, cref;
+	uint64_t lcg = 0x2545'F491'4F6C'DD1Dull;
+	auto setOperand = [&lcg](blocksignificant<nbits, BlockType>& bs, blockbinary<2 * nbits, uint32_t>& ref, uint64_t pattern) {
+		bs.clear();
+		ref.clear();
+		bs.setbit(radix);
+		ref.setbit(radix);
+		for (unsigned k = 0; k < ebits; ++k) {
+			bool bit = (pattern >> k) & 0x1;
+			bs.setbit(radix - ebits + k, bit);
+			ref.setbit(radix - ebits + k, bit);
+		}
+		for (unsigned k = radix - fbits; k < radix - ebits; ++k) {
+			lcg = lcg * 6364136223846793005ull + 1442695040888963407ull;
+			bool bit = (lcg >> 63) & 0x1;
+			bs.setbit(k, bit);
+			ref.setbit(k, bit);
+		}
+	};
+	for (uint64_t i = 0; i < NR_VALUES; i++) {
+		setOperand(a, aref, i);
+		aref <<= static_cast<int>(2 * fbits);
+		for (uint64_t j = 0; j < NR_VALUES; j++) {
+			setOperand(b, bref, j);
 			cref = aref / bref;
+			cref <<= static_cast<int>(lsb);
+			a.setradix(radix);
+			b.setradix(radix);
 			c.div(a, b);
-			for (unsigned k = 0; k < nrBlocks; ++k) {
-				refResult.setblock(k, c.block(k));
-			}
+			refResult.clear();
+			for (unsigned k = 0; k < nbits; ++k) refResult.setbit(k, cref.test(k));
 
-			if (refResult != cref) {
+			if (refResult != c) {
 				nrOfFailedTests++;
-				if (reportTestCases)	ReportBinaryArithmeticErrorBSCustom("FAIL", "+", a, b, c, refResult);
+				if (reportTestCases)	ReportBinaryArithmeticErrorBSCustom("FAIL", "/", a, b, c, refResult);
 			}
 			else {
-				// if (reportTestCases) ReportBinaryArithmeticSuccessBSCustom("PASS", "+", a, b, c, cref);
+				// if (reportTestCases) ReportBinaryArithmeticSuccessBSCustom("PASS", "/", a, b, c, refResult);
 			}
 			if (nrOfFailedTests > 100) return nrOfFailedTests;
 		}
-		//		if (i % 1024 == 0) cout << '.'; /// if you enable this, put the endl back
 	}
-	//	cout << endl;
 	return nrOfFailedTests;
 }
 
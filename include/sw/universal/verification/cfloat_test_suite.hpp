@@ -1237,6 +1237,332 @@ namespace sw { namespace universal {
 		return nrOfFailedTestCases;
 	}
 
+// optimizing compilers manipulate NaN(ind) and the sign of infinite on a division by zero
+// when defined, this compiler guard adds a filter to the CFLOAT division test regression
+// to filter out these discrepancies. In debug builds, the compiler is compliant and you
+// can undefine this guard and add the test comparisons for divide by zero to catch any
+// errors that the implementation might have.
+#define FILTER_OUT_DIVIDE_BY_ZERO
+
+	// The per operand pair rules of the binary operator suites, shared by the sequential suites below
+	// and the parallel drivers: each computes nut = a op b and the reference cref, derived from the
+	// double reference and the nan, inf, and saturation rules of the configuration, and returns true
+	// when nut is a failure.
+
+	template<typename Cfloat>
+	bool CfloatAdditionCaseFails(const Cfloat& a, const Cfloat& b, Cfloat& nut, Cfloat& cref) {
+		constexpr bool isSaturating = Cfloat::isSaturating;
+		if constexpr (!Cfloat::hasSubnormals) {
+			if (a.isdenormal() || b.isdenormal()) return false; // ignore subnormal encodings
+		}
+		double ref = double(a) + double(b);  // make certain that IEEE doubles are sufficient as reference
+#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
+		// catching overflow
+		try {
+			nut = a + b;
+		}
+		catch (...) {
+			cref = ref;
+			return cref.inrange(ref);  // only overflow may throw
+		}
+#else
+		nut = a + b;
+#endif // CFLOAT_THROW_ARITHMETIC_EXCEPTION
+		if (a.isnan() || b.isnan()) {
+			// nan-type propagates
+			// if both are nan then signalling nan wins
+			// a        b   =   ref
+			// qnan    qnan = qnan
+			// qnan     #   = qnan
+			// #       qnan = qnan
+			// snan     #   = snan
+			// #       snan = snan
+			// snan    snan = snan
+			// snan    qnan = snan
+			// qnan    snan = snan
+			if (a.isnan(NAN_TYPE_SIGNALLING) || b.isnan(NAN_TYPE_SIGNALLING)) {
+				cref.setnan(NAN_TYPE_SIGNALLING);
+			}
+			else {
+				cref.setnan(NAN_TYPE_QUIET);
+			}
+		}
+		else if (a.isinf() || b.isinf()) {
+			// a      b  =  ref
+			// +inf +inf = +inf
+			// +inf -inf = snan
+			// -inf +inf = snan
+			// -inf -inf = -inf
+			if (a.isinf()) {
+				if (b.isinf()) {
+					if (a.sign() == b.sign()) {
+						cref.setinf(a.sign());
+					}
+					else {
+						cref.setnan(NAN_TYPE_SIGNALLING);
+					}
+				}
+				else {
+					cref.setinf(a.sign());
+				}
+			}
+			else {
+				cref.setinf(b.sign());
+			}
+		}
+		else {
+			if (!nut.inrange(ref)) {
+				// the result of the addition is outside of the range
+				// of the NUT (number system under test)
+				if constexpr (isSaturating) {
+					if (ref > 0) cref.maxpos(); else cref.maxneg();
+				}
+				else {
+					cref.setinf(ref < 0);
+				}
+			}
+			else {
+				cref = ref;
+			}
+		}
+
+		if (nut == cref) return false;
+		if (nut.isnan() && cref.isnan()) return false; // (s)nan != (s)nan, so the regular equivalance test fails
+		if (ref == 0 && nut.iszero()) return false;    // mismatched is ignored as compiler optimizes away negative zero
+		return true;
+	}
+
+	template<typename Cfloat>
+	bool CfloatSubtractionCaseFails(const Cfloat& a, const Cfloat& b, Cfloat& nut, Cfloat& cref) {
+		constexpr bool isSaturating = Cfloat::isSaturating;
+		double ref = double(a) - double(b);  // make certain that IEEE doubles are sufficient as reference
+#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
+		// catching overflow
+		try {
+			nut = a - b;
+		}
+		catch (...) {
+			cref = ref;
+			return cref.inrange(ref);  // only overflow may throw
+		}
+#else
+		nut = a - b;
+#endif // CFLOAT_THROW_ARITHMETIC_EXCEPTION
+		if (a.isnan() || b.isnan()) {
+			// nan-type propagates
+			// if both are nan then signalling nan wins
+			// a        b   =   ref
+			// qnan    qnan = qnan
+			// qnan     #   = qnan
+			// #       qnan = qnan
+			// snan     #   = snan
+			// #       snan = snan
+			// snan    snan = snan
+			// snan    qnan = snan
+			// qnan    snan = snan
+			if (a.isnan(NAN_TYPE_SIGNALLING) || b.isnan(NAN_TYPE_SIGNALLING)) {
+				cref.setnan(NAN_TYPE_SIGNALLING);
+			}
+			else {
+				cref.setnan(NAN_TYPE_QUIET);
+			}
+		}
+		else if (a.isinf() || b.isinf()) {
+			// a      b  =  ref
+			// +inf +inf = snan
+			// +inf -inf = +inf
+			// -inf +inf = -inf
+			// -inf -inf = snan
+			if (a.isinf()) {
+				if (b.isinf()) {
+					if (a.sign() != b.sign()) {
+						cref.setinf(a.sign());
+					}
+					else {
+						cref.setnan(NAN_TYPE_SIGNALLING);
+					}
+				}
+				else {
+					cref.setinf(a.sign());
+				}
+			}
+			else {
+				cref.setinf(!b.sign());
+			}
+		}
+		else {
+			if (!nut.inrange(ref)) {
+				// the result of the subtraction is outside of the range
+				// of the NUT (number system under test)
+				if constexpr (isSaturating) {
+					if (ref > 0) cref.maxpos(); else cref.maxneg();
+				}
+				else {
+					cref.setinf(ref < 0);
+				}
+			}
+			else {
+				cref = ref;
+			}
+		}
+
+		if (nut == cref) return false;
+		if (nut.isnan() && cref.isnan()) return false; // (s)nan != (s)nan, so the regular equivalance test fails
+		if (ref == 0 && nut.iszero()) return false;    // mismatched is ignored as compiler optimizes away negative zero
+		return true;
+	}
+
+	template<typename Cfloat>
+	bool CfloatMultiplicationCaseFails(const Cfloat& a, const Cfloat& b, Cfloat& nut, Cfloat& cref) {
+		constexpr bool isSaturating = Cfloat::isSaturating;
+		double ref = double(a) * double(b);  // make certain that IEEE doubles are sufficient as reference
+#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
+		// catching overflow
+		try {
+			nut = a * b;
+		}
+		catch (...) {
+			cref = ref;
+			return cref.inrange(ref);  // only overflow may throw
+		}
+#else
+		nut = a * b;
+#endif // CFLOAT_THROW_ARITHMETIC_EXCEPTION
+		if (a.isnan() || b.isnan()) {
+			// nan-type propagates
+			if (a.isnan(NAN_TYPE_SIGNALLING) || b.isnan(NAN_TYPE_SIGNALLING)) {
+				cref.setnan(NAN_TYPE_SIGNALLING);
+			}
+			else {
+				cref.setnan(NAN_TYPE_QUIET);
+			}
+		}
+		else if (a.isinf() || b.isinf()) {
+			// a      b  =  ref
+			// +inf +inf = +inf
+			// +inf -inf = -inf
+			// -inf +inf = -inf
+			// -inf -inf = +inf
+			//  0   +inf = snan
+			// +inf  0   = snan
+			if (a.isinf()) {
+				if (b.iszero()) {
+					cref.setnan(NAN_TYPE_QUIET);
+				}
+				else {
+					cref.setinf(a.sign() != b.sign());
+				}
+			}
+			else {
+				if (a.iszero()) {
+					cref.setnan(NAN_TYPE_QUIET);
+				}
+				else {
+					cref.setinf(a.sign() != b.sign());
+				}
+			}
+		}
+		else {
+			if (!nut.inrange(ref)) {
+				// the result of the multiplication is outside of the range
+				// of the NUT (number system under test)
+				if constexpr (isSaturating) {
+					if (ref > 0) cref.maxpos(); else cref.maxneg();
+				}
+				else {
+					cref.setinf(ref < 0);
+				}
+			}
+			else {
+				cref = ref;
+			}
+		}
+
+		if (nut == cref) return false;
+		if (nut.isnan() && cref.isnan()) return false; // (s)nan != (s)nan, so the regular equivalance test fails
+		if (ref == 0 && nut.iszero()) return false;    // mismatched is ignored as compiler optimizes away negative zero
+		return true;
+	}
+
+	template<typename Cfloat>
+	bool CfloatDivisionCaseFails(const Cfloat& a, const Cfloat& b, Cfloat& nut, Cfloat& cref) {
+		constexpr bool isSaturating = Cfloat::isSaturating;
+		double ref = double(a) / double(b);  // make certain that IEEE doubles are sufficient as reference
+#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
+		// catching overflow
+		try {
+			nut = a / b;
+		}
+		catch (...) {
+			cref = ref;
+			return cref.inrange(ref);  // only overflow may throw
+		}
+#else
+		nut = a / b;
+#endif // CFLOAT_THROW_ARITHMETIC_EXCEPTION
+		bool resultSign = a.sign() != b.sign();
+		if (a.isnan() || b.isnan()) {
+			// nan-type propagates
+			if (a.isnan(NAN_TYPE_SIGNALLING) || b.isnan(NAN_TYPE_SIGNALLING)) {
+				cref.setnan(NAN_TYPE_SIGNALLING);
+			}
+			else {
+				cref.setnan(NAN_TYPE_QUIET);
+			}
+		}
+		else if (a.isinf() || b.isinf()) {
+			//     a /   b  =  ref
+			//     0 /  inf =  0 : 0b0.00000000.00000000000000000000000
+			//	   0 / -inf = -0 : 0b1.00000000.00000000000000000000000
+			//	   1 /  inf =  0 : 0b0.00000000.00000000000000000000000
+			//	   1 / -inf = -0 : 0b1.00000000.00000000000000000000000
+			//	 inf /    0 =  inf : 0b0.11111111.00000000000000000000000
+			//	 inf /   -0 = -inf : 0b1.11111111.00000000000000000000000
+			//	-inf /    0 = -inf : 0b1.11111111.00000000000000000000000
+			//	-inf /   -0 =  inf : 0b0.11111111.00000000000000000000000
+			//	 inf /  inf = -nan(ind) : 0b1.11111111.10000000000000000000000
+			//	 inf / -inf = -nan(ind) : 0b1.11111111.10000000000000000000000
+			//	-inf /  inf = -nan(ind) : 0b1.11111111.10000000000000000000000
+			//	-inf / -inf = -nan(ind) : 0b1.11111111.10000000000000000000000
+			if (a.isinf()) {
+				if (b.isinf()) {
+					cref.setnan(NAN_TYPE_QUIET);
+					cref.setsign(false);  // MSVC NaN/indeterminate
+				}
+				else {
+					cref.setinf(resultSign);
+				}
+			}
+			else {
+				cref.setzero();
+				cref.setsign(resultSign);
+			}
+		}
+		else {
+			if (!nut.inrange(ref)) {
+				// the result of the division is outside of the range
+				// of the NUT (number system under test)
+				if constexpr (isSaturating) {
+					if (ref > 0) cref.maxpos(); else cref.maxneg();
+				}
+				else {
+					cref.setinf(ref < 0);
+				}
+			}
+			else {
+				cref = ref;
+			}
+		}
+
+		if (nut == cref) return false;
+		if (nut.isnan() && cref.isnan()) return false; // (s)nan != (s)nan, so the regular equivalance test fails
+		if (ref == 0 && nut.iszero()) return false;    // mismatched is ignored as compiler optimizes away negative zero
+#ifdef FILTER_OUT_DIVIDE_BY_ZERO
+		if (b.iszero()) return false; // optimization alters nan(ind) and +-inf
+#endif
+		return true;
+	}
+
 	/// <summary>
 	/// Enumerate all addition cases for a number system configuration.
 	/// Uses doubles to create a reference to compare to.
@@ -1257,99 +1583,12 @@ namespace sw { namespace universal {
 		constexpr size_t NR_ENCODINGS = (size_t(1) << nbits);
 		int nrOfFailedTests = 0;
 
-		// set the saturation clamps
-		// Cfloat maxpos(sw::universal::SpecificValue::maxpos), maxneg(sw::universal::SpecificValue::maxneg);
-
-		double da, db, ref;  // make certain that IEEE doubles are sufficient as reference
 		Cfloat a{}, b{}, nut{}, cref{};
 		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
 			a.setbits(i); // number system concept requires a member function setbits()
-			if constexpr (hasSubnormals == false) if (a.isdenormal()) continue; // ignore subnormal encodings
-			da = double(a);
 			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
 				b.setbits(j);
-				if constexpr (hasSubnormals == false) if (b.isdenormal()) continue; // ignore subnormal encodings
-				db = double(b);
-				ref = da + db;
-#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
-				// catching overflow
-				try {
-					result = a + b;
-				}
-				catch (...) {
-					if (!nut.inrange(ref)) {
-						// correctly caught the overflow exception
-						continue;
-					}
-					else {
-						nrOfFailedTests++;
-					}
-				}
-#else
-				nut = a + b;
-				if (a.isnan() || b.isnan()) {
-					// nan-type propagates
-					// if both are nan then signalling nan wins
-					// a        b   =   ref
-					// qnan    qnan = qnan
-					// qnan     #   = qnan
-					// #       qnan = qnan
-					// snan     #   = snan
-					// #       snan = snan
-					// snan    snan = snan
-					// snan    qnan = snan
-					// qnan    snan = snan
-					if (a.isnan(NAN_TYPE_SIGNALLING) || b.isnan(NAN_TYPE_SIGNALLING)) {
-						cref.setnan(NAN_TYPE_SIGNALLING);
-					}
-					else {
-						cref.setnan(NAN_TYPE_QUIET);
-					}
-				}
-				else if (a.isinf() || b.isinf()) {
-					// a      b  =  ref
-					// +inf +inf = +inf
-					// +inf -inf = snan
-					// -inf +inf = snan
-					// -inf -inf = -inf
-					if (a.isinf()) {
-						if (b.isinf()) {
-							if (a.sign() == b.sign()) {
-								cref.setinf(a.sign());
-							}
-							else {
-								cref.setnan(NAN_TYPE_SIGNALLING);
-							}
-						}
-						else {
-							cref.setinf(a.sign());
-						}
-					}
-					else {
-						cref.setinf(b.sign());
-					}
-				}
-				else {
-					if (!nut.inrange(ref)) {
-						// the result of the addition is outside of the range
-						// of the NUT (number system under test)
-						if constexpr (isSaturating) {
-							if (ref > 0) cref.maxpos(); else cref.maxneg();
-						}
-						else {
-							cref.setinf(ref < 0);
-						}
-					}
-					else {
-						cref = ref;
-					}
-				}
-
-#endif // THROW_ARITHMETIC_EXCEPTION
-
-				if (nut != cref) {
-					if (nut.isnan() && cref.isnan()) continue; // (s)nan != (s)nan, so the regular equivalance test fails
-					if (ref == 0 && nut.iszero()) continue;    // mismatched is ignored as compiler optimizes away negative zero
+				if (CfloatAdditionCaseFails(a, b, nut, cref)) {
 					nrOfFailedTests++;
 					if (reportTestCases)	ReportBinaryArithmeticError("FAIL", "+", a, b, nut, cref);
 #ifdef TRACE_ROUNDING
@@ -1381,7 +1620,6 @@ namespace sw { namespace universal {
 				if (i % (NR_ENCODINGS / 25) == 0) std::cout << '.';
 			}
 		}
-//		std::cout << std::endl;
 		return nrOfFailedTests;
 	}
 
@@ -1394,109 +1632,23 @@ namespace sw { namespace universal {
 	/// <returns>nr of failed test cases</returns>
 	template<typename TestType>
 	int VerifyCfloatSubtraction(bool reportTestCases) {
-		constexpr size_t nbits = TestType::nbits;  // number system concept requires a static member indicating its size in bits
-		constexpr size_t es = TestType::es;
-		using BlockType = typename TestType::BlockType;
-		constexpr bool hasSubnormals = TestType::hasSubnormals;
+		constexpr size_t nbits         = TestType::nbits;  // number system concept requires a static member indicating its size in bits
+		constexpr size_t es            = TestType::es;
+		using BlockType                = typename TestType::BlockType;
+		constexpr bool hasSubnormals   = TestType::hasSubnormals;
 		constexpr bool hasSupernormals = TestType::hasSupernormals;
-		constexpr bool isSaturating = TestType::isSaturating;
+		constexpr bool isSaturating    = TestType::isSaturating;
 		using Cfloat = sw::universal::cfloat<nbits, es, BlockType, hasSubnormals, hasSupernormals, isSaturating>;
 
 		constexpr size_t NR_ENCODINGS = (size_t(1) << nbits);
 		int nrOfFailedTests = 0;
 
-		// set the saturation clamps
-		// Cfloat maxpos(sw::universal::SpecificValue::maxpos), maxneg(sw::universal::SpecificValue::maxneg);
-
-		double da, db, ref;  // make certain that IEEE doubles are sufficient as reference
 		Cfloat a{}, b{}, nut{}, cref{};
 		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
 			a.setbits(i); // number system concept requires a member function setbits()
-			da = double(a);
 			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
 				b.setbits(j);
-				db = double(b);
-				ref = da - db;
-#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
-				// catching overflow
-				try {
-					result = a - b;
-				}
-				catch (...) {
-					if (!nut.inrange(ref)) {
-						// correctly caught the overflow exception
-						continue;
-					}
-					else {
-						nrOfFailedTests++;
-					}
-				}
-
-#else
-				nut = a - b;
-				if (a.isnan() || b.isnan()) {
-					// nan-type propagates
-					// if both are nan then signalling nan wins
-					// a        b   =   ref
-					// qnan    qnan = qnan
-					// qnan     #   = qnan
-					// #       qnan = qnan
-					// snan     #   = snan
-					// #       snan = snan
-					// snan    snan = snan
-					// snan    qnan = snan
-					// qnan    snan = snan
-					if (a.isnan(NAN_TYPE_SIGNALLING) || b.isnan(NAN_TYPE_SIGNALLING)) {
-						cref.setnan(NAN_TYPE_SIGNALLING);
-					}
-					else {
-						cref.setnan(NAN_TYPE_QUIET);
-					}
-				}
-				else if (a.isinf() || b.isinf()) {
-					// a      b  =  ref
-					// +inf +inf = snan
-					// +inf -inf = +inf
-					// -inf +inf = -inf
-					// -inf -inf = snan
-					if (a.isinf()) {
-						if (b.isinf()) {
-							if (a.sign() != b.sign()) {
-								cref.setinf(a.sign());
-							}
-							else {
-								cref.setnan(NAN_TYPE_SIGNALLING);
-							}
-						}
-						else {
-							cref.setinf(a.sign());
-						}
-					}
-					else {
-						cref.setinf(!b.sign());
-					}
-				}
-				else {
-					if (!nut.inrange(ref)) {
-						// the result of the subtraction is outside of the range
-						// of the NUT (number system under test)
-						if constexpr (isSaturating) {
-							if (ref > 0) cref.maxpos(); else cref.maxneg();
-						}
-						else {
-							cref.setinf(ref < 0);
-						}
-					}
-					else {
-						cref = ref;
-					}
-				}
-
-#endif // THROW_ARITHMETIC_EXCEPTION
-
-				if (nut != cref) {
-					if (nut.isnan() && cref.isnan()) continue; // (s)nan != (s)nan, so the regular equivalance test fails
-					if (ref == 0 and nut.iszero()) continue; // mismatched is ignored as compiler optimizes away negative zero
+				if (CfloatSubtractionCaseFails(a, b, nut, cref)) {
 					nrOfFailedTests++;
 					if (reportTestCases)	ReportBinaryArithmeticError("FAIL", "-", a, b, nut, cref);
 #ifdef TRACE_ROUNDING
@@ -1528,7 +1680,6 @@ namespace sw { namespace universal {
 				if (i % (NR_ENCODINGS / 25) == 0) std::cout << '.';
 			}
 		}
-		//		std::cout << std::endl;
 		return nrOfFailedTests;
 	}
 
@@ -1541,101 +1692,23 @@ namespace sw { namespace universal {
 	/// <returns>nr of failed test cases</returns>
 	template<typename TestType>
 	int VerifyCfloatMultiplication(bool reportTestCases) {
-		constexpr size_t nbits = TestType::nbits;  // number system concept requires a static member indicating its size in bits
-		constexpr size_t es = TestType::es;
-		using BlockType = typename TestType::BlockType;
-		constexpr bool hasSubnormals = TestType::hasSubnormals;
+		constexpr size_t nbits         = TestType::nbits;  // number system concept requires a static member indicating its size in bits
+		constexpr size_t es            = TestType::es;
+		using BlockType                = typename TestType::BlockType;
+		constexpr bool hasSubnormals   = TestType::hasSubnormals;
 		constexpr bool hasSupernormals = TestType::hasSupernormals;
-		constexpr bool isSaturating = TestType::isSaturating;
+		constexpr bool isSaturating    = TestType::isSaturating;
 		using Cfloat = sw::universal::cfloat<nbits, es, BlockType, hasSubnormals, hasSupernormals, isSaturating>;
 
 		constexpr size_t NR_ENCODINGS = (size_t(1) << nbits);
 		int nrOfFailedTests = 0;
 
-		// set the saturation clamps
-		// Cfloat maxpos(sw::universal::SpecificValue::maxpos), maxneg(sw::universal::SpecificValue::maxneg);
-
-		double da, db, ref;  // make certain that IEEE doubles are sufficient as reference
 		Cfloat a{}, b{}, nut{}, cref{};
 		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
 			a.setbits(i); // number system concept requires a member function setbits()
-			da = double(a);
 			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
 				b.setbits(j);
-				db = double(b);
-				ref = da * db;
-#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
-				// catching overflow
-				try {
-					result = a * b;
-				}
-				catch (...) {
-					if (!nut.inrange(ref)) {
-						// correctly caught the overflow exception
-						continue;
-					}
-					else {
-						nrOfFailedTests++;
-					}
-				}
-
-#else
-				nut = a * b;
-				if (a.isnan() || b.isnan()) {
-					// nan-type propagates
-					if (a.isnan(NAN_TYPE_SIGNALLING) || b.isnan(NAN_TYPE_SIGNALLING)) {
-						cref.setnan(NAN_TYPE_SIGNALLING);
-					}
-					else {
-						cref.setnan(NAN_TYPE_QUIET);
-					}
-				}
-				else if (a.isinf() || b.isinf()) {
-					// a      b  =  ref
-					// +inf +inf = +inf
-					// +inf -inf = -inf
-					// -inf +inf = -inf
-					// -inf -inf = +inf
-					//  0   +inf = snan
-					// +inf  0   = snan
-					if (a.isinf()) {
-						if (b.iszero()) {
-							cref.setnan(NAN_TYPE_QUIET);
-						}
-						else {
-							cref.setinf(a.sign() != b.sign());
-						}
-					}
-					else {
-						if (a.iszero()) {
-							cref.setnan(NAN_TYPE_QUIET);
-						}
-						else {
-							cref.setinf(a.sign() != b.sign());
-						}
-					}
-				}
-				else {
-					if (!nut.inrange(ref)) {
-						// the result of the multiplication is outside of the range
-						// of the NUT (number system under test)
-						if constexpr (isSaturating) {
-							if (ref > 0) cref.maxpos(); else cref.maxneg();
-						}
-						else {
-							cref.setinf(ref < 0);
-						}
-					}
-					else {
-						cref = ref;
-					}
-				}
-
-#endif // THROW_ARITHMETIC_EXCEPTION
-
-				if (nut != cref) {
-					if (nut.isnan() && cref.isnan()) continue; // (s)nan != (s)nan, so the regular equivalance test fails
-					if (ref == 0 and nut.iszero()) continue; // mismatched is ignored as compiler optimizes away negative zero
+				if (CfloatMultiplicationCaseFails(a, b, nut, cref)) {
 					nrOfFailedTests++;
 					if (reportTestCases)	ReportBinaryArithmeticError("FAIL", "*", a, b, nut, cref);
 #ifdef TRACE_ROUNDING
@@ -1667,17 +1740,9 @@ namespace sw { namespace universal {
 				if (i % (NR_ENCODINGS / 25) == 0) std::cout << '.';
 			}
 		}
-		//		std::cout << std::endl;
 		return nrOfFailedTests;
 	}
 
-// optimizing compilers manipulate NaN(ind) and the sign of infinite on a division by zero
-// when defined, this compiler guard adds a filter to the CFLOAT division test regression
-// to filter out these discrepancies. In debug builds, the compiler is compliant and you
-// can undefine this guard and add the test comparisons for divide by zero to catch any
-// errors that the implementation might have.
-#define FILTER_OUT_DIVIDE_BY_ZERO
-
 	/// <summary>
 	/// Enumerate all division cases for a cfloat configuration.
 	/// Uses doubles to create a reference to compare to.
@@ -1698,97 +1763,12 @@ namespace sw { namespace universal {
 		constexpr size_t NR_ENCODINGS = (size_t(1) << nbits);
 		int nrOfFailedTests = 0;
 
-		// set the saturation clamps
-		// Cfloat maxpos(sw::universal::SpecificValue::maxpos), maxneg(sw::universal::SpecificValue::maxneg);
-
-		double da, db, ref;  // make certain that IEEE doubles are sufficient as reference
 		Cfloat a{}, b{}, nut{}, cref{};
 		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
 			a.setbits(i); // number system concept requires a member function setbits()
-			da = double(a);
 			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
 				b.setbits(j);
-				db = double(b);
-				ref = da / db;
-#if CFLOAT_THROW_ARITHMETIC_EXCEPTION
-				// catching overflow
-				try {
-					nut = a / b;
-				}
-				catch (...) {
-					if (!nut.inrange(ref)) {
-						// correctly caught the overflow exception
-						continue;
-					}
-					else {
-						nrOfFailedTests++;
-					}
-				}
-
-#else
-				nut = a / b;
-				bool resultSign = a.sign() != b.sign();
-				if (a.isnan() || b.isnan()) {
-					// nan-type propagates
-					if (a.isnan(NAN_TYPE_SIGNALLING) || b.isnan(NAN_TYPE_SIGNALLING)) {
-						cref.setnan(NAN_TYPE_SIGNALLING);
-					}
-					else {
-						cref.setnan(NAN_TYPE_QUIET);
-					}
-				}
-				else if (a.isinf() || b.isinf()) {
-					//     a /   b  =  ref
-					//     0 /  inf =  0 : 0b0.00000000.00000000000000000000000
-					//	   0 / -inf = -0 : 0b1.00000000.00000000000000000000000
-					//	   1 /  inf =  0 : 0b0.00000000.00000000000000000000000
-					//	   1 / -inf = -0 : 0b1.00000000.00000000000000000000000
-					//	 inf /    0 =  inf : 0b0.11111111.00000000000000000000000
-					//	 inf /   -0 = -inf : 0b1.11111111.00000000000000000000000
-					//	-inf /    0 = -inf : 0b1.11111111.00000000000000000000000
-					//	-inf /   -0 =  inf : 0b0.11111111.00000000000000000000000
-					//	 inf /  inf = -nan(ind) : 0b1.11111111.10000000000000000000000
-					//	 inf / -inf = -nan(ind) : 0b1.11111111.10000000000000000000000
-					//	-inf /  inf = -nan(ind) : 0b1.11111111.10000000000000000000000
-					//	-inf / -inf = -nan(ind) : 0b1.11111111.10000000000000000000000
-					if (a.isinf()) {
-						if (b.isinf()) {
-							cref.setnan(NAN_TYPE_QUIET);
-							cref.setsign(false);  // MSVC NaN/indeterminate
-						}
-						else {
-							cref.setinf(resultSign);
-						}
-					}
-					else {
-						cref.setzero();
-						cref.setsign(resultSign);
-					}
-				}
-				else {
-					if (!nut.inrange(ref)) {
-						// the result of the division is outside of the range
-						// of the NUT (number system under test)
-						if constexpr (isSaturating) {
-							if (ref > 0) cref.maxpos(); else cref.maxneg();
-						}
-						else {
-							cref.setinf(ref < 0);
-						}
-					}
-					else {
-						cref = ref;
-					}
-				}
-
-#endif // CFLOAT_THROW_ARITHMETIC_EXCEPTION
-
-				if (nut != cref) {
-					if (nut.isnan() && cref.isnan()) continue; // (s)nan != (s)nan, so the regular equivalance test fails
-					if (ref == 0 and nut.iszero()) continue; // mismatched is ignored as compiler optimizes away negative zero
-#ifdef FILTER_OUT_DIVIDE_BY_ZERO
-					if (b.iszero()) continue; // optimization alters nan(ind) and +-inf
-#endif
+				if (CfloatDivisionCaseFails(a, b, nut, cref)) {
 					nrOfFailedTests++;
 					if (reportTestCases)	ReportBinaryArithmeticError("FAIL", "/", a, b, nut, cref);
 #ifdef TRACE_ROUNDING
@@ -1820,7 +1800,6 @@ namespace sw { namespace universal {
 				if (i % (NR_ENCODINGS / 25) == 0) std::cout << '.';
 			}
 		}
-		//		std::cout << std::endl;
 		return nrOfFailedTests;
 	}
 
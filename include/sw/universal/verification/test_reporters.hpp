@@ -154,11 +154,11 @@ void ReportArithmeticShiftSuccess(const std::string& label, const std::string& o
 }
 
 template<typename InputType, typename ResultType, typename RefType>
-void ReportBinaryArithmeticError(const std::string& label, const std::string& op, 
+void ReportBinaryArithmeticError(std::ostream& ostr, const std::string& label, const std::string& op, 
 	const InputType& lhs, const InputType& rhs, const ResultType& result, const RefType& ref) {
 	using namespace sw::universal;
-	auto old_precision = std::cerr.precision();
-	std::cerr << std::setprecision(20)
+	auto old_precision = ostr.precision();
+	ostr << std::setprecision(20)
 		<< label << '\n'
 		<< std::setw(NUMBER_COLUMN_WIDTH) << lhs
 		<< " " << op << " "
@@ -179,6 +179,12 @@ void ReportBinaryArithmeticError(const std::string& label, const std::string& op
 		<< '\n';
 }
 
+template<typename InputType, typename ResultType, typename RefType>
+void ReportBinaryArithmeticError(const std::string& label, const std::string& op, 
+	const InputType& lhs, const InputType& rhs, const ResultType& result, const RefType& ref) {
+	ReportBinaryArithmeticError(std::cerr, label, op, lhs, rhs, result, ref);
+}
+
 template<typename TestType, typename ResultType, typename RefType>
 void ReportBinaryArithmeticSuccess(const std::string& label, const std::string& op, const TestType& lhs, const TestType& rhs, const ResultType& result, const RefType& ref) {
 	auto old_precision = std::cerr.precision();
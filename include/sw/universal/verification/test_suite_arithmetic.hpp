@@ -22,6 +22,7 @@
 #include <universal/number/shared/specific_value_encoding.hpp>
 #include <universal/verification/test_status.hpp>
 #include <universal/verification/test_reporters.hpp>  // error/success reporting
+#include <universal/verification/test_suite_binary_cases.hpp>
 
 namespace sw { namespace universal {
 
@@ -74,44 +75,16 @@ int VerifyAddition(bool reportTestCases) {
 	constexpr size_t NR_VALUES = (size_t(1) << nbits);
 	int nrOfFailedTests = 0;
 
-	// set the saturation clamps
-	TestType maxpos(SpecificValue::maxpos), maxneg(SpecificValue::maxneg);
-
-	double da, db, ref;  // make certain that IEEE doubles are sufficient as reference
-	TestType a, b, c, cref;
+	double ref;
+	TestType a, b, c;
 	for (size_t i = 0; i < NR_VALUES; i++) {
 		a.setbits(i); // number system concept requires a member function setbits()
-		da = double(a);
 		for (size_t j = 0; j < NR_VALUES; j++) {
 			b.setbits(j);
-			db = double(b);
-			ref = da + db;
-#if THROW_ARITHMETIC_EXCEPTION
-			// catching overflow
-			try {
-				c = a + b;
-			}
-			catch (...) {
-				if (ref < double(maxneg) || ref > double(maxpos)) {
-					// correctly caught the overflow exception
-					continue;
-				}
-				else {
-					nrOfFailedTests++;
-				}
-			}
-#else
-			c = a + b;
-#endif // THROW_ARITHMETIC_EXCEPTION
-			cref = ref;
-			if (c != cref) {
-				if (ref == 0 and c.iszero()) continue; // mismatched is ignored as compiler optimizes away negative zero
+			if (AdditionCaseFails(a, b, c, ref)) {
 				nrOfFailedTests++;
 				if (reportTestCases)	ReportBinaryArithmeticError("FAIL", "+", a, b, c, ref);
 			}
-			else {
-				//if (reportTestCases) ReportBinaryArithmeticSuccess("PASS", "+", a, b, c, ref);
-			}
 		}
 		if constexpr (NR_VALUES > 256 * 256) {
 			if (i % (NR_VALUES / 25) == 0) std::cout << '.';
@@ -197,44 +170,16 @@ int VerifySubtraction(bool reportTestCases) {
 	constexpr size_t NR_VALUES = (size_t(1) << nbits);
 	int nrOfFailedTests = 0;
 
-	// set the saturation clamps
-	TestType maxpos(SpecificValue::maxpos), maxneg(SpecificValue::maxneg);
-
-	double da, db, ref;  // make certain that IEEE doubles are sufficient as reference
-	TestType a, b, c, cref;
+	double ref;
+	TestType a, b, c;
 	for (size_t i = 0; i < NR_VALUES; i++) {
 		a.setbits(i); // number system concept requires a member function setbits()
-		da = double(a);
 		for (size_t j = 0; j < NR_VALUES; j++) {
 			b.setbits(j);
-			db = double(b);
-			ref = da - db;
-#if THROW_ARITHMETIC_EXCEPTION
-			// catching overflow
-			try {
-				c = a - b;
-			}
-			catch (...) {
-				if (ref < double(maxneg) || ref > double(maxpos)) {
-					// correctly caught the overflow exception
-					continue;
-				}
-				else {
-					nrOfFailedTests++;
-				}
-			}
-#else
-			c = a - b;
-#endif // THROW_ARITHMETIC_EXCEPTION
-			cref = ref;
-			if (c != cref) {
-				if (ref == 0 and c.iszero()) continue; // mismatched is ignored as compiler optimizes away negative zero
+			if (SubtractionCaseFails(a, b, c, ref)) {
 				nrOfFailedTests++;
 				if (reportTestCases)	ReportBinaryArithmeticError("FAIL", "-", a, b, c, ref);
 			}
-			else {
-				//if (reportTestCases) ReportBinaryArithmeticSuccess("PASS", "-", a, b, c, ref);
-			}
 			if (nrOfFailedTests > 9) return nrOfFailedTests;
 		}
 		if constexpr (NR_VALUES > 256 * 256) {
@@ -321,39 +266,16 @@ int VerifyMultiplication(bool reportTestCases) {
 	const unsigned NR_VALUES = (unsigned(1) << nbits);
 	int nrOfFailedTests = 0;
 
-	TestType a, b, c, cref;
+	double ref;
+	TestType a, b, c;
 	for (unsigned i = 0; i < NR_VALUES; i++) {
 		a.setbits(i);
-		double da = double(a);
 		for (unsigned j = 0; j < NR_VALUES; j++) {
 			b.setbits(j);
-			double db = double(b);
-			double ref = da * db; // make certain that IEEE doubles are sufficient as reference
-#if THROW_ARITHMETIC_EXCEPTION
-			try {
-				c = a * b;
-			}
-			catch (...) {
-				if (a.isnan() || b.isnan()) {
-					// correctly caught the exception
-					c.setnan(true); // TODO: unify quiet vs signalling propagation among real number systems
-					// posits behave differently than floats, so this may need a least common denominator approach
-				}
-				else {
-					throw;  // rethrow
-				}
-			}
-#else
-			c = a * b;
-#endif
-			cref = ref;
-			if (c != cref) {
+			if (MultiplicationCaseFails(a, b, c, ref)) {
 				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "*", a, b, c, ref);
 				nrOfFailedTests++;
 			}
-			else {
-				//if (reportTestCases) ReportBinaryArithmeticSuccess("PASS", "*", a, b, c, ref);
-			}
 		}
 	}
 	return nrOfFailedTests;
@@ -425,45 +347,16 @@ int VerifyDivision(bool reportTestCases) {
 	const unsigned NR_VALUES = (unsigned(1) << nbits);
 	int nrOfFailedTests = 0;
 
-	TestType a, b, c, cref;
+	double ref;
+	TestType a, b, c;
 	for (unsigned i = 0; i < NR_VALUES; i++) {
 		a.setbits(i);
-		double da = double(a);
 		for (unsigned j = 0; j < NR_VALUES; j++) {
 			b.setbits(j);
-			double db = double(b);
-			double ref{ 0 }; // make certain that IEEE doubles are sufficient as reference
-#if THROW_ARITHMETIC_EXCEPTION
-			try {
-				c = a / b;
-				ref = da / db;
-			}
-			catch (...) {
-				if (b.iszero()) {
-					// correctly caught the exception
-					c.setnan(true); // TODO: unify quiet vs signalling propagation among real number systems
-					// posits behave differently than floats, so this may need a least common denominator approach
-				}
-				else if (a.isnan() || b.isnan()) {
-					// Universal will throw a divide_by_nar or numerator_is_nar exception for posits
-					c.setnan(true); // TODO: unify quiet vs signalling propagation among real number systems
-				}
-				else {
-					throw;  // rethrow
-				}
-			}
-#else
-			c = a / b;
-			ref = da / db;
-#endif
-			cref = ref;
-			if (c != cref) {
-				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "*", a, b, c, ref);
+			if (DivisionCaseFails(a, b, c, ref)) {
+				if (reportTestCases) ReportBinaryArithmeticError("FAIL", "/", a, b, c, ref);
 				nrOfFailedTests++;
 			}
-			else {
-				//if (reportTestCases) ReportBinaryArithmeticSuccess("PASS", "*", a, b, c, ref);
-			}
 		}
 	}
 	return nrOfFailedTests;
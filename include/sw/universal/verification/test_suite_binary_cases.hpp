@@ -0,0 +1,122 @@
+#pragma once
+// test_suite_binary_cases.hpp : per operand pair acceptance rules of the exhaustive binary operator test suites
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+
+// same calling environment prerequisite as the sequential arithmetic test suite
+#ifndef THROW_ARITHMETIC_EXCEPTION
+#define THROW_ARITHMETIC_EXCEPTION 1
+#endif
+
+#include <universal/number/shared/specific_value_encoding.hpp>
+
+namespace sw { namespace universal {
+
+///////////////////////////////////////////////////////////////////////////////////////
+///                    PER OPERAND PAIR ACCEPTANCE RULES                            ///
+///////////////////////////////////////////////////////////////////////////////////////
+
+// The exhaustive binary operator suites, the sequential ones of test_suite_arithmetic.hpp and
+// the parallel ones of test_suite_parallel.hpp, share these rules: each computes c = a op b
+// and its double reference ref, and returns true when c is a failure.
+
+// NaN encodings do not compare equal, so a NaN result matches a NaN reference
+template<typename TestType>
+bool BinaryResultDiffers(const TestType& c, const TestType& cref) {
+	if (c == cref) return false;
+	if constexpr (requires { c.isnan(); }) {
+		if (c.isnan() && cref.isnan()) return false;
+	}
+	return true;
+}
+
+template<typename TestType>
+bool AdditionCaseFails(const TestType& a, const TestType& b, TestType& c, double& ref) {
+	ref = double(a) + double(b);  // make certain that IEEE doubles are sufficient as reference
+#if THROW_ARITHMETIC_EXCEPTION
+	try {
+		c = a + b;
+	}
+	catch (...) {
+		// only overflow may throw
+		return !(ref < double(TestType(SpecificValue::maxneg)) || ref > double(TestType(SpecificValue::maxpos)));
+	}
+#else
+	c = a + b;
+#endif // THROW_ARITHMETIC_EXCEPTION
+	TestType cref = ref;
+	if (!BinaryResultDiffers(c, cref)) return false;
+	return !(ref == 0 && c.iszero());  // mismatched is ignored as compiler optimizes away negative zero
+}
+
+template<typename TestType>
+bool SubtractionCaseFails(const TestType& a, const TestType& b, TestType& c, double& ref) {
+	ref = double(a) - double(b);
+#if THROW_ARITHMETIC_EXCEPTION
+	try {
+		c = a - b;
+	}
+	catch (...) {
+		// only overflow may throw
+		return !(ref < double(TestType(SpecificValue::maxneg)) || ref > double(TestType(SpecificValue::maxpos)));
+	}
+#else
+	c = a - b;
+#endif // THROW_ARITHMETIC_EXCEPTION
+	TestType cref = ref;
+	if (!BinaryResultDiffers(c, cref)) return false;
+	return !(ref == 0 && c.iszero());  // mismatched is ignored as compiler optimizes away negative zero
+}
+
+template<typename TestType>
+bool MultiplicationCaseFails(const TestType& a, const TestType& b, TestType& c, double& ref) {
+	ref = double(a) * double(b);
+#if THROW_ARITHMETIC_EXCEPTION
+	try {
+		c = a * b;
+	}
+	catch (...) {
+		if (a.isnan() || b.isnan()) {
+			// correctly caught the exception
+			c = TestType(SpecificValue::snan); // TODO: unify quiet vs signalling propagation among real number systems
+		}
+		else {
+			throw;  // rethrow
+		}
+	}
+#else
+	c = a * b;
+#endif
+	TestType cref = ref;
+	return BinaryResultDiffers(c, cref);
+}
+
+template<typename TestType>
+bool DivisionCaseFails(const TestType& a, const TestType& b, TestType& c, double& ref) {
+	ref = 0;
+#if THROW_ARITHMETIC_EXCEPTION
+	try {
+		c = a / b;
+		ref = double(a) / double(b);
+	}
+	catch (...) {
+		if (b.iszero() || a.isnan() || b.isnan()) {
+			// correctly caught the exception: Universal throws a divide_by_nar or numerator_is_nar exception for posits
+			c = TestType(SpecificValue::snan); // TODO: unify quiet vs signalling propagation among real number systems
+		}
+		else {
+			throw;  // rethrow
+		}
+	}
+#else
+	c = a / b;
+	ref = double(a) / double(b);
+#endif
+	TestType cref = ref;
+	return BinaryResultDiffers(c, cref);
+}
+
+}} // namespace sw::universal
@@ -0,0 +1,167 @@
+#pragma once
+// test_suite_parallel.hpp : parallel and sharded exhaustive arithmetic verification
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+// same calling environment prerequisite as the sequential arithmetic test suite
+#ifndef THROW_ARITHMETIC_EXCEPTION
+#define THROW_ARITHMETIC_EXCEPTION 1
+#endif
+
+#include <universal/number/shared/specific_value_encoding.hpp>
+#include <universal/verification/test_reporters.hpp>
+#include <universal/verification/test_suite_binary_cases.hpp>
+#include <universal/utility/thread_pool.hpp>
+
+namespace sw { namespace universal {
+
+/*
+ * The exhaustive binary operator tests enumerate NR_VALUES x NR_VALUES operand pairs.
+ * The parallel driver hands out the rows of the outer loop, one encoding of the left
+ * operand per task, to a thread pool. The failure count and the failure reports of each
+ * row are recorded separately and merged in row order, so the result and the output do
+ * not depend on the number of threads or on the scheduling.
+ *
+ * A run can also be split across processes or machines: shard i of N verifies the
+ * contiguous block of rows [i*NR_VALUES/N, (i+1)*NR_VALUES/N), and the N shards together
+ * cover every operand pair exactly once.
+ */
+struct VerificationShard {
+	size_t index{ 0 };
+	size_t count{ 1 };
+};
+
+// parse a shard specification of the form "i/N" with 0 <= i < N
+inline VerificationShard ParseShard(const std::string& spec) {
+	VerificationShard shard;
+	size_t slash = spec.find('/');
+	if (slash == std::string::npos) throw std::invalid_argument("shard specification must be i/N: " + spec);
+	char* end{ nullptr };
+	std::string index = spec.substr(0, slash), count = spec.substr(slash + 1);
+	shard.index = std::strtoull(index.c_str(), &end, 10);
+	if (index.empty() || *end != '\0') throw std::invalid_argument("shard index is not a number: " + spec);
+	shard.count = std::strtoull(count.c_str(), &end, 10);
+	if (count.empty() || *end != '\0') throw std::invalid_argument("shard count is not a number: " + spec);
+	if (shard.count == 0 || shard.index >= shard.count) throw std::invalid_argument("shard index must be in [0, N): " + spec);
+	return shard;
+}
+
+// pick up --shard i/N or --shard=i/N from the command line, the default is the whole range
+inline VerificationShard ParseShardArgument(int argc, char* argv[]) {
+	VerificationShard shard;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg(argv[i]);
+		if (arg == "--shard") {
+			if (i + 1 >= argc) throw std::invalid_argument("--shard requires an argument of the form i/N");
+			shard = ParseShard(argv[++i]);
+		}
+		else if (arg.rfind("--shard=", 0) == 0) {
+			shard = ParseShard(arg.substr(8));
+		}
+	}
+	return shard;
+}
+
+/// <summary>
+/// enumerate all operand pairs of the rows that belong to the shard, in parallel
+/// </summary>
+/// <typeparam name="TestType">the number system type to verify</typeparam>
+/// <typeparam name="RefType">the type of the reference the check produces, double or TestType</typeparam>
+/// <param name="op">operator symbol used in the failure reports</param>
+/// <param name="check">check(a, b, c, ref) computes c and its reference ref, and returns true when c is wrong</param>
+/// <param name="reportTestCases">if yes, report on individual test failures</param>
+/// <param name="shard">the block of rows to verify</param>
+/// <param name="nrThreads">0 selects the hardware concurrency</param>
+/// <param name="reportLimit">maximum number of individual failures reported, the remainder is only counted</param>
+/// <returns>number of failed test cases</returns>
+template<typename TestType, typename RefType = double, typename BinaryCheck>
+int VerifyBinaryOperatorInParallel(const std::string& op, BinaryCheck check, bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0, size_t reportLimit = 100) {
+	constexpr size_t nbits = TestType::nbits;
+	static_assert(nbits <= 24, "exhaustive enumeration of operand pairs is limited to 24-bit encodings");
+	constexpr size_t NR_VALUES = (size_t(1) << nbits);
+	size_t firstRow = shard.index * NR_VALUES / shard.count;
+	size_t lastRow = (shard.index + 1) * NR_VALUES / shard.count;
+	size_t nrRows = lastRow - firstRow;
+
+	// no row keeps more reports than can be printed
+	std::vector<int> failures(nrRows, 0);
+	std::vector<std::vector<std::string>> reports(reportTestCases ? nrRows : 0);
+	auto row = [&](size_t r) {
+		TestType a, b, c;
+		a.setbits(firstRow + r);
+		int nrOfFailedTests = 0;
+		for (size_t j = 0; j < NR_VALUES; ++j) {
+			b.setbits(j);
+			RefType ref{};
+			if (check(a, b, c, ref)) {
+				++nrOfFailedTests;
+				if (reportTestCases && reports[r].size() < reportLimit) {
+					std::ostringstream report;
+					ReportBinaryArithmeticError(report, "FAIL", op, a, b, c, ref);
+					reports[r].push_back(report.str());
+				}
+			}
+		}
+		failures[r] = nrOfFailedTests;
+	};
+	if (nrThreads == 0) {
+		default_thread_pool().parallel_for(nrRows, row);
+	}
+	else {
+		thread_pool pool(nrThreads);
+		pool.parallel_for(nrRows, row);
+	}
+
+	// deterministic merge in row order
+	int nrOfFailedTests = 0;
+	size_t nrOfReports = 0;
+	for (size_t r = 0; r < nrRows; ++r) {
+		nrOfFailedTests += failures[r];
+		if (reportTestCases) {
+			for (const std::string& report : reports[r]) {
+				if (nrOfReports == reportLimit) break;
+				std::cerr << report;
+				++nrOfReports;
+			}
+		}
+	}
+	if (reportTestCases && size_t(nrOfFailedTests) > nrOfReports) {
+		std::cerr << "FAIL: " << (size_t(nrOfFailedTests) - nrOfReports) << " more failures of operator " << op << " not reported\n";
+	}
+	return nrOfFailedTests;
+}
+
+// the per operand pair checks of test_suite_binary_cases.hpp are the acceptance rules of the sequential
+// VerifyAddition, VerifySubtraction, VerifyMultiplication, and VerifyDivision of test_suite_arithmetic.hpp
+
+template<typename TestType>
+int VerifyAdditionInParallel(bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0, size_t reportLimit = 100) {
+	return VerifyBinaryOperatorInParallel<TestType>("+", AdditionCaseFails<TestType>, reportTestCases, shard, nrThreads, reportLimit);
+}
+
+template<typename TestType>
+int VerifySubtractionInParallel(bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0, size_t reportLimit = 100) {
+	return VerifyBinaryOperatorInParallel<TestType>("-", SubtractionCaseFails<TestType>, reportTestCases, shard, nrThreads, reportLimit);
+}
+
+template<typename TestType>
+int VerifyMultiplicationInParallel(bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0, size_t reportLimit = 100) {
+	return VerifyBinaryOperatorInParallel<TestType>("*", MultiplicationCaseFails<TestType>, reportTestCases, shard, nrThreads, reportLimit);
+}
+
+template<typename TestType>
+int VerifyDivisionInParallel(bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0, size_t reportLimit = 100) {
+	return VerifyBinaryOperatorInParallel<TestType>("/", DivisionCaseFails<TestType>, reportTestCases, shard, nrThreads, reportLimit);
+}
+
+}} // namespace sw::universal
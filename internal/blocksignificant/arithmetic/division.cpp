@@ -27,10 +27,8 @@ void TestMostSignificantBit() {
 	}
 }
 
-// TODO: blocksignificant div is failing, currently regression testing is disabled
-// 
 // Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
-#define MANUAL_TESTING 1
+#define MANUAL_TESTING 0
 // REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
 // It is the responsibility of the regression test to organize the tests in a quartile progression.
 //#undef REGRESSION_LEVEL_OVERRIDE
@@ -81,12 +79,19 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<6, uint8_t> >(reportTestCases), "blocksignificant<6,uint8_t>", "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<7, uint8_t> >(reportTestCases), "blocksignificant<7,uint8_t>", "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<8, uint8_t> >(reportTestCases), "blocksignificant<8,uint8_t>", "division");
+
+	// divider significant of a half-precision cfloat: 2 + 3*fbits + 4
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<36, uint32_t> >(reportTestCases), "blocksignificant<36,uint32_t>", "division");
 #endif
 
 #if REGRESSION_LEVEL_2
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<9, uint8_t> >(reportTestCases), "blocksignificant<9,uint8_t>", "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<10, uint8_t> >(reportTestCases), "blocksignificant<10,uint8_t>", "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<12, uint8_t> >(reportTestCases), "blocksignificant<12,uint8_t>", "division");
+
+	// divider significant of a single-precision cfloat
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<75, uint8_t> >(reportTestCases), "blocksignificant<75,uint8_t>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<75, uint32_t> >(reportTestCases), "blocksignificant<75,uint32_t>", "division");
 #endif
 
 #if REGRESSION_LEVEL_3
@@ -100,6 +105,10 @@ try {
 #if REGRESSION_LEVEL_4
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<16, uint8_t> >(reportTestCases), "blocksignificant<16,uint8_t>", "division");
 	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<16, uint16_t> >(reportTestCases), "blocksignificant<16,uint16_t>", "division");
+
+	// divider significant of a double-precision cfloat
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<162, uint32_t> >(reportTestCases), "blocksignificant<162,uint32_t>", "division");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockSignificantDivision< blocksignificant<162, uint64_t> >(reportTestCases), "blocksignificant<162,uint64_t>", "division");
 #endif
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
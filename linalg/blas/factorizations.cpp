@@ -0,0 +1,408 @@
+// factorizations.cpp: blocked LU with partial pivoting, blocked Householder QR, and one-sided Jacobi SVD
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <blas/blas.hpp>
+#include <blas/ext/solvers/fused_lu.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// random N x N matrix with elements in [-1, 1]
+template<typename Scalar>
+sw::numeric::containers::matrix<Scalar> RandomMatrix(size_t rows, size_t cols, unsigned seed) {
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	sw::numeric::containers::matrix<Scalar> A(rows, cols);
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < cols; ++j) A(i, j) = Scalar(distribution(generator));
+	}
+	return A;
+}
+
+// max |P A - L U| relative to max |A|, evaluated in double
+template<typename Scalar, typename Factorization>
+double FactorizationResidual(const sw::numeric::containers::matrix<Scalar>& A, const Factorization& lup) {
+	size_t N = num_rows(A);
+	auto L = lup.L();
+	auto U = lup.U();
+	auto perm = lup.permutation();
+	double residual{ 0 }, norm{ 0 };
+	for (size_t i = 0; i < N; ++i) {
+		for (size_t j = 0; j < N; ++j) {
+			double lu{ 0 };
+			for (size_t p = 0; p <= std::min(i, j); ++p) lu += double(L(i, p)) * double(U(p, j));
+			residual = std::max(residual, std::abs(double(A(perm[i], j)) - lu));
+			norm = std::max(norm, std::abs(double(A(i, j))));
+		}
+	}
+	return residual / norm;
+}
+
+// max |A x - b| relative to max |b|, evaluated in double
+template<typename Scalar>
+double SolutionResidual(const sw::numeric::containers::matrix<Scalar>& A, const sw::numeric::containers::vector<Scalar>& x, const sw::numeric::containers::vector<Scalar>& b) {
+	size_t N = num_rows(A);
+	double residual{ 0 }, norm{ 0 };
+	for (size_t i = 0; i < N; ++i) {
+		double ax{ 0 };
+		for (size_t j = 0; j < N; ++j) ax += double(A(i, j)) * double(x[j]);
+		residual = std::max(residual, std::abs(ax - double(b[i])));
+		norm = std::max(norm, std::abs(double(b[i])));
+	}
+	return residual / norm;
+}
+
+// factor and solve random systems across block sizes that do and do not divide N
+template<typename Scalar, typename Factorization = sw::blas::solvers::LUP<Scalar>>
+int VerifyBlockedLU(bool reportTestCases, double tolerance) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	const size_t sizes[] = { 1, 5, 16, 67, 100 };
+	const size_t blocks[] = { 1, 8, 64 };
+	unsigned seed = 1;
+	for (size_t N : sizes) {
+		for (size_t nb : blocks) {
+			matrix<Scalar> A = RandomMatrix<Scalar>(N, N, seed++);
+			Factorization lup(A, nb, 1);
+			if (lup.singular()) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: N = " << N << " block size " << nb << " reported singular\n";
+				continue;
+			}
+			double r = FactorizationResidual(A, lup);
+			if (r > tolerance * double(N)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: N = " << N << " block size " << nb << " |PA - LU| = " << r << '\n';
+			}
+			vector<Scalar> b(N);
+			for (size_t i = 0; i < N; ++i) b[i] = Scalar(double(i % 7) - 3.0);
+			vector<Scalar> x = lup.solve(b);
+			double s = SolutionResidual(A, x, b);
+			if (s > tolerance * double(N) * 100.0) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: N = " << N << " block size " << nb << " |Ax - b| = " << s << '\n';
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the factors do not depend on the number of threads, and multiple right-hand sides match the single solves
+template<typename Scalar>
+int VerifyReproducibility(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas::solvers;
+	int nrOfFailedTests = 0;
+	const size_t N = 150;
+	matrix<Scalar> A = RandomMatrix<Scalar>(N, N, 42);
+	LUP<Scalar> serial(A, 16, 1);
+	LUP<Scalar> threaded(A, 16, 3);
+	if (serial.LU() != threaded.LU() || serial.pivots() != threaded.pivots()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: factors depend on the number of threads\n";
+	}
+	matrix<Scalar> B = RandomMatrix<Scalar>(N, 5, 7);
+	matrix<Scalar> X = threaded.solve(B);
+	for (size_t c = 0; c < 5; ++c) {
+		vector<Scalar> b(N);
+		for (size_t i = 0; i < N; ++i) b[i] = B(i, c);
+		vector<Scalar> x = serial.solve(b);
+		for (size_t i = 0; i < N; ++i) {
+			if (x[i] != X(i, c)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: rhs " << c << " element " << i << " : " << x[i] << " != " << X(i, c) << '\n';
+				break;
+			}
+		}
+	}
+	// the permutation matrix reproduces the row order of the pivots
+	matrix<Scalar> PA = serial.P() * A;
+	auto perm = serial.permutation();
+	for (size_t i = 0; i < N; ++i) {
+		if (PA(i, 0) != A(perm[i], 0)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: permutation matrix row " << i << '\n';
+			break;
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// rank deficient and non-square matrices are reported
+template<typename Scalar>
+int VerifySingular(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas::solvers;
+	int nrOfFailedTests = 0;
+	matrix<Scalar> A = RandomMatrix<Scalar>(20, 20, 3);
+	for (size_t i = 0; i < 20; ++i) A(i, 11) = Scalar(0);
+	LUP<Scalar> lup(A, 8, 1);
+	if (!lup.singular()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: matrix with a zero column is not singular\n";
+	}
+	std::cerr << "expected diagnostic: ";
+	LUP<Scalar> rectangular(RandomMatrix<Scalar>(3, 4, 5));
+	if (!rectangular.singular()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: rectangular matrix is accepted\n";
+	}
+	return nrOfFailedTests;
+}
+
+// max |A - B C| relative to max |A|, evaluated in double
+template<typename Scalar>
+double ProductResidual(const sw::numeric::containers::matrix<Scalar>& A, const sw::numeric::containers::matrix<Scalar>& B, const sw::numeric::containers::matrix<Scalar>& C) {
+	double residual{ 0 }, norm{ 0 };
+	for (size_t i = 0; i < num_rows(A); ++i) {
+		for (size_t j = 0; j < num_cols(A); ++j) {
+			double bc{ 0 };
+			for (size_t p = 0; p < num_cols(B); ++p) bc += double(B(i, p)) * double(C(p, j));
+			residual = std::max(residual, std::abs(double(A(i, j)) - bc));
+			norm = std::max(norm, std::abs(double(A(i, j))));
+		}
+	}
+	return residual / norm;
+}
+
+// max |Q^T Q - I| over the columns of Q, evaluated in double
+template<typename Scalar>
+double OrthogonalityError(const sw::numeric::containers::matrix<Scalar>& Q) {
+	double error{ 0 };
+	for (size_t i = 0; i < num_cols(Q); ++i) {
+		for (size_t j = 0; j < num_cols(Q); ++j) {
+			double dot{ 0 };
+			for (size_t p = 0; p < num_rows(Q); ++p) dot += double(Q(p, i)) * double(Q(p, j));
+			error = std::max(error, std::abs(dot - (i == j ? 1.0 : 0.0)));
+		}
+	}
+	return error;
+}
+
+// blocked Householder QR of tall, square, and wide matrices
+template<typename Scalar>
+int VerifyBlockedQR(bool reportTestCases, double tolerance, size_t N) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	const size_t shapes[][2] = { { 1, 1 }, { 7, 5 }, { N * 5 / 8, N * 3 / 8 }, { N, N }, { N / 3, N / 2 } };
+	const size_t blocks[] = { 1, 4, 32 };
+	unsigned seed = 100;
+	for (auto shape : shapes) {
+		for (size_t nb : blocks) {
+			size_t m = shape[0], n = shape[1];
+			matrix<Scalar> A = RandomMatrix<Scalar>(m, n, seed++);
+			matrix<Scalar> Q, R;
+			sw::blas::solvers::blockedqr(A, Q, R, nb);
+			bool upper = true;
+			for (size_t i = 0; i < m; ++i) {
+				for (size_t j = 0; j < std::min(i, n); ++j) if (R(i, j) != Scalar(0)) upper = false;
+			}
+			double r = ProductResidual(A, Q, R);
+			double o = OrthogonalityError(Q);
+			if (!upper || r > tolerance * double(m) || o > tolerance * double(m)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << m << " x " << n << " block size " << nb << (upper ? "" : " R not upper triangular") << " |A - QR| = " << r << " |Q^TQ - I| = " << o << '\n';
+			}
+		}
+	}
+	// the default qr() dispatches to the blocked factorization
+	matrix<Scalar> A = RandomMatrix<Scalar>(12, 9, 7);
+	auto [Q, R] = sw::blas::solvers::qr(A);
+	if (ProductResidual(A, Q, R) > tolerance * 12.0) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: qr(A) residual " << ProductResidual(A, Q, R) << '\n';
+	}
+	return nrOfFailedTests;
+}
+
+// one-sided Jacobi SVD: reconstruction, orthogonality, ordering, and a known spectrum
+template<typename Scalar>
+int VerifyJacobiSVD(bool reportTestCases, double tolerance, size_t N) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	const size_t shapes[][2] = { { 1, 1 }, { 6, 6 }, { N * 3 / 5, N / 3 }, { N / 3, N * 3 / 5 }, { N, N }, { N * 8, 3 } };
+	unsigned seed = 200;
+	for (auto shape : shapes) {
+		size_t m = shape[0], n = shape[1], k = std::min(m, n);
+		matrix<Scalar> A = RandomMatrix<Scalar>(m, n, seed++);
+		matrix<Scalar> U, S, V;
+		sw::blas::solvers::svd(A, U, S, V, 0.0, 1);
+		if (num_rows(U) != m || num_cols(U) != k || num_rows(S) != k || num_rows(V) != n || num_cols(V) != k) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << m << " x " << n << " factor shapes\n";
+			continue;
+		}
+		matrix<Scalar> Vt(k, n);
+		for (size_t i = 0; i < n; ++i) for (size_t j = 0; j < k; ++j) Vt(j, i) = V(i, j);
+		matrix<Scalar> US = U * S;
+		double r = ProductResidual(A, US, Vt);
+		double ou = OrthogonalityError(U);
+		double ov = OrthogonalityError(V);
+		bool sorted = true;
+		for (size_t i = 1; i < k; ++i) if (S(i, i) > S(i - 1, i - 1) || S(i, i) < Scalar(0)) sorted = false;
+		double bound = tolerance * double(std::max(m, n));
+		if (!sorted || r > bound || ou > bound || ov > bound) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << m << " x " << n << (sorted ? "" : " singular values not sorted") << " |A - USV^T| = " << r << " |U^TU - I| = " << ou << " |V^TV - I| = " << ov << '\n';
+		}
+	}
+	// A = Q1 diag(sigma) Q2^T has the singular values sigma
+	const size_t K = N / 2;
+	matrix<Scalar> Q1, Q2, R;
+	sw::blas::solvers::blockedqr(RandomMatrix<Scalar>(K, K, 300), Q1, R);
+	sw::blas::solvers::blockedqr(RandomMatrix<Scalar>(K, K, 301), Q2, R);
+	matrix<Scalar> D(K, K);
+	for (size_t i = 0; i < K; ++i) D(i, i) = Scalar(std::ldexp(1.0, -int(i) / 2));
+	matrix<Scalar> Q2t(K, K);
+	for (size_t i = 0; i < K; ++i) for (size_t j = 0; j < K; ++j) Q2t(j, i) = Q2(i, j);
+	matrix<Scalar> A = Q1 * D * Q2t;
+	auto [U, S, V] = sw::blas::solvers::svd(A);
+	for (size_t i = 0; i < K; ++i) {
+		double expected = double(D(i, i));
+		if (std::abs(double(S(i, i)) - expected) > tolerance * double(K) * double(S(0, 0))) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: singular value " << i << " : " << S(i, i) << " != " << expected << '\n';
+		}
+	}
+	// the parallel rotations do not change the result
+	matrix<Scalar> B = RandomMatrix<Scalar>(N, N, 400);
+	matrix<Scalar> U1, S1, V1, U3, S3, V3;
+	sw::blas::solvers::svd(B, U1, S1, V1, 0.0, 1);
+	sw::blas::solvers::svd(B, U3, S3, V3, 0.0, 3);
+	if (U1 != U3 || S1 != S3 || V1 != V3) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: SVD depends on the number of threads\n";
+	}
+	return nrOfFailedTests;
+}
+
+// zero singular values: the left singular vectors complete an orthonormal basis
+template<typename Scalar>
+int VerifyRankDeficientSVD(bool reportTestCases, double tolerance) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	struct { size_t m, n, zeroRow, zeroCol; } cases[] = {
+		{ 5, 3, 5, 3 },   // no zeros: the zero matrix below
+		{ 7, 4, 7, 1 },   // tall, a zero column
+		{ 3, 5, 2, 5 },   // wide, a zero row
+		{ 6, 6, 0, 4 },   // square, a zero row and a zero column
+	};
+	unsigned seed = 500;
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+		size_t m = cases[c].m, n = cases[c].n, k = std::min(m, n);
+		matrix<Scalar> A = (c == 0 ? matrix<Scalar>(m, n) : RandomMatrix<Scalar>(m, n, seed++));
+		for (size_t j = 0; j < n && cases[c].zeroRow < m; ++j) A(cases[c].zeroRow, j) = Scalar(0);
+		for (size_t i = 0; i < m && cases[c].zeroCol < n; ++i) A(i, cases[c].zeroCol) = Scalar(0);
+		matrix<Scalar> U, S, V;
+		sw::blas::solvers::svd(A, U, S, V, 0.0, 1);
+		size_t zeros = 0;
+		for (size_t i = 0; i < k; ++i) if (S(i, i) == Scalar(0)) ++zeros;
+		matrix<Scalar> Vt(k, n);
+		for (size_t i = 0; i < n; ++i) for (size_t j = 0; j < k; ++j) Vt(j, i) = V(i, j);
+		matrix<Scalar> US = U * S;
+		double r = (c == 0 ? 0.0 : ProductResidual(A, US, Vt));
+		double ou = OrthogonalityError(U);
+		double ov = OrthogonalityError(V);
+		double bound = tolerance * double(std::max(m, n));
+		if (zeros == 0 || r > bound || ou > bound || ov > bound) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: rank-deficient " << m << " x " << n << " with " << zeros << " zero singular values |A - USV^T| = " << r << " |U^TU - I| = " << ou << " |V^TV - I| = " << ov << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "matrix factorizations";
+	std::string test_tag    = "factorizations";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedLU< posit<32, 2> >(reportTestCases, 1.0e-7), test_tag, "blocked LU posit<32,2>");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD< posit<32, 2> >(reportTestCases, 1.0e-7, 12), test_tag, "Jacobi SVD posit<32,2>");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedLU< double >(reportTestCases, 1.0e-15), test_tag, "blocked LU double");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility< double >(reportTestCases), test_tag, "thread count reproducibility double");
+	nrOfFailedTestCases += ReportTestResult(VerifySingular< double >(reportTestCases), test_tag, "singular double");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR< double >(reportTestCases, 1.0e-15, 64), test_tag, "blocked QR double");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD< double >(reportTestCases, 1.0e-15, 50), test_tag, "Jacobi SVD double");
+	nrOfFailedTestCases += ReportTestResult(VerifyRankDeficientSVD< double >(reportTestCases, 1.0e-15), test_tag, "rank-deficient SVD double");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedLU< float >(reportTestCases, 1.0e-6), test_tag, "blocked LU float");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedLU< posit<32, 2> >(reportTestCases, 1.0e-7), test_tag, "blocked LU posit<32,2>");
+	nrOfFailedTestCases += ReportTestResult((VerifyBlockedLU< posit<32, 2>, sw::blas::fused_LUP< posit<32, 2> > >(reportTestCases, 1.0e-7)), test_tag, "fused LU posit<32,2>");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR< float >(reportTestCases, 1.0e-6, 64), test_tag, "blocked QR float");
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD< float >(reportTestCases, 1.0e-6, 50), test_tag, "Jacobi SVD float");
+	nrOfFailedTestCases += ReportTestResult(VerifyRankDeficientSVD< float >(reportTestCases, 1.0e-6), test_tag, "rank-deficient SVD float");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedLU< cfloat<32, 8, uint32_t, true, false, false> >(reportTestCases, 1.0e-6), test_tag, "blocked LU cfloat<32,8>");
+	nrOfFailedTestCases += ReportTestResult((VerifyBlockedLU< cfloat<32, 8, uint32_t, true, false, false>, sw::blas::fused_LUP< cfloat<32, 8, uint32_t, true, false, false> > >(reportTestCases, 1.0e-6)), test_tag, "fused LU cfloat<32,8>");
+	nrOfFailedTestCases += ReportTestResult(VerifyReproducibility< posit<32, 2> >(reportTestCases), test_tag, "thread count reproducibility posit<32,2>");
+	nrOfFailedTestCases += ReportTestResult(VerifyBlockedQR< posit<32, 2> >(reportTestCases, 1.0e-7, 24), test_tag, "blocked QR posit<32,2>");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyJacobiSVD< posit<32, 2> >(reportTestCases, 1.0e-7, 12), test_tag, "Jacobi SVD posit<32,2>");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,287 @@
+// fused_ops.cpp: reproducible dot, matvec, and gemm operators using exact accumulators
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/bfloat/bfloat.hpp>
+#include <blas/blas.hpp>
+#include <blas/ext/fused_blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+/*
+ * The exact accumulator of a number system adds products without rounding,
+ * so a fused dot product only rounds once, and the result does not depend
+ * on the order in which the products are presented:
+ *   posit    : quire
+ *   cfloat   : IEEE quire of the cfloat configuration
+ *   fixpnt   : fixpnt with twice the bits plus capacity bits
+ *   lns      : Kulisch register of double, the sum is rounded to double and then to lns
+ *   float    : IEEE quire of single precision
+ *   double   : Kulisch register of double
+ */
+
+// catastrophic cancellation: big^2 absorbs the small products in a left to right dot product,
+// the exact accumulator recovers them, even when big^2 is not representable in the Scalar type
+template<typename Scalar>
+int VerifyCancellation(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	Scalar big = Scalar(std::ldexp(1.0, 10));
+	Scalar small = Scalar(std::ldexp(1.0, -3));
+	vector<Scalar> x = { big, small, -big, small, small };
+	vector<Scalar> y = { big, small, big, small, -small };
+	// big^2 + small^2 - big^2 + small^2 - small^2 = small^2
+	Scalar expected = small * small;
+	Scalar result = sw::blas::fused_dot(x, y);
+	if (result != expected) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: fused_dot " << result << " != " << expected << '\n';
+	}
+	// reversing the order of the products yields the same sum
+	vector<Scalar> rx(size(x)), ry(size(y));
+	for (size_t i = 0; i < size(x); ++i) {
+		rx[i] = x[size(x) - 1 - i];
+		ry[i] = y[size(y) - 1 - i];
+	}
+	Scalar reversed = sw::blas::fused_dot(rx, ry);
+	if (reversed != result) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: fused_dot is order dependent " << reversed << " != " << result << '\n';
+	}
+	return nrOfFailedTests;
+}
+
+// fused_gemm and fused_matvec produce the same fused dot products for the same rows and columns
+template<typename Scalar>
+int VerifyFusedGemm(unsigned N, bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	matrix<double> ref = sw::blas::gaussian_random_matrix<double>(N, N, 0.0, 1.0);
+	matrix<Scalar> A(ref), B(ref);
+	B.transpose();
+	matrix<Scalar> C = sw::blas::fused_gemm(A, B);
+	for (unsigned j = 0; j < N; ++j) {
+		vector<Scalar> x(N);
+		for (unsigned i = 0; i < N; ++i) x[i] = B(i, j);
+		vector<Scalar> c = sw::blas::fused_matvec(A, x);
+		for (unsigned i = 0; i < N; ++i) {
+			if (c[i] != C(i, j)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: C(" << i << ',' << j << ") = " << C(i, j) << " != " << c[i] << '\n';
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// cfloats without subnormals flush products and sums below the normal range to zero, like their arithmetic:
+// a fused dot product of a single product is the cfloat product itself
+template<typename Scalar>
+int VerifySubnormalFlush(bool reportTestCases) {
+	static_assert(!Scalar::hasSubnormals, "VerifySubnormalFlush requires a cfloat without subnormals");
+	using namespace sw::numeric::containers;
+	constexpr size_t NR_ENCODINGS = (size_t(1) << Scalar::nbits);
+	int nrOfFailedTests = 0;
+	Scalar a, b;
+	for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+		a.setbits(i);
+		if (a.isdenormal()) continue;  // not a value of this configuration
+		for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+			b.setbits(j);
+			if (b.isdenormal()) continue;
+			vector<Scalar> x = { a }, y = { b };
+			Scalar result = sw::blas::fused_dot(x, y);
+			Scalar expected = a * b;
+			// compare values: cfloat equality distinguishes -0 from +0
+			if (double(result) != double(expected) && !(result.isnan() && expected.isnan())) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: fused_dot " << a << " * " << b << " = " << result << " != " << expected << '\n';
+			}
+			if (nrOfFailedTests > 24) return nrOfFailedTests;
+		}
+	}
+	// a flushed product does not contribute to the sum, and a sum below the normal range flushes
+	Scalar minpos(sw::universal::SpecificValue::minpos), half(0.5), one(1), oneandhalf(1.5);
+	vector<Scalar> x = { minpos, one }, y = { half, minpos };
+	Scalar result = sw::blas::fused_dot(x, y);
+	if (result != minpos) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: fused_dot of a flushed product " << result << " != " << minpos << '\n';
+	}
+	x = { oneandhalf * minpos, -one };
+	y = { one, minpos };
+	result = sw::blas::fused_dot(x, y);
+	if (!result.iszero()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: fused_dot of a sum below the normal range " << result << " != 0\n";
+	}
+	return nrOfFailedTests;
+}
+
+// for double, the fused dot product is the correctly rounded sum of the products
+int VerifyCorrectRounding(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	// 1 + 2^-53 rounds to 1 in each step of a naive sum, but the exact sum of two of them is 1 + 2^-52
+	double tiny = std::ldexp(1.0, -53);
+	vector<double> x = { 1.0, tiny, tiny };
+	vector<double> y = { 1.0, 1.0, 1.0 };
+	double result = sw::blas::fused_dot(x, y);
+	double expected = 1.0 + std::ldexp(1.0, -52);
+	if (result != expected) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: " << result << " != " << expected << '\n';
+	}
+	// a single tie rounds to even
+	x = { 1.0, tiny };
+	y = { 1.0, 1.0 };
+	result = sw::blas::fused_dot(x, y);
+	if (result != 1.0) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: " << result << " != 1\n";
+	}
+	// subnormal results
+	x = { std::ldexp(1.0, -600), -std::ldexp(1.0, -600) };
+	y = { std::ldexp(1.0, -470), std::ldexp(1.0, -471) };
+	result = sw::blas::fused_dot(x, y);
+	if (result != std::ldexp(1.0, -1071)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: " << result << " != 2^-1071\n";
+	}
+	// non-finite products
+	x = { 1.0, std::numeric_limits<double>::infinity() };
+	result = sw::blas::fused_dot(x, y);
+	if (!std::isinf(result)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: " << result << " != inf\n";
+	}
+	x = { 0.0, std::numeric_limits<double>::infinity() };
+	y = { std::numeric_limits<double>::infinity(), 1.0 };
+	result = sw::blas::fused_dot(x, y);
+	if (!std::isnan(result)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: " << result << " != nan\n";
+	}
+	return nrOfFailedTests;
+}
+
+// lns has no exact binary accumulator: the fused dot product is the lns conversion of the correctly rounded
+// double of the exact sum, which is the fused dot product of the double images of the operands
+template<typename Scalar>
+int VerifyDoubleRoundedLns(unsigned N, bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	matrix<double> ref = sw::blas::gaussian_random_matrix<double>(2, N, 0.0, 1.0);
+	vector<Scalar> x(N), y(N);
+	vector<double> dx(N), dy(N);
+	for (unsigned i = 0; i < N; ++i) {
+		x[i] = ref(0, i);
+		y[i] = ref(1, i);
+		dx[i] = double(x[i]);
+		dy[i] = double(y[i]);
+	}
+	Scalar result = sw::blas::fused_dot(x, y);
+	Scalar expected = Scalar(sw::blas::fused_dot(dx, dy));
+	if (result != expected) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: fused_dot " << result << " != " << expected << '\n';
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "fused BLAS operators";
+	std::string test_tag    = "fused";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases), test_tag, "fused_dot cfloat<16,5>");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< posit<32, 2> >(reportTestCases), test_tag, "fused_dot posit<32,2>");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases), test_tag, "fused_dot cfloat<16,5>");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< bfloat_t >(reportTestCases), test_tag, "fused_dot bfloat_t");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< bfloat16 >(reportTestCases), test_tag, "fused_dot bfloat16");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< fixpnt<32, 16, Modulo, uint32_t> >(reportTestCases), test_tag, "fused_dot fixpnt<32,16,Modulo>");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< fixpnt<32, 16, Saturate, uint32_t> >(reportTestCases), test_tag, "fused_dot fixpnt<32,16,Saturate>");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< lns<16, 8> >(reportTestCases), test_tag, "fused_dot lns<16,8>");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< float >(reportTestCases), test_tag, "fused_dot float");
+	nrOfFailedTestCases += ReportTestResult(VerifyCancellation< double >(reportTestCases), test_tag, "fused_dot double");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyCorrectRounding(reportTestCases), test_tag, "fused_dot double rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyDoubleRoundedLns< lns<16, 8> >(64, reportTestCases), test_tag, "fused_dot lns<16,8> double-rounded");
+	nrOfFailedTestCases += ReportTestResult(VerifySubnormalFlush< cfloat<8, 4, uint8_t, false, false, false> >(reportTestCases), test_tag, "fused_dot cfloat<8,4> flush");
+	nrOfFailedTestCases += ReportTestResult(VerifySubnormalFlush< cfloat<10, 3, uint16_t, false, true, true> >(reportTestCases), test_tag, "fused_dot cfloat<10,3> flush");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedGemm< posit<16, 2> >(8, reportTestCases), test_tag, "fused_gemm posit<16,2>");
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedGemm< half >(8, reportTestCases), test_tag, "fused_gemm half");
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedGemm< fixpnt<16, 8, Saturate, uint16_t> >(8, reportTestCases), test_tag, "fused_gemm fixpnt<16,8>");
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedGemm< float >(8, reportTestCases), test_tag, "fused_gemm float");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyFusedGemm< double >(32, reportTestCases), test_tag, "fused_gemm double");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,198 @@
+// iterative_refinement.cpp: mixed-precision iterative refinement with low precision LU factors
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/dd/dd.hpp>
+#include <blas/blas.hpp>
+#include <blas/solvers/iterative_refinement.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// diagonally weighted random matrix, with an optional scale per row to stress the squeeze strategies
+template<typename Scalar>
+sw::numeric::containers::matrix<Scalar> TestMatrix(size_t N, unsigned seed, double magnitude = 1.0, bool rowScaled = false) {
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	sw::numeric::containers::matrix<Scalar> A(N, N);
+	for (size_t i = 0; i < N; ++i) {
+		double rowScale = (rowScaled ? std::ldexp(1.0, int(i % 17) - 8) : 1.0);
+		for (size_t j = 0; j < N; ++j) {
+			double a = distribution(generator) + (i == j ? 2.0 : 0.0);
+			A(i, j) = Scalar(magnitude * rowScale * a);
+		}
+	}
+	return A;
+}
+
+// max |x - ones| for the solution of A x = A * ones
+template<typename Scalar>
+double ForwardError(const sw::numeric::containers::vector<Scalar>& x) {
+	double error{ 0 };
+	for (size_t i = 0; i < size(x); ++i) {
+		double e = std::abs(double(x[i]) - 1.0);
+		if (!(e <= error)) error = e;  // propagates NaN
+	}
+	return error;
+}
+
+// right-hand side A * ones, accumulated in double
+template<typename Scalar>
+sw::numeric::containers::vector<Scalar> OnesRhs(const sw::numeric::containers::matrix<Scalar>& A) {
+	sw::numeric::containers::vector<Scalar> b(num_rows(A));
+	for (size_t i = 0; i < num_rows(A); ++i) {
+		double sum{ 0 };
+		for (size_t j = 0; j < num_cols(A); ++j) sum += double(A(i, j));
+		b[i] = Scalar(sum);
+	}
+	return b;
+}
+
+// refinement recovers the working precision accuracy from the low precision factors
+template<typename WorkingT, typename LowT, typename ResidualT>
+int VerifyRefinement(bool reportTestCases, size_t N, double magnitude, bool rowScaled, sw::blas::solvers::SqueezeStrategy squeeze, double tolerance) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas::solvers;
+	int nrOfFailedTests = 0;
+	matrix<WorkingT> A = TestMatrix<WorkingT>(N, 11, magnitude, rowScaled);
+	refinement_options options;
+	options.squeeze = squeeze;
+	options.maxIterations = 20;
+	iterative_refinement<WorkingT, LowT, ResidualT> solver(A, options);
+	// the factors are reused for several right-hand sides
+	for (unsigned rhs = 0; rhs < 2; ++rhs) {
+		vector<WorkingT> b = OnesRhs(A);
+		if (rhs == 1) {
+			for (size_t i = 0; i < N; ++i) b[i] = -b[i];
+		}
+		vector<WorkingT> x = solver.solve(b);
+		if (rhs == 1) {
+			for (size_t i = 0; i < N; ++i) x[i] = -x[i];
+		}
+		double error = ForwardError(x);
+		const auto& history = solver.history();
+		double lastBackwardError = (history.empty() ? 1.0 : history.back().backwardError);
+		if (!solver.converged() || error > tolerance) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: rhs " << rhs << " status " << int(solver.status()) << " after " << solver.iterations() << " iterations, forward error " << error << ", backward error " << lastBackwardError << '\n';
+		}
+		if (history.empty() || history.size() > options.maxIterations || history.front().iteration != 1) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: iteration history of " << history.size() << " steps\n";
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// a low precision format that overflows on A needs a squeeze strategy
+template<typename WorkingT, typename LowT, typename ResidualT>
+int VerifyOverflow(bool reportTestCases, size_t N, double magnitude) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas::solvers;
+	int nrOfFailedTests = 0;
+	matrix<WorkingT> A = TestMatrix<WorkingT>(N, 13, magnitude);
+	std::cerr << "expected diagnostic: ";
+	iterative_refinement<WorkingT, LowT, ResidualT> solver(A);
+	vector<WorkingT> x = solver.solve(OnesRhs(A));
+	if (solver.status() != refinement_status::FactorizationFailed || solver.converged()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: refinement on the unscaled matrix is not rejected, error " << ForwardError(x) << '\n';
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+	using namespace sw::blas::solvers;
+
+	std::string test_suite  = "mixed-precision iterative refinement";
+	std::string test_tag    = "iterative refinement";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	{
+		using Matrix = sw::numeric::containers::matrix<double>;
+		Matrix A = TestMatrix<double>(50, 11);
+		iterative_refinement<double, float, dd> solver(A);
+		auto x = solver.solve(OnesRhs(A));
+		std::cout << "factorization " << solver.factorizationSeconds() << "s\n";
+		for (const auto& step : solver.history()) {
+			std::cout << step.iteration << " : backward error " << step.backwardError << " correction " << step.correctionNorm
+				<< " residual " << step.residualSeconds << "s solve " << step.solveSeconds << "s\n";
+		}
+		std::cout << "forward error " << ForwardError(x) << '\n';
+	}
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinement<double, float, dd>(reportTestCases, 100, 1.0, false, SqueezeStrategy::None, 1.0e-14)), test_tag, "double/float/dd");
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinement<double, float, double>(reportTestCases, 100, 1.0, false, SqueezeStrategy::None, 1.0e-13)), test_tag, "double/float/double");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using half = cfloat<16, 5, uint16_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinement<float, half, double>(reportTestCases, 40, 1.0, false, SqueezeStrategy::None, 1.0e-5)), test_tag, "float/half/double");
+	nrOfFailedTestCases += ReportTestResult((VerifyOverflow<float, half, double>(reportTestCases, 40, 1.0e6)), test_tag, "float/half overflow");
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinement<float, half, double>(reportTestCases, 40, 1.0e6, false, SqueezeStrategy::ScaleAndRound, 1.0e-5)), test_tag, "float/half scale and round");
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinement<float, half, double>(reportTestCases, 40, 1.0e6, true, SqueezeStrategy::TwoSidedScaleAndRound, 1.0e-5)), test_tag, "float/half two-sided scale and round");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult((VerifyRefinement<posit<32, 2>, posit<16, 1>, quire_residual>(reportTestCases, 30, 1.0, false, SqueezeStrategy::None, 1.0e-7)), test_tag, "posit<32,2>/posit<16,1>/quire");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,207 @@
+// sparse_ops.cpp: compressed sparse row/column matrices, sparse matrix-vector products, and sparse iterative solvers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <blas/blas.hpp>
+#include <blas/solvers/cg.hpp>
+#include <blas/ext/fused_blas.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// compress and expand a dense matrix in both storage formats and convert between them
+template<typename Scalar>
+int VerifyCompression(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	matrix<Scalar> A;
+	sw::blas::laplace2D(A, 4, 5);
+	A(0, 19) = Scalar(0.5);  // break the symmetry
+	sparse_matrix<Scalar> csr(A);
+	sparse_matrix<Scalar, SparseFormat::CSC> csc(A);
+	sparse_matrix<Scalar, SparseFormat::CSC> converted(csr);
+	sparse_matrix<Scalar> roundtrip(converted);
+	size_t nonzeros = 0;
+	for (size_t i = 0; i < A.rows(); ++i) {
+		for (size_t j = 0; j < A.cols(); ++j) {
+			if (A(i, j) != Scalar(0)) ++nonzeros;
+			if (csr(i, j) != A(i, j) || csc(i, j) != A(i, j) || converted(i, j) != A(i, j)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: element (" << i << ',' << j << ") " << csr(i, j) << " " << csc(i, j) << " " << converted(i, j) << " != " << A(i, j) << '\n';
+			}
+		}
+	}
+	if (nnz(csr) != nonzeros || nnz(csc) != nonzeros) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: nnz " << nnz(csr) << " " << nnz(csc) << " != " << nonzeros << '\n';
+	}
+	if (converted.offsets() != csc.offsets() || converted.indices() != csc.indices() || converted.values() != csc.values()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: CSR to CSC conversion differs from the compressed dense matrix\n";
+	}
+	if (roundtrip.offsets() != csr.offsets() || roundtrip.indices() != csr.indices() || roundtrip.values() != csr.values()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: CSC to CSR conversion does not round trip\n";
+	}
+	if (csc.to_dense() != A) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: to_dense\n";
+	}
+	// triplet assembly sums duplicates
+	using triplet = typename sparse_matrix<Scalar>::triplet;
+	std::vector<triplet> entries = { triplet(2, 1, Scalar(1)), triplet(0, 0, Scalar(2)), triplet(2, 1, Scalar(3)), triplet(1, 2, Scalar(-1)) };
+	sparse_matrix<Scalar> T(3, 3, entries);
+	if (nnz(T) != 3 || T(2, 1) != Scalar(4) || T(0, 0) != Scalar(2) || T(1, 2) != Scalar(-1) || T(1, 1) != Scalar(0)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: triplet assembly\n" << T;
+	}
+	// a minor dimension beyond the 32-bit indices is rejected
+	try {
+		sparse_matrix<Scalar> wide(2, size_t(1) << 33);
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: " << wide.cols() << " columns accepted with 32-bit indices\n";
+	}
+	catch (const std::length_error&) {}
+	return nrOfFailedTests;
+}
+
+// the sparse matrix-vector product rounds the same as the dense product, which skips no products
+template<typename Scalar>
+int VerifySpmv(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	matrix<Scalar> A;
+	sw::blas::laplace2D(A, 6, 6);
+	vector<Scalar> x(A.cols());
+	for (size_t i = 0; i < size(x); ++i) x[i] = Scalar(1.0 + 0.125 * double(i));
+	vector<Scalar> ref = A * x;
+	sparse_matrix<Scalar> csr(A);
+	sparse_matrix<Scalar, SparseFormat::CSC> csc(A);
+	vector<Scalar> ycsr = csr * x;
+	vector<Scalar> ycsc = csc * x;
+	vector<Scalar> yfused = sw::blas::fused_matvec(csr, x);
+	vector<Scalar> yfusedcsc = sw::blas::fused_matvec(csc, x);
+	// mixed precision: Scalar matrix and vector, double accumulation, Scalar result
+	vector<Scalar> ymixed = spmv<double, Scalar>(csr, x);
+	for (size_t i = 0; i < size(x); ++i) {
+		if (ycsr[i] != ref[i] || ycsc[i] != ref[i] || yfused[i] != ref[i] || yfusedcsc[i] != ref[i] || ymixed[i] != ref[i]) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: y[" << i << "] " << ycsr[i] << " " << ycsc[i] << " " << yfused[i] << " " << yfusedcsc[i] << " " << ymixed[i] << " != " << ref[i] << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// solve a diagonally dominant system with the sparse Jacobi, Gauss-Seidel, and conjugate gradient solvers
+template<typename Scalar>
+int VerifySparseSolvers(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	int nrOfFailedTests = 0;
+	constexpr size_t N = 100;
+	matrix<Scalar> D;
+	sw::blas::tridiag(D, N, Scalar(-1), Scalar(4), Scalar(-1));
+	sparse_matrix<Scalar> A(D);
+	vector<Scalar> ones(N);
+	ones = Scalar(1);
+	vector<Scalar> b = A * ones;
+	Scalar tolerance = Scalar(1.0e-5);
+
+	auto check = [&](const char* solver, const vector<Scalar>& x, size_t itr) {
+		Scalar error = sw::blas::normL1(x - ones);
+		if (error > Scalar(1.0e-3) || itr >= 100) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << solver << " error " << error << " after " << itr << " iterations\n";
+		}
+	};
+	vector<Scalar> x(N);
+	x = Scalar(0);
+	check("Jacobi", x, sw::blas::solvers::Jacobi(A, b, x, tolerance));
+	x = Scalar(0);
+	check("Gauss-Seidel", x, sw::blas::solvers::GaussSeidel(sparse_matrix<Scalar, SparseFormat::CSC>(A), b, x, tolerance));
+	x = Scalar(0);
+	vector<Scalar> residuals;
+	check("cg", x, sw::blas::solvers::cg(A, b, x, residuals, tolerance));
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "sparse matrix operators";
+	std::string test_tag    = "sparse";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< posit<32, 2> >(reportTestCases), test_tag, "spmv posit<32,2>");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyCompression< float >(reportTestCases), test_tag, "compression float");
+	nrOfFailedTestCases += ReportTestResult(VerifyCompression< posit<16, 1> >(reportTestCases), test_tag, "compression posit<16,1>");
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< double >(reportTestCases), test_tag, "spmv double");
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< float >(reportTestCases), test_tag, "spmv float");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifySpmv< posit<32, 2> >(reportTestCases), test_tag, "spmv posit<32,2>");
+	nrOfFailedTestCases += ReportTestResult(VerifySparseSolvers< double >(reportTestCases), test_tag, "solvers double");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifySparseSolvers< posit<32, 2> >(reportTestCases), test_tag, "solvers posit<32,2>");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
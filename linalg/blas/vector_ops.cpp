@@ -17,6 +17,7 @@
 #include <universal/number/cfloat/cfloat.hpp>
 #include <universal/number/lns/lns.hpp>
 #include <blas/blas.hpp>
+#include <blas/ext/fused_blas.hpp>
 #include <universal/verification/test_suite.hpp>
 
 template<unsigned nbits, unsigned es>
@@ -64,7 +65,7 @@ int VerifyErrorFreeFusedDotProduct(Scalar maxpos) {
 	// dot: 0
 	// fdp: 0.000244141
 	Scalar errorFullDot = dot(a, b);
-	Scalar errorFreeFDP = fdp(a, b);
+	Scalar errorFreeFDP = fused_dot(a, b);
 	std::cout << "\naccumulation of 32k epsilons (" << epsilon << ") for a " << type_tag(Scalar()) << " yields:\n";
 	std::cout << "dot            : " << errorFullDot << " : " << to_binary(errorFullDot) << '\n';
 	std::cout << "fdp            : " << errorFreeFDP << " : " << to_binary(errorFreeFDP) << '\n';
@@ -130,9 +131,9 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyErrorFreeFusedDotProduct(std::numeric_limits<posit<8, 2> >::max()), test_tag, "error free posit<8,2> dot");
 	nrOfFailedTestCases += ReportTestResult(VerifyErrorFreeFusedDotProduct(std::numeric_limits<posit<16, 2> >::max()), test_tag, "error free posit<16,2> dot");
 	nrOfFailedTestCases += ReportTestResult(VerifyErrorFreeFusedDotProduct(std::numeric_limits<posit<32, 2> >::max()), test_tag, "error free posit<32,2> dot");
-	// TBD: no fdp yet for cfloat or lns
-	// nrOfFailedTestCases += ReportTestResult(VerifyErrorFreeFusedDotProduct(std::numeric_limits< bfloat_t >::max()), test_tag, "error free bfloat16 dot");
-	// nrOfFailedTestCases += ReportTestResult(VerifyErrorFreeFusedDotProduct(std::numeric_limits< lns<16, 8> >::max()), test_tag, "error free lns dot");
+	nrOfFailedTestCases += ReportTestResult(VerifyErrorFreeFusedDotProduct(std::numeric_limits< bfloat_t >::max()), test_tag, "error free bfloat16 dot");
+	// the lns sum is exact, but it is rounded to double before it is rounded to lns
+	nrOfFailedTestCases += ReportTestResult(VerifyErrorFreeFusedDotProduct(std::numeric_limits< lns<16, 8> >::max()), test_tag, "double-rounded lns dot");
 
 	std::cout << "Verify Vector scaling for different arithmetic types\n";
 	nrOfFailedTestCases += ReportTestResult(VerifyVectorScale< posit<32, 2> >(100), "vector scale", "scale posit vector");
@@ -0,0 +1,252 @@
+// binary_datafile.cpp: binary serialization of vectors and matrices with a memory-mapped restore
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <universal/number_systems.hpp>
+#include <blas/blas.hpp>
+#include <blas/serialization/datafile.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// save a vector and a matrix of Scalar into a binary datafile, and restore them through the mapped view and a block copy
+template<typename Scalar>
+int VerifyBinaryRoundTrip(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas;
+	int nrOfFailedTests = 0;
+	std::string tag = type_tag(Scalar());
+	vector<Scalar> x(17);
+	matrix<Scalar> A(5, 7);
+	gaussian_random(x, 0.0, 1.0);
+	gaussian_random(A, 0.0, 1.0);
+
+	std::string filename = (std::filesystem::temp_directory_path() / "universal_binary_datafile.dat").string();
+	{
+		datafile<BinaryFormat> df;
+		df.add(x, "x");
+		df.add(A, "A");
+		std::ofstream fo(filename, std::ios::binary);
+		if (!df.save(fo)) {
+			if (reportTestCases) std::cerr << "FAIL: " << tag << " save\n";
+			return 1;
+		}
+	}
+	{
+		mapped_datafile mdf(filename);
+		if (mdf.size() != 2 || !mdf.contains("x") || !mdf.contains("A")) {
+			if (reportTestCases) std::cerr << "FAIL: " << tag << " records\n";
+			return 1;
+		}
+		auto vx = mdf.view<Scalar>("x");
+		auto vA = mdf.view<Scalar>("A");
+		if (vx.size() != size(x) || vA.rows() != A.rows() || vA.cols() != A.cols()) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << tag << " shape\n";
+		}
+		else {
+			for (size_t i = 0; i < size(x); ++i) {
+				if (vx[i] != x[i]) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: " << tag << " x[" << i << "] " << vx[i] << " != " << x[i] << '\n';
+				}
+			}
+			for (size_t i = 0; i < A.rows(); ++i) {
+				for (size_t j = 0; j < A.cols(); ++j) {
+					if (vA(i, j) != A(i, j)) {
+						++nrOfFailedTests;
+						if (reportTestCases) std::cerr << "FAIL: " << tag << " A(" << i << ',' << j << ") " << vA(i, j) << " != " << A(i, j) << '\n';
+					}
+				}
+			}
+		}
+		vector<Scalar> y;
+		matrix<Scalar> B;
+		if (!mdf.get("x", y) || !mdf.get("A", B) || !(y == x) || !(B == A)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << tag << " block copy restore\n";
+		}
+		// the aggregation type and the arithmetic type of a record are checked
+		if (mdf.get("A", y)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << tag << " matrix restored into a vector\n";
+		}
+		vector<char> wrongType;
+		if (mdf.get("x", wrongType)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << tag << " record restored into a different arithmetic type\n";
+		}
+	}
+	std::filesystem::remove(filename);
+	return nrOfFailedTests;
+}
+
+// corrupt record headers must be rejected when the file is opened or the record is viewed
+int VerifyCorruptBinaryDatafile(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas;
+	int nrOfFailedTests = 0;
+	std::string filename = (std::filesystem::temp_directory_path() / "universal_corrupt_datafile.dat").string();
+	{
+		vector<double> x = { 1.0, 2.0, 3.0 };
+		datafile<BinaryFormat> df;
+		df.add(x, "x");
+		std::ofstream fo(filename, std::ios::binary);
+		df.save(fo);
+	}
+	std::string image;
+	{
+		std::ifstream fi(filename, std::ios::binary);
+		image.assign(std::istreambuf_iterator<char>(fi), std::istreambuf_iterator<char>());
+	}
+	constexpr size_t recordAt = sizeof(BinaryDataFileHeader);
+	auto patch = [&](std::string bytes, size_t field, auto value) {
+		std::memcpy(&bytes[recordAt + field], &value, sizeof(value));
+		std::ofstream fo(filename, std::ios::binary);
+		fo.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	};
+	auto rejects = [&](const std::string& label, auto&& access) {
+		try {
+			access();
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << label << " not rejected\n";
+		}
+		catch (const std::runtime_error&) {
+			// correctly rejected
+		}
+	};
+
+	patch(image, offsetof(BinaryRecordHeader, rows), uint64_t(4));
+	rejects("rows * cols != nrElements", [&] { mapped_datafile mdf(filename); });
+	patch(image, offsetof(BinaryRecordHeader, cols), uint64_t(1) << 62);
+	rejects("rows * cols overflow", [&] { mapped_datafile mdf(filename); });
+	{
+		// 2^61 elements of 8 bytes wrap a 64-bit byte count to 0
+		std::string bytes = image;
+		uint64_t count = uint64_t(1) << 61;
+		std::memcpy(&bytes[recordAt + offsetof(BinaryRecordHeader, rows)], &count, sizeof(count));
+		patch(bytes, offsetof(BinaryRecordHeader, nrElements), count);
+	}
+	rejects("element byte count overflow", [&] { mapped_datafile mdf(filename); });
+	patch(image, offsetof(BinaryRecordHeader, aggregationType), uint32_t(UNIVERSAL_AGGREGATE_TENSOR));
+	rejects("tensor record viewed as an array", [&] { mapped_datafile mdf(filename); mdf.view<double>("x"); });
+
+	std::filesystem::remove(filename);
+	return nrOfFailedTests;
+}
+
+// an element type that owns heap storage, so its values cannot be stored as raw encodings
+namespace boxed {
+	struct Boxed {
+		std::vector<double> payload{ 0.0 };
+	};
+	inline std::string to_hex(const Boxed&, bool, bool) { return "0x0"; }
+	inline std::ostream& operator<<(std::ostream& ostr, const Boxed& b) { return ostr << b.payload.front(); }
+}
+
+// a datafile with a non-trivially copyable element type compiles, and reports the failure when saved in binary
+int VerifyUnsupportedBinaryElement(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas;
+	int nrOfFailedTests = 0;
+	vector<boxed::Boxed> x(3);
+	datafile<BinaryFormat> df;
+	df.add(x, "x");
+	std::stringstream ss;
+	if (df.save(ss) || !ss.fail()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: non-trivially copyable elements saved as raw encodings\n";
+	}
+	std::stringstream text("1");
+	if (df.restore(text)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: binary datafile restored from a stream\n";
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "binary datafile";
+	std::string test_tag    = "binary save/restore";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryRoundTrip< posit<32, 2> >(reportTestCases), test_tag, "posit<32,2>");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryRoundTrip< float >(reportTestCases), test_tag, "float");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryRoundTrip< double >(reportTestCases), test_tag, "double");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryRoundTrip< posit<32, 2> >(reportTestCases), test_tag, "posit<32,2>");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryRoundTrip< cfloat<16, 5, uint16_t, true, false, false> >(reportTestCases), test_tag, "cfloat<16,5>");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorruptBinaryDatafile(reportTestCases), test_tag, "corrupt files");
+	nrOfFailedTestCases += ReportTestResult(VerifyUnsupportedBinaryElement(reportTestCases), test_tag, "unsupported element type");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryRoundTrip< fixpnt<32, 16, Modulo, uint32_t> >(reportTestCases), test_tag, "fixpnt<32,16>");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryRoundTrip< lns<16, 8, uint16_t> >(reportTestCases), test_tag, "lns<16,8>");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryRoundTrip< posit<8, 0> >(reportTestCases), test_tag, "posit<8,0>");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryRoundTrip< posit<64, 3> >(reportTestCases), test_tag, "posit<64,3>");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
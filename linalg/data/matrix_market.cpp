@@ -0,0 +1,338 @@
+// matrix_market.cpp: Matrix Market and binary matrix file readers and writers
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <universal/number/posit/posit.hpp>
+#include <numeric/containers.hpp>
+#include <blas/serialization/matrix_market.hpp>
+#include <blas/serialization/test_matrix.hpp>
+#include <universal/verification/test_suite.hpp>
+
+template<typename Scalar, typename Matrix>
+int CompareMatrices(const Matrix& A, const sw::numeric::containers::matrix<Scalar>& ref, const std::string& label, bool reportTestCases) {
+	int nrOfFailedTests = 0;
+	if (A.rows() != ref.rows() || A.cols() != ref.cols()) {
+		if (reportTestCases) std::cerr << "FAIL: " << label << " shape " << A.rows() << 'x' << A.cols() << " != " << ref.rows() << 'x' << ref.cols() << '\n';
+		return 1;
+	}
+	for (size_t i = 0; i < ref.rows(); ++i) {
+		for (size_t j = 0; j < ref.cols(); ++j) {
+			if (Scalar(A(i, j)) != ref(i, j)) {
+				++nrOfFailedTests;
+				if (reportTestCases && nrOfFailedTests < 10) std::cerr << "FAIL: " << label << " (" << i << ',' << j << ") " << A(i, j) << " != " << ref(i, j) << '\n';
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// write a test matrix in Matrix Market format and read it back, sparse and dense
+int VerifyMatrixMarketRoundTrip(const std::string& testMatrix, bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas;
+	int nrOfFailedTests = 0;
+	matrix<double> ref = getTestMatrix(testMatrix);
+	if (ref.rows() == 0) return 1;
+	sparse_matrix<double> S(ref);
+
+	std::stringstream coordinate;
+	writeMatrixMarket(coordinate, S);
+	auto csc = readMatrixMarket<double, SparseFormat::CSC>(coordinate);
+	nrOfFailedTests += CompareMatrices(csc, ref, testMatrix + " coordinate", reportTestCases);
+	if (csc.nnz() != S.nnz()) ++nrOfFailedTests;
+
+	std::stringstream array;
+	writeMatrixMarket(array, ref);
+	matrix<double> dense;
+	readMatrixMarket(array, dense);
+	nrOfFailedTests += CompareMatrices(dense, ref, testMatrix + " array", reportTestCases);
+
+	// conversion to the target type while reading
+	std::stringstream converted;
+	writeMatrixMarket(converted, S);
+	auto p = readMatrixMarket< sw::universal::posit<32, 2> >(converted);
+	nrOfFailedTests += CompareMatrices(p, matrix< sw::universal::posit<32, 2> >(ref), testMatrix + " posit", reportTestCases);
+	return nrOfFailedTests;
+}
+
+// symmetric, skew-symmetric, pattern, and array layouts
+int VerifyMatrixMarketVariants(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas;
+	int nrOfFailedTests = 0;
+	matrix<double> ref = {
+		{  4, -1,  0 },
+		{ -1,  4, -2 },
+		{  0, -2,  5 }
+	};
+	std::stringstream symmetric(
+		"%%MatrixMarket matrix coordinate real symmetric\n"
+		"% lower triangle only\n"
+		"\n"
+		"3 3 5\n"
+		"1 1 4\n"
+		"2 1 -1\n"
+		"2 2 4.0\n"
+		"3 2 -2e0\n"
+		"3 3 5\n");
+	nrOfFailedTests += CompareMatrices(readMatrixMarket<double>(symmetric), ref, "symmetric coordinate", reportTestCases);
+
+	std::stringstream symmetricArray(
+		"%%MatrixMarket matrix array real symmetric\n"
+		"3 3\n"
+		"4\n-1\n0\n4\n-2\n5\n");
+	matrix<double> A;
+	readMatrixMarket(symmetricArray, A);
+	nrOfFailedTests += CompareMatrices(A, ref, "symmetric array", reportTestCases);
+
+	matrix<double> skewRef = {
+		{ 0, -2, 0 },
+		{ 2,  0, 3 },
+		{ 0, -3, 0 }
+	};
+	std::stringstream skew(
+		"%%MatrixMarket matrix coordinate integer skew-symmetric\n"
+		"3 3 2\n"
+		"2 1 2\n"
+		"3 2 -3\n");
+	nrOfFailedTests += CompareMatrices(readMatrixMarket<double>(skew), skewRef, "skew-symmetric", reportTestCases);
+
+	matrix<double> patternRef = {
+		{ 1, 0, 0 },
+		{ 0, 0, 1 }
+	};
+	std::stringstream pattern(
+		"%%MatrixMarket matrix coordinate pattern general\n"
+		"2 3 2\n"
+		"1 1\n"
+		"2 3\n");
+	nrOfFailedTests += CompareMatrices(readMatrixMarket<float>(pattern), matrix<float>(patternRef), "pattern", reportTestCases);
+
+	std::stringstream complex("%%MatrixMarket matrix coordinate complex general\n1 1 1\n1 1 1 0\n");
+	try {
+		readMatrixMarket<double>(complex);
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: complex field not rejected\n";
+	}
+	catch (const std::runtime_error&) {
+		// correctly rejected
+	}
+
+	// an entry count beyond the 32-bit sparse indices is rejected before anything is reserved for it
+	std::stringstream oversized("%%MatrixMarket matrix coordinate real symmetric\n4 4 3000000000\n1 1 1\n");
+	try {
+		readMatrixMarket<double>(oversized);
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: oversized entry count not rejected\n";
+	}
+	catch (const std::runtime_error&) {
+		// correctly rejected
+	}
+	return nrOfFailedTests;
+}
+
+// save a test matrix in the binary format and restore it through the memory-mapped view
+int VerifyBinaryMatrix(const std::string& testMatrix, bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas;
+	int nrOfFailedTests = 0;
+	matrix<double> ref = getTestMatrix(testMatrix);
+	if (ref.rows() == 0) return 1;
+	sparse_matrix<double> S(ref);
+	std::filesystem::path dir = std::filesystem::temp_directory_path();
+	std::string sparseFile = (dir / (testMatrix + "_csr.umx")).string();
+	std::string denseFile = (dir / (testMatrix + "_dense.umx")).string();
+	saveBinaryMatrix(sparseFile, sparse_matrix<double, SparseFormat::CSC>(S));
+	saveBinaryMatrix(denseFile, ref);
+	{
+		BinaryMatrixView csr(sparseFile);
+		if (!csr.is_sparse() || csr.nnz() != S.nnz()) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << testMatrix << " binary CSR header\n";
+		}
+		nrOfFailedTests += CompareMatrices(csr.dense<double>(), ref, testMatrix + " binary CSR dense", reportTestCases);
+		nrOfFailedTests += CompareMatrices(csr.sparse<double, SparseFormat::CSC>(), ref, testMatrix + " binary CSR sparse", reportTestCases);
+		using Posit = sw::universal::posit<32, 2>;
+		nrOfFailedTests += CompareMatrices(csr.sparse<Posit>(), matrix<Posit>(ref), testMatrix + " binary CSR posit", reportTestCases);
+
+		BinaryMatrixView dense(denseFile);
+		if (dense.is_sparse() || dense.rows() != ref.rows() || dense.cols() != ref.cols()) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << testMatrix << " binary dense header\n";
+		}
+		nrOfFailedTests += CompareMatrices(dense.dense<double>(), ref, testMatrix + " binary dense", reportTestCases);
+		nrOfFailedTests += CompareMatrices(dense.sparse<float>(), matrix<float>(ref), testMatrix + " binary dense sparse", reportTestCases);
+	}
+	std::filesystem::remove(sparseFile);
+	std::filesystem::remove(denseFile);
+	return nrOfFailedTests;
+}
+
+// corrupt binary matrix files must be rejected when the view is constructed
+int VerifyCorruptBinaryMatrix(bool reportTestCases) {
+	using namespace sw::numeric::containers;
+	using namespace sw::blas;
+	int nrOfFailedTests = 0;
+	matrix<double> ref = {
+		{ 1, 0, 2 },
+		{ 0, 3, 0 }
+	};
+	std::string filename = (std::filesystem::temp_directory_path() / "corrupt_csr.umx").string();
+	saveBinaryMatrix(filename, sparse_matrix<double>(ref));
+	std::string image;
+	{
+		std::ifstream fi(filename, std::ios::binary);
+		image.assign(std::istreambuf_iterator<char>(fi), std::istreambuf_iterator<char>());
+	}
+	constexpr size_t headerSize = sizeof(BinaryMatrixHeader);
+	constexpr size_t offsetsAt = headerSize;                    // 3 row offsets: 0, 2, 3
+	constexpr size_t indicesAt = headerSize + 3 * sizeof(uint32_t);  // 3 column indices: 0, 2, 1
+	auto patch32 = [](std::string& bytes, size_t at, uint32_t v) { std::memcpy(&bytes[at], &v, sizeof(v)); };
+	auto patch64 = [](std::string& bytes, size_t at, uint64_t v) { std::memcpy(&bytes[at], &v, sizeof(v)); };
+	auto rejects = [&](const std::string& bytes, const std::string& label) {
+		{
+			std::ofstream fo(filename, std::ios::binary);
+			fo.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		}
+		try {
+			BinaryMatrixView view(filename);
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << label << " not rejected\n";
+		}
+		catch (const std::runtime_error&) {
+			// correctly rejected
+		}
+	};
+
+	std::string bytes = image;
+	patch32(bytes, offsetsAt, 1);
+	rejects(bytes, "first row offset not 0");
+	bytes = image;
+	patch32(bytes, offsetsAt + sizeof(uint32_t), 4);
+	rejects(bytes, "decreasing row offsets");
+	bytes = image;
+	patch32(bytes, offsetsAt + 2 * sizeof(uint32_t), 2);
+	rejects(bytes, "last row offset not nnz");
+	bytes = image;
+	patch32(bytes, indicesAt + sizeof(uint32_t), 3);
+	rejects(bytes, "column index outside of the matrix");
+	bytes = image;
+	patch32(bytes, indicesAt, 2);
+	patch32(bytes, indicesAt + sizeof(uint32_t), 0);
+	rejects(bytes, "unsorted column indices");
+	bytes = image;
+	patch32(bytes, indicesAt, 2);
+	rejects(bytes, "duplicate column indices");
+	bytes = image;
+	patch64(bytes, offsetof(BinaryMatrixHeader, nnz), uint64_t(1) << 62);
+	rejects(bytes, "nnz beyond the mapping");
+	bytes = image;
+	patch64(bytes, offsetof(BinaryMatrixHeader, rows), ~uint64_t(0));
+	rejects(bytes, "rows beyond the mapping");
+	bytes = image;
+	patch32(bytes, offsetof(BinaryMatrixHeader, layout), static_cast<uint32_t>(BinaryMatrixLayout::Dense));
+	patch64(bytes, offsetof(BinaryMatrixHeader, rows), uint64_t(1) << 32);
+	patch64(bytes, offsetof(BinaryMatrixHeader, cols), uint64_t(1) << 32);
+	patch64(bytes, offsetof(BinaryMatrixHeader, nnz), 0);
+	rejects(bytes, "dense size overflow");
+	bytes = image;
+	patch32(bytes, offsetof(BinaryMatrixHeader, layout), static_cast<uint32_t>(BinaryMatrixLayout::Dense));
+	patch64(bytes, offsetof(BinaryMatrixHeader, rows), 1);
+	patch64(bytes, offsetof(BinaryMatrixHeader, cols), 1);
+	rejects(bytes, "dense nnz not rows*cols");
+
+	// the unmodified image still loads
+	{
+		std::ofstream fo(filename, std::ios::binary);
+		fo.write(image.data(), static_cast<std::streamsize>(image.size()));
+	}
+	nrOfFailedTests += CompareMatrices(BinaryMatrixView(filename).dense<double>(), ref, "binary CSR image", reportTestCases);
+	std::filesystem::remove(filename);
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "Matrix Market and binary matrix files";
+	std::string test_tag    = "matrix files";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyMatrixMarketRoundTrip("h3", reportTestCases), test_tag, "Matrix Market h3");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyMatrixMarketVariants(reportTestCases), test_tag, "Matrix Market variants");
+	nrOfFailedTestCases += ReportTestResult(VerifyMatrixMarketRoundTrip("b1_ss", reportTestCases), test_tag, "Matrix Market b1_ss");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryMatrix("b1_ss", reportTestCases), test_tag, "binary b1_ss");
+	nrOfFailedTestCases += ReportTestResult(VerifyCorruptBinaryMatrix(reportTestCases), test_tag, "binary corrupt files");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyMatrixMarketRoundTrip("bcsstk01", reportTestCases), test_tag, "Matrix Market bcsstk01");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryMatrix("bcsstk01", reportTestCases), test_tag, "binary bcsstk01");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyMatrixMarketRoundTrip("west0132", reportTestCases), test_tag, "Matrix Market west0132");
+	nrOfFailedTestCases += ReportTestResult(VerifyBinaryMatrix("steam1", reportTestCases), test_tag, "binary steam1");
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,258 @@
+// conv2d.cpp: direct, im2col, and Winograd mixed-precision convolutions
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+// standard library
+#include <cmath>
+#include <random>
+#include <vector>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/dnn/dnn.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+namespace sw { namespace dnn {
+
+template<typename T>
+std::vector<T> RandomTensor(size_t n, unsigned seed) {
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<T> v(n);
+	for (auto& e : v) e = T(distribution(generator));
+	return v;
+}
+
+// convolution in double of the values the conv2d sees
+template<typename Conv>
+std::vector<double> ReferenceConvolution(const Conv& conv, const std::vector<typename Conv::input_type>& input, size_t N, size_t H, size_t W) {
+	const conv2d_parameters& p = conv.parameters();
+	const size_t P = conv.output_height(H), Q = conv.output_width(W);
+	const size_t C = p.in_channels, K = p.out_channels, R = p.kernel_height, S = p.kernel_width;
+	std::vector<double> y(N * K * P * Q);
+	for (size_t n = 0; n < N; ++n) {
+		for (size_t k = 0; k < K; ++k) {
+			for (size_t oh = 0; oh < P; ++oh) {
+				for (size_t ow = 0; ow < Q; ++ow) {
+					double sum = double(conv.bias()[k]);
+					for (size_t c = 0; c < C; ++c) {
+						for (size_t r = 0; r < R; ++r) {
+							for (size_t s = 0; s < S; ++s) {
+								long long h = static_cast<long long>(oh * p.stride_h + r * p.dilation_h) - static_cast<long long>(p.pad_h);
+								long long w = static_cast<long long>(ow * p.stride_w + s * p.dilation_w) - static_cast<long long>(p.pad_w);
+								if (h < 0 || h >= static_cast<long long>(H) || w < 0 || w >= static_cast<long long>(W)) continue;
+								sum += double(conv.weights()[((k * C + c) * R + r) * S + s]) * double(input[((n * C + c) * H + size_t(h)) * W + size_t(w)]);
+							}
+						}
+					}
+					y[((n * K + k) * P + oh) * Q + ow] = sum;
+				}
+			}
+		}
+	}
+	return y;
+}
+
+// each algorithm against the double reference, relative to the magnitude of the products
+template<typename InputT, typename WeightT, typename AccumT, typename OutputT>
+int VerifyAlgorithms(bool reportTestCases, const conv2d_parameters& params, size_t N, size_t H, size_t W, double tolerance) {
+	int nrOfFailedTestCases = 0;
+	conv2d<InputT, WeightT, AccumT, OutputT> conv(params, 1);
+	conv.set_weights(RandomTensor<WeightT>(params.out_channels * params.in_channels * params.kernel_height * params.kernel_width, 3));
+	conv.set_bias(RandomTensor<AccumT>(params.out_channels, 5));
+	auto input = RandomTensor<InputT>(N * params.in_channels * H * W, 7);
+	auto reference = ReferenceConvolution(conv, input, N, H, W);
+	const double scale = std::sqrt(double(params.in_channels * params.kernel_height * params.kernel_width));
+
+	std::vector<conv2d_algorithm> algorithms = { conv2d_algorithm::Direct, conv2d_algorithm::Im2col };
+	if (conv.winograd_applicable()) algorithms.push_back(conv2d_algorithm::Winograd);
+	for (auto algorithm : algorithms) {
+		std::vector<OutputT> output;
+		conv.forward(input, N, H, W, output, algorithm);
+		double maxError{ 0.0 };
+		for (size_t i = 0; i < output.size(); ++i) maxError = std::max(maxError, std::abs(double(output[i]) - reference[i]));
+		if (!(maxError <= tolerance * scale)) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: " << to_string(algorithm) << " C=" << params.in_channels << " K=" << params.out_channels << ' ' << params.kernel_height << 'x' << params.kernel_width
+				<< " stride " << params.stride_h << " pad " << params.pad_h << " dilation " << params.dilation_h << " error " << maxError << '\n';
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+// every schedule produces the same bits for any number of threads
+template<typename InputT, typename WeightT, typename AccumT, typename OutputT>
+int VerifyThreadInvariance(bool reportTestCases, const conv2d_parameters& params, size_t N, size_t H, size_t W, unsigned nrThreads) {
+	int nrOfFailedTestCases = 0;
+	conv2d<InputT, WeightT, AccumT, OutputT> serial(params, 1), threaded(params, nrThreads);
+	auto weights = RandomTensor<WeightT>(params.out_channels * params.in_channels * params.kernel_height * params.kernel_width, 11);
+	serial.set_weights(weights);
+	threaded.set_weights(weights);
+	std::vector<conv2d_algorithm> algorithms = { conv2d_algorithm::Direct, conv2d_algorithm::Im2col };
+	if (serial.winograd_applicable()) algorithms.push_back(conv2d_algorithm::Winograd);
+	// a batch larger than the pool splits samples, a single sample splits the sample
+	for (size_t batch : { N, size_t(1) }) {
+		auto input = RandomTensor<InputT>(batch * params.in_channels * H * W, 13);
+		for (auto algorithm : algorithms) {
+			std::vector<OutputT> a, b;
+			serial.forward(input, batch, H, W, a, algorithm);
+			threaded.forward(input, batch, H, W, b, algorithm);
+			// twice, to reuse the pool and workspaces
+			threaded.forward(input, batch, H, W, b, algorithm);
+			if (a != b) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: " << to_string(algorithm) << " batch " << batch << " differs on " << nrThreads << " threads\n";
+			}
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+int VerifySchedule(bool reportTestCases) {
+	int nrOfFailedTestCases = 0;
+	auto expect = [&](const conv2d_parameters& p, size_t N, size_t H, size_t W, unsigned threads, conv2d_algorithm algorithm, conv2d_partition partition) {
+		conv2d<float, float, float, float> conv(p, threads);
+		conv2d_schedule s = conv.schedule(N, H, W);
+		if (s.algorithm != algorithm || s.partition != partition) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) std::cerr << "FAIL: schedule C=" << p.in_channels << " K=" << p.out_channels << " N=" << N << " selected " << to_string(s.algorithm) << '\n';
+		}
+	};
+	conv2d_parameters wide{ 64, 64, 3, 3, 1, 1, 1, 1, 1, 1 };
+	conv2d_parameters strided{ 64, 64, 3, 3, 2, 2, 1, 1, 1, 1 };
+	conv2d_parameters thin{ 1, 2, 3, 3, 1, 1, 0, 0, 1, 1 };
+	expect(wide, 8, 28, 28, 4, conv2d_algorithm::Winograd, conv2d_partition::Batch);
+	expect(wide, 1, 28, 28, 4, conv2d_algorithm::Winograd, conv2d_partition::Channels);
+	expect(strided, 8, 28, 28, 1, conv2d_algorithm::Im2col, conv2d_partition::Batch);
+	expect(thin, 2, 16, 16, 4, conv2d_algorithm::Direct, conv2d_partition::Channels);
+	// a half precision accumulator does not absorb the cancellation of the Winograd transforms
+	using half = sw::universal::half;
+	conv2d<half, half, half, half> low(wide, 1);
+	if (low.schedule(8, 28, 28).algorithm == conv2d_algorithm::Winograd) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: Winograd selected for a half precision accumulator\n";
+	}
+	return nrOfFailedTestCases;
+}
+
+int VerifyArguments(bool reportTestCases) {
+	int nrOfFailedTestCases = 0;
+	conv2d<float, float, float, float> conv(conv2d_parameters{ 2, 2, 3, 3, 2, 2, 0, 0, 1, 1 }, 1);
+	std::vector<float> output;
+	try {
+		conv.forward(std::vector<float>(2 * 2 * 8 * 8), 2, 8, 8, output, conv2d_algorithm::Winograd);
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: Winograd accepted a strided convolution\n";
+	}
+	catch (const std::invalid_argument& err) {
+		if (reportTestCases) std::cerr << "expected diagnostic: " << err.what() << '\n';
+	}
+	try {
+		conv.forward(std::vector<float>(10), 2, 8, 8, output);
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: input of the wrong size accepted\n";
+	}
+	catch (const std::invalid_argument& err) {
+		if (reportTestCases) std::cerr << "expected diagnostic: " << err.what() << '\n';
+	}
+	return nrOfFailedTestCases;
+}
+
+}} // namespace sw::dnn
+
+int main()
+try {
+	using namespace sw::universal;
+	using namespace sw::dnn;
+
+	std::string test_suite  = "mixed-precision conv2d";
+	std::string test_tag    = "conv2d";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	conv2d_parameters same3x3{ 5, 6, 3, 3, 1, 1, 1, 1, 1, 1 };     // odd output size, partial Winograd tiles
+	conv2d_parameters valid3x3{ 3, 4, 3, 3, 1, 1, 0, 0, 1, 1 };
+	conv2d_parameters strided{ 4, 3, 3, 3, 2, 2, 1, 1, 1, 1 };
+	conv2d_parameters dilated{ 2, 3, 3, 3, 1, 1, 2, 2, 2, 2 };
+	conv2d_parameters rect{ 3, 2, 5, 1, 1, 2, 2, 0, 1, 1 };        // 5x1 filter, anisotropic stride and padding
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAlgorithms<float, float, double, double>(reportTestCases, same3x3, 2, 9, 7, 1.0e-12), "conv2d", "same 3x3");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	// float operands accumulated in double are exact up to the rounding of the sums
+	nrOfFailedTestCases += ReportTestResult(VerifyAlgorithms<float, float, double, double>(reportTestCases, same3x3, 2, 9, 7, 1.0e-12), "conv2d", "same 3x3");
+	nrOfFailedTestCases += ReportTestResult(VerifyAlgorithms<float, float, double, double>(reportTestCases, valid3x3, 1, 8, 8, 1.0e-12), "conv2d", "valid 3x3");
+	nrOfFailedTestCases += ReportTestResult(VerifyAlgorithms<float, float, double, double>(reportTestCases, strided, 2, 10, 9, 1.0e-12), "conv2d", "stride 2");
+	nrOfFailedTestCases += ReportTestResult(VerifyAlgorithms<float, float, double, double>(reportTestCases, dilated, 1, 9, 9, 1.0e-12), "conv2d", "dilation 2");
+	nrOfFailedTestCases += ReportTestResult(VerifyAlgorithms<float, float, double, double>(reportTestCases, rect, 2, 7, 6, 1.0e-12), "conv2d", "5x1");
+	nrOfFailedTestCases += ReportTestResult(VerifySchedule(reportTestCases), "conv2d", "schedule");
+	nrOfFailedTestCases += ReportTestResult(VerifyArguments(reportTestCases), "conv2d", "arguments");
+#endif
+
+#if REGRESSION_LEVEL_2
+	// narrow inputs and weights, float accumulation, rounded outputs
+	using fp8 = cfloat<8, 2, std::uint8_t, true, true, false>;
+	nrOfFailedTestCases += ReportTestResult((VerifyAlgorithms<half, fp8, float, half>(reportTestCases, same3x3, 2, 9, 7, 1.0e-3)), "conv2d", "half/fp8/float/half");
+	nrOfFailedTestCases += ReportTestResult((VerifyThreadInvariance<float, float, float, float>(reportTestCases, same3x3, 5, 9, 7, 3)), "conv2d", "threads float");
+	nrOfFailedTestCases += ReportTestResult((VerifyThreadInvariance<half, fp8, float, half>(reportTestCases, strided, 5, 10, 9, 3)), "conv2d", "threads half/fp8");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult((VerifyAlgorithms<posit<16, 1>, posit<8, 0>, posit<32, 2>, posit<16, 1>>(reportTestCases, same3x3, 1, 6, 6, 1.0e-3)), "conv2d", "posit mixed");
+	nrOfFailedTestCases += ReportTestResult((VerifyThreadInvariance<posit<16, 1>, posit<8, 0>, posit<32, 2>, posit<16, 1>>(reportTestCases, valid3x3, 3, 6, 6, 2)), "conv2d", "threads posit");
+#endif
+
+#if REGRESSION_LEVEL_4
+
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
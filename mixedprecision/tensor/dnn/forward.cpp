@@ -0,0 +1,256 @@
+// forward.cpp: batched forward pass of the DNN layer stack with mixed-precision weights, activations, and accumulators
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+// standard library
+#include <cmath>
+#include <random>
+#include <vector>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/dnn/dnn.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+namespace sw { namespace dnn {
+
+std::vector<double> RandomSamples(size_t n, unsigned seed) {
+	std::mt19937 generator(seed);
+	std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+	std::vector<double> v(n);
+	for (auto& e : v) e = distribution(generator);
+	return v;
+}
+
+// the conv2d schedule of the layer against a direct convolution in double
+int VerifyConvolution(bool reportTestCases, unsigned C, unsigned H, unsigned W, unsigned K, unsigned R, unsigned S, unsigned stride, unsigned padding, Activation activation, unsigned dilation = 1) {
+	int nrOfFailedTestCases = 0;
+	ConvolutionalLayer<double, double, double> conv(1, C, H, W, activation, K, R, S, stride, padding, dilation);
+	std::mt19937 generator(7);
+	conv.initialize(generator);
+	for (unsigned k = 0; k < K; ++k) conv.setBias(k, 0.125 * k);
+	const size_t batch = 3;
+	auto input = RandomSamples(batch * conv.inputSize(), 11);
+	std::vector<double> output(batch * conv.outputSize());
+	conv.forward(batch, input.data(), output.data(), nullptr);
+
+	const unsigned P = conv.outputHeight(), Q = conv.outputWidth();
+	const auto& w = conv.weights();
+	double maxError{ 0.0 };
+	for (size_t b = 0; b < batch; ++b) {
+		for (unsigned k = 0; k < K; ++k) {
+			for (unsigned p = 0; p < P; ++p) {
+				for (unsigned q = 0; q < Q; ++q) {
+					double sum = 0.125 * k;
+					for (unsigned c = 0; c < C; ++c) {
+						for (unsigned r = 0; r < R; ++r) {
+							for (unsigned s = 0; s < S; ++s) {
+								long long h = static_cast<long long>(p * stride + r * dilation) - padding;
+								long long x = static_cast<long long>(q * stride + s * dilation) - padding;
+								if (h < 0 || h >= H || x < 0 || x >= W) continue;
+								sum += w[((k * C + c) * R + r) * S + s] * input[b * conv.inputSize() + (c * H + size_t(h)) * W + size_t(x)];
+							}
+						}
+					}
+					double expected = activate(activation, sum);
+					double computed = output[b * conv.outputSize() + (size_t(k) * P + p) * Q + q];
+					maxError = std::max(maxError, std::abs(expected - computed));
+				}
+			}
+		}
+	}
+	if (maxError > 1.0e-12) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: " << to_string(conv.convolution_operator().schedule(batch, H, W).algorithm) << " convolution C=" << C << " H=" << H << " W=" << W << " K=" << K << " R=" << R << " S=" << S << " stride=" << stride << " padding=" << padding << " dilation=" << dilation << " error " << maxError << '\n';
+	}
+	return nrOfFailedTestCases;
+}
+
+// gemm against a dot product per node in double
+int VerifyFullyConnected(bool reportTestCases, unsigned nrInputs, unsigned nrNodes, Activation activation) {
+	int nrOfFailedTestCases = 0;
+	FullyConnectedLayer<double, double, double> fc(nrNodes, 1, activation);
+	fc.build(nrInputs);
+	std::mt19937 generator(5);
+	fc.initialize(generator);
+	for (unsigned j = 0; j < nrNodes; ++j) fc.setBias(j, -0.25 + 0.0625 * j);
+	const size_t batch = 5;
+	auto input = RandomSamples(batch * nrInputs, 13);
+	std::vector<double> output(batch * nrNodes);
+	fc.forward(batch, input.data(), output.data(), nullptr);
+
+	const auto& w = fc.weights();
+	double maxError{ 0.0 };
+	for (size_t b = 0; b < batch; ++b) {
+		for (unsigned j = 0; j < nrNodes; ++j) {
+			double sum = -0.25 + 0.0625 * j;
+			for (unsigned i = 0; i < nrInputs; ++i) sum += w[size_t(j) * nrInputs + i] * input[b * nrInputs + i];
+			maxError = std::max(maxError, std::abs(activate(activation, sum) - output[b * nrNodes + j]));
+		}
+	}
+	if (maxError > 1.0e-12) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: fully connected " << nrInputs << " x " << nrNodes << " error " << maxError << '\n';
+	}
+	return nrOfFailedTestCases;
+}
+
+// a small convolutional network: the result of a sample does not depend on the batch it is in, nor on the number of threads
+template<typename WeightType, typename ActivationType, typename AccumulatorType>
+int VerifyBatchInvariance(bool reportTestCases, unsigned nrThreads) {
+	int nrOfFailedTestCases = 0;
+	dnn<float> network("invariance", 0.1f);
+	auto conv1 = CreateConvolutionLayer<WeightType, ActivationType, AccumulatorType>(1, 2, 12, 12, Activation::Tanh, 4, 3, 3, 1, 1);
+	auto conv2 = CreateConvolutionLayer<WeightType, ActivationType, AccumulatorType>(1, 4, 12, 12, Activation::ReLU, 6, 3, 3, 2, 0);
+	auto fc = CreateFullyConnectedLayer<WeightType, ActivationType, AccumulatorType>(10ul, Activation::Sigmoid);
+	network.addLayer(conv1);
+	network.addLayer(conv2);
+	network.addLayer(fc);
+	const size_t batch = 7;
+	network.build(0, batch);
+	network.initialize(3);
+	auto input = RandomSamples(batch * network.inputSize(), 17);
+
+	std::vector<double> batched = network.forward(input, batch);
+	network.setThreads(nrThreads);
+	std::vector<double> threaded = network.forward(input, batch);
+	network.setThreads(1);
+	if (batched != threaded) {
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: " << nrThreads << " threads differ from 1 thread\n";
+	}
+	for (size_t b = 0; b < batch; ++b) {
+		std::vector<double> sample(input.begin() + static_cast<std::ptrdiff_t>(b * network.inputSize()), input.begin() + static_cast<std::ptrdiff_t>((b + 1) * network.inputSize()));
+		const auto& single = network.forward(sample, 1);
+		for (size_t j = 0; j < network.outputSize(); ++j) {
+			if (single[j] != batched[b * network.outputSize() + j]) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: sample " << b << " output " << j << " depends on the batch\n";
+				break;
+			}
+		}
+		// outputs are values of the activation type
+		for (size_t j = 0; j < network.outputSize(); ++j) {
+			if (double(ActivationType(single[j])) != single[j]) {
+				++nrOfFailedTestCases;
+				if (reportTestCases) std::cerr << "FAIL: output " << single[j] << " is not rounded to the activation type\n";
+				break;
+			}
+		}
+	}
+	return nrOfFailedTestCases;
+}
+
+int VerifyShapeMismatch(bool reportTestCases) {
+	int nrOfFailedTestCases = 0;
+	dnn<float> network("mismatch", 0.1f);
+	auto conv = CreateConvolutionLayer<float, float>(1, 1, 8, 8, Activation::ReLU);
+	auto conv2 = CreateConvolutionLayer<float, float>(1, 3, 8, 8, Activation::ReLU);
+	network.addLayer(conv);
+	network.addLayer(conv2);
+	try {
+		network.build();
+		++nrOfFailedTestCases;
+		if (reportTestCases) std::cerr << "FAIL: incompatible layers not detected\n";
+	}
+	catch (const std::runtime_error& err) {
+		if (reportTestCases) std::cerr << "expected diagnostic: " << err.what() << '\n';
+	}
+	return nrOfFailedTestCases;
+}
+
+}} // namespace sw::dnn
+
+int main()
+try {
+	using namespace sw::universal;
+	using namespace sw::dnn;
+
+	std::string test_suite  = "dnn forward pass";
+	std::string test_tag    = "forward";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using WeightType     = cfloat<8, 2, std::uint8_t, true, true, false>;
+	using ActivationType = lns<8, 3, std::uint8_t>;
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution(reportTestCases, 3, 9, 7, 4, 3, 3, 2, 1, Activation::Tanh), "conv", "C=3 K=4 stride 2");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchInvariance<WeightType, ActivationType, float>(reportTestCases, 3), "batch", "cfloat/lns");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution(reportTestCases, 1, 6, 6, 1, 3, 3, 1, 1, Activation::Identity), "conv", "single channel");
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution(reportTestCases, 3, 9, 7, 4, 3, 3, 2, 1, Activation::Tanh), "conv", "C=3 K=4 stride 2");
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution(reportTestCases, 2, 8, 8, 5, 5, 5, 1, 0, Activation::ReLU), "conv", "5x5 no padding");
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution(reportTestCases, 2, 5, 6, 3, 1, 1, 1, 0, Activation::Sigmoid), "conv", "1x1");
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution(reportTestCases, 16, 8, 8, 16, 3, 3, 1, 1, Activation::Identity), "conv", "Winograd C=16 K=16");
+	nrOfFailedTestCases += ReportTestResult(VerifyConvolution(reportTestCases, 2, 9, 9, 3, 3, 3, 1, 2, Activation::ReLU, 2), "conv", "dilation 2");
+	nrOfFailedTestCases += ReportTestResult(VerifyFullyConnected(reportTestCases, 17, 9, Activation::Tanh), "gemm", "17 x 9");
+	nrOfFailedTestCases += ReportTestResult(VerifyFullyConnected(reportTestCases, 1, 4, Activation::ReLU), "gemm", "1 x 4");
+	nrOfFailedTestCases += ReportTestResult(VerifyShapeMismatch(reportTestCases), "build", "shape mismatch");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using WeightType     = cfloat<8, 2, std::uint8_t, true, true, false>;
+	using ActivationType = lns<8, 3, std::uint8_t>;
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchInvariance<float, float, float>(reportTestCases, 3), "batch", "float");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchInvariance<WeightType, ActivationType, float>(reportTestCases, 3), "batch", "cfloat/lns");
+#endif
+
+#if REGRESSION_LEVEL_3
+	using WeightType = cfloat<8, 2, std::uint8_t, true, true, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchInvariance<WeightType, lns<5, 2, std::uint8_t>, double>(reportTestCases, 4), "batch", "cfloat/lns double accumulator");
+#endif
+
+#if REGRESSION_LEVEL_4
+
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
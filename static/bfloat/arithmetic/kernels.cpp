@@ -0,0 +1,340 @@
+// kernels.cpp: test suite runner for the batch kernels over arrays of bfloat16
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <universal/number/bfloat/bfloat.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace local {
+	// operands that cover normals, subnormals, zeros, infinities, NaNs, and values that overflow when combined
+	std::vector<sw::universal::bfloat16> operands(size_t n, unsigned seed) {
+		using namespace sw::universal;
+		std::mt19937 generator(seed);
+		std::uniform_int_distribution<unsigned> bits(0, 0xFFFFu);
+		std::uniform_real_distribution<float> values(-8.0f, 8.0f);
+		std::vector<bfloat16> v(n);
+		for (size_t i = 0; i < n; ++i) {
+			if (i % 3 == 0) v[i].setbits(bits(generator)); else v[i] = values(generator);
+		}
+		if (n > 5) {
+			v[1].setbits(0x0001u);      // smallest subnormal
+			v[2] = SpecificValue::maxpos;
+			v[3] = SpecificValue::infneg;
+			v[4].setbits(0x7FC0u);      // quiet NaN
+			v[5] = 0.0f;
+		}
+		return v;
+	}
+
+	bool same(sw::universal::bfloat16 a, sw::universal::bfloat16 b) {
+		return a.bits() == b.bits() || (a.isnan() && b.isnan());
+	}
+
+	float widen(uint16_t bits) {
+		uint32_t raw = uint32_t(bits) << 16;
+		float f;
+		std::memcpy(&f, &raw, 4);
+		return f;
+	}
+
+	// reference rounding that shares no code with the kernels or the scalar conversion: select the nearer
+	// of the two bfloat16 neighbours of f by their distance in double precision, ties to the even encoding
+	sw::universal::bfloat16 nearest(float f) {
+		sw::universal::bfloat16 r;
+		uint32_t raw;
+		std::memcpy(&raw, &f, 4);
+		if (std::isnan(f)) {
+			r.setbits(0x7FC0u);
+			return r;
+		}
+		uint16_t below = static_cast<uint16_t>(raw >> 16);  // the neighbour towards zero
+		uint16_t above = static_cast<uint16_t>(below + 1u);  // the neighbour away from zero, infinity beyond maxpos
+		double v = std::abs(double(f));
+		double lo = std::abs(double(widen(below)));
+		double hi = ((below & 0x7FFFu) == 0x7F7Fu ? std::ldexp(1.0, 128) : std::abs(double(widen(above))));
+		if (v == lo) r.setbits(below);
+		else if (v - lo < hi - v) r.setbits(below);
+		else if (v - lo > hi - v) r.setbits(above);
+		else r.setbits((below & 1u) ? above : below);
+		return r;
+	}
+
+	// the double counterpart: bisect the ordered encodings for the neighbour towards zero of |d|
+	sw::universal::bfloat16 nearest(double d) {
+		sw::universal::bfloat16 r;
+		if (std::isnan(d)) {
+			r.setbits(0x7FC0u);
+			return r;
+		}
+		double v = std::abs(d);
+		uint16_t below = 0;
+		for (uint16_t step = 0x4000u; step > 0; step >>= 1) {
+			uint16_t probe = static_cast<uint16_t>(below + step);
+			if (probe <= 0x7F80u && double(widen(probe)) <= v) below = probe;
+		}
+		uint16_t sign = std::signbit(d) ? 0x8000u : 0u;
+		uint16_t above = static_cast<uint16_t>(below + 1u);
+		double lo = double(widen(below));
+		double hi = (below == 0x7F7Fu ? std::ldexp(1.0, 128) : double(widen(above)));
+		uint16_t bits = below;
+		if (below == 0x7F80u || v == lo) bits = below;
+		else if (v - lo > hi - v || (v - lo == hi - v && (below & 1u))) bits = above;
+		r.setbits(static_cast<uint16_t>(sign | bits));
+		return r;
+	}
+}
+
+// the element-wise kernels must round the float result of each element to the nearest bfloat16, for every length and alignment
+int VerifyElementwiseKernels(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	for (size_t n : { 0, 1, 7, 8, 9, 15, 16, 17, 64, 1031 }) {
+		for (size_t offset : { 0, 1, 3 }) {
+			std::vector<bfloat16> a = local::operands(n + offset, 1), b = local::operands(n + offset, 2), c = local::operands(n + offset, 3);
+			std::vector<bfloat16> sum(n + offset), product(n + offset), fused(n + offset), y(c);
+			bfloat16 alpha = -1.375f;
+			bfloat16_add(n, a.data() + offset, b.data() + offset, sum.data() + offset);
+			bfloat16_mul(n, a.data() + offset, b.data() + offset, product.data() + offset);
+			bfloat16_fma(n, a.data() + offset, b.data() + offset, c.data() + offset, fused.data() + offset);
+			bfloat16_axpy(n, alpha, a.data() + offset, y.data() + offset);
+			for (size_t i = offset; i < n + offset; ++i) {
+				// the product-sums are rounded to float first, and that float is rounded to bfloat16
+				bool ok = local::same(sum[i], local::nearest(float(a[i]) + float(b[i])))
+					&& local::same(product[i], local::nearest(float(a[i]) * float(b[i])))
+					&& local::same(fused[i], local::nearest(float(a[i]) * float(b[i]) + float(c[i])))
+					&& local::same(y[i], local::nearest(float(alpha) * float(a[i]) + float(c[i])))
+					&& local::same(sum[i], a[i] + b[i])
+					&& local::same(product[i], a[i] * b[i]);
+				if (!ok) {
+					++nrOfFailedTests;
+					if (reportTestCases) std::cerr << "FAIL: n = " << n << " offset = " << offset << " element " << i << " : " << a[i] << ", " << b[i] << ", " << c[i] << '\n';
+				}
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// narrowing rounds to nearest, ties to even, and keeps NaNs and infinities
+int VerifyNarrowing(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	struct { uint32_t f; uint16_t bf; } conversions[] = {
+		{ 0x3F80'0000u, 0x3F80u },  // 1.0
+		{ 0x3F80'7FFFu, 0x3F80u },  // below the tie rounds down
+		{ 0x3F80'8000u, 0x3F80u },  // tie to even stays
+		{ 0x3F81'8000u, 0x3F82u },  // tie to even rounds up
+		{ 0x3F80'8001u, 0x3F81u },  // above the tie rounds up
+		{ 0x7F7F'FFFFu, 0x7F80u },  // FLT_MAX rounds to infinity
+		{ 0x7F80'0000u, 0x7F80u },  // infinity
+		{ 0xFF80'0000u, 0xFF80u },  // -infinity
+		{ 0x7F80'0001u, 0x7FC0u },  // NaN with a low payload stays a NaN
+		{ 0x0000'8000u, 0x0000u },  // subnormal tie to even
+	};
+	for (auto c : conversions) {
+		float f;
+		std::memcpy(&f, &c.f, 4);
+		uint16_t narrowed = bfloat16_narrow_bits(c.f);
+		bfloat16 scalar(f);
+		if (narrowed != c.bf || scalar.bits() != c.bf) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: narrowing of " << to_hex(c.f) << " yields " << to_hex(scalar.bits()) << " instead of " << to_hex(c.bf) << '\n';
+		}
+	}
+	// the scalar conversion against the reference rounding: random floats, and floats on and around the ties
+	std::mt19937 generator(0xBF16u);
+	std::uniform_int_distribution<uint32_t> bits;
+	for (unsigned i = 0; i < (1u << 20); ++i) {
+		uint32_t raw = bits(generator);
+		if (i % 4 == 1) raw &= 0x807F'FFFFu;                                  // subnormals
+		if (i % 4 == 2) raw = (raw & 0xFFFF'0000u) | (0x7FFFu + (i / 4) % 3);  // below, on, and above the tie
+		float f;
+		std::memcpy(&f, &raw, 4);
+		bfloat16 scalar(f);
+		if (!local::same(scalar, local::nearest(f))) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: narrowing of " << to_hex(raw) << " yields " << to_hex(scalar.bits()) << " instead of " << to_hex(local::nearest(f).bits()) << '\n';
+		}
+		if (nrOfFailedTests > 24) return nrOfFailedTests;
+	}
+	// the same rounding cusps through the vector lanes and the scalar tail of a kernel
+	struct { uint16_t a, b, sum; } sums[] = {
+		{ 0x3F80u, 0x3B80u, 0x3F80u },  // 1 + 2^-8 is a tie that stays even
+		{ 0x3F81u, 0x3B80u, 0x3F82u },  // (1 + 2^-7) + 2^-8 is a tie that rounds up to even
+		{ 0x3F80u, 0x3BC0u, 0x3F81u },  // 1 + 1.5 * 2^-8 rounds up
+		{ 0x7F7Fu, 0x7F7Fu, 0x7F80u },  // maxpos + maxpos overflows to infinity
+		{ 0x7F80u, 0xFF80u, 0xFFC0u },  // inf - inf is a NaN
+	};
+	for (auto c : sums) {
+		std::vector<bfloat16> x(9), y(9), z(9);
+		for (size_t i = 0; i < 9; ++i) { x[i].setbits(c.a); y[i].setbits(c.b); }
+		bfloat16_add(9, x.data(), y.data(), z.data());
+		for (size_t i = 0; i < 9; ++i) {
+			if (z[i].bits() != c.sum && !(z[i].isnan() && ((c.sum & 0x7F80u) == 0x7F80u) && (c.sum & 0x7Fu))) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: lane " << i << " of " << to_hex(c.a) << " + " << to_hex(c.b) << " yields " << to_hex(z[i].bits()) << " instead of " << to_hex(c.sum) << '\n';
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// narrowing a double rounds once, where rounding through float would round twice
+int VerifyDoubleNarrowing(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	struct { double d; uint16_t bf; } conversions[] = {
+		{ 1.0 + std::ldexp(1.0, -8) + std::ldexp(1.0, -40), 0x3F81u },   // just above the tie, float rounds it onto the tie
+		{ 1.0 + std::ldexp(1.0, -8) - std::ldexp(1.0, -40), 0x3F80u },   // just below the tie
+		{ 1.0 + std::ldexp(1.0, -8), 0x3F80u },                           // tie to even stays
+		{ -(1.0 + std::ldexp(3.0, -8) + std::ldexp(1.0, -45)), 0xBF82u }, // negative, above the tie
+		{ std::ldexp(1.0, -133) * (1.0 + std::ldexp(1.0, -40)), 0x0001u },// smallest subnormal from just above half of it
+		{ std::ldexp(1.0, -134) * (1.0 + std::ldexp(1.0, -40)), 0x0001u },// just above half the smallest subnormal rounds up
+		{ std::ldexp(1.0, -134), 0x0000u },                               // half the smallest subnormal is a tie to zero
+		{ std::ldexp(1.0, -1074), 0x0000u },                              // double subnormal
+		{ std::ldexp(1.0, 128), 0x7F80u },                                // beyond maxpos
+		{ 3.3895313892515355e+38, 0x7F7Fu },                              // maxpos
+	};
+	for (auto c : conversions) {
+		bfloat16 scalar(c.d);
+		if (scalar.bits() != c.bf) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: narrowing of " << c.d << " yields " << to_hex(scalar.bits()) << " instead of " << to_hex(c.bf) << '\n';
+		}
+	}
+	// random doubles across the bfloat16 range, and doubles on and around the ties
+	std::mt19937_64 generator(0xBF16u);
+	std::uniform_int_distribution<uint64_t> bits;
+	std::uniform_int_distribution<uint64_t> exponents(1023 - 140, 1023 + 130);
+	for (unsigned i = 0; i < (1u << 20); ++i) {
+		uint64_t raw = bits(generator);
+		if (i % 2 == 1) raw = (raw & 0x800F'FFFF'FFFF'FFFFull) | (exponents(generator) << 52);
+		if (i % 4 == 3) raw = (raw & 0xFFFF'E000'0000'0000ull) | ((0x0000'1000'0000'0000ull + (i / 4) % 3) - 1);  // below, on, and above the tie
+		double d;
+		std::memcpy(&d, &raw, 8);
+		bfloat16 scalar(d);
+		if (!local::same(scalar, local::nearest(d))) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: narrowing of " << to_hex(raw) << " yields " << to_hex(scalar.bits()) << " instead of " << to_hex(local::nearest(d).bits()) << '\n';
+		}
+		if (nrOfFailedTests > 24) return nrOfFailedTests;
+	}
+	return nrOfFailedTests;
+}
+
+// the dot product accumulates in 8 lane partial sums that are reduced in lane order
+int VerifyDot(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	for (size_t n : { 0, 1, 5, 8, 13, 64, 1000, 4099 }) {
+		std::vector<bfloat16> x(n), y(n);
+		std::mt19937 generator(static_cast<unsigned>(n));
+		std::uniform_real_distribution<float> values(-2.0f, 2.0f);
+		for (size_t i = 0; i < n; ++i) { x[i] = values(generator); y[i] = values(generator); }
+		float partial[8] = { 0 };
+		double exact{ 0 };
+		for (size_t i = 0; i < n; ++i) {
+			partial[i % 8] += float(x[i]) * float(y[i]);
+			exact += double(x[i]) * double(y[i]);
+		}
+		float expected = partial[0];
+		for (size_t k = 1; k < 8; ++k) expected += partial[k];
+		float dot = bfloat16_dot(n, x.data(), y.data());
+		if (dot != expected || std::abs(double(dot) - exact) > 1.0e-4 * (1.0 + double(n))) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: dot of length " << n << " yields " << dot << " instead of " << expected << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite         = "bfloat16 batch kernels";
+	std::string test_tag           = "kernels";
+	bool reportTestCases           = false;
+	int nrOfFailedTestCases        = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if defined(BFLOAT_KERNELS_AVX2)
+	std::cout << "instruction set: AVX2\n";
+#elif defined(BFLOAT_KERNELS_SSE2)
+	std::cout << "instruction set: SSE2\n";
+#else
+	std::cout << "instruction set: portable\n";
+#endif
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwiseKernels(true), "bfloat16", "element-wise");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS; // ignore failures
+#else  // !MANUAL_TESTING
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyNarrowing(reportTestCases), "bfloat16", "narrowing");
+	nrOfFailedTestCases += ReportTestResult(VerifyDoubleNarrowing(reportTestCases), "bfloat16", "double narrowing");
+	nrOfFailedTestCases += ReportTestResult(VerifyElementwiseKernels(reportTestCases), "bfloat16", "element-wise");
+	nrOfFailedTestCases += ReportTestResult(VerifyDot(reportTestCases), "bfloat16", "dot");
+#endif
+
+#if REGRESSION_LEVEL_2
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
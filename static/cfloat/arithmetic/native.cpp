@@ -0,0 +1,253 @@
+// native.cpp: native arithmetic of the IEEE-754 equivalent cfloat configurations
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <random>
+// map single, double, half, and bfloat16 onto native arithmetic
+#define CFLOAT_FAST_SPECIALIZATION
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace local {
+	enum class Op { ADD, SUB, MUL, DIV };
+	const char* symbol(Op op) { return (op == Op::ADD ? "+" : op == Op::SUB ? "-" : op == Op::MUL ? "*" : "/"); }
+
+	// the correctly rounded result: double holds the exact result, or rounds it innocuously, for all four operators
+	template<typename Cfloat>
+	Cfloat reference(Op op, const Cfloat& a, const Cfloat& b) {
+		double da = double(a), db = double(b), dc{ 0 };
+		switch (op) {
+		case Op::ADD: dc = da + db; break;
+		case Op::SUB: dc = da - db; break;
+		case Op::MUL: dc = da * db; break;
+		case Op::DIV: dc = da / db; break;
+		}
+		Cfloat c{ 0 };
+		if constexpr (Cfloat::nbits == 32) c = float(dc); else c = dc;
+		if constexpr (Cfloat::isSaturating) {
+			if (c.isinf()) { if (dc < 0) c.maxneg(); else c.maxpos(); }
+		}
+		return c;
+	}
+
+	template<typename Cfloat>
+	Cfloat compute(Op op, const Cfloat& a, const Cfloat& b) {
+		switch (op) {
+		case Op::ADD: return a + b;
+		case Op::SUB: return a - b;
+		case Op::MUL: return a * b;
+		case Op::DIV: return a / b;
+		}
+		return Cfloat(0);
+	}
+
+	template<typename Cfloat>
+	bool isoperand(const Cfloat& v) { return !v.iszero() && !v.isinf() && !v.isnan(); }
+
+	template<typename Cfloat>
+	int check(bool reportTestCases, Op op, const Cfloat& a, const Cfloat& b) {
+		using namespace sw::universal;
+		Cfloat c = compute(op, a, b), ref = reference(op, a, b);
+		if (c == ref || (c.iszero() && ref.iszero())) return 0;
+		if (reportTestCases) ReportBinaryArithmeticError("FAIL", symbol(op), a, b, c, ref);
+		return 1;
+	}
+}
+
+// all encodings of the left operand against a stride of encodings of the right operand
+template<typename Cfloat>
+int VerifyNativeArithmeticSweep(bool reportTestCases, size_t stride) {
+	using namespace local;
+	static_assert(Cfloat::hasNativeArithmetic, "configuration is not mapped onto native arithmetic");
+	constexpr size_t NR_VALUES = size_t(1) << Cfloat::nbits;
+	int nrOfFailedTests = 0;
+	Cfloat a, b;
+	for (size_t i = 0; i < NR_VALUES; ++i) {
+		a.setbits(i);
+		if (!isoperand(a)) continue;
+		for (size_t j = 1; j < NR_VALUES; j += stride) {
+			b.setbits(j);
+			if (!isoperand(b)) continue;
+			for (Op op : { Op::ADD, Op::SUB, Op::MUL, Op::DIV }) nrOfFailedTests += check(reportTestCases, op, a, b);
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// random encodings, which cover the full exponent range including the subnormals
+template<typename Cfloat>
+int VerifyNativeArithmeticRandoms(bool reportTestCases, size_t nrTests) {
+	using namespace local;
+	static_assert(Cfloat::hasNativeArithmetic, "configuration is not mapped onto native arithmetic");
+	std::mt19937_64 generator(0x5eed);
+	int nrOfFailedTests = 0;
+	Cfloat a, b;
+	for (size_t k = 0; k < nrTests; ++k) {
+		uint64_t raw = generator();
+		a.setbits(raw);
+		b.setbits((k % 4 == 1) ? (raw ^ (generator() & 0xFFFF)) : generator()); // nearby operands exercise cancellation
+		if (!isoperand(a) || !isoperand(b)) continue;
+		for (Op op : { Op::ADD, Op::SUB, Op::MUL, Op::DIV }) nrOfFailedTests += check(reportTestCases, op, a, b);
+	}
+	return nrOfFailedTests;
+}
+
+// zeros, infinities, and overflow keep the cfloat rules
+template<typename Cfloat>
+int VerifyNativeSpecialCases(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	Cfloat maxpos(SpecificValue::maxpos), maxneg(SpecificValue::maxneg), minpos(SpecificValue::minpos), inf(SpecificValue::infpos);
+	Cfloat pzero(0), nzero(0), one(1), c;
+	nzero.setsign(true);
+
+	c = maxpos + maxpos;
+	if (Cfloat::isSaturating ? c != maxpos : !c.isinf(INF_TYPE_POSITIVE)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: overflow of maxpos + maxpos yields " << to_binary(c) << '\n';
+	}
+	c = maxneg * Cfloat(4);
+	if (Cfloat::isSaturating ? c != maxneg : !c.isinf(INF_TYPE_NEGATIVE)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: overflow of maxneg * 4 yields " << to_binary(c) << '\n';
+	}
+	c = minpos / Cfloat(4);
+	if (!c.iszero()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: underflow of minpos / 4 yields " << to_binary(c) << '\n';
+	}
+	c = minpos * Cfloat(3);
+	if (double(c) != 3.0 * double(minpos)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: subnormal minpos * 3 yields " << to_binary(c) << '\n';
+	}
+	c = pzero + nzero;   // the emulated rule of the zero operands is unchanged
+	if (!c.iszero() || !c.sign()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: 0 + -0 yields " << to_binary(c) << '\n';
+	}
+	c = one / pzero;
+	if (!c.isinf(INF_TYPE_POSITIVE)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: 1 / 0 yields " << to_binary(c) << '\n';
+	}
+	c = inf - inf;
+	if (!c.isnan()) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: inf - inf yields " << to_binary(c) << '\n';
+	}
+	c = one + inf;
+	if (!c.isinf(INF_TYPE_POSITIVE)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: 1 + inf yields " << to_binary(c) << '\n';
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat native arithmetic";
+	std::string test_tag    = "native";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	// the IEEE-754 equivalent configurations, in every storage and saturation variant
+	using fp16s = cfloat<16, 5, uint8_t, true, false, true>;
+	using bf16  = cfloat<16, 8, uint16_t, true, false, false>;
+	using bf16s = cfloat<16, 8, uint16_t, true, false, true>;
+	using fp32s = cfloat<32, 8, uint32_t, true, false, true>;
+	using fp64s = cfloat<64, 11, uint64_t, true, false, true>;
+	static_assert(half::hasNativeArithmetic && single::hasNativeArithmetic && duble::hasNativeArithmetic && bf16::hasNativeArithmetic);
+	static_assert(!cfloat<16, 5, uint16_t, false, false, false>::hasNativeArithmetic, "only gradual underflow maps onto IEEE-754");
+	static_assert(!cfloat<32, 8, uint32_t, true, true, false>::hasNativeArithmetic, "supernormals do not map onto IEEE-754");
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< half >(true, 1021), type_tag(half()), "sweep");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeSpecialCases< half >(reportTestCases), type_tag(half()), "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeSpecialCases< fp16s >(reportTestCases), type_tag(fp16s()), "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeSpecialCases< bf16 >(reportTestCases), type_tag(bf16()), "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeSpecialCases< bf16s >(reportTestCases), type_tag(bf16s()), "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeSpecialCases< single >(reportTestCases), type_tag(single()), "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeSpecialCases< fp32s >(reportTestCases), type_tag(fp32s()), "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeSpecialCases< duble >(reportTestCases), type_tag(duble()), "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeSpecialCases< fp64s >(reportTestCases), type_tag(fp64s()), "special cases");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< half >(reportTestCases, 4099), type_tag(half()), "sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< bf16 >(reportTestCases, 4099), type_tag(bf16()), "sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticRandoms< single >(reportTestCases, 10000), type_tag(single()), "randoms");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticRandoms< duble >(reportTestCases, 10000), type_tag(duble()), "randoms");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< half >(reportTestCases, 257), type_tag(half()), "sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< fp16s >(reportTestCases, 257), type_tag(fp16s()), "sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< bf16 >(reportTestCases, 257), type_tag(bf16()), "sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< bf16s >(reportTestCases, 257), type_tag(bf16s()), "sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticRandoms< fp32s >(reportTestCases, 1000000), type_tag(fp32s()), "randoms");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticRandoms< fp64s >(reportTestCases, 1000000), type_tag(fp64s()), "randoms");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< half >(reportTestCases, 17), type_tag(half()), "sweep");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< bf16 >(reportTestCases, 17), type_tag(bf16()), "sweep");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< half >(reportTestCases, 1), type_tag(half()), "exhaustive");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmeticSweep< bf16 >(reportTestCases, 1), type_tag(bf16()), "exhaustive");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
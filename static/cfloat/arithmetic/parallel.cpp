@@ -0,0 +1,177 @@
+// parallel.cpp: exhaustive classic floating-point arithmetic verification partitioned across threads and processes
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/cfloat_test_suite.hpp>
+#include <universal/verification/test_suite_parallel.hpp>
+
+/*
+ * usage: cfloat_parallel [--shard i/N]
+ *
+ * The exhaustive 16-bit verification of REGRESSION_LEVEL_4 can be spread over N processes,
+ * each running one shard, and the failure counts of the shards add up to the full run.
+ */
+
+namespace sw { namespace universal {
+
+	// the per operand pair checks are the acceptance rules of the sequential VerifyCfloatAddition, VerifyCfloatSubtraction,
+	// VerifyCfloatMultiplication, and VerifyCfloatDivision of cfloat_test_suite.hpp, reported against the cfloat reference
+
+	template<typename Cfloat>
+	int VerifyCfloatAdditionInParallel(bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0) {
+		return VerifyBinaryOperatorInParallel<Cfloat, Cfloat>("+", CfloatAdditionCaseFails<Cfloat>, reportTestCases, shard, nrThreads);
+	}
+
+	template<typename Cfloat>
+	int VerifyCfloatSubtractionInParallel(bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0) {
+		return VerifyBinaryOperatorInParallel<Cfloat, Cfloat>("-", CfloatSubtractionCaseFails<Cfloat>, reportTestCases, shard, nrThreads);
+	}
+
+	template<typename Cfloat>
+	int VerifyCfloatMultiplicationInParallel(bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0) {
+		return VerifyBinaryOperatorInParallel<Cfloat, Cfloat>("*", CfloatMultiplicationCaseFails<Cfloat>, reportTestCases, shard, nrThreads);
+	}
+
+	template<typename Cfloat>
+	int VerifyCfloatDivisionInParallel(bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0) {
+		return VerifyBinaryOperatorInParallel<Cfloat, Cfloat>("/", CfloatDivisionCaseFails<Cfloat>, reportTestCases, shard, nrThreads);
+	}
+
+}} // namespace sw::universal
+
+// the parallel driver must agree with the sequential test suite, irrespective of the number of threads
+template<typename TestType>
+int VerifyAgreement(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	int add = VerifyCfloatAddition<TestType>(false);
+	int sub = VerifyCfloatSubtraction<TestType>(false);
+	int mul = VerifyCfloatMultiplication<TestType>(false);
+	int div = VerifyCfloatDivision<TestType>(false);
+	for (unsigned nrThreads : { 1u, 3u }) {
+		if (VerifyCfloatAdditionInParallel<TestType>(reportTestCases, {}, nrThreads) != add) ++nrOfFailedTests;
+		if (VerifyCfloatSubtractionInParallel<TestType>(reportTestCases, {}, nrThreads) != sub) ++nrOfFailedTests;
+		if (VerifyCfloatMultiplicationInParallel<TestType>(reportTestCases, {}, nrThreads) != mul) ++nrOfFailedTests;
+		if (VerifyCfloatDivisionInParallel<TestType>(reportTestCases, {}, nrThreads) != div) ++nrOfFailedTests;
+	}
+	return nrOfFailedTests;
+}
+
+// the failure counts of the shards add up to the count of the full run
+template<typename TestType>
+int VerifySharding(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	int full = VerifyCfloatMultiplicationInParallel<TestType>(false, {}, 3);
+	for (size_t count : { 3, 7 }) {
+		int sum = 0;
+		for (size_t index = 0; index < count; ++index) {
+			sum += VerifyCfloatMultiplicationInParallel<TestType>(false, VerificationShard{ index, count }, 2);
+		}
+		if (sum != full) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << count << " shards counted " << sum << " failures instead of " << full << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main(int argc, char* argv[])
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "cfloat parallel exhaustive verification";
+	std::string test_tag    = "parallel";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	VerificationShard shard = ParseShardArgument(argc, argv);
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+	if (shard.count > 1) std::cout << "shard " << shard.index << " of " << shard.count << '\n';
+
+#if MANUAL_TESTING
+
+	using Cfloat12 = cfloat<12, 4, std::uint16_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatAdditionInParallel< Cfloat12 >(reportTestCases, shard), "cfloat<12,4,uint16_t,t,f,f>", "addition");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	using Cfloat8 = cfloat<8, 2, std::uint8_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyAgreement< Cfloat8 >(reportTestCases), "cfloat<8,2,uint8_t,t,f,f>", "parallel agreement");
+	nrOfFailedTestCases += ReportTestResult(VerifySharding< Cfloat8 >(reportTestCases), "cfloat<8,2,uint8_t,t,f,f>", "sharding");
+	using SatCfloat8 = cfloat<8, 3, std::uint8_t, false, false, true>;
+	nrOfFailedTestCases += ReportTestResult(VerifyAgreement< SatCfloat8 >(reportTestCases), "cfloat<8,3,uint8_t,f,f,t>", "parallel agreement");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using Cfloat10 = cfloat<10, 3, std::uint16_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatAdditionInParallel< Cfloat10 >(reportTestCases, shard), "cfloat<10,3,uint16_t,t,f,f>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSubtractionInParallel< Cfloat10 >(reportTestCases, shard), "cfloat<10,3,uint16_t,t,f,f>", "subtraction");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatMultiplicationInParallel< Cfloat10 >(reportTestCases, shard), "cfloat<10,3,uint16_t,t,f,f>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatDivisionInParallel< Cfloat10 >(reportTestCases, shard), "cfloat<10,3,uint16_t,t,f,f>", "division");
+#endif
+
+#if REGRESSION_LEVEL_3
+	using Cfloat12 = cfloat<12, 4, std::uint16_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatAdditionInParallel< Cfloat12 >(reportTestCases, shard), "cfloat<12,4,uint16_t,t,f,f>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatMultiplicationInParallel< Cfloat12 >(reportTestCases, shard), "cfloat<12,4,uint16_t,t,f,f>", "multiplication");
+#endif
+
+#if REGRESSION_LEVEL_4
+	// 2^32 operand pairs per operator: use --shard to spread the run over processes
+	using Half = cfloat<16, 5, std::uint16_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatAdditionInParallel< Half >(reportTestCases, shard), "cfloat<16,5,uint16_t,t,f,f>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatSubtractionInParallel< Half >(reportTestCases, shard), "cfloat<16,5,uint16_t,t,f,f>", "subtraction");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatMultiplicationInParallel< Half >(reportTestCases, shard), "cfloat<16,5,uint16_t,t,f,f>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyCfloatDivisionInParallel< Half >(reportTestCases, shard), "cfloat<16,5,uint16_t,t,f,f>", "division");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
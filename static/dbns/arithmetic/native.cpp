@@ -0,0 +1,220 @@
+// native.cpp: test suite runner for the native exponent pair arithmetic of the double-base logarithmic number system
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <universal/number/dbns/dbns.hpp>
+#include <universal/verification/test_status.hpp>
+#include <universal/verification/test_reporters.hpp>
+
+namespace sw { namespace universal {
+
+	// brute force reference of the rounding to the nearest exponent pair: all positive encodings
+	// with a finite double value, sorted by the base-2 logarithm of their value. Zero, the encoding
+	// of the pair (MAX_A, 0), stands for the scale -MAX_A, as it does in the rounding of dbns.
+	template<typename DbnsType>
+	class NearestPairReference {
+	public:
+		NearestPairReference() {
+			DbnsType v;
+			for (std::uint64_t bits = 0; bits < (1ull << (DbnsType::nbits - 1)); ++bits) {
+				v.setbits(bits);
+				if (v.isnan()) continue;
+				double scale = (v.iszero() ? -static_cast<double>(DbnsType::MAX_A) : std::log2(double(v)));
+				if (std::isfinite(scale)) table.push_back({ scale, bits });
+			}
+			std::sort(table.begin(), table.end(), [](const Entry& l, const Entry& r) { return l.scale < r.scale; });
+		}
+
+		DbnsType operator()(double value) const {
+			DbnsType v;
+			v.setzero();
+			if (value == 0.0) return v;
+			double scale = std::log2(std::abs(value));
+			auto upper = std::lower_bound(table.begin(), table.end(), scale, [](const Entry& e, double s) { return e.scale < s; });
+			auto nearest = upper;
+			if (upper == table.end() || (upper != table.begin() && scale - (upper - 1)->scale <= upper->scale - scale)) nearest = upper - 1;
+			v.setbits(nearest->bits);
+			return (value < 0.0 && !v.iszero() ? -v : v);
+		}
+
+	private:
+		struct Entry {
+			double        scale;
+			std::uint64_t bits;
+		};
+		std::vector<Entry> table;
+	};
+
+	// conversion from double must round to the nearest exponent pair in the logarithmic domain
+	template<typename DbnsType>
+	int VerifyNearestPairRounding(bool reportTestCases, double lowestScale, double highestScale) {
+		NearestPairReference<DbnsType> nearest;
+		int nrOfFailedTestCases = 0;
+		for (double scale = lowestScale; scale <= highestScale; scale += 1.0 / 64.0) {
+			for (double value : { std::exp2(scale), -std::exp2(scale) }) {
+				DbnsType c = value, cref = nearest(value);
+				if (c != cref) {
+					++nrOfFailedTestCases;
+					if (reportTestCases) std::cerr << "FAIL: " << value << " rounds to " << c << " reference " << cref << '\n';
+				}
+			}
+			if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// the arithmetic on exponent pairs must match the nearest pair of the double precision result
+	// of the same operands: operands are sampled in [2^-range, 2^range] with both signs
+	template<typename DbnsType>
+	int VerifyNativeArithmetic(bool reportTestCases, double range, unsigned nrSamples) {
+		NearestPairReference<DbnsType> nearest;
+		std::mt19937_64 rng(0x0db5);
+		std::uniform_real_distribution<double> scale(-range, range);
+		int nrOfFailedTestCases = 0;
+		const char* ops[4] = { "+", "-", "*", "/" };
+		for (unsigned i = 0; i < nrSamples; ++i) {
+			DbnsType a = (i & 1 ? -1.0 : 1.0) * std::exp2(scale(rng));
+			DbnsType b = (i & 2 ? -1.0 : 1.0) * std::exp2(scale(rng));
+			if (i % 16 == 0) b = a;  // exact cancellation and doubling
+			double da = double(a), db = double(b);
+			DbnsType results[4] = { a + b, a - b, a * b, a / b };
+			double refs[4] = { da + db, da - db, da * db, da / db };
+			for (int op = 0; op < 4; ++op) {
+				DbnsType cref = nearest(refs[op]);
+				if (results[op] != cref) {
+					++nrOfFailedTestCases;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", ops[op], a, b, results[op], cref);
+				}
+			}
+			if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// products and quotients of pairs that stay in the encodable range are exact
+	template<typename DbnsType>
+	int VerifyExactPairArithmetic(bool reportTestCases) {
+		int nrOfFailedTestCases = 0;
+		DbnsType a, b;
+		for (std::uint64_t i = 0; i < (1ull << (DbnsType::nbits - 1)); i += 7) {
+			a.setbits(i);
+			if (a.isnan() || a.iszero()) continue;
+			for (std::uint64_t j = 0; j < (1ull << (DbnsType::nbits - 1)); j += 11) {
+				b.setbits(j);
+				if (b.isnan() || b.iszero()) continue;
+				DbnsType p = a * b, q = a / b;
+				// when the exact result is itself a pair, the exponent arithmetic must produce it
+				DbnsType pref = double(a) * double(b), qref = double(a) / double(b);
+				if (double(pref) == double(a) * double(b) && p != pref) {
+					++nrOfFailedTestCases;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "*", a, b, p, pref);
+				}
+				if (double(qref) == double(a) / double(b) && q != qref) {
+					++nrOfFailedTestCases;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "/", a, b, q, qref);
+				}
+				if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+} }  // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "dbns native arithmetic validation";
+	std::string test_tag    = "native";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	// the configurations cover the tabulated and the evaluated Gaussian logarithms,
+	// and the table and the window search of the rounding to the nearest pair,
+	// each declared in the regression block that uses it
+
+#if MANUAL_TESTING
+
+	using DBNS16_5 = dbns<16, 5, std::uint16_t>;   // evaluated Gaussian logarithms, fraction table
+	nrOfFailedTestCases += ReportTestResult(VerifyNearestPairRounding<DBNS16_5>(reportTestCases, -40.0, 40.0), "dbns<16,5,uint16_t>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<DBNS16_5>(reportTestCases, 16.0, 1000), "dbns<16,5,uint16_t>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	using DBNS8_3  = dbns< 8, 3, std::uint8_t>;    // addition table, fraction table
+	using DBNS12_4 = dbns<12, 4, std::uint16_t>;   // addition table, fraction table
+	nrOfFailedTestCases += ReportTestResult(VerifyNearestPairRounding<DBNS8_3>(reportTestCases, -12.0, 12.0), "dbns<8,3,uint8_t>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyNearestPairRounding<DBNS12_4>(reportTestCases, -24.0, 120.0), "dbns<12,4,uint16_t>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<DBNS12_4>(reportTestCases, 8.0, 5000), "dbns<12,4,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyExactPairArithmetic<DBNS12_4>(reportTestCases), "dbns<12,4,uint16_t>", "exact pairs");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using DBNS16_5 = dbns<16, 5, std::uint16_t>;   // evaluated Gaussian logarithms, fraction table
+	nrOfFailedTestCases += ReportTestResult(VerifyNearestPairRounding<DBNS16_5>(reportTestCases, -40.0, 40.0), "dbns<16,5,uint16_t>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<DBNS16_5>(reportTestCases, 16.0, 5000), "dbns<16,5,uint16_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	using DBNS20_2 = dbns<20, 2, std::uint32_t>;   // evaluated Gaussian logarithms, window search
+	nrOfFailedTestCases += ReportTestResult(VerifyNearestPairRounding<DBNS20_2>(reportTestCases, -8.0, 64.0), "dbns<20,2,uint32_t>", "rounding");
+	nrOfFailedTestCases += ReportTestResult(VerifyNativeArithmetic<DBNS20_2>(reportTestCases, 2.0, 2000), "dbns<20,2,uint32_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,248 @@
+// arithmetic.cpp: test suite runner for the arithmetic operators of the decimal floating-point number system
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <vector>
+// second: enable/disable arithmetic exceptions
+#define DFLOAT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/dfloat/dfloat.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// the canonical encoding of (-1)^sign * significand * 10^q
+	template<typename DfloatType>
+	DfloatType EncodeDfloat(bool sign, uint64_t significand, int64_t q) {
+		DfloatType v;
+		uint64_t exponentField = uint64_t(q - DfloatType::qmin);
+		v.setbits((uint64_t(sign) << (DfloatType::ebits + DfloatType::sbits)) | (exponentField << DfloatType::sbits) | significand);
+		return v;
+	}
+
+	// reference rounding of the exact value (-1)^sign * (magnitude + f) * 10^q, with 0 < f < 1 when sticky is set:
+	// works on the decimal digit string, independent of the dfloat implementation
+	template<typename DfloatType>
+	DfloatType ReferenceRound(bool sign, __int128 magnitude, int64_t q, bool sticky) {
+		constexpr int64_t p = int64_t(DfloatType::precision);
+		if (magnitude == 0 && !sticky) return EncodeDfloat<DfloatType>(sign, 0, DfloatType::qmin);
+		std::string digits;
+		for (__int128 m = magnitude; m > 0; m /= 10) digits.insert(digits.begin(), char('0' + int(m % 10)));
+		if (digits.empty()) digits = "0";
+		int64_t leading = q + int64_t(digits.size()) - 1;
+		int64_t t = std::max(leading - (p - 1), DfloatType::qmin);   // exponent of the last digit kept
+		uint64_t kept = 0;
+		if (t <= q) {
+			kept = uint64_t(magnitude);
+			for (int64_t i = t; i < q; ++i) kept *= 10u;
+		}
+		else {
+			int64_t drop = t - q;
+			int64_t keep = int64_t(digits.size()) - drop;
+			std::string high = (keep > 0 ? digits.substr(0, size_t(keep)) : std::string("0"));
+			std::string low = (keep > 0 ? digits.substr(size_t(keep)) : std::string(size_t(-keep), '0') + digits);
+			kept = std::stoull(high);
+			char roundDigit = low[0];
+			bool rest = sticky || low.find_first_not_of('0', 1) != std::string::npos;
+			if (roundDigit > '5' || (roundDigit == '5' && (rest || (kept & 1u)))) ++kept;
+			if (kept == DfloatType::SIGNIFICAND_LIMIT) { kept /= 10u; ++t; }
+		}
+		if (t > DfloatType::qmax) return DfloatType(sign ? SpecificValue::infneg : SpecificValue::infpos);
+		if (kept == 0) t = DfloatType::qmin;
+		return EncodeDfloat<DfloatType>(sign, kept, t);
+	}
+
+	// the same encoding, or both NaN
+	template<typename DfloatType>
+	bool SameDfloat(const DfloatType& a, const DfloatType& b) {
+		if (a.isnan() || b.isnan()) return a.isnan() && b.isnan();
+		return a.sign() == b.sign() && a.isinf() == b.isinf() && a.significand() == b.significand() && a.exponent() == b.exponent();
+	}
+
+	enum class DfloatOperator { ADD, SUB, MUL, DIV };
+
+	// all finite values of a small dfloat, both signs
+	template<typename DfloatType>
+	std::vector<DfloatType> EnumerateDfloats() {
+		std::vector<DfloatType> values;
+		for (int sign = 0; sign < 2; ++sign) {
+			for (uint64_t m = 0; m < DfloatType::SIGNIFICAND_LIMIT; ++m) values.push_back(EncodeDfloat<DfloatType>(sign != 0, m, DfloatType::qmin));
+			for (int64_t q = DfloatType::qmin + 1; q <= DfloatType::qmax; ++q) {
+				for (uint64_t m = DfloatType::SIGNIFICAND_NORMAL; m < DfloatType::SIGNIFICAND_LIMIT; ++m) values.push_back(EncodeDfloat<DfloatType>(sign != 0, m, q));
+			}
+		}
+		return values;
+	}
+
+	// exhaustively compare an operator on all pairs of finite values against the reference rounding
+	template<typename DfloatType>
+	int VerifyDfloatArithmetic(DfloatOperator op, bool reportTestCases) {
+		std::vector<DfloatType> values = EnumerateDfloats<DfloatType>();
+		int nrOfFailedTests = 0;
+		for (const DfloatType& a : values) {
+			for (const DfloatType& b : values) {
+				DfloatType result, reference;
+				__int128 x = __int128(a.significand()), y = __int128(b.significand());
+				int64_t qa = a.exponent(), qb = b.exponent();
+				bool sa = a.sign(), sb = b.sign();
+				switch (op) {
+				case DfloatOperator::ADD:
+				case DfloatOperator::SUB: {
+					result = (op == DfloatOperator::ADD ? a + b : a - b);
+					if (op == DfloatOperator::SUB) sb = !sb;
+					int64_t q = std::min(qa, qb);
+					for (int64_t i = q; i < qa; ++i) x *= 10;
+					for (int64_t i = q; i < qb; ++i) y *= 10;
+					__int128 s = (sa ? -x : x) + (sb ? -y : y);
+					bool negative = (s < 0) || (s == 0 && sa && sb);
+					reference = ReferenceRound<DfloatType>(negative, (s < 0 ? -s : s), q, false);
+					break;
+				}
+				case DfloatOperator::MUL:
+					result = a * b;
+					reference = ReferenceRound<DfloatType>(sa != sb, x * y, qa + qb, false);
+					break;
+				case DfloatOperator::DIV:
+					result = a / b;
+					if (y == 0) {
+						reference = (x == 0 ? DfloatType(SpecificValue::qnan) : DfloatType(sa != sb ? SpecificValue::infneg : SpecificValue::infpos));
+					}
+					else {
+						constexpr int K = 24;  // quotient digits beyond any rounding position
+						for (int i = 0; i < K; ++i) x *= 10;
+						reference = ReferenceRound<DfloatType>(sa != sb, x / y, qa - qb - K, (x % y) != 0);
+					}
+					break;
+				}
+				if (!SameDfloat(result, reference)) {
+					++nrOfFailedTests;
+					if (reportTestCases && nrOfFailedTests < 25) {
+						std::cerr << "FAIL: " << a << ' ' << b << " -> " << result << " != " << reference << ' ' << to_binary(result) << " vs " << to_binary(reference) << '\n';
+					}
+				}
+			}
+		}
+		return nrOfFailedTests;
+	}
+
+	// special values: infinities, NaN, signed zeros, overflow, and conversions
+	template<typename DfloatType>
+	int VerifyDfloatSpecialCases(bool reportTestCases) {
+		int nrOfFailedTests = 0;
+		auto check = [&](bool condition, const char* msg) {
+			if (!condition) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << msg << '\n';
+			}
+		};
+		DfloatType inf(SpecificValue::infpos), zero(0), one(1), maxpos(SpecificValue::maxpos), minpos(SpecificValue::minpos);
+		check((inf - inf).isnan(), "inf - inf is NaN");
+		check((inf * zero).isnan(), "inf * 0 is NaN");
+		check((zero / zero).isnan(), "0 / 0 is NaN");
+		check((inf / inf).isnan(), "inf / inf is NaN");
+		check((one / zero).isinf(INF_TYPE_POSITIVE), "1 / 0 is inf");
+		check((-one / zero).isinf(INF_TYPE_NEGATIVE), "-1 / 0 is -inf");
+		check((one / inf).iszero(), "1 / inf is 0");
+		check((maxpos + maxpos).isinf(INF_TYPE_POSITIVE), "maxpos + maxpos overflows");
+		check((minpos / DfloatType(3)).iszero(), "minpos / 3 underflows");
+		check((-minpos / DfloatType(3)).sign(), "-minpos / 3 keeps its sign");
+		check(!(one - one).sign(), "1 - 1 is +0");
+		check((-zero + -zero).sign(), "-0 + -0 is -0");
+		check((DfloatType(SpecificValue::qnan) + one).isnan(NAN_TYPE_QUIET), "NaN propagates");
+		check(DfloatType(SpecificValue::qnan) != DfloatType(SpecificValue::qnan), "NaN is unordered");
+		check(zero == -zero, "+0 == -0");
+		check(double(DfloatType(0.5)) == 0.5, "0.5 round trips");
+		check(double(DfloatType(-12)) == -12.0, "-12 round trips");
+		check(DfloatType("1.25e1") == DfloatType(12.5), "string and double conversion agree");
+		DfloatType v(1);
+		++v; --v;
+		check(v == one, "++ and -- are inverses");
+		check(DfloatType(-2) < DfloatType(-1) && DfloatType(-1) < zero && zero < minpos && minpos < one && one < maxpos && maxpos < inf, "ordering");
+		return nrOfFailedTests;
+	}
+
+}} // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "dfloat arithmetic validation";
+	std::string test_tag    = "arithmetic";
+	bool reportTestCases    = true;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Dfloat = dfloat<3, 1>;
+	Dfloat a(0.25), b(3);
+	std::cout << a << " / " << b << " = " << a / b << " : " << to_binary(a / b) << '\n';
+	nrOfFailedTestCases += ReportTestResult(VerifyDfloatArithmetic< dfloat<3, 1> >(DfloatOperator::DIV, reportTestCases), "dfloat<3,1>", "division");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyDfloatSpecialCases< dfloat<3, 1> >(reportTestCases), "dfloat<3,1>", "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyDfloatSpecialCases< dfloat<8, 2> >(reportTestCases), "dfloat<8,2>", "special cases");
+	nrOfFailedTestCases += ReportTestResult(VerifyDfloatArithmetic< dfloat<3, 1> >(DfloatOperator::ADD, reportTestCases), "dfloat<3,1>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyDfloatArithmetic< dfloat<3, 1> >(DfloatOperator::SUB, reportTestCases), "dfloat<3,1>", "subtraction");
+	nrOfFailedTestCases += ReportTestResult(VerifyDfloatArithmetic< dfloat<3, 1> >(DfloatOperator::MUL, reportTestCases), "dfloat<3,1>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyDfloatArithmetic< dfloat<3, 1> >(DfloatOperator::DIV, reportTestCases), "dfloat<3,1>", "division");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyDfloatSpecialCases< dfloat<16, 3, uint32_t> >(reportTestCases), "dfloat<16,3>", "special cases");
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << "Caught ad-hoc exception: " << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Caught unexpected universal arithmetic exception : " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Caught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Caught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
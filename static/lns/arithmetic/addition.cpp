@@ -56,6 +56,68 @@ namespace sw { namespace universal {
 		return nrOfFailedTestCases;
 	}
 
+	// without saturation, a sum beyond maxpos overflows to NaN, as lns has no infinite encoding,
+	// and every other sum matches the saturating configuration of the same encoding
+	template<typename LnsType, std::enable_if_t<is_lns<LnsType>, bool> = true>
+	int VerifyNonSaturatingAddition(bool reportTestCases) {
+		static_assert(LnsType::behavior != Behavior::Saturating, "VerifyNonSaturatingAddition requires a non-saturating lns");
+		using SaturatingType = lns<LnsType::nbits, LnsType::rbits, typename LnsType::BlockType, Behavior::Saturating>;
+		constexpr size_t NR_ENCODINGS = (1ull << LnsType::nbits);
+		const double maxScale = double(LnsType::max_exponent_ulps) / LnsType::scaling;
+
+		int nrOfFailedTestCases = 0;
+		LnsType a, b, c;
+		SaturatingType sa, sb;
+		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
+			a.setbits(i);
+			sa.setbits(i);
+			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
+				b.setbits(j);
+				sb.setbits(j);
+				c = a + b;
+				SaturatingType sc = sa + sb;
+				double ref = double(a) + double(b);
+				bool overflow = !a.isnan() && !b.isnan() && ref != 0.0 && std::round(std::log2(std::abs(ref)) * LnsType::scaling) / LnsType::scaling > maxScale;
+				bool pass = (overflow ? c.isnan() : (sc.isnan() ? c.isnan() : to_binary(c) == to_binary(sc)));
+				if (!pass) {
+					++nrOfFailedTestCases;
+					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", a, b, c, ref);
+				}
+				if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// directed overflow cases for the configurations that are too wide to enumerate
+	template<typename LnsType, std::enable_if_t<is_lns<LnsType>, bool> = true>
+	int VerifyNonSaturatingOverflow(bool reportTestCases) {
+		static_assert(LnsType::behavior != Behavior::Saturating, "VerifyNonSaturatingOverflow requires a non-saturating lns");
+		int nrOfFailedTestCases = 0;
+		LnsType maxpos(SpecificValue::maxpos), maxneg(SpecificValue::maxneg), minpos(SpecificValue::minpos), c;
+		c = maxpos + maxpos;
+		if (!c.isnan()) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", maxpos, maxpos, c, double(maxpos) + double(maxpos));
+		}
+		c = maxneg + maxneg;
+		if (!c.isnan()) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", maxneg, maxneg, c, double(maxneg) + double(maxneg));
+		}
+		c = maxpos - minpos;  // stays in range
+		if (c.isnan() || c > maxpos) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "-", maxpos, minpos, c, double(maxpos) - double(minpos));
+		}
+		c = maxpos + maxneg;
+		if (!c.iszero()) {
+			++nrOfFailedTestCases;
+			if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", maxpos, maxneg, c, 0.0);
+		}
+		return nrOfFailedTestCases;
+	}
+
 } }  // namespace sw::universal
 
 
@@ -117,6 +179,10 @@ try {
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<LNS5_2_sat>(reportTestCases), "lns<5,2,uint8_t>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<LNS8_3_sat>(reportTestCases), "lns<8,3,uint8_t>", test_tag);
 
+	using LNS5_2_wrap = lns<5, 2, std::uint8_t, Behavior::Wrapping>;
+	using LNS8_3_wrap = lns<8, 3, std::uint8_t, Behavior::Wrapping>;
+	nrOfFailedTestCases += ReportTestResult(VerifyNonSaturatingAddition<LNS5_2_wrap>(reportTestCases), "lns<5,2,uint8_t,Wrapping>", "overflow");
+	nrOfFailedTestCases += ReportTestResult(VerifyNonSaturatingAddition<LNS8_3_wrap>(reportTestCases), "lns<8,3,uint8_t,Wrapping>", "overflow");
 #endif
 
 #if REGRESSION_LEVEL_2
@@ -125,12 +191,26 @@ try {
 
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<LNS9_4_sat>(reportTestCases), "lns<9,4,uint8_t>", test_tag);
 	nrOfFailedTestCases += ReportTestResult(VerifyAddition<LNS10_4_sat>(reportTestCases), "lns<10,4,uint8_t>", test_tag);
+
+	using LNS10_4_wrap = lns<10, 4, std::uint8_t, Behavior::Wrapping>;
+	nrOfFailedTestCases += ReportTestResult(VerifyNonSaturatingAddition<LNS10_4_wrap>(reportTestCases), "lns<10,4,uint8_t,Wrapping>", "overflow");
+
+	using LNS72_10_wrap = lns<72, 10, std::uint32_t, Behavior::Wrapping>;  // blockbinary exponent arithmetic
+	using LNS64_60_wrap = lns<64, 60, std::uint32_t, Behavior::Wrapping>;  // double precision fallback
+	nrOfFailedTestCases += ReportTestResult(VerifyNonSaturatingOverflow<LNS72_10_wrap>(reportTestCases), "lns<72,10,uint32_t,Wrapping>", "overflow");
+	nrOfFailedTestCases += ReportTestResult(VerifyNonSaturatingOverflow<LNS64_60_wrap>(reportTestCases), "lns<64,60,uint32_t,Wrapping>", "overflow");
 #endif
 
 #if REGRESSION_LEVEL_3
+	using LNS10_6_sat = lns<10, 6, std::uint16_t>;
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition<LNS10_6_sat>(reportTestCases), "lns<10,6,uint16_t>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
+	using LNS11_9_sat = lns<11, 9, std::uint16_t>; // interpolated Gaussian logarithms
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition<LNS11_9_sat>(reportTestCases), "lns<11,9,uint16_t>", test_tag);
 #endif
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
@@ -0,0 +1,164 @@
+// parallel.cpp: exhaustive logarithmic number system arithmetic verification partitioned across threads and processes
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#define LNS_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/lns/lns.hpp>
+#include <universal/verification/test_suite_arithmetic.hpp>
+#include <universal/verification/test_suite_parallel.hpp>
+
+/*
+ * usage: lns_parallel [--shard i/N]
+ *
+ * The exhaustive 16-bit verification of REGRESSION_LEVEL_4 can be spread over N processes,
+ * each running one shard, and the failure counts of the shards add up to the full run.
+ */
+
+namespace sw { namespace universal {
+
+	// lns has no infinite encoding: a division by zero yields NaN where the double reference is an infinite,
+	// and all other operand pairs follow the acceptance rules of the sequential VerifyDivision
+	template<typename LnsType>
+	bool LnsDivisionCaseFails(const LnsType& a, const LnsType& b, LnsType& c, double& ref) {
+		if (b.iszero()) {
+			c = a / b;
+			ref = double(a) / double(b);
+			return !c.isnan();
+		}
+		return DivisionCaseFails(a, b, c, ref);
+	}
+
+	template<typename LnsType>
+	int VerifyLnsDivisionInParallel(bool reportTestCases, const VerificationShard& shard = {}, unsigned nrThreads = 0) {
+		return VerifyBinaryOperatorInParallel<LnsType>("/", LnsDivisionCaseFails<LnsType>, reportTestCases, shard, nrThreads);
+	}
+
+}} // namespace sw::universal
+
+// the parallel driver must agree with the sequential test suite, irrespective of the number of threads
+template<typename TestType>
+int VerifyAgreement(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	int add = VerifyAddition<TestType>(false);
+	int mul = VerifyMultiplication<TestType>(false);
+	int sub = VerifySubtraction<TestType>(false);
+	for (unsigned nrThreads : { 1u, 3u }) {
+		if (VerifyAdditionInParallel<TestType>(reportTestCases, {}, nrThreads) != add) ++nrOfFailedTests;
+		if (VerifyMultiplicationInParallel<TestType>(reportTestCases, {}, nrThreads) != mul) ++nrOfFailedTests;
+		if (VerifySubtractionInParallel<TestType>(reportTestCases, {}, nrThreads) != sub) ++nrOfFailedTests;
+	}
+	return nrOfFailedTests;
+}
+
+// the failure counts of the shards add up to the count of the full run
+template<typename TestType>
+int VerifySharding(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	int full = VerifyLnsDivisionInParallel<TestType>(false, {}, 3);
+	for (size_t count : { 3, 7 }) {
+		int sum = 0;
+		for (size_t index = 0; index < count; ++index) {
+			sum += VerifyLnsDivisionInParallel<TestType>(false, VerificationShard{ index, count }, 2);
+		}
+		if (sum != full) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << count << " shards counted " << sum << " failures instead of " << full << '\n';
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main(int argc, char* argv[])
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "lns parallel exhaustive verification";
+	std::string test_tag    = "parallel";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	VerificationShard shard = ParseShardArgument(argc, argv);
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+	if (shard.count > 1) std::cout << "shard " << shard.index << " of " << shard.count << '\n';
+
+#if MANUAL_TESTING
+
+	using LNS10_4 = lns<10, 4, std::uint8_t>;
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplicationInParallel< LNS10_4 >(reportTestCases, shard), "lns<10,4,uint8_t>", "multiplication");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	using LNS8_3 = lns<8, 3, std::uint8_t>;
+	nrOfFailedTestCases += ReportTestResult(VerifyAgreement< LNS8_3 >(reportTestCases), "lns<8,3,uint8_t>", "parallel agreement");
+	nrOfFailedTestCases += ReportTestResult(VerifySharding< LNS8_3 >(reportTestCases), "lns<8,3,uint8_t>", "sharding");
+	nrOfFailedTestCases += ReportTestResult(VerifyLnsDivisionInParallel< LNS8_3 >(reportTestCases, shard), "lns<8,3,uint8_t>", "division");
+#endif
+
+#if REGRESSION_LEVEL_2
+	using LNS10_4 = lns<10, 4, std::uint8_t>;
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplicationInParallel< LNS10_4 >(reportTestCases, shard), "lns<10,4,uint8_t>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyLnsDivisionInParallel< LNS10_4 >(reportTestCases, shard), "lns<10,4,uint8_t>", "division");
+#endif
+
+#if REGRESSION_LEVEL_3
+	using LNS12_5 = lns<12, 5, std::uint16_t>;
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplicationInParallel< LNS12_5 >(reportTestCases, shard), "lns<12,5,uint16_t>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyLnsDivisionInParallel< LNS12_5 >(reportTestCases, shard), "lns<12,5,uint16_t>", "division");
+#endif
+
+#if REGRESSION_LEVEL_4
+	// 2^32 operand pairs per operator: use --shard to spread the run over processes
+	using LNS16_5 = lns<16, 5, std::uint16_t>;
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplicationInParallel< LNS16_5 >(reportTestCases, shard), "lns<16,5,uint16_t>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyLnsDivisionInParallel< LNS16_5 >(reportTestCases, shard), "lns<16,5,uint16_t>", "division");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -129,9 +129,15 @@ try {
 #endif
 
 #if REGRESSION_LEVEL_3
+	using LNS10_6_sat = lns<10, 6, std::uint16_t>;
+
+	nrOfFailedTestCases += ReportTestResult(VerifySubtraction<LNS10_6_sat>(reportTestCases), "lns<10,6, uint16_t>", test_tag);
 #endif
 
 #if REGRESSION_LEVEL_4
+	using LNS11_9_sat = lns<11, 9, std::uint16_t>; // interpolated Gaussian logarithms
+
+	nrOfFailedTestCases += ReportTestResult(VerifySubtraction<LNS11_9_sat>(reportTestCases), "lns<11,9, uint16_t>", test_tag);
 #endif
 
 	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
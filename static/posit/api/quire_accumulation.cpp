@@ -279,6 +279,29 @@ int ValidateBorrowPropagation() {
 	return nrOfFailedTests;
 }
 
+// the quire is a signed accumulator: verify ordering across the sign boundary
+template<unsigned nbits, unsigned es, unsigned capacity = 2>
+int ValidateQuireOrdering() {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+
+	posit<nbits, es> one(1), two(2);
+	quire<nbits, es, capacity> qm2, qm1, q0, qp1, qp2;
+	qm2 -= quire_mul(one, two);
+	qm1 -= quire_mul(one, one);
+	qp1 += quire_mul(one, one);
+	qp2 += quire_mul(two, one);
+	if (!(qm2 < qm1) || !(qm1 < q0) || !(q0 < qp1) || !(qp1 < qp2)) ++nrOfFailedTests;
+	if (!(qm2 < quire_mul(one, -one)) || !(qm1 > quire_mul(two, -one)) || !(qp1 == quire_mul(one, one))) ++nrOfFailedTests;
+	// walk from -2 to +2 through zero
+	qm2 += quire_mul(two, two);
+	if (qm2 != qp2) ++nrOfFailedTests;
+	qm2 -= qp2;
+	if (!qm2.iszero() || qm2.sign()) ++nrOfFailedTests;
+
+	return nrOfFailedTests;
+}
+
 template<unsigned nbits, unsigned es, unsigned capacity = 2>
 int ValidateQuireAccumulation(bool reportTestCases) {
 	int nrOfFailedTests = 0;
@@ -354,6 +377,9 @@ try {
 	nrOfFailedTestCases += ReportTestResult(ValidateCarryPropagation<4, 1>(), "carry propagation", "increment");
 	std::cout << "Borrow Propagation\n";
 	nrOfFailedTestCases += ReportTestResult(ValidateBorrowPropagation<4, 1>(), "borrow propagation", "increment");
+	std::cout << "Signed ordering\n";
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireOrdering<8, 1>(), "quire ordering", "comparison");
+	nrOfFailedTestCases += ReportTestResult(ValidateQuireOrdering<32, 2>(), "quire ordering", "comparison");
 
 #ifdef ISSUE_45_DEBUG
 	{	
@@ -0,0 +1,196 @@
+// parallel.cpp: exhaustive posit arithmetic verification partitioned across threads and processes
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#define POSIT_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/posit/posit.hpp>
+#include <universal/verification/posit_test_suite.hpp>
+#include <universal/verification/test_suite_parallel.hpp>
+
+/*
+ * usage: posit_parallel [--shard i/N]
+ * 
+ * The exhaustive 16-bit verification of REGRESSION_LEVEL_4 can be spread over N processes,
+ * each running one shard, and the failure counts of the shards add up to the full run.
+ */
+
+// the parallel driver must agree with the sequential test suite, irrespective of the number of threads
+template<typename TestType>
+int VerifyAgreement(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	int add = VerifyAddition<TestType>(false);
+	int mul = VerifyMultiplication<TestType>(false);
+	for (unsigned nrThreads : { 1u, 3u }) {
+		if (VerifyAdditionInParallel<TestType>(reportTestCases, {}, nrThreads) != add) ++nrOfFailedTests;
+		if (VerifyMultiplicationInParallel<TestType>(reportTestCases, {}, nrThreads) != mul) ++nrOfFailedTests;
+	}
+	return nrOfFailedTests;
+}
+
+// the shards partition the operand pairs and the failure counts merge to the count of the full run
+template<typename TestType>
+int VerifySharding(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	// a check that fails on a known subset of the operand pairs
+	auto selective = [](const TestType& a, const TestType& b, TestType& c, double& ref) {
+		c = a + b;
+		ref = double(c);
+		return ((a.bits() + 3 * b.bits()) % 7) == 0;
+	};
+	constexpr size_t NR_VALUES = size_t(1) << TestType::nbits;
+	size_t expected = 0;
+	for (size_t i = 0; i < NR_VALUES; ++i) for (size_t j = 0; j < NR_VALUES; ++j) if ((i + 3 * j) % 7 == 0) ++expected;
+	int full = VerifyBinaryOperatorInParallel<TestType>("+", selective, false, {}, 3);
+	if (size_t(full) != expected) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: full run counted " << full << " failures instead of " << expected << '\n';
+	}
+	for (size_t count : { 2, 5, 7 }) {
+		int sum = 0;
+		for (size_t index = 0; index < count; ++index) {
+			sum += VerifyBinaryOperatorInParallel<TestType>("+", selective, false, VerificationShard{ index, count }, 2);
+		}
+		if (sum != full) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << count << " shards counted " << sum << " failures instead of " << full << '\n';
+		}
+	}
+	// shard specifications
+	VerificationShard shard = ParseShard("3/8");
+	if (shard.index != 3 || shard.count != 8) ++nrOfFailedTests;
+	for (const char* bad : { "8/8", "1", "a/2", "1/0", "/3" }) {
+		try {
+			ParseShard(bad);
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: shard specification " << bad << " not rejected\n";
+		}
+		catch (const std::invalid_argument&) {
+			// correctly rejected
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the report cap bounds the output, not the failure count
+template<typename TestType>
+int VerifyReportLimit(bool reportTestCases) {
+	using namespace sw::universal;
+	int nrOfFailedTests = 0;
+	auto always = [](const TestType& a, const TestType& b, TestType& c, double& ref) {
+		c = a + b;
+		ref = double(c);
+		return true;
+	};
+	constexpr int NR_PAIRS = int(1) << (2 * TestType::nbits);
+	std::streambuf* cerrBuffer = std::cerr.rdbuf();
+	std::ostringstream captured;
+	std::cerr.rdbuf(captured.rdbuf());
+	int count = VerifyBinaryOperatorInParallel<TestType>("+", always, true, {}, 3, 5);
+	std::cerr.rdbuf(cerrBuffer);
+	std::string output = captured.str();
+	size_t nrOfReports = 0;
+	for (size_t pos = output.find("FAIL\n"); pos != std::string::npos; pos = output.find("FAIL\n", pos + 1)) ++nrOfReports;
+	if (count != NR_PAIRS) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: capped run counted " << count << " failures instead of " << NR_PAIRS << '\n';
+	}
+	if (nrOfReports != 5 || output.find(std::to_string(NR_PAIRS - 5) + " more failures") == std::string::npos) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: capped run reported\n" << output;
+	}
+	return nrOfFailedTests;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main(int argc, char* argv[])
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "posit parallel exhaustive verification";
+	std::string test_tag    = "parallel";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	VerificationShard shard = ParseShardArgument(argc, argv);
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+	if (shard.count > 1) std::cout << "shard " << shard.index << " of " << shard.count << '\n';
+
+#if MANUAL_TESTING
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAdditionInParallel< posit<12, 1> >(reportTestCases, shard), "posit<12,1>", "addition");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyAgreement< posit<8, 0> >(reportTestCases), "posit<8,0>", "parallel agreement");
+	nrOfFailedTestCases += ReportTestResult(VerifySharding< posit<6, 1> >(reportTestCases), "posit<6,1>", "sharding");
+	nrOfFailedTestCases += ReportTestResult(VerifyReportLimit< posit<4, 0> >(reportTestCases), "posit<4,0>", "report limit");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyAdditionInParallel< posit<10, 1> >(reportTestCases, shard), "posit<10,1>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifySubtractionInParallel< posit<10, 1> >(reportTestCases, shard), "posit<10,1>", "subtraction");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplicationInParallel< posit<10, 1> >(reportTestCases, shard), "posit<10,1>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyDivisionInParallel< posit<10, 1> >(reportTestCases, shard), "posit<10,1>", "division");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyAdditionInParallel< posit<12, 1> >(reportTestCases, shard), "posit<12,1>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplicationInParallel< posit<12, 1> >(reportTestCases, shard), "posit<12,1>", "multiplication");
+#endif
+
+#if REGRESSION_LEVEL_4
+	// 2^32 operand pairs per operator: use --shard to spread the run over processes
+	nrOfFailedTestCases += ReportTestResult(VerifyAdditionInParallel< posit<16, 1> >(reportTestCases, shard), "posit<16,1>", "addition");
+	nrOfFailedTestCases += ReportTestResult(VerifySubtractionInParallel< posit<16, 1> >(reportTestCases, shard), "posit<16,1>", "subtraction");
+	nrOfFailedTestCases += ReportTestResult(VerifyMultiplicationInParallel< posit<16, 1> >(reportTestCases, shard), "posit<16,1>", "multiplication");
+	nrOfFailedTestCases += ReportTestResult(VerifyDivisionInParallel< posit<16, 1> >(reportTestCases, shard), "posit<16,1>", "division");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
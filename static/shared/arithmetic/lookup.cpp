@@ -0,0 +1,211 @@
+// lookup.cpp: test suite runner of the table-driven arithmetic shared by number systems with encodings of 8 bits or fewer
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+// division by zero of fixpnt throws, which exercises the exception path of the tables
+#define FIXPNT_THROW_ARITHMETIC_EXCEPTION 1
+#include <universal/number/cfloat/cfloat.hpp>
+#include <universal/number/fixpnt/fixpnt.hpp>
+#include <universal/number/lns/lns.hpp>
+#include <universal/number/takum/takum.hpp>
+#include <universal/number/areal/areal.hpp>
+#include <universal/number/posit/posit.hpp>
+#include <universal/number/shared/lookup_arithmetic.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// the lookup tables must reproduce the arithmetic of the number system bit for bit
+template<typename Real>
+int VerifyLookupArithmetic(bool reportTestCases) {
+	using namespace sw::universal;
+	using Table = tabulated<Real>;
+	constexpr size_t NR_VALUES = size_t(1) << Real::nbits;
+	int nrOfFailedTests = 0;
+	auto compare = [&](const char* op, size_t i, size_t j, auto direct, auto lookup) {
+		bool directThrew{ false }, lookupThrew{ false };
+		uint64_t expected{ 0 }, actual{ 0 };
+		try { expected = lookup_encoding(direct()); } catch (...) { directThrew = true; }
+		try { actual = lookup(); } catch (...) { lookupThrew = true; }
+		if (directThrew != lookupThrew || (!directThrew && expected != actual)) {
+			++nrOfFailedTests;
+			if (reportTestCases) std::cerr << "FAIL: " << type_tag(Real()) << ' ' << to_hex(i) << ' ' << op << ' ' << to_hex(j)
+				<< " table " << to_hex(actual) << " direct " << to_hex(expected) << '\n';
+		}
+	};
+	for (size_t i = 0; i < NR_VALUES; ++i) {
+		Real a;
+		a.setbits(i);
+		Table ta = Table::fromBits(static_cast<uint8_t>(i));
+		compare("neg", i, 0, [&]() { return Real(-a); }, [&]() { return (-ta).bits(); });
+		for (size_t j = 0; j < NR_VALUES; ++j) {
+			Real b;
+			b.setbits(j);
+			Table tb = Table::fromBits(static_cast<uint8_t>(j));
+			compare("+", i, j, [&]() { return Real(a + b); }, [&]() { return (ta + tb).bits(); });
+			compare("-", i, j, [&]() { return Real(a - b); }, [&]() { return (ta - tb).bits(); });
+			compare("*", i, j, [&]() { return Real(a * b); }, [&]() { return (ta * tb).bits(); });
+			compare("/", i, j, [&]() { return Real(a / b); }, [&]() { return (ta / tb).bits(); });
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the comparisons on the encodings must reproduce the comparisons of the number system
+template<typename Real>
+int VerifyLookupComparison(bool reportTestCases) {
+	using namespace sw::universal;
+	using Table = tabulated<Real>;
+	constexpr size_t NR_VALUES = size_t(1) << Real::nbits;
+	int nrOfFailedTests = 0;
+	for (size_t i = 0; i < NR_VALUES; ++i) {
+		Real a;
+		a.setbits(i);
+		Table ta = Table::fromBits(static_cast<uint8_t>(i));
+		for (size_t j = 0; j < NR_VALUES; ++j) {
+			Real b;
+			b.setbits(j);
+			Table tb = Table::fromBits(static_cast<uint8_t>(j));
+			if ((ta == tb) != (a == b) || (ta != tb) != (a != b) || (ta < tb) != (a < b) ||
+				(ta > tb) != (a > b) || (ta <= tb) != (a <= b) || (ta >= tb) != (a >= b)) {
+				++nrOfFailedTests;
+				if (reportTestCases) std::cerr << "FAIL: " << type_tag(Real()) << " comparison of " << to_hex(i) << " and " << to_hex(j) << '\n';
+			}
+		}
+	}
+	return nrOfFailedTests;
+}
+
+// the wrapper converts, compares, and accumulates like the number system it tabulates
+template<typename Real>
+int VerifyTabulatedInterface(bool reportTestCases) {
+	using namespace sw::universal;
+	using Table = tabulated<Real>;
+	int nrOfFailedTests = 0;
+	Table sum{ 0 };
+	Real ref{ 0 };
+	for (int k = 1; k <= 4; ++k) {
+		sum += Table(0.25 * k);
+		ref += Real(0.25 * k);
+	}
+	if (double(sum) != double(ref)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: accumulation " << sum << " != " << ref << '\n';
+	}
+	Table one(1), two(2);
+	if (!(one < two) || !(two > one) || one == two || !(one <= one) || Real(one + one) != Real(two)) {
+		++nrOfFailedTests;
+		if (reportTestCases) std::cerr << "FAIL: comparison of " << type_tag(one) << '\n';
+	}
+	return nrOfFailedTests;
+}
+
+// a static object whose initializer uses the tables: they are built on first use,
+// so the result does not depend on the static initialization order
+using StaticInitType = sw::universal::cfloat<8, 2, uint8_t, true, false, false>;
+static const double staticInitSum = double(sw::universal::tabulated<StaticInitType>(1.5) + sw::universal::tabulated<StaticInitType>(0.25));
+
+int VerifyStaticInitialization(bool reportTestCases) {
+	double ref = double(StaticInitType(1.5) + StaticInitType(0.25));
+	if (staticInitSum != ref) {
+		if (reportTestCases) std::cerr << "FAIL: sum during static initialization " << staticInitSum << " != " << ref << '\n';
+		return 1;
+	}
+	return 0;
+}
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "lookup table arithmetic";
+	std::string test_tag    = "lookup";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using fp8 = cfloat<8, 4, uint8_t, true, false, false>;
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< fp8 >(true), type_tag(fp8()), "lookup");
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	using fp8e2 = cfloat<8, 2, uint8_t, true, false, false>;
+	using fp8e4 = cfloat<8, 4, uint8_t, true, false, false>;
+	using fp8e5 = cfloat<8, 5, uint8_t, false, false, true>;
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< fp8e2 >(reportTestCases), type_tag(fp8e2()), "lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< fp8e4 >(reportTestCases), type_tag(fp8e4()), "lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< fp8e5 >(reportTestCases), type_tag(fp8e5()), "lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< fixpnt<8, 4, Modulo, uint8_t> >(reportTestCases), "fixpnt<8,4,Modulo>", "lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< lns<8, 3, uint8_t> >(reportTestCases), "lns<8,3>", "lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< takum<8, uint8_t> >(reportTestCases), "takum<8>", "lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< areal<8, 2, uint8_t> >(reportTestCases), "areal<8,2>", "lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< posit<8, 0> >(reportTestCases), "posit<8,0>", "lookup");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupComparison< fp8e4 >(reportTestCases), type_tag(fp8e4()), "comparison");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupComparison< fp8e5 >(reportTestCases), type_tag(fp8e5()), "comparison");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupComparison< lns<8, 3, uint8_t> >(reportTestCases), "lns<8,3>", "comparison");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupComparison< posit<8, 0> >(reportTestCases), "posit<8,0>", "comparison");
+
+	nrOfFailedTestCases += ReportTestResult(VerifyTabulatedInterface< fp8e4 >(reportTestCases), type_tag(fp8e4()), "interface");
+	nrOfFailedTestCases += ReportTestResult(VerifyTabulatedInterface< lns<8, 3, uint8_t> >(reportTestCases), "lns<8,3>", "interface");
+	nrOfFailedTestCases += ReportTestResult(VerifyStaticInitialization(reportTestCases), type_tag(StaticInitType()), "static initialization");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< cfloat<6, 2, uint8_t, true, true, false> >(reportTestCases), "cfloat<6,2,tt>", "lookup");
+	nrOfFailedTestCases += ReportTestResult(VerifyLookupArithmetic< lns<6, 2, uint8_t> >(reportTestCases), "lns<6,2>", "lookup");
+#endif
+
+#if REGRESSION_LEVEL_3
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,228 @@
+// lattice.cpp: test suite runner for the table-driven arithmetic on the SORN lattice
+//
+// Copyright (C) 2017-2022 Stillwater Supercomputing, Inc.
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <vector>
+#include <universal/number/sorn/sorn.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// sample points of a lattice interval: the closed bounds and a few interior values
+	template<typename SornType>
+	std::vector<double> SamplePoints(size_t index) {
+		auto interval = SornType::sornDT[index];
+		double lo = interval.lowerBound, hi = interval.upperBound;
+		std::vector<double> samples;
+		if (!interval.lowerIsOpen) samples.push_back(lo);
+		if (!interval.upperIsOpen) samples.push_back(hi);
+		if (std::isinf(hi) && !std::isinf(lo)) {
+			samples.insert(samples.end(), { lo + 0.125, 2.0 * lo + 1.0, 1.0e30 });
+		}
+		else if (std::isinf(lo) && !std::isinf(hi)) {
+			samples.insert(samples.end(), { hi - 0.125, 2.0 * hi - 1.0, -1.0e30 });
+		}
+		else if (lo != hi) {
+			samples.insert(samples.end(), { lo + 0.25 * (hi - lo), lo + 0.5 * (hi - lo), lo + 0.75 * (hi - lo) });
+		}
+		return samples;
+	}
+
+	// the result of every operation on lattice intervals must contain the SORN of every
+	// result of the operation on the values that these intervals contain
+	template<typename SornType>
+	int VerifyLatticeEnclosure(bool reportTestCases) {
+		constexpr size_t sornBits = SornType::sornBits;
+		int nrOfFailedTestCases = 0;
+		for (size_t i = 0; i < sornBits; ++i) {
+			std::bitset<sornBits> bi; bi.set(i);
+			SornType a; a.setBits(bi);
+			auto xs = SamplePoints<SornType>(i);
+			for (size_t j = 0; j < sornBits; ++j) {
+				std::bitset<sornBits> bj; bj.set(j);
+				SornType b; b.setBits(bj);
+				auto ys = SamplePoints<SornType>(j);
+				SornType results[4] = { a + b, a - b, a * b, a / b };
+				const char* ops[4] = { "+", "-", "*", "/" };
+				for (double x : xs) {
+					for (double y : ys) {
+						double refs[4] = { x + y, x - y, x * y, x / y };
+						for (int op = 0; op < 4; ++op) {
+							if (std::isnan(refs[op])) continue;  // indeterminate forms such as 0/0 and inf - inf
+							SornType cref = refs[op];
+							if ((cref.getBits() & ~results[op].getBits()).any()) {
+								++nrOfFailedTestCases;
+								if (reportTestCases) std::cerr << "FAIL " << a << ' ' << ops[op] << ' ' << b << " = " << results[op] << " does not contain " << x << ' ' << ops[op] << ' ' << y << " = " << refs[op] << '\n';
+							}
+						}
+					}
+				}
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// an operation on a SORN with several set bits is the union of the operations on its intervals
+	template<typename SornType>
+	int VerifySetUnion(bool reportTestCases) {
+		constexpr size_t sornBits = SornType::sornBits;
+		int nrOfFailedTestCases = 0;
+		for (size_t i = 0; i + 2 < sornBits; i += 3) {
+			std::bitset<sornBits> bi, b0, b1;
+			bi.set(i); bi.set(i + 2);
+			b0.set(i); b1.set(i + 2);
+			SornType a, a0, a1;
+			a.setBits(bi); a0.setBits(b0); a1.setBits(b1);
+			for (size_t j = 0; j < sornBits; ++j) {
+				std::bitset<sornBits> bj; bj.set(j);
+				SornType b; b.setBits(bj);
+				if (((a * b).getBits() != ((a0 * b).getBits() | (a1 * b).getBits())) ||
+					((a / b).getBits() != ((a0 / b).getBits() | (a1 / b).getBits()))) {
+					++nrOfFailedTestCases;
+					if (reportTestCases) std::cerr << "FAIL union of " << a << " and " << b << '\n';
+				}
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<typename SornType>
+	int VerifyValue(const SornType& c, const std::string& ref, bool reportTestCases) {
+		std::stringstream s;
+		s << c;
+		if (s.str() != ref) {
+			if (reportTestCases) std::cerr << "FAIL " << s.str() << " != " << ref << '\n';
+			return 1;
+		}
+		return 0;
+	}
+
+} }  // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "sorn lattice arithmetic validation";
+	std::string test_tag    = "lattice";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	using LinSorn = sorn<0, 4, 8>;                    // [-inf,-4) ... 0 ... (4,inf]
+	using LogSorn = sorn<-2, 2, 1, 0, 1, 1, 1, 1>;    // [-inf,-4) ... 0 ... (4,inf] on powers of 2
+	using PosSorn = sorn<0, 2, 4, 1, 1, 0, 0, 1>;     // 0 (0,0.5] ... (1.5,2]
+
+	// the lattice is a compile-time table shared by all values
+	static_assert(LinSorn::sornDT.size() == LinSorn::sornBits, "lattice size must match the SORN bitwidth");
+	static_assert(LinSorn::sornDT[9].isZero(), "the exact zero must be the center of a symmetric lattice");
+	static_assert(LogSorn::sornDT[LogSorn::sornBits - 2].upperBound == 4.0f, "the logarithmic lattice must end with 2^stop");
+	static_assert(sizeof(LinSorn) <= sizeof(std::uint64_t), "a SORN value must be a pure bitset");
+
+#if MANUAL_TESTING
+
+	LinSorn a = 1.25, b = -0.75;
+	std::cout << a << " + " << b << " = " << a + b << '\n';
+	std::cout << a << " / " << b << " = " << a / b << '\n';
+	std::cout << a << " / 0 = " << a / LinSorn(0) << '\n';
+
+	nrOfFailedTestCases += ReportTestResult(VerifyLatticeEnclosure<LinSorn>(reportTestCases), "sorn<0,4,8>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+
+#if REGRESSION_LEVEL_1
+	{
+		LinSorn a = 1.25, b = -0.75, zero = 0;
+		int nrOfFailures = 0;
+		nrOfFailures += VerifyValue(a + b, "(0,1]", reportTestCases);
+		nrOfFailures += VerifyValue(a - b, "(1.5,2.5]", reportTestCases);
+		nrOfFailures += VerifyValue(a * b, "[-1.5,-0.5)", reportTestCases);
+		nrOfFailures += VerifyValue(a / b, "[-3,-1)", reportTestCases);
+		nrOfFailures += VerifyValue(a / zero, "[-inf,-4) U (4,inf]", reportTestCases);
+		nrOfFailures += VerifyValue(zero / zero, "{}", reportTestCases);
+		nrOfFailures += VerifyValue(zero * LinSorn(INFINITY), "0", reportTestCases);
+		nrOfFailures += VerifyValue(-a, "[-1.5,-1)", reportTestCases);
+		nrOfFailures += VerifyValue(abs(b), "(0.5,1]", reportTestCases);
+		nrOfFailures += VerifyValue(a + 0.25, "(1,2]", reportTestCases);
+		nrOfFailures += VerifyValue(1.0 - a, "[-0.5,0)", reportTestCases);
+		nrOfFailures += VerifyValue(LinSorn(3.0) * LinSorn(3.0), "(4,inf]", reportTestCases);
+		nrOfFailures += VerifyValue(PosSorn(0.25) - PosSorn(1.0), "0", reportTestCases);  // saturates to the lowest interval
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "sorn<0,4,8>", "special cases");
+	}
+	{
+		// conversion to native types: the midpoint of the hull of the set
+		LinSorn a = 1.25, b = -0.75, zero = 0, nan;
+		nan.setBits(0);
+		int nrOfFailures = 0;
+		if (double(a) != 1.25) ++nrOfFailures;
+		if (float(b) != -0.75f) ++nrOfFailures;
+		if (double(a + b) != 0.5) ++nrOfFailures;
+		if (double(zero) != 0.0) ++nrOfFailures;
+		if (double(LinSorn(3.0) * LinSorn(3.0)) != INFINITY) ++nrOfFailures;
+		if (double(a / zero) != 0.0) ++nrOfFailures;       // the hull is the full real line
+		if (!std::isnan(double(nan))) ++nrOfFailures;
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "sorn<0,4,8>", "conversion");
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyLatticeEnclosure<LinSorn>(reportTestCases), "sorn<0,4,8>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyLatticeEnclosure<LogSorn>(reportTestCases), "sorn<-2,2,log>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySetUnion<LinSorn>(reportTestCases), "sorn<0,4,8>", "set union");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyLatticeEnclosure<PosSorn>(reportTestCases), "sorn<0,2,4,pos>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifySetUnion<LogSorn>(reportTestCases), "sorn<-2,2,log>", "set union");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyLatticeEnclosure< sorn<0, 8, 32> >(reportTestCases), "sorn<0,8,32>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught unexpected universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
@@ -4,48 +4,85 @@
 //
 // This file is part of the universal numbers project, which is released under an MIT Open Source license.
 
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <vector>
 #include <universal/number/sorn/sorn.hpp>
 #include <universal/verification/test_suite.hpp>    // there is a generic VerifySubtraction here
 
 namespace sw { namespace universal {
 
-	//template<typename SornType,
-	//	std::enable_if_t<is_sorn<SornType>, SornType> = 0
-	//>
+	// sample points of a lattice interval: the bounds and a few interior values
 	template<typename SornType>
-	int VerifySubtraction_(bool reportTestCases) {
-		constexpr size_t nbits = SornType::nbits;
-		// using value_type = typename SornType::value_type;
-
-		SornType s;
-		std::cerr << "SORN type : " << type_tag(s) << " : nbits = " << nbits << '\n';
-
-		constexpr size_t NR_ENCODINGS = 16; // (1ull << nbits);		int nrOfFailedTestCases = 0;
+	std::vector<double> SamplePoints(size_t index) {
+		auto interval = SornType::sornDT[index];
+		double lo = interval.lowerBound, hi = interval.upperBound;
+		std::vector<double> samples;
+		if (!interval.lowerIsOpen) samples.push_back(lo);
+		if (!interval.upperIsOpen) samples.push_back(hi);
+		// open bounds are approached from inside the interval
+		constexpr double nudge = 1.0e-6;
+		if (interval.lowerIsOpen && !std::isinf(lo)) samples.push_back(lo + nudge);
+		if (interval.upperIsOpen && !std::isinf(hi)) samples.push_back(hi - nudge);
+		if (std::isinf(hi) && !std::isinf(lo)) {
+			samples.insert(samples.end(), { lo + 0.125, 2.0 * lo + 1.0, 1.0e30 });
+		}
+		else if (std::isinf(lo) && !std::isinf(hi)) {
+			samples.insert(samples.end(), { hi - 0.125, 2.0 * hi - 1.0, -1.0e30 });
+		}
+		else if (lo != hi) {
+			samples.insert(samples.end(), { lo + 0.25 * (hi - lo), lo + 0.5 * (hi - lo), lo + 0.75 * (hi - lo) });
+		}
+		return samples;
+	}
 
+	// The reference of a - b is built from values: for each pair of lattice intervals of a and b,
+	// the SORNs of the sampled results x - y are collected and filled to the range between the lowest
+	// and the highest interval they hit. The result set must equal the union of these ranges.
+	template<typename SornType>
+	int VerifySubtraction_(bool reportTestCases) {
+		constexpr size_t sornBits = SornType::sornBits;
 		int nrOfFailedTestCases = 0;
 
+		// all sets of the first four intervals, and every single interval
+		std::vector<std::bitset<sornBits>> encodings;
+		for (std::uint64_t i = 0; i < 16; ++i) encodings.push_back(std::bitset<sornBits>(i));
+		for (size_t i = 4; i < sornBits; ++i) {
+			std::bitset<sornBits> single;
+			single.set(i);
+			encodings.push_back(single);
+		}
+
 		SornType a, b, c, cref;
-		for (size_t i = 0; i < NR_ENCODINGS; ++i) {
-			a.setbits(i);
-			double da = double(a);
-			for (size_t j = 0; j < NR_ENCODINGS; ++j) {
-				b.setbits(j);
-				double db = double(b);
-
-				double ref = da + db;
-				c = a + b;
-				cref = ref;
-				//std::cout << "ref  : " << to_binary(ref) << " : " << ref << '\n';
-				//std::cout << "cref : " << std::setw(68) << to_binary(cref) << " : " << cref << '\n';
+		for (const auto& ea : encodings) {
+			a.setBits(ea);
+			for (const auto& eb : encodings) {
+				b.setBits(eb);
+				std::bitset<sornBits> ref;
+				for (size_t i = 0; i < sornBits; ++i) {
+					if (!ea[i]) continue;
+					for (size_t j = 0; j < sornBits; ++j) {
+						if (!eb[j]) continue;
+						size_t lowest = sornBits, highest = 0;
+						for (double x : SamplePoints<SornType>(i)) {
+							for (double y : SamplePoints<SornType>(j)) {
+								SornType v = x - y;
+								for (size_t k = 0; k < sornBits; ++k) {
+									if (!v.getBits()[k]) continue;
+									lowest = std::min(lowest, k);
+									highest = std::max(highest, k);
+								}
+							}
+						}
+						for (size_t k = lowest; k <= highest && k < sornBits; ++k) ref.set(k);
+					}
+				}
+				c = a - b;
+				cref.setBits(ref);
 				if (c != cref) {
-					if (c.isnan() && cref.isnan()) continue; // NaN non-equivalence
 					++nrOfFailedTestCases;
-					if (reportTestCases) ReportBinaryArithmeticError("FAIL", "+", a, b, c, cref);
-					//std::cout << "ref  : " << to_binary(ref) << " : " << ref << '\n';
-					//std::cout << "cref : " << std::setw(68) << to_binary(cref) << " : " << cref << '\n';
-				}
-				else {
-					if (reportTestCases) ReportBinaryArithmeticSuccess("PASS", "+", a, b, c, ref);
+					if (reportTestCases) std::cerr << "FAIL: " << a << " - " << b << " = " << c << " reference " << cref << '\n';
 				}
 				if (nrOfFailedTestCases > 24) return nrOfFailedTestCases;
 			}
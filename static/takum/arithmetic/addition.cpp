@@ -0,0 +1,95 @@
+// addition.cpp: test suite runner for addition of takums
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+// configure the takum arithmetic
+#define TAKUM_THROW_ARITHMETIC_EXCEPTION 0
+#include <universal/number/takum/takum.hpp>
+#include <universal/verification/test_suite.hpp>
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "takum addition validation";
+	std::string test_tag    = "addition";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+#if MANUAL_TESTING
+
+	using Takum = takum<16, std::uint16_t>;
+	Takum a(1.5), b(0.375), c;
+	c = a + b;
+	std::cout << a << " + " << b << " = " << c << " : " << to_binary(c) << '\n';
+
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition< takum<8, std::uint8_t> >(true), "takum< 8, uint8_t>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;   // ignore failures
+#else
+
+#if REGRESSION_LEVEL_1
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition< takum< 6, std::uint8_t> >(reportTestCases), "takum< 6, uint8_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition< takum< 8, std::uint8_t> >(reportTestCases), "takum< 8, uint8_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition< takum<10, std::uint16_t> >(reportTestCases), "takum<10,uint16_t>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition< takum<10, std::uint8_t> >(reportTestCases), "takum<10, uint8_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition< takum<12, std::uint16_t> >(reportTestCases), "takum<12,uint16_t>", test_tag);
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyAddition< takum<12, std::uint8_t> >(reportTestCases), "takum<12, uint8_t>", test_tag);
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}
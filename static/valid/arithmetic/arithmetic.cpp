@@ -0,0 +1,332 @@
+// arithmetic.cpp: test suite runner for the interval arithmetic of valids
+//
+// Copyright (C) 2017 Stillwater Supercomputing, Inc.
+// SPDX-License-Identifier: MIT
+//
+// This file is part of the universal numbers project, which is released under an MIT Open Source license.
+#include <universal/utility/directives.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <universal/number/valid/valid.hpp>
+#include <universal/verification/test_suite.hpp>
+
+namespace sw { namespace universal {
+
+	// r contains the real value x
+	template<unsigned nbits, unsigned es>
+	bool Contains(const valid<nbits, es>& r, double x) {
+		posit<nbits, es> lb, ub;
+		bool lclosed = r.getlb(lb), uclosed = r.getub(ub);
+		bool aboveLower = lb.isnar() || double(lb) < x || (lclosed && double(lb) == x);
+		bool belowUpper = ub.isnar() || x < double(ub) || (uclosed && double(ub) == x);
+		return aboveLower && belowUpper;
+	}
+
+	// the valids with bounds that are at most span posits apart, with all combinations of open and closed bounds,
+	// and the values to sample from each of them
+	template<unsigned nbits, unsigned es>
+	void GenerateIntervals(int span, std::vector< valid<nbits, es> >& intervals, std::vector< std::vector<double> >& samples) {
+		std::vector< posit<nbits, es> > bounds;
+		posit<nbits, es> p;
+		for (uint64_t i = 0; i < (uint64_t(1) << nbits); ++i) {
+			p.setbits(i);
+			if (!p.isnar()) bounds.push_back(p);
+		}
+		std::sort(bounds.begin(), bounds.end(), [](const posit<nbits, es>& a, const posit<nbits, es>& b) { return a < b; });
+		// the NaR bounds of the unbounded sides
+		posit<nbits, es> nar; nar.setnar();
+		bounds.insert(bounds.begin(), nar);
+		bounds.push_back(nar);
+		int last = static_cast<int>(bounds.size()) - 1;
+		for (int i = 0; i <= last; ++i) {
+			for (int j = i; j <= std::min(last, i + span); ++j) {
+				for (int flags = 0; flags < 4; ++flags) {
+					bool lclosed = (flags & 1), uclosed = (flags & 2);
+					if (i == j && (!lclosed || !uclosed || i == 0 || i == last)) continue;  // empty, or not a real value
+					if (i == last || j == 0) continue;
+					valid<nbits, es> v;
+					v.setlb(bounds[i], lclosed);
+					v.setub(bounds[j], uclosed);
+					double lo = (i == 0 ? -1.0e6 : double(bounds[i]));
+					double hi = (j == last ? 1.0e6 : double(bounds[j]));
+					std::vector<double> s;
+					if (lclosed && i != 0) s.push_back(lo);
+					if (uclosed && j != last && j != i) s.push_back(hi);
+					if (i != j) s.push_back(lo + 0.5 * (hi - lo));
+					intervals.push_back(v);
+					samples.push_back(s);
+				}
+			}
+		}
+	}
+
+	// the result of an operation on valids must contain the result of the operation on every pair of values they contain
+	template<unsigned nbits, unsigned es>
+	int VerifyEnclosure(int span, bool reportTestCases) {
+		std::vector< valid<nbits, es> > intervals;
+		std::vector< std::vector<double> > samples;
+		GenerateIntervals<nbits, es>(span, intervals, samples);
+		const char* ops[4] = { "+", "-", "*", "/" };
+		int nrOfFailedTestCases = 0;
+		for (size_t i = 0; i < intervals.size(); ++i) {
+			for (size_t j = 0; j < intervals.size(); ++j) {
+				const valid<nbits, es>& a = intervals[i];
+				const valid<nbits, es>& b = intervals[j];
+				valid<nbits, es> results[4] = { a + b, a - b, a * b, a / b };
+				for (double x : samples[i]) {
+					for (double y : samples[j]) {
+						double refs[4] = { x + y, x - y, x * y, x / y };
+						for (int op = 0; op < 4; ++op) {
+							if (std::isnan(refs[op]) || std::isinf(refs[op])) continue;
+							if (!Contains(results[op], refs[op])) {
+								++nrOfFailedTestCases;
+								if (reportTestCases) std::cerr << "FAIL " << a << ' ' << ops[op] << ' ' << b << " = " << results[op] << " does not contain " << x << ' ' << ops[op] << ' ' << y << " = " << refs[op] << '\n';
+							}
+						}
+					}
+				}
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// an operation on two exact valids yields the exact posit, or the pair of adjacent posits around the exact result
+	template<unsigned nbits, unsigned es>
+	int VerifyTightness(bool reportTestCases) {
+		using Posit = posit<nbits, es>;
+		using Valid = valid<nbits, es>;
+		constexpr uint64_t NR_ENCODINGS = (uint64_t(1) << nbits);
+		const char* ops[4] = { "+", "-", "*", "/" };
+		int nrOfFailedTestCases = 0;
+		Posit pa, pb;
+		for (uint64_t i = 0; i < NR_ENCODINGS; ++i) {
+			pa.setbits(i);
+			if (pa.isnar()) continue;
+			Valid a; a.setlb(pa, true); a.setub(pa, true);
+			for (uint64_t j = 0; j < NR_ENCODINGS; ++j) {
+				pb.setbits(j);
+				if (pb.isnar() || pb.iszero()) continue;
+				Valid b; b.setlb(pb, true); b.setub(pb, true);
+				Valid results[4] = { a + b, a - b, a * b, a / b };
+				Posit refs[4] = { pa + pb, pa - pb, pa * pb, pa / pb };
+				for (int op = 0; op < 4; ++op) {
+					Posit lb, ub;
+					bool lclosed = results[op].getlb(lb), uclosed = results[op].getub(ub);
+					Posit next = lb; ++next;
+					bool exact = lclosed && uclosed && lb == ub && lb == refs[op];
+					bool adjacent = !lclosed && !uclosed && (next == ub || lb.isnar() || ub.isnar()) && (refs[op] == lb || refs[op] == ub);
+					if (!exact && !adjacent) {
+						++nrOfFailedTestCases;
+						if (reportTestCases) std::cerr << "FAIL " << a << ' ' << ops[op] << ' ' << b << " = " << results[op] << " posit result " << refs[op] << '\n';
+					}
+				}
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	// wide configurations round outward by one posit: the result must contain the posit result
+	template<unsigned nbits, unsigned es>
+	int VerifyOutwardRounding(size_t nrOfSamples, bool reportTestCases) {
+		using Posit = posit<nbits, es>;
+		using Valid = valid<nbits, es>;
+		std::mt19937_64 rng(1234);
+		std::uniform_real_distribution<double> dist(-100.0, 100.0);
+		int nrOfFailedTestCases = 0;
+		for (size_t k = 0; k < nrOfSamples; ++k) {
+			Posit pa(dist(rng)), pb(dist(rng));
+			Valid a, b;
+			a.setlb(pa, true); a.setub(pa, true);
+			b.setlb(pb, true); b.setub(pb, true);
+			Valid results[4] = { a + b, a - b, a * b, a / b };
+			Posit refs[4] = { pa + pb, pa - pb, pa * pb, pa / pb };
+			for (int op = 0; op < 4; ++op) {
+				Posit lb, ub;
+				results[op].getlb(lb); results[op].getub(ub);
+				if (!(lb < refs[op] && refs[op] < ub)) {
+					++nrOfFailedTestCases;
+					if (reportTestCases) std::cerr << "FAIL " << results[op] << " does not contain " << refs[op] << '\n';
+				}
+			}
+		}
+		return nrOfFailedTestCases;
+	}
+
+	template<unsigned nbits, unsigned es>
+	std::vector< valid<nbits, es> > RandomValids(size_t n, unsigned seed) {
+		std::mt19937_64 rng(seed);
+		std::uniform_real_distribution<double> dist(-8.0, 8.0);
+		std::vector< valid<nbits, es> > v(n);
+		for (size_t i = 0; i < n; ++i) {
+			double lo = dist(rng), hi = lo + std::abs(dist(rng));
+			posit<nbits, es> plo(lo), phi(hi);
+			v[i].setlb(plo, (i & 1) != 0);
+			v[i].setub(phi, (i & 2) != 0);
+		}
+		return v;
+	}
+
+	// the batch kernels produce the valids of the scalar operators
+	template<unsigned nbits, unsigned es>
+	int VerifyBatchKernels(size_t n, bool reportTestCases) {
+		using Valid = valid<nbits, es>;
+		auto x = RandomValids<nbits, es>(n, 1);
+		auto y = RandomValids<nbits, es>(n, 2);
+		std::vector<Valid> z(n);
+		int nrOfFailedTestCases = 0;
+		auto compare = [&](const char* op, auto scalarOp) {
+			for (size_t i = 0; i < n; ++i) {
+				Valid ref = scalarOp(x[i], y[i]);
+				if (z[i] != ref) {
+					++nrOfFailedTestCases;
+					if (reportTestCases) std::cerr << "FAIL " << x[i] << ' ' << op << ' ' << y[i] << " batch " << z[i] << " scalar " << ref << '\n';
+				}
+			}
+		};
+		valid_add(n, x.data(), y.data(), z.data());
+		compare("+", [](const Valid& a, const Valid& b) { return a + b; });
+		valid_sub(n, x.data(), y.data(), z.data());
+		compare("-", [](const Valid& a, const Valid& b) { return a - b; });
+		valid_mul(n, x.data(), y.data(), z.data());
+		compare("*", [](const Valid& a, const Valid& b) { return a * b; });
+		valid_div(n, x.data(), y.data(), z.data());
+		compare("/", [](const Valid& a, const Valid& b) { return a / b; });
+		return nrOfFailedTestCases;
+	}
+
+	template<typename Valid>
+	int VerifyValue(const Valid& v, const std::string& ref, bool reportTestCases) {
+		std::stringstream s;
+		s << v;
+		if (s.str() != ref) {
+			if (reportTestCases) std::cerr << "FAIL " << s.str() << " != " << ref << '\n';
+			return 1;
+		}
+		return 0;
+	}
+
+} }  // namespace sw::universal
+
+// Regression testing guards: typically set by the cmake configuration, but MANUAL_TESTING is an override
+#define MANUAL_TESTING 0
+// REGRESSION_LEVEL_OVERRIDE is set by the cmake file to drive a specific regression intensity
+// It is the responsibility of the regression test to organize the tests in a quartile progression.
+//#undef REGRESSION_LEVEL_OVERRIDE
+#ifndef REGRESSION_LEVEL_OVERRIDE
+#undef REGRESSION_LEVEL_1
+#undef REGRESSION_LEVEL_2
+#undef REGRESSION_LEVEL_3
+#undef REGRESSION_LEVEL_4
+#define REGRESSION_LEVEL_1 1
+#define REGRESSION_LEVEL_2 1
+#define REGRESSION_LEVEL_3 1
+#define REGRESSION_LEVEL_4 1
+#endif
+
+int main()
+try {
+	using namespace sw::universal;
+
+	std::string test_suite  = "valid interval arithmetic validation";
+	std::string test_tag    = "arithmetic";
+	bool reportTestCases    = false;
+	int nrOfFailedTestCases = 0;
+
+	ReportTestSuiteHeader(test_suite, reportTestCases);
+
+	static_assert(valid_native_endpoints<16, 1>(), "posit<16,1> endpoints must take the native path");
+	static_assert(!valid_native_endpoints<64, 3>(), "posit<64,3> endpoints exceed double precision");
+
+#if MANUAL_TESTING
+
+	using Valid = valid<32, 2>;
+	Valid a = 1.0, b = 3.0;
+	std::cout << a << " / " << b << " = " << a / b << '\n';
+	std::cout << a << " - " << b << " = " << a - b << '\n';
+
+	// interval evaluation against the posit evaluation of the same values
+	constexpr size_t N = 1024 * 64;
+	auto x = RandomValids<32, 2>(N, 1);
+	auto y = RandomValids<32, 2>(N, 2);
+	std::vector<Valid> z(N);
+	std::vector< posit<32, 2> > px(N), py(N), pz(N);
+	for (size_t i = 0; i < N; ++i) { x[i].getlb(px[i]); y[i].getub(py[i]); }
+	auto begin = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < N; ++i) pz[i] = px[i] * py[i];
+	auto middle = std::chrono::steady_clock::now();
+	valid_mul(N, x.data(), y.data(), z.data());
+	auto end = std::chrono::steady_clock::now();
+	double positTime = std::chrono::duration<double>(middle - begin).count();
+	double validTime = std::chrono::duration<double>(end - middle).count();
+	std::cout << "posit<32,2> mul : " << positTime << " sec\n";
+	std::cout << "valid<32,2> mul : " << validTime << " sec, " << validTime / positTime << "x\n";
+
+	nrOfFailedTestCases += ReportTestResult(VerifyEnclosure<5, 0>(2, reportTestCases), "valid<5,0>", test_tag);
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return EXIT_SUCCESS;
+#else
+
+#if REGRESSION_LEVEL_1
+	{
+		using Valid = valid<8, 0>;
+		Valid one = 1, three = 3, zero = 0;
+		int nrOfFailures = 0;
+		nrOfFailures += VerifyValue(one + three, "[4, 4]", reportTestCases);
+		nrOfFailures += VerifyValue(one - three, "[-2, -2]", reportTestCases);
+		nrOfFailures += VerifyValue(one / three, "(0.328125, 0.34375)", reportTestCases);
+		nrOfFailures += VerifyValue(-(one / three), "(-0.34375, -0.328125)", reportTestCases);
+		nrOfFailures += VerifyValue(zero * (one / three), "[0, 0]", reportTestCases);
+		nrOfFailures += VerifyValue(one / zero, "[nar, nar]", reportTestCases);
+		nrOfFailures += VerifyValue(Valid(1.0e10), "(64, nar)", reportTestCases);
+		nrOfFailures += (one < three && !(three < one) && !(one < one)) ? 0 : 1;
+		nrOfFailures += (one + three == Valid(4)) ? 0 : 1;
+		nrOfFailedTestCases += ReportTestResult(nrOfFailures, "valid<8,0>", "special cases");
+	}
+	nrOfFailedTestCases += ReportTestResult(VerifyEnclosure<5, 0>(3, reportTestCases), "valid<5,0>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyTightness<6, 1>(reportTestCases), "valid<6,1>", "tightness");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels<16, 1>(1000, reportTestCases), "valid<16,1>", "batch");
+#endif
+
+#if REGRESSION_LEVEL_2
+	nrOfFailedTestCases += ReportTestResult(VerifyEnclosure<6, 1>(2, reportTestCases), "valid<6,1>", test_tag);
+	nrOfFailedTestCases += ReportTestResult(VerifyTightness<8, 0>(reportTestCases), "valid<8,0>", "tightness");
+	nrOfFailedTestCases += ReportTestResult(VerifyOutwardRounding<64, 3>(1000, reportTestCases), "valid<64,3>", "outward rounding");
+#endif
+
+#if REGRESSION_LEVEL_3
+	nrOfFailedTestCases += ReportTestResult(VerifyTightness<8, 2>(reportTestCases), "valid<8,2>", "tightness");
+	nrOfFailedTestCases += ReportTestResult(VerifyBatchKernels<32, 2>(10000, reportTestCases), "valid<32,2>", "batch");
+#endif
+
+#if REGRESSION_LEVEL_4
+	nrOfFailedTestCases += ReportTestResult(VerifyTightness<10, 1>(reportTestCases), "valid<10,1>", "tightness");
+#endif
+
+	ReportTestSuiteResults(test_suite, nrOfFailedTestCases);
+	return (nrOfFailedTestCases > 0 ? EXIT_FAILURE : EXIT_SUCCESS);
+
+#endif  // MANUAL_TESTING
+}
+catch (char const* msg) {
+	std::cerr << msg << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_arithmetic_exception& err) {
+	std::cerr << "Uncaught unexpected universal arithmetic exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const sw::universal::universal_internal_exception& err) {
+	std::cerr << "Uncaught unexpected universal internal exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (const std::runtime_error& err) {
+	std::cerr << "Uncaught runtime exception: " << err.what() << std::endl;
+	return EXIT_FAILURE;
+}
+catch (...) {
+	std::cerr << "Caught unknown exception" << std::endl;
+	return EXIT_FAILURE;
+}